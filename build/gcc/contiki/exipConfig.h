@@ -45,9 +45,10 @@
 #define EXIP_REALLOC d_realloc
 #define EXIP_MFREE d_free
 
+#define MEM_ARENA_USE OFF
+#define MEM_ARENA_CHUNK_SIZE 512
 #define HASH_TABLE_USE OFF
-#define INITIAL_HASH_TABLE_SIZE 53
-#define MAX_HASH_TABLE_SIZE 3000
+#define INITIAL_HASH_TABLE_SIZE 64
 #define DYN_ARRAY_USE ON
 
 
@@ -130,4 +131,47 @@ struct ThinFloat
 #define BUILD_IN_GRAMMARS_USE ON
 #endif
 
+/** @def STRING_TABLE_HASH_USE
+ * 		Whether to index the URI and local-name string tables with open addressing
+ * 		hash tables. Speeds up the serialization with schemas that define many names.
+ * 	@def STRING_TABLE_HASH_THRESHOLD
+ * 		The number of entries from which a URI or local-name table is indexed
+ */
+#define STRING_TABLE_HASH_USE OFF
+#define STRING_TABLE_HASH_THRESHOLD 16
+
+/**
+ * Whether to support the EXI compression and pre-compression alignment options.
+ * The values of each block are then multiplexed in channels and, in case of
+ * compression, DEFLATE-ed by the built-in raw DEFLATE implementation.
+ * When disabled such EXI streams are rejected with EXIP_NOT_IMPLEMENTED_YET.
+ */
+#define COMPRESSION_USE OFF
+
+/**
+ * Whether the strings are represented in UTF-8 (UTF8_stringManipulate.c)
+ * instead of ASCII. String.length is then the number of bytes and the
+ * decoded strings may take up to 4 bytes per character.
+ */
+#define STRING_UTF8_USE OFF
+
+/**
+ * Whether the productions of the event codes of static schemas can be
+ * selected by the functions generated with "exipg -codec" (see StaticCodec
+ * in procTypes.h) instead of the generic grammar processing.
+ */
+#define STATIC_CODEC_USE OFF
+
+/**
+ * Whether the schema cache of the codec (schemaCache.h) can be used
+ * from several threads. Its accesses are then serialized with a POSIX mutex.
+ */
+#define SCHEMA_CACHE_THREAD_SAFE OFF
+
+/**
+ * The number of instances of a schema that the schema cache of the codec
+ * keeps when they are released; the other ones are freed.
+ */
+#define SCHEMA_CACHE_IDLE_INSTANCES 1
+
 #endif /* EXIPCONFIG_H_ */
@@ -76,16 +76,23 @@
 #define EXIP_REALLOC realloc
 #define EXIP_MFREE free
 
+/** @def MEM_ARENA_USE
+ * 		Whether the memory allocated through an AllocList (memManagedAllocate())
+ * 		is carved from large chunks instead of allocated one by one
+ * 	@def MEM_ARENA_CHUNK_SIZE
+ * 		The minimal size in bytes of the arena chunks
+ */
+#define MEM_ARENA_USE ON
+#define MEM_ARENA_CHUNK_SIZE 4096
+
 /** @def HASH_TABLE_USE
  * 		Whether to use hash table for value partition table when in encoding mode
  * 	@def INITIAL_HASH_TABLE_SIZE
- * 		The initial capacity of the hash tables
- * 	@def MAX_HASH_TABLE_SIZE
- * 		The maximum capacity of the hash tables
+ * 		The initial number of slots of the hash tables (rounded up to a power of two).
+ * 		The tables grow as needed.
  */
 #define HASH_TABLE_USE ON
-#define INITIAL_HASH_TABLE_SIZE 6151
-#define MAX_HASH_TABLE_SIZE 32000
+#define INITIAL_HASH_TABLE_SIZE 1024
 
 /** Whether to use dynamic arrays */
 #define DYN_ARRAY_USE ON
@@ -149,6 +156,50 @@
 #define BUILD_IN_GRAMMARS_USE ON
 #endif
 
+/** @def STRING_TABLE_HASH_USE
+ * 		Whether to index the URI and local-name string tables with open addressing
+ * 		hash tables. Speeds up the serialization with schemas that define many names.
+ * 	@def STRING_TABLE_HASH_THRESHOLD
+ * 		The number of entries from which a URI or local-name table is indexed
+ */
+#define STRING_TABLE_HASH_USE ON
+#define STRING_TABLE_HASH_THRESHOLD 16
+
+/**
+ * Whether to support the EXI compression and pre-compression alignment options.
+ * The values of each block are then multiplexed in channels and, in case of
+ * compression, DEFLATE-ed by the built-in raw DEFLATE implementation.
+ * When disabled such EXI streams are rejected with EXIP_NOT_IMPLEMENTED_YET.
+ */
+#define COMPRESSION_USE ON
+
+/**
+ * Whether the strings are represented in UTF-8 (UTF8_stringManipulate.c)
+ * instead of ASCII. String.length is then the number of bytes and the
+ * decoded strings may take up to 4 bytes per character.
+ * OFF by default; enable it for applications that need non-ASCII strings.
+ */
+#define STRING_UTF8_USE OFF
+
+/**
+ * Whether the productions of the event codes of static schemas can be
+ * selected by the functions generated with "exipg -codec" (see StaticCodec
+ * in procTypes.h) instead of the generic grammar processing.
+ */
+#define STATIC_CODEC_USE ON
+
+/**
+ * Whether the schema cache of the codec (schemaCache.h) can be used
+ * from several threads. Its accesses are then serialized with a POSIX mutex.
+ */
+#define SCHEMA_CACHE_THREAD_SAFE ON
+
+/**
+ * The number of instances of a schema that the schema cache of the codec
+ * keeps when they are released; the other ones are freed.
+ */
+#define SCHEMA_CACHE_IDLE_INSTANCES 2
+
 
 
 #endif /* EXIPCONFIG_H_ */
@@ -91,7 +91,8 @@ typedef EXIP_SMALL_INDEX SmallIndex;
 /**
  * Defines the encoding used for characters.
  * It is dependent on the implementation of the stringManipulate.h functions
- * The default is ASCII characters (ASCII_stringManipulate.c)
+ * The default is ASCII characters (ASCII_stringManipulate.c). With STRING_UTF8_USE
+ * the char strings hold UTF-8 (UTF8_stringManipulate.c) and String.length is in bytes.
  */
 #ifndef CHAR_TYPE
 # define CHAR_TYPE char
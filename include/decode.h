@@ -17,9 +17,19 @@
 #include "EXIPrimitives.h"
 #include "singleLinkedList.h"
 #include "errorHandle.h"
+#include "schemaCache.h"
+#include "eventVector.h"
 
 #define OUT_EXI 0
 #define OUT_XML 1
+/** Added to OUT_EXI or OUT_XML to also print the output on stdout; off by default */
+#define OUT_ECHO 0x80
+
+/*
+ * The schema of schemaPath is taken from the schema cache (schemaCache.h).
+ * The ...WithSchema() variants use a schema given by the application instead,
+ * NULL for schema-less decoding.
+ */
 
 errorCode decodeFromFile(
 	char *schemaPath, 
@@ -38,4 +48,42 @@ errorCode decodeFromBuffer(
 	size_t inDataLen, 
 	List *outData);
 
+errorCode decodeFromFileWithSchema(
+	struct EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	List *outData);
+
+errorCode decodeFromBufferWithSchema(
+	struct EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	void *inData,
+	size_t inDataLen,
+	List *outData);
+
+/*
+ * Decode to an EventVector (eventVector.h) instead of a List of text lines.
+ * The events are appended to outEvents, which must be set up with initEventVector().
+ * schema is NULL for schema-less decoding, e.g. from acquireSchema() otherwise.
+ */
+
+errorCode decodeEventsFromFile(
+	struct EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	EventVector *outEvents);
+
+errorCode decodeEventsFromBuffer(
+	struct EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	void *inData,
+	size_t inDataLen,
+	EventVector *outEvents);
+
 #endif /* DECODE_H_ */
\ No newline at end of file
@@ -17,10 +17,20 @@
 #include "EXIPrimitives.h"
 #include "singleLinkedList.h"
 #include "errorHandle.h"
+#include "schemaCache.h"
+#include "eventVector.h"
 
 #define IN_EXI 0
 #define IN_XML 1
 
+/*
+ * The schema of schemaPath is taken from the schema cache (schemaCache.h).
+ * The ...WithSchema() variants use a schema given by the application instead,
+ * NULL for schema-less encoding. encodeFromFile() reads the input events
+ * one per line, in the form of the decodeFrom...() output, or an XML
+ * document with IN_XML (see encodeXmlFromFile()).
+ */
+
 errorCode encodeFromFile(
     char *schemaPath, 
 	unsigned char outFlag, 
@@ -40,4 +50,74 @@ errorCode encodeFromBuffer(
 	char **outData,
 	size_t *outDataLen);
 
+errorCode encodeFromFileWithSchema(
+	struct EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	char **outData,
+	size_t *outDataLen);
+
+errorCode encodeFromBufferWithSchema(
+	struct EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	List *inData,
+	size_t inDataLen,
+	char **outData,
+	size_t *outDataLen);
+
+/*
+ * Encode an EventVector (eventVector.h), e.g. from decodeEventsFrom...().
+ * The events are passed to the serializer as they are: no text is parsed and the
+ * values keep their types. The element and attribute names are resolved to their
+ * string table IDs once per name instead of once per event.
+ * schema is NULL for schema-less encoding, e.g. from acquireSchema() otherwise.
+ * *outData is allocated with malloc() and owned by the caller.
+ */
+
+errorCode encodeEventsToBuffer(
+	struct EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const EventVector *inEvents,
+	char **outData,
+	size_t *outDataLen);
+
+/*
+ * Encode an XML document. The text is read in blocks with inputStream, e.g.
+ * readFileInputStream() from codec_common.h, and each event is passed to the serializer
+ * as soon as it is tokenized: the memory used depends on the longest tag or character
+ * data and on the nesting of the elements, not on the size of the document.
+ * With a schema, the values of the simple typed elements and attributes are converted
+ * from their lexical form and encoded with their EXI types: integers, floats, decimals,
+ * booleans, dateTimes, binary data and QNames.
+ * The document is UTF-8 encoded. Comments, processing instructions and the document
+ * type declaration are not encoded: the options that preserve them are rejected with
+ * EXIP_NOT_IMPLEMENTED_YET. The namespace declarations and the prefixes are encoded
+ * with the preserve prefixes option. Character data that is only white space is
+ * dropped, except as the value of a simple typed element.
+ * schema is NULL for schema-less encoding, e.g. from acquireSchema() otherwise.
+ * *outData is allocated with malloc() and owned by the caller.
+ */
+
+errorCode encodeXmlFromFile(
+	struct EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	char **outData,
+	size_t *outDataLen);
+
+errorCode encodeXmlFromStream(
+	struct EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	size_t (*inputStream)(void *buf, size_t size, void *stream),
+	void *inStream,
+	char **outData,
+	size_t *outDataLen);
+
 #endif /* ENCODE_H_ */
\ No newline at end of file
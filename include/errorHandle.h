@@ -196,7 +196,12 @@ enum errorCode
 	  * to the specification */
 	 EXIP_INVALID_INPUT                      	 =18,
 	 /** Received EXI event that is invalid or not expected */
-	 EXIP_INVALID_EVENT                      	 =19
+	 EXIP_INVALID_EVENT                      	 =19,
+	 /**
+	  * Returned by the startElement() content handler callback to request
+	  * that the content of the element is skipped; see skipElement() in EXIParser.h
+	  */
+	 EXIP_HANDLER_SKIP_ELEMENT                   =20
 };
 
 typedef enum errorCode errorCode;
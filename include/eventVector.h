@@ -0,0 +1,193 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file eventVector.h
+ * @brief A compact, typed representation of the events of an EXI stream
+ * used by the codec (decode.h) instead of the text List.
+ *
+ * The events are kept in one array of fixed size records. All the character
+ * data - names, string and binary values - is appended to a single growing
+ * string buffer and referenced by offset, so the vector needs a handful of
+ * allocations for a whole stream. The qualified names are interned: each distinct
+ * name is stored once and the events refer to it by index.
+ * The value of an attribute is the event that follows its EV_ATTRIBUTE event.
+ */
+
+#ifndef EVENTVECTOR_H_
+#define EVENTVECTOR_H_
+
+#include "EXIPrimitives.h"
+#include "EXIOptions.h"
+#include "errorHandle.h"
+
+struct EXIPDateTime;
+
+enum EventKind
+{
+	EV_START_DOCUMENT   = 0,
+	EV_END_DOCUMENT     = 1,
+	EV_START_ELEMENT    = 2,
+	EV_END_ELEMENT      = 3,
+	EV_ATTRIBUTE        = 4,
+	EV_SELF_CONTAINED   = 5,
+	EV_STRING           = 6,
+	EV_INT              = 7,
+	EV_FLOAT            = 8,
+	EV_DECIMAL          = 9,
+	EV_BOOLEAN          = 10,
+	EV_DATE_TIME        = 11,
+	EV_BINARY           = 12,
+	EV_QNAME            = 13
+};
+
+typedef enum EventKind EventKind;
+
+/** A string of the string buffer of an EventVector */
+struct EventString
+{
+	size_t offset;
+	size_t length;
+};
+
+typedef struct EventString EventString;
+
+/** An interned qualified name */
+struct EventName
+{
+	EventString uri;
+	EventString localName;
+};
+
+typedef struct EventName EventName;
+
+struct CodecEvent
+{
+	/** One of EventKind */
+	unsigned char kind;
+	/**
+	 * EV_START_ELEMENT, EV_ATTRIBUTE and EV_QNAME: the index of the name in EventVector.names
+	 * EV_DATE_TIME: the index of the value in EventVector.dateTimes
+	 */
+	Index id;
+	union
+	{
+		/** EV_STRING and EV_BINARY */
+		EventString str;
+		Integer intVal;
+		/** EV_FLOAT and EV_DECIMAL */
+		Float floatVal;
+		boolean boolVal;
+	} value;
+};
+
+typedef struct CodecEvent CodecEvent;
+
+struct EventVector
+{
+	CodecEvent* events;
+	Index count;
+	Index capacity;
+
+	/** All the names and the string and binary values */
+	char* strings;
+	size_t stringsLength;
+	size_t stringsCapacity;
+
+	EventName* names;
+	Index nameCount;
+	Index nameCapacity;
+	/** Open addressing index of names; INDEX_MAX marks an empty slot */
+	Index* nameSlots;
+	Index nameSlotCount;
+
+	struct EXIPDateTime* dateTimes;
+	Index dateTimeCount;
+	Index dateTimeCapacity;
+
+	/** TRUE if the header of the decoded stream has options */
+	boolean hasOptions;
+	/**
+	 * The header options of the decoded stream. The schemaID and the
+	 * datatype representation map are not kept: schemaID is empty and drMap NULL
+	 */
+	EXIOptions options;
+};
+
+typedef struct EventVector EventVector;
+
+/**
+ * @brief Initial setup of an EventVector. No memory is allocated before the first event.
+ *
+ * @param[out] vector the event vector
+ */
+void initEventVector(EventVector* vector);
+
+/**
+ * @brief Frees the memory of an EventVector; it can be used again after initEventVector()
+ *
+ * @param[in, out] vector the event vector
+ */
+void destroyEventVector(EventVector* vector);
+
+/**
+ * @brief Appends an event to the vector
+ *
+ * @param[in, out] vector the event vector
+ * @param[in] event the event; copied
+ * @return Error handling code
+ */
+errorCode addEvent(EventVector* vector, const CodecEvent* event);
+
+/**
+ * @brief Copies a string or binary value to the string buffer of the vector
+ *
+ * @param[in, out] vector the event vector
+ * @param[in] data the characters or bytes
+ * @param[in] length the number of bytes of data
+ * @param[out] str where the value is stored in vector->strings
+ * @return Error handling code
+ */
+errorCode addEventString(EventVector* vector, const void* data, size_t length, EventString* str);
+
+/**
+ * @brief Returns the index of a qualified name in vector->names, adding it if it is new
+ *
+ * @param[in, out] vector the event vector
+ * @param[in] uri the namespace URI of the name
+ * @param[in] localName the local name
+ * @param[out] nameId the index of the name
+ * @return Error handling code
+ */
+errorCode internEventName(EventVector* vector, const String* uri, const String* localName, Index* nameId);
+
+/**
+ * @brief Appends a dateTime value to vector->dateTimes
+ *
+ * @param[in, out] vector the event vector
+ * @param[in] dateTime the value; copied
+ * @param[out] dateTimeId the index of the value
+ * @return Error handling code
+ */
+errorCode addEventDateTime(EventVector* vector, const struct EXIPDateTime* dateTime, Index* dateTimeId);
+
+/**
+ * @brief Writes the events of a vector as text. The output is collected in a local
+ * buffer and passed to outputStream in large blocks.
+ *
+ * @param[in] vector the event vector
+ * @param[in] outFlag OUT_EXI for one line per event as in the decodeFrom...() List,
+ * OUT_XML for an XML document
+ * @param[in] outputStream writes size bytes of buf to stream and returns the number written,
+ * e.g. a wrapper of fwrite()
+ * @param[in] stream passed to outputStream
+ * @return Error handling code; EXIP_BUFFER_END_REACHED if outputStream fails
+ */
+errorCode writeEventVector(const EventVector* vector, unsigned char outFlag,
+						   size_t (*outputStream)(void* buf, size_t size, void* stream), void* stream);
+
+#endif /* EVENTVECTOR_H_ */
@@ -0,0 +1,66 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file schemaCache.h
+ * @brief A process-wide cache of the schemas used by the codec (decode.h and encode.h)
+ *
+ * Building the grammars of a schema costs much more than encoding or decoding
+ * a small message with them. The cache keeps the schemas built from a schema path
+ * so that they are built once per process instead of once per message.
+ * The entries are keyed by the schema path, the identity of the schema files
+ * (device, inode, size and modification time) and the options mask, so a schema
+ * file that is changed on disk is parsed again.
+ *
+ * An EXIPSchema object is used by one EXI stream at a time: the stream adds the names
+ * and the built-in grammars it learns to the schema and removes them at its end.
+ * The cache therefore hands out each schema instance to one user at a time and builds
+ * another instance of the same schema when all of them are in use, e.g. by several threads.
+ * Up to SCHEMA_CACHE_IDLE_INSTANCES instances of a schema are kept when they are released.
+ * With SCHEMA_CACHE_THREAD_SAFE the cache can be used from several threads; a schema
+ * is then built without blocking the acquisition of the schemas already in the cache.
+ */
+
+#ifndef SCHEMACACHE_H_
+#define SCHEMACACHE_H_
+
+#include "EXIOptions.h"
+#include "errorHandle.h"
+
+struct EXIPSchema;
+
+/**
+ * @brief Returns a schema built from a list of schema files, from the cache when possible
+ *
+ * @param[in] schemaPath the paths of the XSD or EXI-encoded XSD files separated by ','
+ * as for parseSchema(); not modified
+ * @param[in] maskOpt the options of the EXI-encoded schema files if any, otherwise NULL
+ * @param[out] schema the schema; to be returned with releaseSchema() and not modified
+ * in any other way than by the EXI streams that use it
+ * @return Error handling code; EXIP_INVALID_INPUT if a schema file cannot be read
+ */
+errorCode acquireSchema(const char* schemaPath, EXIOptions* maskOpt, struct EXIPSchema** schema);
+
+/**
+ * @brief Returns a schema obtained with acquireSchema() to the cache.
+ * The EXI stream that used it must be closed before.
+ *
+ * @param[in] schema the schema
+ */
+void releaseSchema(struct EXIPSchema* schema);
+
+/**
+ * @brief Frees the schemas of the cache that are not in use
+ */
+void clearSchemaCache(void);
+
+/**
+ * @brief Returns the number of schema instances in the cache, in use or not
+ */
+unsigned int getSchemaCacheCount(void);
+
+#endif /* SCHEMACACHE_H_ */
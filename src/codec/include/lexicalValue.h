@@ -0,0 +1,91 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file lexicalValue.h
+ * @brief Conversion of the lexical (text) form of the schema-typed values for the codec encoders
+ *
+ * The parsers do not depend on the C locale and do not allocate memory.
+ * Leading and trailing white space is ignored as for the XML Schema
+ * types with collapsed white space.
+ */
+
+#ifndef LEXICALVALUE_H_
+#define LEXICALVALUE_H_
+
+#include "procTypes.h"
+
+/**
+ * @brief Parses an xsd:integer, xsd:long, xsd:int etc. value
+ *
+ * @param[in] str the characters of the value
+ * @param[in] length the number of characters
+ * @param[out] value the value
+ * @return Error handling code; EXIP_INVALID_INPUT if the value is not an integer or does not fit in Integer
+ */
+errorCode parseIntegerValue(const char* str, size_t length, Integer* value);
+
+/**
+ * @brief Parses an xsd:float, xsd:double or xsd:decimal value, including INF, -INF and NaN.
+ * Digits that do not fit in the mantissa are dropped.
+ *
+ * @param[in] str the characters of the value
+ * @param[in] length the number of characters
+ * @param[out] value the value; the trailing zeros of the mantissa are moved to the exponent
+ * @return Error handling code; EXIP_INVALID_INPUT if the value is not a number or
+ * its exponent is out of the EXI range
+ */
+errorCode parseFloatValue(const char* str, size_t length, Float* value);
+
+/**
+ * @brief Parses an xsd:boolean value: true, false, 1 or 0
+ *
+ * @param[in] str the characters of the value
+ * @param[in] length the number of characters
+ * @param[out] value the value
+ * @return Error handling code
+ */
+errorCode parseBooleanValue(const char* str, size_t length, boolean* value);
+
+/**
+ * @brief Parses an xsd:dateTime, xsd:date, xsd:time, xsd:gYear, xsd:gYearMonth,
+ * xsd:gMonth, xsd:gMonthDay or xsd:gDay value. The fields that are not
+ * in the value are set to 0 (tm_mon to -1).
+ *
+ * @param[in] str the characters of the value
+ * @param[in] length the number of characters
+ * @param[out] value the value
+ * @return Error handling code
+ */
+errorCode parseDateTimeValue(const char* str, size_t length, EXIPDateTime* value);
+
+/**
+ * @brief Decodes an xsd:hexBinary or xsd:base64Binary value in place.
+ * The schema types of the binary values are not known to the encoders: a value
+ * that is valid hexBinary is decoded as hexBinary, any other as base64Binary.
+ *
+ * @param[in, out] str the characters of the value; replaced by the bytes of the value
+ * @param[in] length the number of characters
+ * @param[out] nbytes the number of bytes of the value
+ * @return Error handling code
+ */
+errorCode parseBinaryValue(char* str, size_t length, Index* nbytes);
+
+/**
+ * @brief Serializes a value given in its lexical form with the typed serializer
+ * function of its value type class, e.g. serialize.intData() for VALUE_TYPE_INTEGER_CLASS.
+ * The values of the other classes, except QNames, are serialized with serialize.stringData().
+ *
+ * @param[in, out] strm EXI stream
+ * @param[in] valueType the value type class returned by serialize.startElement() or serialize.attribute()
+ * @param[in, out] str the characters of the value; binary values are decoded in place
+ * @param[in] length the number of characters
+ * @return Error handling code; EXIP_INVALID_INPUT if the value is not valid for its type
+ */
+errorCode serializeLexicalValue(EXIStream* strm, EXITypeClass valueType, char* str, size_t length);
+
+#endif /* LEXICALVALUE_H_ */
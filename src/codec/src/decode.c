@@ -14,7 +14,7 @@
 #include "codec_common.h"
 #include "EXIParser.h"
 #include "stringManipulate.h"
-#include "parseSchema.h"
+#include "schemaCache.h"
 #include "../../grammarGen/include/grammarGenerator.h"
 #include <stdio.h>
 #include <string.h>
@@ -22,9 +22,14 @@
 #define INPUT_BUFFER_SIZE 200
 #define MAX_PREFIXES 10
 
+// The output is printed on stdout only with OUT_ECHO
+#define ECHO_PRINTF(appD, ...) do { if((appD)->echo) printf(__VA_ARGS__); } while(0)
+#define ECHO_STRING(appD, str) do { if((appD)->echo) printString(str); } while(0)
+
 struct appData
 {
 	unsigned char outputFormat;
+	boolean echo;
 	unsigned char expectAttributeData;
 	char nameBuf[200];				  // needed for the OUT_XML Output Format
 	struct element *stack;			  // needed for the OUT_XML Output Format
@@ -36,6 +41,8 @@ struct appData
 	 *
 	 */
 	List outData;
+	/** The output of decodeEventsFrom...(); NULL for the List output */
+	EventVector *events;
 };
 
 // Stuff needed for the OUT_XML Output Format
@@ -71,6 +78,24 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data);
 static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data);
 static errorCode sample_binaryData(const char *binary_val, Index nbytes, void *app_data);
 static errorCode sample_qnameData(const QName qname, void *app_data);
+static errorCode sample_selfContained(void *app_data);
+
+// Content Handler API for the EventVector output
+static errorCode vector_fatalError(const errorCode code, const char *msg, void *app_data);
+static errorCode vector_startDocument(void *app_data);
+static errorCode vector_endDocument(void *app_data);
+static errorCode vector_startElement(QName qname, void *app_data);
+static errorCode vector_endElement(void *app_data);
+static errorCode vector_attribute(QName qname, void *app_data);
+static errorCode vector_stringData(const String value, void *app_data);
+static errorCode vector_decimalData(Decimal value, void *app_data);
+static errorCode vector_intData(Integer int_val, void *app_data);
+static errorCode vector_floatData(Float fl_val, void *app_data);
+static errorCode vector_booleanData(boolean bool_val, void *app_data);
+static errorCode vector_dateTimeData(EXIPDateTime dt_val, void *app_data);
+static errorCode vector_binaryData(const char *binary_val, Index nbytes, void *app_data);
+static errorCode vector_qnameData(const QName qname, void *app_data);
+static errorCode vector_selfContained(void *app_data);
 
 static errorCode decode(
 	EXIPSchema *schemaPtr,
@@ -81,7 +106,8 @@ static errorCode decode(
 	size_t (*inputStream)(void *buf, size_t size, void *stream),
 	void *inData,
 	size_t inDataLen,
-	List *outData)
+	List *outData,
+	EventVector *outEvents)
 {
 	Parser testParser;
 	char buf[INPUT_BUFFER_SIZE];
@@ -114,31 +140,67 @@ static errorCode decode(
 	parsingData.stack = NULL;
 	parsingData.unclosedElement = 0;
 	parsingData.prefixesCount = 0;
-	parsingData.outputFormat = outFlag;
+	parsingData.outputFormat = outFlag & ~OUT_ECHO;
+	parsingData.echo = (outFlag & OUT_ECHO) != 0;
 	parsingData.outData = newList();
+	parsingData.events = outEvents;
 	if (outOfBandOpts && opts != NULL)
 		testParser.strm.header.opts = *opts;
 
-	testParser.handler.fatalError = sample_fatalError;
-	testParser.handler.error = sample_fatalError;
-	testParser.handler.startDocument = sample_startDocument;
-	testParser.handler.endDocument = sample_endDocument;
-	testParser.handler.startElement = sample_startElement;
-	testParser.handler.attribute = sample_attribute;
-	testParser.handler.stringData = sample_stringData;
-	testParser.handler.endElement = sample_endElement;
-	testParser.handler.decimalData = sample_decimalData;
-	testParser.handler.intData = sample_intData;
-	testParser.handler.floatData = sample_floatData;
-	testParser.handler.booleanData = sample_booleanData;
-	testParser.handler.dateTimeData = sample_dateTimeData;
-	testParser.handler.binaryData = sample_binaryData;
-	testParser.handler.qnameData = sample_qnameData;
+	if (outEvents != NULL)
+	{
+		testParser.handler.fatalError = vector_fatalError;
+		testParser.handler.error = vector_fatalError;
+		testParser.handler.startDocument = vector_startDocument;
+		testParser.handler.endDocument = vector_endDocument;
+		testParser.handler.startElement = vector_startElement;
+		testParser.handler.attribute = vector_attribute;
+		testParser.handler.stringData = vector_stringData;
+		testParser.handler.endElement = vector_endElement;
+		testParser.handler.decimalData = vector_decimalData;
+		testParser.handler.intData = vector_intData;
+		testParser.handler.floatData = vector_floatData;
+		testParser.handler.booleanData = vector_booleanData;
+		testParser.handler.dateTimeData = vector_dateTimeData;
+		testParser.handler.binaryData = vector_binaryData;
+		testParser.handler.qnameData = vector_qnameData;
+		testParser.handler.selfContained = vector_selfContained;
+	}
+	else
+	{
+		testParser.handler.fatalError = sample_fatalError;
+		testParser.handler.error = sample_fatalError;
+		testParser.handler.startDocument = sample_startDocument;
+		testParser.handler.endDocument = sample_endDocument;
+		testParser.handler.startElement = sample_startElement;
+		testParser.handler.attribute = sample_attribute;
+		testParser.handler.stringData = sample_stringData;
+		testParser.handler.endElement = sample_endElement;
+		testParser.handler.decimalData = sample_decimalData;
+		testParser.handler.intData = sample_intData;
+		testParser.handler.floatData = sample_floatData;
+		testParser.handler.booleanData = sample_booleanData;
+		testParser.handler.dateTimeData = sample_dateTimeData;
+		testParser.handler.binaryData = sample_binaryData;
+		testParser.handler.qnameData = sample_qnameData;
+		testParser.handler.selfContained = sample_selfContained;
+	}
 
 	// IV: Parse the header of the stream
 
 	TRY(parse.parseHeader(&testParser, outOfBandOpts));
 
+	if (outEvents != NULL)
+	{
+		// The strings of the options are freed with the parser
+		outEvents->hasOptions = testParser.strm.header.has_options;
+		outEvents->options = testParser.strm.header.opts;
+		outEvents->options.schemaID = EMPTY_STRING;
+		outEvents->options.drMap = NULL;
+		if (outEvents->options.schemaIDMode == SCHEMA_ID_SET)
+			outEvents->options.schemaIDMode = SCHEMA_ID_EMPTY;
+	}
+
 	// IV.1: Set the schema to be used for parsing.
 	// The schemaID mode and schemaID field can be read at
 	// parser.strm.header.opts.schemaIDMode and
@@ -158,9 +220,12 @@ static errorCode decode(
 
 	parse.destroyParser(&testParser);
 
-	outData->size = parsingData.outData.size;
-	outData->head = parsingData.outData.head;
-	outData->tail = parsingData.outData.tail;
+	if (outData != NULL)
+	{
+		outData->size = parsingData.outData.size;
+		outData->head = parsingData.outData.head;
+		outData->tail = parsingData.outData.tail;
+	}
 
 	if (tmp_err_code == EXIP_PARSING_COMPLETE)
 		return EXIP_OK;
@@ -176,23 +241,36 @@ errorCode decodeFromFile(
 	const char *inputFilePath,
 	List *outData)
 {
-	EXIPSchema schema;
 	EXIPSchema* schemaPtr = NULL;
-	void *inputFile;
 	errorCode ret;
 
 	if (schemaPath)
 	{
-		if ((parseSchema(schemaPath, NULL, &schema) != EXIP_OK))
+		if ((acquireSchema(schemaPath, NULL, &schemaPtr) != EXIP_OK))
 		{
 			fprintf(stderr, "Unable to parse schema\n");
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			schemaPtr = &schema;
-		}
 	}
 
+	ret = decodeFromFileWithSchema(schemaPtr, outFlag, hasOptions, options, inputFilePath, outData);
+
+	if(schemaPtr != NULL)
+		releaseSchema(schemaPtr);
+	return ret;
+}
+
+errorCode decodeFromFileWithSchema(
+	EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	List *outData)
+{
+	void *inputFile;
+	errorCode ret;
+
 	inputFile = fopen(inputFilePath, "rb");
 	if (!inputFile)
 	{
@@ -201,7 +279,7 @@ errorCode decodeFromFile(
 	}
 
 	ret = decode(
-		schemaPtr,
+		schema,
 		outFlag,
 		hasOptions,
 		options,
@@ -209,10 +287,9 @@ errorCode decodeFromFile(
 		readFileInputStream,
 		NULL,
 		0,
-		outData);
+		outData,
+		NULL);
 
-	if(schemaPtr != NULL)
-		destroySchema(schemaPtr);
 	fclose(inputFile);
 	return ret;
 }
@@ -226,24 +303,37 @@ errorCode decodeFromBuffer(
 	size_t inDataLen,
 	List *outData)
 {
-	EXIPSchema schema;
 	EXIPSchema* schemaPtr = NULL;
 	errorCode ret;
 
 	if (schemaPath)
 	{
-		if ((parseSchema(schemaPath, NULL, &schema) != EXIP_OK))
+		if ((acquireSchema(schemaPath, NULL, &schemaPtr) != EXIP_OK))
 		{
 			fprintf(stderr, "Unable to parse schema\n");
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			schemaPtr = &schema;
-		}
 	}
 
-	ret = decode(
-		schemaPtr,
+	ret = decodeFromBufferWithSchema(schemaPtr, outFlag, hasOptions, options, inData, inDataLen, outData);
+
+	if(schemaPtr != NULL)
+		releaseSchema(schemaPtr);
+
+	return ret;
+}
+
+errorCode decodeFromBufferWithSchema(
+	EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	void *inData,
+	size_t inDataLen,
+	List *outData)
+{
+	return decode(
+		schema,
 		outFlag,
 		hasOptions,
 		options,
@@ -251,14 +341,44 @@ errorCode decodeFromBuffer(
 		NULL,
 		inData,
 		inDataLen,
-		outData);
+		outData,
+		NULL);
+}
 
-	if(schemaPtr != NULL)
-		destroySchema(schemaPtr);
+errorCode decodeEventsFromFile(
+	EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	EventVector *outEvents)
+{
+	void *inputFile;
+	errorCode ret;
+
+	inputFile = fopen(inputFilePath, "rb");
+	if (!inputFile)
+	{
+		fprintf(stderr, "Unable to open EXI file \"%s\" for parsing\n", inputFilePath);
+		return EXIP_INVALID_INPUT;
+	}
+
+	ret = decode(schema, OUT_EXI, hasOptions, options, inputFile, readFileInputStream, NULL, 0, NULL, outEvents);
 
+	fclose(inputFile);
 	return ret;
 }
 
+errorCode decodeEventsFromBuffer(
+	EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	void *inData,
+	size_t inDataLen,
+	EventVector *outEvents)
+{
+	return decode(schema, OUT_EXI, hasOptions, options, NULL, NULL, inData, inDataLen, NULL, outEvents);
+}
+
 /**
  * @brief Update the last attribute located on the List tail if isAttribute is true.
  * Otherwise, add a new entry to the list.
@@ -311,9 +431,9 @@ static errorCode updateListLastAttribute(unsigned char isAttribute, List *list,
 static errorCode sample_fatalError(const errorCode code, const char *msg, void *app_data)
 {
 	char err_msg[128];
-	sprintf(err_msg, "\n%d : FATAL ERROR: %s\n", code, msg);
-	printf("%s", err_msg);
 	struct appData *appD = (struct appData *)app_data;
+	sprintf(err_msg, "\n%d : FATAL ERROR: %s\n", code, msg);
+	fprintf(stderr, "%s", err_msg);
 	pushBack(&appD->outData, err_msg, strlen(msg));
 	return EXIP_HANDLER_STOP;
 }
@@ -327,7 +447,7 @@ static errorCode sample_startDocument(void *app_data)
 	else if (appD->outputFormat == OUT_XML)
 		sprintf(msg, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
 
-	printf("%s\n", msg);
+	ECHO_PRINTF(appD, "%s\n", msg);
 	pushBack(&appD->outData, msg, strlen(msg));
 	return EXIP_OK;
 }
@@ -341,7 +461,7 @@ static errorCode sample_endDocument(void *app_data)
 	else if (appD->outputFormat == OUT_XML)
 		sprintf(msg, " ");
 
-	printf("%s\n", msg);
+	ECHO_PRINTF(appD, "%s\n", msg);
 	pushBack(&appD->outData, msg, strlen(msg));
 	return EXIP_OK;
 }
@@ -355,19 +475,19 @@ static errorCode sample_startElement(QName qname, void *app_data)
 
 	if (appD->outputFormat == OUT_EXI)
 	{
-		printf("SE ");
+		ECHO_PRINTF(appD, "SE ");
 		sprintf(msg, "SE ");
 		msgIdx += 3;
-		printString(qname.uri);
+		ECHO_STRING(appD, qname.uri);
 		sPrintString(msg + msgIdx, qname.uri);
 		msgIdx = strlen(msg);
-		printf(" ");
+		ECHO_PRINTF(appD, " ");
 		sprintf(msg + msgIdx, " ");
 		msgIdx++;
-		printString(qname.localName);
+		ECHO_STRING(appD, qname.localName);
 		sPrintString(msg + msgIdx, qname.localName);
 		msgIdx = strlen(msg);
-		printf("\n");
+		ECHO_PRINTF(appD, "\n");
 	}
 	else if (appD->outputFormat == OUT_XML)
 	{
@@ -395,7 +515,7 @@ static errorCode sample_startElement(QName qname, void *app_data)
 		push(&(appD->stack), createElement(appD->nameBuf));
 		if (appD->unclosedElement)
 		{
-			printf(">\n");
+			ECHO_PRINTF(appD, ">\n");
 			// sprintf(msg, ">\n");
 			// msgIdx++;
 			tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">\n");
@@ -404,19 +524,19 @@ static errorCode sample_startElement(QName qname, void *app_data)
 				return tmp_err_code;
 			}
 		}
-		printf("<%s", appD->nameBuf);
+		ECHO_PRINTF(appD, "<%s", appD->nameBuf);
 		sprintf(msg + msgIdx, "<%s", appD->nameBuf);
 		msgIdx += strlen(appD->nameBuf) + 1;
 
 		if (prxHit == 0)
 		{
 			sprintf(appD->nameBuf, " xmlns:p%d=\"", prefixIndex);
-			printf("%s", appD->nameBuf);
+			ECHO_PRINTF(appD, "%s", appD->nameBuf);
 			sprintf(msg + msgIdx, "%s", appD->nameBuf);
 			msgIdx += strlen(appD->nameBuf);
 
-			printString(qname.uri);
-			printf("\"");
+			ECHO_STRING(appD, qname.uri);
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "%.*s\"", (int)qname.uri->length, qname.uri->str);
 		}
 
@@ -427,6 +547,20 @@ static errorCode sample_startElement(QName qname, void *app_data)
 	return EXIP_OK;
 }
 
+static errorCode sample_selfContained(void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+
+	// Reported in the EXI event form only: the XML form has no self-contained elements
+	if (appD->outputFormat == OUT_EXI)
+	{
+		ECHO_PRINTF(appD, "SC\n");
+		pushBack(&appD->outData, "SC", 2);
+	}
+
+	return EXIP_OK;
+}
+
 static errorCode sample_endElement(void *app_data)
 {
 	char msg[128];
@@ -437,7 +571,7 @@ static errorCode sample_endElement(void *app_data)
 	if (appD->outputFormat == OUT_EXI)
 	{
 		sprintf(msg, "EE");
-		printf("%s\n", msg);
+		ECHO_PRINTF(appD, "%s\n", msg);
 	}
 	else if (appD->outputFormat == OUT_XML)
 	{
@@ -445,7 +579,7 @@ static errorCode sample_endElement(void *app_data)
 
 		if (appD->unclosedElement)
 		{
-			printf(">\n");
+			ECHO_PRINTF(appD, ">\n");
 			// sprintf(msg, ">\n");
 			// msgIdx++;
 			tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -456,7 +590,7 @@ static errorCode sample_endElement(void *app_data)
 		}
 		appD->unclosedElement = 0;
 		el = pop(&(appD->stack));
-		printf("</%s>\n", el->name);
+		ECHO_PRINTF(appD, "</%s>\n", el->name);
 		sprintf(msg + msgIdx, "</%s>", el->name);
 		destroyElement(el);
 	}
@@ -472,45 +606,45 @@ static errorCode sample_attribute(QName qname, void *app_data)
 	struct appData *appD = (struct appData *)app_data;
 	if (appD->outputFormat == OUT_EXI)
 	{
-		printf("AT ");
+		ECHO_PRINTF(appD, "AT ");
 		sprintf(msg + msgIdx, "AT ");
 		msgIdx += 3;
-		printString(qname.uri);
+		ECHO_STRING(appD, qname.uri);
 		sPrintString(msg + msgIdx, qname.uri);
 		msgIdx = strlen(msg);
 		if (qname.uri->length > 0)
 		{
-			printf(" ");
+			ECHO_PRINTF(appD, " ");
 			sprintf(msg + msgIdx, " ");
 			msgIdx++;	
 		}
-		printString(qname.localName);
+		ECHO_STRING(appD, qname.localName);
 		sPrintString(msg + msgIdx, qname.localName);
 		msgIdx = strlen(msg);
-		printf("=\"");
+		ECHO_PRINTF(appD, "=\"");
 		sprintf(msg + msgIdx, "=\"");
 	}
 	else if (appD->outputFormat == OUT_XML)
 	{
-		printf(" ");
+		ECHO_PRINTF(appD, " ");
 		sprintf(msg + msgIdx, " ");
 		msgIdx++;
 		if (!isStringEmpty(qname.uri))
 		{
-			printString(qname.uri);
+			ECHO_STRING(appD, qname.uri);
 			sPrintString(msg + msgIdx, qname.uri);
 			msgIdx = strlen(msg);
 			if (qname.uri->length > 0)
 			{
-				printf(":");
+				ECHO_PRINTF(appD, ":");
 				sprintf(msg + msgIdx, ":");
 				msgIdx++;	
 			}
 		}
-		printString(qname.localName);
+		ECHO_STRING(appD, qname.localName);
 		sPrintString(msg + msgIdx, qname.localName);
 		msgIdx = strlen(msg);
-		printf("=\"");
+		ECHO_PRINTF(appD, "=\"");
 		sprintf(msg + msgIdx, "=\"");
 	}
 	appD->expectAttributeData = 1;
@@ -531,33 +665,33 @@ static errorCode sample_stringData(const String value, void *app_data)
 	{
 		if (appD->expectAttributeData)
 		{
-			printString(&value);
+			ECHO_STRING(appD, &value);
 			sPrintString(msg + msgIdx, &value);
 			msgIdx = strlen(msg);
-			printf("\"\n");
+			ECHO_PRINTF(appD, "\"\n");
 			sprintf(msg + msgIdx, "\"");
 			msgIdx += 1;
 			appD->expectAttributeData = 0;
 		}
 		else
 		{
-			printf("CH ");
+			ECHO_PRINTF(appD, "CH ");
 			sprintf(msg + msgIdx, "CH ");
 			msgIdx += 3;
-			printString(&value);
+			ECHO_STRING(appD, &value);
 			sPrintString(msg + msgIdx, &value);
 			msgIdx = strlen(msg);
-			printf("\n");
+			ECHO_PRINTF(appD, "\n");
 		}
 	}
 	else if (appD->outputFormat == OUT_XML)
 	{
 		if (appD->expectAttributeData)
 		{
-			printString(&value);
+			ECHO_STRING(appD, &value);
 			sPrintString(msg + msgIdx, &value);
 			msgIdx = strlen(msg);
-			printf("\"");
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "\"");
 			appD->expectAttributeData = 0;
 		}
@@ -565,7 +699,7 @@ static errorCode sample_stringData(const String value, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -575,7 +709,7 @@ static errorCode sample_stringData(const String value, void *app_data)
 				}
 			}
 			appD->unclosedElement = 0;
-			printString(&value);
+			ECHO_STRING(appD, &value);
 			sPrintString(msg + msgIdx, &value);
 			msgIdx = strlen(msg);
 		}
@@ -609,19 +743,19 @@ static errorCode sample_intData(Integer int_val, void *app_data)
 		if (appD->expectAttributeData)
 		{
 			sprintf(tmp_buf, "%lld", (long long int)int_val);
-			printf("%s", tmp_buf);
-			printf("\"\n");
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\"\n");
 			sprintf(msg + msgIdx, "%s\"", tmp_buf);
 			msgIdx = strlen(msg);
 			appD->expectAttributeData = 0;
 		}
 		else
 		{
-			printf("CH ");
+			ECHO_PRINTF(appD, "CH ");
 			sprintf(tmp_buf, "%lld", (long long int)int_val);
-			printf("%s", tmp_buf);
-			printf("\n");
-			sprintf(msg + msgIdx, "CH %s\"", tmp_buf);
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\n");
+			sprintf(msg + msgIdx, "CH %s", tmp_buf);
 			msgIdx = strlen(msg);
 		}
 	}
@@ -630,8 +764,8 @@ static errorCode sample_intData(Integer int_val, void *app_data)
 		if (appD->expectAttributeData)
 		{
 			sprintf(tmp_buf, "%lld", (long long int)int_val);
-			printf("%s", tmp_buf);
-			printf("\"");
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "%s\"", tmp_buf);
 			msgIdx = strlen(msg);
 			appD->expectAttributeData = 0;
@@ -640,7 +774,7 @@ static errorCode sample_intData(Integer int_val, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -651,7 +785,7 @@ static errorCode sample_intData(Integer int_val, void *app_data)
 			}
 			appD->unclosedElement = 0;
 			sprintf(tmp_buf, "%lld", (long long int)int_val);
-			printf("%s", tmp_buf);
+			ECHO_PRINTF(appD, "%s", tmp_buf);
 			sprintf(msg + msgIdx, "%s", tmp_buf);
 			msgIdx = strlen(msg);
 		}
@@ -679,13 +813,13 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data)
 		{
 			if (bool_val)
 			{
-				printf("true\"\n");
+				ECHO_PRINTF(appD, "true\"\n");
 				sprintf(msg + msgIdx, "true\"");
 				msgIdx += 6;
 			}
 			else
 			{
-				printf("false\"\n");
+				ECHO_PRINTF(appD, "false\"\n");
 				sprintf(msg + msgIdx, "false\"");
 				msgIdx += 7;
 			}
@@ -694,16 +828,16 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data)
 		}
 		else
 		{
-			printf("CH ");
+			ECHO_PRINTF(appD, "CH ");
 			if (bool_val)
 			{
-				printf("true\n");
+				ECHO_PRINTF(appD, "true\n");
 				sprintf(msg + msgIdx, "CH true");
 				msgIdx += 9;
 			}
 			else
 			{
-				printf("false\n");
+				ECHO_PRINTF(appD, "false\n");
 				sprintf(msg + msgIdx, "CH false");
 				msgIdx += 10;
 			}
@@ -715,13 +849,13 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data)
 		{
 			if (bool_val)
 			{
-				printf("true\"");
+				ECHO_PRINTF(appD, "true\"");
 				sprintf(msg + msgIdx, "true\"");
 				msgIdx += 6;
 			}
 			else
 			{
-				printf("false\"");
+				ECHO_PRINTF(appD, "false\"");
 				sprintf(msg + msgIdx, "false\"");
 				msgIdx += 7;
 			}
@@ -731,7 +865,7 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -744,13 +878,13 @@ static errorCode sample_booleanData(boolean bool_val, void *app_data)
 
 			if (bool_val)
 			{
-				printf("true");
+				ECHO_PRINTF(appD, "true");
 				sprintf(msg + msgIdx, "true");
 				msgIdx += 5;
 			}
 			else
 			{
-				printf("false");
+				ECHO_PRINTF(appD, "false");
 				sprintf(msg + msgIdx, "false");
 				msgIdx += 6;
 			}
@@ -779,18 +913,18 @@ static errorCode sample_floatData(Float fl_val, void *app_data)
 		if (appD->expectAttributeData)
 		{
 			sprintf(tmp_buf, "%lldE%d", (long long int)fl_val.mantissa, fl_val.exponent);
-			printf("%s", tmp_buf);
-			printf("\"\n");
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\"\n");
 			sprintf(msg + msgIdx, "%s\"", tmp_buf);
 			msgIdx = strlen(msg);
 			appD->expectAttributeData = 0;
 		}
 		else
 		{
-			printf("CH ");
+			ECHO_PRINTF(appD, "CH ");
 			sprintf(tmp_buf, "%lldE%d", (long long int)fl_val.mantissa, fl_val.exponent);
-			printf("%s", tmp_buf);
-			printf("\n");
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\n");
 			sprintf(msg + msgIdx, "CH %s", tmp_buf);
 			msgIdx = strlen(msg);
 		}
@@ -800,8 +934,8 @@ static errorCode sample_floatData(Float fl_val, void *app_data)
 		if (appD->expectAttributeData)
 		{
 			sprintf(tmp_buf, "%lldE%d", (long long int)fl_val.mantissa, fl_val.exponent);
-			printf("%s", tmp_buf);
-			printf("\"");
+			ECHO_PRINTF(appD, "%s", tmp_buf);
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "%s\"", tmp_buf);
 			msgIdx = strlen(msg);
 			appD->expectAttributeData = 0;
@@ -810,7 +944,7 @@ static errorCode sample_floatData(Float fl_val, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -821,7 +955,7 @@ static errorCode sample_floatData(Float fl_val, void *app_data)
 			}
 			appD->unclosedElement = 0;
 			sprintf(tmp_buf, "%lldE%d", (long long int)fl_val.mantissa, fl_val.exponent);
-			printf("%s", tmp_buf);
+			ECHO_PRINTF(appD, "%s", tmp_buf);
 			sprintf(msg + msgIdx, "%s", tmp_buf);
 			msgIdx = strlen(msg);
 		}
@@ -888,11 +1022,11 @@ static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data)
 	{
 		if (appD->expectAttributeData)
 		{
-			printf("%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
+			ECHO_PRINTF(appD, "%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
 				   dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
 				   dt_val.dateTime.tm_hour, dt_val.dateTime.tm_min,
 				   dt_val.dateTime.tm_sec, fsecBuf, tzBuf);
-			printf("\"\n");
+			ECHO_PRINTF(appD, "\"\n");
 			sprintf(msg + msgIdx, "%04d-%02d-%02dT%02d:%02d:%02d%s%s\"",
 					dt_val.dateTime.tm_year + 1900,
 					dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
@@ -903,12 +1037,12 @@ static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data)
 		}
 		else
 		{
-			printf("CH ");
-			printf("%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
+			ECHO_PRINTF(appD, "CH ");
+			ECHO_PRINTF(appD, "%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
 				   dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
 				   dt_val.dateTime.tm_hour, dt_val.dateTime.tm_min,
 				   dt_val.dateTime.tm_sec, fsecBuf, tzBuf);
-			printf("\n");
+			ECHO_PRINTF(appD, "\n");
 			sprintf(msg + msgIdx, "CH %04d-%02d-%02dT%02d:%02d:%02d%s%s",
 					dt_val.dateTime.tm_year + 1900,
 					dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
@@ -921,11 +1055,11 @@ static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data)
 	{
 		if (appD->expectAttributeData)
 		{
-			printf("%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
+			ECHO_PRINTF(appD, "%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
 				   dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
 				   dt_val.dateTime.tm_hour, dt_val.dateTime.tm_min,
 				   dt_val.dateTime.tm_sec, fsecBuf, tzBuf);
-			printf("\"");
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "%04d-%02d-%02dT%02d:%02d:%02d%s%s\"",
 					dt_val.dateTime.tm_year + 1900,
 					dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
@@ -938,7 +1072,7 @@ static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -948,7 +1082,7 @@ static errorCode sample_dateTimeData(EXIPDateTime dt_val, void *app_data)
 				}
 			}
 			appD->unclosedElement = 0;
-			printf("%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
+			ECHO_PRINTF(appD, "%04d-%02d-%02dT%02d:%02d:%02d%s%s", dt_val.dateTime.tm_year + 1900,
 				   dt_val.dateTime.tm_mon + 1, dt_val.dateTime.tm_mday,
 				   dt_val.dateTime.tm_hour, dt_val.dateTime.tm_min,
 				   dt_val.dateTime.tm_sec, fsecBuf, tzBuf);
@@ -983,19 +1117,19 @@ static errorCode sample_binaryData(const char *binary_val, Index nbytes, void *a
 		{
 			for (size_t i = 0; i < nbytes; i++)
 			{
-				printf("%02X", (char)*binary_val);
+				ECHO_PRINTF(appD, "%02X", (char)*binary_val);
 				sprintf(msg + msgIdx, "%02X", (char)*binary_val);
 				msgIdx = strlen(msg);
 			}
-			printf(" [%d bytes]", (int)nbytes);
-			printf("\"\n");
+			ECHO_PRINTF(appD, " [%d bytes]", (int)nbytes);
+			ECHO_PRINTF(appD, "\"\n");
 			appD->expectAttributeData = 0;
 		}
 		else
 		{
-			printf("CH ");
-			printf("%02X [%d bytes]", (char)*binary_val, (int)nbytes);
-			printf("\n");
+			ECHO_PRINTF(appD, "CH ");
+			ECHO_PRINTF(appD, "%02X [%d bytes]", (char)*binary_val, (int)nbytes);
+			ECHO_PRINTF(appD, "\n");
 			sprintf(msg + msgIdx, "%02X", (char)*binary_val);
 			msgIdx = strlen(msg);
 		}
@@ -1004,8 +1138,8 @@ static errorCode sample_binaryData(const char *binary_val, Index nbytes, void *a
 	{
 		if (appD->expectAttributeData)
 		{
-			printf("%02X [%d bytes]", (char)*binary_val, (int)nbytes);
-			printf("\"");
+			ECHO_PRINTF(appD, "%02X [%d bytes]", (char)*binary_val, (int)nbytes);
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "%02X", (char)*binary_val);
 			msgIdx = strlen(msg);
 			appD->expectAttributeData = 0;
@@ -1014,7 +1148,7 @@ static errorCode sample_binaryData(const char *binary_val, Index nbytes, void *a
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -1024,7 +1158,7 @@ static errorCode sample_binaryData(const char *binary_val, Index nbytes, void *a
 				}
 			}
 			appD->unclosedElement = 0;
-			printf("%02X [%d bytes]", (char)*binary_val, (int)nbytes);
+			ECHO_PRINTF(appD, "%02X [%d bytes]", (char)*binary_val, (int)nbytes);
 			sprintf(msg + msgIdx, "%02X\"", (char)*binary_val);
 			msgIdx = strlen(msg);
 		}
@@ -1050,50 +1184,50 @@ static errorCode sample_qnameData(const QName qname, void *app_data)
 	{
 		if (appD->expectAttributeData)
 		{
-			printString(qname.uri);
+			ECHO_STRING(appD, qname.uri);
 			sPrintString(msg + msgIdx, qname.uri);
 			msgIdx = strlen(msg);
-			printf(":");
+			ECHO_PRINTF(appD, ":");
 			sprintf(msg + msgIdx, ":");
 			msgIdx++;
-			printString(qname.localName);
+			ECHO_STRING(appD, qname.localName);
 			sPrintString(msg + msgIdx, qname.localName);
 			msgIdx = strlen(msg);
-			printf("\"\n");
+			ECHO_PRINTF(appD, "\"\n");
 			sprintf(msg + msgIdx, "\"");
 			appD->expectAttributeData = 0;
 		}
 		else
 		{
-			printf("QNAME ");
+			ECHO_PRINTF(appD, "QNAME ");
 			sprintf(msg + msgIdx, "QNAME ");
 			msgIdx += 6;
-			printString(qname.uri);
+			ECHO_STRING(appD, qname.uri);
 			sPrintString(msg + msgIdx, qname.uri);
 			msgIdx = strlen(msg);
-			printf(":");
+			ECHO_PRINTF(appD, ":");
 			sprintf(msg + msgIdx, ":");
 			msgIdx++;
-			printString(qname.localName);
+			ECHO_STRING(appD, qname.localName);
 			sPrintString(msg + msgIdx, qname.localName);
 			msgIdx = strlen(msg);
-			printf("\n");
+			ECHO_PRINTF(appD, "\n");
 		}
 	}
 	else if (appD->outputFormat == OUT_XML)
 	{
 		if (appD->expectAttributeData)
 		{
-			printString(qname.uri);
+			ECHO_STRING(appD, qname.uri);
 			sPrintString(msg + msgIdx, qname.uri);
 			msgIdx = strlen(msg);
-			printf(":");
+			ECHO_PRINTF(appD, ":");
 			sprintf(msg + msgIdx, ":");
 			msgIdx++;
-			printString(qname.localName);
+			ECHO_STRING(appD, qname.localName);
 			sPrintString(msg + msgIdx, qname.localName);
 			msgIdx = strlen(msg);
-			printf("\"");
+			ECHO_PRINTF(appD, "\"");
 			sprintf(msg + msgIdx, "\"");
 			appD->expectAttributeData = 0;
 		}
@@ -1101,7 +1235,7 @@ static errorCode sample_qnameData(const QName qname, void *app_data)
 		{
 			if (appD->unclosedElement)
 			{
-				printf(">");
+				ECHO_PRINTF(appD, ">");
 				// sprintf(msg + msgIdx, ">");
 				// msgIdx++;
 				tmp_err_code = updateListLastAttribute(1, &(appD->outData), ">");
@@ -1111,13 +1245,13 @@ static errorCode sample_qnameData(const QName qname, void *app_data)
 				}
 			}
 			appD->unclosedElement = 0;
-			printString(qname.uri);
+			ECHO_STRING(appD, qname.uri);
 			sPrintString(msg + msgIdx, qname.uri);
 			msgIdx = strlen(msg);
-			printf(":");
+			ECHO_PRINTF(appD, ":");
 			sprintf(msg + msgIdx, ":");
 			msgIdx++;
-			printString(qname.localName);
+			ECHO_STRING(appD, qname.localName);
 			sPrintString(msg + msgIdx, qname.localName);
 			msgIdx = strlen(msg);
 		}
@@ -1131,6 +1265,153 @@ static errorCode sample_qnameData(const QName qname, void *app_data)
 	return EXIP_OK;
 }
 
+static errorCode addKindEvent(struct appData *appD, EventKind kind)
+{
+	CodecEvent event;
+
+	event.kind = kind;
+	event.id = INDEX_MAX;
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_fatalError(const errorCode code, const char *msg, void *app_data)
+{
+	fprintf(stderr, "\n%d : FATAL ERROR: %s\n", code, msg);
+	return EXIP_HANDLER_STOP;
+}
+
+static errorCode vector_startDocument(void *app_data)
+{
+	return addKindEvent((struct appData *)app_data, EV_START_DOCUMENT);
+}
+
+static errorCode vector_endDocument(void *app_data)
+{
+	return addKindEvent((struct appData *)app_data, EV_END_DOCUMENT);
+}
+
+static errorCode vector_startElement(QName qname, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_START_ELEMENT;
+	TRY(internEventName(appD->events, qname.uri, qname.localName, &event.id));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_endElement(void *app_data)
+{
+	return addKindEvent((struct appData *)app_data, EV_END_ELEMENT);
+}
+
+static errorCode vector_attribute(QName qname, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_ATTRIBUTE;
+	TRY(internEventName(appD->events, qname.uri, qname.localName, &event.id));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_stringData(const String value, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_STRING;
+	event.id = INDEX_MAX;
+	TRY(addEventString(appD->events, value.str, value.length*sizeof(CharType), &event.value.str));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_decimalData(Decimal value, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	CodecEvent event;
+
+	event.kind = EV_DECIMAL;
+	event.id = INDEX_MAX;
+	event.value.floatVal = value;
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_intData(Integer int_val, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	CodecEvent event;
+
+	event.kind = EV_INT;
+	event.id = INDEX_MAX;
+	event.value.intVal = int_val;
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_floatData(Float fl_val, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	CodecEvent event;
+
+	event.kind = EV_FLOAT;
+	event.id = INDEX_MAX;
+	event.value.floatVal = fl_val;
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_booleanData(boolean bool_val, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	CodecEvent event;
+
+	event.kind = EV_BOOLEAN;
+	event.id = INDEX_MAX;
+	event.value.boolVal = bool_val;
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_dateTimeData(EXIPDateTime dt_val, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_DATE_TIME;
+	TRY(addEventDateTime(appD->events, &dt_val, &event.id));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_binaryData(const char *binary_val, Index nbytes, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_BINARY;
+	event.id = INDEX_MAX;
+	TRY(addEventString(appD->events, binary_val, nbytes, &event.value.str));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_qnameData(const QName qname, void *app_data)
+{
+	struct appData *appD = (struct appData *)app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	CodecEvent event;
+
+	event.kind = EV_QNAME;
+	TRY(internEventName(appD->events, qname.uri, qname.localName, &event.id));
+	return addEvent(appD->events, &event);
+}
+
+static errorCode vector_selfContained(void *app_data)
+{
+	return addKindEvent((struct appData *)app_data, EV_SELF_CONTAINED);
+}
+
 // Stuff needed for the OUT_XML Output Format
 // ******************************************
 static void push(struct element **stack, struct element *el)
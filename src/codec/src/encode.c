@@ -14,14 +14,17 @@
 #include "codec_common.h"
 #include "EXISerializer.h"
 #include "stringManipulate.h"
-#include "parseSchema.h"
+#include "schemaCache.h"
 #include <stdio.h>
 #include <string.h>
 #include "../../grammarGen/include/grammarGenerator.h"
 #include "headerEncode.h"
+#include "lexicalValue.h"
 
 #define OUTPUT_BUFFER_SIZE 200
 #define MAX_ATTRIBUTE_LENGTH 64
+#define MAX_INPUT_LINE_LENGTH 512
+#define XSI_NAMESPACE "http://www.w3.org/2001/XMLSchema-instance"
 
 const String NS_STR = {"http://www.ltu.se/EISLAB/schema-test", 36};
 const String NS_NESTED_STR = {"http://www.ltu.se/EISLAB/nested-xsd", 35};
@@ -55,10 +58,24 @@ const String ATTR_ID_STR = {"id", 2};
 
 #define TRY_CATCH_ENCODE(func) TRY_CATCH(func, serialize.closeEXIStream(&testStrm))
 
+/**
+ * @brief Checks if the input line starts with the event code token code,
+ * followed by a space or the end of the line
+ */
+static boolean isEventLine(const char *data, const char *code)
+{
+	size_t len = strlen(code);
+
+	if (strncmp(data, code, len) != 0)
+		return FALSE;
+
+	return data[len] == '\0' || data[len] == ' ' || data[len] == '\n' || data[len] == '\r';
+}
+
 errorCode read_startDocument(unsigned char inFlag, const char *data)
 {
 	if (inFlag == IN_EXI)
-		return strstr(data, "SD") != NULL ? EXIP_OK : EXIP_INVALID_INPUT;
+		return isEventLine(data, "SD") ? EXIP_OK : EXIP_INVALID_INPUT;
 	else if (inFlag == IN_XML)
 		return strcmp(data,  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n") == 0 ? EXIP_OK : EXIP_INVALID_INPUT;
 	else 
@@ -72,7 +89,7 @@ errorCode read_endDocument(unsigned char inFlag, const char *data)
 	}
 
 	if (inFlag == IN_EXI)
-		return strstr(data, "ED") != NULL ? EXIP_OK : EXIP_INVALID_INPUT;
+		return isEventLine(data, "ED") ? EXIP_OK : EXIP_INVALID_INPUT;
 	else if (inFlag == IN_XML)
 		return EXIP_OK;
 	else 
@@ -100,13 +117,10 @@ errorCode read_startElement(unsigned char inFlag, const char *data, String *uri,
 
 	if (inFlag== IN_EXI)
 	{
-		strPtr = strstr(data, "SE ");
-		if (strPtr == NULL) {
+		if (!isEventLine(data, "SE")) {
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			strPtr += 3;
-		}
+		strPtr = (char*) data + 3;
 
 		// Checks if there is some Uri element
 		localNamePtr = strstr(strPtr, " ");
@@ -118,7 +132,7 @@ errorCode read_startElement(unsigned char inFlag, const char *data, String *uri,
 		else {
 			// Has Uri
 			localNamePtr++; // Remove the space
-			strLen = strlen(strPtr) - strlen(localNamePtr);
+			strLen = strlen(strPtr) - strlen(localNamePtr) - 1; // The Uri ends before the space
 			strncpy(tmp_uri, strPtr, strLen);
 			strLen = strlen(localNamePtr);
 			strncpy(tmp_localName, localNamePtr, strLen);
@@ -166,7 +180,7 @@ errorCode read_endElement(unsigned char inFlag, const char *data)
 
 	if (inFlag == IN_EXI)
 	{
-		return strstr(data, "EE") != NULL ? EXIP_OK : EXIP_INVALID_INPUT;
+		return isEventLine(data, "EE") ? EXIP_OK : EXIP_INVALID_INPUT;
 	}
 	else if (inFlag == IN_XML)
 	{
@@ -187,15 +201,13 @@ errorCode read_endElement(unsigned char inFlag, const char *data)
 	}
 }
 
-errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, String *localName, EXITypeClass *valueType)
+errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, String *localName, String *attrValue)
 {
 	char* strPtr = NULL;
 	char* localNamePtr = NULL;
 	char* attPtr = NULL;
-	char attribute[MAX_ATTRIBUTE_LENGTH];
 	char tmp_uri[MAX_ATTRIBUTE_LENGTH];
 	char tmp_localName[MAX_ATTRIBUTE_LENGTH];
-	memset(attribute, 0, MAX_ATTRIBUTE_LENGTH);
 	memset(tmp_uri, 0, MAX_ATTRIBUTE_LENGTH);
 	memset(tmp_localName, 0, MAX_ATTRIBUTE_LENGTH);
 
@@ -218,13 +230,10 @@ errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, St
 
 	if (inFlag== IN_EXI)
 	{
-		strPtr = strstr(data, "AT ");
-		if (strPtr == NULL) {
+		if (!isEventLine(data, "AT")) {
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			strPtr += 3;
-		}
+		strPtr = (char*) data + 3;
 
 		attPtr = strstr(data, "=\"");
 		if (attPtr == NULL) 
@@ -235,10 +244,6 @@ errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, St
 		else
 		{
 			attPtr += 2;
-			strcpy(attribute, attPtr);
-			strLen = strlen(attribute);
-			// Remove the quotes
-			attribute[strLen-1] = '\0';
 		}
 
 		// Checks if there is some Uri element
@@ -254,7 +259,7 @@ errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, St
 		{
 			// Has Uri
 			localNamePtr++; // Remove the space
-			strLen = strlen(strPtr) - strlen(localNamePtr);
+			strLen = strlen(strPtr) - strlen(localNamePtr) - 1; // The Uri ends before the space
 			strncpy(tmp_uri, strPtr, strLen);
 			strLen = strlen(localNamePtr) - strlen(attPtr) - 2; // Removes the `=` and the quote
 			strncpy(tmp_localName, localNamePtr, strLen);
@@ -281,17 +286,12 @@ errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, St
 		else
 		{
 			attPtr += 2;
-			strcpy(attribute, attPtr);
-			strLen = strlen(attribute);
-			// Remove the quotes
-			attribute[strLen-1] = '\0';
 		}
 
 		// Checks if there is some Uri element
 		localNamePtr = strstr(data, ":");
 		if (localNamePtr == NULL) {
 			// No Uri
-			strLen = strlen(data) - strLen;
 			TRY(asciiToString(strPtr, localName, TRUE));
 		}
 		else {
@@ -308,36 +308,33 @@ errorCode read_attribute(unsigned char inFlag, const char *data, String *uri, St
 	else 
 		return EXIP_INVALID_INPUT;
 
+	// The value is not copied: it points to the characters of data without the closing quote
+	attrValue->str = (CharType*) attPtr;
+	attrValue->length = strlen(attPtr);
+	if (attrValue->length > 0 && attPtr[attrValue->length - 1] == '"')
+		attrValue->length--;
+
 	return EXIP_OK;
 }
 
 errorCode read_stringData(unsigned char inFlag, const char *data, String *chVal) {
 	char* strPtr = NULL;
-	size_t strLen = 0;
-	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
-
-	// Clears output parameters
-	if (!isStringEmpty(chVal)) {
-		clearString(chVal);
-	}
 
 	if (inFlag== IN_EXI)
 	{
-		strPtr = strstr(data, "CH ");
-		if (strPtr == NULL) {
+		if (!isEventLine(data, "CH")) {
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			strPtr += 3;
-		}
+		strPtr = (char*) data + (data[2] == ' ' ? 3 : 2);
 
-		strLen = strlen(data) - strLen;
-		TRY(asciiToString(strPtr, chVal, TRUE));
+		// The value is not copied: it points to the characters of data
+		chVal->str = (CharType*) strPtr;
+		chVal->length = strlen(strPtr);
 	}
 	else if (inFlag== IN_XML)
 	{
-		strLen = strlen(data) - strLen;
-		TRY(asciiToString(strPtr, chVal, TRUE));
+		chVal->str = (CharType*) data;
+		chVal->length = strlen(data);
 	}
 	else 
 		return EXIP_INVALID_INPUT;
@@ -366,9 +363,58 @@ errorCode read_EntityReference(unsigned char inFlag, const char *data, String *u
 }
 
 errorCode read_selfContained(unsigned char inFlag, const char *data, String *uri, String *localName) {
+	if (inFlag == IN_EXI)
+		return isEventLine(data, "SC") ? EXIP_OK : EXIP_INVALID_INPUT;
+
 	return EXIP_NOT_IMPLEMENTED_YET;
 }
 
+/**
+ * @brief Serializes a CH or AT value of the input with the serializer function of
+ * its value type class. The QName values are given as uri:localName
+ */
+static errorCode encodeValue(EXIStream *strm, EXITypeClass valueType, String value)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	if (valueType == VALUE_TYPE_QNAME_CLASS)
+	{
+		String uri = EMPTY_STRING;
+		String ln = value;
+		QName qname = {&uri, &ln, NULL};
+		Index i;
+
+		// The URI itself may contain ':' so the local name follows the last one
+		for (i = value.length; i > 0; i--)
+		{
+			if (value.str[i - 1] == ':')
+			{
+				uri.str = value.str;
+				uri.length = i - 1;
+				ln.str = value.str + i;
+				ln.length = value.length - i;
+				break;
+			}
+		}
+
+		return serialize.qnameData(strm, qname);
+	}
+	else if (valueType == VALUE_TYPE_BINARY_CLASS)
+	{
+		// Binary values are decoded in place so the input line is not used directly
+		char *bytes = malloc(value.length + 1);
+
+		if (bytes == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(bytes, value.str, value.length);
+		tmp_err_code = serializeLexicalValue(strm, valueType, bytes, value.length);
+		free(bytes);
+		return tmp_err_code;
+	}
+
+	return serializeLexicalValue(strm, valueType, value.str, value.length);
+}
+
 static errorCode encode(
 	EXIPSchema *schemaPtr,
 	unsigned char inFlag,
@@ -391,7 +437,8 @@ static errorCode encode(
 	char buf[OUTPUT_BUFFER_SIZE];
 	BinaryBuffer buffer;
 	EXITypeClass valueType;
-	size_t listIdx = 0;
+	// The value type of the content of the current element
+	EXITypeClass chValueType = VALUE_TYPE_NONE_CLASS;
 	Node *entry;
 
 	buffer.buf = buf;
@@ -426,51 +473,49 @@ static errorCode encode(
 	// V: Start building the stream step by step: header, document, element etc...
 	TRY_CATCH_ENCODE(serialize.exiHeader(&testStrm));
 
-	while(listIdx < inData->size) {
-		entry = getNth(inData, listIdx);
-		if(listIdx == 0 && read_startDocument(inFlag, (const char *)entry->data) == EXIP_OK)
+	for(entry = inData->head; entry != NULL; entry = entry->next) {
+		if(entry == inData->head && read_startDocument(inFlag, (const char *)entry->data) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.startDocument(&testStrm));
-			listIdx++;
 		}
 		else if(read_endDocument(inFlag, (const char *)entry->data) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.endDocument(&testStrm));
+			// closeEXIStream() flushes the buffer to bufStrm but keeps it
+			TRY_CATCH_ENCODE(serialize.closeEXIStream(&testStrm));
 			*outDataLen = testStrm.buffer.bufStrm.bufContent;
 			*outData = testStrm.buffer.bufStrm.buf;
-			TRY_CATCH_ENCODE(serialize.closeEXIStream(&testStrm));
 			tmp_err_code = EXIP_OK;
 			break;
 		}
 		else if(read_startElement(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
-			TRY_CATCH_ENCODE(serialize.startElement(&testStrm, qname, &valueType));
-			listIdx++;
+			TRY_CATCH_ENCODE(serialize.startElement(&testStrm, qname, &chValueType));
 		}
 		else if(read_endElement(inFlag, (const char *)entry->data) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.endElement(&testStrm));
-			listIdx++;
+			chValueType = VALUE_TYPE_NONE_CLASS;
 		}
-		else if(read_attribute(inFlag, entry->data, &uri, &ln, &valueType) == EXIP_OK)
+		else if(read_attribute(inFlag, entry->data, &uri, &ln, &chVal) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.attribute(&testStrm, qname, TRUE, &valueType));
-			listIdx++;
+			// The schema-informed grammars give xsi:type the String class but its value is a QName
+			if(stringEqualToAscii(uri, XSI_NAMESPACE) && stringEqualToAscii(ln, "type"))
+				valueType = VALUE_TYPE_QNAME_CLASS;
+			TRY_CATCH_ENCODE(encodeValue(&testStrm, valueType, chVal));
 		}
 		else if(read_stringData(inFlag, entry->data, &chVal) == EXIP_OK)
 		{
-			TRY_CATCH_ENCODE(serialize.stringData(&testStrm, chVal));
-			listIdx++;
+			TRY_CATCH_ENCODE(encodeValue(&testStrm, chValueType, chVal));
 		}
 		else if(read_namespaceDeclaration(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
 			//TRY_CATCH_ENCODE(serialize.namespaceDeclaration(&testStrm, chVal));
-			listIdx++;
 		}
 		else if(read_comment(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.comment(&testStrm, chVal));
-			listIdx++;
 		}
 		else if(read_processingInstruction(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
@@ -479,27 +524,25 @@ static errorCode encode(
 		else if(read_docType(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
 			//TRY_CATCH_ENCODE(serialize.docType(&testStrm, chVal));
-			listIdx++;
 		}
 		else if(read_EntityReference(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
 			//TRY_CATCH_ENCODE(serialize.EntityReference(&testStrm));
-			listIdx++;
 		}
 		else if(read_selfContained(inFlag, entry->data, &uri, &ln) == EXIP_OK)
 		{
 			TRY_CATCH_ENCODE(serialize.selfContained(&testStrm));
-			listIdx++;
 		}
 		else {
 			*outDataLen = 0;
 			tmp_err_code = EXIP_UNEXPECTED_ERROR;
 			break;
 		}
-	};
+	}
+
+	clearString(&uri);
+	clearString(&ln);
 
-	clearString(&chVal);
-	
 	if(tmp_err_code != EXIP_OK)
 	{
 		free(buffer.bufStrm.buf);
@@ -518,25 +561,64 @@ errorCode encodeFromFile(
 	char **outData,
 	size_t *outDataLen)
 {
-	// EXIPSchema schema;
-	// EXIPSchema* schemaPtr = NULL;
-	// errorCode ret;
-
-	// if (schemaPath)
-	// {
-	// 	if ((parseSchema(schemaPath, NULL, &schema) != EXIP_OK))
-	// 	{
-	// 		fprintf(stderr, "Unable to parse schema\n");
-	// 		return EXIP_INVALID_INPUT;
-	// 	}
-	// 	else {
-	// 		schemaPtr = &schema;
-	// 	}
-	// }
-	// //return encode(schemaPtr, out_stream, writeFileOutputStream);
-
-	// destroySchema(&schema);
-	return EXIP_NOT_IMPLEMENTED_YET;
+	EXIPSchema* schemaPtr = NULL;
+	errorCode ret;
+
+	if (schemaPath)
+	{
+		if ((acquireSchema(schemaPath, NULL, &schemaPtr) != EXIP_OK))
+		{
+			fprintf(stderr, "Unable to parse schema\n");
+			return EXIP_INVALID_INPUT;
+		}
+	}
+
+	ret = encodeFromFileWithSchema(schemaPtr, outFlag, hasOptions, options, inputFilePath, outData, outDataLen);
+
+	if(schemaPtr != NULL)
+		releaseSchema(schemaPtr);
+
+	return ret;
+}
+
+errorCode encodeFromFileWithSchema(
+	EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	char **outData,
+	size_t *outDataLen)
+{
+	FILE *inputFile;
+	char line[MAX_INPUT_LINE_LENGTH];
+	List inData = newList();
+	size_t lineLen;
+	errorCode ret;
+
+	if (outFlag == IN_XML)
+		return encodeXmlFromFile(schema, hasOptions, options, inputFilePath, outData, outDataLen);
+
+	inputFile = fopen(inputFilePath, "rb");
+	if (!inputFile)
+	{
+		fprintf(stderr, "Unable to open file \"%s\" for encoding\n", inputFilePath);
+		return EXIP_INVALID_INPUT;
+	}
+
+	// One event per line
+	while (fgets(line, MAX_INPUT_LINE_LENGTH, inputFile) != NULL)
+	{
+		lineLen = strcspn(line, "\r\n");
+		if (lineLen > 0)
+			pushBack(&inData, line, lineLen);
+	}
+	fclose(inputFile);
+
+	ret = encodeFromBufferWithSchema(schema, outFlag, hasOptions, options, &inData, inData.size, outData, outDataLen);
+
+	deleteList(&inData);
+	return ret;
 }
 
 errorCode encodeFromBuffer(
@@ -549,24 +631,38 @@ errorCode encodeFromBuffer(
 	char **outData,
 	size_t *outDataLen)
 {
-	EXIPSchema schema;
 	EXIPSchema* schemaPtr = NULL;
 	errorCode ret;
 
 	if (schemaPath)
 	{
-		if ((parseSchema(schemaPath, NULL, &schema) != EXIP_OK))
+		if ((acquireSchema(schemaPath, NULL, &schemaPtr) != EXIP_OK))
 		{
 			fprintf(stderr, "Unable to parse schema\n");
 			return EXIP_INVALID_INPUT;
 		}
-		else {
-			schemaPtr = &schema;
-		}
 	}
 
-	ret = encode(
-		schemaPtr,
+	ret = encodeFromBufferWithSchema(schemaPtr, outFlag, hasOptions, options, inData, inDataLen, outData, outDataLen);
+
+	if(schemaPtr != NULL)
+		releaseSchema(schemaPtr);
+
+	return ret;
+}
+
+errorCode encodeFromBufferWithSchema(
+	EXIPSchema *schema,
+	unsigned char outFlag,
+	boolean hasOptions,
+	EXIOptions *options,
+	List *inData,
+	size_t inDataLen,
+	char **outData,
+	size_t *outDataLen)
+{
+	return encode(
+		schema,
 		outFlag,
 		hasOptions,
 		options,
@@ -577,8 +673,211 @@ errorCode encodeFromBuffer(
 		&(*outData),
 		outDataLen
 	);
+}
 
-	destroySchema(&schema);
+/** The string table IDs of a name of an EventVector, once resolved */
+struct NameHandle
+{
+	boolean resolved;
+	QNameID qnameId;
+};
 
-	return ret;
-}
\ No newline at end of file
+static QName eventName(const EventVector *events, Index nameId, String *uri, String *ln)
+{
+	QName qname = {uri, ln, NULL};
+
+	uri->str = events->strings + events->names[nameId].uri.offset;
+	uri->length = events->names[nameId].uri.length;
+	ln->str = events->strings + events->names[nameId].localName.offset;
+	ln->length = events->names[nameId].localName.length;
+
+	return qname;
+}
+
+/**
+ * @brief Serializes an SE or AT event with the IDs of its name when they are known.
+ * A name that is not in the string tables yet is serialized by value and resolved
+ * for its next occurrences.
+ */
+static errorCode encodeNameEvent(EXIStream *strm, const EventVector *events, const CodecEvent *event, struct NameHandle *handles)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct NameHandle *handle = &handles[event->id];
+	EXITypeClass valueType;
+	String uri;
+	String ln;
+	QName qname;
+
+	if (handle->resolved)
+	{
+		if (event->kind == EV_START_ELEMENT)
+			return serialize.startElementId(strm, handle->qnameId, &valueType);
+		else
+			return serialize.attributeId(strm, handle->qnameId, TRUE, &valueType);
+	}
+
+	qname = eventName(events, event->id, &uri, &ln);
+	if (event->kind == EV_START_ELEMENT)
+		TRY(serialize.startElement(strm, qname, &valueType));
+	else
+		TRY(serialize.attribute(strm, qname, TRUE, &valueType));
+
+	if (serialize.resolveQName(strm->schema, qname, &handle->qnameId) == EXIP_OK)
+		handle->resolved = TRUE;
+
+	return EXIP_OK;
+}
+
+errorCode encodeEventsToBuffer(
+	EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const EventVector *inEvents,
+	char **outData,
+	size_t *outDataLen)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIStream testStrm;
+	char buf[OUTPUT_BUFFER_SIZE];
+	BinaryBuffer buffer;
+	struct NameHandle *handles = NULL;
+	Index *scDepths = NULL;
+	Index scCount = 0;
+	Index depth = 0;
+	Index i;
+	const CodecEvent *event;
+	String chVal;
+	String uri;
+	String ln;
+
+	*outData = NULL;
+	*outDataLen = 0;
+
+	if (inEvents->nameCount > 0)
+	{
+		handles = calloc(inEvents->nameCount, sizeof(struct NameHandle));
+		if (handles == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	buffer.buf = buf;
+	buffer.bufLen = OUTPUT_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	buffer.bufStrm.buf = calloc(1, OUTPUT_BUFFER_SIZE);
+	buffer.bufStrm.bufLen = OUTPUT_BUFFER_SIZE;
+	if (buffer.bufStrm.buf == NULL)
+	{
+		free(handles);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	serialize.initHeader(&testStrm);
+	testStrm.header.has_cookie = TRUE;
+	testStrm.header.has_options = hasOptions;
+	if (hasOptions && options != NULL)
+		testStrm.header.opts = *options;
+
+	tmp_err_code = serialize.initStream(&testStrm, buffer, schema);
+	if (tmp_err_code == EXIP_OK)
+		tmp_err_code = serialize.exiHeader(&testStrm);
+
+	for (i = 0; i < inEvents->count && tmp_err_code == EXIP_OK; i++)
+	{
+		event = &inEvents->events[i];
+		switch (event->kind)
+		{
+			case EV_START_DOCUMENT:
+				tmp_err_code = serialize.startDocument(&testStrm);
+			break;
+			case EV_END_DOCUMENT:
+				tmp_err_code = serialize.endDocument(&testStrm);
+			break;
+			case EV_START_ELEMENT:
+				tmp_err_code = encodeNameEvent(&testStrm, inEvents, event, handles);
+				depth++;
+			break;
+			case EV_ATTRIBUTE:
+				tmp_err_code = encodeNameEvent(&testStrm, inEvents, event, handles);
+			break;
+			case EV_END_ELEMENT:
+				tmp_err_code = serialize.endElement(&testStrm);
+				if (scCount > 0 && scDepths[scCount - 1] == depth)
+				{
+					// The string tables of the enclosing stream are back:
+					// the IDs resolved in the self-contained element are not valid
+					scCount--;
+					memset(handles, 0, inEvents->nameCount*sizeof(struct NameHandle));
+				}
+				depth--;
+			break;
+			case EV_SELF_CONTAINED:
+			{
+				Index *tmpDepths = realloc(scDepths, (scCount + 1)*sizeof(Index));
+				if (tmpDepths == NULL)
+				{
+					tmp_err_code = EXIP_MEMORY_ALLOCATION_ERROR;
+					break;
+				}
+				scDepths = tmpDepths;
+				scDepths[scCount++] = depth;
+				// The self-contained element starts with the initial string tables
+				if (handles != NULL)
+					memset(handles, 0, inEvents->nameCount*sizeof(struct NameHandle));
+				tmp_err_code = serialize.selfContained(&testStrm);
+			}
+			break;
+			case EV_STRING:
+				chVal.str = inEvents->strings + event->value.str.offset;
+				chVal.length = event->value.str.length;
+				tmp_err_code = serialize.stringData(&testStrm, chVal);
+			break;
+			case EV_INT:
+				tmp_err_code = serialize.intData(&testStrm, event->value.intVal);
+			break;
+			case EV_FLOAT:
+				tmp_err_code = serialize.floatData(&testStrm, event->value.floatVal);
+			break;
+			case EV_DECIMAL:
+				tmp_err_code = serialize.decimalData(&testStrm, event->value.floatVal);
+			break;
+			case EV_BOOLEAN:
+				tmp_err_code = serialize.booleanData(&testStrm, event->value.boolVal);
+			break;
+			case EV_DATE_TIME:
+				tmp_err_code = serialize.dateTimeData(&testStrm, inEvents->dateTimes[event->id]);
+			break;
+			case EV_BINARY:
+				tmp_err_code = serialize.binaryData(&testStrm, inEvents->strings + event->value.str.offset, event->value.str.length);
+			break;
+			case EV_QNAME:
+				tmp_err_code = serialize.qnameData(&testStrm, eventName(inEvents, event->id, &uri, &ln));
+			break;
+			default:
+				tmp_err_code = EXIP_INVALID_INPUT;
+			break;
+		}
+	}
+
+	free(handles);
+	free(scDepths);
+
+	if (tmp_err_code == EXIP_OK)
+	{
+		// closeEXIStream() flushes the buffer to bufStrm but keeps it
+		tmp_err_code = serialize.closeEXIStream(&testStrm);
+		if (tmp_err_code == EXIP_OK)
+		{
+			*outData = testStrm.buffer.bufStrm.buf;
+			*outDataLen = testStrm.buffer.bufStrm.bufContent;
+			return EXIP_OK;
+		}
+	}
+	else
+		serialize.closeEXIStream(&testStrm);
+
+	free(testStrm.buffer.bufStrm.buf);
+	return tmp_err_code;
+}
@@ -0,0 +1,613 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file eventVector.c
+ * @brief The compact event representation of the codec and its text writer
+ */
+
+#include "eventVector.h"
+#include "decode.h"
+#include "procTypes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_EVENT_CAPACITY 256
+#define INITIAL_STRINGS_CAPACITY 4096
+#define INITIAL_NAME_CAPACITY 32
+#define INITIAL_DATE_TIME_CAPACITY 8
+#define TEXT_WRITER_BUFFER_SIZE 8192
+
+static errorCode growArray(void** array, Index* capacity, Index initialCapacity, size_t itemSize);
+static uint32_t nameHash(const String* uri, const String* localName);
+static errorCode rehashNames(EventVector* vector);
+
+void initEventVector(EventVector* vector)
+{
+	memset(vector, 0, sizeof(EventVector));
+}
+
+void destroyEventVector(EventVector* vector)
+{
+	free(vector->events);
+	free(vector->strings);
+	free(vector->names);
+	free(vector->nameSlots);
+	free(vector->dateTimes);
+	initEventVector(vector);
+}
+
+errorCode addEvent(EventVector* vector, const CodecEvent* event)
+{
+	if(vector->count == vector->capacity)
+	{
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+		TRY(growArray((void**) &vector->events, &vector->capacity, INITIAL_EVENT_CAPACITY, sizeof(CodecEvent)));
+	}
+
+	vector->events[vector->count] = *event;
+	vector->count += 1;
+
+	return EXIP_OK;
+}
+
+errorCode addEventString(EventVector* vector, const void* data, size_t length, EventString* str)
+{
+	if(vector->stringsLength + length > vector->stringsCapacity)
+	{
+		size_t newCapacity = vector->stringsCapacity == 0 ? INITIAL_STRINGS_CAPACITY : vector->stringsCapacity;
+		char* newStrings;
+
+		while(vector->stringsLength + length > newCapacity)
+			newCapacity *= 2;
+
+		newStrings = realloc(vector->strings, newCapacity);
+		if(newStrings == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		vector->strings = newStrings;
+		vector->stringsCapacity = newCapacity;
+	}
+
+	if(length > 0)
+		memcpy(vector->strings + vector->stringsLength, data, length);
+	str->offset = vector->stringsLength;
+	str->length = length;
+	vector->stringsLength += length;
+
+	return EXIP_OK;
+}
+
+errorCode internEventName(EventVector* vector, const String* uri, const String* localName, Index* nameId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EventName* name;
+	Index mask;
+	Index s;
+
+	// Keep at most half of the slots used
+	if(2*(vector->nameCount + 1) > vector->nameSlotCount)
+		TRY(rehashNames(vector));
+
+	mask = vector->nameSlotCount - 1;
+	for(s = nameHash(uri, localName) & mask; vector->nameSlots[s] != INDEX_MAX; s = (s + 1) & mask)
+	{
+		name = &vector->names[vector->nameSlots[s]];
+		if(name->uri.length == uri->length && name->localName.length == localName->length &&
+				memcmp(vector->strings + name->uri.offset, uri->str, uri->length) == 0 &&
+				memcmp(vector->strings + name->localName.offset, localName->str, localName->length) == 0)
+		{
+			*nameId = vector->nameSlots[s];
+			return EXIP_OK;
+		}
+	}
+
+	if(vector->nameCount == vector->nameCapacity)
+		TRY(growArray((void**) &vector->names, &vector->nameCapacity, INITIAL_NAME_CAPACITY, sizeof(EventName)));
+
+	name = &vector->names[vector->nameCount];
+	TRY(addEventString(vector, uri->str, uri->length, &name->uri));
+	TRY(addEventString(vector, localName->str, localName->length, &name->localName));
+
+	vector->nameSlots[s] = vector->nameCount;
+	*nameId = vector->nameCount;
+	vector->nameCount += 1;
+
+	return EXIP_OK;
+}
+
+errorCode addEventDateTime(EventVector* vector, const EXIPDateTime* dateTime, Index* dateTimeId)
+{
+	if(vector->dateTimeCount == vector->dateTimeCapacity)
+	{
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+		TRY(growArray((void**) &vector->dateTimes, &vector->dateTimeCapacity, INITIAL_DATE_TIME_CAPACITY, sizeof(EXIPDateTime)));
+	}
+
+	vector->dateTimes[vector->dateTimeCount] = *dateTime;
+	*dateTimeId = vector->dateTimeCount;
+	vector->dateTimeCount += 1;
+
+	return EXIP_OK;
+}
+
+static errorCode growArray(void** array, Index* capacity, Index initialCapacity, size_t itemSize)
+{
+	Index newCapacity = *capacity == 0 ? initialCapacity : 2*(*capacity);
+	void* newArray = realloc(*array, newCapacity*itemSize);
+
+	if(newArray == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	*array = newArray;
+	*capacity = newCapacity;
+	return EXIP_OK;
+}
+
+static uint32_t nameHash(const String* uri, const String* localName)
+{
+	uint32_t hash = 5381;
+	Index i;
+
+	for(i = 0; i < uri->length; i++)
+		hash = ((hash << 5) + hash) + (unsigned char) uri->str[i];
+	hash = ((hash << 5) + hash) + ':';
+	for(i = 0; i < localName->length; i++)
+		hash = ((hash << 5) + hash) + (unsigned char) localName->str[i];
+
+	return hash;
+}
+
+/**
+ * @brief Doubles the slots of the name index and places the names again
+ */
+static errorCode rehashNames(EventVector* vector)
+{
+	Index newCount = vector->nameSlotCount == 0 ? 2*INITIAL_NAME_CAPACITY : 2*vector->nameSlotCount;
+	Index* newSlots = malloc(newCount*sizeof(Index));
+	Index mask = newCount - 1;
+	Index i;
+	Index s;
+	String uri;
+	String localName;
+
+	if(newSlots == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	for(i = 0; i < newCount; i++)
+		newSlots[i] = INDEX_MAX;
+
+	for(i = 0; i < vector->nameCount; i++)
+	{
+		uri.str = vector->strings + vector->names[i].uri.offset;
+		uri.length = vector->names[i].uri.length;
+		localName.str = vector->strings + vector->names[i].localName.offset;
+		localName.length = vector->names[i].localName.length;
+
+		for(s = nameHash(&uri, &localName) & mask; newSlots[s] != INDEX_MAX; s = (s + 1) & mask);
+		newSlots[s] = i;
+	}
+
+	free(vector->nameSlots);
+	vector->nameSlots = newSlots;
+	vector->nameSlotCount = newCount;
+
+	return EXIP_OK;
+}
+
+// The text writer
+// ******************************************
+
+struct TextWriter
+{
+	char buf[TEXT_WRITER_BUFFER_SIZE];
+	size_t length;
+	size_t (*outputStream)(void* buf, size_t size, void* stream);
+	void* stream;
+	errorCode error;
+};
+
+static void flushText(struct TextWriter* writer)
+{
+	if(writer->length > 0 && writer->error == EXIP_OK)
+	{
+		if(writer->outputStream(writer->buf, writer->length, writer->stream) < writer->length)
+			writer->error = EXIP_BUFFER_END_REACHED;
+	}
+	writer->length = 0;
+}
+
+static void writeText(struct TextWriter* writer, const char* text, size_t length)
+{
+	size_t part;
+
+	while(length > 0)
+	{
+		if(writer->length == TEXT_WRITER_BUFFER_SIZE)
+			flushText(writer);
+
+		part = TEXT_WRITER_BUFFER_SIZE - writer->length;
+		if(part > length)
+			part = length;
+		memcpy(writer->buf + writer->length, text, part);
+		writer->length += part;
+		text += part;
+		length -= part;
+	}
+}
+
+static void writeString(struct TextWriter* writer, const EventVector* vector, EventString str)
+{
+	writeText(writer, vector->strings + str.offset, str.length);
+}
+
+/** Writes a string escaping the XML markup characters */
+static void writeEscaped(struct TextWriter* writer, const EventVector* vector, EventString str)
+{
+	const char* text = vector->strings + str.offset;
+	size_t start = 0;
+	size_t i;
+	const char* entity;
+
+	for(i = 0; i < str.length; i++)
+	{
+		switch(text[i])
+		{
+			case '&': entity = "&amp;"; break;
+			case '<': entity = "&lt;"; break;
+			case '>': entity = "&gt;"; break;
+			case '"': entity = "&quot;"; break;
+			default: continue;
+		}
+		writeText(writer, text + start, i - start);
+		writeText(writer, entity, strlen(entity));
+		start = i + 1;
+	}
+	writeText(writer, text + start, str.length - start);
+}
+
+/** Writes the value of a value event in its lexical form */
+static void writeValue(struct TextWriter* writer, const EventVector* vector, const CodecEvent* event, boolean escape)
+{
+	char tmp_buf[80];
+	int len = 0;
+
+	switch(event->kind)
+	{
+		case EV_STRING:
+			if(escape)
+				writeEscaped(writer, vector, event->value.str);
+			else
+				writeString(writer, vector, event->value.str);
+		return;
+		case EV_INT:
+			len = sprintf(tmp_buf, "%lld", (long long int) event->value.intVal);
+		break;
+		case EV_FLOAT:
+		case EV_DECIMAL:
+			len = sprintf(tmp_buf, "%lldE%d", (long long int) event->value.floatVal.mantissa, event->value.floatVal.exponent);
+		break;
+		case EV_BOOLEAN:
+			len = sprintf(tmp_buf, "%s", event->value.boolVal ? "true" : "false");
+		break;
+		case EV_DATE_TIME:
+		{
+			EXIPDateTime* dt = &vector->dateTimes[event->id];
+
+			len = sprintf(tmp_buf, "%04d-%02d-%02dT%02d:%02d:%02d", dt->dateTime.tm_year + 1900,
+					dt->dateTime.tm_mon + 1, dt->dateTime.tm_mday,
+					dt->dateTime.tm_hour, dt->dateTime.tm_min, dt->dateTime.tm_sec);
+			if(IS_PRESENT(dt->presenceMask, FRACT_PRESENCE))
+			{
+				unsigned int tmpfValue = dt->fSecs.value;
+				int digitNum = 0;
+				int i;
+
+				while(tmpfValue)
+				{
+					digitNum++;
+					tmpfValue = tmpfValue / 10;
+				}
+				tmp_buf[len++] = '.';
+				for(i = 0; i < dt->fSecs.offset + 1 - digitNum; i++)
+					tmp_buf[len++] = '0';
+				len += sprintf(tmp_buf + len, "%u", dt->fSecs.value);
+			}
+			if(IS_PRESENT(dt->presenceMask, TZONE_PRESENCE))
+				len += sprintf(tmp_buf + len, "%c%02d:%02d", dt->TimeZone < 0 ? '-' : '+',
+						abs(dt->TimeZone / 64), abs(dt->TimeZone % 64));
+		}
+		break;
+		case EV_BINARY:
+		{
+			size_t i;
+
+			for(i = 0; i < event->value.str.length; i++)
+			{
+				sprintf(tmp_buf, "%02X", (unsigned char) vector->strings[event->value.str.offset + i]);
+				writeText(writer, tmp_buf, 2);
+			}
+		}
+		return;
+		case EV_QNAME:
+			writeString(writer, vector, vector->names[event->id].uri);
+			writeText(writer, ":", 1);
+			writeString(writer, vector, vector->names[event->id].localName);
+		return;
+		default:
+		return;
+	}
+
+	writeText(writer, tmp_buf, len);
+}
+
+static void writeEventLines(struct TextWriter* writer, const EventVector* vector)
+{
+	Index i;
+	const CodecEvent* event;
+	const EventName* name;
+
+	for(i = 0; i < vector->count; i++)
+	{
+		event = &vector->events[i];
+		switch(event->kind)
+		{
+			case EV_START_DOCUMENT:
+				writeText(writer, "SD\n", 3);
+			break;
+			case EV_END_DOCUMENT:
+				writeText(writer, "ED\n", 3);
+			break;
+			case EV_END_ELEMENT:
+				writeText(writer, "EE\n", 3);
+			break;
+			case EV_SELF_CONTAINED:
+				writeText(writer, "SC\n", 3);
+			break;
+			case EV_START_ELEMENT:
+				name = &vector->names[event->id];
+				writeText(writer, "SE ", 3);
+				writeString(writer, vector, name->uri);
+				writeText(writer, " ", 1);
+				writeString(writer, vector, name->localName);
+				writeText(writer, "\n", 1);
+			break;
+			case EV_ATTRIBUTE:
+				name = &vector->names[event->id];
+				writeText(writer, "AT ", 3);
+				if(name->uri.length > 0)
+				{
+					writeString(writer, vector, name->uri);
+					writeText(writer, " ", 1);
+				}
+				writeString(writer, vector, name->localName);
+				writeText(writer, "=\"", 2);
+				if(i + 1 < vector->count && vector->events[i + 1].kind >= EV_STRING)
+				{
+					i++;
+					writeValue(writer, vector, &vector->events[i], FALSE);
+				}
+				writeText(writer, "\"\n", 2);
+			break;
+			default:
+				writeText(writer, event->kind == EV_QNAME ? "QNAME " : "CH ", event->kind == EV_QNAME ? 6 : 3);
+				writeValue(writer, vector, event, FALSE);
+				writeText(writer, "\n", 1);
+			break;
+		}
+	}
+}
+
+/** The prefix index of the names in the XML namespace: they use the "xml" prefix */
+#define XML_PREFIX INDEX_MAX
+
+static const char XML_NAMESPACE_URI[] = "http://www.w3.org/XML/1998/namespace";
+
+static void writePrefixedName(struct TextWriter* writer, const EventVector* vector, Index nameId, const Index* prefixes)
+{
+	char tmp_buf[30];
+
+	if(prefixes[nameId] == XML_PREFIX)
+		writeText(writer, "xml:", 4);
+	else if(vector->names[nameId].uri.length > 0)
+		writeText(writer, tmp_buf, sprintf(tmp_buf, "p%u:", (unsigned int) prefixes[nameId]));
+	writeString(writer, vector, vector->names[nameId].localName);
+}
+
+/**
+ * @brief Gives each distinct non-empty namespace of the names a prefix index,
+ * numbered in the order of the first use, and the XML namespace XML_PREFIX
+ *
+ * A map from the namespaces to the first name using them keeps it linear in
+ * the number of names.
+ */
+static errorCode assignPrefixes(const EventVector* vector, Index* prefixes, Index* uriCount)
+{
+	Index slotCount = 2*INITIAL_NAME_CAPACITY;
+	Index* uriSlots;
+	Index mask;
+	Index i, s;
+	String uri;
+	String noName = {NULL, 0};
+
+	while(slotCount < 2*vector->nameCount)
+		slotCount *= 2;
+	uriSlots = malloc(slotCount*sizeof(Index));
+	if(uriSlots == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	for(s = 0; s < slotCount; s++)
+		uriSlots[s] = INDEX_MAX;
+	mask = slotCount - 1;
+
+	*uriCount = 0;
+	for(i = 0; i < vector->nameCount; i++)
+	{
+		const EventString* uriStr = &vector->names[i].uri;
+
+		uri.str = vector->strings + uriStr->offset;
+		uri.length = uriStr->length;
+		for(s = nameHash(&uri, &noName) & mask; uriSlots[s] != INDEX_MAX; s = (s + 1) & mask)
+		{
+			const EventString* prevUri = &vector->names[uriSlots[s]].uri;
+			if(prevUri->length == uri.length && memcmp(vector->strings + prevUri->offset, uri.str, uri.length) == 0)
+				break;
+		}
+
+		if(uriSlots[s] != INDEX_MAX)
+			prefixes[i] = prefixes[uriSlots[s]];
+		else
+		{
+			uriSlots[s] = i;
+			if(uri.length == sizeof(XML_NAMESPACE_URI) - 1 && memcmp(uri.str, XML_NAMESPACE_URI, uri.length) == 0)
+				prefixes[i] = XML_PREFIX;
+			else if(uri.length > 0)
+				prefixes[i] = (*uriCount)++;
+			else
+				prefixes[i] = 0;
+		}
+	}
+
+	free(uriSlots);
+	return EXIP_OK;
+}
+
+static errorCode writeXml(struct TextWriter* writer, const EventVector* vector)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index* prefixes = NULL;
+	Index* openElements = NULL;
+	Index depth = 0;
+	Index uriCount = 0;
+	boolean unclosedElement = FALSE;
+	char tmp_buf[30];
+	Index i, j;
+	const CodecEvent* event;
+
+	// Each distinct namespace but the XML one gets a prefix declared on the root element
+	if(vector->nameCount > 0)
+	{
+		prefixes = malloc(vector->nameCount*sizeof(Index));
+		if(prefixes == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+	openElements = malloc((vector->count + 1)*sizeof(Index));
+	if(openElements == NULL)
+	{
+		free(prefixes);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	tmp_err_code = assignPrefixes(vector, prefixes, &uriCount);
+	if(tmp_err_code != EXIP_OK)
+	{
+		free(prefixes);
+		free(openElements);
+		return tmp_err_code;
+	}
+
+	for(i = 0; i < vector->count; i++)
+	{
+		event = &vector->events[i];
+
+		if(unclosedElement && event->kind != EV_ATTRIBUTE)
+		{
+			writeText(writer, ">", 1);
+			unclosedElement = FALSE;
+		}
+
+		switch(event->kind)
+		{
+			case EV_START_DOCUMENT:
+				writeText(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n", 39);
+			break;
+			case EV_END_DOCUMENT:
+				writeText(writer, "\n", 1);
+			break;
+			case EV_START_ELEMENT:
+				writeText(writer, "<", 1);
+				writePrefixedName(writer, vector, event->id, prefixes);
+				if(depth == 0)
+				{
+					// Declare all the prefixes on the root element
+					Index declared = 0;
+
+					for(j = 0; j < vector->nameCount && declared < uriCount; j++)
+					{
+						if(vector->names[j].uri.length > 0 && prefixes[j] == declared)
+						{
+							writeText(writer, tmp_buf, sprintf(tmp_buf, " xmlns:p%u=\"", (unsigned int) declared));
+							writeEscaped(writer, vector, vector->names[j].uri);
+							writeText(writer, "\"", 1);
+							declared++;
+						}
+					}
+				}
+				openElements[depth++] = event->id;
+				unclosedElement = TRUE;
+			break;
+			case EV_END_ELEMENT:
+				if(depth > 0)
+				{
+					depth--;
+					writeText(writer, "</", 2);
+					writePrefixedName(writer, vector, openElements[depth], prefixes);
+					writeText(writer, ">", 1);
+				}
+			break;
+			case EV_ATTRIBUTE:
+				writeText(writer, " ", 1);
+				writePrefixedName(writer, vector, event->id, prefixes);
+				writeText(writer, "=\"", 2);
+				if(i + 1 < vector->count && vector->events[i + 1].kind >= EV_STRING)
+				{
+					i++;
+					writeValue(writer, vector, &vector->events[i], TRUE);
+				}
+				writeText(writer, "\"", 1);
+			break;
+			case EV_SELF_CONTAINED:
+			break;
+			default:
+				writeValue(writer, vector, event, TRUE);
+			break;
+		}
+	}
+
+	free(prefixes);
+	free(openElements);
+	return EXIP_OK;
+}
+
+errorCode writeEventVector(const EventVector* vector, unsigned char outFlag,
+						   size_t (*outputStream)(void* buf, size_t size, void* stream), void* stream)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct TextWriter* writer = malloc(sizeof(struct TextWriter));
+
+	if(writer == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	writer->length = 0;
+	writer->outputStream = outputStream;
+	writer->stream = stream;
+	writer->error = EXIP_OK;
+
+	if(outFlag == OUT_XML)
+		tmp_err_code = writeXml(writer, vector);
+	else
+	{
+		writeEventLines(writer, vector);
+		tmp_err_code = EXIP_OK;
+	}
+
+	flushText(writer);
+	if(tmp_err_code == EXIP_OK)
+		tmp_err_code = writer->error;
+
+	free(writer);
+	return tmp_err_code;
+}
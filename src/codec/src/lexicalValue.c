@@ -0,0 +1,571 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file lexicalValue.c
+ * @brief Locale-independent parsers of the lexical forms of the XML Schema simple types
+ */
+
+#include "lexicalValue.h"
+#include "EXISerializer.h"
+#include <string.h>
+
+#define IS_XML_SPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+
+/** Any number with up to 18 decimal digits fits in the int64_t mantissa */
+#define MANTISSA_DIGITS_MAX 18
+/** The range of the EXI Float exponent is [-(2^14-1) .. 2^14-1] */
+#define FLOAT_EXPONENT_MAX 16383
+/** The exponent of the EXI Float special values INF, -INF and NaN */
+#define FLOAT_EXPONENT_SPECIAL -16384
+/** Any number with up to 9 decimal digits fits in FractionalSecs.value */
+#define FRACTION_DIGITS_MAX 9
+/** The years with more digits do not fit in tm_year */
+#define YEAR_DIGITS_MAX 9
+
+static void trimWhiteSpace(const char** str, size_t* length);
+static boolean isDateField(const char* str, const char* end);
+static errorCode readField(const char** str, const char* end, unsigned int digits, int min, int max, int* value);
+static errorCode readTime(const char** str, const char* end, EXIPDateTime* value);
+static errorCode readTimeZone(const char** str, const char* end, EXIPDateTime* value);
+static int hexDigitValue(char c);
+static int base64DigitValue(char c);
+
+errorCode parseIntegerValue(const char* str, size_t length, Integer* value)
+{
+	const char* end;
+	boolean negative = FALSE;
+	uint64_t magnitude = 0;
+	uint64_t limit;
+	unsigned int digit;
+	unsigned int digits = 0;
+
+	trimWhiteSpace(&str, &length);
+	end = str + length;
+
+	if(str < end && (*str == '-' || *str == '+'))
+	{
+		negative = *str == '-';
+		str++;
+	}
+
+	if(str == end)
+		return EXIP_INVALID_INPUT;
+
+	limit = negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+	for(; str < end; str++)
+	{
+		if(!IS_DIGIT(*str))
+			return EXIP_INVALID_INPUT;
+
+		// The first MANTISSA_DIGITS_MAX digits cannot overflow: the range is only checked after them
+		digit = *str - '0';
+		if(++digits > MANTISSA_DIGITS_MAX && magnitude > (limit - digit)/10)
+			return EXIP_INVALID_INPUT;
+		magnitude = magnitude*10 + digit;
+	}
+
+	if(negative && magnitude > 0)
+		*value = -(Integer) (magnitude - 1) - 1;
+	else
+		*value = (Integer) magnitude;
+
+	return EXIP_OK;
+}
+
+errorCode parseFloatValue(const char* str, size_t length, Float* value)
+{
+	const char* end;
+	boolean negative = FALSE;
+	boolean hasDigits = FALSE;
+	int64_t mantissa = 0;
+	unsigned int digits = 0;
+	long exponent = 0;
+
+	trimWhiteSpace(&str, &length);
+	end = str + length;
+
+	if(length == 3 && memcmp(str, "NaN", 3) == 0)
+	{
+		value->mantissa = 0;
+		value->exponent = FLOAT_EXPONENT_SPECIAL;
+		return EXIP_OK;
+	}
+
+	if(str < end && (*str == '-' || *str == '+'))
+	{
+		negative = *str == '-';
+		str++;
+	}
+
+	if(end - str == 3 && memcmp(str, "INF", 3) == 0)
+	{
+		value->mantissa = negative ? -1 : 1;
+		value->exponent = FLOAT_EXPONENT_SPECIAL;
+		return EXIP_OK;
+	}
+
+	// The leading zeros are not counted as significant digits
+	for(; str < end && IS_DIGIT(*str); str++)
+	{
+		hasDigits = TRUE;
+		if(digits < MANTISSA_DIGITS_MAX)
+		{
+			mantissa = mantissa*10 + (*str - '0');
+			if(mantissa != 0)
+				digits++;
+		}
+		else
+			exponent++;
+	}
+
+	if(str < end && *str == '.')
+	{
+		for(str++; str < end && IS_DIGIT(*str); str++)
+		{
+			hasDigits = TRUE;
+			if(digits < MANTISSA_DIGITS_MAX)
+			{
+				mantissa = mantissa*10 + (*str - '0');
+				exponent--;
+				if(mantissa != 0)
+					digits++;
+			}
+		}
+	}
+
+	if(!hasDigits)
+		return EXIP_INVALID_INPUT;
+
+	if(str < end && (*str == 'e' || *str == 'E'))
+	{
+		boolean expNegative = FALSE;
+		long expValue = 0;
+
+		str++;
+		if(str < end && (*str == '-' || *str == '+'))
+		{
+			expNegative = *str == '-';
+			str++;
+		}
+
+		if(str == end)
+			return EXIP_INVALID_INPUT;
+
+		for(; str < end && IS_DIGIT(*str); str++)
+		{
+			// Larger exponents are out of range anyway
+			if(expValue < 10*FLOAT_EXPONENT_MAX)
+				expValue = expValue*10 + (*str - '0');
+		}
+
+		exponent += expNegative ? -expValue : expValue;
+	}
+
+	if(str != end)
+		return EXIP_INVALID_INPUT;
+
+	if(mantissa == 0)
+		exponent = 0;
+
+	while(mantissa != 0 && mantissa % 10 == 0)
+	{
+		mantissa = mantissa / 10;
+		exponent++;
+	}
+
+	if(exponent > FLOAT_EXPONENT_MAX || exponent < -FLOAT_EXPONENT_MAX)
+		return EXIP_INVALID_INPUT;
+
+	value->mantissa = negative ? -mantissa : mantissa;
+	value->exponent = (int16_t) exponent;
+
+	return EXIP_OK;
+}
+
+errorCode parseBooleanValue(const char* str, size_t length, boolean* value)
+{
+	trimWhiteSpace(&str, &length);
+
+	if((length == 4 && memcmp(str, "true", 4) == 0) || (length == 1 && *str == '1'))
+		*value = TRUE;
+	else if((length == 5 && memcmp(str, "false", 5) == 0) || (length == 1 && *str == '0'))
+		*value = FALSE;
+	else
+		return EXIP_INVALID_INPUT;
+
+	return EXIP_OK;
+}
+
+errorCode parseDateTimeValue(const char* str, size_t length, EXIPDateTime* value)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	const char* end;
+	int field;
+
+	trimWhiteSpace(&str, &length);
+	end = str + length;
+
+	memset(value, 0, sizeof(EXIPDateTime));
+	value->dateTime.tm_mon = -1;
+
+	if(end - str >= 2 && str[0] == '-' && str[1] == '-')
+	{
+		// gMonth, gMonthDay or gDay
+		str += 2;
+		if(str < end && *str == '-')
+		{
+			str++;
+			TRY(readField(&str, end, 2, 1, 31, &value->dateTime.tm_mday));
+		}
+		else
+		{
+			TRY(readField(&str, end, 2, 1, 12, &field));
+			value->dateTime.tm_mon = field - 1;
+			if(isDateField(str, end))
+			{
+				str++;
+				TRY(readField(&str, end, 2, 1, 31, &value->dateTime.tm_mday));
+			}
+		}
+	}
+	else if(end - str >= 3 && str[2] == ':')
+	{
+		// time
+		TRY(readTime(&str, end, value));
+	}
+	else
+	{
+		// dateTime, date, gYear or gYearMonth
+		boolean negative = FALSE;
+		int year = 0;
+		unsigned int yearDigits = 0;
+
+		if(str < end && *str == '-')
+		{
+			negative = TRUE;
+			str++;
+		}
+
+		for(; str < end && IS_DIGIT(*str); str++)
+		{
+			if(yearDigits == YEAR_DIGITS_MAX)
+				return EXIP_INVALID_INPUT;
+			year = year*10 + (*str - '0');
+			yearDigits++;
+		}
+
+		if(yearDigits < 4)
+			return EXIP_INVALID_INPUT;
+
+		value->dateTime.tm_year = (negative ? -year : year) - 1900;
+
+		if(isDateField(str, end))
+		{
+			str++;
+			TRY(readField(&str, end, 2, 1, 12, &field));
+			value->dateTime.tm_mon = field - 1;
+
+			if(isDateField(str, end))
+			{
+				str++;
+				TRY(readField(&str, end, 2, 1, 31, &value->dateTime.tm_mday));
+
+				if(str < end && *str == 'T')
+				{
+					str++;
+					TRY(readTime(&str, end, value));
+				}
+			}
+		}
+	}
+
+	TRY(readTimeZone(&str, end, value));
+
+	return str == end ? EXIP_OK : EXIP_INVALID_INPUT;
+}
+
+errorCode parseBinaryValue(char* str, size_t length, Index* nbytes)
+{
+	char* out = str;
+	const char* in = str;
+	const char* end;
+	size_t i;
+	boolean isHex;
+
+	trimWhiteSpace(&in, &length);
+	end = in + length;
+
+	isHex = length % 2 == 0;
+	for(i = 0; i < length && isHex; i++)
+		isHex = hexDigitValue(in[i]) >= 0;
+
+	if(isHex)
+	{
+		for(i = 0; i < length/2; i++)
+			out[i] = (char) ((hexDigitValue(in[2*i]) << 4) | hexDigitValue(in[2*i + 1]));
+		*nbytes = (Index) (length/2);
+	}
+	else
+	{
+		uint32_t bits = 0;
+		unsigned int bitCount = 0;
+		unsigned int padding = 0;
+		Index count = 0;
+		int digit;
+
+		for(; in < end; in++)
+		{
+			if(IS_XML_SPACE(*in))
+				continue;
+
+			if(*in == '=')
+			{
+				padding++;
+				continue;
+			}
+
+			digit = base64DigitValue(*in);
+			if(digit < 0 || padding > 0)
+				return EXIP_INVALID_INPUT;
+
+			bits = (bits << 6) | (uint32_t) digit;
+			bitCount += 6;
+			if(bitCount >= 8)
+			{
+				bitCount -= 8;
+				// Each byte is written behind the characters it is decoded from
+				out[count++] = (char) (bits >> bitCount);
+				bits &= (1u << bitCount) - 1;
+			}
+		}
+
+		if(padding > 2 || bits != 0)
+			return EXIP_INVALID_INPUT;
+
+		*nbytes = count;
+	}
+
+	return EXIP_OK;
+}
+
+errorCode serializeLexicalValue(EXIStream* strm, EXITypeClass valueType, char* str, size_t length)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	switch(valueType)
+	{
+		case VALUE_TYPE_INTEGER_CLASS:
+		{
+			Integer intVal;
+			TRY(parseIntegerValue(str, length, &intVal));
+			return serialize.intData(strm, intVal);
+		}
+		case VALUE_TYPE_FLOAT_CLASS:
+		{
+			Float flVal;
+			TRY(parseFloatValue(str, length, &flVal));
+			return serialize.floatData(strm, flVal);
+		}
+		case VALUE_TYPE_DECIMAL_CLASS:
+		{
+			Decimal decVal;
+			TRY(parseFloatValue(str, length, &decVal));
+			if(decVal.exponent == FLOAT_EXPONENT_SPECIAL)
+				return EXIP_INVALID_INPUT;
+			return serialize.decimalData(strm, decVal);
+		}
+		case VALUE_TYPE_BOOLEAN_CLASS:
+		{
+			boolean boolVal;
+			TRY(parseBooleanValue(str, length, &boolVal));
+			return serialize.booleanData(strm, boolVal);
+		}
+		case VALUE_TYPE_DATE_TIME_CLASS:
+		{
+			EXIPDateTime dtVal;
+			TRY(parseDateTimeValue(str, length, &dtVal));
+			return serialize.dateTimeData(strm, dtVal);
+		}
+		case VALUE_TYPE_BINARY_CLASS:
+		{
+			Index nbytes;
+			TRY(parseBinaryValue(str, length, &nbytes));
+			return serialize.binaryData(strm, str, nbytes);
+		}
+		default:
+		{
+			String chVal;
+			chVal.str = str;
+			chVal.length = (Index) length;
+			return serialize.stringData(strm, chVal);
+		}
+	}
+}
+
+static void trimWhiteSpace(const char** str, size_t* length)
+{
+	while(*length > 0 && IS_XML_SPACE(**str))
+	{
+		*str += 1;
+		*length -= 1;
+	}
+
+	while(*length > 0 && IS_XML_SPACE((*str)[*length - 1]))
+		*length -= 1;
+}
+
+/**
+ * @brief Whether str is at a -MM or -DD field of a date. A '-' followed
+ * by hh: is the time zone of a gYear, gYearMonth, gMonth or date instead
+ */
+static boolean isDateField(const char* str, const char* end)
+{
+	return end - str >= 3 && str[0] == '-' && (end - str == 3 || str[3] != ':');
+}
+
+/**
+ * @brief Reads a field of exactly digits decimal digits in the range [min .. max]
+ */
+static errorCode readField(const char** str, const char* end, unsigned int digits, int min, int max, int* value)
+{
+	unsigned int i;
+
+	if((size_t) (end - *str) < digits)
+		return EXIP_INVALID_INPUT;
+
+	*value = 0;
+	for(i = 0; i < digits; i++)
+	{
+		if(!IS_DIGIT((*str)[i]))
+			return EXIP_INVALID_INPUT;
+		*value = *value*10 + ((*str)[i] - '0');
+	}
+
+	if(*value < min || *value > max)
+		return EXIP_INVALID_INPUT;
+
+	*str += digits;
+	return EXIP_OK;
+}
+
+/**
+ * @brief Reads hh:mm:ss with optional fractional seconds
+ */
+static errorCode readTime(const char** str, const char* end, EXIPDateTime* value)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	TRY(readField(str, end, 2, 0, 24, &value->dateTime.tm_hour));
+	if(*str == end || **str != ':')
+		return EXIP_INVALID_INPUT;
+	*str += 1;
+	TRY(readField(str, end, 2, 0, 59, &value->dateTime.tm_min));
+	if(*str == end || **str != ':')
+		return EXIP_INVALID_INPUT;
+	*str += 1;
+	TRY(readField(str, end, 2, 0, 60, &value->dateTime.tm_sec));
+
+	if(*str < end && **str == '.')
+	{
+		unsigned int fraction = 0;
+		unsigned int digits = 0;
+
+		*str += 1;
+		if(*str == end || !IS_DIGIT(**str))
+			return EXIP_INVALID_INPUT;
+
+		// The digits beyond the precision of FractionalSecs are dropped
+		for(; *str < end && IS_DIGIT(**str); *str += 1)
+		{
+			if(digits < FRACTION_DIGITS_MAX)
+			{
+				fraction = fraction*10 + (**str - '0');
+				digits++;
+			}
+		}
+
+		// The trailing zeros are not significant
+		while(fraction != 0 && fraction % 10 == 0)
+		{
+			fraction = fraction / 10;
+			digits--;
+		}
+
+		if(fraction != 0)
+		{
+			value->presenceMask = value->presenceMask | FRACT_PRESENCE;
+			value->fSecs.value = fraction;
+			value->fSecs.offset = (unsigned char) (digits - 1);
+		}
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Reads the optional time zone: Z, +hh:mm or -hh:mm
+ */
+static errorCode readTimeZone(const char** str, const char* end, EXIPDateTime* value)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	boolean negative;
+	int hours;
+	int minutes;
+
+	if(*str == end)
+		return EXIP_OK;
+
+	if(**str == 'Z')
+	{
+		*str += 1;
+		value->TimeZone = 0;
+	}
+	else if(**str == '+' || **str == '-')
+	{
+		negative = **str == '-';
+		*str += 1;
+		TRY(readField(str, end, 2, 0, 14, &hours));
+		if(*str == end || **str != ':')
+			return EXIP_INVALID_INPUT;
+		*str += 1;
+		TRY(readField(str, end, 2, 0, 59, &minutes));
+		value->TimeZone = (int16_t) (negative ? -(hours*64 + minutes) : hours*64 + minutes);
+	}
+	else
+		return EXIP_INVALID_INPUT;
+
+	value->presenceMask = value->presenceMask | TZONE_PRESENCE;
+	return EXIP_OK;
+}
+
+static int hexDigitValue(char c)
+{
+	if(c >= '0' && c <= '9')
+		return c - '0';
+	if(c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if(c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+static int base64DigitValue(char c)
+{
+	if(c >= 'A' && c <= 'Z')
+		return c - 'A';
+	if(c >= 'a' && c <= 'z')
+		return c - 'a' + 26;
+	if(c >= '0' && c <= '9')
+		return c - '0' + 52;
+	if(c == '+')
+		return 62;
+	if(c == '/')
+		return 63;
+	return -1;
+}
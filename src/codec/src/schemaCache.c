@@ -0,0 +1,313 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file schemaCache.c
+ * @brief The process-wide cache of the codec schemas
+ */
+
+#include "schemaCache.h"
+#include "procTypes.h"
+#include "parseSchema.h"
+#include "grammarGenerator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if SCHEMA_CACHE_THREAD_SAFE
+# include <pthread.h>
+#endif
+
+/** The identity of a schema file: a changed file is parsed again */
+struct SchemaFileId
+{
+	dev_t device;
+	ino_t inode;
+	off_t size;
+	time_t modified;
+};
+
+struct SchemaCacheEntry
+{
+	struct SchemaCacheEntry* next;
+	/** The schemaPath given to acquireSchema() */
+	char* path;
+	/** TRUE if an options mask was given */
+	boolean hasMask;
+	EXIOptions mask;
+	struct SchemaFileId file[MAX_XSD_FILES_COUNT];
+	unsigned int fileCount;
+	/** TRUE while the schema is handed out by acquireSchema() */
+	boolean inUse;
+	/** TRUE if the schema files have changed since the schema was built:
+	 * the entry is freed when it is released */
+	boolean stale;
+	EXIPSchema schema;
+};
+
+static struct SchemaCacheEntry* cacheHead = NULL;
+
+#if SCHEMA_CACHE_THREAD_SAFE
+/** Protects the list of entries; not held while a schema is built */
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+/** Serializes the calls of parseSchema(), which is not reentrant */
+static pthread_mutex_t parseLock = PTHREAD_MUTEX_INITIALIZER;
+# define LOCK_CACHE() pthread_mutex_lock(&cacheLock)
+# define UNLOCK_CACHE() pthread_mutex_unlock(&cacheLock)
+# define LOCK_PARSE() pthread_mutex_lock(&parseLock)
+# define UNLOCK_PARSE() pthread_mutex_unlock(&parseLock)
+#else
+# define LOCK_CACHE()
+# define UNLOCK_CACHE()
+# define LOCK_PARSE()
+# define UNLOCK_PARSE()
+#endif
+
+static errorCode getSchemaFileIds(const char* schemaPath, struct SchemaFileId* file, unsigned int* fileCount);
+static boolean sameMask(struct SchemaCacheEntry* entry, EXIOptions* maskOpt);
+static boolean sameKey(struct SchemaCacheEntry* entry, struct SchemaCacheEntry* other);
+static void destroyEntry(struct SchemaCacheEntry* entry);
+
+errorCode acquireSchema(const char* schemaPath, EXIOptions* maskOpt, EXIPSchema** schema)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct SchemaFileId file[MAX_XSD_FILES_COUNT];
+	unsigned int fileCount;
+	struct SchemaCacheEntry** link;
+	struct SchemaCacheEntry* entry;
+	char* pathCopy;
+
+	if(schemaPath == NULL || schema == NULL)
+		return EXIP_INVALID_INPUT;
+
+	TRY(getSchemaFileIds(schemaPath, file, &fileCount));
+
+	LOCK_CACHE();
+
+	link = &cacheHead;
+	while(*link != NULL)
+	{
+		entry = *link;
+		if(strcmp(entry->path, schemaPath) == 0 && sameMask(entry, maskOpt))
+		{
+			if(entry->fileCount != fileCount || memcmp(entry->file, file, sizeof(struct SchemaFileId)*fileCount) != 0)
+			{
+				// The schema files have changed since the schema was built
+				if(!entry->inUse)
+				{
+					*link = entry->next;
+					destroyEntry(entry);
+					continue;
+				}
+				entry->stale = TRUE;
+			}
+			else if(!entry->inUse)
+			{
+				entry->inUse = TRUE;
+				*schema = &entry->schema;
+				UNLOCK_CACHE();
+				return EXIP_OK;
+			}
+		}
+		link = &entry->next;
+	}
+
+	UNLOCK_CACHE();
+
+	// No schema instance is available: build a new one. The other schemas
+	// of the cache can be acquired and released meanwhile
+	entry = calloc(1, sizeof(struct SchemaCacheEntry));
+	pathCopy = malloc(strlen(schemaPath) + 1);
+	if(entry == NULL || pathCopy == NULL)
+	{
+		free(entry);
+		free(pathCopy);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	// parseSchema() splits the path in place
+	strcpy(pathCopy, schemaPath);
+	LOCK_PARSE();
+	tmp_err_code = parseSchema(pathCopy, maskOpt, &entry->schema);
+	UNLOCK_PARSE();
+	if(tmp_err_code != EXIP_OK)
+	{
+		free(entry);
+		free(pathCopy);
+		return tmp_err_code;
+	}
+
+	strcpy(pathCopy, schemaPath);
+	entry->path = pathCopy;
+	entry->hasMask = maskOpt != NULL;
+	if(maskOpt != NULL)
+		entry->mask = *maskOpt;
+	memcpy(entry->file, file, sizeof(struct SchemaFileId)*fileCount);
+	entry->fileCount = fileCount;
+	entry->inUse = TRUE;
+
+	LOCK_CACHE();
+	entry->next = cacheHead;
+	cacheHead = entry;
+	UNLOCK_CACHE();
+
+	*schema = &entry->schema;
+	return EXIP_OK;
+}
+
+void releaseSchema(EXIPSchema* schema)
+{
+	struct SchemaCacheEntry** link;
+	struct SchemaCacheEntry* entry;
+	struct SchemaCacheEntry* other;
+	unsigned int idle = 0;
+
+	LOCK_CACHE();
+	for(link = &cacheHead; *link != NULL; link = &(*link)->next)
+	{
+		if(&(*link)->schema == schema)
+			break;
+	}
+
+	entry = *link;
+	if(entry != NULL)
+	{
+		// At most SCHEMA_CACHE_IDLE_INSTANCES instances of a schema are kept
+		// once the peak of its concurrent uses is over
+		for(other = cacheHead; other != NULL && !entry->stale; other = other->next)
+		{
+			if(other != entry && !other->inUse && sameKey(entry, other))
+			{
+				if(++idle >= SCHEMA_CACHE_IDLE_INSTANCES)
+					entry->stale = TRUE;
+			}
+		}
+
+		if(entry->stale)
+		{
+			*link = entry->next;
+			destroyEntry(entry);
+		}
+		else
+			entry->inUse = FALSE;
+	}
+	UNLOCK_CACHE();
+}
+
+void clearSchemaCache(void)
+{
+	struct SchemaCacheEntry** link;
+	struct SchemaCacheEntry* entry;
+
+	LOCK_CACHE();
+	link = &cacheHead;
+	while(*link != NULL)
+	{
+		entry = *link;
+		if(entry->inUse)
+			link = &entry->next;
+		else
+		{
+			*link = entry->next;
+			destroyEntry(entry);
+		}
+	}
+	UNLOCK_CACHE();
+}
+
+unsigned int getSchemaCacheCount(void)
+{
+	struct SchemaCacheEntry* entry;
+	unsigned int count = 0;
+
+	LOCK_CACHE();
+	for(entry = cacheHead; entry != NULL; entry = entry->next)
+		count++;
+	UNLOCK_CACHE();
+
+	return count;
+}
+
+/**
+ * @brief Reads the identity of each file of a schema path
+ */
+static errorCode getSchemaFileIds(const char* schemaPath, struct SchemaFileId* file, unsigned int* fileCount)
+{
+	char fileName[500];
+	const char* start = schemaPath;
+	size_t len;
+	struct stat fileStat;
+
+	*fileCount = 0;
+	while(*start != '\0')
+	{
+		len = strcspn(start, "=,");
+		if(len > 0)
+		{
+			if(*fileCount == MAX_XSD_FILES_COUNT || len >= sizeof(fileName))
+				return EXIP_INVALID_INPUT;
+
+			memcpy(fileName, start, len);
+			fileName[len] = '\0';
+			if(stat(fileName, &fileStat) != 0)
+			{
+				fprintf(stderr, "Unable to open XSD file \"%s\" for parsing\n", fileName);
+				return EXIP_INVALID_INPUT;
+			}
+
+			// The padding of the structure is compared too
+			memset(&file[*fileCount], 0, sizeof(struct SchemaFileId));
+			file[*fileCount].device = fileStat.st_dev;
+			file[*fileCount].inode = fileStat.st_ino;
+			file[*fileCount].size = fileStat.st_size;
+			file[*fileCount].modified = fileStat.st_mtime;
+			*fileCount += 1;
+		}
+
+		start += len;
+		if(*start != '\0')
+			start++;
+	}
+
+	return *fileCount > 0 ? EXIP_OK : EXIP_INVALID_INPUT;
+}
+
+/**
+ * @brief Whether the options mask of an entry is the given one
+ */
+static boolean sameMask(struct SchemaCacheEntry* entry, EXIOptions* maskOpt)
+{
+	if(maskOpt == NULL || !entry->hasMask)
+		return maskOpt == NULL && !entry->hasMask;
+
+	return entry->mask.enumOpt == maskOpt->enumOpt &&
+			entry->mask.preserve == maskOpt->preserve &&
+			entry->mask.drMap == maskOpt->drMap &&
+			entry->mask.blockSize == maskOpt->blockSize &&
+			entry->mask.valueMaxLength == maskOpt->valueMaxLength &&
+			entry->mask.valuePartitionCapacity == maskOpt->valuePartitionCapacity;
+}
+
+/**
+ * @brief Whether two entries are instances of the same schema
+ */
+static boolean sameKey(struct SchemaCacheEntry* entry, struct SchemaCacheEntry* other)
+{
+	if(strcmp(entry->path, other->path) != 0 || entry->hasMask != other->hasMask ||
+			(entry->hasMask && !sameMask(other, &entry->mask)))
+		return FALSE;
+
+	return entry->fileCount == other->fileCount &&
+			memcmp(entry->file, other->file, sizeof(struct SchemaFileId)*entry->fileCount) == 0;
+}
+
+static void destroyEntry(struct SchemaCacheEntry* entry)
+{
+	destroySchema(&entry->schema);
+	free(entry->path);
+	free(entry);
+}
@@ -0,0 +1,1215 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file xmlEncode.c
+ * @brief A streaming XML to EXI encoder. The XML text is read block by block,
+ * tokenized and passed to the serializer one event at a time.
+ */
+
+#include "encode.h"
+#include "codec_common.h"
+#include "lexicalValue.h"
+#include "EXISerializer.h"
+#include "stringManipulate.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#elif defined(__ARM_NEON)
+# include <arm_neon.h>
+#endif
+
+#define XML_INPUT_BUFFER_SIZE 4096
+#define OUTPUT_BUFFER_SIZE 200
+#define INITIAL_ITEM_CAPACITY 16
+#define INITIAL_CHARS_CAPACITY 256
+/** The largest Unicode code point */
+#define MAX_CODE_POINT 0x10FFFF
+/** The longest terminator of readUntil(): "-->" or "]]>" */
+#define MAX_TERMINATOR_LENGTH 3
+
+#define IS_XML_SPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+
+/** The delimiter sets of findDelimiter() have four characters; the shorter sets repeat some */
+#define DELIMITER_COUNT 4
+/** The characters that end a run of start or end tag text: '>' and the attribute value quotes */
+static const char TAG_DELIMITER[DELIMITER_COUNT] = {'>', '"', '\'', '>'};
+/** The characters of character data that are replaced: references and line ends */
+static const char CHAR_DATA_SPECIAL[DELIMITER_COUNT] = {'&', '\r', '&', '\r'};
+/** The characters of attribute values that are replaced: references and white space */
+static const char ATTR_VALUE_SPECIAL[DELIMITER_COUNT] = {'&', '\r', '\n', '\t'};
+
+/** The bytes of a 64 bit word equal to c have their high bit set (and possibly the higher bytes) */
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_HIGH_BITS 0x8080808080808080ULL
+#define SWAR_MATCH(w, c) ((((w) ^ (SWAR_ONES*(unsigned char) (c))) - SWAR_ONES) & ~((w) ^ (SWAR_ONES*(unsigned char) (c))) & SWAR_HIGH_BITS)
+
+static CharType XML_NAMESPACE_CHARS[] = "http://www.w3.org/XML/1998/namespace";
+static CharType XSI_NAMESPACE_CHARS[] = "http://www.w3.org/2001/XMLSchema-instance";
+
+/** A growing character buffer */
+struct CharBuffer
+{
+	char* str;
+	size_t length;
+	size_t capacity;
+};
+
+/** A namespace declaration in scope. The prefix and the URI are kept in XmlEncoder.nsChars */
+struct NsBinding
+{
+	size_t prefix;
+	size_t prefixLength;
+	size_t uri;
+	size_t uriLength;
+};
+
+/** An element whose end tag is not read yet */
+struct OpenElement
+{
+	/** The qualified name in XmlEncoder.names, matched with the end tag */
+	size_t name;
+	size_t nameLength;
+	/** The namespace declarations in scope before the start tag */
+	Index nsCount;
+	size_t nsCharsLength;
+	/** The value type class returned by serialize.startElement() */
+	EXITypeClass valueType;
+	boolean hasChildren;
+	/** TRUE if the element has xsi:nil="true" */
+	boolean isNil;
+};
+
+/** An attribute of the start tag being encoded. The name and the value are in XmlEncoder.tag */
+struct XmlAttribute
+{
+	size_t name;
+	size_t nameLength;
+	size_t value;
+	size_t valueLength;
+	String uri;
+	String ln;
+	String prefix;
+};
+
+struct XmlEncoder
+{
+	EXIStream strm;
+	size_t (*inputStream)(void* buf, size_t size, void* stream);
+	void* inStream;
+	char input[XML_INPUT_BUFFER_SIZE];
+	size_t inputPos;
+	size_t inputLength;
+	boolean inputEnd;
+	/** The character data read since the last tag */
+	struct CharBuffer text;
+	/** The text between '<' and '>' of the current tag */
+	struct CharBuffer tag;
+	/** The names of the open elements */
+	struct CharBuffer names;
+	struct CharBuffer nsChars;
+	struct NsBinding* ns;
+	Index nsCount;
+	Index nsCapacity;
+	struct OpenElement* elements;
+	Index depth;
+	Index elementCapacity;
+	struct XmlAttribute* attrs;
+	Index attrCount;
+	Index attrCapacity;
+	boolean rootSeen;
+};
+
+static errorCode growArray(void** array, Index* capacity, size_t itemSize);
+static errorCode appendChars(struct CharBuffer* buffer, const char* chars, size_t length);
+static boolean fillInput(struct XmlEncoder* enc);
+static errorCode nextChar(struct XmlEncoder* enc, char* c);
+static errorCode readCharData(struct XmlEncoder* enc, boolean* markup);
+static errorCode readTag(struct XmlEncoder* enc);
+static errorCode readUntil(struct XmlEncoder* enc, const char* terminator, size_t length, struct CharBuffer* out);
+static errorCode readMarkup(struct XmlEncoder* enc);
+static errorCode readDeclaration(struct XmlEncoder* enc);
+static size_t findDelimiter(const char* str, size_t length, const char* delimiters);
+static errorCode decodeReferences(char* str, size_t* length, const char* special);
+static errorCode decodeReference(const char* str, size_t length, size_t* in, char* out, size_t* outLength);
+static boolean isWhiteSpace(const char* str, size_t length);
+static size_t scanName(const char* str, size_t pos, size_t length);
+static errorCode pushNamespace(struct XmlEncoder* enc, const char* prefix, size_t prefixLength, const char* uri, size_t uriLength);
+static errorCode resolveName(struct XmlEncoder* enc, const char* name, size_t length, boolean useDefault, String* uri, String* ln, String* prefix);
+static int compareAttributes(const void* a, const void* b);
+static errorCode serializeValue(struct XmlEncoder* enc, EXITypeClass valueType, char* str, size_t length);
+static errorCode flushCharData(struct XmlEncoder* enc, boolean atEndTag);
+static errorCode startTag(struct XmlEncoder* enc);
+static errorCode endTag(struct XmlEncoder* enc, const char* name, size_t nameLength);
+
+errorCode encodeXmlFromFile(
+	EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	const char *inputFilePath,
+	char **outData,
+	size_t *outDataLen)
+{
+	FILE *inputFile;
+	errorCode ret;
+
+	inputFile = fopen(inputFilePath, "rb");
+	if (!inputFile)
+	{
+		fprintf(stderr, "Unable to open file \"%s\" for encoding\n", inputFilePath);
+		return EXIP_INVALID_INPUT;
+	}
+
+	ret = encodeXmlFromStream(schema, hasOptions, options, readFileInputStream, inputFile, outData, outDataLen);
+
+	fclose(inputFile);
+	return ret;
+}
+
+errorCode encodeXmlFromStream(
+	EXIPSchema *schema,
+	boolean hasOptions,
+	EXIOptions *options,
+	size_t (*inputStream)(void *buf, size_t size, void *stream),
+	void *inStream,
+	char **outData,
+	size_t *outDataLen)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct XmlEncoder *enc;
+	char buf[OUTPUT_BUFFER_SIZE];
+	BinaryBuffer buffer;
+	boolean markup = TRUE;
+
+	*outData = NULL;
+	*outDataLen = 0;
+
+	// The serializer has no comment, processing instruction and DOCTYPE events:
+	// preserving them would silently lose them
+	if (hasOptions && options != NULL && (IS_PRESERVED(options->preserve, PRESERVE_COMMENTS) ||
+			IS_PRESERVED(options->preserve, PRESERVE_PIS) || IS_PRESERVED(options->preserve, PRESERVE_DTD)))
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, (">Comments, processing instructions and DTD cannot be preserved\n"));
+		return EXIP_NOT_IMPLEMENTED_YET;
+	}
+
+	enc = calloc(1, sizeof(struct XmlEncoder));
+	if (enc == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	enc->inputStream = inputStream;
+	enc->inStream = inStream;
+
+	buffer.buf = buf;
+	buffer.bufLen = OUTPUT_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	buffer.bufStrm.buf = calloc(1, OUTPUT_BUFFER_SIZE);
+	buffer.bufStrm.bufLen = OUTPUT_BUFFER_SIZE;
+	if (buffer.bufStrm.buf == NULL)
+	{
+		free(enc);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	serialize.initHeader(&enc->strm);
+	enc->strm.header.has_cookie = TRUE;
+	enc->strm.header.has_options = hasOptions;
+	if (hasOptions && options != NULL)
+		enc->strm.header.opts = *options;
+
+	tmp_err_code = serialize.initStream(&enc->strm, buffer, schema);
+	if (tmp_err_code == EXIP_OK)
+		tmp_err_code = serialize.exiHeader(&enc->strm);
+	if (tmp_err_code == EXIP_OK)
+		tmp_err_code = serialize.startDocument(&enc->strm);
+
+	// A UTF-8 byte order mark is skipped
+	if (fillInput(enc) && enc->inputLength >= 3 && memcmp(enc->input, "\xEF\xBB\xBF", 3) == 0)
+		enc->inputPos = 3;
+
+	while (tmp_err_code == EXIP_OK && markup)
+	{
+		tmp_err_code = readCharData(enc, &markup);
+		if (tmp_err_code == EXIP_OK && markup)
+			tmp_err_code = readMarkup(enc);
+	}
+
+	if (tmp_err_code == EXIP_OK)
+	{
+		// Only white space may follow the root element
+		tmp_err_code = flushCharData(enc, FALSE);
+		if (tmp_err_code == EXIP_OK && (enc->depth > 0 || !enc->rootSeen))
+			tmp_err_code = EXIP_INVALID_INPUT;
+		if (tmp_err_code == EXIP_OK)
+			tmp_err_code = serialize.endDocument(&enc->strm);
+	}
+
+	free(enc->text.str);
+	free(enc->tag.str);
+	free(enc->names.str);
+	free(enc->nsChars.str);
+	free(enc->ns);
+	free(enc->elements);
+	free(enc->attrs);
+
+	if (tmp_err_code == EXIP_OK)
+	{
+		// closeEXIStream() flushes the buffer to bufStrm but keeps it
+		tmp_err_code = serialize.closeEXIStream(&enc->strm);
+		if (tmp_err_code == EXIP_OK)
+		{
+			*outData = enc->strm.buffer.bufStrm.buf;
+			*outDataLen = enc->strm.buffer.bufStrm.bufContent;
+			free(enc);
+			return EXIP_OK;
+		}
+	}
+	else
+		serialize.closeEXIStream(&enc->strm);
+
+	free(enc->strm.buffer.bufStrm.buf);
+	free(enc);
+	return tmp_err_code;
+}
+
+static errorCode growArray(void** array, Index* capacity, size_t itemSize)
+{
+	Index newCapacity = *capacity == 0 ? INITIAL_ITEM_CAPACITY : *capacity*2;
+	void* newArray = realloc(*array, newCapacity*itemSize);
+
+	if(newArray == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	*array = newArray;
+	*capacity = newCapacity;
+	return EXIP_OK;
+}
+
+static errorCode appendChars(struct CharBuffer* buffer, const char* chars, size_t length)
+{
+	if(buffer->length + length > buffer->capacity)
+	{
+		size_t newCapacity = buffer->capacity == 0 ? INITIAL_CHARS_CAPACITY : buffer->capacity;
+		char* newStr;
+
+		while(buffer->length + length > newCapacity)
+			newCapacity *= 2;
+
+		newStr = realloc(buffer->str, newCapacity);
+		if(newStr == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+
+		buffer->str = newStr;
+		buffer->capacity = newCapacity;
+	}
+
+	if(length > 0)
+		memcpy(buffer->str + buffer->length, chars, length);
+	buffer->length += length;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Reads the next block of the input when the current one is consumed
+ * @return FALSE at the end of the input
+ */
+static boolean fillInput(struct XmlEncoder* enc)
+{
+	if(enc->inputPos < enc->inputLength)
+		return TRUE;
+
+	if(enc->inputEnd)
+		return FALSE;
+
+	enc->inputPos = 0;
+	enc->inputLength = enc->inputStream(enc->input, XML_INPUT_BUFFER_SIZE, enc->inStream);
+	if(enc->inputLength == 0)
+	{
+		enc->inputEnd = TRUE;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static errorCode nextChar(struct XmlEncoder* enc, char* c)
+{
+	if(!fillInput(enc))
+		return EXIP_INVALID_INPUT;
+
+	*c = enc->input[enc->inputPos];
+	enc->inputPos++;
+	return EXIP_OK;
+}
+
+/**
+ * @brief Returns the position of the first of the DELIMITER_COUNT delimiters in str,
+ * or length if there is none. Uses SSE2/AVX2 or NEON when the compiler targets them
+ * and a word-at-a-time scalar loop otherwise.
+ */
+static size_t findDelimiter(const char* str, size_t length, const char* delimiters)
+{
+	const unsigned char* data = (const unsigned char*) str;
+	size_t i = 0;
+	uint64_t w;
+
+#if defined(__AVX2__)
+	{
+		const __m256i d0 = _mm256_set1_epi8(delimiters[0]);
+		const __m256i d1 = _mm256_set1_epi8(delimiters[1]);
+		const __m256i d2 = _mm256_set1_epi8(delimiters[2]);
+		const __m256i d3 = _mm256_set1_epi8(delimiters[3]);
+
+		for(; i + 32 <= length; i += 32)
+		{
+			__m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+			unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, d0), _mm256_cmpeq_epi8(v, d1)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, d2), _mm256_cmpeq_epi8(v, d3))));
+			if(mask != 0)
+				return i + __builtin_ctz(mask);
+		}
+	}
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+	{
+		const __m128i d0 = _mm_set1_epi8(delimiters[0]);
+		const __m128i d1 = _mm_set1_epi8(delimiters[1]);
+		const __m128i d2 = _mm_set1_epi8(delimiters[2]);
+		const __m128i d3 = _mm_set1_epi8(delimiters[3]);
+
+		for(; i + 16 <= length; i += 16)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+			unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, d0), _mm_cmpeq_epi8(v, d1)),
+					_mm_or_si128(_mm_cmpeq_epi8(v, d2), _mm_cmpeq_epi8(v, d3))));
+			if(mask != 0)
+				return i + __builtin_ctz(mask);
+		}
+	}
+#elif defined(__ARM_NEON)
+	{
+		const uint8x16_t d0 = vdupq_n_u8((unsigned char) delimiters[0]);
+		const uint8x16_t d1 = vdupq_n_u8((unsigned char) delimiters[1]);
+		const uint8x16_t d2 = vdupq_n_u8((unsigned char) delimiters[2]);
+		const uint8x16_t d3 = vdupq_n_u8((unsigned char) delimiters[3]);
+
+		for(; i + 16 <= length; i += 16)
+		{
+			// Any matching lane ends the run; the exact position is found below
+			uint8x16_t v = vld1q_u8(data + i);
+			uint64x2_t match = vreinterpretq_u64_u8(vorrq_u8(vorrq_u8(vceqq_u8(v, d0), vceqq_u8(v, d1)),
+					vorrq_u8(vceqq_u8(v, d2), vceqq_u8(v, d3))));
+			if((vgetq_lane_u64(match, 0) | vgetq_lane_u64(match, 1)) != 0)
+				break;
+		}
+	}
+#endif
+
+	// Scalar fallback: eight bytes per step while none of them is a delimiter
+	for(; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+	{
+		memcpy(&w, data + i, sizeof(uint64_t));
+		if((SWAR_MATCH(w, delimiters[0]) | SWAR_MATCH(w, delimiters[1]) |
+				SWAR_MATCH(w, delimiters[2]) | SWAR_MATCH(w, delimiters[3])) != 0)
+			break;
+	}
+
+	while(i < length && str[i] != delimiters[0] && str[i] != delimiters[1] &&
+			str[i] != delimiters[2] && str[i] != delimiters[3])
+		i++;
+
+	return i;
+}
+
+/**
+ * @brief Appends the character data up to the next '<' to enc->text, with the
+ * references and the line ends replaced. The '<' is consumed.
+ *
+ * @param[out] markup FALSE if the end of the input is reached instead of a '<'
+ */
+static errorCode readCharData(struct XmlEncoder* enc, boolean* markup)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	size_t start = enc->text.length;
+	size_t length;
+	const char* lt;
+
+	*markup = FALSE;
+	while(fillInput(enc))
+	{
+		lt = memchr(enc->input + enc->inputPos, '<', enc->inputLength - enc->inputPos);
+		length = lt != NULL ? (size_t) (lt - enc->input) - enc->inputPos : enc->inputLength - enc->inputPos;
+
+		TRY(appendChars(&enc->text, enc->input + enc->inputPos, length));
+		enc->inputPos += length;
+
+		if(lt != NULL)
+		{
+			enc->inputPos++;
+			*markup = TRUE;
+			break;
+		}
+	}
+
+	// A reference cannot contain '<': the run is complete
+	length = enc->text.length - start;
+	if(length > 0)
+	{
+		TRY(decodeReferences(enc->text.str + start, &length, CHAR_DATA_SPECIAL));
+		enc->text.length = start + length;
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Reads the text of a start or end tag up to the closing '>' into enc->tag.
+ * A '>' in a quoted attribute value does not close the tag.
+ */
+static errorCode readTag(struct XmlEncoder* enc)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char quote = 0;
+	size_t pos;
+	const char* found;
+
+	while(TRUE)
+	{
+		if(!fillInput(enc))
+			return EXIP_INVALID_INPUT;
+
+		pos = enc->inputPos;
+		if(quote != 0)
+		{
+			found = memchr(enc->input + pos, quote, enc->inputLength - pos);
+			if(found != NULL)
+			{
+				pos = (size_t) (found - enc->input) + 1;
+				quote = 0;
+			}
+			else
+				pos = enc->inputLength;
+		}
+		else
+		{
+			pos += findDelimiter(enc->input + pos, enc->inputLength - pos, TAG_DELIMITER);
+
+			if(pos < enc->inputLength)
+			{
+				if(enc->input[pos] == '>')
+				{
+					TRY(appendChars(&enc->tag, enc->input + enc->inputPos, pos - enc->inputPos));
+					enc->inputPos = pos + 1;
+					return EXIP_OK;
+				}
+
+				quote = enc->input[pos];
+				pos++;
+			}
+		}
+
+		TRY(appendChars(&enc->tag, enc->input + enc->inputPos, pos - enc->inputPos));
+		enc->inputPos = pos;
+	}
+}
+
+/**
+ * @brief Reads up to and including a terminator such as "-->".
+ * The characters before the terminator are appended to out if it is not NULL.
+ */
+static errorCode readUntil(struct XmlEncoder* enc, const char* terminator, size_t length, struct CharBuffer* out)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	// The last characters of the previous blocks, the most recent last
+	char history[MAX_TERMINATOR_LENGTH] = {0};
+	const char* block;
+	const char* found;
+	size_t blockLength;
+	size_t i;
+	size_t j;
+	boolean match;
+
+	while(fillInput(enc))
+	{
+		block = enc->input + enc->inputPos;
+		blockLength = enc->inputLength - enc->inputPos;
+		i = 0;
+
+		while(i < blockLength && (found = memchr(block + i, terminator[length - 1], blockLength - i)) != NULL)
+		{
+			i = (size_t) (found - block);
+			match = TRUE;
+			for(j = 1; j < length && match; j++)
+			{
+				if(i >= j)
+					match = block[i - j] == terminator[length - 1 - j];
+				else
+					match = history[MAX_TERMINATOR_LENGTH - (j - i)] == terminator[length - 1 - j];
+			}
+
+			i++;
+			if(match)
+			{
+				if(out != NULL)
+				{
+					TRY(appendChars(out, block, i));
+					// The terminator may start in a previous block
+					out->length -= length;
+				}
+				enc->inputPos += i;
+				return EXIP_OK;
+			}
+		}
+
+		if(out != NULL)
+			TRY(appendChars(out, block, blockLength));
+
+		if(blockLength >= MAX_TERMINATOR_LENGTH)
+			memcpy(history, block + blockLength - MAX_TERMINATOR_LENGTH, MAX_TERMINATOR_LENGTH);
+		else
+		{
+			memmove(history, history + blockLength, MAX_TERMINATOR_LENGTH - blockLength);
+			memcpy(history + MAX_TERMINATOR_LENGTH - blockLength, block, blockLength);
+		}
+		enc->inputPos = enc->inputLength;
+	}
+
+	return EXIP_INVALID_INPUT;
+}
+
+/**
+ * @brief Reads and encodes the markup that follows a '<'
+ */
+static errorCode readMarkup(struct XmlEncoder* enc)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char c;
+	size_t length;
+
+	TRY(nextChar(enc, &c));
+	enc->tag.length = 0;
+
+	switch(c)
+	{
+		case '/':
+			TRY(readTag(enc));
+			length = enc->tag.length;
+			while(length > 0 && IS_XML_SPACE(enc->tag.str[length - 1]))
+				length--;
+			return endTag(enc, enc->tag.str, length);
+		case '?':
+			// The XML declaration and the processing instructions are not encoded
+			return readUntil(enc, "?>", 2, NULL);
+		case '!':
+			return readDeclaration(enc);
+		default:
+			TRY(appendChars(&enc->tag, &c, 1));
+			TRY(readTag(enc));
+			return startTag(enc);
+	}
+}
+
+/**
+ * @brief Reads a comment, a CDATA section or the document type declaration after "<!".
+ * The content of a CDATA section is added to the character data.
+ */
+static errorCode readDeclaration(struct XmlEncoder* enc)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char c;
+	char quote = 0;
+	int brackets = 0;
+	char keyword[7];
+	unsigned int i;
+
+	TRY(nextChar(enc, &c));
+	if(c == '-')
+	{
+		TRY(nextChar(enc, &c));
+		if(c != '-')
+			return EXIP_INVALID_INPUT;
+		return readUntil(enc, "-->", 3, NULL);
+	}
+	else if(c == '[')
+	{
+		for(i = 0; i < 6; i++)
+			TRY(nextChar(enc, &keyword[i]));
+		if(memcmp(keyword, "CDATA[", 6) != 0)
+			return EXIP_INVALID_INPUT;
+		return readUntil(enc, "]]>", 3, &enc->text);
+	}
+
+	// <!DOCTYPE ...>: the internal subset is skipped as well
+	while(TRUE)
+	{
+		if(quote != 0)
+		{
+			if(c == quote)
+				quote = 0;
+		}
+		else if(c == '"' || c == '\'')
+			quote = c;
+		else if(c == '[')
+			brackets++;
+		else if(c == ']')
+			brackets--;
+		else if(c == '>' && brackets == 0)
+			return EXIP_OK;
+
+		TRY(nextChar(enc, &c));
+	}
+}
+
+/**
+ * @brief Replaces in place the entity and character references and the line ends
+ * of character data or of an attribute value
+ *
+ * @param[in, out] str the characters
+ * @param[in, out] length the number of characters
+ * @param[in] special CHAR_DATA_SPECIAL or ATTR_VALUE_SPECIAL
+ */
+static errorCode decodeReferences(char* str, size_t* length, const char* special)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	size_t in = 0;
+	size_t out = 0;
+	size_t run;
+
+	while(in < *length)
+	{
+		run = in;
+		in += findDelimiter(str + in, *length - in, special);
+
+		if(out != run)
+			memmove(str + out, str + run, in - run);
+		out += in - run;
+
+		if(in == *length)
+			break;
+
+		if(str[in] == '&')
+		{
+			TRY(decodeReference(str, *length, &in, str + out, &run));
+			out += run;
+		}
+		else
+		{
+			// CR LF and CR are line ends; the white space of attribute values is normalized
+			if(str[in] == '\r' && in + 1 < *length && str[in + 1] == '\n')
+				in++;
+			str[out++] = special == ATTR_VALUE_SPECIAL ? ' ' : '\n';
+			in++;
+		}
+	}
+
+	*length = out;
+	return EXIP_OK;
+}
+
+/**
+ * @brief Decodes the reference at str[*in] to out, UTF-8 encoded.
+ * The decoded characters are never longer than the reference.
+ */
+static errorCode decodeReference(const char* str, size_t length, size_t* in, char* out, size_t* outLength)
+{
+	const char* name = str + *in + 1;
+	const char* end;
+	uint32_t code = 0;
+	size_t nameLength;
+
+	end = memchr(name, ';', length - *in - 1);
+	if(end == NULL)
+		return EXIP_INVALID_INPUT;
+
+	nameLength = (size_t) (end - name);
+	*in += nameLength + 2;
+
+	if(nameLength > 1 && name[0] == '#')
+	{
+		const char* digit = name + 1;
+
+		if(*digit == 'x')
+		{
+			for(digit++; digit < end; digit++)
+			{
+				if(*digit >= '0' && *digit <= '9')
+					code = code*16 + (uint32_t) (*digit - '0');
+				else if(*digit >= 'a' && *digit <= 'f')
+					code = code*16 + (uint32_t) (*digit - 'a' + 10);
+				else if(*digit >= 'A' && *digit <= 'F')
+					code = code*16 + (uint32_t) (*digit - 'A' + 10);
+				else
+					return EXIP_INVALID_INPUT;
+
+				// Checked at each digit: the leading zeros make the number of digits unbounded
+				if(code > MAX_CODE_POINT)
+					return EXIP_INVALID_INPUT;
+			}
+		}
+		else
+		{
+			for(; digit < end; digit++)
+			{
+				if(*digit < '0' || *digit > '9')
+					return EXIP_INVALID_INPUT;
+				code = code*10 + (uint32_t) (*digit - '0');
+				if(code > MAX_CODE_POINT)
+					return EXIP_INVALID_INPUT;
+			}
+		}
+
+		if(code == 0)
+			return EXIP_INVALID_INPUT;
+
+		if(code < 0x80)
+		{
+			out[0] = (char) code;
+			*outLength = 1;
+		}
+		else if(code < 0x800)
+		{
+			out[0] = (char) (0xC0 | (code >> 6));
+			out[1] = (char) (0x80 | (code & 0x3F));
+			*outLength = 2;
+		}
+		else if(code < 0x10000)
+		{
+			out[0] = (char) (0xE0 | (code >> 12));
+			out[1] = (char) (0x80 | ((code >> 6) & 0x3F));
+			out[2] = (char) (0x80 | (code & 0x3F));
+			*outLength = 3;
+		}
+		else
+		{
+			out[0] = (char) (0xF0 | (code >> 18));
+			out[1] = (char) (0x80 | ((code >> 12) & 0x3F));
+			out[2] = (char) (0x80 | ((code >> 6) & 0x3F));
+			out[3] = (char) (0x80 | (code & 0x3F));
+			*outLength = 4;
+		}
+
+		return EXIP_OK;
+	}
+
+	*outLength = 1;
+	if(nameLength == 2 && memcmp(name, "lt", 2) == 0)
+		out[0] = '<';
+	else if(nameLength == 2 && memcmp(name, "gt", 2) == 0)
+		out[0] = '>';
+	else if(nameLength == 3 && memcmp(name, "amp", 3) == 0)
+		out[0] = '&';
+	else if(nameLength == 4 && memcmp(name, "quot", 4) == 0)
+		out[0] = '"';
+	else if(nameLength == 4 && memcmp(name, "apos", 4) == 0)
+		out[0] = '\'';
+	else
+		return EXIP_INVALID_INPUT;
+
+	return EXIP_OK;
+}
+
+static boolean isWhiteSpace(const char* str, size_t length)
+{
+	size_t i;
+
+	for(i = 0; i < length; i++)
+	{
+		if(!IS_XML_SPACE(str[i]))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * @brief Returns the length of the name at str[pos]
+ */
+static size_t scanName(const char* str, size_t pos, size_t length)
+{
+	size_t end = pos;
+
+	while(end < length && !IS_XML_SPACE(str[end]) && str[end] != '=' && str[end] != '/')
+		end++;
+
+	return end - pos;
+}
+
+static errorCode pushNamespace(struct XmlEncoder* enc, const char* prefix, size_t prefixLength, const char* uri, size_t uriLength)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct NsBinding* binding;
+
+	if(enc->nsCount == enc->nsCapacity)
+		TRY(growArray((void**) &enc->ns, &enc->nsCapacity, sizeof(struct NsBinding)));
+
+	binding = &enc->ns[enc->nsCount];
+	binding->prefix = enc->nsChars.length;
+	binding->prefixLength = prefixLength;
+	TRY(appendChars(&enc->nsChars, prefix, prefixLength));
+	binding->uri = enc->nsChars.length;
+	binding->uriLength = uriLength;
+	TRY(appendChars(&enc->nsChars, uri, uriLength));
+	enc->nsCount++;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Resolves the prefix of a qualified name with the namespace declarations in scope.
+ * The strings point to the name and to enc->nsChars.
+ *
+ * @param[in] useDefault TRUE if a name without prefix is in the default namespace,
+ * as element names; FALSE for attribute names
+ * @param[out] prefix the prefix of the name, empty if it has none
+ */
+static errorCode resolveName(struct XmlEncoder* enc, const char* name, size_t length, boolean useDefault, String* uri, String* ln, String* prefix)
+{
+	const char* colon = memchr(name, ':', length);
+	size_t prefixLength = colon != NULL ? (size_t) (colon - name) : 0;
+	Index i;
+
+	getEmptyString(uri);
+	prefix->str = (CharType*) name;
+	prefix->length = (Index) prefixLength;
+	ln->str = (CharType*) (colon != NULL ? colon + 1 : name);
+	ln->length = (Index) (length - (colon != NULL ? prefixLength + 1 : 0));
+
+	if(ln->length == 0 || (colon != NULL && prefixLength == 0))
+		return EXIP_INVALID_INPUT;
+
+	if(colon == NULL && !useDefault)
+		return EXIP_OK;
+
+	for(i = enc->nsCount; i > 0; i--)
+	{
+		struct NsBinding* binding = &enc->ns[i - 1];
+
+		if(binding->prefixLength == prefixLength &&
+				(prefixLength == 0 || memcmp(enc->nsChars.str + binding->prefix, name, prefixLength) == 0))
+		{
+			// xmlns="" undeclares the default namespace
+			if(binding->uriLength > 0)
+			{
+				uri->str = enc->nsChars.str + binding->uri;
+				uri->length = (Index) binding->uriLength;
+			}
+			return EXIP_OK;
+		}
+	}
+
+	if(colon == NULL)
+		return EXIP_OK;
+
+	if(prefixLength == 3 && memcmp(name, "xml", 3) == 0)
+	{
+		uri->str = XML_NAMESPACE_CHARS;
+		uri->length = (Index) strlen(XML_NAMESPACE_CHARS);
+		return EXIP_OK;
+	}
+
+	DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, (">Undeclared namespace prefix\n"));
+	return EXIP_INVALID_INPUT;
+}
+
+/**
+ * @brief The order of the attributes in EXI: xsi:type, xsi:nil, then the others
+ * by local name and by URI
+ */
+static int compareAttributes(const void* a, const void* b)
+{
+	const struct XmlAttribute* attrA = a;
+	const struct XmlAttribute* attrB = b;
+	String xsiNamespace = {XSI_NAMESPACE_CHARS, sizeof(XSI_NAMESPACE_CHARS) - 1};
+	int rankA = 2;
+	int rankB = 2;
+	int diff;
+
+	if(stringEqual(attrA->uri, xsiNamespace))
+	{
+		if(stringEqualToAscii(attrA->ln, "type"))
+			rankA = 0;
+		else if(stringEqualToAscii(attrA->ln, "nil"))
+			rankA = 1;
+	}
+
+	if(stringEqual(attrB->uri, xsiNamespace))
+	{
+		if(stringEqualToAscii(attrB->ln, "type"))
+			rankB = 0;
+		else if(stringEqualToAscii(attrB->ln, "nil"))
+			rankB = 1;
+	}
+
+	if(rankA != rankB)
+		return rankA - rankB;
+
+	diff = stringCompare(attrA->ln, attrB->ln);
+	if(diff != 0)
+		return diff;
+
+	return stringCompare(attrA->uri, attrB->uri);
+}
+
+/**
+ * @brief Serializes a value in its lexical form. QName values are
+ * resolved with the namespace declarations in scope
+ */
+static errorCode serializeValue(struct XmlEncoder* enc, EXITypeClass valueType, char* str, size_t length)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	if(valueType == VALUE_TYPE_QNAME_CLASS)
+	{
+		String uri;
+		String ln;
+		String prefix;
+		QName qname = {&uri, &ln, &prefix};
+
+		while(length > 0 && IS_XML_SPACE(*str))
+		{
+			str++;
+			length--;
+		}
+		while(length > 0 && IS_XML_SPACE(str[length - 1]))
+			length--;
+
+		TRY(resolveName(enc, str, length, TRUE, &uri, &ln, &prefix));
+		return serialize.qnameData(&enc->strm, qname);
+	}
+
+	return serializeLexicalValue(&enc->strm, valueType, str, length);
+}
+
+/**
+ * @brief Serializes the character data read since the last tag. The character data of
+ * an element with simple content is its value, even if it is empty or white space.
+ * Any other character data is only serialized if it is not white space.
+ */
+static errorCode flushCharData(struct XmlEncoder* enc, boolean atEndTag)
+{
+	errorCode tmp_err_code = EXIP_OK;
+	struct OpenElement* element = enc->depth > 0 ? &enc->elements[enc->depth - 1] : NULL;
+	String chVal;
+
+	if(element != NULL && atEndTag && !element->hasChildren && !element->isNil &&
+			element->valueType != VALUE_TYPE_NONE_CLASS && element->valueType != VALUE_TYPE_UNTYPED_CLASS)
+	{
+		if(enc->text.length > 0 || element->valueType == VALUE_TYPE_STRING_CLASS)
+			tmp_err_code = serializeValue(enc, element->valueType, enc->text.str, enc->text.length);
+	}
+	else if(!isWhiteSpace(enc->text.str, enc->text.length))
+	{
+		if(element == NULL)
+			tmp_err_code = EXIP_INVALID_INPUT;
+		else
+		{
+			chVal.str = enc->text.str;
+			chVal.length = (Index) enc->text.length;
+			tmp_err_code = serialize.stringData(&enc->strm, chVal);
+		}
+	}
+
+	enc->text.length = 0;
+	return tmp_err_code;
+}
+
+/**
+ * @brief Encodes the start tag in enc->tag: SE, the namespace declarations
+ * are put in scope and the attributes are serialized in the EXI order
+ */
+static errorCode startTag(struct XmlEncoder* enc)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char* tag = enc->tag.str;
+	size_t length = enc->tag.length;
+	boolean isEmpty = FALSE;
+	struct OpenElement element;
+	struct XmlAttribute* attr;
+	const char* valueEnd;
+	size_t pos;
+	size_t start;
+	char quote;
+	String uri;
+	String ln;
+	String prefix;
+	QName qname = {&uri, &ln, &prefix};
+	EXITypeClass valueType;
+	String xsiNamespace = {XSI_NAMESPACE_CHARS, sizeof(XSI_NAMESPACE_CHARS) - 1};
+	boolean nil;
+	boolean isLocalElementNS = FALSE;
+	Index i;
+
+	if(length > 0 && tag[length - 1] == '/')
+	{
+		isEmpty = TRUE;
+		length--;
+	}
+
+	TRY(flushCharData(enc, FALSE));
+	if(enc->depth == 0)
+	{
+		if(enc->rootSeen)
+			return EXIP_INVALID_INPUT;
+		enc->rootSeen = TRUE;
+	}
+	else
+		enc->elements[enc->depth - 1].hasChildren = TRUE;
+
+	element.nameLength = scanName(tag, 0, length);
+	if(element.nameLength == 0)
+		return EXIP_INVALID_INPUT;
+	element.name = enc->names.length;
+	element.nsCount = enc->nsCount;
+	element.nsCharsLength = enc->nsChars.length;
+	element.hasChildren = FALSE;
+	element.isNil = FALSE;
+	TRY(appendChars(&enc->names, tag, element.nameLength));
+
+	// The namespace declarations are put in scope before any name of the tag is resolved
+	enc->attrCount = 0;
+	pos = element.nameLength;
+	while(TRUE)
+	{
+		start = pos;
+		while(pos < length && IS_XML_SPACE(tag[pos]))
+			pos++;
+
+		if(pos == length)
+			break;
+		if(pos == start)
+			return EXIP_INVALID_INPUT;
+
+		if(enc->attrCount == enc->attrCapacity)
+			TRY(growArray((void**) &enc->attrs, &enc->attrCapacity, sizeof(struct XmlAttribute)));
+		attr = &enc->attrs[enc->attrCount];
+
+		attr->name = pos;
+		attr->nameLength = scanName(tag, pos, length);
+		pos += attr->nameLength;
+		while(pos < length && IS_XML_SPACE(tag[pos]))
+			pos++;
+		if(attr->nameLength == 0 || pos == length || tag[pos] != '=')
+			return EXIP_INVALID_INPUT;
+
+		pos++;
+		while(pos < length && IS_XML_SPACE(tag[pos]))
+			pos++;
+		if(pos == length || (tag[pos] != '"' && tag[pos] != '\''))
+			return EXIP_INVALID_INPUT;
+
+		quote = tag[pos];
+		pos++;
+		valueEnd = memchr(tag + pos, quote, length - pos);
+		if(valueEnd == NULL)
+			return EXIP_INVALID_INPUT;
+
+		attr->value = pos;
+		attr->valueLength = (size_t) (valueEnd - tag) - pos;
+		pos = (size_t) (valueEnd - tag) + 1;
+		TRY(decodeReferences(tag + attr->value, &attr->valueLength, ATTR_VALUE_SPECIAL));
+
+		if(attr->nameLength == 5 && memcmp(tag + attr->name, "xmlns", 5) == 0)
+			TRY(pushNamespace(enc, NULL, 0, tag + attr->value, attr->valueLength));
+		else if(attr->nameLength > 6 && memcmp(tag + attr->name, "xmlns:", 6) == 0)
+			TRY(pushNamespace(enc, tag + attr->name + 6, attr->nameLength - 6, tag + attr->value, attr->valueLength));
+		else
+			enc->attrCount++;
+	}
+
+	TRY(resolveName(enc, tag, element.nameLength, TRUE, &uri, &ln, &prefix));
+	TRY(serialize.startElement(&enc->strm, qname, &element.valueType));
+
+	if(IS_PRESERVED(enc->strm.header.opts.preserve, PRESERVE_PREFIXES))
+	{
+		// NS events in the document order; the first one that declares the
+		// prefix of the element gives it to the element
+		for(i = element.nsCount; i < enc->nsCount; i++)
+		{
+			struct NsBinding* binding = &enc->ns[i];
+			String nsUri = {enc->nsChars.str + binding->uri, (Index) binding->uriLength};
+			String nsPrefix = {enc->nsChars.str + binding->prefix, (Index) binding->prefixLength};
+			boolean isLocal = !isLocalElementNS && stringEqual(nsPrefix, prefix);
+
+			TRY(serialize.namespaceDeclaration(&enc->strm, nsUri, nsPrefix, isLocal));
+			isLocalElementNS = isLocalElementNS || isLocal;
+		}
+	}
+
+	for(i = 0; i < enc->attrCount; i++)
+		TRY(resolveName(enc, tag + enc->attrs[i].name, enc->attrs[i].nameLength, FALSE, &enc->attrs[i].uri, &enc->attrs[i].ln, &enc->attrs[i].prefix));
+
+	if(enc->attrCount > 1)
+		qsort(enc->attrs, enc->attrCount, sizeof(struct XmlAttribute), compareAttributes);
+
+	for(i = 0; i < enc->attrCount; i++)
+	{
+		attr = &enc->attrs[i];
+		if(stringEqual(attr->uri, xsiNamespace) && stringEqualToAscii(attr->ln, "nil") &&
+				parseBooleanValue(tag + attr->value, attr->valueLength, &nil) == EXIP_OK)
+			element.isNil = nil;
+
+		qname.uri = &attr->uri;
+		qname.localName = &attr->ln;
+		qname.prefix = &attr->prefix;
+		TRY(serialize.attribute(&enc->strm, qname, TRUE, &valueType));
+		// The schema-informed grammars give xsi:type the String class but its value is a QName
+		if(stringEqual(attr->uri, xsiNamespace) && stringEqualToAscii(attr->ln, "type"))
+			valueType = VALUE_TYPE_QNAME_CLASS;
+		TRY(serializeValue(enc, valueType, tag + attr->value, attr->valueLength));
+	}
+
+	if(enc->depth == enc->elementCapacity)
+		TRY(growArray((void**) &enc->elements, &enc->elementCapacity, sizeof(struct OpenElement)));
+	enc->elements[enc->depth] = element;
+	enc->depth++;
+
+	if(isEmpty)
+		return endTag(enc, NULL, 0);
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Encodes an end tag: the character data of the element and EE
+ *
+ * @param[in] name the name of the end tag; NULL for an empty-element tag
+ */
+static errorCode endTag(struct XmlEncoder* enc, const char* name, size_t nameLength)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct OpenElement* element;
+
+	if(enc->depth == 0)
+		return EXIP_INVALID_INPUT;
+
+	element = &enc->elements[enc->depth - 1];
+	if(name != NULL && (nameLength != element->nameLength || memcmp(name, enc->names.str + element->name, nameLength) != 0))
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, (">End tag does not match the start tag\n"));
+		return EXIP_INVALID_INPUT;
+	}
+
+	TRY(flushCharData(enc, TRUE));
+	TRY(serialize.endElement(&enc->strm));
+
+	enc->nsCount = element->nsCount;
+	enc->nsChars.length = element->nsCharsLength;
+	enc->names.length = element->name;
+	enc->depth--;
+
+	return EXIP_OK;
+}
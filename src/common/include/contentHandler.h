@@ -40,6 +40,9 @@ struct ContentHandler
 	errorCode (*stringData)(const String str_val, void* app_data);
 	errorCode (*floatData)(Float float_val, void* app_data);
 	errorCode (*binaryData)(const char* binary_val, Index nbytes, void* app_data);
+	// Used instead of binaryData when a chunk size is set by setBinaryChunkSize(): called once per chunk
+	// of up to chunkSize bytes; offset is the position of the chunk in the value of totalBytes
+	errorCode (*binaryDataChunk)(const char* chunk, Index nbytes, Index offset, Index totalBytes, void* app_data);
 	errorCode (*dateTimeData)(EXIPDateTime dt_val, void* app_data);
 	errorCode (*decimalData)(Decimal dec_val, void* app_data);
 	errorCode (*listData)(EXITypeClass exiType, unsigned int itemCount, void* app_data);
@@ -9,17 +9,18 @@
 #include "procTypes.h"
 
 /**
- * DJB Hash Function
- * An algorithm produced by Professor Daniel J. Bernstein and shown first to the world
- * on the usenet newsgroup comp.lang.c. It is one of the most efficient hash functions ever published.
- *
- * djb2
- * this algorithm (k=33) was first reported by dan bernstein many years ago in comp.lang.c.
- * another version of this algorithm (now favored by bernstein) uses xor: hash(i) = hash(i - 1) * 33 ^ str[i];
- * the magic of number 33 (why it works better than many other constants, prime or not) has never
- * been adequately explained.
+ * Word-at-a-time string hash (the MurmurHash3 x86_32 mixing).
+ * The string is consumed four bytes per step followed by a final
+ * avalanche so that all the bits of the result are usable as a table index.
+ * This is the hash function of the value and string table indexes.
  **/
-uint32_t djbHash(String str);
+uint32_t stringHash(String str);
+
+/* The hash table is a flat array of slots with linear probing. The number of
+ * slots is a power of two and is doubled when 3/4 of them are used; there is no
+ * upper limit. Inserting and removing keys does not allocate memory per entry.
+ * The keys are not copied - the memory of the key strings must be valid while
+ * they are in the table. */
 
 struct hashtable;
 
@@ -83,7 +84,7 @@ struct hashtable;
  * create_hashtable
    
  * @name                    create_hashtable
- * @param   minsize         minimum initial size of hashtable
+ * @param   minsize         minimum initial number of slots; rounded up to a power of two
  * @param   hashfunction    function for hashing keys
  * @param   key_eq_fn       function for determining key equality
  * @return                  newly created hashtable or NULL on failure
@@ -99,7 +100,7 @@ create_hashtable(unsigned int minsize,
    
  * @name        hashtable_insert
  * @param   h   the hashtable to insert into
- * @param   k   the key - hashtable claims ownership and will free on removal
+ * @param   k   the key - does not claim ownership
  * @param   v   the value - does not claim ownership
  * @return      EXIP_OK for successful insertion
  *
@@ -107,9 +108,7 @@ create_hashtable(unsigned int minsize,
  * the ratio of entries to table size over the maximum load factor.
  *
  * This function does not check for repeated insertions with a duplicate key.
- * The value returned when using a duplicate key is undefined -- when
- * the hashtable changes size, the order of retrieval of duplicate key
- * entries is reversed.
+ * The value returned when using a duplicate key is undefined.
  * If in doubt, remove before insert.
  */
 
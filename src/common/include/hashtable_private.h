@@ -1,4 +1,5 @@
 /* Copyright (C) 2002, 2004 Christopher Clark <firstname.lastname@cl.cam.ac.uk> */
+/* Reworked as a flat open addressing table with linear probing */
 /* @par[Revision] $Id$
  **/
 
@@ -8,50 +9,35 @@
 #include "hashtable.h"
 
 /*****************************************************************************/
+/** The key and value of an occupied slot */
 struct entry
 {
     String key;
     Index value;
-    uint32_t hash;
-    struct entry *next;
 };
 
+/**
+ * Flat open addressing table with linear probing. The number of slots
+ * is a power of two. The hashes of the keys are stored apart from the entries
+ * so that probing touches a compact array and the keys are compared only
+ * when the stored hash matches. A stored hash of 0 marks an empty slot.
+ */
 struct hashtable {
-    unsigned int tablelength;
-    struct entry **table;
-    unsigned int entrycount;
-    unsigned int loadlimit;
-    unsigned int primeindex;
+    Index size;
+    Index count;
+    Index loadlimit;
+    uint32_t* hashes;
+    struct entry* entries;
     uint32_t (*hashfn) (String key);
     boolean (*eqfn) (const String str1, const String str2);
 };
 
 /*****************************************************************************/
+/** The table is expanded when more than 3/4 of the slots are used */
+#define LOAD_LIMIT(size) ((size) - (size)/4)
 
-// uint32_t hash(struct hashtable *h, void *k, unsigned int len);
-
-/*****************************************************************************/
-/* indexFor */
-/* inline not supported by all platforms
-   static inline unsigned int
-indexFor(unsigned int tablelength, unsigned int hashvalue) {
-    return (hashvalue % tablelength);
-};
-*/
-#define indexFor(tablelength,hashvalue)		((unsigned int) (hashvalue % (uint32_t) tablelength))
-
-/* Only works if tablelength == 2^N */
-/*static inline unsigned int
-indexFor(unsigned int tablelength, unsigned int hashvalue)
-{
-    return (hashvalue & (tablelength - 1u));
-}
-*/
-
-/*****************************************************************************/
-#define freekey(X) EXIP_MFREE(X)
-/*define freekey(X) ; */
-
+/** The hash as kept in the hashes array - 0 is reserved for empty slots */
+#define STORED_HASH(hash) ((hash) == 0 ? 1 : (hash))
 
 /*****************************************************************************/
 
@@ -35,6 +35,7 @@ errorCode initAllocList(AllocList* list);
 /**
  * @brief Allocate a memory block with size size and store a copy of
  * the pointer in a linked list for freeing it at the end.
+ * With MEM_ARENA_USE the block is carved from a chunk of the list instead.
  *
  * @param[in, out] list A list storing the memory allocations
  * @param[in] size the size of the memory block to be allocated
@@ -52,6 +53,38 @@ void* memManagedAllocate(AllocList* list, size_t size);
  */
 void freeAllMem(EXIStream* strm);
 
+/**
+ * @brief Restores an EXI stream to its state right after the schema was set,
+ * keeping the allocated memory where possible. The value table is emptied,
+ * the built-in grammars are freed, the names added by the stream are removed
+ * from the string tables and the allocation list is reset.
+ * The grammar stack, the buffer and the channels are not touched.
+ *
+ * @param[in, out] strm EXI stream with the schema set
+ * @return Error handling code
+ */
+errorCode resetAllMem(EXIStream* strm);
+
+/**
+ * @brief Starts the processing of a self-contained element. The string tables and
+ * the value table of the stream are saved in a new strm->selfContained frame and
+ * replaced by their initial state; the built-in grammars created from now on
+ * are dropped by exitSelfContained().
+ *
+ * @param[in, out] strm EXI stream with the schema set
+ * @return Error handling code
+ */
+errorCode enterSelfContained(EXIStream* strm);
+
+/**
+ * @brief Ends the processing of the innermost self-contained element: its tables
+ * and built-in grammars are freed and the ones of the enclosing stream restored.
+ * The grammar stack is not touched.
+ *
+ * @param[in, out] strm EXI stream with strm->selfContained set
+ */
+void exitSelfContained(EXIStream* strm);
+
 /**
  * @brief Frees a particular Allocation list
  *
@@ -60,4 +93,47 @@ void freeAllMem(EXIStream* strm);
  */
 void freeAllocList(AllocList* list);
 
+/**
+ * @brief Releases all the memory allocated through an Allocation list
+ * so that the list can be used again. With MEM_ARENA_USE the memory chunks
+ * are kept and reused by the next allocations; otherwise the
+ * allocations are freed as in freeAllocList().
+ *
+ * @param[in, out] list Allocation list to be reset
+ */
+void resetAllocList(AllocList* list);
+
+/**
+ * @brief Initial setup of a StringArena. No memory is allocated
+ * before the first call to arenaAllocate().
+ *
+ * @param[in, out] arena the string arena to be setup
+ */
+void initStringArena(StringArena* arena);
+
+/**
+ * @brief Allocate a memory block with size size from the current chunk of
+ * the arena. A new chunk is allocated when the current one is full.
+ *
+ * @param[in, out] arena the string arena
+ * @param[in] size the size of the memory block to be allocated
+ * @return pointer to the allocated memory if successful. NULL otherwise
+ */
+void* arenaAllocate(StringArena* arena, size_t size);
+
+/**
+ * @brief Releases all the allocations of a StringArena but keeps its
+ * current chunk for reuse. The zero-copy decoding is enabled again.
+ *
+ * @param[in, out] arena the string arena to be reset
+ */
+void resetStringArena(StringArena* arena);
+
+/**
+ * @brief Frees all the chunks of a StringArena
+ *
+ * @param[in, out] arena the string arena to be freed
+ */
+void freeStringArena(StringArena* arena);
+
 #endif /* MEMMANAGEMENT_H_ */
@@ -232,17 +232,49 @@ struct allocBlock {
 	struct allocBlock* nextBlock;
 };
 
-/** A list of allocation blocks.
+/** A memory chunk of an arena (StringArena or AllocList when MEM_ARENA_USE is ON).
+ * The memory follows the chunk header. */
+struct arenaChunk {
+	struct arenaChunk* nextChunk;
+	size_t size;
+	size_t used;
+};
+
+/** A list of allocation blocks or, when MEM_ARENA_USE is ON,
+ * a chain of memory chunks the allocations are carved from.
  * Pass to initAllocList() before use. */
 struct allocList {
+#if MEM_ARENA_USE
+	/** The chunks in order of allocation */
+	struct arenaChunk* firstChunk;
+	/** The chunk the allocations are served from. After resetAllocList()
+	 * the chunks following it are reused before new ones are allocated. */
+	struct arenaChunk* currChunk;
+#else
 	struct allocBlock* firstBlock;
 	struct allocBlock* lastBlock;
 	/** The next allocation slot in the allocation array of the lastBlock */
 	SmallIndex currAllocSlot;
+#endif
 };
 
 typedef struct allocList AllocList;
 
+/** The minimal size in bytes of the memory chunks of a StringArena */
+#define STRING_ARENA_CHUNK_SIZE 2048
+
+/** A bump allocator for the string values of an EXI stream.
+ * All the memory is freed at once at the end of the processing.
+ * Pass to initStringArena() before use. */
+struct stringArena {
+	/** The chunk the allocations are served from; the previous chunks are linked in nextChunk */
+	struct arenaChunk* currChunk;
+	/** TRUE when the string values may point directly into the input buffer */
+	boolean zeroCopy;
+};
+
+typedef struct stringArena StringArena;
+
 /**
  * Meta-data of generic dynamic array.
  * A concrete dynamic array is defined as follow:
@@ -511,6 +543,8 @@ typedef struct EventCode EventCode;
 #define GR_CONTENT_2 (GR_VOID_NON_TERMINAL-1)
 
 #define GR_FRAGMENT_CONTENT  0
+/** The fragment of a self-contained element after the element: only ED follows */
+#define GR_SC_FRAGMENT_END   1
 /**@}*/
 
 /** 
@@ -741,12 +775,33 @@ struct LnEntry {
 
 typedef struct LnEntry LnEntry;
 
+#if STRING_TABLE_HASH_USE
+/**
+ * Open addressing (linear probing) hash index over the strings of a
+ * URI or local-name table. A slot holds the entry ID + 1; 0 is an empty slot.
+ * The index is built on the first lookup once the table has
+ * STRING_TABLE_HASH_THRESHOLD entries and is then kept in sync
+ * when entries are added. It is not present (NULL slots) in static
+ * string tables until they are first searched.
+ */
+struct StringTableIndex {
+	Index* slots;
+	/** The number of slots - a power of 2 */
+	Index size;
+};
+
+typedef struct StringTableIndex StringTableIndex;
+#endif
+
 struct LnTable {
 #if DYN_ARRAY_USE == ON
 	DynArray dynArray;
 #endif
 	LnEntry* ln;
 	Index count;
+#if STRING_TABLE_HASH_USE
+	StringTableIndex hashIndex;
+#endif
 };
 
 typedef struct LnTable LnTable;
@@ -765,10 +820,35 @@ struct UriTable {
 #endif
 	UriEntry* uri;
 	SmallIndex count;
+#if STRING_TABLE_HASH_USE
+	StringTableIndex hashIndex;
+#endif
 };
 
 typedef struct UriTable UriTable;
 
+/** The number of entries of a URI partition recorded in a StringTablesMark */
+struct UriEntryMark {
+	Index lnCount;
+	/** SMALL_INDEX_MAX when the URI has no prefix table */
+	SmallIndex pfxCount;
+};
+
+typedef struct UriEntryMark UriEntryMark;
+
+/**
+ * The size of the string tables at a given point of the processing.
+ * Used to restore the tables to their state after the schema was set;
+ * see markStringTables() and restoreStringTables()
+ */
+struct StringTablesMark {
+	SmallIndex uriCount;
+	/** uriCount entries; NULL when no mark is set */
+	UriEntryMark* uri;
+};
+
+typedef struct StringTablesMark StringTablesMark;
+
 /**@}*/ // End String Table Types
 
 /** @name Constraining Facets IDs
@@ -939,6 +1019,57 @@ struct EnumTable {
 
 typedef struct EnumTable EnumTable;
 
+#if STATIC_CODEC_USE
+
+struct EXIStream;
+
+/**
+ * Event code functions of a schema-informed grammar (or the document grammar)
+ * generated by "exipg -codec". The event codes are indexes of the productions
+ * from the end of GrammarRule.production as in the generic processing.
+ */
+struct StaticGrammarCodec
+{
+	/**
+	 * Reads the first part of the event code of a grammar rule
+	 * with the number of bits known for that rule.
+	 */
+	errorCode (*decodeCode)(struct EXIStream* strm, SmallIndex ruleId, unsigned int* code);
+	/**
+	 * Writes the first level event code of the production of a grammar rule that matches the event.
+	 * qname is the QName constant of the SE/AT event (see StaticCodec.uriBase) or INDEX_MAX and
+	 * uriId its URI ID. code is INDEX_MAX and nothing is written if there is no such production.
+	 */
+	errorCode (*encodeCode)(struct EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+							Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code);
+};
+
+typedef struct StaticGrammarCodec StaticGrammarCodec;
+
+/**
+ * Production selection functions generated for a static schema by "exipg -codec".
+ * The number of bits of the event codes depends on the Strict option and on the
+ * Preserve options for DTD, comments and PIs: the codec is only used by the streams
+ * that have the same values of these options as the ones it is generated for.
+ */
+struct StaticCodec
+{
+	boolean strict;
+	/** The PRESERVE_DTD, PRESERVE_COMMENTS and PRESERVE_PIS bits of EXIOptions.preserve */
+	unsigned char preserve;
+	StaticGrammarCodec docGrammar;
+	/** The codecs of the first EXIPSchema.staticGrCount grammars of the grammar table */
+	const StaticGrammarCodec* grammar;
+	/** The QName constants are uriBase[uriId] + lnId for the string table entries of
+	 * the schema; uriBase has uriCount + 1 entries */
+	const Index* uriBase;
+	SmallIndex uriCount;
+};
+
+typedef struct StaticCodec StaticCodec;
+
+#endif
+
 /**
  * EXIP representation of XML Schema.
  * @todo If the simple types are included in the grammarTable's EXIGrammar structure,
@@ -978,6 +1109,13 @@ struct EXIPSchema
 	Index staticGrCount;
 
 	EnumTable enumTable;
+
+#if STATIC_CODEC_USE
+	/**
+	 * The production selection functions generated for this schema, if any
+	 */
+	const StaticCodec* codec;
+#endif
 };
 
 typedef struct EXIPSchema EXIPSchema;
@@ -1006,6 +1144,26 @@ struct StreamContext
 
 	/** Value type of the expected attribute */
 	Index attrTypeId;
+
+	/** Parser: TRUE while the content of an element is skipped; the values that
+	 * are not added to the string tables are not decoded */
+	boolean skipValues;
+
+	/** Parser: TRUE when the startElement() handler returned EXIP_HANDLER_SKIP_ELEMENT */
+	boolean skipRequested;
+
+	/** Parser: the position in the EXI stream past a skipped self-contained element
+	 * that the input is moved to; 0 if none, see useSelfContainedIndex() */
+	Index skipOffset;
+
+	/**
+	 * The position in the EXI stream of the first byte of the buffer, i.e. the number
+	 * of bytes flushed (serializer) or discarded (parser) before it
+	 */
+	Index bufferOffset;
+
+	/** Serializer: the number of elements started so far */
+	Index elementCount;
 };
 
 typedef struct StreamContext StreamContext;
@@ -1120,6 +1278,48 @@ struct BinaryBuffer
 
 typedef struct BinaryBuffer BinaryBuffer;
 
+/** A self-contained element of an EXI stream; see setSelfContainedIndex() in EXISerializer.h */
+struct SelfContainedIndexEntry
+{
+	/** The ordinal of the element: the number of elements started before it */
+	Index element;
+	/** The position in the EXI stream of its byte-aligned content, right after the SC event */
+	Index offset;
+	/** The position in the EXI stream right after its fragment; 0 until the element ends */
+	Index end;
+};
+
+typedef struct SelfContainedIndexEntry SelfContainedIndexEntry;
+
+/** The self-contained elements of an EXI stream in document order */
+struct SelfContainedIndex
+{
+#if DYN_ARRAY_USE == ON
+	DynArray dynArray;
+#endif
+	SelfContainedIndexEntry* entry;
+	Index count;
+};
+
+typedef struct SelfContainedIndex SelfContainedIndex;
+
+/**
+ * The state of the enclosing stream saved while a self-contained element
+ * is processed with the initial string tables; see enterSelfContained()
+ */
+struct SelfContainedFrame
+{
+	UriTable uriTable;
+	ValueTable valueTable;
+	/** The number of grammars in the grammar table when the element started */
+	Index grammarCount;
+	/** The position in the EXI stream of the byte-aligned content of the element */
+	Index offset;
+	/** The grammar stack node of the fragment that holds the element */
+	EXIGrammarStack* fragment;
+	struct SelfContainedFrame* previous;
+};
+
 /**
  * Represents an EXI stream
  */
@@ -1157,6 +1357,80 @@ struct EXIStream
 	 * It contains the string tables and possibly schema-informed EXI grammars.
 	 */
 	EXIPSchema* schema;
+
+	/**
+	 * Alignment-specialized primitives for reading (parser) or
+	 * writing (serializer) the stream; see streamDecode.h and streamEncode.h
+	 */
+	const struct DecodePrimitives* decodePrim;
+	const struct EncodePrimitives* encodePrim;
+
+	/**
+	 * Parser: when not NULL the string values are allocated in this arena
+	 * instead of one by one and may point directly into the input buffer;
+	 * see enableStringArena() in EXIParser.h
+	 */
+	StringArena* valueArena;
+
+	/**
+	 * Parser: when chunkSize > 0 the binary values are decoded and reported
+	 * to the binaryDataChunk() handler in pieces of up to chunkSize bytes;
+	 * see setBinaryChunkSize() in EXIParser.h. delivered is the number of bytes
+	 * of the current value already reported, in case it is decoded again after
+	 * EXIP_BUFFER_END_REACHED
+	 */
+	struct
+	{
+		Index chunkSize;
+		Index delivered;
+	} binaryChunks;
+
+	/**
+	 * The size of the string tables right after the schema was set.
+	 * The names added by the stream are removed from the tables when the
+	 * stream is reset or freed; see resetAllMem()
+	 */
+	StringTablesMark tablesMark;
+
+	/**
+	 * Parser: the precomputed event code widths and second level events
+	 * of the grammar rules; see createEventCodeDispatch() in bodyDecode.h
+	 */
+	struct EventCodeDispatch* dispatch;
+
+	/**
+	 * Serializer: the production index and QName cache of encodeProduction();
+	 * see createProductionIndex() in bodyEncode.h. NULL if not used.
+	 */
+	struct ProductionIndex* prodIndex;
+
+	/** The self-contained elements being processed, innermost first; NULL if none */
+	struct SelfContainedFrame* selfContained;
+
+	/** Serializer: the index of the self-contained elements; NULL if not kept */
+	SelfContainedIndex* scIndex;
+
+	/**
+	 * The schema-informed fragment grammar of the self-contained elements, created
+	 * in the memList on the first one; see pushSelfContainedFragment() in grammars.h
+	 */
+	EXIGrammar* scGrammar;
+
+#if STATIC_CODEC_USE
+	/**
+	 * The production selection functions of the schema; NULL if there are none or
+	 * they are generated for other EXI options. See selectStaticCodec() in grammars.h
+	 */
+	const StaticCodec* codec;
+#endif
+
+#if COMPRESSION_USE
+	/**
+	 * The state of the structure and value channels of the current block.
+	 * Only used (non NULL) when the compression or pre-compression options are set.
+	 */
+	struct ChannelState* channels;
+#endif
 };
 
 typedef struct EXIStream EXIStream;
@@ -20,6 +20,16 @@
 #include "procTypes.h"
 #include "errorHandle.h"
 
+/**
+ * The maximum number of CharType units used for the representation of a single
+ * UCS character. Used when sizing the memory for a string of known character count.
+ */
+#if STRING_UTF8_USE
+# define UCS_CHAR_MAX_UNITS 4
+#else
+# define UCS_CHAR_MAX_UNITS 1
+#endif
+
 /**
  * @brief Allocate a memory for a string with UCSchars number of UCS characters
  * It depends on the representation of the characters
@@ -77,6 +87,17 @@ errorCode writeCharToString(String* str, uint32_t code_point, Index* writerPosit
  */
 uint32_t readCharFromString(const String* str, Index* readerPosition);
 
+/**
+ * @brief Returns the number of UCS [ISO/IEC 10646] characters in a string.
+ * This is the string length used in the EXI stream. For the UTF-8 representation
+ * the string is validated as well.
+ * @param[in] str string
+ * @param[out] charCount the number of characters
+ * @return EXIP_INVALID_STRING_OPERATION if the string is not a valid
+ * sequence of characters, otherwise EXIP_OK
+ */
+errorCode countStringChars(const String* str, Index* charCount);
+
 /**
  * @brief Creates an empty string
  * @param[in, out] emptyStr empty string
@@ -8,6 +8,8 @@
 /**
  * @file ASCII_stringManipulate.c
  * @brief String manipulation functions used for UCS <-> ASCII transformations
+ * When STRING_UTF8_USE is ON the functions that depend on the character
+ * representation are implemented in UTF8_stringManipulate.c instead.
  *
  * @date Sep 3, 2010
  * @author Rumen Kyusakov
@@ -20,6 +22,7 @@
 
 #define PARSING_STRING_MAX_LENGTH 100
 
+#if !STRING_UTF8_USE
 errorCode allocateStringMemory(CharType** str, Index UCSchars)
 {
 	*str = EXIP_CALLOC(1, sizeof(CharType)*UCSchars);
@@ -27,6 +30,7 @@ errorCode allocateStringMemory(CharType** str, Index UCSchars)
 		return EXIP_MEMORY_ALLOCATION_ERROR;
 	return EXIP_OK;
 }
+#endif /* !STRING_UTF8_USE */
 
 errorCode newStringWithCapacity(String* str, Index capacity)
 {
@@ -43,6 +47,7 @@ errorCode newStringWithCapacity(String* str, Index capacity)
 	}
 }
 
+#if !STRING_UTF8_USE
 errorCode allocateStringMemoryManaged(CharType** str, Index UCSchars, AllocList* memList)
 {
 	(*str) = (CharType*) memManagedAllocate(memList, sizeof(CharType)*UCSchars);
@@ -62,6 +67,7 @@ errorCode writeCharToString(String* str, uint32_t code_point, Index* writerPosit
 	*writerPosition += 1;
 	return EXIP_OK;
 }
+#endif /* !STRING_UTF8_USE */
 
 void getEmptyString(String* emptyStr)
 {
@@ -186,6 +192,7 @@ boolean stringEqualToAscii(const String str1, const char* str2)
 	}
 }
 
+#if !STRING_UTF8_USE
 int stringCompare(const String str1, const String str2)
 {
 	/* Check for NULL string pointers */
@@ -219,6 +226,13 @@ uint32_t readCharFromString(const String* str, Index* readerPosition)
 	return (uint32_t) str->str[*readerPosition - 1];
 }
 
+errorCode countStringChars(const String* str, Index* charCount)
+{
+	*charCount = str->length;
+	return EXIP_OK;
+}
+#endif /* !STRING_UTF8_USE */
+
 errorCode cloneString(const String* src, String* newStr)
 {
 	if(newStr == NULL)
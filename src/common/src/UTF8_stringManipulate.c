@@ -0,0 +1,296 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file UTF8_stringManipulate.c
+ * @brief String manipulation functions used for UCS <-> UTF-8 transformations
+ * Used instead of the character dependent functions in ASCII_stringManipulate.c
+ * when STRING_UTF8_USE is ON. The strings are sequences of UTF-8 bytes and
+ * String.length is the number of bytes.
+ *
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#include "stringManipulate.h"
+#include "memManagement.h"
+#include "ioUtil.h"
+
+#if STRING_UTF8_USE
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+
+/** The lead bytes of the sequences are taken from the first UTF8_BLOCK_LEADS bytes of a
+ * 16 byte block so that their continuation bytes are in the same block */
+#define UTF8_BLOCK_LEADS 14
+#define UTF8_LEADS_MASK ((1u << UTF8_BLOCK_LEADS) - 1)
+#endif
+
+/**
+ * @brief Checks the UTF-8 sequence at the beginning of s
+ * The overlong forms, the surrogates and the code points above U+10FFFF are rejected.
+ * @param[in] s the sequence
+ * @param[in] len number of bytes available from s
+ * @return the number of bytes of the sequence; 0 if it is not well-formed
+ */
+static unsigned int utf8SequenceLength(const unsigned char* s, Index len)
+{
+	unsigned char c = s[0];
+
+	if(c < 0x80)
+		return 1;
+	else if(c < 0xC2)
+		return 0;
+	else if(c < 0xE0)
+	{
+		if(len < 2 || (s[1] & 0xC0) != 0x80)
+			return 0;
+		return 2;
+	}
+	else if(c < 0xF0)
+	{
+		if(len < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80)
+			return 0;
+		if((c == 0xE0 && s[1] < 0xA0) || (c == 0xED && s[1] > 0x9F))
+			return 0;
+		return 3;
+	}
+	else if(c < 0xF5)
+	{
+		if(len < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80)
+			return 0;
+		if((c == 0xF0 && s[1] < 0x90) || (c == 0xF4 && s[1] > 0x8F))
+			return 0;
+		return 4;
+	}
+
+	return 0;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Validates and counts the characters of text made of 1, 2 and 3 byte
+ * UTF-8 sequences 16 bytes at a time. Stops at the first block that has other
+ * (4 byte or invalid) sequences; these are left to utf8SequenceLength().
+ * @param[in] s the text; starts with a sequence
+ * @param[in] len number of bytes in s
+ * @param[in, out] count incremented with the number of characters checked
+ * @return the number of bytes checked; always the end of a sequence
+ */
+static Index utf8BlockScan(const unsigned char* s, Index len, Index* count)
+{
+	Index i = 0;
+	const __m128i contLowEnd = _mm_set1_epi8((char) 0xA0);
+	const __m128i contEnd = _mm_set1_epi8((char) 0xC0);
+	const __m128i lead2First = _mm_set1_epi8((char) 0xC1);
+	const __m128i lead3First = _mm_set1_epi8((char) 0xDF);
+	const __m128i lead3End = _mm_set1_epi8((char) 0xF0);
+	const __m128i leadE0 = _mm_set1_epi8((char) 0xE0);
+	const __m128i leadED = _mm_set1_epi8((char) 0xED);
+	__m128i v;
+	unsigned int nonAscii, cont, contLow, lead2, lead3, leadE0Mask, leadEDMask, expected;
+
+	while(i + 16 <= len)
+	{
+		v = _mm_loadu_si128((const __m128i*) (s + i));
+		nonAscii = (unsigned int) _mm_movemask_epi8(v);
+		if(nonAscii == 0)
+		{
+			i += 16;
+			*count += 16;
+			continue;
+		}
+
+		// Signed byte comparisons: 80..BF are continuation bytes (80..9F the low half),
+		// C2..DF lead 2 byte sequences and E0..EF lead 3 byte sequences
+		cont = (unsigned int) _mm_movemask_epi8(_mm_cmplt_epi8(v, contEnd));
+		contLow = (unsigned int) _mm_movemask_epi8(_mm_cmplt_epi8(v, contLowEnd));
+		lead2 = (unsigned int) _mm_movemask_epi8(_mm_andnot_si128(_mm_cmpgt_epi8(v, lead3First), _mm_cmpgt_epi8(v, lead2First)));
+		lead3 = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, lead3First), _mm_cmplt_epi8(v, lead3End)));
+		leadE0Mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(v, leadE0)) & UTF8_LEADS_MASK;
+		leadEDMask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(v, leadED)) & UTF8_LEADS_MASK;
+		lead2 &= UTF8_LEADS_MASK;
+		lead3 &= UTF8_LEADS_MASK;
+		expected = (lead2 << 1) | (lead3 << 1) | (lead3 << 2);
+
+		// Every non-ASCII byte in the first UTF8_BLOCK_LEADS must be a known lead or an expected
+		// continuation and the continuations of these leads must be in place. After E0 the
+		// overlong forms (80..9F) and after ED the surrogates (A0..BF) are rejected
+		if(((nonAscii & ~cont & ~lead2 & ~lead3) & UTF8_LEADS_MASK) != 0 ||
+				((cont ^ expected) & (UTF8_LEADS_MASK << 1 | 1)) != 0 || (expected & ~cont) != 0 ||
+				((leadE0Mask << 1) & contLow) != 0 || ((leadEDMask << 1) & cont & ~contLow) != 0)
+			break;
+
+		*count += __builtin_popcount(~cont & UTF8_LEADS_MASK);
+		// Skip the continuation bytes of the last sequences as well
+		i += UTF8_BLOCK_LEADS + __builtin_popcount(expected & ~UTF8_LEADS_MASK);
+	}
+
+	return i;
+}
+#endif
+
+errorCode allocateStringMemory(CharType** str, Index UCSchars)
+{
+	*str = EXIP_CALLOC(1, sizeof(CharType)*UCSchars*UCS_CHAR_MAX_UNITS);
+	if((*str) == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	return EXIP_OK;
+}
+
+errorCode allocateStringMemoryManaged(CharType** str, Index UCSchars, AllocList* memList)
+{
+	(*str) = (CharType*) memManagedAllocate(memList, sizeof(CharType)*UCSchars*UCS_CHAR_MAX_UNITS);
+	if((*str) == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	return EXIP_OK;
+}
+
+errorCode writeCharToString(String* str, uint32_t code_point, Index* writerPosition)
+{
+	unsigned char* dst = (unsigned char*) str->str + *writerPosition;
+
+	if(code_point < 0x80)
+	{
+		if(*writerPosition >= str->length)
+			return EXIP_OUT_OF_BOUND_BUFFER;
+		dst[0] = (unsigned char) code_point;
+		*writerPosition += 1;
+	}
+	else if(code_point < 0x800)
+	{
+		if(*writerPosition + 2 > str->length)
+			return EXIP_OUT_OF_BOUND_BUFFER;
+		dst[0] = (unsigned char) (0xC0 | (code_point >> 6));
+		dst[1] = (unsigned char) (0x80 | (code_point & 0x3F));
+		*writerPosition += 2;
+	}
+	else if(code_point < 0x10000)
+	{
+		if(code_point >= 0xD800 && code_point <= 0xDFFF)
+			return EXIP_INVALID_STRING_OPERATION;
+		if(*writerPosition + 3 > str->length)
+			return EXIP_OUT_OF_BOUND_BUFFER;
+		dst[0] = (unsigned char) (0xE0 | (code_point >> 12));
+		dst[1] = (unsigned char) (0x80 | ((code_point >> 6) & 0x3F));
+		dst[2] = (unsigned char) (0x80 | (code_point & 0x3F));
+		*writerPosition += 3;
+	}
+	else if(code_point <= 0x10FFFF)
+	{
+		if(*writerPosition + 4 > str->length)
+			return EXIP_OUT_OF_BOUND_BUFFER;
+		dst[0] = (unsigned char) (0xF0 | (code_point >> 18));
+		dst[1] = (unsigned char) (0x80 | ((code_point >> 12) & 0x3F));
+		dst[2] = (unsigned char) (0x80 | ((code_point >> 6) & 0x3F));
+		dst[3] = (unsigned char) (0x80 | (code_point & 0x3F));
+		*writerPosition += 4;
+	}
+	else
+		return EXIP_INVALID_STRING_OPERATION;
+
+	return EXIP_OK;
+}
+
+/**
+ * The string is expected to be checked by countStringChars() before.
+ * A byte that does not start a well-formed sequence is returned as a single character.
+ */
+uint32_t readCharFromString(const String* str, Index* readerPosition)
+{
+	const unsigned char* s = (const unsigned char*) str->str + *readerPosition;
+	uint32_t code_point;
+
+	assert(*readerPosition < str->length);
+	switch(utf8SequenceLength(s, str->length - *readerPosition))
+	{
+		case 2:
+			code_point = ((uint32_t) (s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+			*readerPosition += 2;
+		break;
+		case 3:
+			code_point = ((uint32_t) (s[0] & 0x0F) << 12) | ((uint32_t) (s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+			*readerPosition += 3;
+		break;
+		case 4:
+			code_point = ((uint32_t) (s[0] & 0x07) << 18) | ((uint32_t) (s[1] & 0x3F) << 12) |
+						 ((uint32_t) (s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+			*readerPosition += 4;
+		break;
+		default:
+			code_point = s[0];
+			*readerPosition += 1;
+	}
+
+	return code_point;
+}
+
+errorCode countStringChars(const String* str, Index* charCount)
+{
+	const unsigned char* s = (const unsigned char*) str->str;
+	Index i = 0;
+	Index count = 0;
+	Index run;
+	unsigned int seqLen;
+
+	while(i < str->length)
+	{
+#if defined(__SSE2__)
+		// Whole blocks are checked with vector operations...
+		run = utf8BlockScan(s + i, str->length - i, &count);
+		i += run;
+		// ...and the block that stopped the scan one sequence at a time
+		run = i + 16;
+#else
+		// Runs of 7-bit characters are skipped with the vector scan of asciiRunLength()
+		run = asciiRunLength(s + i, str->length - i);
+		i += run;
+		count += run;
+		// The multibyte characters up to the next ASCII one are checked one by one
+		run = i;
+#endif
+
+		while(i < str->length && (i < run || s[i] >= 0x80))
+		{
+			seqLen = utf8SequenceLength(s + i, str->length - i);
+			if(seqLen == 0)
+				return EXIP_INVALID_STRING_OPERATION;
+			i += seqLen;
+			count++;
+		}
+	}
+
+	*charCount = count;
+	return EXIP_OK;
+}
+
+/**
+ * The byte order of UTF-8 strings is the order of their code points
+ */
+int stringCompare(const String str1, const String str2)
+{
+	/* Check for NULL string pointers */
+	if(str1.str == NULL)
+	{
+		if(str2.str == NULL)
+			return 0;
+		return -1;
+	}
+	else if(str2.str == NULL)
+		return 1;
+	else // None of the strings is NULL
+	{
+		int diff = memcmp(str1.str, str2.str, str1.length < str2.length ? str1.length : str2.length);
+		if(diff)
+			return diff;
+		/* The strings have the same prefix and might differ only in length*/
+		return str1.length - str2.length;
+	}
+}
+
+#endif /* STRING_UTF8_USE */
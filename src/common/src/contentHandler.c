@@ -20,6 +20,7 @@ void initContentHandler(ContentHandler* handler)
 {
 	handler->attribute = NULL;
 	handler->binaryData = NULL;
+	handler->binaryDataChunk = NULL;
 	handler->booleanData = NULL;
 	handler->dateTimeData = NULL;
 	handler->decimalData = NULL;
@@ -1,4 +1,5 @@
 /* Copyright (C) 2004 Christopher Clark <firstname.lastname@cl.cam.ac.uk> */
+/* Reworked as a flat open addressing table with linear probing */
 /* @par[Revision] $Id$
  **/
 
@@ -6,238 +7,244 @@
 #include "hashtable_private.h"
 #include "procTypes.h"
 
-#define CEIL(VARIABLE) ( ((VARIABLE) - (unsigned int)(VARIABLE))==0 ? (unsigned int)(VARIABLE) : (unsigned int) (VARIABLE)+1 )
+/** The smallest number of slots in a hash table */
+#define MIN_TABLE_SIZE 16
 
-/*
-Credit for primes table: Aaron Krowne
- http://br.endernet.org/~akrowne/
- http://planetmath.org/encyclopedia/GoodHashTablePrimes.html
-*/
-static const uint32_t primes[] = {
-53, 97, 193, 389,
-769, 1543, 3079, 6151,
-12289, 24593, 49157, 98317,
-196613, 393241, 786433, 1572869,
-3145739, 6291469, 12582917, 25165843,
-50331653, 100663319, 201326611, 402653189,
-805306457, 1610612741
-};
-const unsigned int prime_table_length = sizeof(primes)/sizeof(primes[0]);
-const float max_load_factor = 0.65F;
-
-uint32_t djbHash(String str)
+#define ROTL32(x, r) (((x) << (r)) | ((x) >> (32 - (r))))
+
+uint32_t stringHash(String str)
 {
-	char* tmp = (char*) str.str;
-	uint32_t hash = 5381;
-	unsigned int i = 0;
+	const unsigned char* p = (const unsigned char*) str.str;
+	size_t len = sizeof(CharType)*str.length;
+	uint32_t hash = 0x9747B28CUL ^ (uint32_t) len;
+	uint32_t k;
 
-	for(i = 0; i < sizeof(CharType)*str.length; tmp++, i++)
+	// Four bytes per step. The memcpy is compiled to a single (unaligned) load
+	for(; len >= 4; p += 4, len -= 4)
 	{
-		hash = ((hash << 5) + hash) + (*tmp);
+		memcpy(&k, p, 4);
+		k *= 0xCC9E2D51UL;
+		k = ROTL32(k, 15);
+		k *= 0x1B873593UL;
+		hash ^= k;
+		hash = ROTL32(hash, 13);
+		hash = hash*5 + 0xE6546B64UL;
 	}
 
+	k = 0;
+	switch(len)
+	{
+		case 3:
+			k ^= (uint32_t) p[2] << 16;
+		case 2:
+			k ^= (uint32_t) p[1] << 8;
+		case 1:
+			k ^= p[0];
+			k *= 0xCC9E2D51UL;
+			k = ROTL32(k, 15);
+			k *= 0x1B873593UL;
+			hash ^= k;
+	}
+
+	// Final avalanche so that the low bits used as a slot index depend on all the input
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6BUL;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35UL;
+	hash ^= hash >> 16;
+
 	return hash;
 }
 
 /*****************************************************************************/
 
+/** Allocates empty hashes and entries arrays with size slots */
+static boolean allocSlots(Index size, uint32_t** hashes, struct entry** entries)
+{
+	*hashes = (uint32_t*) EXIP_MALLOC(size*sizeof(uint32_t));
+	if(*hashes == NULL)
+		return FALSE;
+	memset(*hashes, 0, size*sizeof(uint32_t));
+	*entries = (struct entry*) EXIP_MALLOC(size*sizeof(struct entry));
+	if(*entries == NULL)
+	{
+		EXIP_MFREE(*hashes);
+		return FALSE;
+	}
+	return TRUE;
+}
+
 struct hashtable * create_hashtable(unsigned int minsize,
 						uint32_t (*hashfn) (String key),
 						boolean (*eqfn) (const String str1, const String str2))
 {
-    struct hashtable *h;
-    unsigned int pindex, size = primes[0];
-    /* Check requested hashtable isn't too large */
-    if (minsize > MAX_HASH_TABLE_SIZE) return NULL;
-    /* Enforce size as prime */
-    for (pindex=0; pindex < prime_table_length; pindex++) {
-        if (primes[pindex] >= minsize) { size = primes[pindex]; break; }
-    }
-    h = (struct hashtable *)EXIP_MALLOC(sizeof(struct hashtable));
-    if (NULL == h) return NULL; /*oom*/
-    h->table = (struct entry **)EXIP_MALLOC(sizeof(struct entry*) * size);
-    if (NULL == h->table) { EXIP_MFREE(h); return NULL; } /*oom*/
-    memset(h->table, 0, size * sizeof(struct entry *));
-    h->tablelength  = size;
-    h->primeindex   = pindex;
-    h->entrycount   = 0;
-    h->hashfn       = hashfn;
-    h->eqfn         = eqfn;
-    h->loadlimit    = CEIL(size * max_load_factor);
-    return h;
+	struct hashtable *h;
+	Index size = MIN_TABLE_SIZE;
+
+	while(size < minsize)
+		size = 2*size;
+
+	h = (struct hashtable *)EXIP_MALLOC(sizeof(struct hashtable));
+	if(NULL == h) return NULL; /*oom*/
+
+	if(!allocSlots(size, &h->hashes, &h->entries))
+	{
+		EXIP_MFREE(h);
+		return NULL;
+	}
+
+	h->size = size;
+	h->count = 0;
+	h->loadlimit = LOAD_LIMIT(size);
+	h->hashfn = hashfn;
+	h->eqfn = eqfn;
+	return h;
 }
 
 /*****************************************************************************/
 
-// Currently this function is not used. Some performance tests must be written
-// and performed to show if it is better when it is used
-//uint32_t hash(struct hashtable *h, void *k, unsigned int len)
-//{
-//    /* Aim to protect against poor hash functions by adding logic here
-//     * - logic taken from java 1.4 hashtable source */
-//    uint32_t i = h->hashfn(k, len);
-//    i += ~(i << 9);
-//    i ^=  ((i >> 14) | (i << 18)); /* >>> */
-//    i +=  (i << 4);
-//    i ^=  ((i >> 10) | (i << 22)); /* >>> */
-//    return i;
-//}
+/** Places an entry in the first free slot of its probe sequence */
+static void placeEntry(uint32_t* hashes, struct entry* entries, Index mask, uint32_t hash, String key, Index value)
+{
+	Index s = hash & mask;
+
+	while(hashes[s] != 0)
+		s = (s + 1) & mask;
 
-/*****************************************************************************/
-static int hashtable_expand(struct hashtable *h)
+	hashes[s] = hash;
+	entries[s].key = key;
+	entries[s].value = value;
+}
+
+/**
+ * Doubles the number of slots. The stored hashes are used so the keys
+ * are neither hashed nor compared again.
+ * @return FALSE if the memory allocation fails; the table is unchanged then
+ */
+static boolean hashtable_expand(struct hashtable *h)
 {
-    /* Double the size of the table to accommodate more entries */
-    struct entry **newtable;
-    struct entry *e;
-    struct entry **pE;
-    unsigned int newsize, i, index;
-    /* Check we're not hitting max capacity */
-    if (h->primeindex == (prime_table_length - 1) || primes[h->primeindex + 1] > MAX_HASH_TABLE_SIZE) return 0;
-    newsize = primes[++(h->primeindex)];
-
-    newtable = (struct entry **)EXIP_MALLOC(sizeof(struct entry*) * newsize);
-    if (NULL != newtable)
-    {
-        memset(newtable, 0, newsize * sizeof(struct entry *));
-        /* This algorithm is not 'stable'. ie. it reverses the list
-         * when it transfers entries between the tables */
-        for (i = 0; i < h->tablelength; i++) {
-            while (NULL != (e = h->table[i])) {
-                h->table[i] = e->next;
-                index = indexFor(newsize,e->hash);
-                e->next = newtable[index];
-                newtable[index] = e;
-            }
-        }
-        EXIP_MFREE(h->table);
-        h->table = newtable;
-    }
-    /* Plan B: realloc instead */
-    else 
-    {
-        newtable = (struct entry **) EXIP_REALLOC(h->table, newsize * sizeof(struct entry *));
-        if (NULL == newtable) { (h->primeindex)--; return 0; }
-        h->table = newtable;
-        memset(newtable[h->tablelength], 0, newsize - h->tablelength);
-        for (i = 0; i < h->tablelength; i++) {
-            for (pE = &(newtable[i]), e = *pE; e != NULL; e = *pE) {
-                index = indexFor(newsize,e->hash);
-                if (index == i)
-                {
-                    pE = &(e->next);
-                }
-                else
-                {
-                    *pE = e->next;
-                    e->next = newtable[index];
-                    newtable[index] = e;
-                }
-            }
-        }
-    }
-    h->tablelength = newsize;
-    h->loadlimit   = CEIL(newsize * max_load_factor);
-    return -1;
+	uint32_t* newHashes;
+	struct entry* newEntries;
+	Index newsize = 2*h->size;
+	Index i;
+
+	if(newsize < h->size) return FALSE; /* overflow of Index */
+
+	if(!allocSlots(newsize, &newHashes, &newEntries))
+		return FALSE;
+
+	for(i = 0; i < h->size; i++)
+	{
+		if(h->hashes[i] != 0)
+			placeEntry(newHashes, newEntries, newsize - 1, h->hashes[i], h->entries[i].key, h->entries[i].value);
+	}
+
+	EXIP_MFREE(h->hashes);
+	EXIP_MFREE(h->entries);
+	h->hashes = newHashes;
+	h->entries = newEntries;
+	h->size = newsize;
+	h->loadlimit = LOAD_LIMIT(newsize);
+	return TRUE;
 }
 
 /*****************************************************************************/
 unsigned int hashtable_count(struct hashtable *h)
 {
-    return h->entrycount;
+	return (unsigned int) h->count;
 }
 
 /*****************************************************************************/
 errorCode hashtable_insert(struct hashtable *h, String key, Index value)
 {
-    /* This method allows duplicate keys - but they shouldn't be used */
-    unsigned int index;
-    struct entry *e;
-    if (++(h->entrycount) > h->loadlimit)
-    {
-        /* Ignore the return value. If expand fails, we should
-         * still try cramming just this value into the existing table
-         * -- we may not have memory for a larger table, but one more
-         * element may be ok. Next time we insert, we'll try expanding again.*/
-        hashtable_expand(h);
-    }
-    e = (struct entry *)EXIP_MALLOC(sizeof(struct entry));
-    if (NULL == e) { --(h->entrycount); return EXIP_MEMORY_ALLOCATION_ERROR; } /*oom*/
-    e->hash = h->hashfn(key); // hash(h,k, len);
-    index = indexFor(h->tablelength,e->hash);
-    e->key = key;
-    e->value = value;
-    e->next = h->table[index];
-    h->table[index] = e;
-    return EXIP_OK;
+	/* This method allows duplicate keys - but they shouldn't be used */
+	if(h->count + 1 > h->loadlimit)
+	{
+		/* If expand fails, still try cramming just this value into the
+		 * existing table as long as one slot remains empty - the probing
+		 * relies on that. Next time we insert, we'll try expanding again. */
+		if(!hashtable_expand(h) && h->count + 1 >= h->size)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	placeEntry(h->hashes, h->entries, h->size - 1, STORED_HASH(h->hashfn(key)), key, value);
+	h->count++;
+	return EXIP_OK;
 }
 
 /*****************************************************************************/
+
+/** @return the slot of the key or INDEX_MAX if not found */
+static Index findSlot(struct hashtable *h, String key)
+{
+	uint32_t hashvalue = STORED_HASH(h->hashfn(key));
+	Index mask = h->size - 1;
+	Index s = hashvalue & mask;
+
+	while(h->hashes[s] != 0)
+	{
+		/* Check hash value to short circuit heavier comparison */
+		if(h->hashes[s] == hashvalue && h->eqfn(key, h->entries[s].key))
+			return s;
+		s = (s + 1) & mask;
+	}
+
+	return INDEX_MAX;
+}
+
 Index hashtable_search(struct hashtable *h, String key)
 {
-    struct entry *e;
-    uint32_t hashvalue;
-    unsigned int index;
-    hashvalue = h->hashfn(key); // hash(h,k, len);
-    index = indexFor(h->tablelength,hashvalue);
-    e = h->table[index];
-    while (NULL != e)
-    {
-        /* Check hash value to short circuit heavier comparison */
-        if ((hashvalue == e->hash) && h->eqfn(key, e->key)) return e->value;
-        e = e->next;
-    }
-    return INDEX_MAX;
+	Index s = findSlot(h, key);
+
+	if(s == INDEX_MAX)
+		return INDEX_MAX;
+
+	return h->entries[s].value;
 }
 
 /*****************************************************************************/
 Index hashtable_remove(struct hashtable *h, String key)
 {
-    /* TODO: consider compacting the table when the load factor drops enough,
-     *       or provide a 'compact' method. */
-
-    struct entry *e;
-    struct entry **pE;
-    Index value;
-    uint32_t hashvalue;
-    unsigned int index;
-
-    hashvalue = h->hashfn(key); // hash(h,k, len);
-    index = indexFor(h->tablelength, hashvalue);
-    pE = &(h->table[index]);
-    e = *pE;
-    while (NULL != e)
-    {
-        /* Check hash value to short circuit heavier comparison */
-        if (hashvalue == e->hash && h->eqfn(key, e->key))
-        {
-            *pE = e->next;
-            h->entrycount--;
-            value = e->value;
- //           freekey(e->key);
-            EXIP_MFREE(e);
-            return value;
-        }
-        pE = &(e->next);
-        e = e->next;
-    }
-    return INDEX_MAX;
+	Index mask = h->size - 1;
+	Index s = findSlot(h, key);
+	Index j, home;
+	Index value;
+
+	if(s == INDEX_MAX)
+		return INDEX_MAX;
+
+	value = h->entries[s].value;
+
+	/* Backward shift deletion: move up the following entries of the cluster
+	 * that would otherwise become unreachable. No tombstones are left. */
+	j = s;
+	while(1)
+	{
+		j = (j + 1) & mask;
+		if(h->hashes[j] == 0)
+			break;
+		home = h->hashes[j] & mask;
+		/* Entry j may fill the hole at s only if its home slot is not cyclically in (s, j] */
+		if((s <= j) ? (home <= s || home > j) : (home <= s && home > j))
+		{
+			h->hashes[s] = h->hashes[j];
+			h->entries[s] = h->entries[j];
+			s = j;
+		}
+	}
+
+	h->hashes[s] = 0;
+	h->count--;
+	return value;
 }
 
 /*****************************************************************************/
 /* destroy */
 void hashtable_destroy(struct hashtable *h)
 {
-    unsigned int i;
-    struct entry *e, *f;
-    struct entry **table = h->table;
-	for (i = 0; i < h->tablelength; i++)
-	{
-		e = table[i];
-		while (NULL != e)
-		{ f = e; e = e->next; EXIP_MFREE(f); }
-	}
-    EXIP_MFREE(h->table);
-    EXIP_MFREE(h);
+	EXIP_MFREE(h->hashes);
+	EXIP_MFREE(h->entries);
+	EXIP_MFREE(h);
 }
 
 /*
@@ -19,6 +19,83 @@
 #include "dynamicArray.h"
 #include "sTables.h"
 #include "grammars.h"
+#include "stringManipulate.h"
+
+#if MEM_ARENA_USE
+
+/** The allocations carved from the chunks are aligned as EXIP_MALLOC would for these types */
+union arenaAlignment
+{
+	void* ptr;
+	double dbl;
+	int64_t i64;
+	size_t sz;
+};
+
+#define ARENA_ALIGN(size) (((size) + sizeof(union arenaAlignment) - 1) & ~(sizeof(union arenaAlignment) - 1))
+
+/** Offset of the memory of a chunk from its header */
+#define CHUNK_HEADER_SIZE ARENA_ALIGN(sizeof(struct arenaChunk))
+
+errorCode initAllocList(AllocList* list)
+{
+	// The first chunk is allocated on demand
+	list->firstChunk = NULL;
+	list->currChunk = NULL;
+
+	return EXIP_OK;
+}
+
+void* memManagedAllocate(AllocList* list, size_t size)
+{
+	struct arenaChunk* chunk = list->currChunk;
+	void* ptr;
+
+	size = ARENA_ALIGN(size);
+
+	if(chunk == NULL || chunk->size - chunk->used < size)
+	{
+		if(chunk != NULL && chunk->nextChunk != NULL && chunk->nextChunk->size >= size)
+		{
+			// A chunk kept by resetAllocList()
+			chunk = chunk->nextChunk;
+		}
+		else
+		{
+			struct arenaChunk* newChunk;
+			size_t chunkSize = size > MEM_ARENA_CHUNK_SIZE ? size : MEM_ARENA_CHUNK_SIZE;
+
+			newChunk = EXIP_MALLOC(CHUNK_HEADER_SIZE + chunkSize);
+			if(newChunk == NULL)
+				return NULL;
+
+			newChunk->size = chunkSize;
+			newChunk->used = 0;
+
+			// The new chunk is inserted after the current one so that any kept
+			// chunks that are too small for this allocation are still reused
+			if(chunk == NULL)
+			{
+				newChunk->nextChunk = list->firstChunk;
+				list->firstChunk = newChunk;
+			}
+			else
+			{
+				newChunk->nextChunk = chunk->nextChunk;
+				chunk->nextChunk = newChunk;
+			}
+			chunk = newChunk;
+		}
+		list->currChunk = chunk;
+	}
+
+	ptr = (unsigned char*) chunk + CHUNK_HEADER_SIZE + chunk->used;
+	chunk->used += size;
+
+	return ptr;
+}
+
+#else
 
 errorCode initAllocList(AllocList* list)
 {
@@ -55,51 +132,67 @@ void* memManagedAllocate(AllocList* list, size_t size)
 	return ptr;
 }
 
-void freeAllMem(EXIStream* strm)
+#endif /* MEM_ARENA_USE */
+
+#if BUILD_IN_GRAMMARS_USE
+/**
+ * @brief Frees the built-in element grammars created while processing a stream,
+ * from the grammar with index grammarCount on. The local names referring to them
+ * are reset as they may belong to a schema that outlives the stream.
+ */
+static void freeBuiltInGrammars(EXIPSchema* schema, Index grammarCount)
 {
+	Index g;
 	Index i;
+	SmallIndex u;
+	DynGrammarRule* tmp_rule;
 
-	if(strm->schema != NULL) // can be, in case of error during EXIStream initialization
+	if(schema->grammarTable.count == grammarCount)
+		return;
+
+	for(g = grammarCount; g < schema->grammarTable.count; g++)
 	{
-#if BUILD_IN_GRAMMARS_USE
-		{
-		Index g;
-		DynGrammarRule* tmp_rule;
-		// Explicitly free the memory for any build-in grammars
-		for(g = strm->schema->staticGrCount; g < strm->schema->grammarTable.count; g++)
+		for(i = 0; i < schema->grammarTable.grammar[g].count; i++)
 		{
-			for(i = 0; i < strm->schema->grammarTable.grammar[g].count; i++)
-			{
-				tmp_rule = &((DynGrammarRule*) strm->schema->grammarTable.grammar[g].rule)[i];
-				if(tmp_rule->production != NULL)
-					EXIP_MFREE(tmp_rule->production);
-			}
-			EXIP_MFREE(strm->schema->grammarTable.grammar[g].rule);
+			tmp_rule = &((DynGrammarRule*) schema->grammarTable.grammar[g].rule)[i];
+			if(tmp_rule->production != NULL)
+				EXIP_MFREE(tmp_rule->production);
 		}
+		EXIP_MFREE(schema->grammarTable.grammar[g].rule);
+	}
 
-		strm->schema->grammarTable.count = strm->schema->staticGrCount;
+	for(u = 0; u < schema->uriTable.count; u++)
+	{
+		for(i = 0; i < schema->uriTable.uri[u].lnTable.count; i++)
+		{
+			if(GET_LN_URI_IDS(schema->uriTable, u, i).elemGrammar != INDEX_MAX &&
+				GET_LN_URI_IDS(schema->uriTable, u, i).elemGrammar >= grammarCount)
+				GET_LN_URI_IDS(schema->uriTable, u, i).elemGrammar = INDEX_MAX;
 		}
+	}
+
+	schema->grammarTable.count = grammarCount;
+}
+#endif
+
+void freeAllMem(EXIStream* strm)
+{
+	// The tables of the enclosing elements are the ones freed below
+	while(strm->selfContained != NULL)
+		exitSelfContained(strm);
+
+	if(strm->schema != NULL) // can be, in case of error during EXIStream initialization
+	{
+#if BUILD_IN_GRAMMARS_USE
+		// Explicitly free the memory for any build-in grammars
+		freeBuiltInGrammars(strm->schema, strm->schema->staticGrCount);
 #else
 		assert(strm->schema->grammarTable.count == strm->schema->staticGrCount);
 #endif
 
 #if VALUE_CROSSTABLE_USE
 		// Freeing the value cross tables
-		{
-		Index j;
-		for(i = 0; i < strm->schema->uriTable.count; i++)
-		{
-			for(j = 0; j < strm->schema->uriTable.uri[i].lnTable.count; j++)
-			{
-				if(GET_LN_URI_IDS(strm->schema->uriTable, i, j).vxTable != NULL)
-				{
-					assert(GET_LN_URI_IDS(strm->schema->uriTable, i, j).vxTable->vx);
-					destroyDynArray(&GET_LN_URI_IDS(strm->schema->uriTable, i, j).vxTable->dynArray);
-					GET_LN_URI_IDS(strm->schema->uriTable, i, j).vxTable = NULL;
-				}
-			}
-		}
-		}
+		destroyVxTables(&strm->schema->uriTable);
 #endif
 
 		// In case a default schema was used for this stream
@@ -107,21 +200,17 @@ void freeAllMem(EXIStream* strm)
 		{
 			// No schema-informed grammars. This is an empty EXIPSchema container that needs to be freed
 			// Freeing the string tables
-
-			for(i = 0; i < strm->schema->uriTable.count; i++)
-			{
-				if(strm->schema->uriTable.uri[i].pfxTable != NULL)
-					EXIP_MFREE(strm->schema->uriTable.uri[i].pfxTable);
-
-				destroyDynArray(&strm->schema->uriTable.uri[i].lnTable.dynArray);
-			}
-
-			destroyDynArray(&strm->schema->uriTable.dynArray);
+			destroyStringTables(&strm->schema->uriTable);
 			destroyDynArray(&strm->schema->grammarTable.dynArray);
 			if(strm->schema->simpleTypeTable.sType != NULL)
 				destroyDynArray(&strm->schema->simpleTypeTable.dynArray);
 			freeAllocList(&strm->schema->memList);
 		}
+		else if(strm->tablesMark.uri != NULL)
+		{
+			// The names added to a shared schema are allocated in the memList of the stream
+			restoreStringTables(&strm->schema->uriTable, &strm->tablesMark);
+		}
 	}
 
 	// Hash tables are freed separately
@@ -135,18 +224,187 @@ void freeAllMem(EXIStream* strm)
 	if(strm->valueTable.value != NULL)
 	{
 		Index i;
-		for(i = 0; i < strm->valueTable.count; i++)
+		// The strings allocated in the value arena are freed together with it
+		if(strm->valueArena == NULL)
 		{
-			EXIP_MFREE(strm->valueTable.value[i].valueStr.str);
+			for(i = 0; i < strm->valueTable.count; i++)
+			{
+				EXIP_MFREE(strm->valueTable.value[i].valueStr.str);
+			}
 		}
 
 		destroyDynArray(&strm->valueTable.dynArray);
 	}
 
+	if(strm->valueArena != NULL)
+	{
+		// The arena itself is in the memList
+		freeStringArena(strm->valueArena);
+		strm->valueArena = NULL;
+	}
+
 	freeAllocList(&(strm->memList));
 }
 
+errorCode resetAllMem(EXIStream* strm)
+{
+	EXIPSchema streamSchema;
+	StringArena valueArena;
+	// See freeAllMem(): such a schema is allocated in the memList of the stream
+	boolean ownSchema = strm->schema->staticGrCount <= SIMPLE_TYPE_COUNT;
+
+	while(strm->selfContained != NULL)
+		exitSelfContained(strm);
+
+	clearValueTable(strm);
+#if BUILD_IN_GRAMMARS_USE
+	freeBuiltInGrammars(strm->schema, strm->schema->staticGrCount);
+#endif
+	restoreStringTables(&strm->schema->uriTable, &strm->tablesMark);
+
+	// The objects in the memList that live as long as the stream are
+	// copied out and allocated again once the list is reset
+	if(ownSchema)
+		streamSchema = *strm->schema;
+	if(strm->valueArena != NULL)
+		valueArena = *strm->valueArena;
+
+	resetAllocList(&strm->memList);
+	strm->scGrammar = NULL;
+
+	if(ownSchema)
+	{
+		strm->schema = memManagedAllocate(&strm->memList, sizeof(EXIPSchema));
+		if(strm->schema == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		*strm->schema = streamSchema;
+	}
+
+	if(strm->valueArena != NULL)
+	{
+		strm->valueArena = memManagedAllocate(&strm->memList, sizeof(StringArena));
+		if(strm->valueArena == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		*strm->valueArena = valueArena;
+		resetStringArena(strm->valueArena);
+	}
+
+	return markStringTables(&strm->schema->uriTable, &strm->memList, &strm->tablesMark);
+}
+
+errorCode enterSelfContained(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct SelfContainedFrame* frame;
+	UriTable uriTable;
+
+	// The string tables as they were after the schema was set
+	tmp_err_code = copyStringTables(&strm->schema->uriTable, &strm->tablesMark, strm->schema->staticGrCount, &uriTable);
+	if(tmp_err_code != EXIP_OK)
+	{
+		destroyStringTables(&uriTable);
+		return tmp_err_code;
+	}
+
+	frame = EXIP_MALLOC(sizeof(struct SelfContainedFrame));
+	if(frame == NULL)
+	{
+		destroyStringTables(&uriTable);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	frame->uriTable = strm->schema->uriTable;
+	frame->valueTable = strm->valueTable;
+	frame->grammarCount = strm->schema->grammarTable.count;
+	frame->offset = strm->context.bufferOffset + strm->context.bufferIndx;
+	frame->fragment = NULL;
+	frame->previous = strm->selfContained;
+	strm->selfContained = frame;
+	strm->schema->uriTable = uriTable;
+
+	// An empty value table with the same set up as the one of the stream
+	strm->valueTable.value = NULL;
+	strm->valueTable.count = 0;
+	strm->valueTable.globalId = 0;
+#if HASH_TABLE_USE
+	strm->valueTable.hashTbl = NULL;
+#endif
+	if(frame->valueTable.value != NULL)
+	{
+		TRY_CATCH(createValueTable(&strm->valueTable), exitSelfContained(strm));
+	}
+
+#if HASH_TABLE_USE
+	if(frame->valueTable.hashTbl != NULL)
+	{
+		strm->valueTable.hashTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
+		if(strm->valueTable.hashTbl == NULL)
+		{
+			exitSelfContained(strm);
+			return EXIP_HASH_TABLE_ERROR;
+		}
+	}
+#endif
+
+	return EXIP_OK;
+}
+
+void exitSelfContained(EXIStream* strm)
+{
+	struct SelfContainedFrame* frame = strm->selfContained;
+
+	// Frees the value table, the built-in grammars and the string tables of the element...
+	clearValueTable(strm);
+#if HASH_TABLE_USE
+	if(strm->valueTable.hashTbl != NULL)
+		hashtable_destroy(strm->valueTable.hashTbl);
+#endif
+	if(strm->valueTable.value != NULL)
+		destroyDynArray(&strm->valueTable.dynArray);
+#if BUILD_IN_GRAMMARS_USE
+	freeBuiltInGrammars(strm->schema, frame->grammarCount);
+#endif
+	destroyStringTables(&strm->schema->uriTable);
+
+	// ...and restores the ones of the enclosing stream
+	strm->schema->uriTable = frame->uriTable;
+	strm->valueTable = frame->valueTable;
+	strm->selfContained = frame->previous;
+	EXIP_MFREE(frame);
+}
+
+#if MEM_ARENA_USE
+
 void freeAllocList(AllocList* list)
+{
+	struct arenaChunk* chunk = list->firstChunk;
+	struct arenaChunk* rmChunk;
+
+	while(chunk != NULL)
+	{
+		rmChunk = chunk;
+		chunk = chunk->nextChunk;
+		EXIP_MFREE(rmChunk);
+	}
+
+	list->firstChunk = NULL;
+	list->currChunk = NULL;
+}
+
+void resetAllocList(AllocList* list)
+{
+	struct arenaChunk* chunk;
+
+	for(chunk = list->firstChunk; chunk != NULL; chunk = chunk->nextChunk)
+		chunk->used = 0;
+
+	list->currChunk = list->firstChunk;
+}
+
+#else
+
+/** Frees the allocations of an AllocList and all its blocks but the first one */
+static void freeAllocations(AllocList* list)
 {
 	struct allocBlock* tmpBlock = list->firstBlock;
 	struct allocBlock* rmBl;
@@ -165,6 +423,94 @@ void freeAllocList(AllocList* list)
 
 		rmBl = tmpBlock;
 		tmpBlock = tmpBlock->nextBlock;
-		EXIP_MFREE(rmBl);
+		if(rmBl != list->firstBlock)
+			EXIP_MFREE(rmBl);
+	}
+}
+
+void freeAllocList(AllocList* list)
+{
+	freeAllocations(list);
+	EXIP_MFREE(list->firstBlock);
+}
+
+void resetAllocList(AllocList* list)
+{
+	freeAllocations(list);
+	list->firstBlock->nextBlock = NULL;
+	list->lastBlock = list->firstBlock;
+	list->currAllocSlot = 0;
+}
+
+#endif /* MEM_ARENA_USE */
+
+void initStringArena(StringArena* arena)
+{
+	arena->currChunk = NULL;
+	arena->zeroCopy = TRUE;
+}
+
+void* arenaAllocate(StringArena* arena, size_t size)
+{
+	struct arenaChunk* chunk = arena->currChunk;
+	void* ptr;
+
+	// Keep the allocations pointer-aligned
+	size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+	if(chunk == NULL || chunk->size - chunk->used < size)
+	{
+		size_t chunkSize = size > STRING_ARENA_CHUNK_SIZE ? size : STRING_ARENA_CHUNK_SIZE;
+
+		chunk = EXIP_MALLOC(sizeof(struct arenaChunk) + chunkSize);
+		if(chunk == NULL)
+			return NULL;
+
+		chunk->nextChunk = arena->currChunk;
+		chunk->size = chunkSize;
+		chunk->used = 0;
+		arena->currChunk = chunk;
+	}
+
+	ptr = (unsigned char*) (chunk + 1) + chunk->used;
+	chunk->used += size;
+
+	return ptr;
+}
+
+void resetStringArena(StringArena* arena)
+{
+	struct arenaChunk* chunk;
+	struct arenaChunk* rmChunk;
+
+	if(arena->currChunk != NULL)
+	{
+		chunk = arena->currChunk->nextChunk;
+		while(chunk != NULL)
+		{
+			rmChunk = chunk;
+			chunk = chunk->nextChunk;
+			EXIP_MFREE(rmChunk);
+		}
+
+		arena->currChunk->nextChunk = NULL;
+		arena->currChunk->used = 0;
+	}
+
+	arena->zeroCopy = TRUE;
+}
+
+void freeStringArena(StringArena* arena)
+{
+	struct arenaChunk* chunk = arena->currChunk;
+	struct arenaChunk* rmChunk;
+
+	while(chunk != NULL)
+	{
+		rmChunk = chunk;
+		chunk = chunk->nextChunk;
+		EXIP_MFREE(rmChunk);
 	}
+
+	arena->currChunk = NULL;
 }
@@ -165,6 +165,9 @@ void popFromStackPersistent(GenericStack** stack, void** item)
 		"EXIP_NO_PREFIXES_PRESERVED_XML_SCHEMA",
 		"EXIP_INVALID_STRING_OPERATION",
 		"EXIP_HEADER_OPTIONS_MISMATCH",
-		"EXIP_HANDLER_STOP"
+		"EXIP_HANDLER_STOP",
+		"EXIP_INVALID_INPUT",
+		"EXIP_INVALID_EVENT",
+		"EXIP_HANDLER_SKIP_ELEMENT"
 	};
 #endif
@@ -21,6 +21,115 @@
 
 #include "contentHandler.h"
 
+/** The kinds of events returned by exipNextEvent() */
+enum ExipEventKind
+{
+	EXIP_EVENT_NONE            =0,
+	EXIP_EVENT_START_DOCUMENT  =1,
+	EXIP_EVENT_END_DOCUMENT    =2,
+	EXIP_EVENT_START_ELEMENT   =3,
+	EXIP_EVENT_END_ELEMENT     =4,
+	EXIP_EVENT_ATTRIBUTE       =5,
+	EXIP_EVENT_NAMESPACE       =6,
+	EXIP_EVENT_INT             =7,
+	EXIP_EVENT_BOOLEAN         =8,
+	EXIP_EVENT_STRING          =9,
+	EXIP_EVENT_FLOAT           =10,
+	EXIP_EVENT_BINARY          =11,
+	EXIP_EVENT_DATE_TIME       =12,
+	EXIP_EVENT_DECIMAL         =13,
+	EXIP_EVENT_LIST            =14,
+	EXIP_EVENT_QNAME           =15,
+	EXIP_EVENT_PI              =16,
+	EXIP_EVENT_SELF_CONTAINED  =17
+};
+
+typedef enum ExipEventKind ExipEventKind;
+
+/**
+ * An event of the EXI stream as returned by exipNextEvent().
+ * The events and the values are the same as the ones passed to the
+ * ContentHandler callbacks by parseNext(). The strings and the binary data
+ * are views into the string tables or the string arena of the parser.
+ */
+struct ExipEvent
+{
+	ExipEventKind kind;
+	/** The qname of EXIP_EVENT_START_ELEMENT, EXIP_EVENT_ATTRIBUTE and EXIP_EVENT_QNAME;
+	 * the prefix is an empty string when not preserved */
+	struct
+	{
+		String uri;
+		String localName;
+		String prefix;
+	} name;
+	/** The IDs of the qname of EXIP_EVENT_START_ELEMENT and EXIP_EVENT_ATTRIBUTE in the
+	 * string tables; {URI_MAX, LN_MAX} for the other events and in compression modes */
+	QNameID qnameId;
+	/** The value of the event; the member is selected by the kind */
+	union
+	{
+		Integer intVal;
+		boolean boolVal;
+		Float floatVal;
+		Decimal decVal;
+		EXIPDateTime dtVal;
+		String strVal;
+		struct
+		{
+			const char* data;
+			Index length;
+		} binVal;
+		struct
+		{
+			EXITypeClass itemType;
+			unsigned int itemCount;
+		} listVal;
+		struct
+		{
+			String ns;
+			String prefix;
+			boolean isLocalElementNS;
+		} nsVal;
+	} value;
+};
+
+typedef struct ExipEvent ExipEvent;
+
+/**
+ * The events decoded but not yet returned by exipNextEvent().
+ * A single production can report several events, e.g. an attribute and its value
+ * or a list and its items.
+ */
+struct ExipEventQueue
+{
+	DynArray dynArray;
+	ExipEvent* event;
+	Index count;
+	/** The index of the next event to be returned */
+	Index next;
+	/** One of the PULL_STATE_* values of EXIParser.c */
+	unsigned char state;
+};
+
+typedef struct ExipEventQueue ExipEventQueue;
+
+/**
+ * The progress of skipElement(), kept when the skipping is interrupted
+ * by the end of the input buffer
+ */
+struct SkipState
+{
+	/** TRUE while an element is being skipped */
+	boolean active;
+	/** The grammar stack node of the parent of the skipped element */
+	EXIGrammarStack* parent;
+	/** Compression modes: the number of elements left to be closed */
+	unsigned int depth;
+};
+
+typedef struct SkipState SkipState;
+
 /**
  * Parses an EXI document.
  */
@@ -31,6 +140,10 @@ struct Parser
 	/** Function pointers for document events. */
 	ContentHandler handler;
 	void* app_data;
+	/** The events of the pull interface exipNextEvent() */
+	ExipEventQueue events;
+	/** The progress of skipElement() */
+	SkipState skip;
 };
 
 typedef struct Parser Parser;
@@ -43,6 +156,13 @@ struct EXIParser
 	errorCode (*parseNext)(Parser* parser);
 	errorCode (*pushEXIData)(char* inBuf, unsigned int bufSize, Parser* parser);
 	void (*destroyParser)(Parser* parser);
+	errorCode (*enableStringArena)(Parser* parser);
+	errorCode (*resetParser)(Parser* parser, BinaryBuffer buffer);
+	errorCode (*setBinaryChunkSize)(Parser* parser, Index chunkSize);
+	errorCode (*exipNextEvent)(Parser* parser, ExipEvent* event);
+	errorCode (*skipElement)(Parser* parser);
+	errorCode (*seekSelfContained)(Parser* parser, Index offset);
+	errorCode (*useSelfContainedIndex)(Parser* parser, SelfContainedIndex* index);
 };
 
 typedef struct EXIParser EXIParser;
@@ -117,6 +237,159 @@ errorCode parseNext(Parser* parser);
  */
 errorCode pushEXIData(char* inBuf, unsigned int bufSize, Parser* parser);
 
+/**
+ * @brief Switches the parser to decode the string values in a per-document arena
+ *
+ * Instead of one allocation per string value that is not found in the
+ * string tables, the values are allocated in large chunks that are freed
+ * together by destroyParser(). When the input buffer holds the whole EXI
+ * stream (no input stream is used) the 7-bit string values that start on a byte
+ * boundary are not copied at all - the String passed to the stringData()
+ * handler points directly into the input buffer. In both cases
+ * the String is valid only during the stringData() callback.
+ *
+ * Must be called after initParser() and before any value is parsed.
+ * The first call to pushEXIData() copies the string values that point into
+ * the input buffer to the arena and disables the zero-copy decoding.
+ *
+ * @param[in, out] parser the parser object
+ * @return Error handling code
+ */
+errorCode enableStringArena(Parser* parser);
+
+/**
+ * @brief Prepares the parser object for the next EXI stream
+ *
+ * The parser is restored to its state right after setSchema(): the string
+ * and value tables are emptied of the entries added by the previous stream and
+ * the built-in grammars learned by it are dropped, while the allocated memory
+ * is kept for reuse where possible. The content handler, the application data,
+ * the schema and the options are kept as well. The cost is proportional to
+ * the number of entries added by the previous stream.
+ *
+ * Call parseHeader() next (but not setSchema()) and then parseNext() as usual.
+ * The options of the new stream must match the previous ones or parseHeader()
+ * returns EXIP_HEADER_OPTIONS_MISMATCH. With outOfBandOpts set to TRUE, the
+ * options of the previous stream serve as the out-of-band options.
+ *
+ * @param[in, out] parser the parser object; setSchema() must be called before
+ * @param[in] buffer an input buffer holding (part of) the representation of the next EXI stream
+ * @return Error handling code
+ */
+errorCode resetParser(Parser* parser, BinaryBuffer buffer);
+
+/**
+ * @brief Switches the parser to report the binary values in chunks
+ *
+ * When chunkSize is greater than 0 and the binaryDataChunk() handler is set,
+ * each base64Binary/hexBinary value is decoded chunkSize bytes at a time and
+ * every chunk is passed to binaryDataChunk() as soon as it is decoded, so large
+ * values are never buffered whole (except in compression and pre-compression
+ * modes, where the values of a block are decoded before they are reported).
+ * An empty value is reported as a single chunk of 0 bytes. The chunk is valid
+ * only during the callback. A chunkSize of 0 restores the default reporting
+ * of whole values to binaryData().
+ *
+ * @param[in, out] parser the parser object
+ * @param[in] chunkSize the maximum number of bytes passed to binaryDataChunk() at once
+ * @return Error handling code
+ */
+errorCode setBinaryChunkSize(Parser* parser, Index chunkSize);
+
+/**
+ * @brief Parse the next event from the EXI stream contained in the parser object
+ *
+ * A pull interface alternative to parseNext(): instead of invoking the content
+ * handler callbacks, the events are returned one at a time to the caller, which can
+ * stop the parsing at any event. It is an adapter over the callbacks: each production
+ * is decoded by processNextProduction() with an internal content handler that appends
+ * the reported events to a queue in the parser, from which they are copied out.
+ * It is not faster than parseNext(). The first event returned is
+ * EXIP_EVENT_START_DOCUMENT and the last one EXIP_EVENT_END_DOCUMENT. The content
+ * handler of the parser is not invoked for the body events, apart from the
+ * warning(), error() and fatalError() callbacks.
+ *
+ * Requires the string arena (see enableStringArena()): the string and binary values
+ * of the events remain valid until resetParser() or destroyParser(). Without it,
+ * EXIP_INCONSISTENT_PROC_STATE is returned. The strings decoded without a copy remain
+ * valid only until the next pushEXIData(). In compression and pre-compression modes the events are replayed
+ * from the decoded block and their string values are valid only until the next call
+ * to exipNextEvent(). The calls to exipNextEvent() and parseNext() must not be mixed
+ * on the same stream.
+ *
+ * @param[in, out] parser the parser object; parseHeader() and setSchema() must be called before
+ * @param[out] event the next event
+ *
+ * @return Error handling code; EXIP_PARSING_COMPLETE after EXIP_EVENT_END_DOCUMENT is returned,
+ * EXIP_BUFFER_END_REACHED when more data is needed: pushEXIData() must be used to fill the buffer
+ * before calling exipNextEvent() again.
+ */
+errorCode exipNextEvent(Parser* parser, ExipEvent* event);
+
+/**
+ * @brief Skips the rest of the current element, up to and including its end
+ *
+ * Used when the content of the element is not needed: the events of the content
+ * are not reported (neither their end element event) and the string values that
+ * are not added to the string tables and the binary values are skipped without
+ * being decoded. The rest of the content is decoded only as much as needed to keep
+ * the grammars and the string tables consistent. In compression and pre-compression
+ * modes the events of the blocks already decoded are passed over directly, and
+ * the self-contained elements whose end is in the index given with
+ * useSelfContainedIndex() are passed over without decoding their content.
+ *
+ * The current element is the one whose start element event was reported last
+ * and is not closed yet. Returning EXIP_HANDLER_SKIP_ELEMENT from the startElement()
+ * handler has the same effect as calling skipElement() right after the callback.
+ * With exipNextEvent(), the events of the element not yet returned are dropped.
+ *
+ * @param[in, out] parser the parser object
+ * @return Error handling code; EXIP_PARSING_COMPLETE at the end of the stream,
+ * EXIP_BUFFER_END_REACHED when more data is needed: pushEXIData() must be used to fill
+ * the buffer before calling skipElement(), parseNext() or exipNextEvent() again to
+ * continue the skipping.
+ */
+errorCode skipElement(Parser* parser);
+
+/**
+ * @brief Positions the parser at a self-contained element
+ *
+ * Random access to the elements of a stream encoded with the selfContained
+ * option: the element starting at the byte offset (as recorded in the
+ * SelfContainedIndex of the serializer, see setSelfContainedIndex()) is decoded
+ * on its own, with the initial string tables, without parsing what precedes it.
+ * The following parseNext() or exipNextEvent() calls report the events of the
+ * element, from its start element to its end element, and then the end of the
+ * document.
+ *
+ * If the offset is within the input buffer the parsing continues from there.
+ * Otherwise the buffer is emptied and the application must position the input
+ * stream at the offset (or push the data from there with pushEXIData()) before
+ * the next call; the offsets are counted from the beginning of the EXI stream.
+ * Can be called any number of times after parseHeader() and setSchema().
+ *
+ * @param[in, out] parser the parser object
+ * @param[in] offset the byte offset of the self-contained element in the EXI stream
+ * @return Error handling code
+ */
+errorCode seekSelfContained(Parser* parser, Index offset);
+
+/**
+ * @brief Gives the parser the index of the self-contained elements of the stream
+ *
+ * The index is the one filled by the serializer of the stream (see setSelfContainedIndex()
+ * of EXISerializer.h). skipElement() then moves the input directly to the end of the
+ * self-contained elements being skipped, as recorded in the index; the input stream
+ * is read up to there, or EXIP_BUFFER_END_REACHED is returned until the data is pushed
+ * with pushEXIData(). The index is owned by the application and must remain valid
+ * until resetParser() or destroyParser(); NULL stops its use.
+ *
+ * @param[in, out] parser the parser object
+ * @param[in] index the index of the stream being parsed
+ * @return Error handling code
+ */
+errorCode useSelfContainedIndex(Parser* parser, SelfContainedIndex* index);
+
 /**
  * @brief Free any memroy allocated by parser object
  * @param[in] parser the parser object
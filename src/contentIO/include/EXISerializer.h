@@ -29,6 +29,8 @@ struct EXISerializer
 	errorCode (*startElement)(EXIStream* strm, QName qname, EXITypeClass* valueType);
 	errorCode (*endElement)(EXIStream* strm);
 	errorCode (*attribute)(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeClass* valueType);
+	errorCode (*startElementId)(EXIStream* strm, QNameID qnameId, EXITypeClass* valueType);
+	errorCode (*attributeId)(EXIStream* strm, QNameID qnameId, boolean isSchemaType, EXITypeClass* valueType);
 
 	// For handling the data
 	errorCode (*intData)(EXIStream* strm, Integer int_val);
@@ -56,7 +58,10 @@ struct EXISerializer
 	void (*initHeader)(EXIStream* strm);
 	errorCode (*initStream)(EXIStream* strm, BinaryBuffer buffer, EXIPSchema* schema);
 	errorCode (*closeEXIStream)(EXIStream* strm);
+	errorCode (*resetStream)(EXIStream* strm, BinaryBuffer buffer);
 	errorCode (*flushEXIData)(EXIStream* strm);
+	errorCode (*resolveQName)(EXIPSchema* schema, QName qname, QNameID* qnameId);
+	errorCode (*setSelfContainedIndex)(EXIStream* strm, SelfContainedIndex* index);
 };
 
 typedef struct EXISerializer EXISerializer;
@@ -125,6 +130,34 @@ errorCode endElement(EXIStream* strm);
  */
 errorCode attribute(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeClass* valueType);
 
+/**
+ * @brief Encodes start of an element with a QName resolved by resolveQName()
+ * No string comparisons are made to find the grammar production and the QName
+ * is encoded as a string table hit.
+ *
+ * @param[in, out] strm EXI stream object
+ * @param[in] qnameId the QName IDs of the element
+ * @param[out] valueType see startElement()
+ * @return Error handling code; EXIP_INVALID_EXIP_CONFIGURATION if qnameId is
+ * not in the string tables of the stream
+ * @note When Preserve.prefixes is TRUE and the URI has more than one prefix
+ * use startElement() to give the prefix
+ */
+errorCode startElementId(EXIStream* strm, QNameID qnameId, EXITypeClass* valueType);
+
+/**
+ * @brief Encodes a start of an attribute with a QName resolved by resolveQName()
+ * The same as attribute() without the string operations on the QName.
+ *
+ * @param[in, out] strm EXI stream object
+ * @param[in] qnameId the QName IDs of the attribute
+ * @param[in] isSchemaType see attribute()
+ * @param[out] valueType see attribute()
+ * @return Error handling code; EXIP_INVALID_EXIP_CONFIGURATION if qnameId is
+ * not in the string tables of the stream
+ */
+errorCode attributeId(EXIStream* strm, QNameID qnameId, boolean isSchemaType, EXITypeClass* valueType);
+
 // For handling the data
 
 /**
@@ -273,9 +306,17 @@ errorCode entityReference(EXIStream* strm, const String reference);
 /**
  * @brief Encode a self Contained event used for indexing independent elements for random access
  *
+ * Called right after the startElement() of the element, before its attributes and
+ * content, when the selfContained option is set. The rest of the element is encoded
+ * as usual but independently of the enclosing stream: it starts on a byte boundary
+ * with the initial string tables and grammars, and the tables of the enclosing stream
+ * are restored after its endElement(). Such an element can be decoded on its own
+ * with seekSelfContained() of EXIParser.h; see setSelfContainedIndex().
+ * The namespace declarations in scope, if prefixes are preserved, are not inherited by
+ * the element: it declares the ones it uses with namespaceDeclaration().
+ *
  * @param[in, out] strm EXI stream object
  * @return Error handling code
- * @todo define the parameters!
  */
 errorCode selfContained(EXIStream* strm);
 
@@ -307,6 +348,24 @@ errorCode initStream(EXIStream* strm, BinaryBuffer buffer, EXIPSchema *schema);
  */
 errorCode closeEXIStream(EXIStream* strm);
 
+/**
+ * @brief Completes the EXI stream like closeEXIStream() and prepares the
+ * EXI stream object for serializing the next stream
+ *
+ * The object is restored to its state right after initStream(): the string
+ * and value tables are emptied of the entries added by the previous stream and
+ * the built-in grammars learned by it are dropped, while the allocated memory
+ * is kept for reuse where possible. The header, the options and the schema are kept.
+ * The cost is proportional to the number of entries added by the previous stream.
+ * Continue with serialize.exiHeader() and serialize.startDocument() as usual.
+ *
+ * @param[in, out] strm EXI stream object initialized with initStream()
+ * @param[in] buffer output buffer for the next EXI stream
+ * @return Error handling code; EXIP_BUFFER_END_REACHED if the previous stream
+ * could not be flushed completely - the object is reset in any case
+ */
+errorCode resetStream(EXIStream* strm, BinaryBuffer buffer);
+
 /**
  * @brief In case the EXI buffer (strm->buffer) is filled this function can be used to
  * flush it to some external buffer when strm->buffer.ioStrm.readWriteToStream is not available.
@@ -335,6 +394,46 @@ errorCode closeEXIStream(EXIStream* strm);
  */
 errorCode flushEXIData(EXIStream* strm, char* outBuf, unsigned int bufSize, unsigned int* bytesFlush);
 
+/**
+ * @brief Resolves a QName to its IDs in the string tables of a schema.
+ * The IDs are used with startElementId() and attributeId() to avoid resolving the
+ * same QName on every event. They are valid for all the streams that use this schema.
+ * In schema-less mode the schema of the stream (strm->schema) can be used once the
+ * QName is serialized; such IDs are valid until resetStream() or closeEXIStream().
+ *
+ * @param[in] schema the schema object given to initStream()
+ * @param[in] qname the qualified name to resolve; the prefix is not used
+ * @param[out] qnameId the QName IDs
+ * @return Error handling code; EXIP_INVALID_EXIP_CONFIGURATION if the QName is not in
+ * the string tables of the schema. Such QNames are serialized with startElement()/attribute()
+ */
+errorCode resolveQName(EXIPSchema* schema, QName qname, QNameID* qnameId);
+
+/**
+ * @brief Records the position of every self-contained element encoded from now on
+ *
+ * Until closeEXIStream() or resetStream(), each call to selfContained() adds an entry
+ * to the index with the ordinal of the element (the number of elements started before
+ * it in the stream) and the byte offset of its content in the EXI stream, to be given
+ * to seekSelfContained() of EXIParser.h. The byte offset of the end of the element is
+ * added at its endElement(); with the index, skipElement() of EXIParser.h passes over
+ * the element directly (see useSelfContainedIndex()).
+ * The index is owned by the application, which keeps it after closeEXIStream() and frees
+ * it with destroySelfContainedIndex().
+ *
+ * @param[in, out] strm EXI stream object initialized with initStream()
+ * @param[out] index the index to be filled
+ * @return Error handling code
+ */
+errorCode setSelfContainedIndex(EXIStream* strm, SelfContainedIndex* index);
+
+/**
+ * @brief Frees the entries of an index filled through setSelfContainedIndex()
+ *
+ * @param[in, out] index the index to be freed
+ */
+void destroySelfContainedIndex(SelfContainedIndex* index);
+
 /****  END: Serializer API implementation  ****/
 
 
@@ -19,6 +19,82 @@
 
 #include "contentHandler.h"
 
+/** The maximum number of values of the second part of an event code */
+#define SECOND_LEVEL_CODES_MAX 16
+/** The maximum number of different second level layouts in a stream */
+#define SECOND_LEVEL_LAYOUTS_MAX 16
+/** SecondLevelCodes.event[] value of the second parts that are not used */
+#define SECOND_LEVEL_EVENT_NONE 0xFF
+
+/**
+ * The second level event codes of a grammar rule. The events are numbered
+ * in the order of the second level productions of the kind of grammar
+ * (built-in element or schema-informed; strict or non-strict mode)
+ */
+struct SecondLevelCodes
+{
+	/** Number of bits of the second part of the event code */
+	unsigned char bits;
+	/** The event for each value of the second part */
+	unsigned char event[SECOND_LEVEL_CODES_MAX];
+};
+
+typedef struct SecondLevelCodes SecondLevelCodes;
+
+/** How the event codes of a rule of a grammar other than the built-in element grammars are decoded */
+struct RuleDispatch
+{
+	/** Number of bits of the first part of the event code */
+	unsigned char firstBits;
+	/** Number of bits of the first part of the event code after xsi:nil="true" */
+	unsigned char nilFirstBits;
+	/** The SecondLevelCodes of the rule in EventCodeDispatch.layout */
+	unsigned char secondLevel;
+};
+
+typedef struct RuleDispatch RuleDispatch;
+
+/**
+ * The event code widths and second level events of the grammar rules of a
+ * stream. They depend only on the grammars and the EXI options so they are
+ * computed once when the schema is set. Only the first part of the event
+ * codes of the built-in element grammars, whose rules grow while parsing,
+ * is computed for each production.
+ */
+struct EventCodeDispatch
+{
+	/** The different second level layouts of the rules */
+	SecondLevelCodes layout[SECOND_LEVEL_LAYOUTS_MAX];
+	unsigned char layoutCount;
+	/** Layouts of the StartTagContent and ElementContent rules of the built-in element grammars */
+	unsigned char builtInStartTag;
+	unsigned char builtInContent;
+	/** Number of grammars of schema->grammarTable with a dispatch */
+	Index grammarCount;
+	/** The first RuleDispatch of schema->docGrammar followed by those of each grammar
+	 * of schema->grammarTable in rule[]; INDEX_MAX if it has none.
+	 * The rules of a grammar are followed by an entry for GR_CONTENT_2 */
+	Index* ruleOffset;
+	RuleDispatch* rule;
+};
+
+typedef struct EventCodeDispatch EventCodeDispatch;
+
+/**
+ * @brief Computes the event code dispatch of the stream (strm->dispatch) for
+ * the grammars of strm->schema and the built-in element grammars.
+ * Requires the EXI options of the stream. processNextProduction() requires it.
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode createEventCodeDispatch(EXIStream* strm);
+
+/**
+ * @brief Frees the event code dispatch of the stream if any
+ * @param[in, out] strm EXI stream
+ */
+void destroyEventCodeDispatch(EXIStream* strm);
+
 /**
  * @brief Process the next grammar production in the Current Grammar
  *
@@ -114,6 +190,17 @@ errorCode decodeEventContent(EXIStream* strm, Production* prodHit, ContentHandle
  */
 errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler, SmallIndex* nonTermID_out, QNameID localQNameID, void* app_data);
 
+/**
+ * @brief Checks the return code of a startElement() handler callback.
+ * EXIP_HANDLER_SKIP_ELEMENT is recorded in strm->context.skipRequested
+ * and the decoding continues as if EXIP_OK was returned
+ *
+ * @param[in, out] strm EXI stream representation
+ * @param[in] handlerCode the code returned by startElement()
+ * @return Error handling code
+ */
+errorCode checkSkipRequest(EXIStream* strm, errorCode handlerCode);
+
 /**
  * @brief Decodes NS event
  * @param[in, out] strm EXI stream representation
@@ -144,5 +231,12 @@ errorCode decodeSEWildcardEvent(EXIStream* strm, ContentHandler* handler, SmallI
  */
 errorCode decodeATWildcardEvent(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data);
 
+/**
+ * @brief Looks up the end of a self-contained element in an index
+ * @param[in] index the self-contained elements of a stream in document order
+ * @param[in] offset the position in the EXI stream of the content of the element
+ * @return the position in the EXI stream right after the element; 0 if it is not known
+ */
+Index getSelfContainedEnd(const SelfContainedIndex* index, Index offset);
 
 #endif /* BODYDECODE_H_ */
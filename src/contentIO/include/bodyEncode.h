@@ -20,17 +20,93 @@
 #include "errorHandle.h"
 #include "procTypes.h"
 
+/** Number of entries of the QName -> QNameID cache of the serializer; a power of 2 */
+#define QNAME_CACHE_SIZE 64
+/** Grammar rules with at least this number of productions are searched
+ * through the ProductionIndex; the smaller ones are scanned */
+#define PROD_INDEX_THRESHOLD 8
+
+/** A QName recently resolved by the serializer. The entries are keyed by
+ * the addresses of the strings and checked against the string tables on a hit */
+struct QNameCacheEntry
+{
+	const CharType* uri;
+	const CharType* ln;
+	QNameID qnameId;
+};
+
+/** A slot of the production hash index; rule is NULL for the empty slots */
+struct ProductionIndexSlot
+{
+	const GrammarRule* rule;
+	QNameID qnameId;
+	/** The EventTypeClass of the productions or PROD_INDEX_RULE_MARK */
+	unsigned char eventClass;
+	/** The last production of the rule with this event class and
+	 * QNameID; for PROD_INDEX_RULE_MARK: the number of productions indexed */
+	Index prodIndx;
+};
+
+/** ProductionIndexSlot.eventClass of the entry that records how much of a rule is indexed */
+#define PROD_INDEX_RULE_MARK 0xFF
+
+/**
+ * Serializer lookup structures for encodeProduction(): the QName cache and
+ * a hash index (grammar rule, event class, QNameID) -> production. The rules
+ * are indexed on first use; as the productions are only appended to the built-in
+ * grammar rules, the ones inserted later are added on the next use of the rule.
+ */
+struct ProductionIndex
+{
+	struct QNameCacheEntry qnameCache[QNAME_CACHE_SIZE];
+	struct ProductionIndexSlot* slot;
+	/** The number of slots - a power of 2 */
+	Index size;
+	Index count;
+};
+
+typedef struct ProductionIndex ProductionIndex;
+
+/**
+ * @brief Creates the production index and QName cache of the serializer (strm->prodIndex)
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode createProductionIndex(EXIStream* strm);
+
+/**
+ * @brief Drops all the entries of the production index and QName cache, if any.
+ * Needed when the built-in grammars and the string table entries of the stream are freed.
+ * @param[in, out] strm EXI stream
+ */
+void clearProductionIndex(EXIStream* strm);
+
+/**
+ * @brief Frees the production index and QName cache of the stream, if any
+ * @param[in, out] strm EXI stream
+ */
+void destroyProductionIndex(EXIStream* strm);
+
 /**
  * @brief Finds the grammar production based on the event (and eventually the qname in case of SE and AT)
  * @param[in, out] strm EXI stream
  * @param[in] eventClass event class type to be looked up
  * @param[in] isSchemaType determine if the data type should be encoded as non-schema type
- * @param[in] qname element or attribute QName in case of SE or AT events; NULL otherwise
+ * @param[in] qnameID element or attribute QName IDs in case of SE or AT events as given by resolveQNameID(); NULL otherwise
  * @param[in] chTypeClass the type of the "value" content of CH EXI events; if not CH event then VALUE_TYPE_NONE_CLASS
  * @param[out] prodHit the matched grammar production
  * @return Error handling code
  */
-errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean isSchemaType, QName* qname, EXITypeClass chTypeClass, Production* prodHit);
+errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean isSchemaType, QNameID* qnameID, EXITypeClass chTypeClass, Production* prodHit);
+
+/**
+ * @brief Resolves the QName of an SE or AT event to its IDs in the string tables.
+ * The QName cache of the stream is checked first.
+ * @param[in] strm EXI stream
+ * @param[in] qname the QName
+ * @param[out] qnameID the QName IDs; URI_MAX/LN_MAX if the URI/local name is not in the string tables
+ */
+void resolveQNameID(EXIStream* strm, QName* qname, QNameID* qnameID);
 
 /**
  * @brief Encodes String value into EXI stream
@@ -54,6 +130,17 @@ errorCode encodeStringData(EXIStream* strm, String strng, QNameID qnameID, Index
  */
 errorCode encodeQName(EXIStream* strm, QName qname, EventType eventT, QNameID* qnameID);
 
+/**
+ * @brief Encodes QName that is in the URI and LN string tables into EXI stream
+ * @param[in, out] strm EXI stream
+ * @param[in] qname the prefix of the QName in case of Preserve.prefixes; can be NULL when
+ * the URI has at most one prefix
+ * @param[in] qnameID the QName ID
+ * @param[in] eventT (EVENT_SE_ALL or EVENT_AT_ALL) used for error checking purposes; see encodeQName()
+ * @return Error handling code
+ */
+errorCode encodeQNameID(EXIStream* strm, QName* qname, QNameID qnameID, EventType eventT);
+
 /**
  * @brief Encodes URI into EXI stream
  * @param[in, out] strm EXI stream
@@ -103,4 +190,44 @@ errorCode encodePfx(EXIStream* strm, SmallIndex uriID, String* prefix);
  */
 errorCode encodeIntData(EXIStream* strm, Integer int_val, QNameID qnameID, Index typeId);
 
+/**
+ * @brief Encodes Boolean value into EXI stream
+ * @param[in, out] strm EXI stream
+ * @param[in] bool_val boolean to be written
+ * @param[in] qnameID The uri/ln ids in the URI string table
+ * @param[in] typeId index in the type table; INDEX_MAX for untyped values
+ * @return Error handling code
+ */
+errorCode encodeBooleanData(EXIStream* strm, boolean bool_val, QNameID qnameID, Index typeId);
+
+/**
+ * @brief Encodes Float value into EXI stream
+ * @param[in, out] strm EXI stream
+ * @param[in] float_val float to be written
+ * @param[in] qnameID The uri/ln ids in the URI string table
+ * @param[in] typeId index in the type table; INDEX_MAX for untyped values
+ * @return Error handling code
+ */
+errorCode encodeFloatData(EXIStream* strm, Float float_val, QNameID qnameID, Index typeId);
+
+/**
+ * @brief Encodes Decimal value into EXI stream
+ * @param[in, out] strm EXI stream
+ * @param[in] dec_val decimal to be written
+ * @param[in] qnameID The uri/ln ids in the URI string table
+ * @param[in] typeId index in the type table; INDEX_MAX for untyped values
+ * @return Error handling code
+ */
+errorCode encodeDecimalData(EXIStream* strm, Decimal dec_val, QNameID qnameID, Index typeId);
+
+/**
+ * @brief Encodes Date-Time value into EXI stream
+ * @param[in, out] strm EXI stream
+ * @param[in] dt_val date-time to be written
+ * @param[in] qnameID The uri/ln ids in the URI string table
+ * @param[in] typeId index in the type table. It is used to determine the EXI date-time type
+ * @return Error handling code
+ */
+errorCode encodeDateTimeData(EXIStream* strm, EXIPDateTime dt_val, QNameID qnameID, Index typeId);
+
 #endif /* BODYENCODE_H_ */
@@ -0,0 +1,262 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file compression.h
+ * @brief Multiplexing of the EXI body in structure and value channels
+ * (EXI specification, section 9) used by the compression and
+ * pre-compression alignment options.
+ *
+ * The EXI body is split into blocks of up to blockSize attribute and
+ * character values. Within a block all event codes and QNames (together with
+ * the xsi:type and xsi:nil values) form the structure channel, while the rest of
+ * the values are grouped in one value channel per attribute/element QName.
+ * The channels are ordered by the first occurrence of their QName in the block.
+ * In compression mode each group of channels is DEFLATE-ed as described in
+ * section 9.3 of the spec.
+ *
+ * When serializing, the values are buffered in their channels and encoded when
+ * the block is complete. When parsing, the structure channel of a block is decoded
+ * first while recording the events, then the value channels are decoded and
+ * finally the events of the block are reported one grammar production per call
+ * to parse.parseNext().
+ *
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#ifndef COMPRESSION_H_
+#define COMPRESSION_H_
+
+#include "contentHandler.h"
+
+#if COMPRESSION_USE
+
+/** Only blocks (and channels) of up to this number of values are
+ * compressed together in a single DEFLATE stream */
+#define SMALL_CHANNEL_VALUES 100
+
+/**
+ * Whether a value with the given QName is multiplexed in a value channel.
+ * The values of xsi:type and xsi:nil are kept in the structure channel.
+ */
+#define IS_CHANNEL_VALUE(strm, qnameID) ((strm)->channels != NULL && \
+		!((qnameID).uriId == XML_SCHEMA_INSTANCE_ID && \
+		((qnameID).lnId == XML_SCHEMA_INSTANCE_TYPE_ID || (qnameID).lnId == XML_SCHEMA_INSTANCE_NIL_ID)))
+
+/** The payload of a buffered value or recorded content handler event */
+union ChannelData
+{
+	Integer intVal;
+	boolean boolVal;
+	Float floatVal;
+	Decimal decVal;
+	EXIPDateTime dtVal;
+	String strVal;
+	struct
+	{
+		char* buf;
+		Index len;
+	} binVal;
+	unsigned int itemCount;
+	/** Parser: the value placeholder in the structure channel */
+	Index valueId;
+};
+
+typedef union ChannelData ChannelData;
+
+/** A value item in a value channel */
+struct ChannelValue
+{
+	/** Serializer: which data function provided the value; parser: unused */
+	EXITypeClass valueClass;
+	Index typeId;
+	QNameID qnameID;
+	ChannelData data;
+	/** Parser: the events recorded while decoding the value */
+	Index firstEvent;
+	Index eventCount;
+	/** Next value in the same channel; INDEX_MAX for the last */
+	Index next;
+};
+
+typedef struct ChannelValue ChannelValue;
+
+/** A value channel of a block */
+struct Channel
+{
+	QNameID qnameID;
+	Index valueCount;
+	Index head;
+	Index tail;
+};
+
+typedef struct Channel Channel;
+
+/** A content handler event recorded by the parser */
+struct ChannelEvent
+{
+	unsigned char kind;
+	boolean flag;
+	String uri;
+	String ln;
+	String pfx;
+	ChannelData data;
+};
+
+typedef struct ChannelEvent ChannelEvent;
+
+struct ChannelState
+{
+	/** Memory for the copied string and binary values of the current block */
+	AllocList blockMem;
+
+	/** Value channels of the block in order of first occurrence */
+	struct
+	{
+		DynArray dynArray;
+		Channel* ch;
+		Index count;
+	} channelList;
+
+	/** Values of the block. Parser: value placeholders */
+	struct
+	{
+		DynArray dynArray;
+		ChannelValue* val;
+		Index count;
+	} valueList;
+
+	/** Open addressing hash index QNameID -> channel ID + 1 (0 - empty slot) */
+	Index* hashSlots;
+	Index hashSize;
+
+	/** Number of values in the block; list items are not counted */
+	Index blockValues;
+	/** Number of list items still expected for the last list value */
+	unsigned int listItemsLeft;
+
+	/** The channels of a DEFLATE stream before compressing (serializer) or after inflating (parser) */
+	BinaryBuffer plain;
+	/** Serializer: the DEFLATE-ed block. Parser: unused */
+	BinaryBuffer deflated;
+	/** Serializer: small memory buffer used as strm->buffer in compression mode */
+	char* workBuf;
+
+	/** The stream buffer while strm->buffer is replaced by a compression buffer */
+	BinaryBuffer savedBuffer;
+	Index savedBufferIndx;
+	unsigned char savedBitPointer;
+	boolean bufferSwapped;
+
+	/** Parser: the recorded events of the block */
+	struct
+	{
+		DynArray dynArray;
+		ChannelEvent* ev;
+		Index count;
+	} eventList;
+	/** Parser: the number of events recorded from the structure channel */
+	Index structureEvents;
+	/** Parser: the next event to be reported */
+	Index replayIndx;
+	/** Parser: TRUE while the structure channel is decoded */
+	boolean inStructure;
+	/** Parser: content handler that records the events of the block */
+	ContentHandler recorder;
+	/** Parser: the actual content handler and its application data */
+	ContentHandler* handler;
+	void* appData;
+};
+
+typedef struct ChannelState ChannelState;
+
+/**
+ * @brief Creates the channel state of an EXI stream (strm->channels)
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode createChannels(EXIStream* strm);
+
+/**
+ * @brief Frees the channel state of an EXI stream if any.
+ * The stream buffer of the application is restored if needed.
+ * @param[in, out] strm EXI stream
+ */
+void destroyChannels(EXIStream* strm);
+
+/**
+ * @brief Drops the current block of an EXI stream, if it has channels, and
+ * restores the stream buffer of the application if needed. The memory
+ * of the channel state is kept for the next stream.
+ * @param[in, out] strm EXI stream
+ */
+void resetChannels(EXIStream* strm);
+
+/**
+ * @brief Serializer: starts a new block of the EXI body.
+ * In compression mode the structure channel is redirected to an internal buffer.
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode beginChannelBlock(EXIStream* strm);
+
+/**
+ * @brief Serializer: buffers a value in its value channel. The string and binary
+ * values are copied. When the block gets full it is closed and a new one is started.
+ * @param[in, out] strm EXI stream
+ * @param[in] valueClass the data function used to provide the value
+ * @param[in] data the value
+ * @param[in] qnameID The uri/ln ids of the attribute or element
+ * @param[in] typeId index in the type table; INDEX_MAX for untyped values
+ * @return Error handling code
+ */
+errorCode deferValueItem(EXIStream* strm, EXITypeClass valueClass, ChannelData* data, QNameID qnameID, Index typeId);
+
+/**
+ * @brief Serializer: encodes the value channels of the current block and,
+ * in compression mode, writes the DEFLATE-ed block in the stream buffer
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode closeChannelBlock(EXIStream* strm);
+
+/**
+ * @brief Parser: registers a value to be decoded from its value channel
+ * after the structure channel of the block is decoded
+ * @param[in, out] strm EXI stream
+ * @param[in] typeId index in the type table; INDEX_MAX for untyped values
+ * @param[in] qnameID The uri/ln ids of the attribute or element
+ * @return Error handling code
+ */
+errorCode addValuePlaceholder(EXIStream* strm, Index typeId, QNameID qnameID);
+
+/**
+ * @brief Parser: reports the events of the next grammar production. A new block
+ * is decoded when all the events of the current one are reported.
+ * @param[in, out] strm EXI stream
+ * @param[in] handler content handler callbacks
+ * @param[in] app_data Application data to be passed to the content handler callbacks
+ * @return EXIP_PARSING_COMPLETE at the end of the stream, otherwise error handling code
+ */
+errorCode decodeChannelEvent(EXIStream* strm, ContentHandler* handler, void* app_data);
+
+/**
+ * @brief Parser: skips the events of the decoded blocks without reporting them
+ * until the end of the current element. The values of the skipped blocks are
+ * decoded with the block as the string tables depend on them.
+ * @param[in, out] strm EXI stream
+ * @param[in] handler content handler for the errors of the skipped blocks
+ * @param[in] app_data Application data to be passed to the content handler callbacks
+ * @param[in, out] depth the number of elements left to be closed; 0 when the element is skipped
+ * @return EXIP_PARSING_COMPLETE at the end of the stream, otherwise error handling code
+ */
+errorCode skipChannelElement(EXIStream* strm, ContentHandler* handler, void* app_data, unsigned int* depth);
+
+#endif /* COMPRESSION_USE */
+
+#endif /* COMPRESSION_H_ */
@@ -23,6 +23,19 @@
 #include "sTables.h"
 #include "grammars.h"
 #include "initSchemaInstance.h"
+#include "compression.h"
+#include "streamDecode.h"
+#include "ioUtil.h"
+#include "stringManipulate.h"
+#include "dynamicArray.h"
+
+/** The states of the pull interface exipNextEvent() */
+#define PULL_STATE_START    0
+#define PULL_STATE_BODY     1
+#define PULL_STATE_COMPLETE 2
+
+/** The initial number of entries in the event queue of exipNextEvent() */
+#define DEFAULT_EVENT_QUEUE_DIM 8
 
 /**
  * The handler to be used by the applications to parse EXI streams
@@ -32,7 +45,72 @@ const EXIParser parse ={initParser,
 						setSchema,
 						parseNext,
 						pushEXIData,
-						destroyParser};
+						destroyParser,
+						enableStringArena,
+						resetParser,
+						setBinaryChunkSize,
+						exipNextEvent,
+						skipElement,
+						seekSelfContained,
+						useSelfContainedIndex};
+
+static void initParserContext(Parser* parser);
+static boolean sameProcessingOptions(EXIOptions* opts1, EXIOptions* opts2);
+static errorCode parseNextProduction(Parser* parser, ContentHandler* handler, void* app_data);
+static errorCode parseProduction(Parser* parser, ContentHandler* handler, void* app_data);
+static errorCode continueSkip(Parser* parser);
+static errorCode skipInput(EXIStream* strm);
+static errorCode relocateValueStrings(EXIStream* strm, ValueTable* valueTable);
+
+static errorCode pullEndDocument(void* app_data);
+static errorCode pullStartElement(QName qname, void* app_data);
+static errorCode pullEndElement(void* app_data);
+static errorCode pullAttribute(QName qname, void* app_data);
+static errorCode pullIntData(Integer int_val, void* app_data);
+static errorCode pullBooleanData(boolean bool_val, void* app_data);
+static errorCode pullStringData(const String str_val, void* app_data);
+static errorCode pullFloatData(Float float_val, void* app_data);
+static errorCode pullBinaryData(const char* binary_val, Index nbytes, void* app_data);
+static errorCode pullDateTimeData(EXIPDateTime dt_val, void* app_data);
+static errorCode pullDecimalData(Decimal dec_val, void* app_data);
+static errorCode pullListData(EXITypeClass exiType, unsigned int itemCount, void* app_data);
+static errorCode pullQnameData(const QName qname, void* app_data);
+static errorCode pullProcessingInstruction(void* app_data);
+static errorCode pullNamespaceDeclaration(const String ns, const String prefix, boolean isLocalElementNS, void* app_data);
+static errorCode pullWarning(const errorCode code, const char* msg, void* app_data);
+static errorCode pullError(const errorCode code, const char* msg, void* app_data);
+static errorCode pullFatalError(const errorCode code, const char* msg, void* app_data);
+static errorCode pullSelfContained(void* app_data);
+
+/**
+ * The content handler used by exipNextEvent(): the events reported by
+ * processNextProduction() are appended to the event queue of the parser
+ * passed as app_data
+ */
+static ContentHandler pullHandler = {NULL,
+									pullEndDocument,
+									pullStartElement,
+									pullEndElement,
+									pullAttribute,
+									pullIntData,
+									pullBooleanData,
+									pullStringData,
+									pullFloatData,
+									pullBinaryData,
+									NULL,
+									pullDateTimeData,
+									pullDecimalData,
+									pullListData,
+									pullQnameData,
+									pullProcessingInstruction,
+									pullNamespaceDeclaration,
+									pullWarning,
+									pullError,
+									pullFatalError,
+									pullSelfContained};
+
+/** The content handler used while skipping: none of the events is reported */
+static ContentHandler skipHandler;
 
 errorCode initParser(Parser* parser, BinaryBuffer buffer, void* app_data)
 {
@@ -40,19 +118,36 @@ errorCode initParser(Parser* parser, BinaryBuffer buffer, void* app_data)
 	TRY(initAllocList(&parser->strm.memList));
 
 	parser->strm.buffer = buffer;
-	parser->strm.context.bitPointer = 0;
-	parser->strm.context.bufferIndx = 0;
-	parser->strm.context.currAttr.lnId = 0;
-	parser->strm.context.currAttr.uriId = 0;
-	parser->strm.context.expectATData = FALSE;
-	parser->strm.context.isNilType = FALSE;
-	parser->strm.context.attrTypeId = INDEX_MAX;
+	initParserContext(parser);
 	parser->strm.gStack = NULL;
 	parser->strm.valueTable.value = NULL;
 	parser->strm.valueTable.count = 0;
 	parser->app_data = app_data;
 	parser->strm.schema = NULL;
+#if COMPRESSION_USE
+	parser->strm.channels = NULL;
+#endif
     makeDefaultOpts(&parser->strm.header.opts);
+	setDecodePrimitives(&parser->strm);
+	parser->strm.encodePrim = NULL;
+	parser->strm.valueArena = NULL;
+	parser->strm.dispatch = NULL;
+	parser->strm.prodIndex = NULL;
+	parser->strm.selfContained = NULL;
+	parser->strm.scIndex = NULL;
+	parser->strm.scGrammar = NULL;
+#if STATIC_CODEC_USE
+	parser->strm.codec = NULL;
+#endif
+	parser->strm.tablesMark.uriCount = 0;
+	parser->strm.tablesMark.uri = NULL;
+	parser->strm.binaryChunks.chunkSize = 0;
+	parser->strm.binaryChunks.delivered = 0;
+	parser->events.event = NULL;
+	parser->events.count = 0;
+	parser->events.next = 0;
+	parser->events.state = PULL_STATE_START;
+	parser->skip.active = FALSE;
 
 	initContentHandler(&parser->handler);
 
@@ -66,17 +161,43 @@ errorCode initParser(Parser* parser, BinaryBuffer buffer, void* app_data)
 errorCode parseHeader(Parser* parser, boolean outOfBandOpts)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	// After resetParser() the schema, the value table and the channels
+	// of the previous stream are kept
+	boolean isReset = parser->strm.schema != NULL;
+	EXIOptions prevOpts = parser->strm.header.opts;
+
+	if(isReset && outOfBandOpts == FALSE)
+		makeDefaultOpts(&parser->strm.header.opts);
 
-	printf("Decoding the header...\n");
 	TRY(decodeHeader(&parser->strm, outOfBandOpts));
+	setDecodePrimitives(&parser->strm);
 
-	if(parser->strm.header.opts.valuePartitionCapacity > 0)
+	if(isReset)
 	{
-		printf("Creating the Value table...\n");
-		TRY(createValueTable(&parser->strm.valueTable));
+		if(!sameProcessingOptions(&prevOpts, &parser->strm.header.opts))
+		{
+			DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> The options of a stream parsed after resetParser() must match the previous ones"));
+			return EXIP_HEADER_OPTIONS_MISMATCH;
+		}
+	}
+	else
+	{
+		if(parser->strm.header.opts.valuePartitionCapacity > 0)
+		{
+			TRY(createValueTable(&parser->strm.valueTable));
+		}
+
+		if(WITH_COMPRESSION(parser->strm.header.opts.enumOpt) || GET_ALIGNMENT(parser->strm.header.opts.enumOpt) == PRE_COMPRESSION)
+		{
+#if COMPRESSION_USE
+			TRY(createChannels(&parser->strm));
+#else
+			DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> Compression and pre-compression are disabled in this build"));
+			return EXIP_NOT_IMPLEMENTED_YET;
+#endif
+		}
 	}
 
-	printf("Starting document...\n");
 	// The parsing of the header is successful
 	// TODO: Consider removing the startDocument all together instead of invoking it always here?
 	if(parser->handler.startDocument != NULL)
@@ -179,16 +300,61 @@ errorCode setSchema(Parser* parser, EXIPSchema* schema)
 		TRY(pushGrammar(&parser->strm.gStack, emptyQNameID, &parser->strm.schema->docGrammar));
 	}
 
-	return EXIP_OK;
+	TRY(createEventCodeDispatch(&parser->strm));
+#if STATIC_CODEC_USE
+	selectStaticCodec(&parser->strm);
+#endif
+
+	return markStringTables(&parser->strm.schema->uriTable, &parser->strm.memList, &parser->strm.tablesMark);
 }
 
 errorCode parseNext(Parser* parser)
+{
+	return parseNextProduction(parser, &parser->handler, parser->app_data);
+}
+
+/**
+ * @brief Parses the next production and reports its events to handler.
+ * Used by both parseNext() and exipNextEvent().
+ */
+static errorCode parseNextProduction(Parser* parser, ContentHandler* handler, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	// The skipping was interrupted by the end of the buffer
+	if(parser->skip.active)
+	{
+		TRY(continueSkip(parser));
+	}
+
+#if COMPRESSION_USE
+	// The events are decoded block by block from the structure and value channels
+	if(parser->strm.channels != NULL)
+		tmp_err_code = decodeChannelEvent(&parser->strm, handler, app_data);
+	else
+#endif
+	tmp_err_code = parseProduction(parser, handler, app_data);
+
+	if(tmp_err_code == EXIP_OK && parser->strm.context.skipRequested)
+	{
+		parser->strm.context.skipRequested = FALSE;
+		return skipElement(parser);
+	}
+
+	return tmp_err_code;
+}
+
+/**
+ * @brief Decodes a single production outside of the compression modes.
+ * The context is restored when the end of the buffer is reached
+ */
+static errorCode parseProduction(Parser* parser, ContentHandler* handler, void* app_data)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	SmallIndex tmpNonTermID = GR_VOID_NON_TERMINAL;
 	StreamContext savedContext = parser->strm.context;
 
-	tmp_err_code = processNextProduction(&parser->strm, &tmpNonTermID, &parser->handler, parser->app_data);
+	tmp_err_code = processNextProduction(&parser->strm, &tmpNonTermID, handler, app_data);
 	if(tmp_err_code == EXIP_BUFFER_END_REACHED)
 		parser->strm.context = savedContext;
 
@@ -214,8 +380,229 @@ errorCode parseNext(Parser* parser)
 	return EXIP_OK;
 }
 
+errorCode skipElement(Parser* parser)
+{
+	if(!parser->skip.active)
+	{
+#if COMPRESSION_USE
+		// The grammar stack is at the end of the decoded block
+		if(parser->strm.channels != NULL)
+			parser->skip.parent = NULL;
+		else
+#endif
+		if(parser->strm.gStack == NULL)
+			return EXIP_PARSING_COMPLETE;
+		else
+		{
+			struct SelfContainedFrame* frame = parser->strm.selfContained;
+
+			parser->skip.parent = parser->strm.gStack->nextInStack;
+
+			// The element is self-contained and its end is in the index: the rest of
+			// its fragment is passed over, unless it is the one after seekSelfContained()
+			if(parser->strm.scIndex != NULL && frame != NULL && frame->fragment == parser->skip.parent && frame->fragment->nextInStack != NULL)
+			{
+				Index end = getSelfContainedEnd(parser->strm.scIndex, frame->offset);
+
+				if(end > parser->strm.context.bufferOffset + parser->strm.context.bufferIndx)
+				{
+					popGrammar(&parser->strm.gStack);
+					popGrammar(&parser->strm.gStack);
+					exitSelfContained(&parser->strm);
+					parser->skip.parent = parser->strm.gStack;
+					parser->strm.context.bitPointer = 0;
+					parser->strm.context.skipOffset = end;
+				}
+			}
+		}
+
+		parser->skip.active = TRUE;
+		parser->skip.depth = 1;
+		// The pulled events of the element that are not returned yet
+		parser->events.next = parser->events.count;
+	}
+
+	return continueSkip(parser);
+}
+
+/**
+ * @brief Decodes the productions of the element being skipped until its end
+ */
+static errorCode continueSkip(Parser* parser)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+#if COMPRESSION_USE
+	if(parser->strm.channels != NULL)
+		tmp_err_code = skipChannelElement(&parser->strm, &skipHandler, NULL, &parser->skip.depth);
+	else
+#endif
+	{
+		parser->strm.context.skipValues = TRUE;
+		// The element grammar is popped at its end element event
+		do
+		{
+			// The self-contained elements in the index are passed over in the input
+			if(parser->strm.context.skipOffset != 0)
+				tmp_err_code = skipInput(&parser->strm);
+			else
+				tmp_err_code = parseProduction(parser, &skipHandler, NULL);
+		}
+		while(tmp_err_code == EXIP_OK && (parser->strm.gStack != parser->skip.parent || parser->strm.context.skipOffset != 0));
+		parser->strm.context.skipValues = FALSE;
+	}
+
+	if(tmp_err_code != EXIP_BUFFER_END_REACHED)
+		parser->skip.active = FALSE;
+	if(tmp_err_code == EXIP_PARSING_COMPLETE)
+		parser->events.state = PULL_STATE_COMPLETE;
+
+	return tmp_err_code;
+}
+
+/**
+ * @brief Moves the input to the position past a skipped self-contained element,
+ * reading the input stream up to there
+ */
+static errorCode skipInput(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	while(strm->context.skipOffset - strm->context.bufferOffset > strm->buffer.bufContent)
+	{
+		strm->context.bufferIndx = strm->buffer.bufContent;
+		TRY(readEXIChunkForParsing(strm, 1));
+	}
+
+	strm->context.bufferIndx = strm->context.skipOffset - strm->context.bufferOffset;
+	strm->context.skipOffset = 0;
+
+	return EXIP_OK;
+}
+
+errorCode exipNextEvent(Parser* parser, ExipEvent* event)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEventQueue* queue = &parser->events;
+
+	if(queue->next < queue->count)
+	{
+		*event = queue->event[queue->next];
+		queue->next += 1;
+		return EXIP_OK;
+	}
+
+	if(queue->state == PULL_STATE_COMPLETE)
+		return EXIP_PARSING_COMPLETE;
+	else if(queue->state == PULL_STATE_START)
+	{
+		// The string and binary values must outlive the callbacks that report them
+		if(parser->strm.valueArena == NULL)
+		{
+			DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> enableStringArena() must be called before exipNextEvent()"));
+			return EXIP_INCONSISTENT_PROC_STATE;
+		}
+
+		if(queue->event == NULL)
+		{
+			TRY(createDynArray(&queue->dynArray, sizeof(ExipEvent), DEFAULT_EVENT_QUEUE_DIM));
+		}
+
+		queue->state = PULL_STATE_BODY;
+		event->kind = EXIP_EVENT_START_DOCUMENT;
+		event->qnameId.uriId = URI_MAX;
+		event->qnameId.lnId = LN_MAX;
+		return EXIP_OK;
+	}
+
+	queue->count = 0;
+	queue->next = 0;
+
+	// Some productions (e.g. the ones of the undeclared content) do not report any event
+	do
+	{
+		tmp_err_code = parseNextProduction(parser, &pullHandler, parser);
+		if(tmp_err_code == EXIP_PARSING_COMPLETE)
+		{
+			queue->state = PULL_STATE_COMPLETE;
+			if(queue->count == 0)
+				return EXIP_PARSING_COMPLETE;
+		}
+		else if(tmp_err_code != EXIP_OK)
+		{
+			// The production is decoded again after pushEXIData()
+			queue->count = 0;
+			return tmp_err_code;
+		}
+	}
+	while(queue->count == 0);
+
+#if COMPRESSION_USE
+	if(parser->strm.channels == NULL)
+#endif
+	{
+		// The events of a production start with its SE event, if any, and the
+		// grammar of the element is pushed by now
+		if(queue->event[0].kind == EXIP_EVENT_START_ELEMENT)
+			queue->event[0].qnameId = parser->strm.gStack->currQNameID;
+	}
+
+	*event = queue->event[0];
+	queue->next = 1;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Copies the value table strings that point into the input buffer to the
+ * value arena. Used before the content of the buffer is overwritten.
+ */
+static errorCode relocateBufferStrings(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct SelfContainedFrame* frame;
+
+	TRY(relocateValueStrings(strm, &strm->valueTable));
+
+	// The value tables of the elements enclosing the self-contained ones
+	for(frame = strm->selfContained; frame != NULL; frame = frame->previous)
+	{
+		TRY(relocateValueStrings(strm, &frame->valueTable));
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Copies the strings of a value table that point into the input buffer to the
+ * value arena; see relocateBufferStrings()
+ */
+static errorCode relocateValueStrings(EXIStream* strm, ValueTable* valueTable)
+{
+	Index i;
+	CharType* tmpStr;
+
+	for(i = 0; i < valueTable->count; i++)
+	{
+		String* valueStr = &valueTable->value[i].valueStr;
+
+		if((char*) valueStr->str >= strm->buffer.buf && (char*) valueStr->str < strm->buffer.buf + strm->buffer.bufLen)
+		{
+			tmpStr = arenaAllocate(strm->valueArena, sizeof(CharType)*valueStr->length);
+			if(tmpStr == NULL)
+				return EXIP_MEMORY_ALLOCATION_ERROR;
+
+			memcpy(tmpStr, valueStr->str, sizeof(CharType)*valueStr->length);
+			valueStr->str = tmpStr;
+		}
+	}
+
+	return EXIP_OK;
+}
+
 errorCode pushEXIData(char* inBuf, unsigned int bufSize, Parser* parser)
 {
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	Index bytesCopied = parser->strm.buffer.bufContent - parser->strm.context.bufferIndx;
 
 	if(bufSize > parser->strm.buffer.bufLen - bytesCopied)
@@ -227,17 +614,195 @@ errorCode pushEXIData(char* inBuf, unsigned int bufSize, Parser* parser)
 	if(2*bytesCopied > parser->strm.buffer.bufLen)
 		return EXIP_INCONSISTENT_PROC_STATE;
 
-	memcpy(parser->strm.buffer.buf, parser->strm.buffer.buf + parser->strm.context.bufferIndx, bytesCopied);
+	if(parser->strm.valueArena != NULL && parser->strm.valueArena->zeroCopy)
+	{
+		// The string values must not point into the buffer once it is overwritten
+		TRY(relocateBufferStrings(&parser->strm));
+		parser->strm.valueArena->zeroCopy = FALSE;
+	}
+
+	// The unparsed bytes overlap their destination when fewer bytes than them were parsed
+	memmove(parser->strm.buffer.buf, parser->strm.buffer.buf + parser->strm.context.bufferIndx, bytesCopied);
 	memcpy(parser->strm.buffer.buf + bytesCopied, inBuf, bufSize);
 
+	parser->strm.context.bufferOffset += parser->strm.context.bufferIndx;
 	parser->strm.context.bufferIndx = 0;
 	parser->strm.buffer.bufContent = bytesCopied + bufSize;
 
 	return EXIP_OK;
 }
 
+errorCode enableStringArena(Parser* parser)
+{
+	if(parser->strm.valueArena != NULL)
+		return EXIP_OK;
+
+	// The strings already in the value table are not allocated in the arena
+	if(parser->strm.valueTable.value != NULL && parser->strm.valueTable.count > 0)
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> The string arena must be enabled before any value is parsed"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	parser->strm.valueArena = memManagedAllocate(&parser->strm.memList, sizeof(StringArena));
+	if(parser->strm.valueArena == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	initStringArena(parser->strm.valueArena);
+
+	return EXIP_OK;
+}
+
+errorCode resetParser(Parser* parser, BinaryBuffer buffer)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	if(parser->strm.schema == NULL)
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> setSchema() must be called before resetParser()"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+#if COMPRESSION_USE
+	resetChannels(&parser->strm);
+#endif
+
+	while(parser->strm.gStack != NULL)
+	{
+		popGrammar(&parser->strm.gStack);
+	}
+
+	TRY(resetAllMem(&parser->strm));
+
+	// The options decoded from the header were allocated in the memList
+	if(parser->strm.header.has_options)
+		getEmptyString(&parser->strm.header.opts.schemaID);
+
+	parser->strm.buffer = buffer;
+	parser->strm.scIndex = NULL;
+	initParserContext(parser);
+	parser->strm.binaryChunks.delivered = 0;
+	parser->events.count = 0;
+	parser->events.next = 0;
+	parser->events.state = PULL_STATE_START;
+	parser->skip.active = FALSE;
+
+	{
+		QNameID emptyQNameID = {URI_MAX, LN_MAX};
+		TRY(pushGrammar(&parser->strm.gStack, emptyQNameID, &parser->strm.schema->docGrammar));
+	}
+
+	return EXIP_OK;
+}
+
+errorCode setBinaryChunkSize(Parser* parser, Index chunkSize)
+{
+	parser->strm.binaryChunks.chunkSize = chunkSize;
+	return EXIP_OK;
+}
+
+errorCode seekSelfContained(Parser* parser, Index offset)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index bufferOffset = parser->strm.context.bufferOffset;
+	Index bufContent = parser->strm.buffer.bufContent;
+
+	if(parser->strm.schema == NULL)
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> setSchema() must be called before seekSelfContained()"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	if(!WITH_SELF_CONTAINED(parser->strm.header.opts.enumOpt))
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	while(parser->strm.gStack != NULL)
+	{
+		popGrammar(&parser->strm.gStack);
+	}
+
+	TRY(resetAllMem(&parser->strm));
+
+	// The options decoded from the header were allocated in the memList
+	if(parser->strm.header.has_options)
+		getEmptyString(&parser->strm.header.opts.schemaID);
+
+	initParserContext(parser);
+	if(offset >= bufferOffset && offset - bufferOffset <= bufContent)
+	{
+		// The element starts in the content of the buffer
+		parser->strm.context.bufferOffset = bufferOffset;
+		parser->strm.context.bufferIndx = offset - bufferOffset;
+	}
+	else
+	{
+		// The application has positioned the input at the offset
+		parser->strm.buffer.bufContent = 0;
+		parser->strm.context.bufferOffset = offset;
+	}
+
+	parser->strm.binaryChunks.delivered = 0;
+	parser->events.count = 0;
+	parser->events.next = 0;
+	parser->events.state = PULL_STATE_START;
+	parser->skip.active = FALSE;
+
+	// The element is decoded as a fragment with the initial string tables
+	TRY(enterSelfContained(&parser->strm));
+	TRY(pushSelfContainedFragment(&parser->strm));
+	parser->strm.selfContained->fragment = parser->strm.gStack;
+
+	return EXIP_OK;
+}
+
+errorCode useSelfContainedIndex(Parser* parser, SelfContainedIndex* index)
+{
+	parser->strm.scIndex = index;
+	return EXIP_OK;
+}
+
+static void initParserContext(Parser* parser)
+{
+	parser->strm.context.bitPointer = 0;
+	parser->strm.context.bufferIndx = 0;
+	parser->strm.context.currAttr.lnId = 0;
+	parser->strm.context.currAttr.uriId = 0;
+	parser->strm.context.expectATData = FALSE;
+	parser->strm.context.isNilType = FALSE;
+	parser->strm.context.attrTypeId = INDEX_MAX;
+	parser->strm.context.skipValues = FALSE;
+	parser->strm.context.skipRequested = FALSE;
+	parser->strm.context.skipOffset = 0;
+	parser->strm.context.bufferOffset = 0;
+	parser->strm.context.elementCount = 0;
+}
+
+/**
+ * @brief Checks whether two sets of options process the EXI body in the same way
+ * so that the tables and the channels of one stream can be reused for the other
+ */
+static boolean sameProcessingOptions(EXIOptions* opts1, EXIOptions* opts2)
+{
+	return opts1->enumOpt == opts2->enumOpt &&
+			opts1->preserve == opts2->preserve &&
+			opts1->schemaIDMode == opts2->schemaIDMode &&
+			opts1->blockSize == opts2->blockSize &&
+			opts1->valueMaxLength == opts2->valueMaxLength &&
+			opts1->valuePartitionCapacity == opts2->valuePartitionCapacity;
+}
+
 void destroyParser(Parser* parser)
 {
+#if COMPRESSION_USE
+	destroyChannels(&parser->strm);
+#endif
+	destroyEventCodeDispatch(&parser->strm);
+	if(parser->events.event != NULL)
+	{
+		destroyDynArray(&parser->events.dynArray);
+		parser->events.event = NULL;
+	}
+
 	while(parser->strm.gStack != NULL)
 	{
 		popGrammar(&parser->strm.gStack);
@@ -245,3 +810,235 @@ void destroyParser(Parser* parser)
 
 	freeAllMem(&parser->strm);
 }
+
+/**
+ * @brief Appends an empty event of kind kind to the event queue
+ */
+static errorCode queueEvent(Parser* parser, ExipEventKind kind, ExipEvent** event)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index eventId;
+
+	TRY(addEmptyDynEntry(&parser->events.dynArray, (void**) event, &eventId));
+	(*event)->kind = kind;
+	(*event)->qnameId.uriId = URI_MAX;
+	(*event)->qnameId.lnId = LN_MAX;
+
+	return EXIP_OK;
+}
+
+static errorCode pullEndDocument(void* app_data)
+{
+	ExipEvent* event;
+	return queueEvent((Parser*) app_data, EXIP_EVENT_END_DOCUMENT, &event);
+}
+
+/**
+ * @brief Appends an event with a qname to the event queue.
+ * The qname strings are copied as the tables holding them can be
+ * extended before the event is returned
+ */
+static errorCode queueQNameEvent(Parser* parser, ExipEventKind kind, QName qname, ExipEvent** event)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	TRY(queueEvent(parser, kind, event));
+	(*event)->name.uri = *qname.uri;
+	(*event)->name.localName = *qname.localName;
+	if(qname.prefix != NULL)
+		(*event)->name.prefix = *qname.prefix;
+	else
+		getEmptyString(&(*event)->name.prefix);
+
+	return EXIP_OK;
+}
+
+static errorCode pullStartElement(QName qname, void* app_data)
+{
+	ExipEvent* event;
+	// The QNameID is set by exipNextEvent() once the grammar of the element is pushed
+	return queueQNameEvent((Parser*) app_data, EXIP_EVENT_START_ELEMENT, qname, &event);
+}
+
+static errorCode pullEndElement(void* app_data)
+{
+	ExipEvent* event;
+	return queueEvent((Parser*) app_data, EXIP_EVENT_END_ELEMENT, &event);
+}
+
+static errorCode pullAttribute(QName qname, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Parser* parser = (Parser*) app_data;
+	ExipEvent* event;
+
+	TRY(queueQNameEvent(parser, EXIP_EVENT_ATTRIBUTE, qname, &event));
+#if COMPRESSION_USE
+	// The events of a block are reported after the whole block is decoded
+	if(parser->strm.channels != NULL)
+		return EXIP_OK;
+#endif
+	event->qnameId = parser->strm.context.currAttr;
+
+	return EXIP_OK;
+}
+
+static errorCode pullIntData(Integer int_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_INT, &event));
+	event->value.intVal = int_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullBooleanData(boolean bool_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_BOOLEAN, &event));
+	event->value.boolVal = bool_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullStringData(const String str_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	// The string is in the string tables or in the string arena
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_STRING, &event));
+	event->value.strVal = str_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullFloatData(Float float_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_FLOAT, &event));
+	event->value.floatVal = float_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullBinaryData(const char* binary_val, Index nbytes, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Parser* parser = (Parser*) app_data;
+	ExipEvent* event;
+	char* data = NULL;
+
+	// The binary values are freed right after the callback
+	if(nbytes > 0)
+	{
+		data = arenaAllocate(parser->strm.valueArena, nbytes);
+		if(data == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(data, binary_val, nbytes);
+	}
+
+	TRY(queueEvent(parser, EXIP_EVENT_BINARY, &event));
+	event->value.binVal.data = data;
+	event->value.binVal.length = nbytes;
+
+	return EXIP_OK;
+}
+
+static errorCode pullDateTimeData(EXIPDateTime dt_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_DATE_TIME, &event));
+	event->value.dtVal = dt_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullDecimalData(Decimal dec_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_DECIMAL, &event));
+	event->value.decVal = dec_val;
+
+	return EXIP_OK;
+}
+
+static errorCode pullListData(EXITypeClass exiType, unsigned int itemCount, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_LIST, &event));
+	event->value.listVal.itemType = exiType;
+	event->value.listVal.itemCount = itemCount;
+
+	return EXIP_OK;
+}
+
+static errorCode pullQnameData(const QName qname, void* app_data)
+{
+	ExipEvent* event;
+	return queueQNameEvent((Parser*) app_data, EXIP_EVENT_QNAME, qname, &event);
+}
+
+static errorCode pullProcessingInstruction(void* app_data)
+{
+	ExipEvent* event;
+	return queueEvent((Parser*) app_data, EXIP_EVENT_PI, &event);
+}
+
+static errorCode pullNamespaceDeclaration(const String ns, const String prefix, boolean isLocalElementNS, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ExipEvent* event;
+
+	TRY(queueEvent((Parser*) app_data, EXIP_EVENT_NAMESPACE, &event));
+	event->value.nsVal.ns = ns;
+	event->value.nsVal.prefix = prefix;
+	event->value.nsVal.isLocalElementNS = isLocalElementNS;
+
+	return EXIP_OK;
+}
+
+static errorCode pullWarning(const errorCode code, const char* msg, void* app_data)
+{
+	Parser* parser = (Parser*) app_data;
+
+	if(parser->handler.warning != NULL)
+		return parser->handler.warning(code, msg, parser->app_data);
+	return EXIP_OK;
+}
+
+static errorCode pullError(const errorCode code, const char* msg, void* app_data)
+{
+	Parser* parser = (Parser*) app_data;
+
+	if(parser->handler.error != NULL)
+		return parser->handler.error(code, msg, parser->app_data);
+	return EXIP_OK;
+}
+
+static errorCode pullFatalError(const errorCode code, const char* msg, void* app_data)
+{
+	Parser* parser = (Parser*) app_data;
+
+	if(parser->handler.fatalError != NULL)
+		return parser->handler.fatalError(code, msg, parser->app_data);
+	return EXIP_OK;
+}
+
+static errorCode pullSelfContained(void* app_data)
+{
+	ExipEvent* event;
+	return queueEvent((Parser*) app_data, EXIP_EVENT_SELF_CONTAINED, &event);
+}
@@ -24,9 +24,11 @@
 #include "hashtable.h"
 #include "stringManipulate.h"
 #include "streamEncode.h"
+#include "streamWrite.h"
+#include "dynamicArray.h"
 #include "initSchemaInstance.h"
 #include "ioUtil.h"
-#include "streamEncode.h"
+#include "compression.h"
 
 #define ASCII_0 0x30
 #define ASCII_9 0x39
@@ -39,6 +41,8 @@ const EXISerializer serialize ={startDocument,
 								startElement,
 								endElement,
 								attribute,
+								startElementId,
+								attributeId,
 								intData,
 								booleanData,
 								stringData,
@@ -57,13 +61,23 @@ const EXISerializer serialize ={startDocument,
 								selfContained,
 								initHeader,
 								initStream,
-								closeEXIStream};
+								closeEXIStream,
+								resetStream,
+								NULL, /*flushEXIData*/
+								resolveQName,
+								setSelfContainedIndex};
+
+/** The initial number of entries in a SelfContainedIndex */
+#define DEFAULT_SC_INDEX_ENTRIES_NUMBER 16
+
+static void initStreamContext(EXIStream* strm);
+static errorCode flushStream(EXIStream* strm);
+static boolean isStringTableQNameID(EXIStream* strm, QNameID qnameId);
+static errorCode encodeStartElement(EXIStream* strm, QName* qname, QNameID qnameID, EXITypeClass* valueType);
+static errorCode encodeAttribute(EXIStream* strm, QName* qname, QNameID qnameID, boolean isSchemaType, EXITypeClass* valueType);
+static void setSelfContainedEnd(SelfContainedIndex* index, Index offset, Index end);
 
 #if EXI_PROFILE_DEFAULT
-
-extern const String XML_SCHEMA_INSTANCE;
-extern const String URI_2_LN[];
-
 static errorCode encodeATXsiType(EXIStream* strm);
 static errorCode encodeAnyType(EXIStream* strm);
 #endif
@@ -87,23 +101,43 @@ errorCode initStream(EXIStream* strm, BinaryBuffer buffer, EXIPSchema* schema)
 
 	TRY(initAllocList(&(strm->memList)));
 	strm->buffer = buffer;
-	strm->context.bitPointer = 0;
-	strm->context.bufferIndx = 0;
-	strm->context.currAttr.uriId = URI_MAX;
-	strm->context.currAttr.lnId = LN_MAX;
-	strm->context.expectATData = FALSE;
-	strm->context.isNilType = FALSE;
-	strm->context.attrTypeId = INDEX_MAX;
+	initStreamContext(strm);
 	strm->gStack = NULL;
 	strm->valueTable.value = NULL;
 	strm->valueTable.count = 0;
 	strm->schema = NULL;
+#if COMPRESSION_USE
+	strm->channels = NULL;
+#endif
+	strm->decodePrim = NULL;
+	setEncodePrimitives(strm);
+	strm->valueArena = NULL;
+	strm->dispatch = NULL;
+	strm->prodIndex = NULL;
+	strm->selfContained = NULL;
+	strm->scIndex = NULL;
+	strm->scGrammar = NULL;
+#if STATIC_CODEC_USE
+	strm->codec = NULL;
+#endif
+	strm->tablesMark.uriCount = 0;
+	strm->tablesMark.uri = NULL;
 
 	if(strm->header.opts.valuePartitionCapacity > 0)
 	{
 		TRY(createValueTable(&strm->valueTable));
 	}
 
+	if(WITH_COMPRESSION(strm->header.opts.enumOpt) || GET_ALIGNMENT(strm->header.opts.enumOpt) == PRE_COMPRESSION)
+	{
+#if COMPRESSION_USE
+		TRY(createChannels(strm));
+#else
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n> Compression and pre-compression are disabled in this build"));
+		return EXIP_NOT_IMPLEMENTED_YET;
+#endif
+	}
+
 	if(strm->header.opts.schemaIDMode == SCHEMA_ID_NIL)
 	{
 		// When the "schemaId" element in the EXI options document contains the xsi:nil attribute
@@ -198,6 +232,12 @@ errorCode initStream(EXIStream* strm, BinaryBuffer buffer, EXIPSchema* schema)
 		QNameID emptyQNameID = {URI_MAX, LN_MAX};
 		TRY(pushGrammar(&strm->gStack, emptyQNameID, &strm->schema->docGrammar));
 	}
+	TRY(markStringTables(&strm->schema->uriTable, &strm->memList, &strm->tablesMark));
+	TRY(createProductionIndex(strm));
+#if STATIC_CODEC_USE
+	selectStaticCodec(strm);
+#endif
+
 	// #DOCUMENT#
 	// Hashtable for fast look-up of global values in the table.
 	// Only used when:
@@ -209,7 +249,7 @@ errorCode initStream(EXIStream* strm, BinaryBuffer buffer, EXIPSchema* schema)
 	if(strm->header.opts.valuePartitionCapacity > DEFAULT_VALUE_ENTRIES_NUMBER &&
 			strm->header.opts.valueMaxLength > 0)
 	{
-		strm->valueTable.hashTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+		strm->valueTable.hashTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 		if(strm->valueTable.hashTbl == NULL)
 			return EXIP_HASH_TABLE_ERROR;
 	}
@@ -219,6 +259,31 @@ errorCode initStream(EXIStream* strm, BinaryBuffer buffer, EXIPSchema* schema)
 	return EXIP_OK;
 }
 
+errorCode resolveQName(EXIPSchema* schema, QName qname, QNameID* qnameId)
+{
+	assert(schema != NULL);
+	assert(qname.uri != NULL);
+	assert(qname.localName != NULL);
+
+	if(!lookupUri(&schema->uriTable, *qname.uri, &qnameId->uriId) ||
+			!lookupLn(&schema->uriTable.uri[qnameId->uriId].lnTable, *qname.localName, &qnameId->lnId))
+	{
+		DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, (">The QName is not in the string tables of the schema\n"));
+		return EXIP_INVALID_EXIP_CONFIGURATION;
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Checks that a QNameID passed to the serializer refers to string table entries
+ */
+static boolean isStringTableQNameID(EXIStream* strm, QNameID qnameId)
+{
+	return qnameId.uriId < strm->schema->uriTable.count &&
+			qnameId.lnId < strm->schema->uriTable.uri[qnameId.uriId].lnTable.count;
+}
+
 errorCode startDocument(EXIStream* strm)
 {
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, (">Start doc serialization\n"));
@@ -226,6 +291,11 @@ errorCode startDocument(EXIStream* strm)
 	if(strm->gStack->grammar == NULL && strm->gStack->currNonTermID != GR_DOC_CONTENT)
 		return EXIP_INCONSISTENT_PROC_STATE;
 
+#if COMPRESSION_USE
+	if(strm->channels != NULL)
+		return beginChannelBlock(strm);
+#endif
+
 	return EXIP_OK;
 }
 
@@ -238,21 +308,65 @@ errorCode endDocument(EXIStream* strm)
 	if(strm->gStack->grammar == NULL)
 		return EXIP_INCONSISTENT_PROC_STATE;
 
-	tmp_err_code = encodeProduction(strm, EVENT_ED_CLASS, TRUE, NULL, VALUE_TYPE_NONE_CLASS, &prodHit);
+	TRY(encodeProduction(strm, EVENT_ED_CLASS, TRUE, NULL, VALUE_TYPE_NONE_CLASS, &prodHit));
+
+#if COMPRESSION_USE
+	if(strm->channels != NULL)
+	{
+		TRY(closeChannelBlock(strm));
+	}
+#endif
 
 	// Store the size of the encoded stream contained in the BinaryBuffer in the BinaryBuffer.bufContent
 	strm->buffer.bufContent = strm->context.bufferIndx + (strm->context.bitPointer > 0);
 
-	return tmp_err_code;
+	return EXIP_OK;
 }
 
 errorCode startElement(EXIStream* strm, QName qname, EXITypeClass* valueType)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
-	Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
+	QNameID qnameID = {URI_MAX, LN_MAX};
 
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start element serialization\n"));
 
+	TRY(encodeStartElement(strm, &qname, qnameID, valueType));
+	strm->context.elementCount += 1;
+
+	return EXIP_OK;
+}
+
+errorCode startElementId(EXIStream* strm, QNameID qnameId, EXITypeClass* valueType)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start element serialization by QName ID\n"));
+
+	if(!isStringTableQNameID(strm, qnameId))
+		return EXIP_INVALID_EXIP_CONFIGURATION;
+
+	TRY(encodeStartElement(strm, NULL, qnameId, valueType));
+	strm->context.elementCount += 1;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Encodes the start of an element given with its QName or its QName IDs
+ * @param[in, out] strm EXI stream object
+ * @param[in] qname qualified name of the element; NULL if given by qnameID
+ * @param[in] qnameID the QName IDs in the string tables when qname is NULL
+ * @param[out] valueType see startElement()
+ * @return Error handling code
+ */
+static errorCode encodeStartElement(EXIStream* strm, QName* qname, QNameID qnameID, EXITypeClass* valueType)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
+
+	if(qname != NULL)
+		resolveQNameID(strm, qname, &qnameID);
+
 	if(strm->gStack->grammar == NULL)
 #if EXI_PROFILE_DEFAULT
 	{
@@ -267,14 +381,21 @@ errorCode startElement(EXIStream* strm, QName qname, EXITypeClass* valueType)
 
 	*valueType = VALUE_TYPE_NONE_CLASS;
 
-	TRY(encodeProduction(strm, EVENT_SE_CLASS, TRUE, &qname, VALUE_TYPE_NONE_CLASS, &prodHit));
+	TRY(encodeProduction(strm, EVENT_SE_CLASS, TRUE, &qnameID, VALUE_TYPE_NONE_CLASS, &prodHit));
 
 	if(GET_PROD_EXI_EVENT(prodHit.content) == EVENT_SE_ALL)
 	{
 		EXIGrammar* elemGrammar = NULL;
-		QNameID tmpQid;
+		QNameID tmpQid = qnameID;
 
-		TRY(encodeQName(strm, qname, EVENT_SE_ALL, &tmpQid));
+		if(qnameID.lnId != LN_MAX)
+		{
+			TRY(encodeQNameID(strm, qname, qnameID, EVENT_SE_ALL));
+		}
+		else
+		{
+			TRY(encodeQName(strm, *qname, EVENT_SE_ALL, &tmpQid));
+		}
 
 		// New element grammar is pushed on the stack
 #if EXI_PROFILE_DEFAULT
@@ -318,7 +439,7 @@ errorCode startElement(EXIStream* strm, QName qname, EXITypeClass* valueType)
 	{
 		EXIGrammar* elemGrammar = NULL;
 
-		TRY(encodePfxQName(strm, &qname, EVENT_SE_QNAME, prodHit.qnameId.uriId));
+		TRY(encodePfxQName(strm, qname, EVENT_SE_QNAME, prodHit.qnameId.uriId));
 
 		// New element grammar is pushed on the stack
 		if(IS_BUILT_IN_ELEM(strm->gStack->grammar->props))  // If the current grammar is build-in Element grammar ...
@@ -382,25 +503,98 @@ errorCode endElement(EXIStream* strm)
 	else
 		return EXIP_INCONSISTENT_PROC_STATE;
 
+	if(strm->selfContained != NULL && strm->gStack == strm->selfContained->fragment)
+	{
+		// End of a self-contained element: ED, the last production of its fragment
+		Index prodCount = getSelfContainedEndCount(strm->gStack->grammar);
+
+		TRY(encodeNBitUnsignedInteger(strm, getBitsFirstPartCode(strm, prodCount, GR_FRAGMENT_CONTENT), prodCount - 1));
+		if(strm->context.bitPointer != 0)
+		{
+			TRY(writeNBits(strm, 8 - strm->context.bitPointer, 0));
+		}
+
+		if(strm->scIndex != NULL)
+			setSelfContainedEnd(strm->scIndex, strm->selfContained->offset, strm->context.bufferOffset + strm->context.bufferIndx);
+
+		exitSelfContained(strm);
+		// The productions of the dropped grammars are indexed
+		clearProductionIndex(strm);
+		popGrammar(&(strm->gStack));
+	}
+
 	return EXIP_OK;
 }
 
 errorCode attribute(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeClass* valueType)
 {
-	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
-	Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
+	QNameID qnameID = {URI_MAX, LN_MAX};
 
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start attribute serialization\n"));
 
 	assert(qname.uri != NULL);
 	assert(qname.localName != NULL);
 
+	// Check for trying to represent namespace declarations with AT event
+	// Only in debug mode!
+	// See EXI errata about namespace declarations - http://www.w3.org/XML/EXI/exi-10-errata
+#if EXIP_DEBUG == ON && EXIP_DEBUG_LEVEL == WARNING
+	{
+		String ln = *qname.localName;
+
+		if(!stringEqualToAscii(*qname.uri, "http://www.w3.org/2000/xmlns/"))
+		{
+			DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Trying to represent namespace declarations with AT event\n"));
+			return EXIP_INVALID_EXI_INPUT;
+		}
+
+		if(ln.length != 0)
+		{
+			ln.length = 5;
+			if(!stringEqualToAscii(ln, "xmlns"))
+			{
+				DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Trying to represent namespace declarations with AT event\n"));
+				return EXIP_INVALID_EXI_INPUT;
+			}
+		}
+	}
+#endif
+
+	return encodeAttribute(strm, &qname, qnameID, isSchemaType, valueType);
+}
+
+errorCode attributeId(EXIStream* strm, QNameID qnameId, boolean isSchemaType, EXITypeClass* valueType)
+{
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start attribute serialization by QName ID\n"));
+
+	if(!isStringTableQNameID(strm, qnameId))
+		return EXIP_INVALID_EXIP_CONFIGURATION;
+
+	return encodeAttribute(strm, NULL, qnameId, isSchemaType, valueType);
+}
+
+/**
+ * @brief Encodes the start of an attribute given with its QName or its QName IDs
+ * @param[in, out] strm EXI stream object
+ * @param[in] qname qualified name of the attribute; NULL if given by qnameID
+ * @param[in] qnameID the QName IDs in the string tables when qname is NULL
+ * @param[in] isSchemaType see attribute()
+ * @param[out] valueType see attribute()
+ * @return Error handling code
+ */
+static errorCode encodeAttribute(EXIStream* strm, QName* qname, QNameID qnameID, boolean isSchemaType, EXITypeClass* valueType)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
+
+	if(qname != NULL)
+		resolveQNameID(strm, qname, &qnameID);
+
 	if(strm->gStack->grammar == NULL)
 #if EXI_PROFILE_DEFAULT
 	{
 		// if qname == xsi:type
-		if(stringEqual(*qname.uri, XML_SCHEMA_INSTANCE) &&
-				stringEqual(*qname.localName, URI_2_LN[XML_SCHEMA_INSTANCE_TYPE_ID]))
+		if(qnameID.uriId == XML_SCHEMA_INSTANCE_ID && qnameID.lnId == XML_SCHEMA_INSTANCE_TYPE_ID)
 		{
 			// Encode the xsi:type and wait for a QName type serialization;
 			// Leave the current grammar NULL
@@ -425,32 +619,7 @@ errorCode attribute(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeC
 	}
 #endif
 
-	// Check for trying to represent namespace declarations with AT event
-	// Only in debug mode!
-	// See EXI errata about namespace declarations - http://www.w3.org/XML/EXI/exi-10-errata
-#if EXIP_DEBUG == ON && EXIP_DEBUG_LEVEL == WARNING
-	{
-		String ln = *qname.localName;
-
-		if(!stringEqualToAscii(*qname.uri, "http://www.w3.org/2000/xmlns/"))
-		{
-			DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Trying to represent namespace declarations with AT event\n"));
-			return EXIP_INVALID_EXI_INPUT;
-		}
-
-		if(ln.length != 0)
-		{
-			ln.length = 5;
-			if(!stringEqualToAscii(ln, "xmlns"))
-			{
-				DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Trying to represent namespace declarations with AT event\n"));
-				return EXIP_INVALID_EXI_INPUT;
-			}
-		}
-	}
-#endif
-
-	TRY(encodeProduction(strm, EVENT_AT_CLASS, isSchemaType, &qname, VALUE_TYPE_NONE_CLASS, &prodHit));
+	TRY(encodeProduction(strm, EVENT_AT_CLASS, isSchemaType, &qnameID, VALUE_TYPE_NONE_CLASS, &prodHit));
 
 	if(prodHit.typeId == INDEX_MAX)
 		*valueType = VALUE_TYPE_NONE_CLASS;
@@ -459,7 +628,15 @@ errorCode attribute(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeC
 
 	if(GET_PROD_EXI_EVENT(prodHit.content) == EVENT_AT_ALL)
 	{
-		TRY(encodeQName(strm, qname, EVENT_AT_ALL, &strm->context.currAttr));
+		if(qnameID.lnId != LN_MAX)
+		{
+			strm->context.currAttr = qnameID;
+			TRY(encodeQNameID(strm, qname, qnameID, EVENT_AT_ALL));
+		}
+		else
+		{
+			TRY(encodeQName(strm, *qname, EVENT_AT_ALL, &strm->context.currAttr));
+		}
 
 		if(IS_SCHEMA(strm->gStack->grammar->props) && strm->context.currAttr.uriId == XML_SCHEMA_INSTANCE_ID &&
 				(strm->context.currAttr.uriId == XML_SCHEMA_INSTANCE_TYPE_ID || strm->context.currAttr.uriId == XML_SCHEMA_INSTANCE_NIL_ID))
@@ -473,7 +650,7 @@ errorCode attribute(EXIStream* strm, QName qname, boolean isSchemaType, EXITypeC
 		strm->context.currAttr.uriId = prodHit.qnameId.uriId;
 		strm->context.currAttr.lnId = prodHit.qnameId.lnId;
 
-		TRY(encodePfxQName(strm, &qname, EVENT_AT_QNAME, prodHit.qnameId.uriId));
+		TRY(encodePfxQName(strm, qname, EVENT_AT_QNAME, prodHit.qnameId.uriId));
 	}
 	else
 		return EXIP_NOT_IMPLEMENTED_YET;
@@ -513,6 +690,15 @@ errorCode intData(EXIStream* strm, Integer int_val)
 		intTypeId = prodHit.typeId;
 	}
 
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
+	{
+		ChannelData data;
+		data.intVal = int_val;
+		return deferValueItem(strm, VALUE_TYPE_INTEGER_CLASS, &data, qnameID, intTypeId);
+	}
+#endif
+
 	return encodeIntData(strm, int_val, qnameID, intTypeId);
 }
 
@@ -521,7 +707,6 @@ errorCode booleanData(EXIStream* strm, boolean bool_val)
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	boolean isXsiNilAttr = FALSE;
 	Index booleanTypeId;
-	EXIType exiType;
 	QNameID qnameID;
 
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start boolean data serialization\n"));
@@ -549,36 +734,16 @@ errorCode booleanData(EXIStream* strm, boolean bool_val)
 		qnameID = strm->gStack->currQNameID;
 	}
 
-	if(booleanTypeId != INDEX_MAX)
-		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[booleanTypeId].content);
-	else
-		exiType = VALUE_TYPE_NONE;
-
-	if(exiType == VALUE_TYPE_BOOLEAN)
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
 	{
-		TRY(encodeBoolean(strm, bool_val));
+		ChannelData data;
+		data.boolVal = bool_val;
+		return deferValueItem(strm, VALUE_TYPE_BOOLEAN_CLASS, &data, qnameID, booleanTypeId);
 	}
-	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
-	{
-		//       1) Print Warning
-		//       2) convert the boolean to sting
-		//       3) encode string
-		String tmpStr;
-
-		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Boolean to String conversion required \n"));
-#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
-		TRY(booleanToString(bool_val, &tmpStr));
-		TRY(encodeStringData(strm, tmpStr, qnameID, booleanTypeId));
-		EXIP_MFREE(tmpStr.str);
-#else
-		return EXIP_INVALID_EXI_INPUT;
 #endif
-	}
-	else
-	{
-	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a boolean\n"));
-		return EXIP_INCONSISTENT_PROC_STATE;
-	}
+
+	TRY(encodeBooleanData(strm, bool_val, qnameID, booleanTypeId));
 
 	if(IS_SCHEMA(strm->gStack->grammar->props) && isXsiNilAttr && bool_val)
 	{
@@ -634,6 +799,14 @@ errorCode stringData(EXIStream* strm, const String str_val)
 
 	if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
 	{
+#if COMPRESSION_USE
+		if(IS_CHANNEL_VALUE(strm, qnameID))
+		{
+			ChannelData data;
+			data.strVal = str_val;
+			return deferValueItem(strm, VALUE_TYPE_STRING_CLASS, &data, qnameID, typeId);
+		}
+#endif
 		return encodeStringData(strm, str_val, qnameID, typeId);
 	}
 	else
@@ -645,10 +818,8 @@ errorCode stringData(EXIStream* strm, const String str_val)
 
 errorCode floatData(EXIStream* strm, Float float_val)
 {
-	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	Index typeId;
 	QNameID qnameID;
-	EXIType exiType;
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start float data serialization\n"));
 
 	if(strm->gStack->grammar == NULL)
@@ -670,43 +841,22 @@ errorCode floatData(EXIStream* strm, Float float_val)
 		typeId = prodHit.typeId;
 	}
 
-	if(typeId != INDEX_MAX)
-		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
-	else
-		exiType = VALUE_TYPE_NONE;
-
-	if(exiType == VALUE_TYPE_FLOAT)
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
 	{
-		return encodeFloatValue(strm, float_val);
+		ChannelData data;
+		data.floatVal = float_val;
+		return deferValueItem(strm, VALUE_TYPE_FLOAT_CLASS, &data, qnameID, typeId);
 	}
-	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
-	{
-		//       1) Print Warning
-		//       2) convert the float to sting
-		//       3) encode string
-		String tmpStr;
-
-		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Float to String conversion required \n"));
-#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
-		TRY(floatToString(float_val, &tmpStr));
-		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
-		EXIP_MFREE(tmpStr.str);
-#else
-		return EXIP_INVALID_EXI_INPUT;
 #endif
-	}
-	else
-	{
-	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a float\n"));
-		return EXIP_INCONSISTENT_PROC_STATE;
-	}
 
-	return EXIP_OK;
+	return encodeFloatData(strm, float_val, qnameID, typeId);
 }
 
 errorCode binaryData(EXIStream* strm, const char* binary_val, Index nbytes)
 {
 	Index typeId;
+	QNameID qnameID;
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start binary data serialization\n"));
 
 	if(strm->gStack->grammar == NULL)
@@ -716,6 +866,7 @@ errorCode binaryData(EXIStream* strm, const char* binary_val, Index nbytes)
 	{
 		strm->context.expectATData -= 1;
 		typeId = strm->context.attrTypeId;
+		qnameID = strm->context.currAttr;
 	}
 	else
 	{
@@ -724,6 +875,7 @@ errorCode binaryData(EXIStream* strm, const char* binary_val, Index nbytes)
 
 		TRY(encodeProduction(strm, EVENT_CH_CLASS, TRUE, NULL, VALUE_TYPE_BINARY_CLASS, &prodHit));
 		typeId = prodHit.typeId;
+		qnameID = strm->gStack->currQNameID;
 	}
 
 	if(typeId == INDEX_MAX || GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content) != VALUE_TYPE_BINARY)
@@ -733,15 +885,23 @@ errorCode binaryData(EXIStream* strm, const char* binary_val, Index nbytes)
 		return EXIP_INCONSISTENT_PROC_STATE;
 	}
 
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
+	{
+		ChannelData data;
+		data.binVal.buf = (char*) binary_val;
+		data.binVal.len = nbytes;
+		return deferValueItem(strm, VALUE_TYPE_BINARY_CLASS, &data, qnameID, typeId);
+	}
+#endif
+
 	return encodeBinary(strm, (char *)binary_val, nbytes);
 }
 
 errorCode dateTimeData(EXIStream* strm, EXIPDateTime dt_val)
 {
-	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	Index typeId;
 	QNameID qnameID;
-	EXIType exiType;
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start dateTime data serialization\n"));
 
 	if(strm->gStack->grammar == NULL)
@@ -767,46 +927,22 @@ errorCode dateTimeData(EXIStream* strm, EXIPDateTime dt_val)
 		qnameID = strm->gStack->currQNameID;
 	}
 
-	if(typeId != INDEX_MAX)
-		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
-	else
-		exiType = VALUE_TYPE_NONE;
-
-	if(GET_EVENT_CLASS(exiType) == VALUE_TYPE_DATE_TIME_CLASS)
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
 	{
-		return encodeDateTimeValue(strm, exiType, dt_val);
+		ChannelData data;
+		data.dtVal = dt_val;
+		return deferValueItem(strm, VALUE_TYPE_DATE_TIME_CLASS, &data, qnameID, typeId);
 	}
-	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
-	{
-		//       1) Print Warning
-		//       2) convert the dateTime to sting
-		//       3) encode string
-		String tmpStr;
-
-		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>DateTime to String conversion required \n"));
-#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
-		TRY(dateTimeToString(dt_val, &tmpStr));
-		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
-		EXIP_MFREE(tmpStr.str);
-#else
-		return EXIP_INVALID_EXI_INPUT;
 #endif
-	}
-	else
-	{
-	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a dateTime\n"));
-		return EXIP_INCONSISTENT_PROC_STATE;
-	}
 
-	return EXIP_OK;
+	return encodeDateTimeData(strm, dt_val, qnameID, typeId);
 }
 
 errorCode decimalData(EXIStream* strm, Decimal dec_val)
 {
-	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	Index typeId;
 	QNameID qnameID;
-	EXIType exiType;
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start decimal data serialization\n"));
 
 	if(strm->gStack->grammar == NULL)
@@ -828,43 +964,22 @@ errorCode decimalData(EXIStream* strm, Decimal dec_val)
 		typeId = prodHit.typeId;
 	}
 
-	if(typeId != INDEX_MAX)
-		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
-	else
-		exiType = VALUE_TYPE_NONE;
-
-	if(exiType == VALUE_TYPE_DECIMAL)
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
 	{
-		return encodeDecimalValue(strm, dec_val);
+		ChannelData data;
+		data.decVal = dec_val;
+		return deferValueItem(strm, VALUE_TYPE_DECIMAL_CLASS, &data, qnameID, typeId);
 	}
-	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
-	{
-		//       1) Print Warning
-		//       2) convert the float to sting
-		//       3) encode string
-		String tmpStr;
-
-		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Decimal to String conversion required \n"));
-#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
-		TRY(decimalToString(dec_val, &tmpStr));
-		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
-		EXIP_MFREE(tmpStr.str);
-#else
-		return EXIP_INVALID_EXI_INPUT;
 #endif
-	}
-	else
-	{
-	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a decimal\n"));
-		return EXIP_INCONSISTENT_PROC_STATE;
-	}
 
-	return EXIP_OK;
+	return encodeDecimalData(strm, dec_val, qnameID, typeId);
 }
 
 errorCode listData(EXIStream* strm, unsigned int itemCount)
 {
 	Index typeId;
+	QNameID qnameID;
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Start list data serialization\n"));
 
 	if(strm->gStack->grammar == NULL)
@@ -874,6 +989,7 @@ errorCode listData(EXIStream* strm, unsigned int itemCount)
 	{
 		strm->context.expectATData -= 1;
 		typeId = strm->context.attrTypeId;
+		qnameID = strm->context.currAttr;
 
 		// TODO: is it allowed to have list with elements lists??? To be checked...
 	}
@@ -883,11 +999,27 @@ errorCode listData(EXIStream* strm, unsigned int itemCount)
 		Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
 
 		TRY(encodeProduction(strm, EVENT_CH_CLASS, TRUE, NULL, VALUE_TYPE_LIST_CLASS, &prodHit));
+		typeId = prodHit.typeId;
+		qnameID = strm->gStack->currQNameID;
 	}
 
+	if(typeId == INDEX_MAX)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	// The list items are serialized as attribute values of the list qname
 	strm->context.expectATData = itemCount;
+	strm->context.currAttr = qnameID;
  	strm->context.attrTypeId = strm->schema->simpleTypeTable.sType[typeId].length; // The actual type of the list items
 
+#if COMPRESSION_USE
+	if(IS_CHANNEL_VALUE(strm, qnameID))
+	{
+		ChannelData data;
+		data.itemCount = itemCount;
+		return deferValueItem(strm, VALUE_TYPE_LIST_CLASS, &data, qnameID, typeId);
+	}
+#endif
+
 	return encodeUnsignedInteger(strm, (UnsignedInteger) itemCount);
 }
 
@@ -1014,30 +1146,197 @@ errorCode entityReference(EXIStream* strm, const String reference)
 
 errorCode selfContained(EXIStream* strm)
 {
-	return EXIP_NOT_IMPLEMENTED_YET;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Production prodHit = {0, INDEX_MAX, {URI_MAX, LN_MAX}};
+	EXIGrammarStack* element = strm->gStack;
+	QNameID emptyQNameID = {URI_MAX, LN_MAX};
+	EXITypeClass valueType;
+	QName qname;
+	Index code;
+
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, (">SC event serialization\n"));
+
+	if(!WITH_SELF_CONTAINED(strm->header.opts.enumOpt) || element == NULL || element->grammar == NULL || element->nextInStack == NULL)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	qname.uri = &strm->schema->uriTable.uri[element->currQNameID.uriId].uriStr;
+	qname.localName = &GET_LN_URI_QNAME(strm->schema->uriTable, element->currQNameID).lnStr;
+	qname.prefix = NULL;
+
+	TRY(encodeProduction(strm, EVENT_SC_CLASS, TRUE, NULL, VALUE_TYPE_NONE_CLASS, &prodHit));
+
+	// Padding bits
+	if(strm->context.bitPointer != 0)
+	{
+		TRY(writeNBits(strm, 8 - strm->context.bitPointer, 0));
+	}
+
+	if(strm->scIndex != NULL)
+	{
+		SelfContainedIndexEntry* entry;
+		Index entryId;
+
+		TRY(addEmptyDynEntry(&strm->scIndex->dynArray, (void**) &entry, &entryId));
+		entry->element = strm->context.elementCount - 1;
+		entry->offset = strm->context.bufferOffset + strm->context.bufferIndx;
+		entry->end = 0;
+	}
+
+	// The element is encoded again as the content of a fragment with the initial string tables
+	TRY(enterSelfContained(strm));
+	clearProductionIndex(strm);
+	TRY(pushSelfContainedFragment(strm));
+
+	code = getSelfContainedCode(strm, element->currQNameID, element->grammar);
+	if(code != INDEX_MAX)
+	{
+		// SE (qname) of the declaration of the element
+		EventCode ec;
+
+		ec.length = 1;
+		ec.part[0] = code;
+		ec.bits[0] = getBitsFirstPartCode(strm, strm->gStack->grammar->rule[GR_FRAGMENT_CONTENT].pCount, GR_FRAGMENT_CONTENT);
+		TRY(writeEventCode(strm, ec));
+		TRY(encodePfxQName(strm, &qname, EVENT_SE_QNAME, element->currQNameID.uriId));
+		strm->gStack->currNonTermID = GR_SC_FRAGMENT_END;
+		TRY(pushGrammar(&strm->gStack, element->currQNameID, element->grammar));
+	}
+	else
+	{
+		TRY(encodeStartElement(strm, &qname, emptyQNameID, &valueType));
+	}
+
+	// The fragment takes the place of the element in the grammar stack
+	strm->gStack->nextInStack->nextInStack = element->nextInStack;
+	strm->selfContained->fragment = strm->gStack->nextInStack;
+	EXIP_MFREE(element);
+
+	return EXIP_OK;
+}
+
+errorCode setSelfContainedIndex(EXIStream* strm, SelfContainedIndex* index)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	TRY(createDynArray(&index->dynArray, sizeof(SelfContainedIndexEntry), DEFAULT_SC_INDEX_ENTRIES_NUMBER));
+	strm->scIndex = index;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Records the end of the self-contained element whose content starts at offset.
+ * The elements nested in it are indexed after it, so its entry is searched from the last one
+ */
+static void setSelfContainedEnd(SelfContainedIndex* index, Index offset, Index end)
+{
+	Index i = index->count;
+
+	while(i > 0)
+	{
+		i--;
+		if(index->entry[i].offset == offset)
+		{
+			index->entry[i].end = end;
+			return;
+		}
+	}
+}
+
+void destroySelfContainedIndex(SelfContainedIndex* index)
+{
+	destroyDynArray(&index->dynArray);
 }
 
 errorCode closeEXIStream(EXIStream* strm)
 {
 	errorCode tmp_err_code = EXIP_OK;
 
+#if COMPRESSION_USE
+	// Restores the output buffer if closed in the middle of a block
+	destroyChannels(strm);
+#endif
+
 	while(strm->gStack != NULL)
 	{
 		popGrammar(&strm->gStack);
 	}
 
+	tmp_err_code = flushStream(strm);
+
+	destroyProductionIndex(strm);
+	freeAllMem(strm);
+	return tmp_err_code;
+}
+
+errorCode resetStream(EXIStream* strm, BinaryBuffer buffer)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	errorCode flush_err_code;
+
+	if(strm->schema == NULL)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+#if COMPRESSION_USE
+	// Restores the output buffer if reset in the middle of a block
+	resetChannels(strm);
+#endif
+
+	while(strm->gStack != NULL)
+	{
+		popGrammar(&strm->gStack);
+	}
+
+	flush_err_code = flushStream(strm);
+
+	TRY(resetAllMem(strm));
+	// The built-in grammars and the string table entries of the stream are freed
+	clearProductionIndex(strm);
+
+	strm->buffer = buffer;
+	strm->scIndex = NULL;
+	initStreamContext(strm);
+
+	{
+		QNameID emptyQNameID = {URI_MAX, LN_MAX};
+		TRY(pushGrammar(&strm->gStack, emptyQNameID, &strm->schema->docGrammar));
+	}
+
+	return flush_err_code;
+}
+
+static void initStreamContext(EXIStream* strm)
+{
+	strm->context.bitPointer = 0;
+	strm->context.bufferIndx = 0;
+	strm->context.currAttr.uriId = URI_MAX;
+	strm->context.currAttr.lnId = LN_MAX;
+	strm->context.expectATData = FALSE;
+	strm->context.isNilType = FALSE;
+	strm->context.attrTypeId = INDEX_MAX;
+	strm->context.skipValues = FALSE;
+	strm->context.skipRequested = FALSE;
+	strm->context.skipOffset = 0;
+	strm->context.bufferOffset = 0;
+	strm->context.elementCount = 0;
+}
+
+/**
+ * @brief Writes the content of the buffer to the output stream, if any
+ */
+static errorCode flushStream(EXIStream* strm)
+{
 	// Flush the buffer first if there is an output Stream
 	if(strm->buffer.ioStrm.readWriteToStream != NULL || strm->buffer.bufStrm.buf != NULL)
 	{
 		Index numBytesWritten = 0;
 		writeToStream(&(strm->buffer), 0, strm->context.bufferIndx + 1, &numBytesWritten);
 		if(numBytesWritten < strm->context.bufferIndx + 1) {
-			tmp_err_code = EXIP_BUFFER_END_REACHED;
+			return EXIP_BUFFER_END_REACHED;
 		}
 	}
 
-	freeAllMem(strm);
-	return tmp_err_code;
+	return EXIP_OK;
 }
 
 errorCode flushEXIData(EXIStream* strm, char* outBuf, unsigned int bufSize, unsigned int* bytesFlush)
@@ -1052,6 +1351,7 @@ errorCode flushEXIData(EXIStream* strm, char* outBuf, unsigned int bufSize, unsi
 	memcpy(outBuf, strm->buffer.buf, strm->context.bufferIndx);
 
 	strm->buffer.buf[0] = leftOverBits;
+	strm->context.bufferOffset += strm->context.bufferIndx;
 	strm->context.bufferIndx = 0;
 
 	*bytesFlush = strm->context.bufferIndx;
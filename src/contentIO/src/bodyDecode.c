@@ -22,11 +22,24 @@
 #include "grammars.h"
 #include "dynamicArray.h"
 #include "stringManipulate.h"
+#include "compression.h"
 
 
-static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRule, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data);
+static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRule, RuleDispatch* ruleDispatch, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data);
+static RuleDispatch* getRuleDispatch(EXIStream* strm);
+static boolean isContent2Rule(EXIGrammar* grammar, SmallIndex nonTermID);
+static void fillSecondLevelCodes(const boolean* available, unsigned int eventCount, SecondLevelCodes* codes);
+static void getBuiltInSecondLevel(EXIStream* strm, boolean startTag, SecondLevelCodes* codes);
+static void getSchemaSecondLevel(EXIStream* strm, EXIGrammar* grammar, SmallIndex nonTermID, GrammarRule* rule, SecondLevelCodes* codes);
+static errorCode decodeSecondLevelEvent(EXIStream* strm, const SecondLevelCodes* codes, unsigned int* event);
 static errorCode handleProduction(EXIStream* strm, Production* prodHit, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data);
 static errorCode decodeQNameValue(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data);
+static errorCode decodeBinaryChunks(EXIStream* strm, ContentHandler* handler, void* app_data);
+static errorCode decodeSelfContained(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data);
+static errorCode decodeSelfContainedEnd(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data);
+
+/** The content handler of the fragment SE of the self-contained elements, reported before their SC event */
+static ContentHandler silentHandler;
 
 errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data)
 {
@@ -36,6 +49,12 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 	GrammarRule* currentRule;
 	Index prodCount;
 	SmallIndex currNonTermID = strm->gStack->currNonTermID;
+	RuleDispatch* ruleDispatch;
+
+	// The self-contained element is over: only the ED of its fragment is left
+	if(currNonTermID == GR_SC_FRAGMENT_END && strm->selfContained != NULL &&
+			strm->gStack == strm->selfContained->fragment)
+		return decodeSelfContainedEnd(strm, handler, nonTermID_out, app_data);
 
 	// TODO: GR_CONTENT_2 is only needed when schema deviations are allowed.
 	//       Here and in many other places when schema deviations are fully disabled
@@ -46,7 +65,7 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 
 	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("\n>Next production non-term-id: %u\n", (unsigned int) currNonTermID));
 
-	if(currNonTermID >=  strm->gStack->grammar->count)
+	if(currNonTermID >=  strm->gStack->grammar->count || strm->dispatch == NULL)
 		return EXIP_INCONSISTENT_PROC_STATE;
 
 #if BUILD_IN_GRAMMARS_USE
@@ -56,6 +75,8 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 #endif
 		currentRule = &strm->gStack->grammar->rule[currNonTermID];
 
+	ruleDispatch = getRuleDispatch(strm);
+
 #if DEBUG_CONTENT_IO == ON
 	TRY(printGrammarRule(currNonTermID, currentRule, strm->schema));
 #endif
@@ -68,8 +89,7 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 		if(currNonTermID >= GET_CONTENT_INDEX(strm->gStack->grammar->props))
 		{
 			// Instead of content we have a single EE production in the emptyType grammars
-			prodCount = 1;
-			bitCount = getBitsFirstPartCode(strm, prodCount, currNonTermID);
+			bitCount = ruleDispatch->nilFirstBits;
 			if(bitCount > 0)
 				TRY(decodeNBitUnsignedInteger(strm, bitCount, &tmp_bits_val));
 			strm->context.isNilType = FALSE;
@@ -82,7 +102,29 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 		}
 	}
 
-	bitCount = getBitsFirstPartCode(strm, prodCount, currNonTermID);
+#if STATIC_CODEC_USE
+	if(prodCount > 0 && strm->context.isNilType == FALSE)
+	{
+		const StaticGrammarCodec* grammarCodec = getStaticGrammarCodec(strm, strm->gStack->grammar);
+
+		if(grammarCodec != NULL)
+		{
+			// The generated code reads the event code with the number of bits of the rule
+			TRY(grammarCodec->decodeCode(strm, currNonTermID, &tmp_bits_val));
+			if(tmp_bits_val < prodCount)
+				return handleProduction(strm, &currentRule->production[prodCount - 1 - tmp_bits_val], nonTermID_out, handler, app_data);
+
+			return stateMachineProdDecode(strm, currentRule, ruleDispatch, nonTermID_out, handler, app_data);
+		}
+	}
+#endif
+
+	if(ruleDispatch == NULL)
+		bitCount = getBitsFirstPartCode(strm, prodCount, currNonTermID);
+	else if(strm->context.isNilType == FALSE)
+		bitCount = ruleDispatch->firstBits;
+	else
+		bitCount = ruleDispatch->nilFirstBits;
 
 	if(prodCount > 0)
 	{
@@ -121,7 +163,306 @@ errorCode processNextProduction(EXIStream* strm, SmallIndex* nonTermID_out, Cont
 	// Production with length code 1 not found: search second or third level productions
 	// Invoke state machine
 
-	return stateMachineProdDecode(strm, currentRule, nonTermID_out, handler, app_data);
+	return stateMachineProdDecode(strm, currentRule, ruleDispatch, nonTermID_out, handler, app_data);
+}
+
+/**
+ * @brief Returns the precomputed dispatch of the current grammar rule;
+ * NULL for the built-in element grammars and the grammars created while parsing
+ */
+static RuleDispatch* getRuleDispatch(EXIStream* strm)
+{
+	EventCodeDispatch* dispatch = strm->dispatch;
+	EXIGrammar* grammar = strm->gStack->grammar;
+	Index offset;
+
+	if(grammar == &strm->schema->docGrammar)
+		offset = dispatch->ruleOffset[0];
+	else if(grammar >= strm->schema->grammarTable.grammar &&
+			grammar < strm->schema->grammarTable.grammar + dispatch->grammarCount)
+		offset = dispatch->ruleOffset[grammar - strm->schema->grammarTable.grammar + 1];
+	else
+		return NULL;
+
+	if(offset == INDEX_MAX)
+		return NULL;
+	else if(strm->gStack->currNonTermID == GR_CONTENT_2)
+		return &dispatch->rule[offset + grammar->count];
+	else
+		return &dispatch->rule[offset + strm->gStack->currNonTermID];
+}
+
+/**
+ * @brief Whether a rule of a schema-informed grammar is the content2 rule.
+ * A copy of the content grammar rule is created if and only if there are AT
+ * productions that point to the content grammar rule OR the content index is 0.
+ * The content2 grammar rule is only needed in case the current rule is
+ * equal the content grammar rule. Note that when content index is 0, the entry grammar
+ * is the content2 grammar rule and by default the GR_START_TAG_CONTENT is pointing
+ * to the content2 while GR_CONTENT_2 is pointing to content i.e. the roles are
+ * reversed in this situation. It is implemented in this way in order to keep
+ * all the rule processing in tact in the other parts of the implementation.
+ */
+static boolean isContent2Rule(EXIGrammar* grammar, SmallIndex nonTermID)
+{
+	if(nonTermID == GR_CONTENT_2)
+		return GET_CONTENT_INDEX(grammar->props) != GR_START_TAG_CONTENT;
+	else
+		return GET_CONTENT_INDEX(grammar->props) == GR_START_TAG_CONTENT && nonTermID == GR_START_TAG_CONTENT;
+}
+
+/**
+ * @brief Maps each value of the second part of an event code to the
+ * available second level production with that position
+ * @param[in] available the availability of the second level productions in their order
+ * @param[in] eventCount number of second level productions of the kind of grammar
+ * @param[out] codes the second level event codes
+ */
+static void fillSecondLevelCodes(const boolean* available, unsigned int eventCount, SecondLevelCodes* codes)
+{
+	unsigned int prodCnt = 0;
+	unsigned int code;
+	unsigned int event;
+	unsigned int i;
+
+	// Zeroed so that equal layouts compare equal with memcmp
+	memset(codes, 0, sizeof(SecondLevelCodes));
+
+	for(i = 0; i < eventCount; i++)
+		prodCnt += available[i];
+
+	if(prodCnt == 0)
+	{
+		codes->event[0] = SECOND_LEVEL_EVENT_NONE;
+		return;
+	}
+
+	codes->bits = getBitsNumber(prodCnt - 1);
+	for(code = 0; code < (1u << codes->bits); code++)
+	{
+		event = code;
+		for(i = 0; i <= event && event < eventCount; i++)
+			event = event + (available[i] == 0);
+
+		codes->event[code] = event < eventCount ? (unsigned char) event : SECOND_LEVEL_EVENT_NONE;
+	}
+}
+
+/**
+ * @brief The second level events of the built-in element grammars:
+ * EE, AT(*), NS, SC, SE(*), CH, ER, CM or PI
+ */
+static void getBuiltInSecondLevel(EXIStream* strm, boolean startTag, SecondLevelCodes* codes)
+{
+	boolean available[8] = {FALSE, FALSE, FALSE, FALSE, TRUE, TRUE, FALSE, FALSE};
+
+	if(startTag)
+	{
+		available[0] = TRUE;
+		available[1] = TRUE;
+		available[2] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES);
+		available[3] = WITH_SELF_CONTAINED(strm->header.opts.enumOpt);
+	}
+
+	available[6] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_DTD);
+	available[7] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS);
+
+	fillSecondLevelCodes(available, 8, codes);
+}
+
+/**
+ * @brief The second level events of a schema-informed grammar rule.
+ * Strict mode: AT(xsi:type), AT(xsi:nil). Non-strict mode: EE, AT(xsi:type),
+ * AT(xsi:nil), AT(*), AT untyped, NS, SC, SE(*), CH untyped, ER, CM or PI
+ * @param[in] strm EXI stream
+ * @param[in] grammar the grammar of the rule
+ * @param[in] nonTermID the non-terminal of the rule as in the grammar stack (GR_CONTENT_2 is not mapped)
+ * @param[in] rule the rule
+ * @param[out] codes the second level event codes
+ */
+static void getSchemaSecondLevel(EXIStream* strm, EXIGrammar* grammar, SmallIndex nonTermID, GrammarRule* rule, SecondLevelCodes* codes)
+{
+	if(WITH_STRICT(strm->header.opts.enumOpt))
+	{
+		// Only available second level event if it is an entry grammar rule.
+		// The xsi:nil="true" case is checked when decoding
+		boolean available[2] = {FALSE, FALSE};
+
+		if(nonTermID == GR_START_TAG_CONTENT)
+		{
+			available[0] = HAS_NAMED_SUB_TYPE_OR_UNION(grammar->props);
+			available[1] = IS_NILLABLE(grammar->props);
+		}
+
+		fillSecondLevelCodes(available, 2, codes);
+	}
+	else
+	{
+		boolean available[11] = {FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, TRUE, TRUE, FALSE, FALSE};
+
+		if(isContent2Rule(grammar, nonTermID) || nonTermID < GET_CONTENT_INDEX(grammar->props))
+		{
+			available[3] = TRUE;
+			available[4] = TRUE;
+		}
+
+		available[0] = !RULE_CONTAIN_EE(rule->meta);
+
+		if(nonTermID == GR_START_TAG_CONTENT)
+		{
+			available[1] = TRUE;
+			available[2] = TRUE;
+			available[5] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES);
+			available[6] = WITH_SELF_CONTAINED(strm->header.opts.enumOpt);
+		}
+
+		available[9] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_DTD);
+		available[10] = IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS);
+
+		fillSecondLevelCodes(available, 11, codes);
+	}
+}
+
+/**
+ * @brief Decodes the second part of an event code
+ * @param[in, out] strm EXI stream
+ * @param[in] codes the second level event codes of the rule
+ * @param[out] event the second level event; SECOND_LEVEL_EVENT_NONE if the code is not used
+ * @return Error handling code
+ */
+static errorCode decodeSecondLevelEvent(EXIStream* strm, const SecondLevelCodes* codes, unsigned int* event)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int code = 0;
+
+	if(codes->bits > 0)
+		TRY(decodeNBitUnsignedInteger(strm, codes->bits, &code));
+
+	*event = codes->event[code];
+	return EXIP_OK;
+}
+
+/**
+ * @brief Finds or adds a second level layout in the dispatch table
+ */
+static errorCode addSecondLevelLayout(EventCodeDispatch* dispatch, const SecondLevelCodes* codes, unsigned char* layoutId)
+{
+	unsigned char i;
+
+	for(i = 0; i < dispatch->layoutCount; i++)
+	{
+		if(memcmp(&dispatch->layout[i], codes, sizeof(SecondLevelCodes)) == 0)
+		{
+			*layoutId = i;
+			return EXIP_OK;
+		}
+	}
+
+	if(dispatch->layoutCount == SECOND_LEVEL_LAYOUTS_MAX)
+		return EXIP_UNEXPECTED_ERROR;
+
+	dispatch->layout[dispatch->layoutCount] = *codes;
+	*layoutId = dispatch->layoutCount;
+	dispatch->layoutCount += 1;
+
+	return EXIP_OK;
+}
+
+errorCode createEventCodeDispatch(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EventCodeDispatch* dispatch;
+	EXIGrammar* grammar;
+	GrammarRule* rule;
+	SecondLevelCodes codes;
+	Index grammarCount = strm->schema->grammarTable.count;
+	Index ruleCount = 0;
+	Index offset = 0;
+	Index nilProdCount;
+	Index g;
+	SmallIndex r;
+	SmallIndex nonTermID;
+
+	destroyEventCodeDispatch(strm);
+
+	// The document/fragment grammar (g == 0) and the grammar table
+	for(g = 0; g <= grammarCount; g++)
+	{
+		grammar = g == 0 ? &strm->schema->docGrammar : &strm->schema->grammarTable.grammar[g - 1];
+		if(!IS_BUILT_IN_ELEM(grammar->props))
+			ruleCount += grammar->count + 1;
+	}
+
+	// A single allocation: the table, ruleOffset[] and rule[]
+	dispatch = (EventCodeDispatch*) EXIP_MALLOC(sizeof(EventCodeDispatch) + sizeof(Index)*(grammarCount + 1) + sizeof(RuleDispatch)*ruleCount);
+	if(dispatch == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	dispatch->layoutCount = 0;
+	dispatch->grammarCount = grammarCount;
+	dispatch->ruleOffset = (Index*) (dispatch + 1);
+	dispatch->rule = (RuleDispatch*) (dispatch->ruleOffset + grammarCount + 1);
+
+	getBuiltInSecondLevel(strm, TRUE, &codes);
+	TRY_CATCH(addSecondLevelLayout(dispatch, &codes, &dispatch->builtInStartTag), EXIP_MFREE(dispatch));
+	getBuiltInSecondLevel(strm, FALSE, &codes);
+	TRY_CATCH(addSecondLevelLayout(dispatch, &codes, &dispatch->builtInContent), EXIP_MFREE(dispatch));
+
+	for(g = 0; g <= grammarCount; g++)
+	{
+		grammar = g == 0 ? &strm->schema->docGrammar : &strm->schema->grammarTable.grammar[g - 1];
+		if(IS_BUILT_IN_ELEM(grammar->props))
+		{
+			dispatch->ruleOffset[g] = INDEX_MAX;
+			continue;
+		}
+
+		dispatch->ruleOffset[g] = offset;
+		// The rules followed by the GR_CONTENT_2 entry that uses the content rule
+		for(r = 0; r <= grammar->count; r++)
+		{
+			RuleDispatch* ruleDispatch = &dispatch->rule[offset + r];
+			SmallIndex ruleIndx = r < grammar->count ? r : GET_CONTENT_INDEX(grammar->props);
+
+			nonTermID = r < grammar->count ? r : GR_CONTENT_2;
+			if(ruleIndx >= grammar->count)
+			{
+				// Never used: processNextProduction() fails before the lookup
+				ruleDispatch->firstBits = 0;
+				ruleDispatch->nilFirstBits = 0;
+				ruleDispatch->secondLevel = 0;
+				continue;
+			}
+
+			rule = &grammar->rule[ruleIndx];
+			ruleDispatch->firstBits = (unsigned char) getGrammarBitsFirstPartCode(strm, grammar, rule->pCount, ruleIndx, FALSE);
+
+			// After xsi:nil="true" only the AT and EE productions are left;
+			// instead of the content there is a single EE production
+			if(ruleIndx >= GET_CONTENT_INDEX(grammar->props))
+				nilProdCount = 1;
+			else
+				nilProdCount = RULE_GET_AT_COUNT(rule->meta) + RULE_CONTAIN_EE(rule->meta);
+			ruleDispatch->nilFirstBits = (unsigned char) getGrammarBitsFirstPartCode(strm, grammar, nilProdCount, ruleIndx, TRUE);
+
+			getSchemaSecondLevel(strm, grammar, nonTermID, rule, &codes);
+			TRY_CATCH(addSecondLevelLayout(dispatch, &codes, &ruleDispatch->secondLevel), EXIP_MFREE(dispatch));
+		}
+		offset += grammar->count + 1;
+	}
+
+	strm->dispatch = dispatch;
+
+	return EXIP_OK;
+}
+
+void destroyEventCodeDispatch(EXIStream* strm)
+{
+	if(strm->dispatch != NULL)
+	{
+		EXIP_MFREE(strm->dispatch);
+		strm->dispatch = NULL;
+	}
 }
 
 static errorCode handleProduction(EXIStream* strm, Production* prodHit, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data)
@@ -161,7 +502,7 @@ static errorCode handleProduction(EXIStream* strm, Production* prodHit, SmallInd
 	return EXIP_OK;
 }
 
-static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRule, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data)
+static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRule, RuleDispatch* ruleDispatch, SmallIndex* nonTermID_out, ContentHandler* handler, void* app_data)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	unsigned int prodCnt = 0;
@@ -175,60 +516,12 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 
 		/* There are 8 possible states to exit the state machine: EE, AT (*), NS etc.
 		 * The state depends on the input event code from the stream and the
-		 * available productions at level 2.
+		 * available productions at level 2 (see getBuiltInSecondLevel()).
 		 * (Note this is the state for level 2 productions) */
 		unsigned int state = 0;
+		boolean startTag = strm->gStack->currNonTermID == GR_START_TAG_CONTENT;
 
-		/* The state mask stores the availability of the productions on level 2.
-		 * They are encoded ordered:
-		 * Availability for EE is encoded in position 0,
-		 * availability for AT(xsi:type) is encoded in position 1,
-		 * and so on. */
-		boolean state_mask[8] = {FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE};
-		unsigned int i;
-
-		prodCnt = 2; // Always SE, CH, position 4, 5
-		state_mask[4] = TRUE;
-		state_mask[5] = TRUE;
-
-		if(strm->gStack->currNonTermID == GR_START_TAG_CONTENT)
-		{
-			prodCnt += 2; // EE, AT, position 0, 1
-			state_mask[0] = TRUE;
-			state_mask[1] = TRUE;
-
-			if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES))
-			{
-				prodCnt += 1; // NS, position 2
-				state_mask[2] = TRUE;
-			}
-
-			if(WITH_SELF_CONTAINED(strm->header.opts.enumOpt))
-			{
-				prodCnt += 1; // SC, position 3
-				state_mask[3] = TRUE;
-			}
-		}
-
-		if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_DTD))
-		{
-			prodCnt += 1; // ER position 6
-			state_mask[6] = TRUE;
-		}
-
-		if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS))
-		{
-			prodCnt += 1; // CM or PI, position 7
-			state_mask[7] = TRUE;
-		}
-
-		TRY(decodeNBitUnsignedInteger(strm, getBitsNumber(prodCnt - 1), &tmp_bits_val));
-		state = tmp_bits_val;
-
-		for(i = 0; i <= state && state < 8; i++)
-		{
-			state = state + (state_mask[i] == 0);
-		}
+		TRY(decodeSecondLevelEvent(strm, &strm->dispatch->layout[startTag ? strm->dispatch->builtInStartTag : strm->dispatch->builtInContent], &state));
 
 		switch(state)
 		{
@@ -271,7 +564,7 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 			break;
 			case 3:
 				// StartTagContent : SC event
-				return EXIP_NOT_IMPLEMENTED_YET;
+				TRY(decodeSelfContained(strm, handler, nonTermID_out, app_data));
 			break;
 			case 4:
 				// SE(*) event
@@ -426,6 +719,11 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 		// Schema-informed element/type grammar
 		QName qname;
 
+		if(ruleDispatch == NULL)
+			return EXIP_INCONSISTENT_PROC_STATE;
+
+		qname.prefix = NULL;
+
 		if(WITH_STRICT(strm->header.opts.enumOpt))
 		{
 			// Strict mode
@@ -435,29 +733,12 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 			{
 				/* There are 2 possible states to exit the state machine: AT(xsi:type) and AT(xsi:nil)
 				 * (Note this is the state for level 2 productions) */
-				unsigned int state = 1;
+				unsigned int state = 0;
 				boolean nil;
 
 				*nonTermID_out = GR_START_TAG_CONTENT;
 
-				if(HAS_NAMED_SUB_TYPE_OR_UNION(strm->gStack->grammar->props))
-				{
-					prodCnt += 1;
-					state = 0;
-				}
-
-				if(IS_NILLABLE(strm->gStack->grammar->props))
-					prodCnt += 1;
-
-				if(prodCnt == 0)
-					return EXIP_INCONSISTENT_PROC_STATE;
-				else if(prodCnt == 2)
-				{
-					TRY(decodeNBitUnsignedInteger(strm, 1, &state));
-					if(state > 1)
-						return EXIP_INCONSISTENT_PROC_STATE;
-				}
-				// if prodCnt == 1 -> zero bit encoded event
+				TRY(decodeSecondLevelEvent(strm, &strm->dispatch->layout[ruleDispatch->secondLevel], &state));
 
 				switch(state)
 				{
@@ -509,93 +790,12 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 		{
 			/* There are 11 possible states to exit the state machine: EE, AT(xsi:type), AT(xsi:nil) etc.
 			 * The state depends on the input event code from the stream and the
-			 * available productions at level 2.
+			 * available productions at level 2 (see getSchemaSecondLevel()).
 			 * (Note this is the state for level 2 productions) */
 			unsigned int state = 0;
+			boolean isContent2Grammar = isContent2Rule(strm->gStack->grammar, strm->gStack->currNonTermID);
 
-			/* The state mask stores the availability of the productions on level 2.
-			 * They are encoded ordered:
-			 * Availability for EE is encoded in position 0,
-			 * availability for AT(xsi:type) is encoded in position 1,
-			 * and so on. */
-			boolean state_mask[11] = {FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE};
-			unsigned int i;
-			// Create a copy of the content grammar if and only if there are AT
-			// productions that point to the content grammar rule OR the content index is 0.
-			// The content2 grammar rule is only needed in case the current rule is
-			// equal the content grammar rule. Note that when content index is 0, the entry grammar
-			// is the content2 grammar rule and by default the GR_START_TAG_CONTENT is pointing
-			// to the content2 while GR_CONTENT_2 is pointing to content i.e. the roles are
-			// reversed in this situation. It is implemented in this way in order to keep
-			// all the rule processing in tact in the other parts of the implementation.
-			boolean isContent2Grammar = FALSE;
-
-			if(strm->gStack->currNonTermID == GR_CONTENT_2)
-			{
-				if(GET_CONTENT_INDEX(strm->gStack->grammar->props) != GR_START_TAG_CONTENT)
-					isContent2Grammar = TRUE;
-			}
-			else if(GET_CONTENT_INDEX(strm->gStack->grammar->props) == GR_START_TAG_CONTENT &&
-					strm->gStack->currNonTermID == GR_START_TAG_CONTENT)
-			{
-					isContent2Grammar = TRUE;
-			}
-
-			prodCnt = 2; // SE(*), CH(untyped) always available, position 7 and 8
-			state_mask[7] = TRUE;
-			state_mask[8] = TRUE;
-			if(isContent2Grammar ||
-					strm->gStack->currNonTermID < GET_CONTENT_INDEX(strm->gStack->grammar->props))
-			{
-				prodCnt += 2; // AT(*), AT(untyped) third level, position 3 and 4
-				state_mask[3] = TRUE;
-				state_mask[4] = TRUE;
-			}
-
-			if(!RULE_CONTAIN_EE(currentRule->meta))
-			{
-				prodCnt += 1; // EE, position 0
-				state_mask[0] = TRUE;
-			}
-
-			if(strm->gStack->currNonTermID == GR_START_TAG_CONTENT)
-			{
-				prodCnt += 2; // AT(xsi:type), AT(xsi:nil), position 1 and 2
-				state_mask[1] = TRUE;
-				state_mask[2] = TRUE;
-
-				if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES))
-				{
-					prodCnt += 1; // NS, position 5
-					state_mask[5] = TRUE;
-				}
-				if(WITH_SELF_CONTAINED(strm->header.opts.enumOpt))
-				{
-					prodCnt += 1; // SC, position 6
-					state_mask[6] = TRUE;
-				}
-			}
-
-			if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_DTD))
-			{
-				prodCnt += 1; // ER, position 9
-				state_mask[9] = TRUE;
-			}
-
-			if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS))
-			{
-				prodCnt += 1; // CM or PI, position 10
-				state_mask[10] = TRUE;
-			}
-
-			TRY(decodeNBitUnsignedInteger(strm, getBitsNumber(prodCnt - 1), &tmp_bits_val));
-
-			state = tmp_bits_val;
-
-			for(i = 0; i <= state && state < 11; i++)
-			{
-				state = state + (state_mask[i] == 0);
-			}
+			TRY(decodeSecondLevelEvent(strm, &strm->dispatch->layout[ruleDispatch->secondLevel], &state));
 
 			switch(state)
 			{
@@ -663,7 +863,7 @@ static errorCode stateMachineProdDecode(EXIStream* strm, GrammarRule* currentRul
 				break;
 				case 6:
 					// SC event
-					return EXIP_NOT_IMPLEMENTED_YET;
+					TRY(decodeSelfContained(strm, handler, nonTermID_out, app_data));
 				break;
 				case 7:
 					// SE(*) content|same_rule
@@ -857,6 +1057,43 @@ errorCode decodePfx(EXIStream* strm, SmallIndex uriId, SmallIndex* pfxId)
 	return EXIP_OK;
 }
 
+/**
+ * @brief Decodes the characters of a string value in the value arena of the stream.
+ * When the whole EXI stream is in the input buffer, the string starts at a byte
+ * boundary and all its characters are 7-bit, each character is encoded in a single
+ * octet equal to its code point. In that case the string points directly into the buffer.
+ */
+static errorCode decodeArenaString(EXIStream* strm, Index vStrLen, String* value)
+{
+	if(sizeof(CharType) == 1 && strm->valueArena->zeroCopy && strm->context.bitPointer == 0
+#if COMPRESSION_USE
+			&& strm->channels == NULL
+#endif
+			&& strm->buffer.ioStrm.readWriteToStream == NULL && strm->buffer.bufStrm.buf == NULL
+			&& vStrLen <= strm->buffer.bufContent - strm->context.bufferIndx)
+	{
+		const unsigned char* chars = (const unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+		Index i = 0;
+
+		while(i < vStrLen && chars[i] < 0x80)
+			i++;
+
+		if(i == vStrLen)
+		{
+			value->str = (CharType*) (strm->buffer.buf + strm->context.bufferIndx);
+			value->length = vStrLen;
+			strm->context.bufferIndx += vStrLen;
+			return EXIP_OK;
+		}
+	}
+
+	value->str = arenaAllocate(strm->valueArena, sizeof(CharType)*vStrLen*UCS_CHAR_MAX_UNITS);
+	if(value->str == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	return decodeStringOnly(strm, vStrLen, value);
+}
+
 errorCode decodeStringValue(EXIStream* strm, QNameID qnameID, String* value)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
@@ -895,8 +1132,22 @@ errorCode decodeStringValue(EXIStream* strm, QNameID qnameID, String* value)
 	{
 		Index vStrLen = (Index) tmpVar - 2;
 
-		TRY(allocateStringMemory(&value->str, vStrLen));
-		TRY(decodeStringOnly(strm, vStrLen, value));
+		if(strm->context.skipValues && (vStrLen == 0 || vStrLen > strm->header.opts.valueMaxLength || strm->header.opts.valuePartitionCapacity == 0))
+		{
+			// The value is not needed and is not added to the value partitions
+			getEmptyString(value);
+			return skipStringOnly(strm, vStrLen);
+		}
+
+		if(strm->valueArena != NULL)
+		{
+			TRY(decodeArenaString(strm, vStrLen, value));
+		}
+		else
+		{
+			TRY(allocateStringMemory(&value->str, vStrLen));
+			TRY(decodeStringOnly(strm, vStrLen, value));
+		}
 
 		if(vStrLen > 0 && vStrLen <= strm->header.opts.valueMaxLength && strm->header.opts.valuePartitionCapacity > 0)
 		{
@@ -913,6 +1164,8 @@ errorCode decodeEventContent(EXIStream* strm, Production* prodHit, ContentHandle
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	QName qname;
 
+	qname.prefix = NULL;
+
 	// TODO: implement all cases of events such as PI, CM etc.
 
 	switch(GET_PROD_EXI_EVENT(prodHit->content))
@@ -967,7 +1220,7 @@ errorCode decodeEventContent(EXIStream* strm, Production* prodHit, ContentHandle
 
 			if(handler->startElement != NULL)  // Invoke handler method passing the element qname
 			{
-				TRY(handler->startElement(qname, app_data));
+				TRY(checkSkipRequest(strm, handler->startElement(qname, app_data)));
 			}
 		}
 		break;
@@ -1008,11 +1261,28 @@ errorCode decodeEventContent(EXIStream* strm, Production* prodHit, ContentHandle
 	return EXIP_OK;
 }
 
+errorCode checkSkipRequest(EXIStream* strm, errorCode handlerCode)
+{
+	if(handlerCode == EXIP_HANDLER_SKIP_ELEMENT)
+	{
+		strm->context.skipRequested = TRUE;
+		return EXIP_OK;
+	}
+
+	return handlerCode;
+}
+
 errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler, SmallIndex* nonTermID_out, QNameID localQNameID, void* app_data)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	EXIType exiType = VALUE_TYPE_NONE;
 
+#if COMPRESSION_USE
+	// The value is decoded later from its value channel
+	if(IS_CHANNEL_VALUE(strm, localQNameID) && strm->channels->inStructure)
+		return addValuePlaceholder(strm, typeId, localQNameID);
+#endif
+
 	if(typeId != INDEX_MAX)
 		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
 	else if(localQNameID.uriId == XML_SCHEMA_INSTANCE_ID &&
@@ -1099,7 +1369,7 @@ errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler
 			}
 
 			// handle xsi:nil attribute
-			if(IS_SCHEMA(strm->gStack->grammar->props) && localQNameID.uriId == XML_SCHEMA_INSTANCE_ID && localQNameID.lnId == XML_SCHEMA_INSTANCE_NIL_ID) // Schema-enabled grammar and http://www.w3.org/2001/XMLSchema-instance:nil
+			if(localQNameID.uriId == XML_SCHEMA_INSTANCE_ID && localQNameID.lnId == XML_SCHEMA_INSTANCE_NIL_ID && IS_SCHEMA(strm->gStack->grammar->props)) // Schema-enabled grammar and http://www.w3.org/2001/XMLSchema-instance:nil
 			{
 				if(bool_val == TRUE)
 				{
@@ -1115,6 +1385,11 @@ errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler
 			Index nbytes;
 			char *binary_val;
 			//DEBUG_MSG(INFO, DEBUG_CONTENT_IO, (">Binary value\n"));
+			if(strm->context.skipValues)
+				return skipBinary(strm);
+			if(strm->binaryChunks.chunkSize > 0 && handler->binaryDataChunk != NULL)
+				return decodeBinaryChunks(strm, handler, app_data);
+
 			TRY(decodeBinary(strm, &binary_val, &nbytes));
 
 			if(handler->binaryData != NULL)  // Invoke handler method
@@ -1206,9 +1481,12 @@ errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler
 			}
 			else
 			{
+				Index charCount;
+
 				TRY(decodeStringValue(strm, localQNameID, &value));
+				TRY(countStringChars(&value, &charCount));
 
-				if(value.length == 0 || value.length > strm->header.opts.valueMaxLength || strm->header.opts.valuePartitionCapacity == 0)
+				if(charCount == 0 || charCount > strm->header.opts.valueMaxLength || strm->header.opts.valuePartitionCapacity == 0)
 					freeable = TRUE;
 			}
 
@@ -1217,7 +1495,8 @@ errorCode decodeValueItem(EXIStream* strm, Index typeId, ContentHandler* handler
 				TRY(handler->stringData(value, app_data));
 			}
 
-			if(freeable)
+			// The strings in the value arena are freed together with it
+			if(freeable && strm->valueArena == NULL)
 				EXIP_MFREE(value.str);
 		} break;
 	}
@@ -1266,7 +1545,7 @@ errorCode decodeSEWildcardEvent(EXIStream* strm, ContentHandler* handler, SmallI
 
 	if(handler->startElement != NULL)  // Invoke handler method passing the element qname
 	{
-		TRY(handler->startElement(qname, app_data));
+		TRY(checkSkipRequest(strm, handler->startElement(qname, app_data)));
 	}
 
 	// New element grammar is pushed on the stack
@@ -1348,6 +1627,7 @@ errorCode decodeSEWildcardEvent(EXIStream* strm, ContentHandler* handler, SmallI
 				return EXIP_INCONSISTENT_PROC_STATE;
 			}
 
+			strm->context.currAttr = attrQnameId;
 			if(handler->attribute != NULL)  // Invoke handler method for xsi:type
 			{
 				TRY(handler->attribute(attrQname, app_data));
@@ -1407,13 +1687,13 @@ errorCode decodeATWildcardEvent(EXIStream* strm, ContentHandler* handler, SmallI
 		}
 	}
 
+	strm->context.currAttr = qnameId;
 	if(handler->attribute != NULL)  // Invoke handler method
 	{
 		TRY(handler->attribute(qname, app_data));
 	}
 
 	TRY(decodeValueItem(strm, INDEX_MAX, handler, nonTermID_out, qnameId, app_data));
-	strm->context.currAttr = qnameId;
 
 	return EXIP_OK;
 }
@@ -1449,3 +1729,173 @@ static errorCode decodeQNameValue(EXIStream* strm, ContentHandler* handler, Smal
 
 	return EXIP_OK;
 }
+
+/**
+ * @brief Decodes a binary value strm->binaryChunks.chunkSize bytes at a time
+ * and passes every chunk to the binaryDataChunk() handler. The chunks reported
+ * before an EXIP_BUFFER_END_REACHED are skipped when the value is decoded again.
+ */
+static errorCode decodeBinaryChunks(EXIStream* strm, ContentHandler* handler, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	UnsignedInteger length = 0;
+	Index total;
+	Index offset = 0;
+	Index n;
+	unsigned char* chunk;
+
+	TRY(decodeUnsignedInteger(strm, &length));
+	total = (Index) length;
+
+	if(total == 0)
+		return handler->binaryDataChunk(NULL, 0, 0, 0, app_data);
+
+	n = total < strm->binaryChunks.chunkSize ? total : strm->binaryChunks.chunkSize;
+	chunk = (unsigned char*) EXIP_MALLOC(n);
+	if(chunk == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	while(offset < total)
+	{
+		if(n > total - offset)
+			n = total - offset;
+
+		TRY_CATCH(strm->decodePrim->octets(strm, chunk, n), EXIP_MFREE(chunk));
+		if(offset >= strm->binaryChunks.delivered)
+		{
+			TRY_CATCH(handler->binaryDataChunk((char*) chunk, n, offset, total, app_data), EXIP_MFREE(chunk));
+			strm->binaryChunks.delivered = offset + n;
+		}
+		offset += n;
+	}
+
+	EXIP_MFREE(chunk);
+	strm->binaryChunks.delivered = 0;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Decodes the start of a self-contained element right after its SC event: the
+ * padding and the SE of its fragment, encoded with the initial string tables.
+ * The element, already reported by its SE event, is not reported again and its grammar
+ * stack node is replaced by the ones of the fragment and of the element.
+ */
+static errorCode decodeSelfContained(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIGrammarStack* element = strm->gStack;
+	EXIGrammarStack* fragment;
+	SmallIndex fragmentNonTermID;
+
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, (">SC event\n"));
+
+	// Padding bits
+	if(strm->context.bitPointer != 0)
+	{
+		strm->context.bitPointer = 0;
+		strm->context.bufferIndx += 1;
+	}
+
+	// The content of a skipped element in the index is passed over: the element ends here
+	if(strm->context.skipValues && strm->scIndex != NULL)
+	{
+		Index end = getSelfContainedEnd(strm->scIndex, strm->context.bufferOffset + strm->context.bufferIndx);
+
+		if(end != 0)
+		{
+			strm->context.skipOffset = end;
+			*nonTermID_out = GR_VOID_NON_TERMINAL;
+			return EXIP_OK;
+		}
+	}
+
+	TRY(enterSelfContained(strm));
+	tmp_err_code = pushSelfContainedFragment(strm);
+	if(tmp_err_code == EXIP_OK)
+		tmp_err_code = processNextProduction(strm, &fragmentNonTermID, &silentHandler, NULL);
+	if(tmp_err_code == EXIP_OK && (strm->gStack == element || strm->gStack->nextInStack->currNonTermID != GR_SC_FRAGMENT_END))
+		tmp_err_code = EXIP_INVALID_EXI_INPUT; // The fragment must hold the element
+
+	if(tmp_err_code != EXIP_OK)
+	{
+		// The SC event can be decoded again, e.g. after EXIP_BUFFER_END_REACHED
+		while(strm->gStack != element)
+			popGrammar(&strm->gStack);
+		exitSelfContained(strm);
+		return tmp_err_code;
+	}
+
+	// The fragment takes the place of the element in the grammar stack
+	fragment = strm->gStack->nextInStack;
+	fragment->nextInStack = element->nextInStack;
+	EXIP_MFREE(element);
+	strm->selfContained->fragment = fragment;
+	*nonTermID_out = GR_START_TAG_CONTENT;
+
+	if(handler->selfContained != NULL)
+	{
+		TRY(handler->selfContained(app_data));
+	}
+
+	return EXIP_OK;
+}
+
+Index getSelfContainedEnd(const SelfContainedIndex* index, Index offset)
+{
+	Index low = 0;
+	Index high = index->count;
+	Index mid;
+
+	// The offsets increase in document order
+	while(low < high)
+	{
+		mid = low + (high - low)/2;
+		if(index->entry[mid].offset < offset)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if(low < index->count && index->entry[low].offset == offset && index->entry[low].end > offset)
+		return index->entry[low].end;
+
+	return 0;
+}
+
+/**
+ * @brief Decodes the ED event of the fragment of a self-contained element and
+ * restores the string tables of the enclosing stream. The fragment grammar is popped
+ * by the caller. A fragment decoded on its own (see seekSelfContained()) ends
+ * with the endDocument() handler.
+ */
+static errorCode decodeSelfContainedEnd(EXIStream* strm, ContentHandler* handler, SmallIndex* nonTermID_out, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int tmp_bits_val = 0;
+	Index prodCount = getSelfContainedEndCount(strm->gStack->grammar);
+
+	// ED is the last production of FragmentContent
+	TRY(decodeNBitUnsignedInteger(strm, getBitsFirstPartCode(strm, prodCount, GR_FRAGMENT_CONTENT), &tmp_bits_val));
+	if(tmp_bits_val != prodCount - 1)
+		return EXIP_INVALID_EXI_INPUT;
+
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, ("> ED event of SC fragment\n"));
+
+	// Padding bits
+	if(strm->context.bitPointer != 0)
+	{
+		strm->context.bitPointer = 0;
+		strm->context.bufferIndx += 1;
+	}
+
+	if(strm->gStack->nextInStack == NULL && handler->endDocument != NULL)
+	{
+		TRY(handler->endDocument(app_data));
+	}
+
+	exitSelfContained(strm);
+	*nonTermID_out = GR_VOID_NON_TERMINAL;
+
+	return EXIP_OK;
+}
@@ -24,12 +24,20 @@
 #include "memManagement.h"
 #include "dynamicArray.h"
 
-extern const String XML_SCHEMA_INSTANCE;
+/** Initial number of slots of the production index */
+#define PROD_INDEX_INITIAL_SIZE 64
 
 /**
  * @brief Encodes second or third level production based on a state machine  */
 static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventClass, GrammarRule* currentRule,
-										QName* qname, EventCode ec, Production* prodHit);
+										QNameID* qnameID, EventCode ec, Production* prodHit);
+
+static void getEncodedQNameID(EXIStream* strm, QNameID* qnameID);
+#if STATIC_CODEC_USE
+static Index getStaticQName(const StaticCodec* codec, QNameID* qnameID);
+#endif
+static errorCode findProduction(EXIStream* strm, GrammarRule* rule, Index prodCount, EventTypeClass eventClass,
+								QNameID* qnameID, boolean* found, Index* code);
 
 errorCode encodeStringData(EXIStream* strm, String strng, QNameID qnameID, Index typeId)
 {
@@ -88,10 +96,13 @@ errorCode encodeStringData(EXIStream* strm, String strng, QNameID qnameID, Index
 		}
 		else // "local" value partition and global value partition table miss
 		{
-			TRY(encodeUnsignedInteger(strm, (UnsignedInteger)(strng.length + 2)));
+			Index charCount;
+
+			TRY(countStringChars(&strng, &charCount));
+			TRY(encodeUnsignedInteger(strm, (UnsignedInteger)(charCount + 2)));
 			TRY(encodeStringOnly(strm, &strng));
 
-			if(strng.length > 0 && strng.length <= strm->header.opts.valueMaxLength && strm->header.opts.valuePartitionCapacity > 0)
+			if(charCount > 0 && charCount <= strm->header.opts.valueMaxLength && strm->header.opts.valuePartitionCapacity > 0)
 			{
 				// The value should be added in the value partitions of the string tables
 				String clonedValue;
@@ -105,9 +116,11 @@ errorCode encodeStringData(EXIStream* strm, String strng, QNameID qnameID, Index
 	return EXIP_OK;
 }
 
-errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean isSchemaType, QName* qname, EXITypeClass chTypeClass, Production* prodHit)
+errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean isSchemaType, QNameID* qnameID, EXITypeClass chTypeClass, Production* prodHit)
 {
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	GrammarRule* currentRule;
+	QNameID noQNameID = {URI_MAX, LN_MAX};
 	EventCode ec;
 	Index j = 0;
 	Production* tmpProd = NULL;
@@ -168,9 +181,32 @@ errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean i
 	}
 
 #if DEBUG_CONTENT_IO == ON
+	TRY(printGrammarRule(currNonTermID, currentRule, strm->schema));
+#endif
+
+	if(eventClass != EVENT_AT_CLASS && eventClass != EVENT_SE_CLASS)
+		qnameID = &noQNameID;
+	assert(qnameID);
+
+#if STATIC_CODEC_USE
+	if(isSchemaType == TRUE && strm->context.isNilType == FALSE)
 	{
-		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
-		TRY(printGrammarRule(currNonTermID, currentRule, strm->schema));
+		const StaticGrammarCodec* grammarCodec = getStaticGrammarCodec(strm, strm->gStack->grammar);
+
+		if(grammarCodec != NULL)
+		{
+			// The generated code finds the production and writes its event code
+			TRY(grammarCodec->encodeCode(strm, currNonTermID, eventClass, getStaticQName(strm->codec, qnameID),
+										 qnameID->uriId, chTypeClass, &j));
+			if(j != INDEX_MAX)
+			{
+				tmpProd = &currentRule->production[currentRule->pCount - 1 - j];
+				*prodHit = *tmpProd;
+				strm->gStack->currNonTermID = GET_PROD_NON_TERM(tmpProd->content);
+
+				return EXIP_OK;
+			}
+		}
 	}
 #endif
 
@@ -178,41 +214,23 @@ errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean i
 
 	if(isSchemaType == TRUE)
 	{
-		for(j = 0; j < prodCount; j++)
+		TRY(findProduction(strm, currentRule, prodCount, eventClass, qnameID, &matchFound, &j));
+
+		if(matchFound == TRUE)
 		{
 			tmpProd = &currentRule->production[currentRule->pCount - 1 - j];
 
-			if(GET_EVENT_CLASS(GET_PROD_EXI_EVENT(tmpProd->content)) == eventClass)
+			if(eventClass == EVENT_CH_CLASS)
 			{
-				if(eventClass == EVENT_AT_CLASS || eventClass == EVENT_SE_CLASS)
-				{
-					assert(qname);
-					if(tmpProd->qnameId.uriId == URI_MAX || (stringEqual(strm->schema->uriTable.uri[tmpProd->qnameId.uriId].uriStr, *(qname->uri)) &&
-					   (tmpProd->qnameId.lnId == LN_MAX || stringEqual(GET_LN_URI_QNAME(strm->schema->uriTable, tmpProd->qnameId).lnStr, *(qname->localName)))))
-					{
-						matchFound = TRUE;
-						break;
-					}
-				}
-				else if(eventClass == EVENT_CH_CLASS)
-				{
-					EXIType exiType;
-					if(tmpProd->typeId != INDEX_MAX)
-						exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[tmpProd->typeId].content);
-					else
-						exiType = VALUE_TYPE_NONE;
-
-					if(exiType == VALUE_TYPE_NONE || exiType == VALUE_TYPE_UNTYPED)
-						matchFound = TRUE;
-					else if(chTypeClass == GET_VALUE_TYPE_CLASS(exiType))
-						matchFound = TRUE;
-					break;
-				}
+				// Only the first CH production is checked
+				EXIType exiType;
+				if(tmpProd->typeId != INDEX_MAX)
+					exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[tmpProd->typeId].content);
 				else
-				{
-					matchFound = TRUE;
-					break;
-				}
+					exiType = VALUE_TYPE_NONE;
+
+				if(exiType != VALUE_TYPE_NONE && exiType != VALUE_TYPE_UNTYPED && chTypeClass != GET_VALUE_TYPE_CLASS(exiType))
+					matchFound = FALSE;
 			}
 		}
 	}
@@ -237,12 +255,331 @@ errorCode encodeProduction(EXIStream* strm, EventTypeClass eventClass, boolean i
 		ec.part[0] = prodCount;
 		ec.bits[0] = bitCount;
 
-		return stateMachineProdEncode(strm, eventClass, currentRule, qname, ec, prodHit);
+		return stateMachineProdEncode(strm, eventClass, currentRule, qnameID, ec, prodHit);
+	}
+}
+
+#if STATIC_CODEC_USE
+/**
+ * @brief The QName constant of the generated event code functions for a QName ID;
+ * INDEX_MAX if the QName is not in the string tables of the static schema
+ */
+static Index getStaticQName(const StaticCodec* codec, QNameID* qnameID)
+{
+	if(qnameID->uriId >= codec->uriCount ||
+			qnameID->lnId >= codec->uriBase[qnameID->uriId + 1] - codec->uriBase[qnameID->uriId])
+		return INDEX_MAX;
+
+	return codec->uriBase[qnameID->uriId] + qnameID->lnId;
+}
+#endif
+
+void resolveQNameID(EXIStream* strm, QName* qname, QNameID* qnameID)
+{
+	UriTable* uriTable = &strm->schema->uriTable;
+	struct QNameCacheEntry* entry = NULL;
+
+	if(strm->prodIndex != NULL)
+	{
+		entry = &strm->prodIndex->qnameCache[(((uintptr_t) qname->uri->str >> 3) ^ ((uintptr_t) qname->localName->str >> 3)*31) & (QNAME_CACHE_SIZE - 1)];
+
+		// The application might reuse the memory of the strings so a hit is
+		// confirmed by comparing with the string table entries
+		if(entry->uri == qname->uri->str && entry->ln == qname->localName->str &&
+				entry->qnameId.uriId < uriTable->count &&
+				entry->qnameId.lnId < uriTable->uri[entry->qnameId.uriId].lnTable.count &&
+				stringEqual(uriTable->uri[entry->qnameId.uriId].uriStr, *qname->uri) &&
+				stringEqual(uriTable->uri[entry->qnameId.uriId].lnTable.ln[entry->qnameId.lnId].lnStr, *qname->localName))
+		{
+			*qnameID = entry->qnameId;
+			return;
+		}
+	}
+
+	qnameID->uriId = URI_MAX;
+	qnameID->lnId = LN_MAX;
+
+	if(!lookupUri(uriTable, *qname->uri, &qnameID->uriId))
+	{
+		qnameID->uriId = URI_MAX;
+		return;
+	}
+
+	if(!lookupLn(&uriTable->uri[qnameID->uriId].lnTable, *qname->localName, &qnameID->lnId))
+	{
+		qnameID->lnId = LN_MAX;
+		return;
+	}
+
+	if(entry != NULL)
+	{
+		entry->uri = qname->uri->str;
+		entry->ln = qname->localName->str;
+		entry->qnameId = *qnameID;
+	}
+}
+
+/**
+ * @brief Replaces the URI_MAX/LN_MAX of a resolved QName with the IDs
+ * that the URI/local name get when they are added to the string tables
+ */
+static void getEncodedQNameID(EXIStream* strm, QNameID* qnameID)
+{
+	if(qnameID->uriId == URI_MAX)
+	{
+		qnameID->uriId = strm->schema->uriTable.count;
+		qnameID->lnId = 0;
+	}
+	else if(qnameID->lnId == LN_MAX)
+		qnameID->lnId = strm->schema->uriTable.uri[qnameID->uriId].lnTable.count;
+}
+
+/**
+ * @brief Whether the QName of an SE or AT production matches a resolved QName:
+ * SE(*)/AT(*), SE(uri:*)/AT(uri:*) or the same QName
+ */
+static boolean productionQNameMatch(QNameID prodQnameId, QNameID* qnameID)
+{
+	return prodQnameId.uriId == URI_MAX || (prodQnameId.uriId == qnameID->uriId &&
+			(prodQnameId.lnId == LN_MAX || prodQnameId.lnId == qnameID->lnId));
+}
+
+/**
+ * @brief The key of a production in the production index. The QName is
+ * part of the key for the SE(qname)/AT(qname) and SE(uri:*)/AT(uri:*) productions only.
+ * @return the event class of the production
+ */
+static unsigned char getProductionKey(Production* prod, QNameID* key)
+{
+	unsigned char eventClass = GET_EVENT_CLASS(GET_PROD_EXI_EVENT(prod->content));
+
+	key->uriId = URI_MAX;
+	key->lnId = LN_MAX;
+	if((eventClass == EVENT_SE_CLASS || eventClass == EVENT_AT_CLASS) && prod->qnameId.uriId != URI_MAX)
+		*key = prod->qnameId;
+
+	return eventClass;
+}
+
+static Index prodIndexHash(const GrammarRule* rule, unsigned char eventClass, QNameID key)
+{
+	uint64_t h = ((uint64_t) (uintptr_t) rule ^ eventClass) * 0x9E3779B97F4A7C15ULL;
+
+	h = (h ^ key.uriId) * 0x9E3779B97F4A7C15ULL;
+	h = (h ^ key.lnId) * 0x9E3779B97F4A7C15ULL;
+
+	return (Index) (h >> 32);
+}
+
+/**
+ * @return the slot of the key or the empty slot where it should be inserted
+ */
+static struct ProductionIndexSlot* findIndexSlot(ProductionIndex* index, const GrammarRule* rule, unsigned char eventClass, QNameID key)
+{
+	Index mask = index->size - 1;
+	Index s = prodIndexHash(rule, eventClass, key) & mask;
+
+	while(index->slot[s].rule != NULL)
+	{
+		if(index->slot[s].rule == rule && index->slot[s].eventClass == eventClass &&
+				index->slot[s].qnameId.uriId == key.uriId && index->slot[s].qnameId.lnId == key.lnId)
+			break;
+		s = (s + 1) & mask;
+	}
+
+	return &index->slot[s];
+}
+
+/**
+ * @brief Sets the production of a key; the index is rehashed in a twice
+ * bigger array when the load factor exceeds 1/2
+ */
+static errorCode setIndexSlot(ProductionIndex* index, const GrammarRule* rule, unsigned char eventClass, QNameID key, Index prodIndx)
+{
+	struct ProductionIndexSlot* slot;
+
+	if(2*(index->count + 1) > index->size)
+	{
+		struct ProductionIndexSlot* oldSlot = index->slot;
+		Index oldSize = index->size;
+		Index i;
+
+		index->slot = EXIP_CALLOC(2*oldSize, sizeof(struct ProductionIndexSlot));
+		if(index->slot == NULL)
+		{
+			index->slot = oldSlot;
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		}
+		index->size = 2*oldSize;
+
+		for(i = 0; i < oldSize; i++)
+		{
+			if(oldSlot[i].rule != NULL)
+				*findIndexSlot(index, oldSlot[i].rule, oldSlot[i].eventClass, oldSlot[i].qnameId) = oldSlot[i];
+		}
+		EXIP_MFREE(oldSlot);
+	}
+
+	slot = findIndexSlot(index, rule, eventClass, key);
+	if(slot->rule == NULL)
+	{
+		slot->rule = rule;
+		slot->eventClass = eventClass;
+		slot->qnameId = key;
+		index->count += 1;
+	}
+	slot->prodIndx = prodIndx;
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Adds the productions of a rule that are not indexed yet.
+ * The productions are added in order so each key ends up with the
+ * last matching production i.e. the one with the smallest event code.
+ */
+static errorCode indexRuleProductions(ProductionIndex* index, GrammarRule* rule)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	QNameID markKey = {URI_MAX, LN_MAX};
+	QNameID key;
+	struct ProductionIndexSlot* mark = findIndexSlot(index, rule, PROD_INDEX_RULE_MARK, markKey);
+	Index p = mark->rule != NULL ? mark->prodIndx : 0;
+	unsigned char eventClass;
+
+	if(p == rule->pCount)
+		return EXIP_OK;
+
+	for(; p < rule->pCount; p++)
+	{
+		eventClass = getProductionKey(&rule->production[p], &key);
+		TRY(setIndexSlot(index, rule, eventClass, key, p));
+	}
+
+	return setIndexSlot(index, rule, PROD_INDEX_RULE_MARK, markKey, rule->pCount);
+}
+
+/**
+ * @brief Finds the production with the smallest event code among the first prodCount
+ * of a rule that has the event class and, for SE and AT, matches the QName
+ * @param[in, out] strm EXI stream
+ * @param[in] rule the grammar rule
+ * @param[in] prodCount the number of productions with event code length 1 that can be used
+ * @param[in] eventClass the event class
+ * @param[in] qnameID the resolved QName of an SE or AT event
+ * @param[out] found whether a production is found
+ * @param[out] code the first part of the event code of the production
+ * @return Error handling code
+ */
+static errorCode findProduction(EXIStream* strm, GrammarRule* rule, Index prodCount, EventTypeClass eventClass,
+								QNameID* qnameID, boolean* found, Index* code)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Production* prod;
+	Index j;
+
+	*found = FALSE;
+
+	if(strm->prodIndex != NULL && rule->pCount >= PROD_INDEX_THRESHOLD)
+	{
+		QNameID key = {URI_MAX, LN_MAX};
+		struct ProductionIndexSlot* slot;
+		Index last = INDEX_MAX;
+
+		TRY(indexRuleProductions(strm->prodIndex, rule));
+
+		// SE(*)/AT(*) or the first production of the other event classes
+		slot = findIndexSlot(strm->prodIndex, rule, eventClass, key);
+		if(slot->rule != NULL)
+			last = slot->prodIndx;
+
+		if((eventClass == EVENT_SE_CLASS || eventClass == EVENT_AT_CLASS) && qnameID->uriId != URI_MAX)
+		{
+			// SE(uri:*)/AT(uri:*)
+			key.uriId = qnameID->uriId;
+			slot = findIndexSlot(strm->prodIndex, rule, eventClass, key);
+			if(slot->rule != NULL && (last == INDEX_MAX || slot->prodIndx > last))
+				last = slot->prodIndx;
+
+			if(qnameID->lnId != LN_MAX)
+			{
+				// SE(qname)/AT(qname)
+				key.lnId = qnameID->lnId;
+				slot = findIndexSlot(strm->prodIndex, rule, eventClass, key);
+				if(slot->rule != NULL && (last == INDEX_MAX || slot->prodIndx > last))
+					last = slot->prodIndx;
+			}
+		}
+
+		if(last != INDEX_MAX && rule->pCount - 1 - last < prodCount)
+		{
+			*found = TRUE;
+			*code = rule->pCount - 1 - last;
+		}
+
+		return EXIP_OK;
+	}
+
+	for(j = 0; j < prodCount; j++)
+	{
+		prod = &rule->production[rule->pCount - 1 - j];
+
+		if(GET_EVENT_CLASS(GET_PROD_EXI_EVENT(prod->content)) == eventClass &&
+				((eventClass != EVENT_SE_CLASS && eventClass != EVENT_AT_CLASS) || productionQNameMatch(prod->qnameId, qnameID)))
+		{
+			*found = TRUE;
+			*code = j;
+			break;
+		}
+	}
+
+	return EXIP_OK;
+}
+
+errorCode createProductionIndex(EXIStream* strm)
+{
+	destroyProductionIndex(strm);
+
+	strm->prodIndex = EXIP_MALLOC(sizeof(ProductionIndex));
+	if(strm->prodIndex == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	strm->prodIndex->slot = EXIP_CALLOC(PROD_INDEX_INITIAL_SIZE, sizeof(struct ProductionIndexSlot));
+	if(strm->prodIndex->slot == NULL)
+	{
+		EXIP_MFREE(strm->prodIndex);
+		strm->prodIndex = NULL;
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+	strm->prodIndex->size = PROD_INDEX_INITIAL_SIZE;
+	strm->prodIndex->count = 0;
+	memset(strm->prodIndex->qnameCache, 0, sizeof(strm->prodIndex->qnameCache));
+
+	return EXIP_OK;
+}
+
+void clearProductionIndex(EXIStream* strm)
+{
+	if(strm->prodIndex == NULL)
+		return;
+
+	memset(strm->prodIndex->slot, 0, sizeof(struct ProductionIndexSlot)*strm->prodIndex->size);
+	strm->prodIndex->count = 0;
+	memset(strm->prodIndex->qnameCache, 0, sizeof(strm->prodIndex->qnameCache));
+}
+
+void destroyProductionIndex(EXIStream* strm)
+{
+	if(strm->prodIndex != NULL)
+	{
+		EXIP_MFREE(strm->prodIndex->slot);
+		EXIP_MFREE(strm->prodIndex);
+		strm->prodIndex = NULL;
 	}
 }
 
 static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventClass,
-						GrammarRule* currentRule, QName* qname, EventCode ec, Production* prodHit)
+						GrammarRule* currentRule, QNameID* resolvedId, EventCode ec, Production* prodHit)
 {
 	QNameID qnameID;
 
@@ -291,15 +628,8 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 				ec.part[1] = 1;
 				strm->gStack->currNonTermID = GR_START_TAG_CONTENT;
 
-				if(!lookupUri(&strm->schema->uriTable, *qname->uri, &qnameID.uriId))
-				{
-					qnameID.uriId = strm->schema->uriTable.count;
-					qnameID.lnId = 0;
-				}
-				else if(!lookupLn(&strm->schema->uriTable.uri[qnameID.uriId].lnTable, *qname->localName,  &qnameID.lnId))
-				{
-					qnameID.lnId = strm->schema->uriTable.uri[qnameID.uriId].lnTable.count;
-				}
+				qnameID = *resolvedId;
+				getEncodedQNameID(strm, &qnameID);
 
 				// If eventType == AT(qname) and qname == xsi:type check first if there is no
 				// such production already at top level (see http://www.w3.org/XML/EXI/exi-10-errata#Substantive20120508)
@@ -324,7 +654,12 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 				strm->gStack->currNonTermID = GR_START_TAG_CONTENT;
 			break;
 			case EVENT_SC_CLASS:
-				return EXIP_NOT_IMPLEMENTED_YET;
+				if(strm->gStack->currNonTermID != GR_START_TAG_CONTENT || !WITH_SELF_CONTAINED(strm->header.opts.enumOpt))
+					return EXIP_INCONSISTENT_PROC_STATE;
+
+				// The content of the element is encoded as a fragment by selfContained()
+				SET_PROD_EXI_EVENT(prodHit->content, EVENT_SC);
+				ec.part[1] = 2 + IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES);
 			break;
 			case EVENT_SE_CLASS:
 				SET_PROD_EXI_EVENT(prodHit->content, EVENT_SE_ALL);
@@ -334,15 +669,8 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 					ec.part[1] = 0;
 				strm->gStack->currNonTermID = GR_ELEMENT_CONTENT;
 
-				if(!lookupUri(&strm->schema->uriTable, *qname->uri, &qnameID.uriId))
-				{
-					qnameID.uriId = strm->schema->uriTable.count;
-					qnameID.lnId = 0;
-				}
-				else if(!lookupLn(&strm->schema->uriTable.uri[qnameID.uriId].lnTable, *qname->localName,  &qnameID.lnId))
-				{
-					qnameID.lnId = strm->schema->uriTable.uri[qnameID.uriId].lnTable.count;
-				}
+				qnameID = *resolvedId;
+				getEncodedQNameID(strm, &qnameID);
 
 				TRY(insertZeroProduction((DynGrammarRule*) currentRule, EVENT_SE_QNAME, GR_ELEMENT_CONTENT, &qnameID, 1));
 			break;
@@ -418,9 +746,9 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 			// Strict mode
 			if(strm->gStack->currNonTermID != GR_START_TAG_CONTENT ||
 					eventClass != EVENT_AT_CLASS ||
-					!stringEqual(*qname->uri, XML_SCHEMA_INSTANCE))
+					resolvedId->uriId != XML_SCHEMA_INSTANCE_ID)
 				return EXIP_INCONSISTENT_PROC_STATE;
-			if(stringEqualToAscii(*qname->localName, "type"))
+			if(resolvedId->lnId == XML_SCHEMA_INSTANCE_TYPE_ID)
 			{
 				if(!HAS_NAMED_SUB_TYPE_OR_UNION(strm->gStack->grammar->props))
 					return EXIP_INCONSISTENT_PROC_STATE;
@@ -435,7 +763,7 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 				else
 					ec.bits[1] = 1;
 			}
-			else if(stringEqualToAscii(*qname->localName, "nil"))
+			else if(resolvedId->lnId == XML_SCHEMA_INSTANCE_NIL_ID)
 			{
 				if(!IS_NILLABLE(strm->gStack->grammar->props))
 					return EXIP_INCONSISTENT_PROC_STATE;
@@ -522,15 +850,8 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 				break;
 				case EVENT_AT_CLASS:
 
-					if(!lookupUri(&strm->schema->uriTable, *qname->uri, &qnameID.uriId))
-					{
-						qnameID.uriId = strm->schema->uriTable.count;
-						qnameID.lnId = 0;
-					}
-					else if(!lookupLn(&strm->schema->uriTable.uri[qnameID.uriId].lnTable, *qname->localName,  &qnameID.lnId))
-					{
-						qnameID.lnId = strm->schema->uriTable.uri[qnameID.uriId].lnTable.count;
-					}
+					qnameID = *resolvedId;
+					getEncodedQNameID(strm, &qnameID);
 
 					if(qnameID.uriId == XML_SCHEMA_INSTANCE_ID)
 					{
@@ -576,7 +897,14 @@ static errorCode stateMachineProdEncode(EXIStream* strm, EventTypeClass eventCla
 					strm->gStack->currNonTermID = GR_START_TAG_CONTENT;
 				break;
 				case EVENT_SC_CLASS:
-					return EXIP_NOT_IMPLEMENTED_YET;
+					if(strm->gStack->currNonTermID != GR_START_TAG_CONTENT || !WITH_SELF_CONTAINED(strm->header.opts.enumOpt))
+						return EXIP_INCONSISTENT_PROC_STATE;
+
+					// The content of the element is encoded as a fragment by selfContained()
+					SET_PROD_EXI_EVENT(prodHit->content, EVENT_SC);
+					ec.length = 2;
+					ec.part[1] = !RULE_CONTAIN_EE(currentRule->meta) + 4 + IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PREFIXES);
+					ec.bits[1] = getBitsNumber(prod2Count - 1);
 				break;
 				case EVENT_SE_CLASS:
 					// SE(*) content|same_rule
@@ -643,6 +971,22 @@ errorCode encodeQName(EXIStream* strm, QName qname, EventType eventT, QNameID* q
 	return encodePfxQName(strm, &qname, eventT, qnameID->uriId);
 }
 
+errorCode encodeQNameID(EXIStream* strm, QName* qname, QNameID qnameID, EventType eventT)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned char uriBits = getBitsNumber(strm->schema->uriTable.count);
+	unsigned char lnBits = getBitsNumber((unsigned int)(strm->schema->uriTable.uri[qnameID.uriId].lnTable.count - 1));
+
+	DEBUG_MSG(INFO, DEBUG_CONTENT_IO, (">Encoding QName ID\n"));
+
+	// Both the URI and the local name are string table hits
+	TRY(encodeNBitUnsignedInteger(strm, uriBits, qnameID.uriId + 1));
+	TRY(encodeUnsignedInteger(strm, 0));
+	TRY(encodeNBitUnsignedInteger(strm, lnBits, (unsigned int)(qnameID.lnId)));
+
+	return encodePfxQName(strm, qname, eventT, qnameID.uriId);
+}
+
 errorCode encodeUri(EXIStream* strm, String* uri, SmallIndex* uriId)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
@@ -677,7 +1021,10 @@ errorCode encodeLn(EXIStream* strm, String* ln, QNameID* qnameID)
 	else // local-name table miss
 	{
 		String copiedLN;
-		TRY(encodeUnsignedInteger(strm, (UnsignedInteger)(ln->length + 1)));
+		Index charCount;
+
+		TRY(countStringChars(ln, &charCount));
+		TRY(encodeUnsignedInteger(strm, (UnsignedInteger)(charCount + 1)));
 		TRY(encodeStringOnly(strm,  ln));
 
 		if(strm->schema->uriTable.uri[qnameID->uriId].lnTable.ln == NULL)
@@ -806,3 +1153,159 @@ errorCode encodeIntData(EXIStream* strm, Integer int_val, QNameID qnameID, Index
 	}
 	return EXIP_OK;
 }
+
+errorCode encodeBooleanData(EXIStream* strm, boolean bool_val, QNameID qnameID, Index typeId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIType exiType;
+
+	if(typeId != INDEX_MAX)
+		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
+	else
+		exiType = VALUE_TYPE_NONE;
+
+	if(exiType == VALUE_TYPE_BOOLEAN)
+	{
+		return encodeBoolean(strm, bool_val);
+	}
+	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
+	{
+		//       1) Print Warning
+		//       2) convert the boolean to sting
+		//       3) encode string
+		String tmpStr;
+
+		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Boolean to String conversion required \n"));
+#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
+		TRY(booleanToString(bool_val, &tmpStr));
+		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
+		EXIP_MFREE(tmpStr.str);
+#else
+		return EXIP_INVALID_EXI_INPUT;
+#endif
+	}
+	else
+	{
+	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a boolean\n"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	return EXIP_OK;
+}
+
+errorCode encodeFloatData(EXIStream* strm, Float float_val, QNameID qnameID, Index typeId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIType exiType;
+
+	if(typeId != INDEX_MAX)
+		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
+	else
+		exiType = VALUE_TYPE_NONE;
+
+	if(exiType == VALUE_TYPE_FLOAT)
+	{
+		return encodeFloatValue(strm, float_val);
+	}
+	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
+	{
+		//       1) Print Warning
+		//       2) convert the float to sting
+		//       3) encode string
+		String tmpStr;
+
+		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Float to String conversion required \n"));
+#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
+		TRY(floatToString(float_val, &tmpStr));
+		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
+		EXIP_MFREE(tmpStr.str);
+#else
+		return EXIP_INVALID_EXI_INPUT;
+#endif
+	}
+	else
+	{
+	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a float\n"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	return EXIP_OK;
+}
+
+errorCode encodeDecimalData(EXIStream* strm, Decimal dec_val, QNameID qnameID, Index typeId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIType exiType;
+
+	if(typeId != INDEX_MAX)
+		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
+	else
+		exiType = VALUE_TYPE_NONE;
+
+	if(exiType == VALUE_TYPE_DECIMAL)
+	{
+		return encodeDecimalValue(strm, dec_val);
+	}
+	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
+	{
+		//       1) Print Warning
+		//       2) convert the decimal to sting
+		//       3) encode string
+		String tmpStr;
+
+		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>Decimal to String conversion required \n"));
+#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
+		TRY(decimalToString(dec_val, &tmpStr));
+		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
+		EXIP_MFREE(tmpStr.str);
+#else
+		return EXIP_INVALID_EXI_INPUT;
+#endif
+	}
+	else
+	{
+	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a decimal\n"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	return EXIP_OK;
+}
+
+errorCode encodeDateTimeData(EXIStream* strm, EXIPDateTime dt_val, QNameID qnameID, Index typeId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIType exiType;
+
+	if(typeId != INDEX_MAX)
+		exiType = GET_EXI_TYPE(strm->schema->simpleTypeTable.sType[typeId].content);
+	else
+		exiType = VALUE_TYPE_NONE;
+
+	if(GET_EVENT_CLASS(exiType) == VALUE_TYPE_DATE_TIME_CLASS)
+	{
+		return encodeDateTimeValue(strm, exiType, dt_val);
+	}
+	else if(exiType == VALUE_TYPE_STRING || exiType == VALUE_TYPE_UNTYPED || exiType == VALUE_TYPE_NONE)
+	{
+		//       1) Print Warning
+		//       2) convert the dateTime to sting
+		//       3) encode string
+		String tmpStr;
+
+		DEBUG_MSG(WARNING, DEBUG_CONTENT_IO, ("\n>DateTime to String conversion required \n"));
+#if EXIP_IMPLICIT_DATA_TYPE_CONVERSION
+		TRY(dateTimeToString(dt_val, &tmpStr));
+		TRY(encodeStringData(strm, tmpStr, qnameID, typeId));
+		EXIP_MFREE(tmpStr.str);
+#else
+		return EXIP_INVALID_EXI_INPUT;
+#endif
+	}
+	else
+	{
+	    DEBUG_MSG(ERROR, DEBUG_CONTENT_IO, ("\n>Production type is not a dateTime\n"));
+		return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	return EXIP_OK;
+}
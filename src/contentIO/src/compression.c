@@ -0,0 +1,1055 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file compression.c
+ * @brief Implementation of the structure and value channels used
+ * by the compression and pre-compression alignment options
+ *
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#include "compression.h"
+
+#if COMPRESSION_USE
+
+#include "bodyEncode.h"
+#include "bodyDecode.h"
+#include "streamEncode.h"
+#include "streamWrite.h"
+#include "streamDeflate.h"
+#include "memManagement.h"
+#include "dynamicArray.h"
+#include "grammars.h"
+
+/** Size of the memory buffer used as strm->buffer while serializing in compression mode */
+#define CHANNEL_WORK_BUFFER_SIZE 1024
+#define INITIAL_CHANNEL_HASH_SIZE 16
+/** Number of values/events added each time the dynamic arrays are extended */
+#define CHANNEL_ENTRIES_CHUNK 512
+
+/** Kinds of recorded content handler events */
+enum ChannelEventKind
+{
+	CH_EVENT_END_DOC,
+	CH_EVENT_SE,
+	CH_EVENT_EE,
+	CH_EVENT_AT,
+	CH_EVENT_INT,
+	CH_EVENT_BOOL,
+	CH_EVENT_STRING,
+	CH_EVENT_FLOAT,
+	CH_EVENT_BINARY,
+	CH_EVENT_DATE_TIME,
+	CH_EVENT_DECIMAL,
+	CH_EVENT_LIST,
+	CH_EVENT_QNAME,
+	CH_EVENT_PI,
+	CH_EVENT_NS,
+	CH_EVENT_SC,
+	/** Placeholder for a value decoded from a value channel */
+	CH_EVENT_VALUE,
+	/** End of the events of one grammar production; flag is TRUE at the end of the stream */
+	CH_EVENT_PRODUCTION_END
+};
+
+static errorCode resetBlock(ChannelState* cs);
+static errorCode getChannel(ChannelState* cs, QNameID qnameID, Channel** channel);
+static errorCode addChannelValue(ChannelState* cs, QNameID qnameID, boolean isListItem, Index* valueId);
+static errorCode appendBytes(BinaryBuffer* buffer, const char* data, Index len);
+static size_t writeToPlain(void* buf, size_t size, void* stream);
+static void swapBuffer(EXIStream* strm, char* buf, Index len, Index content);
+static void restoreBuffer(EXIStream* strm);
+
+static errorCode encodeChannel(EXIStream* strm, Channel* channel);
+static errorCode deflateSegment(EXIStream* strm);
+
+static errorCode decodeChannelBlock(EXIStream* strm);
+static errorCode decodeChannel(EXIStream* strm, Channel* channel);
+static errorCode inflateSegment(EXIStream* strm);
+static errorCode reportEvent(EXIStream* strm, ChannelEvent* ev, ContentHandler* handler, void* app_data);
+static void initRecorder(ContentHandler* recorder);
+
+errorCode createChannels(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs;
+
+	cs = EXIP_MALLOC(sizeof(ChannelState));
+	if(cs == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	cs->hashSize = INITIAL_CHANNEL_HASH_SIZE;
+	cs->hashSlots = EXIP_MALLOC(cs->hashSize*sizeof(Index));
+	cs->workBuf = EXIP_MALLOC(CHANNEL_WORK_BUFFER_SIZE);
+	if(cs->hashSlots == NULL || cs->workBuf == NULL || initAllocList(&cs->blockMem) != EXIP_OK)
+	{
+		if(cs->hashSlots != NULL)
+			EXIP_MFREE(cs->hashSlots);
+		if(cs->workBuf != NULL)
+			EXIP_MFREE(cs->workBuf);
+		EXIP_MFREE(cs);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	cs->plain.buf = NULL;
+	cs->plain.bufLen = 0;
+	cs->plain.bufContent = 0;
+	cs->deflated = cs->plain;
+	cs->bufferSwapped = FALSE;
+	cs->inStructure = FALSE;
+	cs->structureEvents = 0;
+	cs->replayIndx = 0;
+	cs->handler = NULL;
+	cs->appData = NULL;
+	initRecorder(&cs->recorder);
+	strm->channels = cs;
+
+	// From here on destroyChannels() frees what is allocated
+	cs->channelList.ch = NULL;
+	cs->valueList.val = NULL;
+	cs->eventList.ev = NULL;
+	TRY(createDynArray(&cs->channelList.dynArray, sizeof(Channel), 16));
+	TRY(createDynArray(&cs->valueList.dynArray, sizeof(ChannelValue), CHANNEL_ENTRIES_CHUNK));
+	TRY(createDynArray(&cs->eventList.dynArray, sizeof(ChannelEvent), CHANNEL_ENTRIES_CHUNK));
+
+	return resetBlock(cs);
+}
+
+void destroyChannels(EXIStream* strm)
+{
+	ChannelState* cs = strm->channels;
+
+	if(cs == NULL)
+		return;
+
+	restoreBuffer(strm);
+
+	if(cs->channelList.ch != NULL)
+		destroyDynArray(&cs->channelList.dynArray);
+	if(cs->valueList.val != NULL)
+		destroyDynArray(&cs->valueList.dynArray);
+	if(cs->eventList.ev != NULL)
+		destroyDynArray(&cs->eventList.dynArray);
+	freeAllocList(&cs->blockMem);
+
+	if(cs->plain.buf != NULL)
+		EXIP_MFREE(cs->plain.buf);
+	if(cs->deflated.buf != NULL)
+		EXIP_MFREE(cs->deflated.buf);
+	EXIP_MFREE(cs->hashSlots);
+	EXIP_MFREE(cs->workBuf);
+	EXIP_MFREE(cs);
+	strm->channels = NULL;
+}
+
+void resetChannels(EXIStream* strm)
+{
+	ChannelState* cs = strm->channels;
+
+	if(cs == NULL)
+		return;
+
+	restoreBuffer(strm);
+	resetBlock(cs);
+	cs->plain.bufContent = 0;
+	cs->deflated.bufContent = 0;
+	cs->inStructure = FALSE;
+	cs->handler = NULL;
+	cs->appData = NULL;
+}
+
+/*********************** Serializing ***********************/
+
+errorCode beginChannelBlock(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	if(strm->context.bitPointer != 0)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	TRY(resetBlock(strm->channels));
+
+	if(WITH_COMPRESSION(strm->header.opts.enumOpt))
+	{
+		// The block is encoded in the plain buffer and DEFLATE-ed when closed
+		swapBuffer(strm, strm->channels->workBuf, CHANNEL_WORK_BUFFER_SIZE, 0);
+		strm->buffer.ioStrm.readWriteToStream = writeToPlain;
+		strm->buffer.ioStrm.stream = strm->channels;
+	}
+
+	return EXIP_OK;
+}
+
+errorCode deferValueItem(EXIStream* strm, EXITypeClass valueClass, ChannelData* data, QNameID qnameID, Index typeId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	boolean isListItem = cs->listItemsLeft > 0;
+	ChannelValue* val;
+	Index valueId;
+
+	TRY(addChannelValue(cs, qnameID, isListItem, &valueId));
+	val = &cs->valueList.val[valueId];
+	val->valueClass = valueClass;
+	val->typeId = typeId;
+	val->data = *data;
+
+	// The caller owns the string and binary values so they are copied
+	if(valueClass == VALUE_TYPE_STRING_CLASS && data->strVal.length > 0)
+	{
+		val->data.strVal.str = memManagedAllocate(&cs->blockMem, data->strVal.length*sizeof(CharType));
+		if(val->data.strVal.str == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(val->data.strVal.str, data->strVal.str, data->strVal.length*sizeof(CharType));
+	}
+	else if(valueClass == VALUE_TYPE_BINARY_CLASS && data->binVal.len > 0)
+	{
+		val->data.binVal.buf = memManagedAllocate(&cs->blockMem, data->binVal.len);
+		if(val->data.binVal.buf == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(val->data.binVal.buf, data->binVal.buf, data->binVal.len);
+	}
+
+	if(isListItem)
+		cs->listItemsLeft -= 1;
+	else if(valueClass == VALUE_TYPE_LIST_CLASS)
+		cs->listItemsLeft = data->itemCount;
+
+	// A block is complete after blockSize values, the items of a list belong to the block of the list
+	if(cs->blockValues >= strm->header.opts.blockSize && cs->listItemsLeft == 0)
+	{
+		TRY(closeChannelBlock(strm));
+		TRY(beginChannelBlock(strm));
+	}
+
+	return EXIP_OK;
+}
+
+errorCode closeChannelBlock(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	boolean hasSmall = FALSE;
+	Index i;
+
+	if(cs->blockValues <= SMALL_CHANNEL_VALUES)
+	{
+		// The structure and all value channels form a single stream
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			TRY(encodeChannel(strm, &cs->channelList.ch[i]));
+		}
+		TRY(deflateSegment(strm));
+	}
+	else
+	{
+		// The structure channel, then all small channels together
+		// and then each of the channels with more than 100 values
+		TRY(deflateSegment(strm));
+
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			if(cs->channelList.ch[i].valueCount <= SMALL_CHANNEL_VALUES)
+			{
+				hasSmall = TRUE;
+				TRY(encodeChannel(strm, &cs->channelList.ch[i]));
+			}
+		}
+		if(hasSmall)
+		{
+			TRY(deflateSegment(strm));
+		}
+
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			if(cs->channelList.ch[i].valueCount > SMALL_CHANNEL_VALUES)
+			{
+				TRY(encodeChannel(strm, &cs->channelList.ch[i]));
+				TRY(deflateSegment(strm));
+			}
+		}
+	}
+
+	if(cs->bufferSwapped)
+	{
+		restoreBuffer(strm);
+		TRY(writeBytes(strm, (unsigned char*) cs->deflated.buf, cs->deflated.bufContent));
+		cs->deflated.bufContent = 0;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode encodeChannel(EXIStream* strm, Channel* channel)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelValue* val;
+	Index v;
+
+	for(v = channel->head; v != INDEX_MAX; v = val->next)
+	{
+		val = &strm->channels->valueList.val[v];
+
+		switch(val->valueClass)
+		{
+			case VALUE_TYPE_INTEGER_CLASS:
+				TRY(encodeIntData(strm, val->data.intVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_BOOLEAN_CLASS:
+				TRY(encodeBooleanData(strm, val->data.boolVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_STRING_CLASS:
+				TRY(encodeStringData(strm, val->data.strVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_FLOAT_CLASS:
+				TRY(encodeFloatData(strm, val->data.floatVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_BINARY_CLASS:
+				TRY(encodeBinary(strm, val->data.binVal.buf, val->data.binVal.len));
+			break;
+			case VALUE_TYPE_DATE_TIME_CLASS:
+				TRY(encodeDateTimeData(strm, val->data.dtVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_DECIMAL_CLASS:
+				TRY(encodeDecimalData(strm, val->data.decVal, val->qnameID, val->typeId));
+			break;
+			case VALUE_TYPE_LIST_CLASS:
+				TRY(encodeUnsignedInteger(strm, (UnsignedInteger) val->data.itemCount));
+			break;
+			default:
+				return EXIP_INCONSISTENT_PROC_STATE;
+		}
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Ends the current DEFLATE stream of the block in compression mode.
+ * In pre-compression mode the channels are written directly to the output.
+ */
+static errorCode deflateSegment(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+
+	if(!cs->bufferSwapped)
+		return EXIP_OK;
+
+	TRY(appendBytes(&cs->plain, strm->buffer.buf, strm->context.bufferIndx));
+	strm->context.bufferIndx = 0;
+
+	TRY(deflateData((unsigned char*) cs->plain.buf, cs->plain.bufContent, &cs->deflated));
+	cs->plain.bufContent = 0;
+
+	return EXIP_OK;
+}
+
+static size_t writeToPlain(void* buf, size_t size, void* stream)
+{
+	if(appendBytes(&((ChannelState*) stream)->plain, buf, size) != EXIP_OK)
+		return 0;
+	return size;
+}
+
+/*********************** Parsing ***********************/
+
+errorCode addValuePlaceholder(EXIStream* strm, Index typeId, QNameID qnameID)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	ChannelEvent* ev;
+	Index valueId;
+	Index evId;
+
+	TRY(addChannelValue(cs, qnameID, FALSE, &valueId));
+	cs->valueList.val[valueId].typeId = typeId;
+	cs->valueList.val[valueId].firstEvent = 0;
+	cs->valueList.val[valueId].eventCount = 0;
+
+	TRY(addEmptyDynEntry(&cs->eventList.dynArray, (void**) &ev, &evId));
+	ev->kind = CH_EVENT_VALUE;
+	ev->data.valueId = valueId;
+
+	return EXIP_OK;
+}
+
+errorCode decodeChannelEvent(EXIStream* strm, ContentHandler* handler, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	ChannelEvent* ev;
+	Index i;
+
+	if(cs->replayIndx == cs->structureEvents)
+	{
+		// All the events of the block are reported
+		if(strm->gStack == NULL)
+			return EXIP_INCONSISTENT_PROC_STATE;
+
+		cs->handler = handler;
+		cs->appData = app_data;
+		TRY(decodeChannelBlock(strm));
+	}
+
+	while(cs->replayIndx < cs->structureEvents)
+	{
+		ev = &cs->eventList.ev[cs->replayIndx];
+		cs->replayIndx += 1;
+
+		if(ev->kind == CH_EVENT_PRODUCTION_END)
+		{
+			return ev->flag ? EXIP_PARSING_COMPLETE : EXIP_OK;
+		}
+		else if(ev->kind == CH_EVENT_VALUE)
+		{
+			ChannelValue* val = &cs->valueList.val[ev->data.valueId];
+
+			for(i = val->firstEvent; i < val->firstEvent + val->eventCount; i++)
+			{
+				TRY(reportEvent(strm, &cs->eventList.ev[i], handler, app_data));
+			}
+		}
+		else
+		{
+			TRY(reportEvent(strm, ev, handler, app_data));
+		}
+	}
+
+	return EXIP_OK;
+}
+
+errorCode skipChannelElement(EXIStream* strm, ContentHandler* handler, void* app_data, unsigned int* depth)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	ChannelEvent* ev;
+
+	// The block is already decoded: the skipped events are just passed over
+	while(TRUE)
+	{
+		if(cs->replayIndx == cs->structureEvents)
+		{
+			if(strm->gStack == NULL)
+				return EXIP_INCONSISTENT_PROC_STATE;
+
+			cs->handler = handler;
+			cs->appData = app_data;
+			TRY(decodeChannelBlock(strm));
+		}
+
+		ev = &cs->eventList.ev[cs->replayIndx];
+		cs->replayIndx += 1;
+
+		if(ev->kind == CH_EVENT_SE)
+			*depth += 1;
+		else if(ev->kind == CH_EVENT_EE)
+			*depth -= 1;
+		else if(ev->kind == CH_EVENT_PRODUCTION_END)
+		{
+			if(ev->flag)
+				return EXIP_PARSING_COMPLETE;
+			if(*depth == 0)
+				return EXIP_OK;
+		}
+	}
+}
+
+static errorCode decodeChannelBlock(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	SmallIndex nonTermID;
+	ChannelEvent* ev;
+	Index evId;
+	boolean hasSmall = FALSE;
+	Index i;
+
+	TRY(resetBlock(cs));
+	TRY(inflateSegment(strm));
+
+	// The structure channel: the values are replaced by placeholders
+	// until blockSize values are found or the end of the stream
+	cs->inStructure = TRUE;
+	do
+	{
+		nonTermID = GR_VOID_NON_TERMINAL;
+		TRY(processNextProduction(strm, &nonTermID, &cs->recorder, cs));
+
+		if(nonTermID == GR_VOID_NON_TERMINAL)
+			popGrammar(&(strm->gStack));
+		else
+			strm->gStack->currNonTermID = nonTermID;
+
+		TRY(addEmptyDynEntry(&cs->eventList.dynArray, (void**) &ev, &evId));
+		ev->kind = CH_EVENT_PRODUCTION_END;
+		ev->flag = strm->gStack == NULL;
+	}
+	while(strm->gStack != NULL && cs->blockValues < strm->header.opts.blockSize);
+	cs->inStructure = FALSE;
+	cs->structureEvents = cs->eventList.count;
+
+	// The value channels in the same order as when serializing
+	if(cs->blockValues <= SMALL_CHANNEL_VALUES)
+	{
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			TRY(decodeChannel(strm, &cs->channelList.ch[i]));
+		}
+	}
+	else
+	{
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			if(cs->channelList.ch[i].valueCount <= SMALL_CHANNEL_VALUES)
+			{
+				if(!hasSmall)
+				{
+					hasSmall = TRUE;
+					TRY(inflateSegment(strm));
+				}
+				TRY(decodeChannel(strm, &cs->channelList.ch[i]));
+			}
+		}
+
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			if(cs->channelList.ch[i].valueCount > SMALL_CHANNEL_VALUES)
+			{
+				TRY(inflateSegment(strm));
+				TRY(decodeChannel(strm, &cs->channelList.ch[i]));
+			}
+		}
+	}
+
+	restoreBuffer(strm);
+
+	return EXIP_OK;
+}
+
+static errorCode decodeChannel(EXIStream* strm, Channel* channel)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+	SmallIndex nonTermID;
+	Index firstEvent;
+	Index v;
+
+	for(v = channel->head; v != INDEX_MAX; v = cs->valueList.val[v].next)
+	{
+		firstEvent = cs->eventList.count;
+		TRY(decodeValueItem(strm, cs->valueList.val[v].typeId, &cs->recorder, &nonTermID, cs->valueList.val[v].qnameID, cs));
+		cs->valueList.val[v].firstEvent = firstEvent;
+		cs->valueList.val[v].eventCount = cs->eventList.count - firstEvent;
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * @brief Inflates the next DEFLATE stream of the block in compression mode
+ * and continues parsing from the inflated data
+ */
+static errorCode inflateSegment(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = strm->channels;
+
+	if(!WITH_COMPRESSION(strm->header.opts.enumOpt))
+		return EXIP_OK;
+
+	restoreBuffer(strm);
+	cs->plain.bufContent = 0;
+	TRY(inflateData(strm, &cs->plain));
+	swapBuffer(strm, cs->plain.buf, cs->plain.bufContent, cs->plain.bufContent);
+
+	return EXIP_OK;
+}
+
+static errorCode reportEvent(EXIStream* strm, ChannelEvent* ev, ContentHandler* handler, void* app_data)
+{
+	QName qname;
+
+	qname.uri = &ev->uri;
+	qname.localName = &ev->ln;
+	qname.prefix = ev->flag ? &ev->pfx : NULL;
+
+	switch(ev->kind)
+	{
+		case CH_EVENT_END_DOC:
+			if(handler->endDocument != NULL)
+				return handler->endDocument(app_data);
+		break;
+		case CH_EVENT_SE:
+			if(handler->startElement != NULL)
+				return checkSkipRequest(strm, handler->startElement(qname, app_data));
+		break;
+		case CH_EVENT_EE:
+			if(handler->endElement != NULL)
+				return handler->endElement(app_data);
+		break;
+		case CH_EVENT_AT:
+			if(handler->attribute != NULL)
+				return handler->attribute(qname, app_data);
+		break;
+		case CH_EVENT_INT:
+			if(handler->intData != NULL)
+				return handler->intData(ev->data.intVal, app_data);
+		break;
+		case CH_EVENT_BOOL:
+			if(handler->booleanData != NULL)
+				return handler->booleanData(ev->data.boolVal, app_data);
+		break;
+		case CH_EVENT_STRING:
+			if(handler->stringData != NULL)
+				return handler->stringData(ev->data.strVal, app_data);
+		break;
+		case CH_EVENT_FLOAT:
+			if(handler->floatData != NULL)
+				return handler->floatData(ev->data.floatVal, app_data);
+		break;
+		case CH_EVENT_BINARY:
+			if(strm->binaryChunks.chunkSize > 0 && handler->binaryDataChunk != NULL)
+			{
+				// The value is already decoded: report it in slices
+				errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+				Index offset = 0;
+				Index n;
+
+				do
+				{
+					n = ev->data.binVal.len - offset;
+					if(n > strm->binaryChunks.chunkSize)
+						n = strm->binaryChunks.chunkSize;
+					TRY(handler->binaryDataChunk(ev->data.binVal.buf + offset, n, offset, ev->data.binVal.len, app_data));
+					offset += n;
+				}
+				while(offset < ev->data.binVal.len);
+
+				return EXIP_OK;
+			}
+			else if(handler->binaryData != NULL)
+				return handler->binaryData(ev->data.binVal.buf, ev->data.binVal.len, app_data);
+		break;
+		case CH_EVENT_DATE_TIME:
+			if(handler->dateTimeData != NULL)
+				return handler->dateTimeData(ev->data.dtVal, app_data);
+		break;
+		case CH_EVENT_DECIMAL:
+			if(handler->decimalData != NULL)
+				return handler->decimalData(ev->data.decVal, app_data);
+		break;
+		case CH_EVENT_LIST:
+			if(handler->listData != NULL)
+				return handler->listData((EXITypeClass) ev->uri.length, ev->data.itemCount, app_data);
+		break;
+		case CH_EVENT_QNAME:
+			if(handler->qnameData != NULL)
+				return handler->qnameData(qname, app_data);
+		break;
+		case CH_EVENT_PI:
+			if(handler->processingInstruction != NULL)
+				return handler->processingInstruction(app_data);
+		break;
+		case CH_EVENT_NS:
+			if(handler->namespaceDeclaration != NULL)
+				return handler->namespaceDeclaration(ev->uri, ev->pfx, ev->data.boolVal, app_data);
+		break;
+		case CH_EVENT_SC:
+			if(handler->selfContained != NULL)
+				return handler->selfContained(app_data);
+		break;
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+
+	return EXIP_OK;
+}
+
+/*********************** Event recorder ***********************/
+
+static errorCode recordEvent(ChannelState* cs, unsigned char kind, ChannelEvent** ev)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index evId;
+
+	TRY(addEmptyDynEntry(&cs->eventList.dynArray, (void**) ev, &evId));
+	(*ev)->kind = kind;
+	(*ev)->flag = FALSE;
+
+	return EXIP_OK;
+}
+
+/** The QName strings point to the string tables and do not need to be copied */
+static errorCode recordQName(ChannelState* cs, unsigned char kind, QName qname)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent(cs, kind, &ev));
+	ev->uri = *qname.uri;
+	ev->ln = *qname.localName;
+	if(qname.prefix != NULL)
+	{
+		ev->flag = TRUE;
+		ev->pfx = *qname.prefix;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode recEndDocument(void* app_data)
+{
+	ChannelEvent* ev;
+	return recordEvent((ChannelState*) app_data, CH_EVENT_END_DOC, &ev);
+}
+
+static errorCode recStartElement(QName qname, void* app_data)
+{
+	return recordQName((ChannelState*) app_data, CH_EVENT_SE, qname);
+}
+
+static errorCode recEndElement(void* app_data)
+{
+	ChannelEvent* ev;
+	return recordEvent((ChannelState*) app_data, CH_EVENT_EE, &ev);
+}
+
+static errorCode recAttribute(QName qname, void* app_data)
+{
+	return recordQName((ChannelState*) app_data, CH_EVENT_AT, qname);
+}
+
+static errorCode recIntData(Integer int_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_INT, &ev));
+	ev->data.intVal = int_val;
+	return EXIP_OK;
+}
+
+static errorCode recBooleanData(boolean bool_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_BOOL, &ev));
+	ev->data.boolVal = bool_val;
+	return EXIP_OK;
+}
+
+/** The decoded string values can be freed after the callback so they are copied */
+static errorCode recStringData(const String str_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = (ChannelState*) app_data;
+	ChannelEvent* ev;
+
+	TRY(recordEvent(cs, CH_EVENT_STRING, &ev));
+	ev->data.strVal = str_val;
+	if(str_val.length > 0)
+	{
+		ev->data.strVal.str = memManagedAllocate(&cs->blockMem, str_val.length*sizeof(CharType));
+		if(ev->data.strVal.str == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(ev->data.strVal.str, str_val.str, str_val.length*sizeof(CharType));
+	}
+	return EXIP_OK;
+}
+
+static errorCode recFloatData(Float float_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_FLOAT, &ev));
+	ev->data.floatVal = float_val;
+	return EXIP_OK;
+}
+
+static errorCode recBinaryData(const char* binary_val, Index nbytes, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelState* cs = (ChannelState*) app_data;
+	ChannelEvent* ev;
+
+	TRY(recordEvent(cs, CH_EVENT_BINARY, &ev));
+	ev->data.binVal.buf = NULL;
+	ev->data.binVal.len = nbytes;
+	if(nbytes > 0)
+	{
+		ev->data.binVal.buf = memManagedAllocate(&cs->blockMem, nbytes);
+		if(ev->data.binVal.buf == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		memcpy(ev->data.binVal.buf, binary_val, nbytes);
+	}
+	return EXIP_OK;
+}
+
+static errorCode recDateTimeData(EXIPDateTime dt_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_DATE_TIME, &ev));
+	ev->data.dtVal = dt_val;
+	return EXIP_OK;
+}
+
+static errorCode recDecimalData(Decimal dec_val, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_DECIMAL, &ev));
+	ev->data.decVal = dec_val;
+	return EXIP_OK;
+}
+
+static errorCode recListData(EXITypeClass exiType, unsigned int itemCount, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_LIST, &ev));
+	// The item type is kept in the uri length as the union holds the item count
+	ev->data.itemCount = itemCount;
+	ev->uri.length = (Index) exiType;
+	return EXIP_OK;
+}
+
+static errorCode recQnameData(const QName qname, void* app_data)
+{
+	return recordQName((ChannelState*) app_data, CH_EVENT_QNAME, qname);
+}
+
+static errorCode recProcessingInstruction(void* app_data)
+{
+	ChannelEvent* ev;
+	return recordEvent((ChannelState*) app_data, CH_EVENT_PI, &ev);
+}
+
+static errorCode recNamespaceDeclaration(const String ns, const String prefix, boolean isLocalElementNS, void* app_data)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	ChannelEvent* ev;
+
+	TRY(recordEvent((ChannelState*) app_data, CH_EVENT_NS, &ev));
+	ev->uri = ns;
+	ev->pfx = prefix;
+	ev->data.boolVal = isLocalElementNS;
+	return EXIP_OK;
+}
+
+static errorCode recSelfContained(void* app_data)
+{
+	ChannelEvent* ev;
+	return recordEvent((ChannelState*) app_data, CH_EVENT_SC, &ev);
+}
+
+/** Errors and warnings are reported immediately to the application */
+static errorCode recWarning(const errorCode code, const char* msg, void* app_data)
+{
+	ChannelState* cs = (ChannelState*) app_data;
+	if(cs->handler->warning != NULL)
+		return cs->handler->warning(code, msg, cs->appData);
+	return EXIP_OK;
+}
+
+static errorCode recError(const errorCode code, const char* msg, void* app_data)
+{
+	ChannelState* cs = (ChannelState*) app_data;
+	if(cs->handler->error != NULL)
+		return cs->handler->error(code, msg, cs->appData);
+	return EXIP_OK;
+}
+
+static errorCode recFatalError(const errorCode code, const char* msg, void* app_data)
+{
+	ChannelState* cs = (ChannelState*) app_data;
+	if(cs->handler->fatalError != NULL)
+		return cs->handler->fatalError(code, msg, cs->appData);
+	return EXIP_OK;
+}
+
+static void initRecorder(ContentHandler* recorder)
+{
+	initContentHandler(recorder);
+	recorder->endDocument = recEndDocument;
+	recorder->startElement = recStartElement;
+	recorder->endElement = recEndElement;
+	recorder->attribute = recAttribute;
+	recorder->intData = recIntData;
+	recorder->booleanData = recBooleanData;
+	recorder->stringData = recStringData;
+	recorder->floatData = recFloatData;
+	recorder->binaryData = recBinaryData;
+	recorder->dateTimeData = recDateTimeData;
+	recorder->decimalData = recDecimalData;
+	recorder->listData = recListData;
+	recorder->qnameData = recQnameData;
+	recorder->processingInstruction = recProcessingInstruction;
+	recorder->namespaceDeclaration = recNamespaceDeclaration;
+	recorder->warning = recWarning;
+	recorder->error = recError;
+	recorder->fatalError = recFatalError;
+	recorder->selfContained = recSelfContained;
+}
+
+/*********************** Common ***********************/
+
+static errorCode resetBlock(ChannelState* cs)
+{
+	resetAllocList(&cs->blockMem);
+	cs->channelList.count = 0;
+	cs->valueList.count = 0;
+	cs->eventList.count = 0;
+	cs->structureEvents = 0;
+	cs->replayIndx = 0;
+	cs->blockValues = 0;
+	cs->listItemsLeft = 0;
+	memset(cs->hashSlots, 0, cs->hashSize*sizeof(Index));
+
+	return EXIP_OK;
+}
+
+#define CHANNEL_HASH(qnameID) ((Index) (((qnameID).uriId*0x9E3779B1u) ^ ((qnameID).lnId*0x85EBCA77u)))
+
+static errorCode getChannel(ChannelState* cs, QNameID qnameID, Channel** channel)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index slot = CHANNEL_HASH(qnameID) & (cs->hashSize - 1);
+	Index chId;
+
+	while(cs->hashSlots[slot] != 0)
+	{
+		*channel = &cs->channelList.ch[cs->hashSlots[slot] - 1];
+		if((*channel)->qnameID.uriId == qnameID.uriId && (*channel)->qnameID.lnId == qnameID.lnId)
+			return EXIP_OK;
+		slot = (slot + 1) & (cs->hashSize - 1);
+	}
+
+	// A new channel
+	TRY(addEmptyDynEntry(&cs->channelList.dynArray, (void**) channel, &chId));
+	(*channel)->qnameID = qnameID;
+	(*channel)->valueCount = 0;
+	(*channel)->head = INDEX_MAX;
+	(*channel)->tail = INDEX_MAX;
+	cs->hashSlots[slot] = chId + 1;
+
+	// Keep the load factor below 1/2
+	if(2*cs->channelList.count > cs->hashSize)
+	{
+		Index* newSlots = EXIP_MALLOC(2*cs->hashSize*sizeof(Index));
+		Index i;
+
+		if(newSlots == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+
+		EXIP_MFREE(cs->hashSlots);
+		cs->hashSlots = newSlots;
+		cs->hashSize = 2*cs->hashSize;
+		memset(cs->hashSlots, 0, cs->hashSize*sizeof(Index));
+		for(i = 0; i < cs->channelList.count; i++)
+		{
+			slot = CHANNEL_HASH(cs->channelList.ch[i].qnameID) & (cs->hashSize - 1);
+			while(cs->hashSlots[slot] != 0)
+				slot = (slot + 1) & (cs->hashSize - 1);
+			cs->hashSlots[slot] = i + 1;
+		}
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode addChannelValue(ChannelState* cs, QNameID qnameID, boolean isListItem, Index* valueId)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Channel* channel;
+	ChannelValue* val;
+
+	TRY(getChannel(cs, qnameID, &channel));
+	TRY(addEmptyDynEntry(&cs->valueList.dynArray, (void**) &val, valueId));
+	val->qnameID = qnameID;
+	val->next = INDEX_MAX;
+
+	if(channel->tail == INDEX_MAX)
+		channel->head = *valueId;
+	else
+		cs->valueList.val[channel->tail].next = *valueId;
+	channel->tail = *valueId;
+
+	if(!isListItem)
+	{
+		channel->valueCount += 1;
+		cs->blockValues += 1;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode appendBytes(BinaryBuffer* buffer, const char* data, Index len)
+{
+	if(buffer->bufContent + len > buffer->bufLen)
+	{
+		Index newLen = buffer->bufLen == 0 ? CHANNEL_WORK_BUFFER_SIZE : buffer->bufLen;
+		char* newBuf;
+
+		while(newLen < buffer->bufContent + len)
+			newLen = 2*newLen;
+
+		newBuf = EXIP_REALLOC(buffer->buf, newLen);
+		if(newBuf == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+		buffer->buf = newBuf;
+		buffer->bufLen = newLen;
+	}
+
+	memcpy(buffer->buf + buffer->bufContent, data, len);
+	buffer->bufContent += len;
+
+	return EXIP_OK;
+}
+
+/** Replaces strm->buffer with a memory only buffer. The stream buffer is restored by restoreBuffer() */
+static void swapBuffer(EXIStream* strm, char* buf, Index len, Index content)
+{
+	ChannelState* cs = strm->channels;
+
+	cs->savedBuffer = strm->buffer;
+	cs->savedBufferIndx = strm->context.bufferIndx;
+	cs->savedBitPointer = strm->context.bitPointer;
+	cs->bufferSwapped = TRUE;
+
+	strm->buffer.buf = buf;
+	strm->buffer.bufLen = len;
+	strm->buffer.bufContent = content;
+	strm->buffer.ioStrm.readWriteToStream = NULL;
+	strm->buffer.ioStrm.stream = NULL;
+	strm->buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	strm->context.bufferIndx = 0;
+	strm->context.bitPointer = 0;
+}
+
+static void restoreBuffer(EXIStream* strm)
+{
+	ChannelState* cs = strm->channels;
+
+	if(!cs->bufferSwapped)
+		return;
+
+	strm->buffer = cs->savedBuffer;
+	strm->context.bufferIndx = cs->savedBufferIndx;
+	strm->context.bitPointer = cs->savedBitPointer;
+	cs->bufferSwapped = FALSE;
+}
+
+#endif /* COMPRESSION_USE */
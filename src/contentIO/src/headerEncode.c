@@ -72,6 +72,19 @@ errorCode encodeHeader(EXIStream* strm)
 
 		makeDefaultOpts(&options_strm.header.opts);
 		SET_STRICT(options_strm.header.opts.enumOpt);
+		setEncodePrimitives(&options_strm);
+		options_strm.decodePrim = NULL;
+		options_strm.valueArena = NULL;
+		options_strm.dispatch = NULL;
+		options_strm.prodIndex = NULL;
+		options_strm.selfContained = NULL;
+		options_strm.scIndex = NULL;
+		options_strm.scGrammar = NULL;
+#if STATIC_CODEC_USE
+		options_strm.codec = NULL;
+#endif
+		options_strm.tablesMark.uriCount = 0;
+		options_strm.tablesMark.uri = NULL;
 		TRY(initAllocList(&options_strm.memList));
 
 		options_strm.buffer = strm->buffer;
@@ -82,7 +95,15 @@ errorCode encodeHeader(EXIStream* strm)
 		options_strm.context.expectATData = FALSE;
 		options_strm.context.isNilType = FALSE;
 		options_strm.context.attrTypeId = 0;
+		options_strm.context.skipValues = FALSE;
+		options_strm.context.skipRequested = FALSE;
+		options_strm.context.skipOffset = 0;
+		options_strm.context.bufferOffset = strm->context.bufferOffset;
+		options_strm.context.elementCount = 0;
 		options_strm.gStack = NULL;
+#if COMPRESSION_USE
+		options_strm.channels = NULL;
+#endif
 		options_strm.schema = (EXIPSchema*) &ops_schema;
 
 		TRY_CATCH(createValueTable(&options_strm.valueTable), closeStream(&options_strm));
@@ -92,6 +113,7 @@ errorCode encodeHeader(EXIStream* strm)
 		strm->buffer.bufContent = options_strm.buffer.bufContent;
 		strm->context.bitPointer = options_strm.context.bitPointer;
 		strm->context.bufferIndx = options_strm.context.bufferIndx;
+		strm->context.bufferOffset = options_strm.context.bufferOffset;
 
 		if(WITH_COMPRESSION(strm->header.opts.enumOpt) ||
 				GET_ALIGNMENT(strm->header.opts.enumOpt) != BIT_PACKED)
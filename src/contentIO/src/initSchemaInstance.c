@@ -48,9 +48,16 @@ errorCode initSchema(EXIPSchema* schema, InitSchemaType initializationType)
 	schema->grammarTable.grammar = NULL;
 	schema->enumTable.count = 0;
 	schema->enumTable.enumDef = NULL;
+#if STATIC_CODEC_USE
+	schema->codec = NULL;
+#endif
 
 	/* Create and initialize initial string table entries */
 	TRY_CATCH(createDynArray(&schema->uriTable.dynArray, sizeof(UriEntry), DEFAULT_URI_ENTRIES_NUMBER), freeAllocList(&schema->memList));
+#if STRING_TABLE_HASH_USE
+	schema->uriTable.hashIndex.slots = NULL;
+	schema->uriTable.hashIndex.size = 0;
+#endif
 	TRY_CATCH(createUriTableEntries(&schema->uriTable, initializationType != INIT_SCHEMA_SCHEMA_LESS_MODE), freeAllocList(&schema->memList));
 
 	if(initializationType == INIT_SCHEMA_SCHEMA_ENABLED)
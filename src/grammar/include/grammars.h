@@ -81,6 +81,39 @@ errorCode createDocGrammar(EXIPSchema* schema, QNameID* elQnameArr, Index qnameC
  */
 errorCode createFragmentGrammar(EXIPSchema* schema, QNameID* elQnameArr, Index qnameCount);
 
+/**
+ * @brief Pushes on the grammar stack the fragment grammar that holds the content
+ * of a self-contained element. In schema-less streams it is the Built-in Fragment Grammar:
+ * SE (*) with GR_SC_FRAGMENT_END as right-hand side and ED. In schema-informed streams it
+ * is the Schema-informed Fragment Grammar with an SE (qname) for each element declaration,
+ * which uses the grammar of the declaration, before SE (*) and ED; it is created on the first call.
+ * The ED at GR_SC_FRAGMENT_END is processed by the caller.
+ *
+ * @param[in, out] strm EXI stream
+ * @return Error handling code
+ */
+errorCode pushSelfContainedFragment(EXIStream* strm);
+
+/**
+ * @brief Returns the event code of the SE (qname) of an element with the given grammar in the
+ * schema-informed fragment grammar of a self-contained element on top of the grammar stack
+ *
+ * @param[in] strm EXI stream
+ * @param[in] qnameId the QName IDs of the element
+ * @param[in] grammar the grammar of the element
+ * @return the event code; INDEX_MAX if there is no such production
+ */
+Index getSelfContainedCode(EXIStream* strm, QNameID qnameId, EXIGrammar* grammar);
+
+/**
+ * @brief Returns the number of productions of the fragment grammar of a self-contained
+ * element when the element ends; the ED that ends the fragment is the last one
+ *
+ * @param[in] fragment the fragment grammar pushed by pushSelfContainedFragment()
+ * @return the number of productions of FragmentContent
+ */
+Index getSelfContainedEndCount(EXIGrammar* fragment);
+
 #if BUILD_IN_GRAMMARS_USE
 	/**
 	 * @brief Creates an instance of EXI Built-in Element Grammar
@@ -116,6 +149,34 @@ errorCode createFragmentGrammar(EXIPSchema* schema, QNameID* elQnameArr, Index q
  */
 unsigned int getBitsFirstPartCode(EXIStream* strm, Index prodCount, SmallIndex currentRuleIndx);
 
+/**
+ * @brief Same as getBitsFirstPartCode() for any grammar of the stream, not only the current one
+ * @param[in] strm EXI stream
+ * @param[in] grammar the grammar of the rule
+ * @param[in] prodCount number of productions in the grammar rule
+ * @param[in] currentRuleIndx the index of the concrete grammar rule
+ * @param[in] isNilType TRUE if the element has xsi:nil="true"
+ * @return number of bits needed to encode a production
+ */
+unsigned int getGrammarBitsFirstPartCode(EXIStream* strm, EXIGrammar* grammar, Index prodCount, SmallIndex currentRuleIndx, boolean isNilType);
+
+#if STATIC_CODEC_USE
+/**
+ * @brief Sets the production selection functions of the stream (strm->codec) to those of its schema
+ * if they are generated for the Strict and Preserve options of the stream
+ * @param[in, out] strm EXI stream with a schema and EXI header options set
+ */
+void selectStaticCodec(EXIStream* strm);
+
+/**
+ * @brief Returns the generated event code functions of a grammar of the stream
+ * @param[in] strm EXI stream
+ * @param[in] grammar a grammar of the stream
+ * @return NULL if the stream has no generated event code functions or the grammar is not part of them
+ */
+const StaticGrammarCodec* getStaticGrammarCodec(EXIStream* strm, EXIGrammar* grammar);
+#endif
+
 #if EXIP_DEBUG == ON
 /**
  * @brief Prints a grammar rule
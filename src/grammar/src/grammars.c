@@ -317,17 +317,221 @@ errorCode createFragmentGrammar(EXIPSchema* schema, QNameID* elQnameArr, Index q
 	return EXIP_OK;
 }
 
+/** FragmentContent : SE (*) FragmentEnd 0, ED 1 */
+static Production scFragmentProductions[2] =
+{
+	{((uint32_t) EVENT_ED << 24) | (GR_VOID_NON_TERMINAL & PROD_CONTENT_MASK), INDEX_MAX, {URI_MAX, LN_MAX}},
+	{((uint32_t) EVENT_SE_ALL << 24) | GR_SC_FRAGMENT_END, INDEX_MAX, {URI_MAX, LN_MAX}}
+};
+
+/** FragmentEnd has no productions here, see pushSelfContainedFragment() */
+static GrammarRule scFragmentRules[2] =
+{
+	{scFragmentProductions, 2, 0},
+	{NULL, 0, 0}
+};
+
+static EXIGrammar scFragmentGrammar = {scFragmentRules, GR_PROP_FRAGMENT, 2};
+
+/** An SE (qname) production of the schema-informed fragment grammar with the names it is sorted by */
+struct ScElement
+{
+	const String* ln;
+	const String* uri;
+	Production prod;
+};
+
+static int compareScElements(const void* element1, const void* element2)
+{
+	const struct ScElement* e1 = (const struct ScElement*) element1;
+	const struct ScElement* e2 = (const struct ScElement*) element2;
+	int diff = stringCompare(*e1->ln, *e2->ln);
+
+	if(diff == 0)
+		diff = stringCompare(*e1->uri, *e2->uri);
+	if(diff == 0 && e1->prod.typeId != e2->prod.typeId)
+		diff = e1->prod.typeId < e2->prod.typeId ? -1 : 1;
+
+	return diff;
+}
+
+/**
+ * @brief Collects the SE (qname) productions of the document grammar and of the
+ * schema-informed grammars, i.e. the global and local element declarations, in elements
+ * (NULL to count them only). Returns their number
+ */
+static Index collectScElements(EXIPSchema* schema, struct ScElement* elements)
+{
+	EXIGrammar* grammar;
+	Production* prod;
+	Index count = 0;
+	Index g, p;
+	SmallIndex r;
+
+	for(g = 0; g <= schema->staticGrCount; g++)
+	{
+		grammar = g == 0 ? &schema->docGrammar : &schema->grammarTable.grammar[g - 1];
+		for(r = 0; r < grammar->count; r++)
+		{
+			for(p = 0; p < grammar->rule[r].pCount; p++)
+			{
+				prod = &grammar->rule[r].production[p];
+				if(GET_PROD_EXI_EVENT(prod->content) != EVENT_SE_QNAME || prod->typeId == INDEX_MAX)
+					continue;
+
+				if(elements != NULL)
+				{
+					elements[count].ln = &GET_LN_URI_QNAME(schema->uriTable, prod->qnameId).lnStr;
+					elements[count].uri = &schema->uriTable.uri[prod->qnameId.uriId].uriStr;
+					elements[count].prod = *prod;
+					SET_PROD_NON_TERM(elements[count].prod.content, GR_SC_FRAGMENT_END);
+				}
+				count++;
+			}
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief Creates the schema-informed fragment grammar of the self-contained elements:
+ * FragmentContent : SE (F-0) FragmentEnd 0, ..., SE (F-n-1) FragmentEnd n-1, SE (*) FragmentEnd n, ED n+1
+ * F are the element declarations of the schema sorted by local name and URI; an element
+ * declared with different grammars has an SE (qname) for each of them
+ */
+static errorCode createSelfContainedGrammar(EXIStream* strm)
+{
+	struct ScElement* elements;
+	EXIGrammar* grammar;
+	Production* prod;
+	Index count, unique, e;
+
+	count = collectScElements(strm->schema, NULL);
+	elements = EXIP_MALLOC(sizeof(struct ScElement)*(count + 1));
+	if(elements == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	count = collectScElements(strm->schema, elements);
+	qsort(elements, count, sizeof(struct ScElement), compareScElements);
+
+	// The same element is referenced from every grammar that can hold it
+	for(e = 1, unique = count > 0; e < count; e++)
+	{
+		if(compareScElements(&elements[unique - 1], &elements[e]) != 0)
+			elements[unique++] = elements[e];
+	}
+	count = unique;
+
+	grammar = memManagedAllocate(&strm->memList, sizeof(EXIGrammar) + sizeof(GrammarRule)*2 + sizeof(Production)*(count + 2));
+	if(grammar == NULL)
+	{
+		EXIP_MFREE(elements);
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	}
+
+	grammar->rule = (GrammarRule*) (grammar + 1);
+	grammar->props = GR_PROP_FRAGMENT | GR_PROP_SCHEMA_INFORMED;
+	grammar->count = 2;
+	prod = (Production*) (grammar->rule + 2);
+	grammar->rule[GR_FRAGMENT_CONTENT].production = prod;
+	grammar->rule[GR_FRAGMENT_CONTENT].pCount = count + 2;
+	grammar->rule[GR_FRAGMENT_CONTENT].meta = 0;
+	grammar->rule[GR_SC_FRAGMENT_END] = scFragmentRules[GR_SC_FRAGMENT_END];
+
+	// The productions are stored in reverse order of their event codes
+	prod[0] = scFragmentProductions[0];
+	prod[1] = scFragmentProductions[1];
+	for(e = 0; e < count; e++)
+		prod[count + 1 - e] = elements[e].prod;
+
+	EXIP_MFREE(elements);
+	strm->scGrammar = grammar;
+
+	return EXIP_OK;
+}
+
+errorCode pushSelfContainedFragment(EXIStream* strm)
+{
+	QNameID emptyQNameID = {URI_MAX, LN_MAX};
+
+	if(!IS_SCHEMA(strm->schema->docGrammar.props))
+		return pushGrammar(&strm->gStack, emptyQNameID, &scFragmentGrammar);
+
+	if(strm->scGrammar == NULL)
+	{
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+		TRY(createSelfContainedGrammar(strm));
+	}
+
+	return pushGrammar(&strm->gStack, emptyQNameID, strm->scGrammar);
+}
+
+Index getSelfContainedCode(EXIStream* strm, QNameID qnameId, EXIGrammar* grammar)
+{
+	GrammarRule* rule = &strm->gStack->grammar->rule[GR_FRAGMENT_CONTENT];
+	struct ScElement key;
+	Index first = 0;
+	Index last;
+	Index middle;
+	int diff;
+
+	if(!IS_SCHEMA(strm->gStack->grammar->props) || grammar < strm->schema->grammarTable.grammar ||
+			grammar >= strm->schema->grammarTable.grammar + strm->schema->staticGrCount)
+		return INDEX_MAX;
+
+	key.ln = &GET_LN_URI_QNAME(strm->schema->uriTable, qnameId).lnStr;
+	key.uri = &strm->schema->uriTable.uri[qnameId.uriId].uriStr;
+	key.prod.typeId = (Index) (grammar - strm->schema->grammarTable.grammar);
+
+	// SE (F-0) ... SE (F-n-1) are the productions from the last one to the third one
+	last = rule->pCount - 2;
+	while(first < last)
+	{
+		struct ScElement element;
+
+		middle = first + (last - first)/2;
+		element.prod = rule->production[rule->pCount - 1 - middle];
+		element.ln = &GET_LN_URI_QNAME(strm->schema->uriTable, element.prod.qnameId).lnStr;
+		element.uri = &strm->schema->uriTable.uri[element.prod.qnameId.uriId].uriStr;
+
+		diff = compareScElements(&key, &element);
+		if(diff == 0)
+			return middle;
+		else if(diff < 0)
+			last = middle;
+		else
+			first = middle + 1;
+	}
+
+	return INDEX_MAX;
+}
+
+Index getSelfContainedEndCount(EXIGrammar* fragment)
+{
+	// The built-in FragmentContent has learned the element: SE (qname) 0, SE (*) 1, ED 2
+	if(!IS_SCHEMA(fragment->props))
+		return 3;
+
+	return fragment->rule[GR_FRAGMENT_CONTENT].pCount;
+}
+
 unsigned int getBitsFirstPartCode(EXIStream* strm, Index prodCount, SmallIndex currentRuleIndx)
+{
+	return getGrammarBitsFirstPartCode(strm, strm->gStack->grammar, prodCount, currentRuleIndx, strm->context.isNilType);
+}
+
+unsigned int getGrammarBitsFirstPartCode(EXIStream* strm, EXIGrammar* grammar, Index prodCount, SmallIndex currentRuleIndx, boolean isNilType)
 {
 	boolean secondLevelExists = FALSE;
 
-	if(IS_BUILT_IN_ELEM(strm->gStack->grammar->props))
+	if(IS_BUILT_IN_ELEM(grammar->props))
 	{
 		// Built-in element grammar
 		// There is always a second level production
 		secondLevelExists = TRUE;
 	}
-	else if(IS_DOCUMENT(strm->gStack->grammar->props))
+	else if(IS_DOCUMENT(grammar->props))
 	{
 		// Document grammar
 		if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS))
@@ -335,7 +539,7 @@ unsigned int getBitsFirstPartCode(EXIStream* strm, Index prodCount, SmallIndex c
 		else if(currentRuleIndx == 0 && IS_PRESERVED(strm->header.opts.preserve, PRESERVE_DTD))
 			secondLevelExists = TRUE;
 	}
-	else if(IS_FRAGMENT(strm->gStack->grammar->props))
+	else if(IS_FRAGMENT(grammar->props))
 	{
 		// Fragment grammar
 		if(IS_PRESERVED(strm->header.opts.preserve, PRESERVE_COMMENTS) || IS_PRESERVED(strm->header.opts.preserve, PRESERVE_PIS))
@@ -347,9 +551,9 @@ unsigned int getBitsFirstPartCode(EXIStream* strm, Index prodCount, SmallIndex c
 		if(WITH_STRICT(strm->header.opts.enumOpt))
 		{
 			// Strict mode
-			if(strm->context.isNilType == FALSE && currentRuleIndx == 0)
+			if(isNilType == FALSE && currentRuleIndx == 0)
 			{
-				if(IS_NILLABLE(strm->gStack->grammar->props) || HAS_NAMED_SUB_TYPE_OR_UNION(strm->gStack->grammar->props))
+				if(IS_NILLABLE(grammar->props) || HAS_NAMED_SUB_TYPE_OR_UNION(grammar->props))
 					secondLevelExists = TRUE;
 			}
 		}
@@ -363,6 +567,32 @@ unsigned int getBitsFirstPartCode(EXIStream* strm, Index prodCount, SmallIndex c
 	return getBitsNumber(prodCount - 1 + secondLevelExists);
 }
 
+#if STATIC_CODEC_USE
+void selectStaticCodec(EXIStream* strm)
+{
+	const StaticCodec* codec = strm->schema->codec;
+	unsigned char preserve = strm->header.opts.preserve & (PRESERVE_DTD | PRESERVE_COMMENTS | PRESERVE_PIS);
+
+	strm->codec = NULL;
+	if(codec != NULL && !WITH_FRAGMENT(strm->header.opts.enumOpt) &&
+			codec->strict == WITH_STRICT(strm->header.opts.enumOpt) && codec->preserve == preserve)
+		strm->codec = codec;
+}
+
+const StaticGrammarCodec* getStaticGrammarCodec(EXIStream* strm, EXIGrammar* grammar)
+{
+	if(strm->codec == NULL)
+		return NULL;
+	else if(grammar == &strm->schema->docGrammar)
+		return &strm->codec->docGrammar;
+	else if(grammar >= strm->schema->grammarTable.grammar &&
+			grammar < strm->schema->grammarTable.grammar + strm->schema->staticGrCount)
+		return &strm->codec->grammar[grammar - strm->schema->grammarTable.grammar];
+
+	return NULL;
+}
+#endif
+
 #if EXIP_DEBUG == ON
 
 static void writeValueTypeString(EXIType exiType)
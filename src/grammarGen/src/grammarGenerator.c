@@ -153,6 +153,9 @@ void destroySchema(EXIPSchema* schema)
 	Index i;
 
 	// Freeing the string tables
+#if STRING_TABLE_HASH_USE
+	destroyStringTableIndexes(&schema->uriTable);
+#endif
 
 	for(i = 0; i < schema->uriTable.count; i++)
 	{
@@ -224,4 +227,9 @@ static void sortUriTable(UriTable* uriTable)
 	//	URI	2	"http://www.w3.org/2001/XMLSchema-instance"
 	//	URI	3	"http://www.w3.org/2001/XMLSchema"
 	qsort(&uriTable->uri[4], uriTable->count - 4, sizeof(UriEntry), compareUri);
+
+#if STRING_TABLE_HASH_USE
+	// The indexes refer to the entries by their position
+	destroyStringTableIndexes(uriTable);
+#endif
 }
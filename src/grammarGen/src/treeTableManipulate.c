@@ -242,23 +242,23 @@ errorCode initTreeTable(TreeTable* treeT)
 #if HASH_TABLE_USE
 	// TODO: conditionally create the table, only if the schema is big.
 	// How to determine when the schema is big?
-	treeT->typeTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+	treeT->typeTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 	if(treeT->typeTbl == NULL)
 		return EXIP_HASH_TABLE_ERROR;
 
-	treeT->elemTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+	treeT->elemTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 	if(treeT->elemTbl == NULL)
 		return EXIP_HASH_TABLE_ERROR;
 
-	treeT->attrTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+	treeT->attrTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 	if(treeT->attrTbl == NULL)
 		return EXIP_HASH_TABLE_ERROR;
 
-	treeT->groupTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+	treeT->groupTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 	if(treeT->groupTbl == NULL)
 		return EXIP_HASH_TABLE_ERROR;
 
-	treeT->attrGroupTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, djbHash, stringEqual);
+	treeT->attrGroupTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
 	if(treeT->attrGroupTbl == NULL)
 		return EXIP_HASH_TABLE_ERROR;
 #endif
@@ -48,6 +48,34 @@ unsigned char getBitsNumber(uint64_t val);
  */
 unsigned int log2INT(uint64_t val);
 
+/**
+ * @brief Loads the eight bytes starting at p as one big-endian 64 bit word.
+ * The first byte ends up in the most significant position, which matches the
+ * MSB-first bit order of the EXI stream. p does not need to be aligned.
+ * @param[in] p pointer to at least eight readable bytes
+ *
+ * @return The big-endian 64 bit window
+ */
+uint64_t loadBigEndian64(const unsigned char* p);
+
+/**
+ * @brief Stores a 64 bit word at p in big-endian byte order (inverse of loadBigEndian64)
+ * @param[out] p pointer to at least eight writable bytes; does not need to be aligned
+ * @param[in] w the 64 bit word to store
+ */
+void storeBigEndian64(unsigned char* p, uint64_t w);
+
+/**
+ * @brief Returns the length of the longest prefix of data made of 7-bit bytes (< 0x80).
+ * In the EXI stream such bytes are the one-octet unsigned integers, i.e. the ASCII
+ * characters of a string value. Uses SSE2/AVX2 or NEON when the compiler targets them
+ * and a word-at-a-time scalar loop otherwise.
+ * @param[in] data the bytes to scan
+ * @param[in] len number of bytes in data
+ * @return The number of leading bytes below 0x80
+ */
+Index asciiRunLength(const unsigned char* data, Index len);
+
 /**
  * @brief Reads an EXI stream chunk using buffer.ioStrm.readWriteToStream if available
  * @param[in] strm EXI stream of bits
@@ -21,6 +21,35 @@
 #include "errorHandle.h"
 #include "procTypes.h"
 
+/**
+ * Alignment-specialized decoding primitives. The bit-packed versions
+ * shift and mask the bits of the stream while the byte-aligned versions
+ * (used with the byteAlignment, preCompression and compression options)
+ * work with whole bytes of the buffer. The table matching the options of the
+ * stream is selected once by setDecodePrimitives().
+ */
+struct DecodePrimitives
+{
+	errorCode (*nBitUnsignedInteger)(EXIStream* strm, unsigned char n, unsigned int* int_val);
+	errorCode (*unsignedInteger)(EXIStream* strm, UnsignedInteger* int_val);
+	/** Reads len octets in data */
+	errorCode (*octets)(EXIStream* strm, unsigned char* data, Index len);
+	/** Copies in data the leading characters below 0x80 (one-octet code points) of a string,
+	 * up to len of them, that are already in the buffer. Returns the number of characters copied */
+	Index (*asciiRun)(EXIStream* strm, unsigned char* data, Index len);
+};
+
+typedef struct DecodePrimitives DecodePrimitives;
+
+/**
+ * @brief Selects the decoding primitives (strm->decodePrim) according to
+ * the alignment and compression options in strm->header.opts.
+ * Must be invoked before decoding any value and every time these options change.
+ *
+ * @param[in, out] strm EXI stream
+ */
+void setDecodePrimitives(EXIStream* strm);
+
 /**
  * @brief Decode EXI n-bit Unsigned Integer
  * Decodes and returns an n-bit unsigned integer.
@@ -71,15 +100,33 @@ errorCode decodeString(EXIStream* strm, String* string_val);
  * This function is used for Partitions Optimized for Frequent use of String Literals
  * when there is a local name miss => the Length part is read first.
  * The memory to hold the string data should be allocated before
- * calling this function.
+ * calling this function (str_length*UCS_CHAR_MAX_UNITS CharType units).
  *
  * @param[in] strm EXI stream of bits
- * @param[in] str_length the length of the string
+ * @param[in] str_length the number of characters of the string
  * @param[out] string_val decoded string
  * @return Error handling code
  */
 errorCode decodeStringOnly(EXIStream* strm, Index str_length, String* string_val);
 
+/**
+ * @brief Skips str_length characters of a string value without decoding them
+ * Used when the value is not needed and is not added to the string tables
+ *
+ * @param[in, out] strm EXI stream of bits
+ * @param[in] str_length the number of characters to skip
+ * @return Error handling code
+ */
+errorCode skipStringOnly(EXIStream* strm, Index str_length);
+
+/**
+ * @brief Skips a value of EXI Binary type without copying it
+ *
+ * @param[in, out] strm EXI stream of bits
+ * @return Error handling code
+ */
+errorCode skipBinary(EXIStream* strm);
+
 /**
  * @brief Decode EXI Binary type
  * Decode a binary value as a length-prefixed sequence of octets.
@@ -0,0 +1,52 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file streamDeflate.h
+ * @brief Built-in raw DEFLATE (RFC 1951) compressor and decompressor
+ * used for the EXI compression of the structure and value channels.
+ * Only complete DEFLATE streams are produced and consumed -
+ * no zlib or gzip wrapping is involved.
+ *
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#ifndef STREAMDEFLATE_H_
+#define STREAMDEFLATE_H_
+
+#include "errorHandle.h"
+#include "procTypes.h"
+
+/**
+ * @brief Compresses a sequence of bytes into a single raw DEFLATE stream.
+ * The stream is appended to the content of the output buffer. The
+ * output buffer memory (BinaryBuffer.buf of size BinaryBuffer.bufLen)
+ * is allocated/extended with EXIP_REALLOC when needed and must be freed
+ * by the caller; BinaryBuffer.bufContent holds the number of bytes used.
+ *
+ * @param[in] data bytes to be compressed
+ * @param[in] dataLen number of bytes to be compressed
+ * @param[in, out] out output buffer
+ * @return Error handling code
+ */
+errorCode deflateData(const unsigned char* data, Index dataLen, BinaryBuffer* out);
+
+/**
+ * @brief Decompresses a single raw DEFLATE stream read from an EXI stream.
+ * The DEFLATE stream must start at a byte boundary of the EXI stream.
+ * On success the EXI stream is positioned at the first byte following
+ * the DEFLATE stream. The decompressed bytes are appended to the output buffer
+ * that is managed as in deflateData().
+ *
+ * @param[in, out] strm EXI stream holding the compressed data
+ * @param[in, out] out output buffer
+ * @return Error handling code
+ */
+errorCode inflateData(EXIStream* strm, BinaryBuffer* out);
+
+#endif /* STREAMDEFLATE_H_ */
@@ -21,6 +21,32 @@
 #include "errorHandle.h"
 #include "procTypes.h"
 
+/**
+ * Alignment-specialized encoding primitives. The bit-packed versions
+ * shift and mask the bits of the stream while the byte-aligned versions
+ * (used with the byteAlignment, preCompression and compression options)
+ * work with whole bytes of the buffer. The table matching the options of the
+ * stream is selected once by setEncodePrimitives().
+ */
+struct EncodePrimitives
+{
+	errorCode (*nBitUnsignedInteger)(EXIStream* strm, unsigned char n, unsigned int int_val);
+	errorCode (*unsignedInteger)(EXIStream* strm, UnsignedInteger int_val);
+	/** Writes len octets from data */
+	errorCode (*octets)(EXIStream* strm, const unsigned char* data, Index len);
+};
+
+typedef struct EncodePrimitives EncodePrimitives;
+
+/**
+ * @brief Selects the encoding primitives (strm->encodePrim) according to
+ * the alignment and compression options in strm->header.opts.
+ * Must be invoked before encoding any value and every time these options change.
+ *
+ * @param[in, out] strm EXI stream
+ */
+void setEncodePrimitives(EXIStream* strm);
+
 /**
  * @brief Encode EXI n-bit Unsigned Integer
  *
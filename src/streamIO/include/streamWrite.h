@@ -38,4 +38,14 @@ errorCode writeNextBit(EXIStream* strm, boolean bit_val);
  */
 errorCode writeNBits(EXIStream* strm, unsigned char nbits, unsigned int bits_val);
 
+/**
+ * @brief Writes a sequence of whole bytes to a byte-aligned EXI stream
+ * (bitPointer must be 0). The buffer is flushed as many times as needed.
+ * @param[out] strm EXI stream of bits
+ * @param[in] data bytes to be written
+ * @param[in] len number of bytes
+ * @return Error handling code
+ */
+errorCode writeBytes(EXIStream* strm, const unsigned char* data, Index len);
+
 #endif /* STREAMWRITE_H_ */
@@ -17,6 +17,14 @@
 
 #include "ioUtil.h"
 
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#elif defined(__ARM_NEON)
+# include <arm_neon.h>
+#endif
+
 void moveBitPointer(EXIStream* strm, unsigned int bitPositions)
 {
 	int nbits;
@@ -98,6 +106,83 @@ unsigned int log2INT(uint64_t val)
 	return r;
 }
 
+uint64_t loadBigEndian64(const unsigned char* p)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	// Single unaligned load followed by a byte swap
+	uint64_t w;
+	memcpy(&w, p, sizeof(uint64_t));
+	return __builtin_bswap64(w);
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	uint64_t w;
+	memcpy(&w, p, sizeof(uint64_t));
+	return w;
+#else
+	return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) | ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32) |
+		   ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) | ((uint64_t) p[6] << 8) | (uint64_t) p[7];
+#endif
+}
+
+void storeBigEndian64(unsigned char* p, uint64_t w)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	w = __builtin_bswap64(w);
+	memcpy(p, &w, sizeof(uint64_t));
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	memcpy(p, &w, sizeof(uint64_t));
+#else
+	int i;
+	for(i = 7; i >= 0; i--)
+	{
+		p[i] = (unsigned char) w;
+		w = w >> 8;
+	}
+#endif
+}
+
+Index asciiRunLength(const unsigned char* data, Index len)
+{
+	Index i = 0;
+
+#if defined(__AVX2__)
+	for(; i + 32 <= len; i += 32)
+	{
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*) (data + i)));
+		if(mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+	for(; i + 16 <= len; i += 16)
+	{
+		unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (data + i)));
+		if(mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#elif defined(__ARM_NEON)
+	for(; i + 16 <= len; i += 16)
+	{
+		// Any lane with the high bit set ends the run; the exact position is found below
+		uint8x16_t v = vld1q_u8(data + i);
+		uint64x2_t hi = vreinterpretq_u64_u8(vandq_u8(v, vdupq_n_u8(0x80)));
+		if((vgetq_lane_u64(hi, 0) | vgetq_lane_u64(hi, 1)) != 0)
+			break;
+	}
+#endif
+
+	// Scalar fallback: eight bytes per step while none of them has the high bit set
+	for(; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+	{
+		if((loadBigEndian64(data + i) & 0x8080808080808080ULL) != 0)
+			break;
+	}
+
+	while(i < len && data[i] < 0x80)
+		i++;
+
+	return i;
+}
+
 errorCode readEXIChunkForParsing(EXIStream* strm, unsigned int numBytesToBeRead)
 {
 	Index bytesCopied = strm->buffer.bufContent - strm->context.bufferIndx;
@@ -122,6 +207,7 @@ errorCode readEXIChunkForParsing(EXIStream* strm, unsigned int numBytesToBeRead)
 	if(strm->buffer.bufContent < numBytesToBeRead)
 		return EXIP_UNEXPECTED_ERROR;
 
+	strm->context.bufferOffset += strm->context.bufferIndx;
 	strm->context.bufferIndx = 0;
 
 	return EXIP_OK;
@@ -129,13 +215,15 @@ errorCode readEXIChunkForParsing(EXIStream* strm, unsigned int numBytesToBeRead)
 
 errorCode writeEncodedEXIChunk(EXIStream* strm)
 {
-	char leftOverBits;
+	char leftOverBits = 0;
 	Index numBytesWritten = 0;
 
 	if(strm->buffer.ioStrm.readWriteToStream == NULL && strm->buffer.bufStrm.buf == NULL)
 		return EXIP_BUFFER_END_REACHED;
 
-	leftOverBits = strm->buffer.buf[strm->context.bufferIndx];
+	// A completely filled buffer has no partially written byte
+	if(strm->context.bufferIndx < strm->buffer.bufLen)
+		leftOverBits = strm->buffer.buf[strm->context.bufferIndx];
 
 	errorCode error = writeToStream(&(strm->buffer), 0, strm->context.bufferIndx, &numBytesWritten);
 	if (error != EXIP_OK)  
@@ -144,6 +232,7 @@ errorCode writeEncodedEXIChunk(EXIStream* strm)
 		return EXIP_UNEXPECTED_ERROR;
 
 	strm->buffer.buf[0] = leftOverBits;
+	strm->context.bufferOffset += strm->context.bufferIndx;
 	strm->context.bufferIndx = 0;
 
 	return EXIP_OK;
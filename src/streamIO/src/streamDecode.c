@@ -21,59 +21,116 @@
 #include "ioUtil.h"
 #include <math.h>
 
+static errorCode decodeNBitUIntBitPacked(EXIStream* strm, unsigned char n, unsigned int* int_val);
+static errorCode decodeNBitUIntAligned(EXIStream* strm, unsigned char n, unsigned int* int_val);
+static errorCode decodeUIntBitPacked(EXIStream* strm, UnsignedInteger* int_val);
+static errorCode decodeUIntAligned(EXIStream* strm, UnsignedInteger* int_val);
+static errorCode readOctetsBitPacked(EXIStream* strm, unsigned char* data, Index len);
+static errorCode readOctetsAligned(EXIStream* strm, unsigned char* data, Index len);
+static Index readAsciiRunBitPacked(EXIStream* strm, unsigned char* data, Index len);
+static Index readAsciiRunAligned(EXIStream* strm, unsigned char* data, Index len);
+
+static const DecodePrimitives BIT_PACKED_DECODING = {decodeNBitUIntBitPacked, decodeUIntBitPacked, readOctetsBitPacked, readAsciiRunBitPacked};
+static const DecodePrimitives BYTE_ALIGNED_DECODING = {decodeNBitUIntAligned, decodeUIntAligned, readOctetsAligned, readAsciiRunAligned};
+
+void setDecodePrimitives(EXIStream* strm)
+{
+	if(WITH_COMPRESSION(strm->header.opts.enumOpt) == FALSE && GET_ALIGNMENT(strm->header.opts.enumOpt) == BIT_PACKED)
+		strm->decodePrim = &BIT_PACKED_DECODING;
+	else
+		strm->decodePrim = &BYTE_ALIGNED_DECODING;
+}
+
 errorCode decodeNBitUnsignedInteger(EXIStream* strm, unsigned char n, unsigned int* int_val)
 {
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> (%d-bits uint)", n));
+	return strm->decodePrim->nBitUnsignedInteger(strm, n, int_val);
+}
+
+static errorCode decodeNBitUIntBitPacked(EXIStream* strm, unsigned char n, unsigned int* int_val)
+{
+	return readBits(strm, n, int_val);
+}
+
+static errorCode decodeNBitUIntAligned(EXIStream* strm, unsigned char n, unsigned int* int_val)
+{
+	unsigned int byte_number = ((unsigned int) n) / 8 + (n % 8 != 0);
+	unsigned char* buf;
+	unsigned int i = 0;
+
 	if(n == 0)
 	{
 		*int_val = 0;
 		return EXIP_OK;
 	}
 
-	if(WITH_COMPRESSION(strm->header.opts.enumOpt) == FALSE && GET_ALIGNMENT(strm->header.opts.enumOpt) == BIT_PACKED)
+	if(strm->buffer.bufContent < strm->context.bufferIndx + byte_number)
 	{
-		return readBits(strm, n, int_val);
+		// The buffer end is reached: there are fewer than byte_number left unparsed
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+		TRY(readEXIChunkForParsing(strm, byte_number));
 	}
-	else
-	{
-		unsigned int byte_number = ((unsigned int) n) / 8 + (n % 8 != 0);
-		unsigned long tmp_byte_buf = 0;
-		unsigned int i = 0;
 
-		if(strm->buffer.bufContent < strm->context.bufferIndx + byte_number)
-		{
-			// The buffer end is reached: there are fewer than byte_number left unparsed
-			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	// The bytes are in little-endian order
+	buf = (unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+	*int_val = 0;
+	for(i = byte_number; i > 0; i--)
+		*int_val = (*int_val << 8) | buf[i - 1];
 
-			TRY(readEXIChunkForParsing(strm, byte_number));
-		}
+	strm->context.bufferIndx += byte_number;
 
-		*int_val = 0;
-		for(i = 0; i < byte_number*8; i += 8)
-		{
-			tmp_byte_buf = strm->buffer.buf[strm->context.bufferIndx] << i;
-			*int_val = *int_val | tmp_byte_buf;
-			strm->context.bufferIndx++;
-		}
-	}
 	return EXIP_OK;
 }
 
 errorCode decodeBoolean(EXIStream* strm, boolean* bool_val)
 {
 	//TODO:  when pattern facets are available in the schema datatype - handle it differently
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int bit_val = 0;
+
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> (bool)"));
-	return decodeNBitUnsignedInteger(strm, 1, (unsigned int *)bool_val);
+	TRY(decodeNBitUnsignedInteger(strm, 1, &bit_val));
+	*bool_val = (bit_val != 0);
+
+	return EXIP_OK;
 }
 
 errorCode decodeUnsignedInteger(EXIStream* strm, UnsignedInteger* int_val)
+{
+	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> (uint)"));
+	return strm->decodePrim->unsignedInteger(strm, int_val);
+}
+
+static errorCode decodeUIntBitPacked(EXIStream* strm, UnsignedInteger* int_val)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	unsigned int i = 0;
 	unsigned int tmp_byte_buf = 0;
 	*int_val = 0;
 
-	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> (uint)"));
+	// Fast path: while the 64 bit window is entirely within the buffer, up to
+	// 7 octets of the unsigned integer are taken from a single load
+	while(strm->buffer.bufContent >= strm->context.bufferIndx + sizeof(uint64_t))
+	{
+		uint64_t window = loadBigEndian64((unsigned char *) strm->buffer.buf + strm->context.bufferIndx) << strm->context.bitPointer;
+		unsigned int k;
+
+		for(k = 0; k < 7; k++)
+		{
+			tmp_byte_buf = (unsigned int) (window >> 56);
+			window = window << 8;
+			strm->context.bufferIndx++;
+
+			if(i < 64)
+				*int_val += ((UnsignedInteger) (tmp_byte_buf & 0x7F)) << i;
+			i += 7;
+
+			if((tmp_byte_buf & 0x80) == 0)
+				return EXIP_OK;
+		}
+	}
+
 	do
 	{
 		TRY(readBits(strm, 8, &tmp_byte_buf));
@@ -86,6 +143,30 @@ errorCode decodeUnsignedInteger(EXIStream* strm, UnsignedInteger* int_val)
 	return EXIP_OK;
 }
 
+static errorCode decodeUIntAligned(EXIStream* strm, UnsignedInteger* int_val)
+{
+	unsigned int i = 0;
+	unsigned char tmp_byte_buf;
+	*int_val = 0;
+
+	do
+	{
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+
+		tmp_byte_buf = (unsigned char) strm->buffer.buf[strm->context.bufferIndx++];
+		if(i < 64)
+			*int_val += ((UnsignedInteger) (tmp_byte_buf & 0x7F)) << i;
+		i += 7;
+	}
+	while(tmp_byte_buf & 0x80);
+
+	return EXIP_OK;
+}
+
 errorCode decodeString(EXIStream* strm, String* string_val)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
@@ -109,13 +190,94 @@ errorCode decodeStringOnly(EXIStream* strm, Index str_length, String* string_val
 	Index writerPosition = 0;
 	UnsignedInteger tmp_code_point = 0;
 
-	string_val->length = str_length;
+	// The bound for writeCharToString(); the actual length is known at the end
+	string_val->length = str_length*UCS_CHAR_MAX_UNITS;
 
-	for(i = 0; i < str_length; i++)
+	while(i < str_length)
 	{
-		TRY(decodeUnsignedInteger(strm, &tmp_code_point));
+		if(sizeof(CharType) == 1)
+		{
+			// The characters below 0x80 are single octets in the stream
+			// and are copied in bulk. The rest are decoded one by one
+			Index run = strm->decodePrim->asciiRun(strm, (unsigned char*) string_val->str + writerPosition, str_length - i);
+			i += run;
+			writerPosition += run;
+			if(i == str_length)
+				break;
+		}
+
+		TRY(strm->decodePrim->unsignedInteger(strm, &tmp_code_point));
 		TRY(writeCharToString(string_val, (uint32_t) tmp_code_point, &writerPosition));
+		i++;
+	}
+	string_val->length = writerPosition;
+	return EXIP_OK;
+}
+
+/**
+ * The characters are unsigned integers: at a byte boundary only the octets that
+ * end them (most significant bit 0) are counted, otherwise they are decoded one by one
+ */
+errorCode skipStringOnly(EXIStream* strm, Index str_length)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	UnsignedInteger tmp_code_point = 0;
+	const unsigned char* octets;
+	Index i;
+
+	while(str_length > 0)
+	{
+		if(strm->context.bitPointer != 0)
+		{
+			TRY(strm->decodePrim->unsignedInteger(strm, &tmp_code_point));
+			str_length--;
+			continue;
+		}
+
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+
+		// A character can continue in the next chunk of the stream
+		octets = (const unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+		for(i = 0; i < strm->buffer.bufContent - strm->context.bufferIndx && str_length > 0; i++)
+		{
+			if((octets[i] & 0x80) == 0)
+				str_length--;
+		}
+		strm->context.bufferIndx += i;
+	}
+
+	return EXIP_OK;
+}
+
+/**
+ * Skipping whole octets does not change the bit pointer in bit-packed streams
+ */
+errorCode skipBinary(EXIStream* strm)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	UnsignedInteger length = 0;
+	Index chunk;
+
+	TRY(decodeUnsignedInteger(strm, &length));
+
+	while(length > 0)
+	{
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+
+		chunk = strm->buffer.bufContent - strm->context.bufferIndx;
+		if(chunk > length)
+			chunk = (Index) length;
+
+		strm->context.bufferIndx += chunk;
+		length -= chunk;
 	}
+
 	return EXIP_OK;
 }
 
@@ -123,8 +285,6 @@ errorCode decodeBinary(EXIStream* strm, char** binary_val, Index* nbytes)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	UnsignedInteger length = 0;
-	unsigned int int_val = 0;
-	UnsignedInteger i = 0;
 
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> (binary)"));
 	TRY(decodeUnsignedInteger(strm, &length));
@@ -133,14 +293,124 @@ errorCode decodeBinary(EXIStream* strm, char** binary_val, Index* nbytes)
 	if((*binary_val) == NULL)
 		return EXIP_MEMORY_ALLOCATION_ERROR;
 
-	for(i = 0; i < length; i++)
+	TRY_CATCH(strm->decodePrim->octets(strm, (unsigned char*) *binary_val, (Index) length), EXIP_MFREE(*binary_val));
+
+	return EXIP_OK;
+}
+
+static errorCode readOctetsBitPacked(EXIStream* strm, unsigned char* data, Index len)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int int_val = 0;
+	unsigned int shift = strm->context.bitPointer;
+	const unsigned char* src;
+	Index n;
+	Index i;
+
+	// At a byte boundary the octets are simply copied
+	if(shift == 0)
+		return readOctetsAligned(strm, data, len);
+
+	while(len > 0)
+	{
+		// Each octet spans two bytes of the buffer: merge the shifted
+		// pairs of all the octets that are entirely in the buffer
+		if(strm->context.bufferIndx + 1 >= strm->buffer.bufContent)
+		{
+			// The last octet(s) cross the buffer end; readBits() reads the next chunk
+			TRY(readBits(strm, 8, &int_val));
+			*data++ = (unsigned char) int_val;
+			len--;
+			continue;
+		}
+
+		n = strm->buffer.bufContent - strm->context.bufferIndx - 1;
+		if(n > len)
+			n = len;
+
+		src = (const unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+		for(i = 0; i < n; i++)
+			data[i] = (unsigned char) ((src[i] << shift) | (src[i + 1] >> (8 - shift)));
+
+		strm->context.bufferIndx += n;
+		data += n;
+		len -= n;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode readOctetsAligned(EXIStream* strm, unsigned char* data, Index len)
+{
+	Index chunk;
+
+	while(len > 0)
 	{
-		TRY_CATCH(readBits(strm, 8, &int_val), EXIP_MFREE(*binary_val));
-		(*binary_val)[i]=(char) int_val;
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+
+		chunk = strm->buffer.bufContent - strm->context.bufferIndx;
+		if(chunk > len)
+			chunk = len;
+
+		memcpy(data, strm->buffer.buf + strm->context.bufferIndx, chunk);
+		strm->context.bufferIndx += chunk;
+		data += chunk;
+		len -= chunk;
 	}
+
 	return EXIP_OK;
 }
 
+static Index readAsciiRunBitPacked(EXIStream* strm, unsigned char* data, Index len)
+{
+	Index copied = 0;
+
+	// Seven 8-bit lanes are extracted from each 64 bit window of the buffer.
+	// The bit pointer is not changed as only whole octets are consumed
+	while(copied < len && strm->buffer.bufContent >= strm->context.bufferIndx + sizeof(uint64_t))
+	{
+		uint64_t window = loadBigEndian64((unsigned char *) strm->buffer.buf + strm->context.bufferIndx) << strm->context.bitPointer;
+		uint64_t highBits = window & 0x8080808080808000ULL;
+		unsigned char lanes[sizeof(uint64_t)];
+		Index n = 0;
+
+		while(n < 7 && (highBits & (0x8000000000000000ULL >> (n*8))) == 0)
+			n++;
+		if(n > len - copied)
+			n = len - copied;
+
+		storeBigEndian64(lanes, window);
+		memcpy(data + copied, lanes, n);
+		copied += n;
+		strm->context.bufferIndx += n;
+
+		if(n < 7)
+			break;
+	}
+
+	return copied;
+}
+
+static Index readAsciiRunAligned(EXIStream* strm, unsigned char* data, Index len)
+{
+	Index n = strm->buffer.bufContent - strm->context.bufferIndx;
+
+	if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		return 0;
+
+	if(n > len)
+		n = len;
+	n = asciiRunLength((unsigned char *) strm->buffer.buf + strm->context.bufferIndx, n);
+	memcpy(data, strm->buffer.buf + strm->context.bufferIndx, n);
+	strm->context.bufferIndx += n;
+
+	return n;
+}
+
 errorCode decodeIntegerValue(EXIStream* strm, Integer* sint_val)
 {
 	// TODO: If there is associated schema datatype handle differently!
@@ -0,0 +1,1102 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file streamDeflate.c
+ * @brief Implementation of the built-in raw DEFLATE (RFC 1951) codec
+ *
+ * The compressor does LZ77 matching over hash chains with one step
+ * lazy evaluation and emits each block as stored, fixed Huffman or
+ * dynamic Huffman block - whichever is the shortest.
+ * The decompressor handles all three block types and reads the
+ * compressed data directly from the EXI stream buffer.
+ *
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#include "streamDeflate.h"
+#include "ioUtil.h"
+
+#if COMPRESSION_USE
+
+#define DEFLATE_MIN_MATCH 3
+#define DEFLATE_MAX_MATCH 258
+#define DEFLATE_MAX_WINDOW 32768
+#define DEFLATE_MAX_HASH_BITS 15
+/** Number of hash chain links followed when searching for a match */
+#define DEFLATE_MAX_CHAIN 64
+/** A match of that length is good enough to skip the lazy evaluation */
+#define DEFLATE_GOOD_MATCH 32
+/** Maximum number of LZ77 symbols in a single DEFLATE block */
+#define DEFLATE_BLOCK_SYMBOLS 16384
+/** Maximum number of bytes in a stored DEFLATE block */
+#define DEFLATE_MAX_STORED 65535
+
+#define LITLEN_CODES 288
+#define DIST_CODES 30
+#define CODELEN_CODES 19
+#define END_OF_BLOCK 256
+#define MAX_CODE_BITS 15
+#define MAX_CODELEN_BITS 7
+
+/** Number of code bits resolved with a single table look-up when inflating */
+#define INFLATE_FAST_BITS 9
+
+static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+									35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+									3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[DIST_CODES] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+									257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const unsigned char DIST_EXTRA[DIST_CODES] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+									7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+/** The order in which the code length code lengths are transmitted */
+static const unsigned char CODELEN_ORDER[CODELEN_CODES] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+static errorCode reserveBytes(BinaryBuffer* out, size_t size);
+static unsigned int reverseBits(unsigned int code, unsigned char len);
+static void fixedLengths(unsigned char* litLens, unsigned char* distLens);
+
+/****************************************************************
+ *                         DEFLATE                               *
+ ****************************************************************/
+
+/** A LZ77 symbol: a literal when dist == 0, otherwise a <length, distance> pair */
+struct lzSymbol
+{
+	uint16_t litLen;
+	uint16_t dist;
+};
+
+/** LSB-first bit writer to a buffer with preallocated capacity */
+struct bitWriter
+{
+	unsigned char* ptr;
+	uint32_t bitBuf;
+	unsigned char bitCount;
+};
+
+struct huffCode
+{
+	uint16_t code[LITLEN_CODES]; // bit-reversed, ready to be written LSB-first
+	unsigned char len[LITLEN_CODES];
+};
+
+static void putBits(struct bitWriter* bw, unsigned int bits, unsigned char n)
+{
+	bw->bitBuf |= ((uint32_t) bits) << bw->bitCount;
+	bw->bitCount += n;
+	while(bw->bitCount >= 8)
+	{
+		*bw->ptr++ = (unsigned char) bw->bitBuf;
+		bw->bitBuf >>= 8;
+		bw->bitCount -= 8;
+	}
+}
+
+static void flushBits(struct bitWriter* bw)
+{
+	if(bw->bitCount > 0)
+	{
+		*bw->ptr++ = (unsigned char) bw->bitBuf;
+		bw->bitBuf = 0;
+		bw->bitCount = 0;
+	}
+}
+
+static unsigned int lengthCode(unsigned int len)
+{
+	unsigned int l;
+	unsigned char b;
+
+	if(len <= 10)
+		return 254 + len;
+	if(len == DEFLATE_MAX_MATCH)
+		return 285;
+	l = len - 3;
+	b = getBitsNumber(l) - 1;
+	return 257 + 4*(b - 1) + ((l >> (b - 2)) & 3);
+}
+
+static unsigned int distCode(unsigned int dist)
+{
+	unsigned int d = dist - 1;
+	unsigned char b;
+
+	if(dist <= 4)
+		return d;
+	b = getBitsNumber(d) - 1;
+	return 2*b + ((d >> (b - 1)) & 1);
+}
+
+static int compareFreqSym(const void* a, const void* b)
+{
+	const uint32_t* x = a;
+	const uint32_t* y = b;
+	if(x[0] != y[0])
+		return x[0] < y[0] ? -1 : 1;
+	return x[1] < y[1] ? -1 : (x[1] > y[1]);
+}
+
+/**
+ * Computes length-limited Huffman code lengths for the given frequencies.
+ * The minimum-redundancy lengths are computed in-place (Moffat & Katajainen)
+ * and then limited to maxLen while keeping the code complete.
+ * At least two symbols always get a code so that the code is complete.
+ */
+static void buildCodeLengths(const uint32_t* freq, unsigned int n, unsigned char maxLen, unsigned char* lens)
+{
+	uint32_t sorted[LITLEN_CODES][2];
+	int A[LITLEN_CODES];
+	unsigned int blCount[LITLEN_CODES + 1];
+	int used = 0;
+	unsigned int i;
+	int root, leaf, next, avbl, usedNodes, dpth;
+	int longest = 0;
+
+	for(i = 0; i < n; i++)
+	{
+		lens[i] = 0;
+		if(freq[i] > 0)
+		{
+			sorted[used][0] = freq[i];
+			sorted[used][1] = i;
+			used++;
+		}
+	}
+
+	// Make sure at least two symbols have codes
+	for(i = 0; used < 2 && i < n; i++)
+	{
+		if(freq[i] == 0)
+		{
+			sorted[used][0] = 0;
+			sorted[used][1] = i;
+			used++;
+		}
+	}
+
+	qsort(sorted, used, sizeof(sorted[0]), compareFreqSym);
+	for(i = 0; i < (unsigned int) used; i++)
+		A[i] = (int) sorted[i][0];
+
+	// Phase 1: left to right, set parent pointers
+	A[0] += A[1];
+	root = 0;
+	leaf = 2;
+	for(next = 1; next < used - 1; next++)
+	{
+		if(leaf >= used || A[root] < A[leaf])
+		{
+			A[next] = A[root];
+			A[root++] = next;
+		}
+		else
+			A[next] = A[leaf++];
+
+		if(leaf >= used || (root < next && A[root] < A[leaf]))
+		{
+			A[next] += A[root];
+			A[root++] = next;
+		}
+		else
+			A[next] += A[leaf++];
+	}
+
+	// Phase 2: right to left, set internal depths
+	A[used - 2] = 0;
+	for(next = used - 3; next >= 0; next--)
+		A[next] = A[A[next]] + 1;
+
+	// Phase 3: right to left, set leaf depths
+	avbl = 1;
+	usedNodes = 0;
+	dpth = 0;
+	root = used - 2;
+	next = used - 1;
+	while(avbl > 0)
+	{
+		while(root >= 0 && A[root] == dpth)
+		{
+			usedNodes++;
+			root--;
+		}
+		while(avbl > usedNodes)
+		{
+			A[next--] = dpth;
+			avbl--;
+		}
+		avbl = 2*usedNodes;
+		dpth++;
+		usedNodes = 0;
+	}
+
+	for(i = 0; i <= LITLEN_CODES; i++)
+		blCount[i] = 0;
+	for(i = 0; i < (unsigned int) used; i++)
+	{
+		blCount[A[i]]++;
+		if(A[i] > longest)
+			longest = A[i];
+	}
+
+	// Limit the code lengths to maxLen keeping the Kraft sum equal to 1
+	for(i = longest; i > maxLen; i--)
+	{
+		while(blCount[i] > 0)
+		{
+			unsigned int j = i - 2;
+			while(blCount[j] == 0)
+				j--;
+			blCount[i] -= 2;
+			blCount[i - 1] += 1;
+			blCount[j + 1] += 2;
+			blCount[j] -= 1;
+		}
+	}
+
+	// The least frequent symbols get the longest codes
+	next = 0;
+	for(i = maxLen; i > 0; i--)
+	{
+		unsigned int k;
+		for(k = 0; k < blCount[i]; k++)
+			lens[sorted[next++][1]] = (unsigned char) i;
+	}
+}
+
+/** Assigns the canonical codes to the given code lengths */
+static void assignCodes(struct huffCode* hc, unsigned int n)
+{
+	uint16_t blCount[MAX_CODE_BITS + 1] = {0};
+	uint16_t nextCode[MAX_CODE_BITS + 1];
+	unsigned int code = 0;
+	unsigned int i;
+
+	for(i = 0; i < n; i++)
+		blCount[hc->len[i]]++;
+	blCount[0] = 0;
+
+	for(i = 1; i <= MAX_CODE_BITS; i++)
+	{
+		code = (code + blCount[i - 1]) << 1;
+		nextCode[i] = (uint16_t) code;
+	}
+
+	for(i = 0; i < n; i++)
+	{
+		if(hc->len[i] != 0)
+			hc->code[i] = (uint16_t) reverseBits(nextCode[hc->len[i]]++, hc->len[i]);
+	}
+}
+
+/**
+ * Run-length encodes the literal/length and distance code lengths
+ * with the code length alphabet. Each entry is (symbol | extra bits value << 8)
+ */
+static unsigned int encodeCodeLengths(const unsigned char* lens, unsigned int count, uint16_t* out, uint32_t* freq)
+{
+	unsigned int i = 0;
+	unsigned int n = 0;
+
+	while(i < count)
+	{
+		unsigned char l = lens[i];
+		unsigned int run = 1;
+
+		while(i + run < count && lens[i + run] == l)
+			run++;
+
+		if(l == 0 && run >= 3)
+		{
+			unsigned int r = run > 138 ? 138 : run;
+			if(r >= 11)
+			{
+				out[n++] = (uint16_t) (18 | ((r - 11) << 8));
+				freq[18]++;
+			}
+			else
+			{
+				out[n++] = (uint16_t) (17 | ((r - 3) << 8));
+				freq[17]++;
+			}
+			i += r;
+		}
+		else if(l != 0 && run >= 4)
+		{
+			unsigned int r = run - 1 > 6 ? 6 : run - 1;
+			out[n++] = l;
+			freq[l]++;
+			out[n++] = (uint16_t) (16 | ((r - 3) << 8));
+			freq[16]++;
+			i += r + 1;
+		}
+		else
+		{
+			out[n++] = l;
+			freq[l]++;
+			i++;
+		}
+	}
+
+	return n;
+}
+
+/** Computes the bits needed for the symbols of a block with the given code lengths */
+static size_t blockDataBits(const uint32_t* litFreq, const uint32_t* distFreq, const unsigned char* litLens, const unsigned char* distLens)
+{
+	size_t bits = 0;
+	unsigned int i;
+
+	for(i = 0; i < 286; i++)
+	{
+		bits += (size_t) litFreq[i]*litLens[i];
+		if(i > END_OF_BLOCK)
+			bits += (size_t) litFreq[i]*LENGTH_EXTRA[i - 257];
+	}
+	for(i = 0; i < DIST_CODES; i++)
+		bits += (size_t) distFreq[i]*(distLens[i] + DIST_EXTRA[i]);
+
+	return bits;
+}
+
+static void writeBlockSymbols(struct bitWriter* bw, const struct lzSymbol* sym, unsigned int symCount,
+								const struct huffCode* lit, const struct huffCode* dist)
+{
+	unsigned int i;
+
+	for(i = 0; i < symCount; i++)
+	{
+		if(sym[i].dist == 0)
+			putBits(bw, lit->code[sym[i].litLen], lit->len[sym[i].litLen]);
+		else
+		{
+			unsigned int lc = lengthCode(sym[i].litLen);
+			unsigned int dc = distCode(sym[i].dist);
+
+			putBits(bw, lit->code[lc], lit->len[lc]);
+			if(LENGTH_EXTRA[lc - 257] > 0)
+				putBits(bw, sym[i].litLen - LENGTH_BASE[lc - 257], LENGTH_EXTRA[lc - 257]);
+			putBits(bw, dist->code[dc], dist->len[dc]);
+			if(DIST_EXTRA[dc] > 0)
+				putBits(bw, sym[i].dist - DIST_BASE[dc], DIST_EXTRA[dc]);
+		}
+	}
+	putBits(bw, lit->code[END_OF_BLOCK], lit->len[END_OF_BLOCK]);
+}
+
+/**
+ * Writes one DEFLATE block holding the LZ77 symbols for the raw bytes raw[0..rawLen)
+ * as either stored, fixed or dynamic Huffman block.
+ */
+static void writeBlock(struct bitWriter* bw, const struct lzSymbol* sym, unsigned int symCount,
+						const unsigned char* raw, Index rawLen, boolean isFinal)
+{
+	uint32_t litFreq[LITLEN_CODES] = {0};
+	uint32_t distFreq[DIST_CODES] = {0};
+	uint32_t clFreq[CODELEN_CODES] = {0};
+	struct huffCode lit;
+	struct huffCode dist;
+	struct huffCode cl;
+	unsigned char fixedLit[LITLEN_CODES];
+	unsigned char fixedDist[DIST_CODES];
+	unsigned char allLens[286 + DIST_CODES];
+	uint16_t clSymbols[286 + DIST_CODES];
+	unsigned int clCount;
+	unsigned int hlit, hdist, hclen;
+	size_t dynBits, fixedBits, storedBits;
+	unsigned int i;
+
+	for(i = 0; i < symCount; i++)
+	{
+		if(sym[i].dist == 0)
+			litFreq[sym[i].litLen]++;
+		else
+		{
+			litFreq[lengthCode(sym[i].litLen)]++;
+			distFreq[distCode(sym[i].dist)]++;
+		}
+	}
+	litFreq[END_OF_BLOCK] = 1;
+
+	buildCodeLengths(litFreq, 286, MAX_CODE_BITS, lit.len);
+	lit.len[286] = lit.len[287] = 0;
+	buildCodeLengths(distFreq, DIST_CODES, MAX_CODE_BITS, dist.len);
+
+	for(hlit = 286; hlit > 257 && lit.len[hlit - 1] == 0; hlit--);
+	for(hdist = DIST_CODES; hdist > 1 && dist.len[hdist - 1] == 0; hdist--);
+
+	memcpy(allLens, lit.len, hlit);
+	memcpy(allLens + hlit, dist.len, hdist);
+	clCount = encodeCodeLengths(allLens, hlit + hdist, clSymbols, clFreq);
+
+	buildCodeLengths(clFreq, CODELEN_CODES, MAX_CODELEN_BITS, cl.len);
+	for(hclen = CODELEN_CODES; hclen > 4 && cl.len[CODELEN_ORDER[hclen - 1]] == 0; hclen--);
+
+	dynBits = 3 + 5 + 5 + 4 + 3*hclen + blockDataBits(litFreq, distFreq, lit.len, dist.len);
+	for(i = 0; i < clCount; i++)
+	{
+		unsigned int s = clSymbols[i] & 0xFF;
+		dynBits += cl.len[s] + (s == 16 ? 2 : (s == 17 ? 3 : (s == 18 ? 7 : 0)));
+	}
+
+	fixedLengths(fixedLit, fixedDist);
+	fixedBits = 3 + blockDataBits(litFreq, distFreq, fixedLit, fixedDist);
+
+	storedBits = ((size_t) rawLen + 5*(rawLen/DEFLATE_MAX_STORED + 1))*8 + 8;
+
+	if(storedBits <= dynBits && storedBits <= fixedBits)
+	{
+		Index pos = 0;
+		do
+		{
+			Index len = rawLen - pos > DEFLATE_MAX_STORED ? DEFLATE_MAX_STORED : rawLen - pos;
+			putBits(bw, (isFinal && pos + len == rawLen) ? 1 : 0, 1);
+			putBits(bw, 0, 2);
+			flushBits(bw);
+			putBits(bw, (unsigned int) len, 16);
+			putBits(bw, (unsigned int) (~len & 0xFFFF), 16);
+			memcpy(bw->ptr, raw + pos, len);
+			bw->ptr += len;
+			pos += len;
+		}
+		while(pos < rawLen);
+	}
+	else if(fixedBits <= dynBits)
+	{
+		memcpy(lit.len, fixedLit, LITLEN_CODES);
+		memcpy(dist.len, fixedDist, DIST_CODES);
+		assignCodes(&lit, LITLEN_CODES);
+		assignCodes(&dist, DIST_CODES);
+
+		putBits(bw, isFinal, 1);
+		putBits(bw, 1, 2);
+		writeBlockSymbols(bw, sym, symCount, &lit, &dist);
+	}
+	else
+	{
+		assignCodes(&lit, LITLEN_CODES);
+		assignCodes(&dist, DIST_CODES);
+		assignCodes(&cl, CODELEN_CODES);
+
+		putBits(bw, isFinal, 1);
+		putBits(bw, 2, 2);
+		putBits(bw, hlit - 257, 5);
+		putBits(bw, hdist - 1, 5);
+		putBits(bw, hclen - 4, 4);
+		for(i = 0; i < hclen; i++)
+			putBits(bw, cl.len[CODELEN_ORDER[i]], 3);
+		for(i = 0; i < clCount; i++)
+		{
+			unsigned int s = clSymbols[i] & 0xFF;
+			putBits(bw, cl.code[s], cl.len[s]);
+			if(s == 16)
+				putBits(bw, clSymbols[i] >> 8, 2);
+			else if(s == 17)
+				putBits(bw, clSymbols[i] >> 8, 3);
+			else if(s == 18)
+				putBits(bw, clSymbols[i] >> 8, 7);
+		}
+		writeBlockSymbols(bw, sym, symCount, &lit, &dist);
+	}
+}
+
+static unsigned int hash3(const unsigned char* p, unsigned int mask)
+{
+	return ((((unsigned int) p[0]) << 10) ^ (((unsigned int) p[1]) << 5) ^ p[2] ^ (((unsigned int) p[0]) >> 3)) & mask;
+}
+
+errorCode deflateData(const unsigned char* data, Index dataLen, BinaryBuffer* out)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct bitWriter bw;
+	struct lzSymbol* sym;
+	int32_t* head;
+	int32_t* prev;
+	unsigned int hashSize = 256;
+	unsigned int windowSize = 256;
+	unsigned int hashMask, windowMask;
+	unsigned int symCount = 0;
+	Index blockStart = 0;
+	Index i = 0;
+	unsigned int prevLen = 0;
+	unsigned int prevDist = 0;
+	boolean matchAvailable = FALSE;
+
+	// The hash table and the window are sized after the input
+	while(hashSize < dataLen && hashSize < (1u << DEFLATE_MAX_HASH_BITS))
+		hashSize <<= 1;
+	while(windowSize < dataLen && windowSize < DEFLATE_MAX_WINDOW)
+		windowSize <<= 1;
+	hashMask = hashSize - 1;
+	windowMask = windowSize - 1;
+
+	sym = EXIP_MALLOC(sizeof(struct lzSymbol)*DEFLATE_BLOCK_SYMBOLS + sizeof(int32_t)*(hashSize + windowSize));
+	if(sym == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+	head = (int32_t*) (sym + DEFLATE_BLOCK_SYMBOLS);
+	prev = head + hashSize;
+	memset(head, 0xFF, sizeof(int32_t)*hashSize);
+
+	// Worst case output: every block stored. Each block but the last one covers at least
+	// DEFLATE_BLOCK_SYMBOLS - 1 bytes and costs up to 6 bytes more for every 64K chunk
+	TRY_CATCH(reserveBytes(out, dataLen + 5*(dataLen/DEFLATE_MAX_STORED) + 6*(dataLen/(DEFLATE_BLOCK_SYMBOLS - 1) + 1) + 16), EXIP_MFREE(sym));
+	bw.ptr = (unsigned char*) out->buf + out->bufContent;
+	bw.bitBuf = 0;
+	bw.bitCount = 0;
+
+	while(i < dataLen)
+	{
+		unsigned int curLen = 0;
+		unsigned int curDist = 0;
+
+		if(i + DEFLATE_MIN_MATCH <= dataLen)
+		{
+			unsigned int h = hash3(data + i, hashMask);
+			int32_t cand = head[h];
+			unsigned int maxLen = dataLen - i > DEFLATE_MAX_MATCH ? DEFLATE_MAX_MATCH : (unsigned int) (dataLen - i);
+			unsigned int chain = DEFLATE_MAX_CHAIN;
+			unsigned int best = DEFLATE_MIN_MATCH - 1;
+
+			if(prevLen >= DEFLATE_GOOD_MATCH)
+				chain = chain >> 2;
+
+			while(cand >= 0 && i - (Index) cand <= DEFLATE_MAX_WINDOW && chain-- > 0)
+			{
+				const unsigned char* a = data + cand;
+				const unsigned char* b = data + i;
+
+				if(a[best] == b[best] && a[0] == b[0] && a[1] == b[1])
+				{
+					unsigned int len = 2;
+					while(len < maxLen && a[len] == b[len])
+						len++;
+					if(len > best)
+					{
+						best = len;
+						curDist = (unsigned int) (i - cand);
+						if(len == maxLen)
+							break;
+					}
+				}
+
+				{
+					int32_t nextCand = prev[cand & windowMask];
+					if(nextCand >= cand)
+						break;
+					cand = nextCand;
+				}
+			}
+			if(best >= DEFLATE_MIN_MATCH)
+				curLen = best;
+
+			prev[i & windowMask] = head[h];
+			head[h] = (int32_t) i;
+		}
+
+		if(prevLen >= DEFLATE_MIN_MATCH && curLen <= prevLen)
+		{
+			// Emit the match starting at the previous position
+			Index matchEnd = i - 1 + prevLen;
+
+			sym[symCount].litLen = (uint16_t) prevLen;
+			sym[symCount].dist = (uint16_t) prevDist;
+			symCount++;
+
+			for(i = i + 1; i < matchEnd; i++)
+			{
+				if(i + DEFLATE_MIN_MATCH <= dataLen)
+				{
+					unsigned int h = hash3(data + i, hashMask);
+					prev[i & windowMask] = head[h];
+					head[h] = (int32_t) i;
+				}
+			}
+			matchAvailable = FALSE;
+			prevLen = 0;
+		}
+		else
+		{
+			if(matchAvailable)
+			{
+				sym[symCount].litLen = data[i - 1];
+				sym[symCount].dist = 0;
+				symCount++;
+			}
+			matchAvailable = TRUE;
+			prevLen = curLen;
+			prevDist = curDist;
+			i++;
+		}
+
+		if(symCount >= DEFLATE_BLOCK_SYMBOLS - 1 && !matchAvailable)
+		{
+			writeBlock(&bw, sym, symCount, data + blockStart, i - blockStart, FALSE);
+			blockStart = i;
+			symCount = 0;
+		}
+		else if(symCount >= DEFLATE_BLOCK_SYMBOLS - 1)
+		{
+			// The pending literal/match at i - 1 is not yet emitted
+			writeBlock(&bw, sym, symCount, data + blockStart, i - 1 - blockStart, FALSE);
+			blockStart = i - 1;
+			symCount = 0;
+		}
+	}
+
+	if(matchAvailable)
+	{
+		sym[symCount].litLen = data[dataLen - 1];
+		sym[symCount].dist = 0;
+		symCount++;
+	}
+
+	writeBlock(&bw, sym, symCount, data + blockStart, dataLen - blockStart, TRUE);
+	flushBits(&bw);
+
+	out->bufContent = (Index) (bw.ptr - (unsigned char*) out->buf);
+	EXIP_MFREE(sym);
+
+	return EXIP_OK;
+}
+
+/****************************************************************
+ *                         INFLATE                               *
+ ****************************************************************/
+
+/** Canonical Huffman decoding table */
+struct huffTable
+{
+	uint16_t count[MAX_CODE_BITS + 1];
+	uint16_t symbol[LITLEN_CODES];
+	/** (code length << 9 | symbol) for all codes not longer than INFLATE_FAST_BITS; 0 if longer */
+	uint16_t fast[1 << INFLATE_FAST_BITS];
+};
+
+/** LSB-first bit reader over the EXI stream buffer */
+struct bitReader
+{
+	EXIStream* strm;
+	uint32_t bitBuf;
+	unsigned char bitCount;
+};
+
+/**
+ * Loads the bit buffer with the bytes available in the stream buffer
+ * without refilling it. The bytes that turn out not to be part of the
+ * DEFLATE stream can therefore always be returned to the stream.
+ */
+static void prefetchBytes(struct bitReader* br)
+{
+	EXIStream* strm = br->strm;
+	while(br->bitCount <= 24 && strm->context.bufferIndx < strm->buffer.bufContent)
+	{
+		br->bitBuf |= ((uint32_t) (unsigned char) strm->buffer.buf[strm->context.bufferIndx]) << br->bitCount;
+		strm->context.bufferIndx++;
+		br->bitCount += 8;
+	}
+}
+
+static errorCode needBits(struct bitReader* br, unsigned char n)
+{
+	EXIStream* strm = br->strm;
+	while(br->bitCount < n)
+	{
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+		br->bitBuf |= ((uint32_t) (unsigned char) strm->buffer.buf[strm->context.bufferIndx]) << br->bitCount;
+		strm->context.bufferIndx++;
+		br->bitCount += 8;
+	}
+	return EXIP_OK;
+}
+
+static errorCode getBits(struct bitReader* br, unsigned char n, unsigned int* val)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	TRY(needBits(br, n));
+	*val = br->bitBuf & ((((uint32_t) 1) << n) - 1);
+	br->bitBuf >>= n;
+	br->bitCount -= n;
+
+	return EXIP_OK;
+}
+
+static errorCode buildHuffTable(struct huffTable* h, const unsigned char* lens, unsigned int n)
+{
+	uint16_t offs[MAX_CODE_BITS + 2];
+	int left = 1;
+	unsigned int len, i, code, idx;
+
+	memset(h->count, 0, sizeof(h->count));
+	memset(h->fast, 0, sizeof(h->fast));
+	for(i = 0; i < n; i++)
+		h->count[lens[i]]++;
+
+	// Over-subscribed codes are invalid. Incomplete codes are tolerated
+	for(len = 1; len <= MAX_CODE_BITS; len++)
+	{
+		left <<= 1;
+		left -= h->count[len];
+		if(left < 0)
+			return EXIP_INVALID_EXI_INPUT;
+	}
+
+	offs[1] = 0;
+	for(len = 1; len <= MAX_CODE_BITS; len++)
+		offs[len + 1] = offs[len] + h->count[len];
+	for(i = 0; i < n; i++)
+	{
+		if(lens[i] != 0)
+			h->symbol[offs[lens[i]]++] = (uint16_t) i;
+	}
+
+	code = 0;
+	idx = 0;
+	for(len = 1; len <= INFLATE_FAST_BITS; len++)
+	{
+		for(i = 0; i < h->count[len]; i++, idx++)
+		{
+			unsigned int k;
+			for(k = reverseBits(code, (unsigned char) len); k < (1u << INFLATE_FAST_BITS); k += (1u << len))
+				h->fast[k] = (uint16_t) ((len << 9) | h->symbol[idx]);
+			code++;
+		}
+		code <<= 1;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode decodeSymbol(struct bitReader* br, const struct huffTable* h, unsigned int* sym)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	uint16_t entry;
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	unsigned int len;
+
+	if(br->bitCount < INFLATE_FAST_BITS)
+		prefetchBytes(br);
+
+	entry = h->fast[br->bitBuf & ((1u << INFLATE_FAST_BITS) - 1)];
+	if(entry != 0 && (entry >> 9) <= br->bitCount)
+	{
+		*sym = entry & 0x1FF;
+		br->bitBuf >>= (entry >> 9);
+		br->bitCount -= (entry >> 9);
+		return EXIP_OK;
+	}
+
+	// Long code or end of the available input: decode bit by bit
+	for(len = 1; len <= MAX_CODE_BITS; len++)
+	{
+		unsigned int bit;
+		int count;
+
+		TRY(getBits(br, 1, &bit));
+		code |= (int) bit;
+		count = h->count[len];
+		if(code - count < first)
+		{
+			*sym = h->symbol[index + (code - first)];
+			return EXIP_OK;
+		}
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+
+	return EXIP_INVALID_EXI_INPUT;
+}
+
+static errorCode inflateStored(struct bitReader* br, BinaryBuffer* out)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIStream* strm = br->strm;
+	unsigned int len, nlen;
+
+	// Skip to a byte boundary
+	br->bitBuf >>= br->bitCount % 8;
+	br->bitCount -= br->bitCount % 8;
+
+	TRY(getBits(br, 16, &len));
+	TRY(getBits(br, 16, &nlen));
+	if(len != (~nlen & 0xFFFF))
+		return EXIP_INVALID_EXI_INPUT;
+
+	TRY(reserveBytes(out, len));
+
+	while(len > 0 && br->bitCount > 0)
+	{
+		out->buf[out->bufContent++] = (char) (br->bitBuf & 0xFF);
+		br->bitBuf >>= 8;
+		br->bitCount -= 8;
+		len--;
+	}
+
+	while(len > 0)
+	{
+		Index avail;
+
+		if(strm->context.bufferIndx >= strm->buffer.bufContent)
+		{
+			TRY(readEXIChunkForParsing(strm, 1));
+		}
+		avail = strm->buffer.bufContent - strm->context.bufferIndx;
+		if(avail > len)
+			avail = len;
+		memcpy(out->buf + out->bufContent, strm->buffer.buf + strm->context.bufferIndx, avail);
+		out->bufContent += avail;
+		strm->context.bufferIndx += avail;
+		len -= (unsigned int) avail;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode inflateCodes(struct bitReader* br, BinaryBuffer* out, Index streamStart,
+								const struct huffTable* lit, const struct huffTable* dist)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int sym;
+
+	while(TRUE)
+	{
+		TRY(decodeSymbol(br, lit, &sym));
+
+		if(out->bufContent + DEFLATE_MAX_MATCH > out->bufLen)
+			TRY(reserveBytes(out, DEFLATE_MAX_MATCH));
+
+		if(sym < END_OF_BLOCK)
+			out->buf[out->bufContent++] = (char) sym;
+		else if(sym == END_OF_BLOCK)
+			return EXIP_OK;
+		else
+		{
+			unsigned int len, dst, extra;
+			unsigned char* to;
+			const unsigned char* from;
+
+			sym -= 257;
+			if(sym >= 29)
+				return EXIP_INVALID_EXI_INPUT;
+			TRY(getBits(br, LENGTH_EXTRA[sym], &extra));
+			len = LENGTH_BASE[sym] + extra;
+
+			TRY(decodeSymbol(br, dist, &sym));
+			if(sym >= DIST_CODES)
+				return EXIP_INVALID_EXI_INPUT;
+			TRY(getBits(br, DIST_EXTRA[sym], &extra));
+			dst = DIST_BASE[sym] + extra;
+
+			if(dst > out->bufContent - streamStart)
+				return EXIP_INVALID_EXI_INPUT;
+
+			to = (unsigned char*) out->buf + out->bufContent;
+			from = to - dst;
+			out->bufContent += len;
+			while(len-- > 0)
+				*to++ = *from++;
+		}
+	}
+}
+
+static errorCode inflateDynamicTables(struct bitReader* br, struct huffTable* lit, struct huffTable* dist)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned char lens[286 + DIST_CODES];
+	unsigned char clLens[CODELEN_CODES] = {0};
+	unsigned int hlit, hdist, hclen;
+	unsigned int i = 0;
+	unsigned int val;
+
+	TRY(getBits(br, 5, &hlit));
+	TRY(getBits(br, 5, &hdist));
+	TRY(getBits(br, 4, &hclen));
+	hlit += 257;
+	hdist += 1;
+	hclen += 4;
+	if(hlit > 286 || hdist > DIST_CODES)
+		return EXIP_INVALID_EXI_INPUT;
+
+	for(i = 0; i < hclen; i++)
+	{
+		TRY(getBits(br, 3, &val));
+		clLens[CODELEN_ORDER[i]] = (unsigned char) val;
+	}
+	TRY(buildHuffTable(lit, clLens, CODELEN_CODES));
+
+	i = 0;
+	while(i < hlit + hdist)
+	{
+		unsigned int sym;
+		unsigned char repVal = 0;
+		unsigned int rep;
+
+		TRY(decodeSymbol(br, lit, &sym));
+		if(sym < 16)
+		{
+			lens[i++] = (unsigned char) sym;
+			continue;
+		}
+
+		if(sym == 16)
+		{
+			if(i == 0)
+				return EXIP_INVALID_EXI_INPUT;
+			repVal = lens[i - 1];
+			TRY(getBits(br, 2, &rep));
+			rep += 3;
+		}
+		else if(sym == 17)
+		{
+			TRY(getBits(br, 3, &rep));
+			rep += 3;
+		}
+		else
+		{
+			TRY(getBits(br, 7, &rep));
+			rep += 11;
+		}
+
+		if(i + rep > hlit + hdist)
+			return EXIP_INVALID_EXI_INPUT;
+		while(rep-- > 0)
+			lens[i++] = repVal;
+	}
+
+	if(lens[END_OF_BLOCK] == 0)
+		return EXIP_INVALID_EXI_INPUT;
+
+	TRY(buildHuffTable(lit, lens, hlit));
+	TRY(buildHuffTable(dist, lens + hlit, hdist));
+
+	return EXIP_OK;
+}
+
+errorCode inflateData(EXIStream* strm, BinaryBuffer* out)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct bitReader br;
+	struct huffTable* tables;
+	Index streamStart = out->bufContent;
+	unsigned int isFinal = 0;
+	unsigned int type;
+
+	if(strm->context.bitPointer != 0)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	tables = EXIP_MALLOC(2*sizeof(struct huffTable));
+	if(tables == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	br.strm = strm;
+	br.bitBuf = 0;
+	br.bitCount = 0;
+
+	while(!isFinal)
+	{
+		TRY_CATCH(getBits(&br, 1, &isFinal), EXIP_MFREE(tables));
+		TRY_CATCH(getBits(&br, 2, &type), EXIP_MFREE(tables));
+
+		if(type == 0)
+		{
+			TRY_CATCH(inflateStored(&br, out), EXIP_MFREE(tables));
+		}
+		else if(type == 1)
+		{
+			unsigned char litLens[LITLEN_CODES];
+			unsigned char distLens[DIST_CODES];
+
+			fixedLengths(litLens, distLens);
+			TRY_CATCH(buildHuffTable(&tables[0], litLens, LITLEN_CODES), EXIP_MFREE(tables));
+			TRY_CATCH(buildHuffTable(&tables[1], distLens, DIST_CODES), EXIP_MFREE(tables));
+			TRY_CATCH(inflateCodes(&br, out, streamStart, &tables[0], &tables[1]), EXIP_MFREE(tables));
+		}
+		else if(type == 2)
+		{
+			TRY_CATCH(inflateDynamicTables(&br, &tables[0], &tables[1]), EXIP_MFREE(tables));
+			TRY_CATCH(inflateCodes(&br, out, streamStart, &tables[0], &tables[1]), EXIP_MFREE(tables));
+		}
+		else
+		{
+			EXIP_MFREE(tables);
+			return EXIP_INVALID_EXI_INPUT;
+		}
+	}
+
+	EXIP_MFREE(tables);
+
+	// Return the whole bytes read in advance; the rest of the last byte is padding
+	strm->context.bufferIndx -= br.bitCount / 8;
+
+	return EXIP_OK;
+}
+
+/****************************************************************
+ *                         Common                                *
+ ****************************************************************/
+
+static errorCode reserveBytes(BinaryBuffer* out, size_t size)
+{
+	if(out->bufContent + size > out->bufLen)
+	{
+		size_t newLen = out->bufLen > 0 ? out->bufLen : 1024;
+		char* ptr;
+
+		while(newLen < out->bufContent + size)
+			newLen = newLen*2;
+
+		ptr = EXIP_REALLOC(out->buf, newLen);
+		if(ptr == NULL)
+			return EXIP_MEMORY_ALLOCATION_ERROR;
+
+		out->buf = ptr;
+		out->bufLen = (Index) newLen;
+	}
+
+	return EXIP_OK;
+}
+
+static unsigned int reverseBits(unsigned int code, unsigned char len)
+{
+	unsigned int res = 0;
+
+	while(len-- > 0)
+	{
+		res = (res << 1) | (code & 1);
+		code >>= 1;
+	}
+
+	return res;
+}
+
+static void fixedLengths(unsigned char* litLens, unsigned char* distLens)
+{
+	unsigned int i;
+
+	for(i = 0; i < 144; i++)
+		litLens[i] = 8;
+	for(; i < 256; i++)
+		litLens[i] = 9;
+	for(; i < 280; i++)
+		litLens[i] = 7;
+	for(; i < LITLEN_CODES; i++)
+		litLens[i] = 8;
+	for(i = 0; i < DIST_CODES; i++)
+		distLens[i] = 5;
+}
+
+#endif /* COMPRESSION_USE */
@@ -22,35 +22,58 @@
 #include <math.h>
 
 
-errorCode encodeNBitUnsignedInteger(EXIStream* strm, unsigned char n, unsigned int int_val)
+static errorCode encodeNBitUIntBitPacked(EXIStream* strm, unsigned char n, unsigned int int_val);
+static errorCode encodeNBitUIntAligned(EXIStream* strm, unsigned char n, unsigned int int_val);
+static errorCode encodeUIntBitPacked(EXIStream* strm, UnsignedInteger int_val);
+static errorCode encodeUIntAligned(EXIStream* strm, UnsignedInteger int_val);
+static errorCode writeOctetsBitPacked(EXIStream* strm, const unsigned char* data, Index len);
+
+static const EncodePrimitives BIT_PACKED_ENCODING = {encodeNBitUIntBitPacked, encodeUIntBitPacked, writeOctetsBitPacked};
+static const EncodePrimitives BYTE_ALIGNED_ENCODING = {encodeNBitUIntAligned, encodeUIntAligned, writeBytes};
+
+void setEncodePrimitives(EXIStream* strm)
 {
-	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> %d [0x%X] (%u bits)", int_val, int_val, n));
 	if(WITH_COMPRESSION(strm->header.opts.enumOpt) == FALSE && GET_ALIGNMENT(strm->header.opts.enumOpt) == BIT_PACKED)
-	{
-		return writeNBits(strm, n, int_val);
-	}
+		strm->encodePrim = &BIT_PACKED_ENCODING;
 	else
-	{
-		unsigned int byte_number = n / 8 + (n % 8 != 0);
-		int tmp_byte_buf;
-		unsigned int i;
+		strm->encodePrim = &BYTE_ALIGNED_ENCODING;
+}
 
-		if(strm->buffer.bufLen < strm->context.bufferIndx + byte_number)
-		{
-			// The buffer end is reached: there are fewer than nbits bits left in the buffer
-			// Flush the buffer if possible
-			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+errorCode encodeNBitUnsignedInteger(EXIStream* strm, unsigned char n, unsigned int int_val)
+{
+	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> %d [0x%X] (%u bits)", int_val, int_val, n));
+	return strm->encodePrim->nBitUnsignedInteger(strm, n, int_val);
+}
 
-			TRY(writeEncodedEXIChunk(strm));
-		}
+static errorCode encodeNBitUIntBitPacked(EXIStream* strm, unsigned char n, unsigned int int_val)
+{
+	return writeNBits(strm, n, int_val);
+}
 
-		for(i = 0; i < byte_number*8; i += 8)
-		{
-			tmp_byte_buf = (int_val >> i) & 0xFF;
-			strm->buffer.buf[strm->context.bufferIndx] = tmp_byte_buf;
-			strm->context.bufferIndx++;
-		}
+static errorCode encodeNBitUIntAligned(EXIStream* strm, unsigned char n, unsigned int int_val)
+{
+	unsigned int byte_number = n / 8 + (n % 8 != 0);
+	unsigned char* buf;
+	unsigned int i;
+
+	if(strm->buffer.bufLen <= strm->context.bufferIndx + byte_number)
+	{
+		// The buffer end is reached: writeEncodedEXIChunk() needs one byte
+		// after the written ones. Flush the buffer if possible
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+		TRY(writeEncodedEXIChunk(strm));
+	}
+
+	// The bytes are in little-endian order
+	buf = (unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+	for(i = 0; i < byte_number; i++)
+	{
+		buf[i] = (unsigned char) int_val;
+		int_val = int_val >> 8;
 	}
+	strm->context.bufferIndx += byte_number;
+
 	return EXIP_OK;
 }
 
@@ -62,35 +85,86 @@ errorCode encodeBoolean(EXIStream* strm, boolean bool_val)
 }
 
 errorCode encodeUnsignedInteger(EXIStream* strm, UnsignedInteger int_val)
+{
+	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (" Write %lu (unsigned)\n", (long unsigned int)int_val));
+	return strm->encodePrim->unsignedInteger(strm, int_val);
+}
+
+static errorCode encodeUIntBitPacked(EXIStream* strm, UnsignedInteger int_val)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	unsigned int tmp_byte_buf = 0;
-	
-	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (" Write %lu (unsigned)\n", (long unsigned int)int_val));
+	unsigned int group_buf;
+	unsigned char group_bits;
+
 	do
 	{
-		tmp_byte_buf = (unsigned int) (int_val & 0x7F);
-		int_val = int_val >> 7;
-		if(int_val)
-			tmp_byte_buf |= 0x80;
+		// Pack up to four octets and emit them with a single writeNBits() call
+		group_buf = 0;
+		group_bits = 0;
+		do
+		{
+			tmp_byte_buf = (unsigned int) (int_val & 0x7F);
+			int_val = int_val >> 7;
+			if(int_val)
+				tmp_byte_buf |= 0x80;
+
+			DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> 0x%.2X", tmp_byte_buf));
+			group_buf = (group_buf << 8) | tmp_byte_buf;
+			group_bits += 8;
+		}
+		while(int_val && group_bits < 32);
 
-		DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> 0x%.2X", tmp_byte_buf));
-		TRY(writeNBits(strm, 8, tmp_byte_buf));
+		TRY(writeNBits(strm, group_bits, group_buf));
 	}
 	while(int_val);
 
 	return EXIP_OK;
 }
 
+static errorCode encodeUIntAligned(EXIStream* strm, UnsignedInteger int_val)
+{
+	unsigned char* buf;
+	unsigned int byte_number = 1;
+	UnsignedInteger tmp_val = int_val >> 7;
+
+	while(tmp_val)
+	{
+		byte_number++;
+		tmp_val = tmp_val >> 7;
+	}
+
+	if(strm->buffer.bufLen <= strm->context.bufferIndx + byte_number)
+	{
+		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+		TRY(writeEncodedEXIChunk(strm));
+		if(strm->buffer.bufLen <= strm->context.bufferIndx + byte_number)
+			return EXIP_OUT_OF_BOUND_BUFFER;
+	}
+
+	buf = (unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+	strm->context.bufferIndx += byte_number;
+	while(--byte_number)
+	{
+		*buf++ = (unsigned char) ((int_val & 0x7F) | 0x80);
+		int_val = int_val >> 7;
+	}
+	*buf = (unsigned char) int_val;
+
+	return EXIP_OK;
+}
+
 errorCode encodeString(EXIStream* strm, const String* string_val)
 {
 	// Assume no Restricted Character Set is defined
 	//TODO: Handle the case when Restricted Character Set is defined
 
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index charCount;
 
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (" Prepare to write string"));
-	TRY(encodeUnsignedInteger(strm, (UnsignedInteger)(string_val->length)));
+	TRY(countStringChars(string_val, &charCount));
+	TRY(encodeUnsignedInteger(strm, (UnsignedInteger) charCount));
 
 	return encodeStringOnly(strm, string_val);
 }
@@ -102,7 +176,6 @@ errorCode encodeStringOnly(EXIStream* strm, const String* string_val)
 
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 	uint32_t tmp_val = 0;
-	Index i = 0;
 	Index readerPosition = 0;
 #if DEBUG_STREAM_IO == ON && EXIP_DEBUG_LEVEL == INFO
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("\n Write string, len %u: ", (unsigned int) string_val->length));
@@ -110,11 +183,28 @@ errorCode encodeStringOnly(EXIStream* strm, const String* string_val)
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("\n"));
 #endif
 	
-	for(i = 0; i < string_val->length; i++)
+	while(readerPosition < string_val->length)
 	{
+		if(sizeof(CharType) == 1)
+		{
+			// The characters below 0x80 are encoded as single octets:
+			// write the whole run with the octets primitive
+			const unsigned char* run = (const unsigned char*) string_val->str + readerPosition;
+			Index runLen = asciiRunLength(run, string_val->length - readerPosition);
+
+			if(runLen > 0)
+			{
+				TRY(strm->encodePrim->octets(strm, run, runLen));
+				readerPosition += runLen;
+				if(readerPosition == string_val->length)
+					break;
+			}
+		}
+
+		// Read the code point directly from the string representation
 		tmp_val = readCharFromString(string_val, &readerPosition);
 
-		TRY(encodeUnsignedInteger(strm, (UnsignedInteger) tmp_val));
+		TRY(strm->encodePrim->unsignedInteger(strm, (UnsignedInteger) tmp_val));
 	}
 
 	return EXIP_OK;
@@ -123,16 +213,55 @@ errorCode encodeStringOnly(EXIStream* strm, const String* string_val)
 errorCode encodeBinary(EXIStream* strm, char* binary_val, Index nbytes)
 {
 	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
-	Index i = 0;
 
 	TRY(encodeUnsignedInteger(strm, (UnsignedInteger) nbytes));
 
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (" Write %u (binary bytes)\n", (unsigned int) nbytes));
-	for(i = 0; i < nbytes; i++)
+	return strm->encodePrim->octets(strm, (unsigned char*) binary_val, nbytes);
+}
+
+static errorCode writeOctetsBitPacked(EXIStream* strm, const unsigned char* data, Index len)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int shift = strm->context.bitPointer;
+	unsigned char* dst;
+	unsigned char carry;
+	Index n;
+	Index i;
+
+	// At a byte boundary the octets are simply copied
+	if(shift == 0)
+		return writeBytes(strm, data, len);
+
+	while(len > 0)
 	{
-		TRY(writeNBits(strm, 8, (unsigned int) binary_val[i]));
+		// Keep the byte at bufferIndx + n for the trailing bits of the last octet:
+		// writeEncodedEXIChunk() preserves the byte at bufferIndx
+		if(strm->context.bufferIndx + 1 >= strm->buffer.bufLen)
+		{
+			TRY(writeEncodedEXIChunk(strm));
+		}
+
+		n = strm->buffer.bufLen - strm->context.bufferIndx - 1;
+		if(n > len)
+			n = len;
+
+		// Shift-merge: every octet is split between two consecutive bytes.
+		// As in writeNBits() the bits following the written ones are zeroed
+		dst = (unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+		carry = (unsigned char) (dst[0] & (0xFF << (8 - shift)));
+		for(i = 0; i < n; i++)
+		{
+			dst[i] = (unsigned char) (carry | (data[i] >> shift));
+			carry = (unsigned char) (data[i] << (8 - shift));
+		}
+		dst[n] = carry;
+
+		strm->context.bufferIndx += n;
+		data += n;
+		len -= n;
 	}
-	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("\n"));
+
 	return EXIP_OK;
 }
 
@@ -153,7 +282,7 @@ errorCode encodeIntegerValue(EXIStream* strm, Integer sint_val)
 		sign = 1;
 	}
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (" Write %ld (signed)", (long int)sint_val));
-	TRY(writeNextBit(strm, sign));
+	TRY(encodeBoolean(strm, sign));
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("\n"));
 	return encodeUnsignedInteger(strm, uval);
 }
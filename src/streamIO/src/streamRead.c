@@ -33,6 +33,7 @@ errorCode readNextBit(EXIStream* strm, boolean* bit_val)
 	if(strm->buffer.bufContent <= strm->context.bufferIndx) // the whole buffer is parsed! read another portion
 	{
 		strm->context.bitPointer = 0;
+		strm->context.bufferOffset += strm->buffer.bufContent;
 		strm->context.bufferIndx = 0;
 		strm->buffer.bufContent = 0;
 		Index numBytesRead = 0;
@@ -45,36 +46,72 @@ errorCode readNextBit(EXIStream* strm, boolean* bit_val)
 
 	*bit_val = (strm->buffer.buf[strm->context.bufferIndx] & (1<<REVERSE_BIT_POSITION(strm->context.bitPointer))) != 0;
 
-	moveBitPointer(strm, 1);
+	// Single bit step: no need for the generic moveBitPointer()
+	if(strm->context.bitPointer == 7)
+	{
+		strm->context.bitPointer = 0;
+		strm->context.bufferIndx++;
+	}
+	else
+		strm->context.bitPointer++;
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("  @%u:%u", (unsigned int) strm->context.bufferIndx, strm->context.bitPointer));
 	return EXIP_OK;
 }
 
 errorCode readBits(EXIStream* strm, unsigned char n, unsigned int* bits_val)
 {
-	unsigned int numBytesToBeRead = 1 + ((n + strm->context.bitPointer - 1) / 8);
+	unsigned int numBytesToBeRead;
 	unsigned int byteIndx = 1;
 	unsigned char *buf;
 
-	if(strm->buffer.bufContent < strm->context.bufferIndx + numBytesToBeRead)
+	if(n == 0)
+	{
+		*bits_val = 0;
+		return EXIP_OK;
+	}
+
+	if(strm->buffer.bufContent >= strm->context.bufferIndx + sizeof(uint64_t))
 	{
-		// The buffer end is reached: there are fewer than n bits left unparsed
-		errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+		// Fast path: at least 8 bytes are left in the buffer so the requested
+		// bits (at most 32 + 7 bit offset) are extracted from a single 64 bit window
+		uint64_t window = loadBigEndian64((unsigned char *) strm->buffer.buf + strm->context.bufferIndx);
 
-		TRY(readEXIChunkForParsing(strm, numBytesToBeRead));
+		*bits_val = (unsigned int) ((window << strm->context.bitPointer) >> (64 - n));
 	}
+	else
+	{
+		numBytesToBeRead = 1 + ((n + strm->context.bitPointer - 1) / 8);
 
-	buf = (unsigned char *) strm->buffer.buf + strm->context.bufferIndx;
+		if(strm->buffer.bufContent < strm->context.bufferIndx + numBytesToBeRead)
+		{
+			// The buffer end is reached: there are fewer than n bits left unparsed
+			errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
 
-	*bits_val = (buf[0] & BIT_MASK[8 - strm->context.bitPointer])<<((numBytesToBeRead-1)*8);
+			TRY(readEXIChunkForParsing(strm, numBytesToBeRead));
+		}
 
-	while(byteIndx < numBytesToBeRead)
-	{
-		*bits_val += (unsigned int) (buf[byteIndx])<<((numBytesToBeRead-byteIndx-1)*8);
-		byteIndx++;
-	}
+		buf = (unsigned char *) strm->buffer.buf + strm->context.bufferIndx;
+
+		if(numBytesToBeRead > 4)
+		{
+			// n + bitPointer exceeds 32 bits: assemble in a 64 bit word
+			uint64_t tmp_val = buf[0] & BIT_MASK[8 - strm->context.bitPointer];
+
+			while(byteIndx < numBytesToBeRead)
+				tmp_val = (tmp_val << 8) | buf[byteIndx++];
+
+			*bits_val = (unsigned int) (tmp_val >> (numBytesToBeRead*8 - n - strm->context.bitPointer));
+		}
+		else
+		{
+			*bits_val = buf[0] & BIT_MASK[8 - strm->context.bitPointer];
 
-	*bits_val = *bits_val >> (numBytesToBeRead*8 - n - strm->context.bitPointer);
+			while(byteIndx < numBytesToBeRead)
+				*bits_val = (*bits_val << 8) | buf[byteIndx++];
+
+			*bits_val = *bits_val >> (numBytesToBeRead*8 - n - strm->context.bitPointer);
+		}
+	}
 
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, (">> %d [0x%X] (%u bits)", *bits_val, *bits_val, n));
 
@@ -86,4 +123,3 @@ errorCode readBits(EXIStream* strm, unsigned char n, unsigned int* bits_val)
 
 	return EXIP_OK;
 }
-
@@ -31,6 +31,7 @@ errorCode writeNextBit(EXIStream* strm, boolean bit_val)
 		if(numBytesWritten < strm->buffer.bufLen)
 			return EXIP_BUFFER_END_REACHED;
 		strm->context.bitPointer = 0;
+		strm->context.bufferOffset += strm->buffer.bufLen;
 		strm->context.bufferIndx = 0;
 	}
 
@@ -39,7 +40,14 @@ errorCode writeNextBit(EXIStream* strm, boolean bit_val)
 	else
 		strm->buffer.buf[strm->context.bufferIndx] = strm->buffer.buf[strm->context.bufferIndx] | (1<<REVERSE_BIT_POSITION(strm->context.bitPointer));
 
-	moveBitPointer(strm, 1);
+	// Single bit step: no need for the generic moveBitPointer()
+	if(strm->context.bitPointer == 7)
+	{
+		strm->context.bitPointer = 0;
+		strm->context.bufferIndx++;
+	}
+	else
+		strm->context.bitPointer++;
 	DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("  @%u:%u", (unsigned int) strm->context.bufferIndx, strm->context.bitPointer));
 	return EXIP_OK;
 }
@@ -60,6 +68,28 @@ errorCode writeNBits(EXIStream* strm, unsigned char nbits, unsigned int bits_val
 		TRY(writeEncodedEXIChunk(strm));
 	}
 
+	if(nbits > 0 && strm->buffer.bufLen >= strm->context.bufferIndx + sizeof(uint64_t))
+	{
+		// Fast path: read-modify-write of a single 64 bit big-endian window.
+		// As in the byte-wise loop below, the bits following the written ones
+		// within the last touched byte are zeroed and the later bytes are kept.
+		unsigned char* buf = (unsigned char*) strm->buffer.buf + strm->context.bufferIndx;
+		unsigned int totalBits = strm->context.bitPointer + nbits;
+		unsigned int touchedBytes = (totalBits + 7) / 8;
+		uint64_t window = loadBigEndian64(buf);
+		uint64_t clearMask = (~((uint64_t) 0) >> strm->context.bitPointer) & ~(~((uint64_t) 0) >> (touchedBytes*8));
+		uint64_t value = ((uint64_t) bits_val) & (~((uint64_t) 0) >> (64 - nbits));
+
+		window = (window & ~clearMask) | (value << (64 - totalBits));
+		storeBigEndian64(buf, window);
+
+		strm->context.bufferIndx += totalBits / 8;
+		strm->context.bitPointer = totalBits % 8;
+
+		DEBUG_MSG(INFO, DEBUG_STREAM_IO, ("  @%u:%u\n", (unsigned int) strm->context.bufferIndx, strm->context.bitPointer));
+		return EXIP_OK;
+	}
+
 	while(numBitsWrite < nbits)
 	{
 		if((unsigned int)(nbits - numBitsWrite) <= (unsigned int)(8 - strm->context.bitPointer)) // The rest of the unwritten bits can be put in the current byte from the stream
@@ -79,3 +109,32 @@ errorCode writeNBits(EXIStream* strm, unsigned char nbits, unsigned int bits_val
 
 	return EXIP_OK;
 }
+
+errorCode writeBytes(EXIStream* strm, const unsigned char* data, Index len)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index chunk;
+
+	if(strm->context.bitPointer != 0)
+		return EXIP_INCONSISTENT_PROC_STATE;
+
+	while(len > 0)
+	{
+		// Keep one byte free: writeEncodedEXIChunk() preserves the byte at bufferIndx
+		if(strm->context.bufferIndx + 1 >= strm->buffer.bufLen)
+		{
+			TRY(writeEncodedEXIChunk(strm));
+		}
+
+		chunk = strm->buffer.bufLen - strm->context.bufferIndx - 1;
+		if(chunk > len)
+			chunk = len;
+
+		memcpy(strm->buffer.buf + strm->context.bufferIndx, data, chunk);
+		strm->context.bufferIndx += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+
+	return EXIP_OK;
+}
@@ -101,6 +101,67 @@ errorCode addValueEntry(EXIStream* strm, String valueStr, QNameID qnameID);
  */
 errorCode addPfxEntry(PfxTable* pfxTable, String pfxStr, SmallIndex* pfxEntryId);
 
+/**
+ * @brief Records the number of entries of a URI table and of its
+ * local-name and prefix partitions in a StringTablesMark
+ *
+ * @param[in] uriTable URI string table
+ * @param[in, out] memList the mark is allocated in this allocation list
+ * @param[out] mark the recorded size of the tables
+ * @return Error handling code
+ */
+errorCode markStringTables(UriTable* uriTable, AllocList* memList, StringTablesMark* mark);
+
+/**
+ * @brief Removes the entries added to a URI table and its partitions after
+ * markStringTables() was called. The memory of the removed partitions is freed
+ * but not the strings of the removed entries. Tables that are already smaller
+ * than the mark are left as they are.
+ *
+ * @param[in, out] uriTable URI string table
+ * @param[in] mark the size of the tables to be restored
+ */
+void restoreStringTables(UriTable* uriTable, StringTablesMark* mark);
+
+/**
+ * @brief Creates a URI table holding the entries of another one up to a mark,
+ * i.e. the string tables as they were when markStringTables() was called.
+ * The strings are shared with the source table. The local names have no value
+ * cross tables and refer only to the grammars below staticGrCount.
+ * Used for the initial string tables of the self-contained elements.
+ * @param[in] src URI string table to be copied
+ * @param[in] mark the size of the tables to be copied
+ * @param[in] staticGrCount the number of grammars that are not built-in element grammars
+ * @param[out] dst the new URI table; to be freed with destroyStringTables() even on error
+ * @return Error handling code
+ */
+errorCode copyStringTables(UriTable* src, StringTablesMark* mark, Index staticGrCount, UriTable* dst);
+
+/**
+ * @brief Frees the memory of a URI table and of all its partitions
+ * but not the strings of the entries
+ * @param[in, out] uriTable URI string table
+ */
+void destroyStringTables(UriTable* uriTable);
+
+#if VALUE_CROSSTABLE_USE
+/**
+ * @brief Frees the value cross tables of all the local names in a URI table
+ *
+ * @param[in, out] uriTable URI string table
+ */
+void destroyVxTables(UriTable* uriTable);
+#endif
+
+/**
+ * @brief Removes all the entries of the value table of a stream
+ * together with their value cross tables and hash table entries.
+ * The memory of the table itself is kept for reuse.
+ *
+ * @param[in, out] strm EXI stream
+ */
+void clearValueTable(EXIStream* strm);
+
 /**
  * @brief Create an initial string table entry
  * Create an initial string table entry, including URI, prefix and local name partitions
@@ -132,7 +193,9 @@ errorCode createUriTableEntries(UriTable* uriTable, boolean withSchema);
 
 /**
  * @brief Search the URI table for a particular string value
- * Implements full scan
+ * Implements full scan or, when STRING_TABLE_HASH_USE is enabled and the table
+ * has at least STRING_TABLE_HASH_THRESHOLD entries, a search in its hash index.
+ * The index is built on the first such search.
  *
  * @param[in] uriTable URI table to be searched
  * @param[in] uriStr The string searched for
@@ -143,8 +206,9 @@ boolean lookupUri(UriTable* uriTable, String uriStr, SmallIndex* uriEntryId);
 
 /**
  * @brief Search the local names table for a particular string value
- * Implements full scan
- * RCC 20120201: Try to optimize?
+ * Implements full scan or, when STRING_TABLE_HASH_USE is enabled and the table
+ * has at least STRING_TABLE_HASH_THRESHOLD entries, a search in its hash index.
+ * The index is built on the first such search.
  *
  * @param[in] lnTable Local names table to be searched
  * @param[in] lnStr The local name string searched for
@@ -153,6 +217,17 @@ boolean lookupUri(UriTable* uriTable, String uriStr, SmallIndex* uriEntryId);
  */
 boolean lookupLn(LnTable* lnTable, String lnStr, Index* lnEntryId);
 
+#if STRING_TABLE_HASH_USE
+/**
+ * @brief Frees the hash indexes of a URI table and of all its local-name tables.
+ * Must be called before the string tables are destroyed and after the order of
+ * their entries is changed. The indexes are rebuilt by the next lookup.
+ *
+ * @param[in, out] uriTable URI table
+ */
+void destroyStringTableIndexes(UriTable* uriTable);
+#endif
+
 /**
  * @brief Search the Prefix table for a particular string value
  * Implements full scan
@@ -167,9 +242,9 @@ boolean lookupPfx(PfxTable* pfxTable, String pfxStr, SmallIndex* pfxEntryId);
 #if VALUE_CROSSTABLE_USE
 /**
  * @brief Search the value cross table for a particular string value
- * Search the value cross table (local partition of the value table) for a particular string value
- * Implements full scan
- * RCC 20120201: Try to optimize?
+ * Search the value cross table (local partition of the value table) for a particular string value.
+ * When the value table has a hash table the value is found through it in constant time,
+ * otherwise the local partition is scanned.
  *
  * @param[in] valueTable Global Value table - used to check the string values
  * @param[in] vxTable Value cross table - local partition of the Value table to be searched
@@ -19,6 +19,7 @@
 #include "memManagement.h"
 #include "hashtable.h"
 #include "dynamicArray.h"
+#include <stddef.h>
 
 /********* BEGIN: String table default entries ***************/
 
@@ -170,6 +171,150 @@ errorCode createPfxTable(PfxTable** pfxTable)
 	return EXIP_OK;
 }
 
+#if STRING_TABLE_HASH_USE
+
+/** The String at byte offset strOffset of entry i in an array of entries with size entrySize */
+#define TABLE_ENTRY_STR(base, entrySize, strOffset, i) (*(String*) ((unsigned char*) (base) + (i)*(entrySize) + (strOffset)))
+
+static void insertIndexSlot(StringTableIndex* index, String str, Index entryId)
+{
+	Index mask = index->size - 1;
+	Index s = stringHash(str) & mask;
+
+	while(index->slots[s] != 0)
+		s = (s + 1) & mask;
+
+	index->slots[s] = entryId + 1;
+}
+
+/**
+ * @brief (Re)builds the hash index of a string table with count entries.
+ * The index is sized for a load factor of at most 1/2.
+ * @return FALSE if the memory allocation fails; the old index, if any, is kept then
+ */
+static boolean buildIndex(StringTableIndex* index, void* base, size_t entrySize, size_t strOffset, Index count)
+{
+	Index size = 2*STRING_TABLE_HASH_THRESHOLD;
+	Index* slots;
+	Index i;
+
+	while(size < 2*count)
+		size = 2*size;
+
+	slots = EXIP_CALLOC(size, sizeof(Index));
+	if(slots == NULL)
+		return FALSE;
+
+	if(index->slots != NULL)
+		EXIP_MFREE(index->slots);
+	index->slots = slots;
+	index->size = size;
+
+	for(i = 0; i < count; i++)
+		insertIndexSlot(index, TABLE_ENTRY_STR(base, entrySize, strOffset, i), i);
+
+	return TRUE;
+}
+
+static boolean searchIndex(StringTableIndex* index, void* base, size_t entrySize, size_t strOffset, String str, Index* entryId)
+{
+	Index mask = index->size - 1;
+	Index s = stringHash(str) & mask;
+
+	while(index->slots[s] != 0)
+	{
+		if(stringEqual(TABLE_ENTRY_STR(base, entrySize, strOffset, index->slots[s] - 1), str))
+		{
+			*entryId = index->slots[s] - 1;
+			return TRUE;
+		}
+		s = (s + 1) & mask;
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Adds the last of the count entries of a string table to its hash index, if any.
+ * The index is rebuilt in a twice bigger array when the load factor exceeds 1/2
+ * and dropped, to be rebuilt on the next lookup, if that fails.
+ */
+static void indexLastEntry(StringTableIndex* index, void* base, size_t entrySize, size_t strOffset, Index count)
+{
+	if(index->slots == NULL)
+		return;
+
+	if(2*count > index->size)
+	{
+		if(!buildIndex(index, base, entrySize, strOffset, count))
+		{
+			EXIP_MFREE(index->slots);
+			index->slots = NULL;
+			index->size = 0;
+		}
+	}
+	else
+		insertIndexSlot(index, TABLE_ENTRY_STR(base, entrySize, strOffset, count - 1), count - 1);
+}
+
+static void destroyIndex(StringTableIndex* index)
+{
+	if(index->slots != NULL)
+		EXIP_MFREE(index->slots);
+	index->slots = NULL;
+	index->size = 0;
+}
+
+/**
+ * @brief Removes entry entryId from a hash index, if indexed.
+ * The following slots of its cluster are shifted back so that no tombstones are needed.
+ */
+static void removeIndexSlot(StringTableIndex* index, void* base, size_t entrySize, size_t strOffset, Index entryId)
+{
+	Index mask = index->size - 1;
+	Index s;
+	Index next;
+	Index home;
+
+	if(index->slots == NULL)
+		return;
+
+	s = stringHash(TABLE_ENTRY_STR(base, entrySize, strOffset, entryId)) & mask;
+	while(index->slots[s] != entryId + 1)
+	{
+		if(index->slots[s] == 0)
+			return;
+		s = (s + 1) & mask;
+	}
+
+	next = (s + 1) & mask;
+	while(index->slots[next] != 0)
+	{
+		home = stringHash(TABLE_ENTRY_STR(base, entrySize, strOffset, index->slots[next] - 1)) & mask;
+		// The entry can fill the gap if its home slot is not between the gap and the entry
+		if(((next - home) & mask) >= ((next - s) & mask))
+		{
+			index->slots[s] = index->slots[next];
+			s = next;
+		}
+		next = (next + 1) & mask;
+	}
+
+	index->slots[s] = 0;
+}
+
+void destroyStringTableIndexes(UriTable* uriTable)
+{
+	SmallIndex i;
+
+	for(i = 0; i < uriTable->count; i++)
+		destroyIndex(&uriTable->uri[i].lnTable.hashIndex);
+
+	destroyIndex(&uriTable->hashIndex);
+}
+
+#endif /* STRING_TABLE_HASH_USE */
+
 errorCode addUriEntry(UriTable* uriTable, String uriStr, SmallIndex* uriEntryId)
 {
 	errorCode tmp_err_code;
@@ -185,6 +330,11 @@ errorCode addUriEntry(UriTable* uriTable, String uriStr, SmallIndex* uriEntryId)
 	// Create local names table for this URI
 	// TODO RCC 20120201: Should this be separate (empty string URI has no local names)?
 	TRY(createDynArray(&uriEntry->lnTable.dynArray, sizeof(LnEntry), DEFAULT_LN_ENTRIES_NUMBER));
+#if STRING_TABLE_HASH_USE
+	uriEntry->lnTable.hashIndex.slots = NULL;
+	uriEntry->lnTable.hashIndex.size = 0;
+	indexLastEntry(&uriTable->hashIndex, uriTable->uri, sizeof(UriEntry), offsetof(UriEntry, uriStr), uriTable->count);
+#endif
 
 	*uriEntryId = (SmallIndex)uriLEntryId;
 	return EXIP_OK;
@@ -204,6 +354,9 @@ errorCode addLnEntry(LnTable* lnTable, String lnStr, Index* lnEntryId)
 #if VALUE_CROSSTABLE_USE
 	// The Vx table is created on-demand (additions to value cross table are done when a value is inserted in the value table)
 	lnEntry->vxTable = NULL;
+#endif
+#if STRING_TABLE_HASH_USE
+	indexLastEntry(&lnTable->hashIndex, lnTable->ln, sizeof(LnEntry), offsetof(LnEntry, lnStr), lnTable->count);
 #endif
 	return EXIP_OK;
 }
@@ -265,7 +418,9 @@ errorCode addValueEntry(EXIStream* strm, String valueStr, QNameID qnameID)
 		}
 #endif
 		// Free the memory allocated by the previous string entry
-		EXIP_MFREE(valueEntry->valueStr.str);
+		// unless it is in the value arena of the parser
+		if(strm->valueArena == NULL)
+			EXIP_MFREE(valueEntry->valueStr.str);
 	}
 	else
 	{
@@ -301,6 +456,209 @@ errorCode addValueEntry(EXIStream* strm, String valueStr, QNameID qnameID)
 	return EXIP_OK;
 }
 
+errorCode markStringTables(UriTable* uriTable, AllocList* memList, StringTablesMark* mark)
+{
+	SmallIndex i;
+
+	mark->uri = memManagedAllocate(memList, uriTable->count*sizeof(UriEntryMark));
+	if(mark->uri == NULL)
+		return EXIP_MEMORY_ALLOCATION_ERROR;
+
+	mark->uriCount = uriTable->count;
+	for(i = 0; i < uriTable->count; i++)
+	{
+		mark->uri[i].lnCount = uriTable->uri[i].lnTable.count;
+		if(uriTable->uri[i].pfxTable == NULL)
+			mark->uri[i].pfxCount = SMALL_INDEX_MAX;
+		else
+			mark->uri[i].pfxCount = uriTable->uri[i].pfxTable->count;
+	}
+
+	return EXIP_OK;
+}
+
+void restoreStringTables(UriTable* uriTable, StringTablesMark* mark)
+{
+	SmallIndex i;
+#if STRING_TABLE_HASH_USE
+	Index j;
+#endif
+	UriEntry* uriEntry;
+
+	if(mark->uri == NULL)
+		return;
+
+	// The tables never grow back here: they may have been restored
+	// already by another stream using the same schema
+	for(i = mark->uriCount; i < uriTable->count; i++)
+	{
+		uriEntry = &uriTable->uri[i];
+#if STRING_TABLE_HASH_USE
+		destroyIndex(&uriEntry->lnTable.hashIndex);
+		removeIndexSlot(&uriTable->hashIndex, uriTable->uri, sizeof(UriEntry), offsetof(UriEntry, uriStr), i);
+#endif
+		if(uriEntry->pfxTable != NULL)
+			EXIP_MFREE(uriEntry->pfxTable);
+		destroyDynArray(&uriEntry->lnTable.dynArray);
+	}
+
+	if(uriTable->count > mark->uriCount)
+		uriTable->count = mark->uriCount;
+
+	for(i = 0; i < uriTable->count; i++)
+	{
+		uriEntry = &uriTable->uri[i];
+
+#if STRING_TABLE_HASH_USE
+		for(j = mark->uri[i].lnCount; j < uriEntry->lnTable.count; j++)
+			removeIndexSlot(&uriEntry->lnTable.hashIndex, uriEntry->lnTable.ln, sizeof(LnEntry), offsetof(LnEntry, lnStr), j);
+#endif
+		if(uriEntry->lnTable.count > mark->uri[i].lnCount)
+			uriEntry->lnTable.count = mark->uri[i].lnCount;
+
+		if(uriEntry->pfxTable != NULL)
+		{
+			if(mark->uri[i].pfxCount == SMALL_INDEX_MAX)
+			{
+				EXIP_MFREE(uriEntry->pfxTable);
+				uriEntry->pfxTable = NULL;
+			}
+			else if(uriEntry->pfxTable->count > mark->uri[i].pfxCount)
+				uriEntry->pfxTable->count = mark->uri[i].pfxCount;
+		}
+	}
+}
+
+errorCode copyStringTables(UriTable* src, StringTablesMark* mark, Index staticGrCount, UriTable* dst)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	SmallIndex i;
+	SmallIndex uriEntryId;
+	Index j;
+	Index lnEntryId;
+	UriEntry* uriEntry;
+	LnEntry* lnEntry;
+
+	dst->uri = NULL;
+	dst->count = 0;
+#if STRING_TABLE_HASH_USE
+	dst->hashIndex.slots = NULL;
+	dst->hashIndex.size = 0;
+#endif
+	TRY(createDynArray(&dst->dynArray, sizeof(UriEntry), DEFAULT_URI_ENTRIES_NUMBER));
+
+	for(i = 0; i < mark->uriCount; i++)
+	{
+		TRY(addUriEntry(dst, src->uri[i].uriStr, &uriEntryId));
+		uriEntry = &dst->uri[uriEntryId];
+
+		if(mark->uri[i].pfxCount != SMALL_INDEX_MAX)
+		{
+			TRY(createPfxTable(&uriEntry->pfxTable));
+			memcpy(uriEntry->pfxTable->pfxStr, src->uri[i].pfxTable->pfxStr, mark->uri[i].pfxCount*sizeof(String));
+			uriEntry->pfxTable->count = mark->uri[i].pfxCount;
+		}
+
+		for(j = 0; j < mark->uri[i].lnCount; j++)
+		{
+			TRY(addLnEntry(&uriEntry->lnTable, GET_LN_P_URI_IDS(src, i, j).lnStr, &lnEntryId));
+			lnEntry = &uriEntry->lnTable.ln[lnEntryId];
+			if(GET_LN_P_URI_IDS(src, i, j).elemGrammar < staticGrCount)
+				lnEntry->elemGrammar = GET_LN_P_URI_IDS(src, i, j).elemGrammar;
+			if(GET_LN_P_URI_IDS(src, i, j).typeGrammar < staticGrCount)
+				lnEntry->typeGrammar = GET_LN_P_URI_IDS(src, i, j).typeGrammar;
+		}
+	}
+
+	return EXIP_OK;
+}
+
+void destroyStringTables(UriTable* uriTable)
+{
+	SmallIndex i;
+
+#if STRING_TABLE_HASH_USE
+	destroyStringTableIndexes(uriTable);
+#endif
+
+	for(i = 0; i < uriTable->count; i++)
+	{
+		if(uriTable->uri[i].pfxTable != NULL)
+			EXIP_MFREE(uriTable->uri[i].pfxTable);
+
+		destroyDynArray(&uriTable->uri[i].lnTable.dynArray);
+	}
+
+	destroyDynArray(&uriTable->dynArray);
+}
+
+#if VALUE_CROSSTABLE_USE
+void destroyVxTables(UriTable* uriTable)
+{
+	SmallIndex i;
+	Index j;
+	LnEntry* lnEntry;
+
+	for(i = 0; i < uriTable->count; i++)
+	{
+		for(j = 0; j < uriTable->uri[i].lnTable.count; j++)
+		{
+			lnEntry = &GET_LN_P_URI_IDS(uriTable, i, j);
+			if(lnEntry->vxTable != NULL)
+			{
+				assert(lnEntry->vxTable->vx);
+				destroyDynArray(&lnEntry->vxTable->dynArray);
+				lnEntry->vxTable = NULL;
+			}
+		}
+	}
+}
+#endif
+
+void clearValueTable(EXIStream* strm)
+{
+	ValueTable* valueTable = &strm->valueTable;
+	Index i;
+
+	if(valueTable->value == NULL)
+		return;
+
+#if VALUE_CROSSTABLE_USE
+	if(valueTable->count < strm->header.opts.valuePartitionCapacity)
+	{
+		// No global ID wrapped around, so every vxTable
+		// is reachable from the value entries
+		LnEntry* lnEntry;
+
+		for(i = 0; i < valueTable->count; i++)
+		{
+			lnEntry = &GET_LN_URI_QNAME(strm->schema->uriTable, valueTable->value[i].locValuePartition.forQNameId);
+			if(lnEntry->vxTable != NULL)
+			{
+				destroyDynArray(&lnEntry->vxTable->dynArray);
+				lnEntry->vxTable = NULL;
+			}
+		}
+	}
+	else
+		destroyVxTables(&strm->schema->uriTable);
+#endif
+
+	for(i = 0; i < valueTable->count; i++)
+	{
+#if HASH_TABLE_USE
+		if(valueTable->hashTbl != NULL)
+			hashtable_remove(valueTable->hashTbl, valueTable->value[i].valueStr);
+#endif
+		// The strings in the value arena are released together with it
+		if(strm->valueArena == NULL)
+			EXIP_MFREE(valueTable->value[i].valueStr.str);
+	}
+
+	valueTable->count = 0;
+	valueTable->globalId = 0;
+}
+
 errorCode addPfxEntry(PfxTable* pfxTable, String pfxStr, SmallIndex* pfxEntryId)
 {
 	if(pfxTable->count >= MAXIMUM_NUMBER_OF_PREFIXES_PER_URI)
@@ -395,6 +753,20 @@ boolean lookupUri(UriTable* uriTable, String uriStr, SmallIndex* uriEntryId)
 	if(uriTable == NULL)
 		return FALSE;
 
+#if STRING_TABLE_HASH_USE
+	if(uriTable->hashIndex.slots != NULL || (uriTable->count >= STRING_TABLE_HASH_THRESHOLD &&
+			buildIndex(&uriTable->hashIndex, uriTable->uri, sizeof(UriEntry), offsetof(UriEntry, uriStr), uriTable->count)))
+	{
+		Index entryId;
+
+		if(!searchIndex(&uriTable->hashIndex, uriTable->uri, sizeof(UriEntry), offsetof(UriEntry, uriStr), uriStr, &entryId))
+			return FALSE;
+
+		*uriEntryId = (SmallIndex) entryId;
+		return TRUE;
+	}
+#endif
+
 	for(i = 0; i < uriTable->count; i++)
 	{
 		if(stringEqual(uriTable->uri[i].uriStr, uriStr))
@@ -412,6 +784,13 @@ boolean lookupLn(LnTable* lnTable, String lnStr, Index* lnEntryId)
 
 	if(lnTable == NULL)
 		return FALSE;
+
+#if STRING_TABLE_HASH_USE
+	if(lnTable->hashIndex.slots != NULL || (lnTable->count >= STRING_TABLE_HASH_THRESHOLD &&
+			buildIndex(&lnTable->hashIndex, lnTable->ln, sizeof(LnEntry), offsetof(LnEntry, lnStr), lnTable->count)))
+		return searchIndex(&lnTable->hashIndex, lnTable->ln, sizeof(LnEntry), offsetof(LnEntry, lnStr), lnStr, lnEntryId);
+#endif
+
 	for(i = 0; i < lnTable->count; i++)
 	{
 		if(stringEqual(lnTable->ln[i].lnStr, lnStr))
@@ -451,6 +830,28 @@ boolean lookupVx(ValueTable* valueTable, VxTable* vxTable, String valueStr, Inde
 	if(vxTable == NULL || vxTable->vx == NULL)
 		return FALSE;
 
+#if HASH_TABLE_USE
+	if(valueTable->hashTbl != NULL)
+	{
+		// The strings in the value table are unique and each value entry refers back
+		// to its VxEntry so the global index resolves the local partition as well.
+		// Only the VxEntry of the current owner of a global ID holds that ID -
+		// the entries of overwritten values are set to INDEX_MAX by addValueEntry()
+		Index globalId = hashtable_search(valueTable->hashTbl, valueStr);
+
+		if(globalId == INDEX_MAX)
+			return FALSE;
+
+		i = valueTable->value[globalId].locValuePartition.vxEntryId;
+		if(i < vxTable->count && vxTable->vx[i].globalId == globalId)
+		{
+			*vxEntryId = i;
+			return TRUE;
+		}
+		return FALSE;
+	}
+#endif
+
 	for(i = 0; i < vxTable->count; i++)
 	{
 		vxEntry = vxTable->vx + i;
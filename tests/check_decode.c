@@ -18,7 +18,13 @@
 #include <stdlib.h>
 #include <check.h>
 #include "bodyDecode.h"
+#include "EXIParser.h"
 #include "decode.h"
+#include "encode.h"
+#include <unistd.h>
+#if SCHEMA_CACHE_THREAD_SAFE
+# include <pthread.h>
+#endif
 
 #define MAX_PATH_LEN 200
 #define BUFFER_LEN 1024
@@ -145,6 +151,755 @@ START_TEST (test_decodeFromFile)
 	deleteList(&decodedData);
 }
 END_TEST
+
+START_TEST (test_schemaCache)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	List decodedData = newList();
+	List defaultRoot = defaultRootExi();
+	char exiFullPath[MAX_PATH_LEN + strlen(exiPath)];
+	char *exiSchemaFullPath;
+	size_t pathlen;
+	EXIPSchema *schema;
+	EXIPSchema *schemaSecond;
+	EXIPSchema *schemaCached;
+
+	pathlen = strlen(dataDir);
+	memcpy(exiFullPath, dataDir, pathlen);
+	exiFullPath[pathlen] = '/';
+	memcpy(&exiFullPath[pathlen+1], exiPath, strlen(exiPath)+1);
+
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+
+	// A schema in use is not handed out twice
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schemaSecond);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (schemaSecond != schema, "acquireSchema hands out a schema in use\n");
+
+	tmp_err_code = decodeFromFileWithSchema(schemaSecond, OUT_EXI, FALSE, NULL, exiFullPath, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromFileWithSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (cmpStrList(&decodedData, &defaultRoot), "decodeFromFileWithSchema decoded file does not match expected data\n");
+	deleteList(&decodedData);
+	releaseSchema(schemaSecond);
+
+	// A released schema is reused and decodes the same way
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schemaCached);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (schemaCached == schemaSecond, "acquireSchema does not reuse the cached schema\n");
+
+	tmp_err_code = decodeFromFileWithSchema(schemaCached, OUT_EXI, FALSE, NULL, exiFullPath, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromFileWithSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (cmpStrList(&decodedData, &defaultRoot), "decodeFromFileWithSchema decoded file does not match expected data\n");
+
+	releaseSchema(schemaCached);
+	releaseSchema(schema);
+	clearSchemaCache();
+	free(exiSchemaFullPath);
+	deleteList(&decodedData);
+	deleteList(&defaultRoot);
+}
+END_TEST
+
+/* Copies the test data file name into the file path */
+static void copyDataFile(const char* name, const char* path)
+{
+	char fullPath[MAX_PATH_LEN + 64];
+	char buf[BUFFER_LEN];
+	size_t len;
+	FILE *from;
+	FILE *to;
+
+	snprintf(fullPath, sizeof(fullPath), "%s/%s", dataDir, name);
+	from = fopen(fullPath, "rb");
+	ck_assert_msg (from, "Unable to open file %s", fullPath);
+	to = fopen(path, "wb");
+	ck_assert_msg (to, "Unable to open file %s", path);
+
+	while((len = fread(buf, 1, BUFFER_LEN, from)) > 0)
+		ck_assert (fwrite(buf, 1, len, to) == len);
+
+	fclose(from);
+	fclose(to);
+}
+
+START_TEST (test_schemaCacheChange)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char schemaFile[] = "/tmp/exipSchemaXXXXXX";
+	int fd;
+	EXIPSchema *schema;
+	EXIPSchema *schemaChanged;
+	EXIPSchema *schemaCached;
+	Index grammarCount;
+
+	clearSchemaCache();
+	fd = mkstemp(schemaFile);
+	ck_assert_msg (fd >= 0, "Unable to create a temporary schema file\n");
+	close(fd);
+
+	copyDataFile("exip/schema_demo.exi", schemaFile);
+	tmp_err_code = acquireSchema(schemaFile, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	grammarCount = schema->staticGrCount;
+
+	// The schema in use is kept until it is released but not handed out
+	// again once its file has changed
+	copyDataFile("testStates/acceptance-xsd.exi", schemaFile);
+	tmp_err_code = acquireSchema(schemaFile, NULL, &schemaChanged);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (schemaChanged != schema, "acquireSchema hands out a schema in use\n");
+	ck_assert_msg (schemaChanged->staticGrCount != grammarCount, "acquireSchema does not parse the changed schema file\n");
+	ck_assert_msg (getSchemaCacheCount() == 2, "the schema cache keeps %u instances\n", getSchemaCacheCount());
+
+	releaseSchema(schema);
+	ck_assert_msg (getSchemaCacheCount() == 1, "releaseSchema keeps the schema of a changed file\n");
+
+	releaseSchema(schemaChanged);
+	tmp_err_code = acquireSchema(schemaFile, NULL, &schemaCached);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (schemaCached == schemaChanged, "acquireSchema does not reuse the cached schema\n");
+
+	releaseSchema(schemaCached);
+	clearSchemaCache();
+	ck_assert_msg (getSchemaCacheCount() == 0, "clearSchemaCache keeps %u instances\n", getSchemaCacheCount());
+	unlink(schemaFile);
+}
+END_TEST
+
+START_TEST (test_schemaCacheIdle)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char *exiSchemaFullPath;
+	EXIPSchema *schema[SCHEMA_CACHE_IDLE_INSTANCES + 2];
+	int i;
+
+	clearSchemaCache();
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	for(i = 0; i < SCHEMA_CACHE_IDLE_INSTANCES + 2; i++)
+	{
+		tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema[i]);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+	}
+	ck_assert_msg (getSchemaCacheCount() == SCHEMA_CACHE_IDLE_INSTANCES + 2, "the schema cache keeps %u instances\n", getSchemaCacheCount());
+
+	// Only the idle instances within the bound are kept after the peak
+	for(i = 0; i < SCHEMA_CACHE_IDLE_INSTANCES + 2; i++)
+		releaseSchema(schema[i]);
+	ck_assert_msg (getSchemaCacheCount() == SCHEMA_CACHE_IDLE_INSTANCES, "releaseSchema keeps %u instances\n", getSchemaCacheCount());
+
+	clearSchemaCache();
+	free(exiSchemaFullPath);
+}
+END_TEST
+
+#if SCHEMA_CACHE_THREAD_SAFE
+
+#define CACHE_THREADS 4
+#define CACHE_ITERATIONS 20
+
+struct CacheThread
+{
+	pthread_t thread;
+	char* schemaPath;
+	char* exiPath;
+	int failures;
+};
+
+static void* decodeWithCache(void* arg)
+{
+	struct CacheThread* ct = (struct CacheThread*) arg;
+	List defaultRoot = defaultRootExi();
+	List decodedData;
+	int i;
+
+	for(i = 0; i < CACHE_ITERATIONS; i++)
+	{
+		decodedData = newList();
+		if(decodeFromFile(ct->schemaPath, OUT_EXI, FALSE, NULL, ct->exiPath, &decodedData) != EXIP_OK ||
+				!cmpStrList(&decodedData, &defaultRoot))
+			ct->failures++;
+		deleteList(&decodedData);
+	}
+
+	deleteList(&defaultRoot);
+	return NULL;
+}
+
+START_TEST (test_schemaCacheConcurrent)
+{
+	struct CacheThread ct[CACHE_THREADS];
+	char exiFullPath[MAX_PATH_LEN + strlen(exiPath)];
+	char *exiSchemaFullPath;
+	int i;
+
+	clearSchemaCache();
+	snprintf(exiFullPath, sizeof(exiFullPath), "%s/%s", dataDir, exiPath);
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	for(i = 0; i < CACHE_THREADS; i++)
+	{
+		ct[i].schemaPath = exiSchemaFullPath;
+		ct[i].exiPath = exiFullPath;
+		ct[i].failures = 0;
+		ck_assert (pthread_create(&ct[i].thread, NULL, decodeWithCache, &ct[i]) == 0);
+	}
+
+	for(i = 0; i < CACHE_THREADS; i++)
+	{
+		pthread_join(ct[i].thread, NULL);
+		ck_assert_msg (ct[i].failures == 0, "decodeFromFile fails %d times in thread %d\n", ct[i].failures, i);
+	}
+	ck_assert_msg (getSchemaCacheCount() <= SCHEMA_CACHE_IDLE_INSTANCES, "the schema cache keeps %u instances\n", getSchemaCacheCount());
+
+	clearSchemaCache();
+	free(exiSchemaFullPath);
+}
+END_TEST
+
+#endif /* SCHEMA_CACHE_THREAD_SAFE */
+
+static size_t writeToBuffer(void *buf, size_t size, void *stream)
+{
+	List *text = (List *) stream;
+	pushBack(text, buf, size);
+	return size;
+}
+
+START_TEST (test_decodeEvents)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EventVector events;
+	List text = newList();
+	char exiFullPath[MAX_PATH_LEN + strlen(exiPath)];
+	char *exiSchemaFullPath;
+	size_t pathlen;
+	EXIPSchema *schema;
+	Index i;
+	Index apple = INDEX_MAX;
+	int appleCount = 0;
+	const char *expectedStart = "SD\n"
+			"SE http://exip.sourceforge.net/ one\n"
+			"AT attr=\"---\"\n"
+			"AT http://www.w3.org/2001/XMLSchema-instance schemaLocation=\"http://exip.sourceforge.net/ root.xsd \"\n"
+			"AT subs=\"7E-2\"\n"
+			"SE http://test.org/sub sallad\n"
+			"SE http://test.org/sub apple\n"
+			"AT http://www.w3.org/2001/XMLSchema-instance nil=\"true\"\n"
+			"EE\n"
+			"SE http://test.org/sub orange\n"
+			"CH Name\n"
+			"EE\n"
+			"SE http://test.org/sub grapes\n"
+			"CH 0F00\n";
+	const char *expectedEnd = "SE http://exip.sourceforge.net/ piece\n"
+			"CH root:piece\n"
+			"EE\n"
+			"EE\n"
+			"ED\n";
+
+	pathlen = strlen(dataDir);
+	memcpy(exiFullPath, dataDir, pathlen);
+	exiFullPath[pathlen] = '/';
+	memcpy(&exiFullPath[pathlen+1], exiPath, strlen(exiPath)+1);
+
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+
+	initEventVector(&events);
+	tmp_err_code = decodeEventsFromFile(schema, FALSE, NULL, exiFullPath, &events);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeEventsFromFile returns an error code %d\n", tmp_err_code);
+	releaseSchema(schema);
+
+	ck_assert_msg (events.count == 43, "decodeEventsFromFile returns %d events instead of 43\n", (int) events.count);
+	ck_assert_msg (events.events[0].kind == EV_START_DOCUMENT && events.events[events.count - 1].kind == EV_END_DOCUMENT,
+			"decodeEventsFromFile does not return a whole document\n");
+	ck_assert_msg (events.events[7].kind == EV_FLOAT, "The subs attribute value is not a float\n");
+
+	// The repeated names are interned
+	ck_assert_msg (events.nameCount == 10, "decodeEventsFromFile returns %d names instead of 10\n", (int) events.nameCount);
+	for (i = 0; i < events.count; i++)
+	{
+		if (events.events[i].kind == EV_START_ELEMENT &&
+			strncmp(events.strings + events.names[events.events[i].id].localName.offset, "apple", 5) == 0)
+		{
+			ck_assert_msg (apple == INDEX_MAX || apple == events.events[i].id, "The apple name is not interned\n");
+			apple = events.events[i].id;
+			appleCount++;
+		}
+	}
+	ck_assert_msg (appleCount == 3, "decodeEventsFromFile returns %d apple elements instead of 3\n", appleCount);
+
+	tmp_err_code = writeEventVector(&events, OUT_EXI, writeToBuffer, &text);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "writeEventVector returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (text.size == 1, "writeEventVector does not buffer its output\n");
+	ck_assert_msg (strncmp(text.head->data, expectedStart, strlen(expectedStart)) == 0 &&
+			text.head->size >= strlen(expectedEnd) &&
+			strcmp((char *) text.head->data + text.head->size - strlen(expectedEnd), expectedEnd) == 0,
+			"writeEventVector output does not match expected data:\n%s\n", (char *) text.head->data);
+
+	destroyEventVector(&events);
+	clearSchemaCache();
+	free(exiSchemaFullPath);
+	deleteList(&text);
+}
+END_TEST
+
+static void addNameEvent(EventVector* events, unsigned char kind, const char* uri, const char* localName)
+{
+	CodecEvent event;
+	String uriStr = {(CharType*) uri, strlen(uri)};
+	String lnStr = {(CharType*) localName, strlen(localName)};
+
+	memset(&event, 0, sizeof(CodecEvent));
+	event.kind = kind;
+	if(kind == EV_START_ELEMENT || kind == EV_ATTRIBUTE)
+		ck_assert (internEventName(events, &uriStr, &lnStr, &event.id) == EXIP_OK);
+	else if(kind == EV_STRING)
+		ck_assert (addEventString(events, localName, strlen(localName), &event.value.str) == EXIP_OK);
+	ck_assert (addEvent(events, &event) == EXIP_OK);
+}
+
+START_TEST (test_writeXmlPrefixes)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EventVector events;
+	List text = newList();
+	const char *expected = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<p0:a xmlns:p0=\"urn:p\" xmlns:p1=\"urn:q\" xml:lang=\"en\">"
+			"<p1:b><p0:c xml:space=\"preserve\"></p0:c></p1:b><d></d></p0:a>\n";
+
+	initEventVector(&events);
+	addNameEvent(&events, EV_START_DOCUMENT, "", "");
+	addNameEvent(&events, EV_START_ELEMENT, "urn:p", "a");
+	addNameEvent(&events, EV_ATTRIBUTE, "http://www.w3.org/XML/1998/namespace", "lang");
+	addNameEvent(&events, EV_STRING, "", "en");
+	addNameEvent(&events, EV_START_ELEMENT, "urn:q", "b");
+	addNameEvent(&events, EV_START_ELEMENT, "urn:p", "c");
+	addNameEvent(&events, EV_ATTRIBUTE, "http://www.w3.org/XML/1998/namespace", "space");
+	addNameEvent(&events, EV_STRING, "", "preserve");
+	addNameEvent(&events, EV_END_ELEMENT, "", "");
+	addNameEvent(&events, EV_END_ELEMENT, "", "");
+	addNameEvent(&events, EV_START_ELEMENT, "", "d");
+	addNameEvent(&events, EV_END_ELEMENT, "", "");
+	addNameEvent(&events, EV_END_ELEMENT, "", "");
+	addNameEvent(&events, EV_END_DOCUMENT, "", "");
+
+	// The namespaces get one prefix each, the XML namespace its own "xml" prefix
+	tmp_err_code = writeEventVector(&events, OUT_XML, writeToBuffer, &text);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "writeEventVector returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (text.size == 1 && text.head->size == strlen(expected) &&
+			strncmp(text.head->data, expected, strlen(expected)) == 0,
+			"writeEventVector writes %.*s\n", text.size == 1 ? (int) text.head->size : 0, text.size == 1 ? (char*) text.head->data : "");
+
+	deleteList(&text);
+	destroyEventVector(&events);
+}
+END_TEST
+
+START_TEST (test_encodeEvents)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EventVector events;
+	List decodedData = newList();
+	List defaultRoot = defaultRootExi();
+	char exiFullPath[MAX_PATH_LEN + strlen(exiPath)];
+	char *exiSchemaFullPath;
+	size_t pathlen;
+	EXIPSchema *schema;
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	Node *schemaLocation;
+
+	pathlen = strlen(dataDir);
+	memcpy(exiFullPath, dataDir, pathlen);
+	exiFullPath[pathlen] = '/';
+	memcpy(&exiFullPath[pathlen+1], exiPath, strlen(exiPath)+1);
+
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+
+	initEventVector(&events);
+	tmp_err_code = decodeEventsFromFile(schema, FALSE, NULL, exiFullPath, &events);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeEventsFromFile returns an error code %d\n", tmp_err_code);
+
+	// The serializer does not encode undeclared attributes in schema-informed grammars:
+	// the xsi:schemaLocation attribute and its value are dropped
+	ck_assert_msg (events.events[4].kind == EV_ATTRIBUTE &&
+			strncmp(events.strings + events.names[events.events[4].id].localName.offset, "schemaLocation", 14) == 0,
+			"Unexpected event instead of xsi:schemaLocation\n");
+	memmove(&events.events[4], &events.events[6], (events.count - 6)*sizeof(CodecEvent));
+	events.count -= 2;
+	schemaLocation = popAt(&defaultRoot, 3);
+	clearNode(schemaLocation);
+	free(schemaLocation);
+
+	tmp_err_code = encodeEventsToBuffer(schema, events.hasOptions, &events.options, &events, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "encodeEventsToBuffer returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (encodedLen > 0, "encodeEventsToBuffer returns an empty stream\n");
+
+	// The encoded stream decodes to the same events
+	tmp_err_code = decodeFromBufferWithSchema(schema, OUT_EXI, FALSE, NULL, encoded, encodedLen, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromBufferWithSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (cmpStrList(&decodedData, &defaultRoot), "The encoded events do not match the expected data\n");
+
+	releaseSchema(schema);
+	clearSchemaCache();
+	destroyEventVector(&events);
+	free(encoded);
+	free(exiSchemaFullPath);
+	deleteList(&decodedData);
+	deleteList(&defaultRoot);
+}
+END_TEST
+
+struct XmlChunks
+{
+	const char* text;
+	size_t length;
+	size_t pos;
+};
+
+/* Hands out the document a few bytes at a time so that the tokens span the input blocks */
+static size_t readXmlChunks(void *buf, size_t size, void *stream)
+{
+	struct XmlChunks *chunks = (struct XmlChunks *) stream;
+	size_t count = chunks->length - chunks->pos;
+
+	if(count > 5)
+		count = 5;
+	if(count > size)
+		count = size;
+	memcpy(buf, chunks->text + chunks->pos, count);
+	chunks->pos += count;
+	return count;
+}
+
+START_TEST (test_encodeXml)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	List decodedData = newList();
+	List defaultRoot = defaultRootExi();
+	char *exiSchemaFullPath;
+	EXIPSchema *schema;
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	Node *schemaLocation;
+	struct XmlChunks chunks;
+	const char xml[] =
+		"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		"<!-- the document of root.exi without xsi:schemaLocation -->\n"
+		"<root:one subs=\" 0.070 \" attr=\"-&#45;-\" xmlns:root=\"http://exip.sourceforge.net/\"\r\n"
+		"  xmlns:sub='http://test.org/sub' xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n"
+		"  <sub:sallad>\n"
+		"    <sub:apple xsi:nil=\"true\"/>\n"
+		"    <sub:orange>Name</sub:orange>\n"
+		"    <sub:grapes>0F00</sub:grapes>\n"
+		"    <sub:apple> true </sub:apple>\n"
+		"    <sub:orange>Name&#50;</sub:orange>\n"
+		"    <sub:grapes>0F01</sub:grapes>\n"
+		"    <sub:apple>\tfalse\n</sub:apple>\n"
+		"    <sub:orange>Na<![CDATA[me3]]></sub:orange>\n"
+		"    <sub:grapes>0F02</sub:grapes>\n"
+		"  </sub:sallad>\n"
+		"  <root:piece>root:piece</root:piece >\n"
+		"</root:one>\n";
+
+	exiSchemaFullPath = prependMultiPath(exiSchemaPath, 2, dataDir);
+
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+
+	chunks.text = xml;
+	chunks.length = sizeof(xml) - 1;
+	chunks.pos = 0;
+	tmp_err_code = encodeXmlFromStream(schema, FALSE, NULL, readXmlChunks, &chunks, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "encodeXmlFromStream returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (encodedLen > 0, "encodeXmlFromStream returns an empty stream\n");
+
+	// The header of the stream has no options field
+	tmp_err_code = decodeFromBufferWithSchema(schema, OUT_EXI, TRUE, NULL, encoded, encodedLen, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromBufferWithSchema returns an error code %d\n", tmp_err_code);
+
+	schemaLocation = popAt(&defaultRoot, 3);
+	clearNode(schemaLocation);
+	free(schemaLocation);
+	ck_assert_msg (cmpStrList(&decodedData, &defaultRoot), "The encoded XML document does not match the expected data\n");
+
+	releaseSchema(schema);
+	clearSchemaCache();
+	free(encoded);
+	free(exiSchemaFullPath);
+	deleteList(&decodedData);
+	deleteList(&defaultRoot);
+}
+END_TEST
+
+START_TEST (test_encodeXmlReferences)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	List decodedData = newList();
+	List expected = newList();
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	struct XmlChunks chunks;
+	int i;
+	// The character references may have leading zeros
+	const char xml[] = "<a b=\"&#x0000000041;\">&#0000000066;</a>";
+	const char *expectedEvents[] = {"SD", "SE  a", "AT b=\"A\"", "CH B", "EE", "ED"};
+	// The code points beyond 0x10FFFF are invalid, also when they do not fit in 32 bits
+	const char *invalid[] = {"<a>&#x110000;</a>", "<a>&#x100000041;</a>", "<a>&#4294967361;</a>"};
+
+	for(i = 0; i < (int) (sizeof(expectedEvents)/sizeof(expectedEvents[0])); i++)
+		pushBack(&expected, (void *) expectedEvents[i], strlen(expectedEvents[i]));
+
+	chunks.text = xml;
+	chunks.length = sizeof(xml) - 1;
+	chunks.pos = 0;
+	tmp_err_code = encodeXmlFromStream(NULL, FALSE, NULL, readXmlChunks, &chunks, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "encodeXmlFromStream returns an error code %d\n", tmp_err_code);
+
+	tmp_err_code = decodeFromBuffer(NULL, OUT_EXI, TRUE, NULL, encoded, encodedLen, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromBuffer returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (cmpStrList(&decodedData, &expected), "The character references are not decoded\n");
+	free(encoded);
+
+	for(i = 0; i < (int) (sizeof(invalid)/sizeof(invalid[0])); i++)
+	{
+		chunks.text = invalid[i];
+		chunks.length = strlen(invalid[i]);
+		chunks.pos = 0;
+		tmp_err_code = encodeXmlFromStream(NULL, FALSE, NULL, readXmlChunks, &chunks, &encoded, &encodedLen);
+		ck_assert_msg (tmp_err_code == EXIP_INVALID_INPUT, "The reference of %s is accepted: error code %d\n", invalid[i], tmp_err_code);
+	}
+
+	deleteList(&decodedData);
+	deleteList(&expected);
+}
+END_TEST
+
+/* Hands out the whole document at once so that the delimiter scans see long runs */
+static size_t readXmlBlock(void *buf, size_t size, void *stream)
+{
+	struct XmlChunks *chunks = (struct XmlChunks *) stream;
+	size_t count = chunks->length - chunks->pos;
+
+	if(count > size)
+		count = size;
+	memcpy(buf, chunks->text + chunks->pos, count);
+	chunks->pos += count;
+	return count;
+}
+
+START_TEST (test_encodeXmlDelimiters)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	struct XmlChunks chunks;
+	char run[80];
+	char xml[320];
+	char attrB[128];
+	char attrC[128];
+	char text[128];
+	int k;
+
+	// The delimiters are found at every position of the vector and word blocks
+	for(k = 0; k < 72; k++)
+	{
+		List decodedData = newList();
+		List expected = newList();
+
+		memset(run, 'x', k);
+		run[k] = '\0';
+		sprintf(xml, "<a b=\"%s&amp;\tz\" c='%s>'>%s&lt;z\r\n</a>", run, run, run);
+		sprintf(attrB, "AT b=\"%s& z\"", run);
+		sprintf(attrC, "AT c=\"%s>\"", run);
+		sprintf(text, "CH %s<z\n", run);
+
+		pushBack(&expected, (void *) "SD", 2);
+		pushBack(&expected, (void *) "SE  a", 5);
+		pushBack(&expected, (void *) attrB, strlen(attrB));
+		pushBack(&expected, (void *) attrC, strlen(attrC));
+		pushBack(&expected, (void *) text, strlen(text));
+		pushBack(&expected, (void *) "EE", 2);
+		pushBack(&expected, (void *) "ED", 2);
+
+		chunks.text = xml;
+		chunks.length = strlen(xml);
+		chunks.pos = 0;
+		tmp_err_code = encodeXmlFromStream(NULL, FALSE, NULL, readXmlBlock, &chunks, &encoded, &encodedLen);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "encodeXmlFromStream returns an error code %d for %s\n", tmp_err_code, xml);
+
+		tmp_err_code = decodeFromBuffer(NULL, OUT_EXI, TRUE, NULL, encoded, encodedLen, &decodedData);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromBuffer returns an error code %d\n", tmp_err_code);
+		free(encoded);
+
+		ck_assert_msg (cmpStrList(&decodedData, &expected), "The delimiters of %s are not found\n", xml);
+
+		deleteList(&decodedData);
+		deleteList(&expected);
+	}
+}
+END_TEST
+
+/* Appends the prefixed names and the namespace declarations of the parsed stream to a log */
+static void logQName(char *log, const char *event, const QName qname)
+{
+	size_t len = strlen(log);
+
+	sprintf(log + len, "%s %.*s:%.*s;", event,
+			qname.prefix != NULL ? (int) qname.prefix->length : 1, qname.prefix != NULL ? qname.prefix->str : "-",
+			(int) qname.localName->length, qname.localName->str);
+}
+
+static errorCode logStartElement(QName qname, void *app_data)
+{
+	logQName((char *) app_data, "SE", qname);
+	return EXIP_OK;
+}
+
+static errorCode logAttribute(QName qname, void *app_data)
+{
+	logQName((char *) app_data, "AT", qname);
+	return EXIP_OK;
+}
+
+static errorCode logNamespaceDeclaration(const String ns, const String prefix, boolean isLocalElementNS, void *app_data)
+{
+	char *log = (char *) app_data;
+
+	sprintf(log + strlen(log), "NS %.*s=%.*s %d;", (int) prefix.length, prefix.str, (int) ns.length, ns.str, isLocalElementNS);
+	return EXIP_OK;
+}
+
+START_TEST (test_encodeXmlPrefixes)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXIOptions options;
+	Parser testParser;
+	BinaryBuffer buffer;
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	struct XmlChunks chunks;
+	char log[512] = "";
+	const char xml[] =
+		"<p:a xmlns:q=\"urn:q\" xmlns:p=\"urn:p\" q:b=\"1\">"
+		"<p:c xmlns=\"urn:d\"><e/></p:c>"
+		"</p:a>";
+	// The prefix of an element is given by its first NS event with the local-element-ns flag
+	const char expected[] =
+		"SE -:a;NS q=urn:q 0;NS p=urn:p 1;AT q:b;"
+		"SE p:c;NS =urn:d 0;"
+		"SE :e;";
+
+	makeDefaultOpts(&options);
+	SET_PRESERVED(options.preserve, PRESERVE_PREFIXES);
+
+	chunks.text = xml;
+	chunks.length = sizeof(xml) - 1;
+	chunks.pos = 0;
+	tmp_err_code = encodeXmlFromStream(NULL, TRUE, &options, readXmlChunks, &chunks, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "encodeXmlFromStream returns an error code %d\n", tmp_err_code);
+
+	buffer.buf = encoded;
+	buffer.bufLen = encodedLen;
+	buffer.bufContent = encodedLen;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	tmp_err_code = initParser(&testParser, buffer, log);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d\n", tmp_err_code);
+	testParser.handler.startElement = logStartElement;
+	testParser.handler.attribute = logAttribute;
+	testParser.handler.namespaceDeclaration = logNamespaceDeclaration;
+
+	tmp_err_code = parseHeader(&testParser, FALSE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parseHeader returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (IS_PRESERVED(testParser.strm.header.opts.preserve, PRESERVE_PREFIXES), "The prefixes are not preserved\n");
+	tmp_err_code = setSchema(&testParser, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema returns an error code %d\n", tmp_err_code);
+
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(&testParser);
+
+	destroyParser(&testParser);
+	free(encoded);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "parseNext returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (strcmp(log, expected) == 0, "The prefixes are not encoded: %s\n", log);
+
+	// The comments cannot be encoded: preserving them is rejected
+	makeDefaultOpts(&options);
+	SET_PRESERVED(options.preserve, PRESERVE_COMMENTS);
+	chunks.pos = 0;
+	tmp_err_code = encodeXmlFromStream(NULL, TRUE, &options, readXmlChunks, &chunks, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_NOT_IMPLEMENTED_YET, "Preserving the comments returns an error code %d\n", tmp_err_code);
+}
+END_TEST
+
+START_TEST (test_encodeTypedValues)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	List events = newList();
+	List decodedData = newList();
+	char *exiSchemaFullPath;
+	char *productSchemaPath[1] = {"xsitype/Product.exs"};
+	EXIPSchema *schema;
+	char *encoded = NULL;
+	size_t encodedLen = 0;
+	int i;
+	// The integer values and the xsi:type QName are encoded as typed values.
+	// The name contains the SE and ED event codes: only the leading token classifies a line
+	const char *productEvents[] = {
+		"SD",
+		"SE http://www.exemple.com/XMLNameSpace product",
+		"AT http://www.w3.org/2001/XMLSchema-instance type=\"http://www.exemple.com/XMLNameSpace:ShirtType\"",
+		"AT appId=\"urn:shirts:42\"",
+		"SE  number",
+		"CH 12345",
+		"EE",
+		"SE  name",
+		"CH USED",
+		"EE",
+		"SE  size",
+		"CH -33",
+		"EE",
+		"EE",
+		"ED"
+	};
+
+	for(i = 0; i < (int) (sizeof(productEvents)/sizeof(productEvents[0])); i++)
+		pushBack(&events, (void *) productEvents[i], strlen(productEvents[i]));
+
+	exiSchemaFullPath = prependMultiPath(productSchemaPath, 1, dataDir);
+
+	tmp_err_code = acquireSchema(exiSchemaFullPath, NULL, &schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "acquireSchema returns an error code %d\n", tmp_err_code);
+
+	tmp_err_code = encodeFromBufferWithSchema(schema, IN_EXI, FALSE, NULL, &events, events.size, &encoded, &encodedLen);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "encodeFromBufferWithSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (encodedLen > 0, "encodeFromBufferWithSchema returns an empty stream\n");
+
+	tmp_err_code = decodeFromBufferWithSchema(schema, OUT_EXI, TRUE, NULL, encoded, encodedLen, &decodedData);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "decodeFromBufferWithSchema returns an error code %d\n", tmp_err_code);
+	ck_assert_msg (cmpStrList(&decodedData, &events), "The encoded typed values do not match the input\n");
+
+	releaseSchema(schema);
+	clearSchemaCache();
+	free(encoded);
+	free(exiSchemaFullPath);
+	deleteList(&decodedData);
+	deleteList(&events);
+}
+END_TEST
 /* END: decode tests */
 
 static char* prependMultiPath(char** xsdList, int count, char *prependStr)
@@ -195,8 +950,27 @@ Suite * decode_suite (void)
 	  TCase *tc_decode = tcase_create ("Decode");
 	  tcase_add_test (tc_decode, test_decodeFromBuffer);
 	  tcase_add_test (tc_decode, test_decodeFromFile);
+	  tcase_add_test (tc_decode, test_decodeEvents);
+	  tcase_add_test (tc_decode, test_writeXmlPrefixes);
+	  tcase_add_test (tc_decode, test_encodeEvents);
+	  tcase_add_test (tc_decode, test_encodeXml);
+	  tcase_add_test (tc_decode, test_encodeXmlReferences);
+	  tcase_add_test (tc_decode, test_encodeXmlDelimiters);
+	  tcase_add_test (tc_decode, test_encodeXmlPrefixes);
+	  tcase_add_test (tc_decode, test_encodeTypedValues);
 	  suite_add_tcase (s, tc_decode);
   }
+  {
+	  /* Schema cache test case */
+	  TCase *tc_cache = tcase_create ("SchemaCache");
+	  tcase_add_test (tc_cache, test_schemaCache);
+	  tcase_add_test (tc_cache, test_schemaCacheChange);
+	  tcase_add_test (tc_cache, test_schemaCacheIdle);
+#if SCHEMA_CACHE_THREAD_SAFE
+	  tcase_add_test (tc_cache, test_schemaCacheConcurrent);
+#endif
+	  suite_add_tcase (s, tc_cache);
+  }
 
   return s;
 }
@@ -17,6 +17,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
 #include <check.h>
 #include "procTypes.h"
 #include "EXISerializer.h"
@@ -24,6 +26,11 @@
 #include "stringManipulate.h"
 #include "grammarGenerator.h"
 #include "parseSchema.h"
+#include "memManagement.h"
+#include "bodyDecode.h"
+#include "bodyEncode.h"
+#include "sTables.h"
+#include "schema_demo_codec.h"
 
 #define MAX_PATH_LEN 200
 #define OUTPUT_BUFFER_SIZE 2000
@@ -301,7 +308,7 @@ START_TEST (test_value_part_zero)
 	EXIStream testStrm;
 	String uri;
 	String ln;
-	QName qname = {&uri, &ln, NULL};
+	QName qname = {&uri, &ln};
 	String chVal;
 	BinaryBuffer buffer;
 	EXITypeClass valueType;
@@ -492,7 +499,7 @@ START_TEST (test_recursive_defs)
 	EXIStream testStrm;
 	String uri;
 	String ln;
-	QName qname = {&uri, &ln, NULL};
+	QName qname = {&uri, &ln};
 	String chVal;
 	BinaryBuffer buffer;
 	EXITypeClass valueType;
@@ -782,7 +789,7 @@ errorCode encodeWithDynamicTypes(char* buf, int buf_size, int *strmSize)
 	EXIStream testStrm;
 	String uri;
 	String ln;
-	QName qname = {&uri, &ln, NULL};
+	QName qname = {&uri, &ln};
 
 	BinaryBuffer buffer;
 	EXITypeClass valueType;
@@ -914,7 +921,7 @@ START_TEST (test_large_doc_str_pattern)
 	EXIStream testStrm;
 	String uri;
 	String ln;
-	QName qname = {&uri, &ln, NULL};
+	QName qname = {&uri, &ln};
 	String chVal;
 	char buf[OUTPUT_BUFFER_SIZE_LARGE_DOC];
 	BinaryBuffer buffer;
@@ -1304,6 +1311,2984 @@ END_TEST
 
 /* END: Schema-mode tests */
 
+/* BEGIN: Alignment and compression tests */
+
+#define TRANSCODE_BUFFER_SIZE 100
+#define BENCH_ITERATIONS 50
+
+/* In-memory output or log */
+struct memBuffer
+{
+	char* data;
+	size_t len;
+	size_t cap;
+};
+
+static void appendMemBuffer(struct memBuffer* mem, const void* data, size_t len)
+{
+	if(mem->len + len > mem->cap)
+	{
+		mem->cap = 2*(mem->len + len) + 256;
+		mem->data = realloc(mem->data, mem->cap);
+		if(mem->data == NULL)
+			ck_abort_msg("Memory allocation error");
+	}
+	memcpy(mem->data + mem->len, data, len);
+	mem->len += len;
+}
+
+static size_t writeMemOutputStream(void* buf, size_t size, void* stream)
+{
+	appendMemBuffer((struct memBuffer*) stream, buf, size);
+	return size;
+}
+
+/* Every event is logged unless quiet is set; when transcode is set
+ * the events are also serialized with different alignment options */
+struct transcodeData
+{
+	Parser* src;
+	EXIPSchema* schema;
+	/** BIT_PACKED, BYTE_ALIGNMENT, PRE_COMPRESSION or COMPRESSION */
+	unsigned char alignment;
+	Index blockSize;
+	boolean transcode;
+	boolean quiet;
+	/** Parse with enableStringArena() */
+	boolean stringArena;
+	/** The number of string values that point into the input buffer */
+	unsigned int bufferStrings;
+	/** The content of the elements with this local name is skipped */
+	const char* skipLocalName;
+	/** The transcoded elements with this local name are self-contained */
+	const char* scLocalName;
+	/** The index of the self-contained elements of the transcoding; NULL if not kept */
+	SelfContainedIndex* scIndex;
+	/** The prefixes of the element and attribute QNames are logged */
+	boolean logPrefixes;
+	EXIStream outStrm;
+	char outBuf[TRANSCODE_BUFFER_SIZE];
+	struct memBuffer out;
+	struct memBuffer log;
+};
+
+static void logEvent(struct transcodeData* td, const char* fmt, ...)
+{
+	char line[200];
+	va_list args;
+	int len;
+
+	if(td->quiet)
+		return;
+
+	va_start(args, fmt);
+	len = vsnprintf(line, sizeof(line), fmt, args);
+	va_end(args);
+	appendMemBuffer(&td->log, line, len);
+}
+
+static void logString(struct transcodeData* td, const String* str)
+{
+	if(td->quiet)
+		return;
+	if(str != NULL)
+		appendMemBuffer(&td->log, str->str, str->length);
+	appendMemBuffer(&td->log, "|", 1);
+}
+
+static void logQName(struct transcodeData* td, const char* event, QName qname)
+{
+	logEvent(td, "%s ", event);
+	logString(td, qname.uri);
+	logString(td, qname.localName);
+	if(td->logPrefixes)
+		logString(td, qname.prefix);
+	logEvent(td, "\n");
+}
+
+static errorCode tc_startDocument(void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	BinaryBuffer buffer;
+
+	logEvent(td, "SD\n");
+	if(!td->transcode)
+		return EXIP_OK;
+
+	buffer.buf = td->outBuf;
+	buffer.bufLen = TRANSCODE_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = writeMemOutputStream;
+	buffer.ioStrm.stream = &td->out;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	serialize.initHeader(&td->outStrm);
+	td->outStrm.header.opts = td->src->strm.header.opts;
+	td->outStrm.header.has_options = TRUE;
+	td->outStrm.header.opts.blockSize = td->blockSize;
+	td->outStrm.header.opts.enumOpt &= ~(ALIGNMENT | COMPRESSION);
+	if(td->alignment == COMPRESSION)
+		SET_COMPRESSION(td->outStrm.header.opts.enumOpt);
+	else
+		SET_ALIGNMENT(td->outStrm.header.opts.enumOpt, td->alignment);
+	if(td->scLocalName != NULL)
+		SET_SELF_CONTAINED(td->outStrm.header.opts.enumOpt);
+
+	TRY(serialize.initStream(&td->outStrm, buffer, td->schema));
+	if(td->scIndex != NULL)
+	{
+		TRY(serialize.setSelfContainedIndex(&td->outStrm, td->scIndex));
+	}
+	TRY(serialize.exiHeader(&td->outStrm));
+	return serialize.startDocument(&td->outStrm);
+}
+
+static errorCode tc_endDocument(void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "ED\n");
+	return td->transcode ? serialize.endDocument(&td->outStrm) : EXIP_OK;
+}
+
+static errorCode tc_startElement(QName qname, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	EXITypeClass valueType;
+	logQName(td, "SE", qname);
+	if(td->skipLocalName != NULL && stringEqualToAscii(*qname.localName, td->skipLocalName))
+		return EXIP_HANDLER_SKIP_ELEMENT;
+	if(!td->transcode)
+		return EXIP_OK;
+
+	TRY(serialize.startElement(&td->outStrm, qname, &valueType));
+	if(td->scLocalName != NULL && stringEqualToAscii(*qname.localName, td->scLocalName))
+		return serialize.selfContained(&td->outStrm);
+	return EXIP_OK;
+}
+
+static errorCode tc_endElement(void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "EE\n");
+	return td->transcode ? serialize.endElement(&td->outStrm) : EXIP_OK;
+}
+
+static errorCode tc_attribute(QName qname, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	EXITypeClass valueType;
+	logQName(td, "AT", qname);
+	return td->transcode ? serialize.attribute(&td->outStrm, qname, TRUE, &valueType) : EXIP_OK;
+}
+
+static errorCode tc_intData(Integer int_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "INT %lld\n", (long long int) int_val);
+	return td->transcode ? serialize.intData(&td->outStrm, int_val) : EXIP_OK;
+}
+
+static errorCode tc_booleanData(boolean bool_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "BOOL %d\n", (int) bool_val);
+	return td->transcode ? serialize.booleanData(&td->outStrm, bool_val) : EXIP_OK;
+}
+
+static errorCode tc_stringData(const String str_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	BinaryBuffer* input = &td->src->strm.buffer;
+
+	if(str_val.str >= input->buf && str_val.str < input->buf + input->bufContent)
+		td->bufferStrings++;
+	logEvent(td, "CH ");
+	logString(td, &str_val);
+	logEvent(td, "\n");
+	return td->transcode ? serialize.stringData(&td->outStrm, str_val) : EXIP_OK;
+}
+
+static errorCode tc_floatData(Float fl_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "FLOAT %lldE%d\n", (long long int) fl_val.mantissa, (int) fl_val.exponent);
+	return td->transcode ? serialize.floatData(&td->outStrm, fl_val) : EXIP_OK;
+}
+
+static errorCode tc_binaryData(const char* binary_val, Index nbytes, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "BIN %u ", (unsigned int) nbytes);
+	if(!td->quiet)
+		appendMemBuffer(&td->log, binary_val, nbytes);
+	logEvent(td, "\n");
+	return td->transcode ? serialize.binaryData(&td->outStrm, binary_val, nbytes) : EXIP_OK;
+}
+
+static errorCode tc_dateTimeData(EXIPDateTime dt_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "DT %d-%d-%dT%d:%d:%d.%u/%u %d %u\n", dt_val.dateTime.tm_year, dt_val.dateTime.tm_mon,
+			dt_val.dateTime.tm_mday, dt_val.dateTime.tm_hour, dt_val.dateTime.tm_min, dt_val.dateTime.tm_sec,
+			dt_val.fSecs.value, (unsigned int) dt_val.fSecs.offset, (int) dt_val.TimeZone, (unsigned int) dt_val.presenceMask);
+	return td->transcode ? serialize.dateTimeData(&td->outStrm, dt_val) : EXIP_OK;
+}
+
+static errorCode tc_decimalData(Decimal dec_val, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "DEC %lldE%d\n", (long long int) dec_val.mantissa, (int) dec_val.exponent);
+	return td->transcode ? serialize.decimalData(&td->outStrm, dec_val) : EXIP_OK;
+}
+
+static errorCode tc_listData(EXITypeClass exiType, unsigned int itemCount, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "LIST %d %u\n", (int) exiType, itemCount);
+	return td->transcode ? serialize.listData(&td->outStrm, itemCount) : EXIP_OK;
+}
+
+static errorCode tc_qnameData(const QName qname, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logQName(td, "QNAME", qname);
+	return td->transcode ? serialize.qnameData(&td->outStrm, qname) : EXIP_OK;
+}
+
+static errorCode tc_namespaceDeclaration(const String ns, const String prefix, boolean isLocalElementNS, void* app_data)
+{
+	struct transcodeData* td = (struct transcodeData*) app_data;
+	logEvent(td, "NS ");
+	logString(td, &ns);
+	logString(td, &prefix);
+	logEvent(td, "%d\n", (int) isLocalElementNS);
+	return td->transcode ? serialize.namespaceDeclaration(&td->outStrm, ns, prefix, isLocalElementNS) : EXIP_OK;
+}
+
+static errorCode tc_error(const errorCode code, const char* msg, void* app_data)
+{
+	ck_abort_msg("Parsing error %d: %s", code, msg);
+	return code;
+}
+
+static void setLogHandlers(ContentHandler* handler)
+{
+	handler->startDocument = tc_startDocument;
+	handler->endDocument = tc_endDocument;
+	handler->startElement = tc_startElement;
+	handler->endElement = tc_endElement;
+	handler->attribute = tc_attribute;
+	handler->intData = tc_intData;
+	handler->booleanData = tc_booleanData;
+	handler->stringData = tc_stringData;
+	handler->floatData = tc_floatData;
+	handler->binaryData = tc_binaryData;
+	handler->dateTimeData = tc_dateTimeData;
+	handler->decimalData = tc_decimalData;
+	handler->listData = tc_listData;
+	handler->qnameData = tc_qnameData;
+	handler->namespaceDeclaration = tc_namespaceDeclaration;
+	handler->error = tc_error;
+	handler->fatalError = tc_error;
+}
+
+/* Parses an EXI stream and logs its events; if transcode is TRUE
+ * the events are also serialized in td->out */
+static void parseWithLog(BinaryBuffer buffer, struct transcodeData* td, boolean transcode)
+{
+	Parser parser;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	td->transcode = transcode;
+	td->src = &parser;
+	td->bufferStrings = 0;
+
+	tmp_err_code = initParser(&parser, buffer, td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+
+	if(td->stringArena)
+	{
+		tmp_err_code = parse.enableStringArena(&parser);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "enableStringArena returns an error code %d", tmp_err_code);
+	}
+
+	setLogHandlers(&parser.handler);
+
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+
+	tmp_err_code = setSchema(&parser, td->schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(&parser);
+
+	destroyParser(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the EXI body %d", tmp_err_code);
+
+	if(transcode)
+	{
+		tmp_err_code = serialize.closeEXIStream(&td->outStrm);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+	}
+}
+
+/* Parses an EXI file and logs its events; if transcode is TRUE
+ * the events are also re-encoded in td->out with the options in td */
+static void parseFileWithLog(const char* exifname, struct transcodeData* td, boolean transcode)
+{
+	char buf[INPUT_BUFFER_SIZE];
+	char exipath[MAX_PATH_LEN + 100];
+	BinaryBuffer buffer;
+	FILE *infile;
+	size_t pathlen = strlen(dataDir);
+
+	memcpy(exipath, dataDir, pathlen);
+	exipath[pathlen] = '/';
+	memcpy(&exipath[pathlen+1], exifname, strlen(exifname)+1);
+
+	infile = fopen(exipath, "rb" );
+	if(!infile)
+		ck_abort_msg("Unable to open file %s", exipath);
+
+	buffer.buf = buf;
+	buffer.bufContent = 0;
+	buffer.bufLen = INPUT_BUFFER_SIZE;
+	buffer.ioStrm.readWriteToStream = readFileInputStream;
+	buffer.ioStrm.stream = infile;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	parseWithLog(buffer, td, transcode);
+	fclose(infile);
+}
+
+/* Parses an EXI file and re-encodes it in td->out with the options in td */
+static void transcodeFile(const char* exifname, struct transcodeData* td)
+{
+	parseFileWithLog(exifname, td, TRUE);
+}
+
+/* Returns an input buffer over the in-memory output of a transcoding */
+static BinaryBuffer transcodedBuffer(struct transcodeData* td)
+{
+	BinaryBuffer buffer;
+
+	buffer.buf = td->out.data;
+	buffer.bufContent = td->out.len;
+	buffer.bufLen = td->out.len;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	return buffer;
+}
+
+/* Re-encodes an EXI file with the given alignment option and block size
+ * and checks that the result decodes to the same sequence of events */
+static void checkTranscodeRoundTrip(const char* exifname, EXIPSchema* schema, unsigned char alignment, Index blockSize)
+{
+	struct transcodeData td;
+	struct memBuffer srcLog;
+
+	memset(&td, 0, sizeof(td));
+	td.schema = schema;
+	td.alignment = alignment;
+	td.blockSize = blockSize;
+
+	transcodeFile(exifname, &td);
+
+	srcLog = td.log;
+	td.log.data = NULL;
+	td.log.len = 0;
+	td.log.cap = 0;
+
+	parseWithLog(transcodedBuffer(&td), &td, FALSE);
+
+	ck_assert_msg(td.log.len == srcLog.len && memcmp(td.log.data, srcLog.data, srcLog.len) == 0,
+			"%s: the events decoded with alignment 0x%X and blockSize %u differ from the original",
+			exifname, (unsigned int) alignment, (unsigned int) blockSize);
+
+	free(srcLog.data);
+	free(td.log.data);
+	free(td.out.data);
+}
+
+/* Byte-aligned and bit-packed re-encoding of schema-less and schema-informed streams */
+START_TEST (test_byte_alignment)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	char* schemafname[1] = {"EmptyTypes/emptyTypeSchema-xsd.exi"};
+	EXIPSchema schema;
+	int f;
+
+	for(f = 0; f < 2; f++)
+	{
+		checkTranscodeRoundTrip(files[f], NULL, BIT_PACKED, 1000000);
+		checkTranscodeRoundTrip(files[f], NULL, BYTE_ALIGNMENT, 1000000);
+	}
+
+	parseMultiSchema(schemafname, 1, &schema);
+	checkTranscodeRoundTrip("EmptyTypes/emptyTypeTest-def.exi", &schema, BIT_PACKED, 1000000);
+	checkTranscodeRoundTrip("EmptyTypes/emptyTypeTest-def.exi", &schema, BYTE_ALIGNMENT, 1000000);
+	destroySchema(&schema);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+/* Throughput of the bit-packed and byte-aligned stream primitives on the same documents.
+ * The timing of the encoding includes the decoding of the bit-packed input */
+START_TEST (bench_alignment)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	const unsigned char modes[2] = {BIT_PACKED, BYTE_ALIGNMENT};
+	struct transcodeData src;
+	struct transcodeData td;
+	clock_t start;
+	double decTime, encTime;
+	int f, m, i;
+
+	for(f = 0; f < 2; f++)
+	{
+		// The bit-packed input of the encoding benchmark
+		memset(&src, 0, sizeof(src));
+		src.alignment = BIT_PACKED;
+		src.blockSize = 1000000;
+		src.quiet = TRUE;
+		transcodeFile(files[f], &src);
+
+		for(m = 0; m < 2; m++)
+		{
+			memset(&td, 0, sizeof(td));
+			td.alignment = modes[m];
+			td.blockSize = 1000000;
+			td.quiet = TRUE;
+
+			start = clock();
+			for(i = 0; i < BENCH_ITERATIONS; i++)
+			{
+				free(td.out.data);
+				td.out.data = NULL;
+				td.out.len = 0;
+				td.out.cap = 0;
+				parseWithLog(transcodedBuffer(&src), &td, TRUE);
+			}
+			encTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+			start = clock();
+			for(i = 0; i < BENCH_ITERATIONS; i++)
+				parseWithLog(transcodedBuffer(&td), &td, FALSE);
+			decTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+			printf("%s %s (%u bytes): decoding %.4fs, decoding bit-packed + encoding %.4fs for %d runs\n",
+					files[f], modes[m] == BIT_PACKED ? "bit-packed" : "byte-aligned",
+					(unsigned int) td.out.len, decTime, encTime, BENCH_ITERATIONS);
+
+			free(td.out.data);
+		}
+
+		free(src.out.data);
+	}
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+#if COMPRESSION_USE
+
+/* Schema-less streams in compression and pre-compression mode
+ * with a single block, one value per block and multiple large channels */
+START_TEST (test_compression_schemaless)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	const Index blockSizes[3] = {1000000, 1, 150};
+	int f, b;
+
+	for(f = 0; f < 2; f++)
+	{
+		for(b = 0; b < 3; b++)
+		{
+			checkTranscodeRoundTrip(files[f], NULL, PRE_COMPRESSION, blockSizes[b]);
+			checkTranscodeRoundTrip(files[f], NULL, COMPRESSION, blockSizes[b]);
+		}
+	}
+}
+END_TEST
+
+/* Schema-informed streams with typed values and xsi:nil */
+START_TEST (test_compression_schema)
+{
+	EXIPSchema schema;
+	char* schemafname[2] = {"testStates/acceptance-xsd.exi", "EmptyTypes/emptyTypeSchema-xsd.exi"};
+	const char* files[2] = {"testStates/acceptance_a_01.exi", "EmptyTypes/emptyTypeTest-def.exi"};
+	const Index blockSizes[3] = {1000000, 1, 2};
+	int f, b;
+
+	for(f = 0; f < 2; f++)
+	{
+		parseMultiSchema(&schemafname[f], 1, &schema);
+
+		for(b = 0; b < 3; b++)
+		{
+			checkTranscodeRoundTrip(files[f], &schema, PRE_COMPRESSION, blockSizes[b]);
+			checkTranscodeRoundTrip(files[f], &schema, COMPRESSION, blockSizes[b]);
+		}
+
+		destroySchema(&schema);
+	}
+}
+END_TEST
+
+/* The events of the catalog documents in Compression/: count <item> elements
+ * with an id attribute, every fourth one empty, and a closing <note> */
+static void expectedCatalogLog(struct memBuffer* log, int count)
+{
+	char line[200];
+	int len;
+	int i;
+
+	log->len = 0;
+	len = sprintf(line, "SD\nSE |catalog|\n");
+	appendMemBuffer(log, line, len);
+	for(i = 0; i < count; i++)
+	{
+		len = sprintf(line, "SE |item|\nAT |id|\nCH i%d|\n", i);
+		if(i == 0)
+			len += sprintf(line + len, "AT |lang|\nCH en|\n");
+		if(i % 4 != 3)
+			len += sprintf(line + len, "CH v%d|\n", i % 3);
+		len += sprintf(line + len, "EE\n");
+		appendMemBuffer(log, line, len);
+	}
+	len = sprintf(line, "SE |note|\nCH done|\nEE\nEE\nED\n");
+	appendMemBuffer(log, line, len);
+}
+
+/* Compression and pre-compression streams that are not produced by the exip encoder:
+ * see Compression/mkfixtures.py. The large documents have more than 100 values,
+ * so the structure channel, the small value channels and each large value channel
+ * are in separate (compressed) streams */
+START_TEST (test_compression_fixtures)
+{
+	const char* files[4] = {"Compression/catalog-small-precompression.exi", "Compression/catalog-small-compression.exi",
+			"Compression/catalog-large-precompression.exi", "Compression/catalog-large-compression.exi"};
+	const int counts[4] = {4, 4, 140, 140};
+	struct transcodeData td;
+	struct memBuffer expected = {NULL, 0, 0};
+	int f;
+
+	for(f = 0; f < 4; f++)
+	{
+		memset(&td, 0, sizeof(td));
+		parseFileWithLog(files[f], &td, FALSE);
+		expectedCatalogLog(&expected, counts[f]);
+
+		ck_assert_msg(td.log.len == expected.len && memcmp(td.log.data, expected.data, expected.len) == 0,
+				"%s: the decoded events differ from the catalog document", files[f]);
+		free(td.log.data);
+	}
+
+	free(expected.data);
+}
+END_TEST
+
+#endif /* COMPRESSION_USE */
+
+/* END: Alignment and compression tests */
+
+/* BEGIN: String arena tests */
+
+/* The string values decoded in the string arena are the same as the allocated ones.
+ * The ASCII values of a byte-aligned stream in memory point into the input buffer */
+START_TEST (test_string_arena)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	const unsigned char modes[2] = {BIT_PACKED, BYTE_ALIGNMENT};
+	struct transcodeData td;
+	struct memBuffer srcLog;
+	int f, m;
+
+	for(f = 0; f < 2; f++)
+	{
+		for(m = 0; m < 2; m++)
+		{
+			memset(&td, 0, sizeof(td));
+			td.alignment = modes[m];
+			td.blockSize = 1000000;
+			transcodeFile(files[f], &td);
+
+			srcLog = td.log;
+			td.log.data = NULL;
+			td.log.len = 0;
+			td.log.cap = 0;
+
+			td.stringArena = TRUE;
+			parseWithLog(transcodedBuffer(&td), &td, FALSE);
+			ck_assert_msg(td.log.len == srcLog.len && memcmp(td.log.data, srcLog.data, srcLog.len) == 0,
+					"%s: the events decoded with the string arena differ from the original", files[f]);
+			if(modes[m] == BYTE_ALIGNMENT)
+				ck_assert_msg(td.bufferStrings > 0, "%s: no string values point into the input buffer", files[f]);
+
+			free(srcLog.data);
+			free(td.log.data);
+			free(td.out.data);
+		}
+	}
+}
+END_TEST
+
+/* The value table strings that point into the input buffer are moved
+ * to the string arena before pushEXIData() overwrites the buffer */
+START_TEST (test_string_arena_push)
+{
+	struct transcodeData td;
+	Parser parser;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	BinaryBuffer buffer;
+	Index half, i, count, inBuffer = 0;
+	String* values;
+
+	memset(&td, 0, sizeof(td));
+	td.alignment = BYTE_ALIGNMENT;
+	td.blockSize = 1000000;
+	td.quiet = TRUE;
+	transcodeFile("Ant/build-build.bitPacked", &td);
+
+	// Only the first half of the stream is in the parsing buffer at the start
+	half = td.out.len/2;
+	buffer = transcodedBuffer(&td);
+	buffer.bufLen = td.out.len;
+	buffer.buf = malloc(buffer.bufLen);
+	if(buffer.buf == NULL)
+		ck_abort_msg("Memory allocation error");
+	memcpy(buffer.buf, td.out.data, half);
+	buffer.bufContent = half;
+
+	tmp_err_code = initParser(&parser, buffer, &td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	tmp_err_code = parse.enableStringArena(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "enableStringArena returns an error code %d", tmp_err_code);
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_BUFFER_END_REACHED, "Expected the end of the buffer, got %d", tmp_err_code);
+
+	count = parser.strm.valueTable.count;
+	values = malloc(count*sizeof(String));
+	if(values == NULL)
+		ck_abort_msg("Memory allocation error");
+	for(i = 0; i < count; i++)
+	{
+		values[i].length = parser.strm.valueTable.value[i].valueStr.length;
+		values[i].str = malloc(values[i].length + 1);
+		memcpy(values[i].str, parser.strm.valueTable.value[i].valueStr.str, values[i].length);
+		if(parser.strm.valueTable.value[i].valueStr.str >= buffer.buf && parser.strm.valueTable.value[i].valueStr.str < buffer.buf + buffer.bufLen)
+			inBuffer++;
+	}
+	ck_assert_msg(inBuffer > 0, "No value table strings point into the input buffer");
+
+	tmp_err_code = pushEXIData(td.out.data + half, td.out.len - half, &parser);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "pushEXIData returns an error code %d", tmp_err_code);
+
+	for(i = 0; i < count; i++)
+	{
+		String* valueStr = &parser.strm.valueTable.value[i].valueStr;
+		ck_assert_msg(valueStr->str < buffer.buf || valueStr->str >= buffer.buf + buffer.bufLen,
+				"Value %u points into the input buffer after pushEXIData()", (unsigned int) i);
+		ck_assert_msg(valueStr->length == values[i].length && memcmp(valueStr->str, values[i].str, values[i].length) == 0,
+				"Value %u changed after pushEXIData()", (unsigned int) i);
+		free(values[i].str);
+	}
+	free(values);
+
+	tmp_err_code = EXIP_OK;
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the EXI body %d", tmp_err_code);
+
+	destroyParser(&parser);
+	free(buffer.buf);
+	free(td.out.data);
+}
+END_TEST
+
+/* END: String arena tests */
+
+/* BEGIN: Allocation list tests */
+
+#define ALLOC_TEST_COUNT 500
+
+/* The managed allocations are aligned and stay intact until the list is reset.
+ * With MEM_ARENA_USE the same memory is handed out again after a reset */
+START_TEST (test_alloc_list_reset)
+{
+	AllocList list;
+	unsigned char* ptrs[ALLOC_TEST_COUNT];
+	unsigned char* firstPtr = NULL;
+	size_t size;
+	int i, j, round;
+
+	fail_unless(initAllocList(&list) == EXIP_OK);
+
+	for(round = 0; round < 3; round++)
+	{
+		for(i = 0; i < ALLOC_TEST_COUNT; i++)
+		{
+			// Mostly small allocations with a few bigger than a chunk
+			size = (i % 50 == 49) ? 10000 : (size_t) (i % 37) + 1;
+			ptrs[i] = memManagedAllocate(&list, size);
+			fail_unless(ptrs[i] != NULL, "memManagedAllocate returns NULL");
+			fail_unless(((size_t) ptrs[i]) % sizeof(void*) == 0, "Unaligned allocation of %u bytes", (unsigned int) size);
+			memset(ptrs[i], i & 0xFF, size);
+		}
+
+		for(i = 0; i < ALLOC_TEST_COUNT; i++)
+		{
+			size = (i % 50 == 49) ? 10000 : (size_t) (i % 37) + 1;
+			for(j = 0; j < (int) size; j++)
+				fail_unless(ptrs[i][j] == (i & 0xFF), "Allocation %d is overwritten", i);
+		}
+
+#if MEM_ARENA_USE
+		if(round == 0)
+			firstPtr = ptrs[0];
+		else
+			fail_unless(ptrs[0] == firstPtr, "The memory is not reused after a reset");
+#endif
+		resetAllocList(&list);
+	}
+
+	freeAllocList(&list);
+}
+END_TEST
+
+/* END: Allocation list tests */
+
+/* BEGIN: Reset tests */
+
+#define SMALL_MSG_BUFFER_SIZE 200
+#define RESET_TEST_MESSAGES 40
+#define RESET_BENCH_MESSAGES 100000
+
+/* Returns an output buffer over buf for a small message */
+static BinaryBuffer smallMsgBuffer(char* buf)
+{
+	BinaryBuffer buffer;
+
+	memset(buf, 0, SMALL_MSG_BUFFER_SIZE);
+	buffer.buf = buf;
+	buffer.bufContent = 0;
+	buffer.bufLen = SMALL_MSG_BUFFER_SIZE;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	return buffer;
+}
+
+/* Serializes the n-th small message; the messages share most of their names
+ * and values and every fourth one introduces a new element name.
+ * Returns the length of the message in bytes */
+static Index serializeSmallMessage(EXIStream* strm, int n)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char lnBuf[20];
+	char valBuf[20];
+	String uri;
+	String ln;
+	QName qname = {&uri, &ln};
+	String chVal;
+	EXITypeClass valueType;
+
+	getEmptyString(&uri);
+
+	tmp_err_code = serialize.exiHeader(strm);
+	tmp_err_code += serialize.startDocument(strm);
+
+	tmp_err_code += asciiToStringManaged("msg", &ln, &strm->memList, FALSE);
+	tmp_err_code += serialize.startElement(strm, qname, &valueType);
+	tmp_err_code += asciiToStringManaged("id", &ln, &strm->memList, FALSE);
+	tmp_err_code += serialize.attribute(strm, qname, TRUE, &valueType);
+	sprintf(valBuf, "%d", n % 10);
+	tmp_err_code += asciiToStringManaged(valBuf, &chVal, &strm->memList, FALSE);
+	tmp_err_code += serialize.stringData(strm, chVal);
+
+	sprintf(lnBuf, "field%d", n / 4);
+	tmp_err_code += asciiToStringManaged(lnBuf, &ln, &strm->memList, FALSE);
+	tmp_err_code += serialize.startElement(strm, qname, &valueType);
+	sprintf(valBuf, "value%d", n % 3);
+	tmp_err_code += asciiToStringManaged(valBuf, &chVal, &strm->memList, FALSE);
+	tmp_err_code += serialize.stringData(strm, chVal);
+	tmp_err_code += serialize.stringData(strm, chVal);
+	tmp_err_code += serialize.endElement(strm);
+
+	tmp_err_code += serialize.endElement(strm);
+	tmp_err_code += serialize.endDocument(strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of message %d ended with error code %d", n, tmp_err_code);
+
+	return strm->context.bufferIndx + (strm->context.bitPointer != 0);
+}
+
+/* Sets the header of a small message stream; alignment is BIT_PACKED,
+ * BYTE_ALIGNMENT, PRE_COMPRESSION or COMPRESSION */
+static void initSmallMsgHeader(EXIStream* strm, unsigned char alignment)
+{
+	serialize.initHeader(strm);
+	if(alignment == BIT_PACKED)
+		return;
+
+	strm->header.has_options = TRUE;
+	if(alignment == COMPRESSION)
+		SET_COMPRESSION(strm->header.opts.enumOpt);
+	else
+		SET_ALIGNMENT(strm->header.opts.enumOpt, alignment);
+}
+
+/* Serializes the n-th small message in buf with a new EXI stream object */
+static Index serializeFreshMessage(char* buf, EXIPSchema* schema, unsigned char alignment, int n)
+{
+	EXIStream strm;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+
+	initSmallMsgHeader(&strm, alignment);
+	tmp_err_code = serialize.initStream(&strm, smallMsgBuffer(buf), schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	len = serializeSmallMessage(&strm, n);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* Returns an input buffer over a serialized small message */
+static BinaryBuffer smallMsgInput(char* buf, Index len)
+{
+	BinaryBuffer buffer;
+
+	buffer.buf = buf;
+	buffer.bufContent = len;
+	buffer.bufLen = len;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	return buffer;
+}
+
+/* Parses the next stream with a parser reused through resetParser() */
+static void parseResetWithLog(Parser* parser, BinaryBuffer buffer, struct transcodeData* td, boolean first)
+{
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	td->src = parser;
+	if(first)
+	{
+		tmp_err_code = initParser(parser, buffer, td);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+		setLogHandlers(&parser->handler);
+	}
+	else
+	{
+		tmp_err_code = parse.resetParser(parser, buffer);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "resetParser returns an error code %d", tmp_err_code);
+	}
+
+	tmp_err_code = parseHeader(parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+
+	if(first)
+	{
+		tmp_err_code = setSchema(parser, td->schema);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+	}
+
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(parser);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the EXI body %d", tmp_err_code);
+}
+
+/* Serializes and parses a sequence of small messages with reused objects and
+ * checks that the streams and the events are the same as with new objects.
+ * The objects are not used at the same time as they may share the schema */
+static void checkResetMessages(EXIPSchema* schema, unsigned char alignment)
+{
+	EXIStream strm;
+	Parser parser;
+	struct transcodeData td;
+	struct memBuffer freshLog[RESET_TEST_MESSAGES];
+	char freshBuf[SMALL_MSG_BUFFER_SIZE];
+	char resetBuf[RESET_TEST_MESSAGES][SMALL_MSG_BUFFER_SIZE];
+	Index resetLen[RESET_TEST_MESSAGES];
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index freshLen;
+	int n;
+
+	memset(&td, 0, sizeof(td));
+	td.schema = schema;
+
+	initSmallMsgHeader(&strm, alignment);
+	tmp_err_code = serialize.initStream(&strm, smallMsgBuffer(resetBuf[0]), schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	for(n = 0; n < RESET_TEST_MESSAGES; n++)
+	{
+		if(n > 0)
+		{
+			tmp_err_code = serialize.resetStream(&strm, smallMsgBuffer(resetBuf[n]));
+			ck_assert_msg (tmp_err_code == EXIP_OK, "resetStream returns an error code %d", tmp_err_code);
+		}
+		resetLen[n] = serializeSmallMessage(&strm, n);
+	}
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	for(n = 0; n < RESET_TEST_MESSAGES; n++)
+	{
+		freshLen = serializeFreshMessage(freshBuf, schema, alignment, n);
+		ck_assert_msg (resetLen[n] == freshLen && memcmp(resetBuf[n], freshBuf, freshLen) == 0,
+				"Message %d serialized after resetStream() differs from the one of a new stream", n);
+
+		parseWithLog(smallMsgInput(resetBuf[n], resetLen[n]), &td, FALSE);
+		freshLog[n] = td.log;
+		memset(&td.log, 0, sizeof(td.log));
+	}
+
+	for(n = 0; n < RESET_TEST_MESSAGES; n++)
+	{
+		parseResetWithLog(&parser, smallMsgInput(resetBuf[n], resetLen[n]), &td, n == 0);
+		ck_assert_msg(td.log.len == freshLog[n].len && memcmp(td.log.data, freshLog[n].data, freshLog[n].len) == 0,
+				"The events of message %d parsed after resetParser() differ from the ones of a new parser", n);
+
+		free(freshLog[n].data);
+		free(td.log.data);
+		memset(&td.log, 0, sizeof(td.log));
+	}
+	destroyParser(&parser);
+}
+
+/* Schema-less messages: the names and values learned by a stream
+ * are forgotten by resetStream() and resetParser() */
+START_TEST (test_reset_schemaless)
+{
+	checkResetMessages(NULL, BIT_PACKED);
+	checkResetMessages(NULL, BYTE_ALIGNMENT);
+#if COMPRESSION_USE
+	checkResetMessages(NULL, PRE_COMPRESSION);
+	checkResetMessages(NULL, COMPRESSION);
+#endif
+}
+END_TEST
+
+/* Schema-informed non-strict messages: the names added to a shared
+ * schema are removed from it when a stream is reset or closed */
+START_TEST (test_reset_schema)
+{
+	EXIPSchema schema;
+	char* schemafname[1] = {"EmptyTypes/emptyTypeSchema-xsd.exi"};
+	Index lnCount[4];
+	SmallIndex uriCount;
+	SmallIndex i;
+
+	parseMultiSchema(schemafname, 1, &schema);
+	uriCount = schema.uriTable.count;
+	for(i = 0; i < uriCount && i < 4; i++)
+		lnCount[i] = schema.uriTable.uri[i].lnTable.count;
+
+	checkResetMessages(&schema, BIT_PACKED);
+
+	ck_assert_msg(schema.uriTable.count == uriCount, "URIs are left in the schema");
+	for(i = 0; i < uriCount && i < 4; i++)
+		ck_assert_msg(schema.uriTable.uri[i].lnTable.count == lnCount[i], "Local names are left in URI %u of the schema", (unsigned int) i);
+
+	destroySchema(&schema);
+}
+END_TEST
+
+/* The options of a stream parsed after resetParser() must match the previous ones */
+START_TEST (test_reset_options_mismatch)
+{
+	EXIStream strm;
+	Parser parser;
+	char buf[SMALL_MSG_BUFFER_SIZE];
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+
+	len = serializeFreshMessage(buf, NULL, BIT_PACKED, 0);
+	tmp_err_code = initParser(&parser, smallMsgInput(buf, len), NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+	while(tmp_err_code == EXIP_OK)
+		tmp_err_code = parseNext(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the EXI body %d", tmp_err_code);
+
+	initSmallMsgHeader(&strm, BYTE_ALIGNMENT);
+	tmp_err_code = serialize.initStream(&strm, smallMsgBuffer(buf), NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	len = serializeSmallMessage(&strm, 1);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	tmp_err_code = parse.resetParser(&parser, smallMsgInput(buf, len));
+	ck_assert_msg (tmp_err_code == EXIP_OK, "resetParser returns an error code %d", tmp_err_code);
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_HEADER_OPTIONS_MISMATCH, "Expected options mismatch, got %d", tmp_err_code);
+
+	destroyParser(&parser);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+/* Throughput of serializing and parsing many small messages
+ * with new objects for every message and with reset objects */
+START_TEST (bench_reset)
+{
+	EXIStream strm;
+	Parser parser;
+	char buf[SMALL_MSG_BUFFER_SIZE];
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	clock_t start;
+	double freshTime = 0, resetTime = 0;
+	Index len;
+	int n, withReset;
+
+	for(withReset = 0; withReset < 2; withReset++)
+	{
+		start = clock();
+		for(n = 0; n < RESET_BENCH_MESSAGES; n++)
+		{
+			if(!withReset)
+				len = serializeFreshMessage(buf, NULL, BIT_PACKED, n);
+			else
+			{
+				if(n == 0)
+				{
+					serialize.initHeader(&strm);
+					tmp_err_code = serialize.initStream(&strm, smallMsgBuffer(buf), NULL);
+				}
+				else
+					tmp_err_code = serialize.resetStream(&strm, smallMsgBuffer(buf));
+				ck_assert_msg (tmp_err_code == EXIP_OK, "Stream (re)initialization returns an error code %d", tmp_err_code);
+				len = serializeSmallMessage(&strm, n);
+			}
+
+			if(!withReset || n == 0)
+				tmp_err_code = initParser(&parser, smallMsgInput(buf, len), NULL);
+			else
+				tmp_err_code = parse.resetParser(&parser, smallMsgInput(buf, len));
+			ck_assert_msg (tmp_err_code == EXIP_OK, "Parser (re)initialization returns an error code %d", tmp_err_code);
+			tmp_err_code = parseHeader(&parser, TRUE);
+			if(tmp_err_code == EXIP_OK && (!withReset || n == 0))
+				tmp_err_code = setSchema(&parser, NULL);
+			while(tmp_err_code == EXIP_OK)
+				tmp_err_code = parseNext(&parser);
+			ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of message %d: %d", n, tmp_err_code);
+			if(!withReset)
+				destroyParser(&parser);
+		}
+
+		if(withReset)
+		{
+			destroyParser(&parser);
+			serialize.closeEXIStream(&strm);
+			resetTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+		}
+		else
+			freshTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+	}
+
+	printf("%d small messages serialized and parsed: %.4fs with new objects, %.4fs with reset objects\n",
+			RESET_BENCH_MESSAGES, freshTime, resetTime);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+/* END: Reset tests */
+
+/* BEGIN: Binary chunk tests */
+
+#define BINARY_CHUNK_SIZE 256
+#define BINARY_DOC_BUFFER_SIZE 16384
+#define BINARY_PUSH_SIZE 100
+
+/* The lengths of the three hexBinary values of the test document */
+static const Index binaryValueLen[3] = {5000, 0, 300};
+
+static unsigned char binaryValueByte(int value, Index i)
+{
+	return (unsigned char) (i*7 + value*13 + 1);
+}
+
+/* The binary values received by the parser */
+struct binaryChunkData
+{
+	/** The value being received and its bytes received so far */
+	int value;
+	Index received;
+	unsigned int chunks;
+	unsigned int wholeValues;
+};
+
+/* Input stream over a memory buffer */
+struct memInput
+{
+	const char* data;
+	size_t len;
+	size_t pos;
+};
+
+static size_t readMemInputStream(void* buf, size_t size, void* stream)
+{
+	struct memInput* in = (struct memInput*) stream;
+	size_t n = in->len - in->pos;
+
+	if(n > size)
+		n = size;
+	memcpy(buf, in->data + in->pos, n);
+	in->pos += n;
+	return n;
+}
+
+static errorCode bc_binaryDataChunk(const char* chunk, Index nbytes, Index offset, Index totalBytes, void* app_data)
+{
+	struct binaryChunkData* bd = (struct binaryChunkData*) app_data;
+	Index i;
+
+	ck_assert_msg(bd->value < 3 && totalBytes == binaryValueLen[bd->value] && offset == bd->received,
+			"Unexpected chunk at offset %u of a value of %u bytes", (unsigned int) offset, (unsigned int) totalBytes);
+	ck_assert_msg(nbytes <= BINARY_CHUNK_SIZE && (nbytes > 0 || totalBytes == 0) && offset + nbytes <= totalBytes,
+			"Unexpected chunk size %u", (unsigned int) nbytes);
+	for(i = 0; i < nbytes; i++)
+	{
+		if((unsigned char) chunk[i] != binaryValueByte(bd->value, offset + i))
+			ck_abort_msg("Wrong byte at offset %u of binary value %d", (unsigned int) (offset + i), bd->value);
+	}
+
+	bd->chunks++;
+	bd->received += nbytes;
+	if(bd->received == totalBytes)
+	{
+		bd->value++;
+		bd->received = 0;
+	}
+
+	return EXIP_OK;
+}
+
+static errorCode bc_binaryData(const char* binary_val, Index nbytes, void* app_data)
+{
+	((struct binaryChunkData*) app_data)->wholeValues++;
+	return EXIP_OK;
+}
+
+/* Serializes in buf a document of the subsGroups schema with three hexBinary values.
+ * Returns the length of the document in bytes */
+static Index serializeBinaryDoc(char* buf, EXIPSchema* schema, unsigned char alignment)
+{
+	EXIStream strm;
+	BinaryBuffer buffer;
+	unsigned char value[5000];
+	String uri;
+	String ln;
+	QName qname = {&uri, &ln};
+	String chVal;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	Index i;
+	int k;
+
+	buffer.buf = buf;
+	buffer.bufLen = BINARY_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	initSmallMsgHeader(&strm, alignment);
+	tmp_err_code = serialize.initStream(&strm, buffer, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	tmp_err_code += asciiToStringManaged("http://exip.sourceforge.net/", &uri, &strm.memList, FALSE);
+	tmp_err_code += asciiToStringManaged("one", &ln, &strm.memList, FALSE);
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+	tmp_err_code += asciiToStringManaged("http://test.org/sub", &uri, &strm.memList, FALSE);
+	tmp_err_code += asciiToStringManaged("sallad", &ln, &strm.memList, FALSE);
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+
+	for(k = 0; k < 3; k++)
+	{
+		for(i = 0; i < binaryValueLen[k]; i++)
+			value[i] = binaryValueByte(k, i);
+
+		tmp_err_code += asciiToStringManaged("apple", &ln, &strm.memList, FALSE);
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		tmp_err_code += serialize.booleanData(&strm, TRUE);
+		tmp_err_code += serialize.endElement(&strm);
+		tmp_err_code += asciiToStringManaged("orange", &ln, &strm.memList, FALSE);
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		tmp_err_code += asciiToStringManaged("Name", &chVal, &strm.memList, FALSE);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+		tmp_err_code += asciiToStringManaged("grapes", &ln, &strm.memList, FALSE);
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		tmp_err_code += serialize.binaryData(&strm, (char*) value, binaryValueLen[k]);
+		tmp_err_code += serialize.endElement(&strm);
+	}
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += asciiToStringManaged("http://exip.sourceforge.net/", &uri, &strm.memList, FALSE);
+	tmp_err_code += asciiToStringManaged("piece", &ln, &strm.memList, FALSE);
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+	tmp_err_code += asciiToStringManaged("piece", &chVal, &strm.memList, FALSE);
+	tmp_err_code += serialize.stringData(&strm, chVal);
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the binary document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* Parses the binary document with chunked binary values. The input is the whole
+ * document (inputMode 0), a small buffer refilled from an input stream (1)
+ * or pieces added with pushEXIData() (2) */
+static void parseBinaryDoc(char* buf, Index len, EXIPSchema* schema, int inputMode)
+{
+	Parser parser;
+	BinaryBuffer buffer;
+	struct binaryChunkData bd;
+	struct memInput in;
+	char smallBuf[64];
+	char* pushBuf = NULL;
+	Index pushed = 0;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+
+	memset(&bd, 0, sizeof(bd));
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	if(inputMode == 0)
+	{
+		buffer.buf = buf;
+		buffer.bufLen = len;
+		buffer.bufContent = len;
+	}
+	else if(inputMode == 1)
+	{
+		in.data = buf;
+		in.len = len;
+		in.pos = 0;
+		buffer.buf = smallBuf;
+		buffer.bufLen = sizeof(smallBuf);
+		buffer.bufContent = 0;
+		buffer.ioStrm.readWriteToStream = readMemInputStream;
+		buffer.ioStrm.stream = &in;
+	}
+	else
+	{
+		pushBuf = malloc(BINARY_DOC_BUFFER_SIZE);
+		pushed = len < BINARY_PUSH_SIZE ? len : BINARY_PUSH_SIZE;
+		memcpy(pushBuf, buf, pushed);
+		buffer.buf = pushBuf;
+		buffer.bufLen = BINARY_DOC_BUFFER_SIZE;
+		buffer.bufContent = pushed;
+	}
+
+	tmp_err_code = initParser(&parser, buffer, &bd);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	parser.handler.binaryData = bc_binaryData;
+	parser.handler.binaryDataChunk = bc_binaryDataChunk;
+	tmp_err_code = parse.setBinaryChunkSize(&parser, BINARY_CHUNK_SIZE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setBinaryChunkSize returns an error code %d", tmp_err_code);
+
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	while(tmp_err_code == EXIP_OK)
+	{
+		tmp_err_code = parseNext(&parser);
+		if(tmp_err_code == EXIP_BUFFER_END_REACHED && inputMode == 2 && pushed < len)
+		{
+			Index n = len - pushed < BINARY_PUSH_SIZE ? len - pushed : BINARY_PUSH_SIZE;
+
+			tmp_err_code = pushEXIData(buf + pushed, (unsigned int) n, &parser);
+			pushed += n;
+		}
+	}
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the binary document %d", tmp_err_code);
+
+	// 20 chunks for the 5000 bytes, one empty chunk and two chunks for the 300 bytes
+	ck_assert_msg (bd.value == 3 && bd.wholeValues == 0 && bd.chunks == 23,
+			"%d binary values received in %u chunks (input mode %d)", bd.value, bd.chunks, inputMode);
+
+	destroyParser(&parser);
+	free(pushBuf);
+}
+
+/* Binary values are reported in chunks of up to BINARY_CHUNK_SIZE bytes
+ * however the input is provided */
+START_TEST (test_binary_chunks)
+{
+	EXIPSchema schema;
+	char* schemafname[2] = {"exip/subsGroups/root-xsd.exi","exip/subsGroups/sub-xsd.exi"};
+	char* buf = malloc(BINARY_DOC_BUFFER_SIZE);
+	Index len;
+	int inputMode;
+
+	parseMultiSchema(schemafname, 2, &schema);
+
+	for(inputMode = 0; inputMode < 3; inputMode++)
+	{
+		len = serializeBinaryDoc(buf, &schema, BIT_PACKED);
+		parseBinaryDoc(buf, len, &schema, inputMode);
+		len = serializeBinaryDoc(buf, &schema, BYTE_ALIGNMENT);
+		parseBinaryDoc(buf, len, &schema, inputMode);
+	}
+#if COMPRESSION_USE
+	len = serializeBinaryDoc(buf, &schema, PRE_COMPRESSION);
+	parseBinaryDoc(buf, len, &schema, 0);
+	len = serializeBinaryDoc(buf, &schema, COMPRESSION);
+	parseBinaryDoc(buf, len, &schema, 0);
+	parseBinaryDoc(buf, len, &schema, 1);
+#endif
+
+	free(buf);
+	destroySchema(&schema);
+}
+END_TEST
+
+/* END: Binary chunk tests */
+
+/* BEGIN: Event code dispatch tests */
+
+/* Built-in element grammars, strict and non-strict schema-informed grammars with xsi:nil */
+static char* dispatchSchemas[3] = {NULL, "testStates/acceptance-xsd.exi", "EmptyTypes/emptyTypeSchema-xsd.exi"};
+static const char* dispatchFiles[3] = {"Ant/build-build.bitPacked", "testStates/acceptance_a_01.exi", "EmptyTypes/emptyTypeTest-def.exi"};
+
+/* The event codes decoded with the dispatch table, also after xsi:nil="true",
+ * are the ones written by the serializer */
+START_TEST (test_event_code_dispatch)
+{
+	EXIPSchema schema;
+	int f;
+
+	for(f = 0; f < 3; f++)
+	{
+		if(dispatchSchemas[f] != NULL)
+			parseMultiSchema(&dispatchSchemas[f], 1, &schema);
+
+		checkTranscodeRoundTrip(dispatchFiles[f], dispatchSchemas[f] != NULL ? &schema : NULL, BIT_PACKED, 1000000);
+
+		if(dispatchSchemas[f] != NULL)
+			destroySchema(&schema);
+	}
+}
+END_TEST
+
+/* END: Event code dispatch tests */
+
+/* BEGIN: Production index tests */
+
+#define WIDE_DOC_NAMES 40
+#define WIDE_DOC_ELEMENTS 3000
+#define WIDE_DOC_BUFFER_SIZE 100000
+#define WIDE_DOC_ITERATIONS 20
+
+/* Points str to the characters of an ASCII string without copying them */
+#define SET_ASCII_STRING(s, ascii) ((s).str = (ascii), (s).length = strlen(ascii))
+
+/* Serializes in buf a schema-less document with WIDE_DOC_ELEMENTS child elements
+ * of WIDE_DOC_NAMES different names so that the built-in element grammar of the root
+ * gets many SE(qname) productions. The names are given either as the same String
+ * objects or written in a single char buffer. Returns the length in bytes */
+static Index serializeWideDoc(char* buf, boolean useIndex, boolean sharedBuffer)
+{
+	EXIStream strm;
+	BinaryBuffer buffer;
+	char names[WIDE_DOC_NAMES][12];
+	char nameBuf[12];
+	char valBuf[12];
+	String nameStr[WIDE_DOC_NAMES];
+	String uri;
+	String ln;
+	QName qname = {&uri, &ln};
+	String atName;
+	QName atQname = {&uri, &atName};
+	String chVal;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	int i;
+
+	buffer.buf = buf;
+	buffer.bufLen = WIDE_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	for(i = 0; i < WIDE_DOC_NAMES; i++)
+	{
+		sprintf(names[i], "item%d", i);
+		SET_ASCII_STRING(nameStr[i], names[i]);
+	}
+	getEmptyString(&uri);
+	SET_ASCII_STRING(atName, "key");
+
+	serialize.initHeader(&strm);
+	tmp_err_code = serialize.initStream(&strm, buffer, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	if(!useIndex)
+		destroyProductionIndex(&strm);
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	SET_ASCII_STRING(ln, "root");
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+
+	for(i = 0; i < WIDE_DOC_ELEMENTS; i++)
+	{
+		if(sharedBuffer)
+		{
+			sprintf(nameBuf, "item%d", (i*7) % WIDE_DOC_NAMES);
+			SET_ASCII_STRING(ln, nameBuf);
+		}
+		else
+			ln = nameStr[(i*7) % WIDE_DOC_NAMES];
+
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		tmp_err_code += serialize.attribute(&strm, atQname, TRUE, &valueType);
+		sprintf(valBuf, "%d", i % 5);
+		SET_ASCII_STRING(chVal, valBuf);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+	}
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* The productions found through the production index and the QName cache are the
+ * same as the ones found by scanning the grammar rules, also when the memory of
+ * the names is reused by the application */
+START_TEST (test_production_index)
+{
+	char* plain = malloc(WIDE_DOC_BUFFER_SIZE);
+	char* indexed = malloc(WIDE_DOC_BUFFER_SIZE);
+	struct transcodeData td;
+	Index plainLen, indexedLen;
+	int shared;
+
+	ck_assert(plain != NULL && indexed != NULL);
+
+	for(shared = 0; shared < 2; shared++)
+	{
+		plainLen = serializeWideDoc(plain, FALSE, shared);
+		indexedLen = serializeWideDoc(indexed, TRUE, shared);
+		ck_assert_msg(plainLen == indexedLen && memcmp(plain, indexed, plainLen) == 0,
+				"the document encoded with the production index differs (shared name buffer %d)", shared);
+	}
+
+	memset(&td, 0, sizeof(td));
+	td.quiet = TRUE;
+	parseWithLog(smallMsgInput(indexed, indexedLen), &td, FALSE);
+
+	free(plain);
+	free(indexed);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+START_TEST (bench_production_index)
+{
+	char* buf = malloc(WIDE_DOC_BUFFER_SIZE);
+	Index len = 0;
+	clock_t start;
+	double plainTime, indexedTime;
+	int i;
+
+	ck_assert(buf != NULL);
+
+	start = clock();
+	for(i = 0; i < WIDE_DOC_ITERATIONS; i++)
+		serializeWideDoc(buf, FALSE, FALSE);
+	plainTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for(i = 0; i < WIDE_DOC_ITERATIONS; i++)
+		len = serializeWideDoc(buf, TRUE, FALSE);
+	indexedTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%d elements with %d names (%u bytes): encoding with production index %.4fs, scanning the rules %.4fs for %d runs\n",
+			WIDE_DOC_ELEMENTS, WIDE_DOC_NAMES, (unsigned int) len, indexedTime, plainTime, WIDE_DOC_ITERATIONS);
+
+	free(buf);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+/* END: Production index tests */
+
+/* BEGIN: QName ID serialization tests */
+
+#define PORTS_DOC_PORTS 500
+#define PORTS_DOC_BUFFER_SIZE 100000
+#define PORTS_DOC_ITERATIONS 20
+
+enum PortsDocName
+{
+	PORTS_CONFIGURATION,
+	PORTS_CAPSWITCH,
+	PORTS_RESOURCES,
+	PORTS_PORT,
+	PORTS_RESID,
+	PORTS_ADMIN_STATE,
+	PORTS_NORECEIVE,
+	PORTS_NAME_COUNT
+};
+
+/* Serializes in buf a document of the schema_demo schema with PORTS_DOC_PORTS
+ * port elements. The element QNames are given either as strings or as QNameIDs
+ * resolved from the schema. Returns the length in bytes */
+static Index serializePortsDoc(EXIPSchema* schema, char* buf, boolean useIds)
+{
+	const String NS_EMPTY_STR = {NULL, 0};
+	const String portsNames[PORTS_NAME_COUNT] = {{"configuration", 13}, {"capable-switch", 14},
+			{"resources", 9}, {"port", 4}, {"resource-id", 11}, {"admin-state", 11}, {"no-receive", 10}};
+	QName qname[PORTS_NAME_COUNT];
+	QNameID qnameId[PORTS_NAME_COUNT];
+	EXIStream strm;
+	BinaryBuffer buffer;
+	String chVal;
+	char valBuf[16];
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	int i;
+
+	buffer.buf = buf;
+	buffer.bufLen = PORTS_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	for(i = 0; i < PORTS_NAME_COUNT; i++)
+	{
+		qname[i].uri = &NS_EMPTY_STR;
+		qname[i].localName = &portsNames[i];
+		qname[i].prefix = NULL;
+		tmp_err_code = serialize.resolveQName(schema, qname[i], &qnameId[i]);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "resolveQName returns an error code %d", tmp_err_code);
+	}
+
+#define START_ELEM(n) (useIds ? serialize.startElementId(&strm, qnameId[n], &valueType) : serialize.startElement(&strm, qname[n], &valueType))
+
+	serialize.initHeader(&strm);
+	tmp_err_code = serialize.initStream(&strm, buffer, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	tmp_err_code += START_ELEM(PORTS_CONFIGURATION);
+	tmp_err_code += START_ELEM(PORTS_CAPSWITCH);
+	tmp_err_code += START_ELEM(PORTS_RESOURCES);
+
+	for(i = 0; i < PORTS_DOC_PORTS; i++)
+	{
+		tmp_err_code += START_ELEM(PORTS_PORT);
+
+		tmp_err_code += START_ELEM(PORTS_RESID);
+		sprintf(valBuf, "port%d", i);
+		chVal.str = valBuf;
+		chVal.length = strlen(valBuf);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+
+		tmp_err_code += START_ELEM(PORTS_CONFIGURATION);
+		tmp_err_code += START_ELEM(PORTS_ADMIN_STATE);
+		chVal.str = "up";
+		chVal.length = 2;
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+		tmp_err_code += START_ELEM(PORTS_NORECEIVE);
+		tmp_err_code += serialize.booleanData(&strm, i % 3 == 0);
+		tmp_err_code += serialize.endElement(&strm);
+		tmp_err_code += serialize.endElement(&strm);
+
+		tmp_err_code += serialize.endElement(&strm);
+	}
+
+#undef START_ELEM
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* Serializes in buf a schema-less document with xml:lang attributes given either
+ * as a string QName or by its QNameID in the initial string tables. Returns the length in bytes */
+static Index serializeLangDoc(char* buf, boolean useIds)
+{
+	const String NS_EMPTY_STR = {NULL, 0};
+	const String NS_XML_STR = {"http://www.w3.org/XML/1998/namespace", 36};
+	const String ELEM_ROOT_STR = {"root", 4};
+	const String ELEM_ITEM_STR = {"item", 4};
+	const String ATTR_LANG_STR = {"lang", 4};
+	QName elemQname = {&NS_EMPTY_STR, &ELEM_ROOT_STR, NULL};
+	QName langQname = {&NS_XML_STR, &ATTR_LANG_STR, NULL};
+	QNameID langId;
+	EXIStream strm;
+	BinaryBuffer buffer;
+	String chVal;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	int i;
+
+	buffer.buf = buf;
+	buffer.bufLen = PORTS_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	serialize.initHeader(&strm);
+	tmp_err_code = serialize.initStream(&strm, buffer, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	tmp_err_code = serialize.resolveQName(strm.schema, langQname, &langId);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "resolveQName returns an error code %d", tmp_err_code);
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	tmp_err_code += serialize.startElement(&strm, elemQname, &valueType);
+	elemQname.localName = &ELEM_ITEM_STR;
+
+	for(i = 0; i < 10; i++)
+	{
+		tmp_err_code += serialize.startElement(&strm, elemQname, &valueType);
+		if(useIds)
+			tmp_err_code += serialize.attributeId(&strm, langId, TRUE, &valueType);
+		else
+			tmp_err_code += serialize.attribute(&strm, langQname, TRUE, &valueType);
+		chVal.str = i % 2 ? "en" : "de";
+		chVal.length = 2;
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+	}
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* The QNames serialized by QNameID give the same streams as the ones given by strings */
+START_TEST (test_qname_id)
+{
+	const String NS_EMPTY_STR = {NULL, 0};
+	const String ELEM_UNKNOWN_STR = {"no-such-element", 15};
+	char* schemafname[1] = {"exip/schema_demo.exi"};
+	EXIPSchema schema;
+	char* byString = malloc(PORTS_DOC_BUFFER_SIZE);
+	char* byId = malloc(PORTS_DOC_BUFFER_SIZE);
+	QName qname = {&NS_EMPTY_STR, &ELEM_UNKNOWN_STR, NULL};
+	QNameID qnameId;
+	EXIStream strm;
+	BinaryBuffer buffer;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct transcodeData td;
+	Index stringLen, idLen;
+
+	ck_assert(byString != NULL && byId != NULL);
+	parseMultiSchema(schemafname, 1, &schema);
+
+	stringLen = serializePortsDoc(&schema, byString, FALSE);
+	idLen = serializePortsDoc(&schema, byId, TRUE);
+	ck_assert_msg(stringLen == idLen && memcmp(byString, byId, stringLen) == 0,
+			"the document serialized by QName IDs differs");
+
+	memset(&td, 0, sizeof(td));
+	td.quiet = TRUE;
+	td.schema = &schema;
+	parseWithLog(smallMsgInput(byId, idLen), &td, FALSE);
+
+	stringLen = serializeLangDoc(byString, FALSE);
+	idLen = serializeLangDoc(byId, TRUE);
+	ck_assert_msg(stringLen == idLen && memcmp(byString, byId, stringLen) == 0,
+			"the attributes serialized by QName IDs differ");
+
+	// QNames that are not in the schema are not resolved and invalid IDs are rejected
+	tmp_err_code = serialize.resolveQName(&schema, qname, &qnameId);
+	ck_assert_msg (tmp_err_code == EXIP_INVALID_EXIP_CONFIGURATION, "resolveQName returns %d for an unknown QName", tmp_err_code);
+
+	buffer.buf = byString;
+	buffer.bufLen = PORTS_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	serialize.initHeader(&strm);
+	tmp_err_code = serialize.initStream(&strm, buffer, &schema);
+	tmp_err_code += serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.* returns an error code %d", tmp_err_code);
+	qnameId.uriId = schema.uriTable.count;
+	qnameId.lnId = 0;
+	tmp_err_code = serialize.startElementId(&strm, qnameId, &valueType);
+	ck_assert_msg (tmp_err_code == EXIP_INVALID_EXIP_CONFIGURATION, "startElementId returns %d for an invalid QNameID", tmp_err_code);
+	qnameId.uriId = 0;
+	qnameId.lnId = schema.uriTable.uri[0].lnTable.count;
+	tmp_err_code = serialize.attributeId(&strm, qnameId, TRUE, &valueType);
+	ck_assert_msg (tmp_err_code == EXIP_INVALID_EXIP_CONFIGURATION, "attributeId returns %d for an invalid QNameID", tmp_err_code);
+	serialize.closeEXIStream(&strm);
+
+	destroySchema(&schema);
+	free(byString);
+	free(byId);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+START_TEST (bench_qname_id)
+{
+	char* schemafname[1] = {"exip/schema_demo.exi"};
+	EXIPSchema schema;
+	char* buf = malloc(PORTS_DOC_BUFFER_SIZE);
+	Index len = 0;
+	clock_t start;
+	double stringTime, idTime;
+	int i;
+
+	ck_assert(buf != NULL);
+	parseMultiSchema(schemafname, 1, &schema);
+
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		serializePortsDoc(&schema, buf, FALSE);
+	stringTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		len = serializePortsDoc(&schema, buf, TRUE);
+	idTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%d ports (%u bytes): encoding by QName IDs %.4fs, by QName strings %.4fs for %d runs\n",
+			PORTS_DOC_PORTS, (unsigned int) len, idTime, stringTime, PORTS_DOC_ITERATIONS);
+
+	destroySchema(&schema);
+	free(buf);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+/* END: QName ID serialization tests */
+
+/* BEGIN: Generated static codec tests */
+
+/* The codec of tests/schema_demo_codec.c generated by "exipg -codec -pfx=demo_ -ops=0000000"
+ * from exip/schema_demo.exi gives the same streams and events as the generic grammar processing */
+START_TEST (test_static_codec)
+{
+	char* schemafname[1] = {"exip/schema_demo.exi"};
+	const String NS_EMPTY_STR = {NULL, 0};
+	const String ELEM_PORT_STR = {"port", 4};
+	QName qname = {&NS_EMPTY_STR, &ELEM_PORT_STR, NULL};
+	QNameID qnameId;
+	EXIPSchema schema;
+	char* generic = malloc(PORTS_DOC_BUFFER_SIZE);
+	char* compiled = malloc(PORTS_DOC_BUFFER_SIZE);
+	EXIStream strm;
+	BinaryBuffer buffer;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	struct transcodeData td;
+	struct memBuffer genericLog;
+	Index genericLen, compiledLen;
+
+	ck_assert(generic != NULL && compiled != NULL);
+	parseMultiSchema(schemafname, 1, &schema);
+
+	// The QName constants are the QNameIDs of the schema
+	tmp_err_code = serialize.resolveQName(&schema, qname, &qnameId);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "resolveQName returns an error code %d", tmp_err_code);
+	ck_assert(demo_qnames[demo_QN_0_port].uriId == qnameId.uriId && demo_qnames[demo_QN_0_port].lnId == qnameId.lnId);
+
+	// The codec is only used with the options it is generated for
+	buffer.buf = compiled;
+	buffer.bufLen = PORTS_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	serialize.initHeader(&strm);
+	tmp_err_code = serialize.initStream(&strm, buffer, &demo_schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	ck_assert(strm.codec == demo_schema.codec);
+	serialize.closeEXIStream(&strm);
+	serialize.initHeader(&strm);
+	SET_STRICT(strm.header.opts.enumOpt);
+	tmp_err_code = serialize.initStream(&strm, buffer, &demo_schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	ck_assert(strm.codec == NULL);
+	serialize.closeEXIStream(&strm);
+
+	genericLen = serializePortsDoc(&schema, generic, TRUE);
+	compiledLen = serializePortsDoc(&demo_schema, compiled, TRUE);
+	ck_assert_msg(genericLen == compiledLen && memcmp(generic, compiled, genericLen) == 0,
+			"the document serialized with the generated codec differs");
+
+	memset(&td, 0, sizeof(td));
+	td.schema = &schema;
+	parseWithLog(smallMsgInput(compiled, compiledLen), &td, FALSE);
+	genericLog = td.log;
+	td.log.data = NULL;
+	td.log.len = 0;
+	td.log.cap = 0;
+	td.schema = &demo_schema;
+	parseWithLog(smallMsgInput(compiled, compiledLen), &td, FALSE);
+	ck_assert_msg(td.log.len == genericLog.len && memcmp(td.log.data, genericLog.data, genericLog.len) == 0,
+			"the events decoded with the generated codec differ");
+	free(td.log.data);
+	free(genericLog.data);
+
+	destroySchema(&schema);
+	free(generic);
+	free(compiled);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+START_TEST (bench_static_codec)
+{
+	char* schemafname[1] = {"exip/schema_demo.exi"};
+	EXIPSchema schema;
+	char* buf = malloc(PORTS_DOC_BUFFER_SIZE);
+	struct transcodeData td;
+	Index len = 0;
+	clock_t start;
+	double genericEnc, compiledEnc, genericDec, compiledDec;
+	int i;
+
+	ck_assert(buf != NULL);
+	parseMultiSchema(schemafname, 1, &schema);
+
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		serializePortsDoc(&schema, buf, TRUE);
+	genericEnc = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		len = serializePortsDoc(&demo_schema, buf, TRUE);
+	compiledEnc = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	memset(&td, 0, sizeof(td));
+	td.quiet = TRUE;
+	td.schema = &schema;
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		parseWithLog(smallMsgInput(buf, len), &td, FALSE);
+	genericDec = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	td.schema = &demo_schema;
+	start = clock();
+	for(i = 0; i < PORTS_DOC_ITERATIONS; i++)
+		parseWithLog(smallMsgInput(buf, len), &td, FALSE);
+	compiledDec = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%d ports: generated codec encoding %.4fs, decoding %.4fs; generic grammars encoding %.4fs, decoding %.4fs for %d runs\n",
+			PORTS_DOC_PORTS, compiledEnc, compiledDec, genericEnc, genericDec, PORTS_DOC_ITERATIONS);
+
+	destroySchema(&schema);
+	free(buf);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+/* END: Generated static codec tests */
+
+/* BEGIN: Pull parsing tests */
+
+/* Passes an event returned by exipNextEvent() to the logging handler of parseWithLog() */
+static errorCode logPullEvent(ContentHandler* handler, const ExipEvent* ev, struct transcodeData* td)
+{
+	QName qname = {&ev->name.uri, &ev->name.localName, NULL};
+
+	switch(ev->kind)
+	{
+		case EXIP_EVENT_START_DOCUMENT:
+			return handler->startDocument(td);
+		case EXIP_EVENT_END_DOCUMENT:
+			return handler->endDocument(td);
+		case EXIP_EVENT_START_ELEMENT:
+			return handler->startElement(qname, td);
+		case EXIP_EVENT_END_ELEMENT:
+			return handler->endElement(td);
+		case EXIP_EVENT_ATTRIBUTE:
+			return handler->attribute(qname, td);
+		case EXIP_EVENT_NAMESPACE:
+			return handler->namespaceDeclaration(ev->value.nsVal.ns, ev->value.nsVal.prefix, ev->value.nsVal.isLocalElementNS, td);
+		case EXIP_EVENT_INT:
+			return handler->intData(ev->value.intVal, td);
+		case EXIP_EVENT_BOOLEAN:
+			return handler->booleanData(ev->value.boolVal, td);
+		case EXIP_EVENT_STRING:
+			return handler->stringData(ev->value.strVal, td);
+		case EXIP_EVENT_FLOAT:
+			return handler->floatData(ev->value.floatVal, td);
+		case EXIP_EVENT_BINARY:
+			return handler->binaryData(ev->value.binVal.data, ev->value.binVal.length, td);
+		case EXIP_EVENT_DATE_TIME:
+			return handler->dateTimeData(ev->value.dtVal, td);
+		case EXIP_EVENT_DECIMAL:
+			return handler->decimalData(ev->value.decVal, td);
+		case EXIP_EVENT_LIST:
+			return handler->listData(ev->value.listVal.itemType, ev->value.listVal.itemCount, td);
+		case EXIP_EVENT_QNAME:
+			return handler->qnameData(qname, td);
+		default:
+			return EXIP_OK;
+	}
+}
+
+/* Parses an EXI stream with exipNextEvent() and logs its events as parseWithLog() does.
+ * In quiet mode the events are only counted. Returns the number of events */
+static unsigned int parsePullWithLog(BinaryBuffer buffer, struct transcodeData* td)
+{
+	Parser parser;
+	ContentHandler logHandler;
+	ExipEvent ev;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	unsigned int count = 0;
+	boolean checkIds = TRUE;
+
+	td->transcode = FALSE;
+	td->src = &parser;
+	td->bufferStrings = 0;
+
+	tmp_err_code = initParser(&parser, buffer, td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+
+	initContentHandler(&logHandler);
+	setLogHandlers(&logHandler);
+	parser.handler.error = tc_error;
+	parser.handler.fatalError = tc_error;
+
+	tmp_err_code = parseHeader(&parser, TRUE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+
+	tmp_err_code = setSchema(&parser, td->schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	// The values of the events are kept in the string arena
+	ck_assert(parse.exipNextEvent(&parser, &ev) == EXIP_INCONSISTENT_PROC_STATE);
+	tmp_err_code = parse.enableStringArena(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "enableStringArena returns an error code %d", tmp_err_code);
+
+#if COMPRESSION_USE
+	// The QNameIDs are not reported in compression modes
+	checkIds = parser.strm.channels == NULL;
+#endif
+
+	while((tmp_err_code = parse.exipNextEvent(&parser, &ev)) == EXIP_OK)
+	{
+		count++;
+		if(td->quiet)
+			continue;
+
+		// The QNameIDs refer to the qname of the event
+		if((ev.kind == EXIP_EVENT_START_ELEMENT || ev.kind == EXIP_EVENT_ATTRIBUTE) && checkIds)
+		{
+			ck_assert(stringEqual(ev.name.uri, parser.strm.schema->uriTable.uri[ev.qnameId.uriId].uriStr));
+			ck_assert(stringEqual(ev.name.localName, parser.strm.schema->uriTable.uri[ev.qnameId.uriId].lnTable.ln[ev.qnameId.lnId].lnStr));
+		}
+
+		tmp_err_code = logPullEvent(&logHandler, &ev, td);
+		if(tmp_err_code == EXIP_HANDLER_SKIP_ELEMENT)
+		{
+			tmp_err_code = parse.skipElement(&parser);
+			if(tmp_err_code == EXIP_PARSING_COMPLETE)
+				break;
+		}
+		ck_assert_msg (tmp_err_code == EXIP_OK, "logging of event %d returns an error code %d", (int) ev.kind, tmp_err_code);
+	}
+
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during pull parsing of the EXI body %d", tmp_err_code);
+	ck_assert_msg (ev.kind == EXIP_EVENT_END_DOCUMENT || td->skipLocalName != NULL, "the last event is not the end of the document");
+	// Once completed, the parser keeps reporting it
+	ck_assert(parse.exipNextEvent(&parser, &ev) == EXIP_PARSING_COMPLETE);
+
+	destroyParser(&parser);
+
+	return count;
+}
+
+/* Re-encodes an EXI file with the given alignment and checks that exipNextEvent()
+ * returns the same events as the content handler callbacks of parseNext() */
+static void checkPullEvents(const char* exifname, EXIPSchema* schema, unsigned char alignment)
+{
+	struct transcodeData td;
+	struct memBuffer callbackLog;
+
+	memset(&td, 0, sizeof(td));
+	td.schema = schema;
+	td.alignment = alignment;
+	td.blockSize = 1000000;
+	transcodeFile(exifname, &td);
+
+	callbackLog = td.log;
+	td.log.data = NULL;
+	td.log.len = 0;
+	td.log.cap = 0;
+
+	parsePullWithLog(transcodedBuffer(&td), &td);
+	ck_assert_msg(td.log.len == callbackLog.len && memcmp(td.log.data, callbackLog.data, callbackLog.len) == 0,
+			"%s: the pulled events with alignment 0x%X differ from the callback ones", exifname, (unsigned int) alignment);
+
+	free(callbackLog.data);
+	free(td.log.data);
+	free(td.out.data);
+}
+
+/* The pull interface returns the events of the callback interface in
+ * schema-less and schema-informed streams in all alignment modes */
+START_TEST (test_pull_events)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	char* schemafname[1] = {"testStates/acceptance-xsd.exi"};
+	EXIPSchema schema;
+	int f;
+
+	for(f = 0; f < 2; f++)
+	{
+		checkPullEvents(files[f], NULL, BIT_PACKED);
+		checkPullEvents(files[f], NULL, BYTE_ALIGNMENT);
+#if COMPRESSION_USE
+		checkPullEvents(files[f], NULL, PRE_COMPRESSION);
+		checkPullEvents(files[f], NULL, COMPRESSION);
+#endif
+	}
+
+	parseMultiSchema(schemafname, 1, &schema);
+	checkPullEvents("testStates/acceptance_a_01.exi", &schema, BIT_PACKED);
+	checkPullEvents("testStates/acceptance_a_01.exi", &schema, BYTE_ALIGNMENT);
+#if COMPRESSION_USE
+	checkPullEvents("testStates/acceptance_a_01.exi", &schema, COMPRESSION);
+#endif
+	destroySchema(&schema);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+/* Decoding time of the pull interface against the callback interface on the same documents */
+START_TEST (bench_pull)
+{
+	const char* files[2] = {"Ant/build-build.bitPacked", "SchemaStrict/lkab-devices-xsd.exi"};
+	struct transcodeData src;
+	struct transcodeData td;
+	clock_t start;
+	double callbackTime, pullTime;
+	unsigned int events = 0;
+	int f, i;
+
+	for(f = 0; f < 2; f++)
+	{
+		memset(&src, 0, sizeof(src));
+		src.alignment = BIT_PACKED;
+		src.blockSize = 1000000;
+		src.quiet = TRUE;
+		transcodeFile(files[f], &src);
+
+		memset(&td, 0, sizeof(td));
+		td.quiet = TRUE;
+
+		start = clock();
+		for(i = 0; i < BENCH_ITERATIONS; i++)
+			parseWithLog(transcodedBuffer(&src), &td, FALSE);
+		callbackTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for(i = 0; i < BENCH_ITERATIONS; i++)
+			events = parsePullWithLog(transcodedBuffer(&src), &td);
+		pullTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%s (%u events): pull decoding %.4fs, callback decoding %.4fs for %d runs\n",
+				files[f], events, pullTime, callbackTime, BENCH_ITERATIONS);
+
+		free(src.out.data);
+	}
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+/* END: Pull parsing tests */
+
+/* BEGIN: Element skipping tests */
+
+/* Removes from a log of parseWithLog() the events in the content of the elements
+ * with the given local name, including their end element events */
+static void removeSkippedEvents(struct memBuffer* log, const char* localName)
+{
+	char seLine[100];
+	size_t seLen;
+	size_t in = 0, out = 0, lineLen;
+	unsigned int depth = 0;
+	const char* line;
+	const char* nl;
+
+	// The uri part of the line is not compared
+	seLen = (size_t) snprintf(seLine, sizeof(seLine), "|%s|\n", localName);
+
+	while(in < log->len)
+	{
+		line = log->data + in;
+		nl = memchr(line, '\n', log->len - in);
+		lineLen = (size_t) (nl - line) + 1;
+
+		if(depth > 0)
+		{
+			if(lineLen > 3 && memcmp(line, "SE ", 3) == 0)
+				depth++;
+			else if(lineLen == 3 && memcmp(line, "EE\n", 3) == 0)
+				depth--;
+		}
+		else
+		{
+			memmove(log->data + out, line, lineLen);
+			out += lineLen;
+			if(lineLen >= 3 + seLen && memcmp(line, "SE ", 3) == 0 && memcmp(nl + 1 - seLen, seLine, seLen) == 0)
+				depth = 1;
+		}
+		in += lineLen;
+	}
+
+	log->len = out;
+}
+
+/* Skips the content of the elements with the given local name with both the handler
+ * return code and skipElement() of the pull interface and compares the events with
+ * the ones of the whole stream. The stream is also skipped when parsed in small
+ * chunks from its file */
+static void checkSkipElement(const char* exifname, EXIPSchema* schema, unsigned char alignment, const char* localName)
+{
+	struct transcodeData td;
+	struct memBuffer expected;
+
+	memset(&td, 0, sizeof(td));
+	td.schema = schema;
+	td.alignment = alignment;
+	td.blockSize = 1000000;
+	transcodeFile(exifname, &td);
+
+	expected = td.log;
+	removeSkippedEvents(&expected, localName);
+	ck_assert_msg(expected.len > 0 && expected.len < td.log.len, "%s: no <%s> content to skip", exifname, localName);
+	td.log.data = NULL;
+	td.log.len = 0;
+	td.log.cap = 0;
+
+	td.skipLocalName = localName;
+	parseWithLog(transcodedBuffer(&td), &td, FALSE);
+	ck_assert_msg(td.log.len == expected.len && memcmp(td.log.data, expected.data, expected.len) == 0,
+			"%s: the events with skipped <%s> elements and alignment 0x%X differ", exifname, localName, (unsigned int) alignment);
+
+	td.log.len = 0;
+	parsePullWithLog(transcodedBuffer(&td), &td);
+	ck_assert_msg(td.log.len == expected.len && memcmp(td.log.data, expected.data, expected.len) == 0,
+			"%s: the pulled events with skipped <%s> elements and alignment 0x%X differ", exifname, localName, (unsigned int) alignment);
+
+	if(alignment == BIT_PACKED)
+	{
+		char buf[INPUT_BUFFER_SIZE];
+		char exipath[MAX_PATH_LEN + 100];
+		BinaryBuffer buffer;
+		FILE *infile;
+
+		snprintf(exipath, sizeof(exipath), "%s/%s", dataDir, exifname);
+		infile = fopen(exipath, "rb" );
+		if(!infile)
+			ck_abort_msg("Unable to open file %s", exipath);
+
+		buffer.buf = buf;
+		buffer.bufContent = 0;
+		buffer.bufLen = INPUT_BUFFER_SIZE;
+		buffer.ioStrm.readWriteToStream = readFileInputStream;
+		buffer.ioStrm.stream = infile;
+		buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+		td.log.len = 0;
+		parseWithLog(buffer, &td, FALSE);
+		fclose(infile);
+		ck_assert_msg(td.log.len == expected.len && memcmp(td.log.data, expected.data, expected.len) == 0,
+				"%s: the events with skipped <%s> elements parsed from the file differ", exifname, localName);
+	}
+
+	free(expected.data);
+	free(td.log.data);
+	free(td.out.data);
+}
+
+/* Skipped content in schema-less and schema-informed streams in all alignment modes */
+START_TEST (test_skip_element)
+{
+	const unsigned char modes[4] = {BIT_PACKED, BYTE_ALIGNMENT, PRE_COMPRESSION, COMPRESSION};
+	char* schemafname[1] = {"testStates/acceptance-xsd.exi"};
+	EXIPSchema schema;
+	int m, modeCount = 2;
+
+#if COMPRESSION_USE
+	modeCount = 4;
+#endif
+
+	parseMultiSchema(schemafname, 1, &schema);
+	for(m = 0; m < modeCount; m++)
+	{
+		checkSkipElement("Ant/build-build.bitPacked", NULL, modes[m], "target");
+		checkSkipElement("SchemaStrict/lkab-devices-xsd.exi", NULL, modes[m], "complexType");
+		checkSkipElement("testStates/acceptance_a_01.exi", &schema, modes[m], "A");
+	}
+	destroySchema(&schema);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+START_TEST (bench_skip_element)
+{
+	struct transcodeData td;
+	clock_t start;
+	double fullTime, skipTime;
+	int i;
+
+	memset(&td, 0, sizeof(td));
+	td.alignment = BIT_PACKED;
+	td.blockSize = 1000000;
+	td.quiet = TRUE;
+	transcodeFile("Ant/build-build.bitPacked", &td);
+
+	start = clock();
+	for(i = 0; i < BENCH_ITERATIONS; i++)
+		parseWithLog(transcodedBuffer(&td), &td, FALSE);
+	fullTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	td.skipLocalName = "target";
+	start = clock();
+	for(i = 0; i < BENCH_ITERATIONS; i++)
+		parseWithLog(transcodedBuffer(&td), &td, FALSE);
+	skipTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	printf("Ant/build-build.bitPacked: decoding with skipped <target> elements %.4fs, whole document %.4fs for %d runs\n",
+			skipTime, fullTime, BENCH_ITERATIONS);
+	free(td.out.data);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+/* END: Element skipping tests */
+
+/* BEGIN: Self-contained elements tests */
+
+#define SC_DOC_RECORDS 30
+#define SC_DOC_BUFFER_SIZE 20000
+
+/* A self-contained element of the records document: a <rec> or its <note> */
+struct scRecord
+{
+	Index element;
+	int record;
+	boolean note;
+};
+
+/* Serializes a schema-less document of records; with scRecords set each <rec>, and
+ * the <note> of every third one, is a self-contained element listed in scRecords */
+static Index serializeRecordsDoc(char* buf, unsigned char alignment, SelfContainedIndex* index, struct scRecord* scRecords)
+{
+	EXIStream strm;
+	BinaryBuffer buffer;
+	char idBuf[12];
+	String uri;
+	String ln;
+	QName qname = {&uri, &ln};
+	String chVal;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	Index elements = 0;
+	int scCount = 0;
+	int i;
+
+	buffer.buf = buf;
+	buffer.bufLen = SC_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	getEmptyString(&uri);
+
+	serialize.initHeader(&strm);
+	strm.header.has_options = TRUE;
+	SET_ALIGNMENT(strm.header.opts.enumOpt, alignment);
+	if(scRecords != NULL)
+		SET_SELF_CONTAINED(strm.header.opts.enumOpt);
+
+	tmp_err_code = serialize.initStream(&strm, buffer, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+	if(index != NULL)
+	{
+		tmp_err_code = serialize.setSelfContainedIndex(&strm, index);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "setSelfContainedIndex returns an error code %d", tmp_err_code);
+	}
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	SET_ASCII_STRING(ln, "root");
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+	elements++;
+
+	for(i = 0; i < SC_DOC_RECORDS; i++)
+	{
+		SET_ASCII_STRING(ln, "gap");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		elements++;
+		SET_ASCII_STRING(chVal, "shared");
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+
+		SET_ASCII_STRING(ln, "rec");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		if(scRecords != NULL)
+		{
+			tmp_err_code += serialize.selfContained(&strm);
+			scRecords[scCount].element = elements;
+			scRecords[scCount].record = i;
+			scRecords[scCount++].note = FALSE;
+		}
+		elements++;
+		SET_ASCII_STRING(ln, "id");
+		tmp_err_code += serialize.attribute(&strm, qname, TRUE, &valueType);
+		sprintf(idBuf, "%d", i);
+		SET_ASCII_STRING(chVal, idBuf);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+
+		SET_ASCII_STRING(ln, "name");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		elements++;
+		SET_ASCII_STRING(chVal, "shared");
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+
+		if(i % 3 == 0)
+		{
+			SET_ASCII_STRING(ln, "note");
+			tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+			if(scRecords != NULL)
+			{
+				tmp_err_code += serialize.selfContained(&strm);
+				scRecords[scCount].element = elements;
+				scRecords[scCount].record = i;
+				scRecords[scCount++].note = TRUE;
+			}
+			elements++;
+			tmp_err_code += serialize.stringData(&strm, chVal);
+			tmp_err_code += serialize.endElement(&strm);
+		}
+
+		tmp_err_code += serialize.endElement(&strm);
+	}
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* The events of a self-contained element of the records document decoded on its own */
+static void expectedRecordLog(struct memBuffer* log, struct scRecord* sc)
+{
+	char line[200];
+	int len = 0;
+
+	if(!sc->note)
+		len += sprintf(line + len, "SE |rec|\nAT |id|\nCH %d|\nSE |name|\nCH shared|\nEE\n", sc->record);
+	if(sc->note || sc->record % 3 == 0)
+		len += sprintf(line + len, "SE |note|\nCH shared|\nEE\n");
+	if(!sc->note)
+		len += sprintf(line + len, "EE\n");
+	len += sprintf(line + len, "ED\n");
+
+	log->len = 0;
+	appendMemBuffer(log, line, len);
+}
+
+/* Decodes the self-contained elements of a document on their own, in reverse order, with
+ * seekSelfContained(). The first one is decoded last after a seek outside of the input
+ * buffer: its bytes are given with pushEXIData() */
+static void checkSeekSelfContained(char* buf, Index len, SelfContainedIndex* index, struct scRecord* scRecords)
+{
+	Parser parser;
+	BinaryBuffer buffer;
+	struct transcodeData td;
+	struct memBuffer expected = {NULL, 0, 0};
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index i;
+
+	buffer.buf = malloc(len);
+	memcpy(buffer.buf, buf, len);
+	buffer.bufLen = len;
+	buffer.bufContent = len;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	memset(&td, 0, sizeof(td));
+	td.src = &parser;
+
+	tmp_err_code = initParser(&parser, buffer, &td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	setLogHandlers(&parser.handler);
+
+	tmp_err_code = parseHeader(&parser, FALSE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	for(i = index->count; i > 0; i--)
+	{
+		Index offset = index->entry[i - 1].offset;
+
+		ck_assert(index->entry[i - 1].element == scRecords[i - 1].element);
+
+		if(i == 1)
+			parser.strm.buffer.bufContent = offset - 1;
+
+		tmp_err_code = parse.seekSelfContained(&parser, offset);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "seekSelfContained returns an error code %d", tmp_err_code);
+
+		td.log.len = 0;
+		do
+		{
+			tmp_err_code = parseNext(&parser);
+			if(tmp_err_code == EXIP_BUFFER_END_REACHED && i == 1)
+				tmp_err_code = parse.pushEXIData(buf + offset, len - offset, &parser);
+		}
+		while(tmp_err_code == EXIP_OK);
+		ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the self-contained element at offset %u: %d", (unsigned int) offset, tmp_err_code);
+
+		expectedRecordLog(&expected, &scRecords[i - 1]);
+		ck_assert_msg(td.log.len == expected.len && memcmp(td.log.data, expected.data, expected.len) == 0,
+				"the events of the self-contained element at offset %u differ", (unsigned int) offset);
+	}
+
+	destroyParser(&parser);
+	free(expected.data);
+	free(td.log.data);
+	free(buffer.buf);
+}
+
+/* Skips the elements with the given local name of a document with the index of its
+ * self-contained elements. Their content is overwritten, so the skipping must jump to their
+ * recorded ends; the input is pushed in two parts, the first one ending within the first of them */
+static void checkSkipSelfContained(char* buf, Index len, EXIPSchema* schema, SelfContainedIndex* index,
+								   const char* localName, struct memBuffer* expected)
+{
+	Parser parser;
+	BinaryBuffer buffer;
+	struct transcodeData td;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	char* data = malloc(len);
+	Index given;
+	Index i;
+
+	memcpy(data, buf, len);
+	for(i = 0; i < index->count; i++)
+	{
+		ck_assert_msg(index->entry[i].end > index->entry[i].offset && index->entry[i].end < len,
+				"the self-contained element at offset %u has no end", (unsigned int) index->entry[i].offset);
+		memset(data + index->entry[i].offset, 0xFF, index->entry[i].end - index->entry[i].offset);
+	}
+
+	given = index->entry[0].offset + 1;
+	buffer.buf = malloc(len);
+	memcpy(buffer.buf, data, given);
+	buffer.bufLen = len;
+	buffer.bufContent = given;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	memset(&td, 0, sizeof(td));
+	td.src = &parser;
+	td.skipLocalName = localName;
+
+	tmp_err_code = initParser(&parser, buffer, &td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	setLogHandlers(&parser.handler);
+
+	tmp_err_code = parseHeader(&parser, FALSE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+	tmp_err_code = parse.useSelfContainedIndex(&parser, index);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "useSelfContainedIndex returns an error code %d", tmp_err_code);
+
+	do
+	{
+		tmp_err_code = parseNext(&parser);
+		if(tmp_err_code == EXIP_BUFFER_END_REACHED && given < len)
+		{
+			tmp_err_code = parse.pushEXIData(data + given, len - given, &parser);
+			given = len;
+		}
+	}
+	while(tmp_err_code == EXIP_OK);
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing with skipped self-contained elements: %d", tmp_err_code);
+
+	ck_assert_msg(td.log.len == expected->len && memcmp(td.log.data, expected->data, expected->len) == 0,
+			"the events of the document with skipped self-contained elements differ");
+
+	destroyParser(&parser);
+	free(td.log.data);
+	free(buffer.buf);
+	free(data);
+}
+
+/* Skips the self-contained elements of a document with exipNextEvent(), right after
+ * their SC event: the input must be moved to their recorded ends. Expects count of them */
+static void checkPullSkipSelfContained(char* buf, Index len, EXIPSchema* schema, SelfContainedIndex* index, int count)
+{
+	Parser parser;
+	BinaryBuffer buffer;
+	ExipEvent ev;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index e = 0;
+	Index pos;
+	int skipped = 0;
+
+	buffer.buf = buf;
+	buffer.bufLen = len;
+	buffer.bufContent = len;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	tmp_err_code = initParser(&parser, buffer, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	tmp_err_code = parseHeader(&parser, FALSE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+	tmp_err_code = parse.useSelfContainedIndex(&parser, index);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "useSelfContainedIndex returns an error code %d", tmp_err_code);
+	tmp_err_code = parse.enableStringArena(&parser);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "enableStringArena returns an error code %d", tmp_err_code);
+
+	while((tmp_err_code = parse.exipNextEvent(&parser, &ev)) == EXIP_OK)
+	{
+		if(ev.kind != EXIP_EVENT_SELF_CONTAINED)
+			continue;
+
+		pos = parser.strm.context.bufferOffset + parser.strm.context.bufferIndx;
+		while(e + 1 < index->count && index->entry[e + 1].offset <= pos)
+			e++;
+
+		tmp_err_code = parse.skipElement(&parser);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "skipElement returns an error code %d", tmp_err_code);
+		pos = parser.strm.context.bufferOffset + parser.strm.context.bufferIndx;
+		ck_assert_msg(pos == index->entry[e].end, "the self-contained element at offset %u is skipped up to %u instead of %u",
+				(unsigned int) index->entry[e].offset, (unsigned int) pos, (unsigned int) index->entry[e].end);
+		skipped++;
+	}
+	ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during the pull parsing with skipped self-contained elements: %d", tmp_err_code);
+	ck_assert_msg (skipped == count, "%d self-contained elements skipped instead of %d", skipped, count);
+
+	destroyParser(&parser);
+}
+
+/* Self-contained elements are decoded in the stream as the other elements, on their own
+ * through the index of their offsets and skipped through the index of their ends,
+ * in bit-packed and byte-aligned streams */
+START_TEST (test_self_contained)
+{
+	const unsigned char modes[2] = {BIT_PACKED, BYTE_ALIGNMENT};
+	char* plain = malloc(SC_DOC_BUFFER_SIZE);
+	char* sc = malloc(SC_DOC_BUFFER_SIZE);
+	struct scRecord scRecords[SC_DOC_RECORDS*2];
+	SelfContainedIndex index;
+	struct transcodeData td;
+	struct memBuffer plainLog;
+	Index plainLen, scLen;
+	BinaryBuffer buffer;
+	int m;
+
+	for(m = 0; m < 2; m++)
+	{
+		plainLen = serializeRecordsDoc(plain, modes[m], NULL, NULL);
+		scLen = serializeRecordsDoc(sc, modes[m], &index, scRecords);
+		ck_assert_msg(index.count == SC_DOC_RECORDS + (SC_DOC_RECORDS + 2)/3, "%u self-contained elements in the index", (unsigned int) index.count);
+
+		memset(&td, 0, sizeof(td));
+		buffer.buf = plain;
+		buffer.bufContent = plainLen;
+		buffer.bufLen = plainLen;
+		buffer.ioStrm.readWriteToStream = NULL;
+		buffer.ioStrm.stream = NULL;
+		buffer.bufStrm = EMPTY_BUFFER_STREAM;
+		parseWithLog(buffer, &td, FALSE);
+		plainLog = td.log;
+		memset(&td.log, 0, sizeof(td.log));
+
+		buffer.buf = sc;
+		buffer.bufContent = scLen;
+		buffer.bufLen = scLen;
+		parseWithLog(buffer, &td, FALSE);
+		ck_assert_msg(td.log.len == plainLog.len && memcmp(td.log.data, plainLog.data, plainLog.len) == 0,
+				"the events of the document with self-contained elements differ, alignment 0x%X", (unsigned int) modes[m]);
+
+		checkSeekSelfContained(sc, scLen, &index, scRecords);
+		free(plainLog.data);
+		free(td.log.data);
+
+		memset(&td.log, 0, sizeof(td.log));
+		buffer.buf = plain;
+		buffer.bufContent = plainLen;
+		buffer.bufLen = plainLen;
+		td.skipLocalName = "rec";
+		parseWithLog(buffer, &td, FALSE);
+		checkSkipSelfContained(sc, scLen, NULL, &index, "rec", &td.log);
+		checkPullSkipSelfContained(sc, scLen, NULL, &index, SC_DOC_RECORDS);
+
+		destroySelfContainedIndex(&index);
+		free(td.log.data);
+	}
+
+	free(plain);
+	free(sc);
+}
+END_TEST
+
+/* Decodes each self-contained element of a document on its own with seekSelfContained()
+ * and checks that its events, up to the end of the fragment, are found in the log of the document */
+static void checkSeekSelfContainedLog(char* buf, Index len, EXIPSchema* schema, SelfContainedIndex* index, struct memBuffer* docLog)
+{
+	Parser parser;
+	BinaryBuffer buffer;
+	struct transcodeData td;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index i;
+	size_t pos;
+
+	buffer.buf = buf;
+	buffer.bufLen = len;
+	buffer.bufContent = len;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	memset(&td, 0, sizeof(td));
+	td.src = &parser;
+
+	tmp_err_code = initParser(&parser, buffer, &td);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initParser returns an error code %d", tmp_err_code);
+	setLogHandlers(&parser.handler);
+
+	tmp_err_code = parseHeader(&parser, FALSE);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "parsing the header returns an error code %d", tmp_err_code);
+	tmp_err_code = setSchema(&parser, schema);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "setSchema() returns an error code %d", tmp_err_code);
+
+	for(i = index->count; i > 0; i--)
+	{
+		Index offset = index->entry[i - 1].offset;
+
+		tmp_err_code = parse.seekSelfContained(&parser, offset);
+		ck_assert_msg (tmp_err_code == EXIP_OK, "seekSelfContained returns an error code %d", tmp_err_code);
+
+		td.log.len = 0;
+		do
+		{
+			tmp_err_code = parseNext(&parser);
+		}
+		while(tmp_err_code == EXIP_OK);
+		ck_assert_msg (tmp_err_code == EXIP_PARSING_COMPLETE, "Error during parsing of the self-contained element at offset %u: %d", (unsigned int) offset, tmp_err_code);
+
+		// The events of the element followed by ED
+		ck_assert(td.log.len > 3 && memcmp(td.log.data, "SE ", 3) == 0 && memcmp(td.log.data + td.log.len - 3, "ED\n", 3) == 0);
+		td.log.len -= 3;
+		for(pos = 0; pos + td.log.len <= docLog->len; pos++)
+		{
+			if(memcmp(docLog->data + pos, td.log.data, td.log.len) == 0)
+				break;
+		}
+		ck_assert_msg(pos + td.log.len <= docLog->len, "the events of the self-contained element at offset %u differ", (unsigned int) offset);
+	}
+
+	destroyParser(&parser);
+	free(td.log.data);
+}
+
+/* Self-contained elements of a schema-informed stream are encoded with the grammars of their
+ * declarations: the <port> elements of the schema_demo document, declared with other types
+ * elsewhere in the schema, and the <configuration> elements, the document element and a local
+ * element of another type. They are decoded in the stream, on their own and skipped */
+START_TEST (test_self_contained_schema)
+{
+	char* schemafname[1] = {"exip/schema_demo.exi"};
+	const char* scNames[2] = {"port", "configuration"};
+	const unsigned char modes[2] = {BIT_PACKED, BYTE_ALIGNMENT};
+	EXIPSchema schema;
+	char* plain = malloc(PORTS_DOC_BUFFER_SIZE);
+	SelfContainedIndex index;
+	struct transcodeData td;
+	struct memBuffer plainLog;
+	BinaryBuffer buffer;
+	int m, n;
+
+	ck_assert(plain != NULL);
+	parseMultiSchema(schemafname, 1, &schema);
+
+	buffer.buf = plain;
+	buffer.bufContent = serializePortsDoc(&schema, plain, FALSE);
+	buffer.bufLen = buffer.bufContent;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	for(n = 0; n < 2; n++)
+	{
+		for(m = 0; m < 2; m++)
+		{
+			memset(&td, 0, sizeof(td));
+			td.schema = &schema;
+			td.alignment = modes[m];
+			td.scLocalName = scNames[n];
+			td.scIndex = &index;
+			parseWithLog(buffer, &td, TRUE);
+			ck_assert_msg(index.count == PORTS_DOC_PORTS + n, "%u self-contained <%s> elements in the index", (unsigned int) index.count, scNames[n]);
+
+			plainLog = td.log;
+			memset(&td.log, 0, sizeof(td.log));
+			td.scLocalName = NULL;
+			td.scIndex = NULL;
+			parseWithLog(transcodedBuffer(&td), &td, FALSE);
+			ck_assert_msg(td.log.len == plainLog.len && memcmp(td.log.data, plainLog.data, plainLog.len) == 0,
+					"the events of the document with self-contained <%s> elements differ, alignment 0x%X", scNames[n], (unsigned int) modes[m]);
+
+			checkSeekSelfContainedLog(td.out.data, td.out.len, &schema, &index, &plainLog);
+			free(td.log.data);
+
+			if(n == 0)
+			{
+				memset(&td.log, 0, sizeof(td.log));
+				td.skipLocalName = "port";
+				parseWithLog(buffer, &td, FALSE);
+				checkSkipSelfContained(td.out.data, td.out.len, &schema, &index, "port", &td.log);
+				checkPullSkipSelfContained(td.out.data, td.out.len, &schema, &index, PORTS_DOC_PORTS);
+				free(td.log.data);
+			}
+
+			destroySelfContainedIndex(&index);
+			free(plainLog.data);
+			free(td.out.data);
+		}
+	}
+
+	destroySchema(&schema);
+	free(plain);
+}
+END_TEST
+
+/* Serializes a schema-less document of records with preserved prefixes; with sc set
+ * each <r:rec> is self-contained. A <r:rec> declares the prefixes of its content again and
+ * a new one, s, for the same namespace. Checks that the prefixes of that namespace in the
+ * enclosing stream are the same after each self-contained element */
+static Index serializePrefixRecordsDoc(char* buf, unsigned char alignment, boolean sc)
+{
+	const String NS_R = {"urn:r", 5};
+	const String PFX_R = {"r", 1};
+	const String PFX_S = {"s", 1};
+	EXIStream strm;
+	BinaryBuffer buffer;
+	char idBuf[12];
+	String uri = NS_R;
+	String ln;
+	String prefix = PFX_R;
+	QName qname = {&uri, &ln, &prefix};
+	SmallIndex uriId;
+	String chVal;
+	EXITypeClass valueType;
+	errorCode tmp_err_code = EXIP_UNEXPECTED_ERROR;
+	Index len;
+	int i;
+
+	buffer.buf = buf;
+	buffer.bufLen = SC_DOC_BUFFER_SIZE;
+	buffer.bufContent = 0;
+	buffer.ioStrm.readWriteToStream = NULL;
+	buffer.ioStrm.stream = NULL;
+	buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	serialize.initHeader(&strm);
+	strm.header.has_options = TRUE;
+	SET_ALIGNMENT(strm.header.opts.enumOpt, alignment);
+	SET_PRESERVED(strm.header.opts.preserve, PRESERVE_PREFIXES);
+	if(sc)
+		SET_SELF_CONTAINED(strm.header.opts.enumOpt);
+
+	tmp_err_code = serialize.initStream(&strm, buffer, NULL);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
+
+	tmp_err_code = serialize.exiHeader(&strm);
+	tmp_err_code += serialize.startDocument(&strm);
+	SET_ASCII_STRING(ln, "root");
+	tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+	tmp_err_code += serialize.namespaceDeclaration(&strm, NS_R, PFX_R, TRUE);
+
+	for(i = 0; i < SC_DOC_RECORDS; i++)
+	{
+		prefix = PFX_R;
+		SET_ASCII_STRING(ln, "gap");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		SET_ASCII_STRING(chVal, "shared");
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+
+		SET_ASCII_STRING(ln, "rec");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		if(sc)
+			tmp_err_code += serialize.selfContained(&strm);
+		tmp_err_code += serialize.namespaceDeclaration(&strm, NS_R, PFX_R, TRUE);
+		tmp_err_code += serialize.namespaceDeclaration(&strm, NS_R, PFX_S, FALSE);
+		prefix = PFX_S;
+		SET_ASCII_STRING(ln, "id");
+		tmp_err_code += serialize.attribute(&strm, qname, TRUE, &valueType);
+		sprintf(idBuf, "%d", i);
+		SET_ASCII_STRING(chVal, idBuf);
+		tmp_err_code += serialize.stringData(&strm, chVal);
+
+		SET_ASCII_STRING(ln, "name");
+		tmp_err_code += serialize.startElement(&strm, qname, &valueType);
+		SET_ASCII_STRING(chVal, "shared");
+		tmp_err_code += serialize.stringData(&strm, chVal);
+		tmp_err_code += serialize.endElement(&strm);
+		tmp_err_code += serialize.endElement(&strm);
+
+		ck_assert(lookupUri(&strm.schema->uriTable, NS_R, &uriId));
+		ck_assert_msg(strm.schema->uriTable.uri[uriId].pfxTable->count == (sc ? 1 : 2),
+				"%u prefixes after the element %d", (unsigned int) strm.schema->uriTable.uri[uriId].pfxTable->count, i);
+	}
+
+	tmp_err_code += serialize.endElement(&strm);
+	tmp_err_code += serialize.endDocument(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialization of the document ended with error code %d", tmp_err_code);
+
+	len = strm.context.bufferIndx + (strm.context.bitPointer != 0);
+	tmp_err_code = serialize.closeEXIStream(&strm);
+	ck_assert_msg (tmp_err_code == EXIP_OK, "serialize.closeEXIStream returns an error code %d", tmp_err_code);
+
+	return len;
+}
+
+/* Self-contained elements of a stream with preserved prefixes: the namespace declarations
+ * of a self-contained element only apply to it, the enclosing ones are restored after it */
+START_TEST (test_self_contained_prefixes)
+{
+	const unsigned char modes[2] = {BIT_PACKED, BYTE_ALIGNMENT};
+	char* plain = malloc(SC_DOC_BUFFER_SIZE);
+	char* sc = malloc(SC_DOC_BUFFER_SIZE);
+	struct transcodeData td;
+	struct memBuffer plainLog;
+	BinaryBuffer buffer;
+	int m;
+
+	ck_assert(plain != NULL && sc != NULL);
+
+	for(m = 0; m < 2; m++)
+	{
+		memset(&td, 0, sizeof(td));
+		td.logPrefixes = TRUE;
+		buffer.buf = plain;
+		buffer.bufContent = serializePrefixRecordsDoc(plain, modes[m], FALSE);
+		buffer.bufLen = buffer.bufContent;
+		buffer.ioStrm.readWriteToStream = NULL;
+		buffer.ioStrm.stream = NULL;
+		buffer.bufStrm = EMPTY_BUFFER_STREAM;
+		parseWithLog(buffer, &td, FALSE);
+		plainLog = td.log;
+		memset(&td.log, 0, sizeof(td.log));
+
+		buffer.buf = sc;
+		buffer.bufContent = serializePrefixRecordsDoc(sc, modes[m], TRUE);
+		buffer.bufLen = buffer.bufContent;
+		parseWithLog(buffer, &td, FALSE);
+		ck_assert_msg(td.log.len == plainLog.len && memcmp(td.log.data, plainLog.data, plainLog.len) == 0,
+				"the events of the document with self-contained elements and prefixes differ, alignment 0x%X", (unsigned int) modes[m]);
+
+		free(plainLog.data);
+		free(td.log.data);
+	}
+
+	free(plain);
+	free(sc);
+}
+END_TEST
+
+/* END: Self-contained elements tests */
+
 /* Helper functions */
 static size_t writeFileOutputStream(void* buf, size_t readSize, void* stream)
 {
@@ -1381,6 +4366,115 @@ Suite* exip_suite(void)
 		tcase_add_test (tc_Schema, test_substitution_groups);
 		suite_add_tcase (s, tc_Schema);
 	}
+	{
+		/* Alignment test case */
+		TCase *tc_Alignment = tcase_create ("Alignment");
+		tcase_add_test (tc_Alignment, test_byte_alignment);
+		suite_add_tcase (s, tc_Alignment);
+	}
+#if COMPRESSION_USE
+	{
+		/* Compression and pre-compression test case */
+		TCase *tc_Compression = tcase_create ("Compression");
+		tcase_add_test (tc_Compression, test_compression_schemaless);
+		tcase_add_test (tc_Compression, test_compression_schema);
+		tcase_add_test (tc_Compression, test_compression_fixtures);
+		suite_add_tcase (s, tc_Compression);
+	}
+#endif
+	{
+		/* String arena test case */
+		TCase *tc_StringArena = tcase_create ("StringArena");
+		tcase_add_test (tc_StringArena, test_string_arena);
+		tcase_add_test (tc_StringArena, test_string_arena_push);
+		suite_add_tcase (s, tc_StringArena);
+	}
+	{
+		/* Allocation list test case */
+		TCase *tc_AllocList = tcase_create ("AllocList");
+		tcase_add_test (tc_AllocList, test_alloc_list_reset);
+		suite_add_tcase (s, tc_AllocList);
+	}
+	{
+		/* Reset test case */
+		TCase *tc_Reset = tcase_create ("Reset");
+		tcase_add_test (tc_Reset, test_reset_schemaless);
+		tcase_add_test (tc_Reset, test_reset_schema);
+		tcase_add_test (tc_Reset, test_reset_options_mismatch);
+		suite_add_tcase (s, tc_Reset);
+	}
+	{
+		/* Binary chunk test case */
+		TCase *tc_BinaryChunks = tcase_create ("BinaryChunks");
+		tcase_add_test (tc_BinaryChunks, test_binary_chunks);
+		suite_add_tcase (s, tc_BinaryChunks);
+	}
+
+	{
+		/* Event code dispatch test case */
+		TCase *tc_Dispatch = tcase_create ("EventCodeDispatch");
+		tcase_add_test (tc_Dispatch, test_event_code_dispatch);
+		suite_add_tcase (s, tc_Dispatch);
+	}
+
+	{
+		/* Production index test case */
+		TCase *tc_ProdIndex = tcase_create ("ProductionIndex");
+		tcase_add_test (tc_ProdIndex, test_production_index);
+		suite_add_tcase (s, tc_ProdIndex);
+	}
+
+	{
+		/* QName ID serialization test case */
+		TCase *tc_QNameId = tcase_create ("QNameID");
+		tcase_add_test (tc_QNameId, test_qname_id);
+		suite_add_tcase (s, tc_QNameId);
+	}
+
+	{
+		/* Generated static codec test case */
+		TCase *tc_StaticCodec = tcase_create ("StaticCodec");
+		tcase_add_test (tc_StaticCodec, test_static_codec);
+		suite_add_tcase (s, tc_StaticCodec);
+	}
+
+	{
+		/* Pull parsing test case */
+		TCase *tc_Pull = tcase_create ("PullParsing");
+		tcase_add_test (tc_Pull, test_pull_events);
+		suite_add_tcase (s, tc_Pull);
+	}
+
+	{
+		/* Element skipping test case */
+		TCase *tc_Skip = tcase_create ("SkipElement");
+		tcase_add_test (tc_Skip, test_skip_element);
+		suite_add_tcase (s, tc_Skip);
+	}
+
+	{
+		/* Self-contained elements test case */
+		TCase *tc_SelfContained = tcase_create ("SelfContained");
+		tcase_add_test (tc_SelfContained, test_self_contained);
+		tcase_add_test (tc_SelfContained, test_self_contained_schema);
+		tcase_add_test (tc_SelfContained, test_self_contained_prefixes);
+		suite_add_tcase (s, tc_SelfContained);
+	}
+
+#ifdef EXIP_BENCH
+	{
+		/* Benchmark test case: only run by the bench_exip build */
+		TCase *tc_Bench = tcase_create ("Benchmark");
+		tcase_add_test (tc_Bench, bench_alignment);
+		tcase_add_test (tc_Bench, bench_reset);
+		tcase_add_test (tc_Bench, bench_production_index);
+		tcase_add_test (tc_Bench, bench_qname_id);
+		tcase_add_test (tc_Bench, bench_static_codec);
+		tcase_add_test (tc_Bench, bench_pull);
+		tcase_add_test (tc_Bench, bench_skip_element);
+		suite_add_tcase (s, tc_Bench);
+	}
+#endif
 
 	return s;
 }
@@ -1407,7 +4501,11 @@ int main (int argc, char *argv[])
 #ifdef _MSC_VER
 	srunner_set_fork_status(sr, CK_NOFORK);
 #endif
+#ifdef EXIP_BENCH
+	srunner_run (sr, NULL, "Benchmark", CK_NORMAL);
+#else
 	srunner_run_all (sr, CK_NORMAL);
+#endif
 	number_failed = srunner_ntests_failed (sr);
 	srunner_free (sr);
 	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
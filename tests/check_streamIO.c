@@ -17,6 +17,8 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
 #include <check.h>
 #include "streamRead.h"
 #include "streamWrite.h"
@@ -27,6 +29,27 @@
 #include "stringManipulate.h"
 #include "memManagement.h"
 #include "ioUtil.h"
+#include "streamDeflate.h"
+
+/* Input stream over a memory buffer */
+struct memInput
+{
+	const unsigned char* data;
+	size_t len;
+	size_t pos;
+};
+
+static size_t readMemInput(void* buf, size_t size, void* stream)
+{
+	struct memInput* in = (struct memInput*) stream;
+	size_t n = in->len - in->pos;
+
+	if(n > size)
+		n = size;
+	memcpy(buf, in->data + in->pos, n);
+	in->pos += n;
+	return n;
+}
 
 /* BEGIN: streamRead tests */
 
@@ -132,6 +155,153 @@ START_TEST (test_readBits)
 }
 END_TEST
 
+#define BENCH_BUF_SIZE (1024*1024)
+
+extern const unsigned char BIT_MASK[];
+
+/* Reference byte-at-a-time bit reader (the implementation readBits replaced).
+ * Used to validate and benchmark the 64 bit window reader. */
+static void refReadBits(unsigned char* buf, Index* bufferIndx, unsigned char* bitPointer, unsigned char n, unsigned int* bits_val)
+{
+	unsigned int numBytesToBeRead = 1 + ((n + *bitPointer - 1) / 8);
+	unsigned int byteIndx = 1;
+	uint64_t tmp_val;
+
+	buf += *bufferIndx;
+	tmp_val = buf[0] & BIT_MASK[8 - *bitPointer];
+	while(byteIndx < numBytesToBeRead)
+		tmp_val = (tmp_val << 8) | buf[byteIndx++];
+
+	*bits_val = (unsigned int) (tmp_val >> (numBytesToBeRead*8 - n - *bitPointer));
+
+	n += *bitPointer;
+	*bufferIndx += n / 8;
+	*bitPointer = n % 8;
+}
+
+/* A stream over BENCH_BUF_SIZE random bytes */
+static unsigned char* initRandomStream(EXIStream* testStream)
+{
+  unsigned char* buf;
+  unsigned int i;
+
+  buf = (unsigned char*) malloc(BENCH_BUF_SIZE);
+  ck_assert(buf != NULL);
+  srand(42);
+  for(i = 0; i < BENCH_BUF_SIZE; i++)
+	  buf[i] = (unsigned char) rand();
+
+  testStream->buffer.buf = (char*) buf;
+  testStream->buffer.bufLen = BENCH_BUF_SIZE;
+  testStream->buffer.bufContent = BENCH_BUF_SIZE;
+  testStream->buffer.ioStrm.readWriteToStream = NULL;
+  testStream->buffer.ioStrm.stream = NULL;
+  testStream->buffer.bufStrm = EMPTY_BUFFER_STREAM;
+  testStream->context.bufferIndx = 0;
+  testStream->context.bitPointer = 0;
+  testStream->header.opts.enumOpt = 0;
+  setDecodePrimitives(testStream);
+
+  return buf;
+}
+
+START_TEST (test_readBitsWindow)
+{
+  EXIStream testStream;
+  unsigned char* buf;
+  Index refIndx = 0;
+  unsigned char refBitPointer = 0;
+  unsigned int bits_val = 0;
+  unsigned int ref_val = 0;
+  UnsignedInteger uint_val = 0;
+  UnsignedInteger ref_uint = 0;
+  unsigned int shift;
+  unsigned char n = 1;
+  errorCode err = EXIP_UNEXPECTED_ERROR;
+
+  buf = initRandomStream(&testStream);
+
+  // Both readers must agree on every value
+  while(refIndx + 8 < BENCH_BUF_SIZE)
+  {
+	  refReadBits(buf, &refIndx, &refBitPointer, n, &ref_val);
+	  err = readBits(&testStream, n, &bits_val);
+	  ck_assert_msg(err == EXIP_OK, "readBits returns error code %d", err);
+	  ck_assert_msg(bits_val == ref_val, "readBits(%u) returns %u instead of %u", n, bits_val, ref_val);
+	  ck_assert(testStream.context.bufferIndx == refIndx && testStream.context.bitPointer == refBitPointer);
+	  n = n % 32 + 1;
+  }
+
+  // Unsigned integers decoded over the window must match the byte-wise decoding
+  testStream.context.bufferIndx = 0;
+  testStream.context.bitPointer = 3;
+  refIndx = 0;
+  refBitPointer = 3;
+  while(refIndx + 16 < BENCH_BUF_SIZE)
+  {
+	  ref_uint = 0;
+	  shift = 0;
+	  do
+	  {
+		  refReadBits(buf, &refIndx, &refBitPointer, 8, &ref_val);
+		  if(shift < 64)
+			  ref_uint += ((UnsignedInteger) (ref_val & 0x7F)) << shift;
+		  shift += 7;
+	  }
+	  while(ref_val & 0x80);
+
+	  err = decodeUnsignedInteger(&testStream, &uint_val);
+	  ck_assert_msg(err == EXIP_OK, "decodeUnsignedInteger returns error code %d", err);
+	  ck_assert(uint_val == ref_uint);
+	  ck_assert(testStream.context.bufferIndx == refIndx && testStream.context.bitPointer == refBitPointer);
+  }
+
+  free(buf);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+START_TEST (bench_readBits)
+{
+  EXIStream testStream;
+  unsigned char* buf;
+  Index refIndx = 0;
+  unsigned char refBitPointer = 0;
+  unsigned int bits_val = 0;
+  unsigned int ref_val = 0;
+  unsigned char n = 1;
+  clock_t start;
+  double refTime, winTime;
+
+  buf = initRandomStream(&testStream);
+
+  // Byte-wise reference vs. 64 bit window
+  start = clock();
+  while(refIndx + 8 < BENCH_BUF_SIZE)
+  {
+	  refReadBits(buf, &refIndx, &refBitPointer, n, &ref_val);
+	  n = n % 32 + 1;
+  }
+  refTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  n = 1;
+  start = clock();
+  while(testStream.context.bufferIndx + 8 < BENCH_BUF_SIZE)
+  {
+	  readBits(&testStream, n, &bits_val);
+	  n = n % 32 + 1;
+  }
+  winTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  printf("readBits benchmark (%d bytes): byte-wise %.4fs, 64 bit window %.4fs\n", BENCH_BUF_SIZE, refTime, winTime);
+
+  free(buf);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
 /* END: streamRead tests */
 
 /* BEGIN: streamWrite tests */
@@ -240,6 +410,76 @@ START_TEST (test_writeNBits)
 }
 END_TEST
 
+#define WRITE_TEST_BUF_SIZE 4096
+
+/* Reference byte-at-a-time bit writer (the implementation writeNBits replaced) */
+static void refWriteNBits(unsigned char* buf, Index* bufferIndx, unsigned char* bitPointer, unsigned char nbits, unsigned int bits_val)
+{
+	unsigned int numBitsWrite = 0;
+	unsigned char tmp;
+	int bits_in_byte;
+
+	while(numBitsWrite < nbits)
+	{
+		if((unsigned int)(nbits - numBitsWrite) <= (unsigned int)(8 - *bitPointer))
+			bits_in_byte = nbits - numBitsWrite;
+		else
+			bits_in_byte = 8 - *bitPointer;
+
+		tmp = (bits_val >> (nbits - numBitsWrite - bits_in_byte)) & BIT_MASK[bits_in_byte];
+		tmp = tmp << (8 - *bitPointer - bits_in_byte);
+		buf[*bufferIndx] = (buf[*bufferIndx] & (~BIT_MASK[8 - *bitPointer])) | tmp;
+
+		numBitsWrite += bits_in_byte;
+		*bitPointer += bits_in_byte;
+		if(*bitPointer == 8)
+		{
+			*bitPointer = 0;
+			(*bufferIndx)++;
+		}
+	}
+}
+
+START_TEST (test_writeNBitsReference)
+{
+  EXIStream testStream;
+  unsigned char refBuf[WRITE_TEST_BUF_SIZE];
+  unsigned char buf[WRITE_TEST_BUF_SIZE];
+  Index refIndx = 0;
+  unsigned char refBitPointer = 0;
+  unsigned char nbits;
+  unsigned int val;
+  errorCode err = EXIP_UNEXPECTED_ERROR;
+
+  // Both buffers start with the same garbage to check that untouched bytes are preserved
+  srand(7);
+  for(refIndx = 0; refIndx < WRITE_TEST_BUF_SIZE; refIndx++)
+	  refBuf[refIndx] = buf[refIndx] = (unsigned char) rand();
+  refIndx = 0;
+
+  testStream.buffer.buf = (char*) buf;
+  testStream.buffer.bufLen = WRITE_TEST_BUF_SIZE;
+  testStream.buffer.bufContent = 0;
+  testStream.buffer.ioStrm.readWriteToStream = NULL;
+  testStream.buffer.ioStrm.stream = NULL;
+  testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+  testStream.context.bufferIndx = 0;
+  testStream.context.bitPointer = 0;
+
+  while(refIndx + 16 < WRITE_TEST_BUF_SIZE)
+  {
+	  nbits = (unsigned char) (rand() % 33);
+	  val = ((unsigned int) rand() << 16) ^ (unsigned int) rand();
+
+	  refWriteNBits(refBuf, &refIndx, &refBitPointer, nbits, val);
+	  err = writeNBits(&testStream, nbits, val);
+	  ck_assert_msg(err == EXIP_OK, "writeNBits returns error code %d", err);
+	  ck_assert(testStream.context.bufferIndx == refIndx && testStream.context.bitPointer == refBitPointer);
+	  ck_assert_msg(memcmp(buf, refBuf, WRITE_TEST_BUF_SIZE) == 0, "writeNBits(%u) output differs from the reference", nbits);
+  }
+}
+END_TEST
+
 /* END: streamWrite tests */
 
 /* BEGIN: streamDecode tests */
@@ -254,6 +494,7 @@ START_TEST (test_decodeNBitUnsignedInteger)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char) 0xD4; /* 0b11010100 */
   buf[1] = (char) 0x60; /* 0b01100000 */
@@ -287,6 +528,7 @@ START_TEST (test_decodeBoolean)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char) 0xD4; /* 0b11010100 */
   buf[1] = (char) 0x60; /* 0b01100000 */
@@ -319,6 +561,7 @@ START_TEST (test_decodeUnsignedInteger)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char) 0xD4; /* 0b11010100 */
   buf[1] = (char) 0x60; /* 0b01100000 */
@@ -357,6 +600,7 @@ START_TEST (test_decodeString)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char) 0x02; /* 0b00000010 */
   buf[1] = (char) 0x65; /* 0b01100101 */ // e - ASCII
@@ -402,6 +646,7 @@ START_TEST (test_decodeBinary)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char)  0x05; /* 0b00000101 */		//5
   buf[1] = (char)  0xF0; /* 0b11110000 */
@@ -493,6 +738,7 @@ START_TEST (test_decodeFloat)
 	double actual_res = 0;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
 
 	fl_val.exponent = 0;
 	fl_val.mantissa = 0;
@@ -546,6 +792,7 @@ START_TEST (test_decodeIntegerValue)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setDecodePrimitives(&testStream);
 
   buf[0] = (char) 0x94; /* 0b10010100 */
   buf[1] = (char) 0x60; /* 0b01100000 */
@@ -603,6 +850,7 @@ START_TEST (test_decodeDecimalValue)
 	res.exponent = -3;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
 
 	buf[0] = (char) 0x02; /* 0b00000010 */
 	buf[1] = (char) 0xB2; /* 0b10110010 */
@@ -643,6 +891,7 @@ START_TEST (test_encodeNBitUnsignedInteger)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setEncodePrimitives(&testStream);
 
   buf[0] = (char) 0xCE; /* 0b11001110 */
   buf[1] = (char) 0xE0; /* 0b11100000 */
@@ -679,6 +928,7 @@ START_TEST (test_encodeBoolean)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setEncodePrimitives(&testStream);
 
   buf[0] = (char) 0x54; /* 0b01010100 */
   buf[1] = (char) 0x60; /* 0b01100000 */
@@ -724,6 +974,7 @@ START_TEST (test_encodeUnsignedInteger)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setEncodePrimitives(&testStream);
 
   buf[0] = (char) 0xD4; /* 0b11010100 */
   buf[1] = (char) 0x00;	/* 0b00000000 */
@@ -786,6 +1037,7 @@ START_TEST (test_encodeString)
 
   testStream.context.bitPointer = 0;
   makeDefaultOpts(&testStream.header.opts);
+  setEncodePrimitives(&testStream);
 
   buf[0] = (char) 0x02; /* 0b00000010 */
   buf[1] = (char) 0x65; /* 0b01100101 */
@@ -827,6 +1079,7 @@ START_TEST (test_encodeBinary)
 	errorCode err = EXIP_UNEXPECTED_ERROR;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setEncodePrimitives(&testStream);
 
 	bin_data[0] = (char) 0x22; /* 0b00100010 */
 	bin_data[1] = (char) 0x65; /* 0b01100101 */
@@ -874,6 +1127,8 @@ START_TEST (test_encodeFloatValue)
 	test_val.exponent = 2;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
+	setEncodePrimitives(&testStream);
 
 	testStream.buffer.buf = buf;
 	testStream.buffer.bufLen = 10;
@@ -916,6 +1171,8 @@ START_TEST (test_encodeIntegerValue)
 	Integer test_dec = 0;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
+	setEncodePrimitives(&testStream);
 
 	testStream.buffer.buf = buf;
 	testStream.buffer.bufLen = 5;
@@ -961,6 +1218,8 @@ START_TEST (test_encodeDecimalValue)
 	res.exponent = -3;
 
 	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
+	setEncodePrimitives(&testStream);
 
 	testStream.buffer.buf = buf;
 	testStream.buffer.bufLen = 30;
@@ -992,6 +1251,542 @@ START_TEST (test_encodeDecimalValue)
 }
 END_TEST
 
+/* Byte-aligned mode: every primitive starts at a byte boundary
+ * and n-bit unsigned integers take whole bytes in little-endian order */
+START_TEST (test_byteAlignedPrimitives)
+{
+	EXIStream testStream;
+	unsigned char buf[50];
+	const unsigned char expected[] = {0x9C, 0x01, 0x01, 0xA5, 0x03, 0x00, 0x03, 0xFF, 0x00, 0x7F, 0x02, 'a', 'b'};
+	unsigned char bin_data[3] = {0xFF, 0x00, 0x7F};
+	unsigned int nbit_val = 0;
+	boolean bool_val = FALSE;
+	UnsignedInteger uint_val = 0;
+	char* bin_val = NULL;
+	Index nbytes = 0;
+	String testStr;
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+
+	makeDefaultOpts(&testStream.header.opts);
+	SET_ALIGNMENT(testStream.header.opts.enumOpt, BYTE_ALIGNMENT);
+	setDecodePrimitives(&testStream);
+	setEncodePrimitives(&testStream);
+	initAllocList(&testStream.memList);
+	testStream.buffer.buf = (char*) buf;
+	testStream.buffer.bufLen = 50;
+	testStream.buffer.bufContent = 0;
+	testStream.buffer.ioStrm.readWriteToStream = NULL;
+	testStream.buffer.ioStrm.stream = NULL;
+	testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+	testStream.context.bufferIndx = 0;
+	testStream.context.bitPointer = 0;
+	asciiToStringManaged("ab", &testStr, &testStream.memList, FALSE);
+
+	err = encodeNBitUnsignedInteger(&testStream, 9, 412);
+	err += encodeBoolean(&testStream, TRUE);
+	err += encodeUnsignedInteger(&testStream, 421);
+	err += encodeUnsignedInteger(&testStream, 0);
+	err += encodeBinary(&testStream, (char*) bin_data, 3);
+	err += encodeString(&testStream, &testStr);
+	ck_assert_msg (err == EXIP_OK, "Byte-aligned encoding returns error code %d", err);
+	ck_assert_msg (testStream.context.bitPointer == 0 && testStream.context.bufferIndx == sizeof(expected),
+			"Byte-aligned encoding did not move the stream pointers correctly");
+	ck_assert_msg (memcmp(buf, expected, sizeof(expected)) == 0, "Byte-aligned encoding is incorrect");
+
+	testStream.buffer.bufContent = testStream.context.bufferIndx;
+	testStream.context.bufferIndx = 0;
+
+	err = decodeNBitUnsignedInteger(&testStream, 9, &nbit_val);
+	err += decodeBoolean(&testStream, &bool_val);
+	ck_assert_msg (err == EXIP_OK && nbit_val == 412 && bool_val == TRUE, "Byte-aligned n-bit decoding is incorrect");
+	err = decodeUnsignedInteger(&testStream, &uint_val);
+	ck_assert_msg (err == EXIP_OK && uint_val == 421, "Byte-aligned unsigned integer decoding is incorrect");
+	err = decodeUnsignedInteger(&testStream, &uint_val);
+	ck_assert_msg (err == EXIP_OK && uint_val == 0, "Byte-aligned unsigned integer decoding is incorrect");
+	err = decodeBinary(&testStream, &bin_val, &nbytes);
+	ck_assert_msg (err == EXIP_OK && nbytes == 3 && memcmp(bin_val, bin_data, 3) == 0, "Byte-aligned binary decoding is incorrect");
+	EXIP_MFREE(bin_val);
+	err = decodeString(&testStream, &testStr);
+	ck_assert_msg (err == EXIP_OK && testStr.length == 2 && testStr.str[0] == 'a' && testStr.str[1] == 'b',
+			"Byte-aligned string decoding is incorrect");
+	ck_assert_msg (testStream.context.bufferIndx == sizeof(expected), "Byte-aligned decoding did not consume the whole stream");
+
+	freeAllocList(&testStream.memList);
+}
+END_TEST
+
+#if !STRING_UTF8_USE
+/* The ASCII runs of a string are copied in bulk: the result must match
+ * the one character at a time encoding in both alignment modes */
+START_TEST (test_asciiStringRuns)
+{
+	EXIStream testStream;
+	unsigned char buf[200];
+	unsigned char refBuf[200];
+	CharType chars[70];
+	CharType decoded[70];
+	String testStr;
+	String decodedStr;
+	Index i;
+	Index refIndx;
+	unsigned int nbit_val = 0;
+	UnsignedInteger len_val = 0;
+	int mode;
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+
+	for(i = 0; i < 70; i++)
+		chars[i] = (CharType) ('a' + i % 26);
+	chars[21] = (CharType) 0xE9;
+	chars[22] = (CharType) 0xC4;
+	chars[50] = (CharType) 0xF1;
+	testStr.str = chars;
+	testStr.length = 70;
+
+	ck_assert_msg (asciiRunLength((unsigned char*) chars, 70) == 21, "asciiRunLength stops at the wrong position");
+	ck_assert_msg (asciiRunLength((unsigned char*) chars + 23, 47) == 27, "asciiRunLength stops at the wrong position");
+	ck_assert_msg (asciiRunLength((unsigned char*) chars + 51, 19) == 19, "asciiRunLength stops at the wrong position");
+
+	for(mode = 0; mode < 2; mode++)
+	{
+		makeDefaultOpts(&testStream.header.opts);
+		if(mode == 1)
+			SET_ALIGNMENT(testStream.header.opts.enumOpt, BYTE_ALIGNMENT);
+		setDecodePrimitives(&testStream);
+		setEncodePrimitives(&testStream);
+		testStream.buffer.ioStrm.readWriteToStream = NULL;
+		testStream.buffer.ioStrm.stream = NULL;
+		testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+		testStream.buffer.bufLen = 200;
+		testStream.buffer.bufContent = 0;
+
+		// Reference: one unsigned integer per character, starting at a 3 bit offset in bit-packed mode
+		memset(refBuf, 0xAA, sizeof(refBuf));
+		testStream.buffer.buf = (char*) refBuf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = encodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, 5);
+		err += encodeUnsignedInteger(&testStream, 70);
+		for(i = 0; i < 70; i++)
+			err += encodeUnsignedInteger(&testStream, (UnsignedInteger) (uint32_t) chars[i]);
+		ck_assert_msg (err == EXIP_OK, "Character encoding returns error code %d", err);
+		refIndx = testStream.context.bufferIndx;
+
+		memset(buf, 0x55, sizeof(buf));
+		testStream.buffer.buf = (char*) buf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = encodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, 5);
+		err += encodeString(&testStream, &testStr);
+		ck_assert_msg (err == EXIP_OK, "encodeString returns error code %d", err);
+		ck_assert_msg (testStream.context.bufferIndx == refIndx, "encodeString did not move the stream pointers correctly");
+		ck_assert_msg (memcmp(buf, refBuf, refIndx) == 0 &&
+				(testStream.context.bitPointer == 0 || (buf[refIndx] & (0xFF << (8 - testStream.context.bitPointer))) == (refBuf[refIndx] & (0xFF << (8 - testStream.context.bitPointer)))),
+				"encodeString differs from the character encoding in mode %d", mode);
+
+		testStream.buffer.bufContent = refIndx + 1;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		initAllocList(&testStream.memList);
+		decodedStr.str = decoded;
+		decodedStr.length = 0;
+		err = decodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, &nbit_val);
+		err += decodeUnsignedInteger(&testStream, &len_val);
+		ck_assert_msg (err == EXIP_OK && nbit_val == 5 && len_val == 70, "The string length is decoded wrong");
+		err = decodeStringOnly(&testStream, 70, &decodedStr);
+		ck_assert_msg (err == EXIP_OK && decodedStr.length == 70 && memcmp(decoded, chars, sizeof(chars)) == 0,
+				"decodeStringOnly is incorrect in mode %d", mode);
+		freeAllocList(&testStream.memList);
+	}
+}
+END_TEST
+#endif /* !STRING_UTF8_USE */
+
+/* Binary values at every bit offset: the bulk copy and shift-merge of the
+ * octets must match the octet at a time encoding, also across buffer refills */
+START_TEST (test_bulkOctets)
+{
+	EXIStream testStream;
+	unsigned char data[300];
+	unsigned char buf[400];
+	unsigned char refBuf[400];
+	char smallBuf[16];
+	char* bin_val = NULL;
+	Index nbytes = 0;
+	Index refIndx;
+	unsigned int shift;
+	unsigned int nbit_val = 0;
+	struct memInput in;
+	Index i;
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+
+	for(i = 0; i < 300; i++)
+		data[i] = (unsigned char) (i*37 + 11);
+
+	makeDefaultOpts(&testStream.header.opts);
+	setDecodePrimitives(&testStream);
+	setEncodePrimitives(&testStream);
+	testStream.buffer.ioStrm.readWriteToStream = NULL;
+	testStream.buffer.ioStrm.stream = NULL;
+	testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+
+	for(shift = 0; shift < 8; shift++)
+	{
+		testStream.buffer.bufLen = 400;
+		testStream.buffer.bufContent = 0;
+
+		memset(refBuf, 0xAA, sizeof(refBuf));
+		testStream.buffer.buf = (char*) refBuf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = writeNBits(&testStream, 8, 0x5A);
+		err += writeNBits(&testStream, shift, 0x55);
+		err += encodeUnsignedInteger(&testStream, 300);
+		for(i = 0; i < 300; i++)
+			err += writeNBits(&testStream, 8, data[i]);
+		ck_assert_msg (err == EXIP_OK, "Octet encoding returns error code %d", err);
+		refIndx = testStream.context.bufferIndx;
+
+		memset(buf, 0x55, sizeof(buf));
+		testStream.buffer.buf = (char*) buf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = writeNBits(&testStream, 8, 0x5A);
+		err += writeNBits(&testStream, shift, 0x55);
+		err += encodeBinary(&testStream, (char*) data, 300);
+		ck_assert_msg (err == EXIP_OK, "encodeBinary returns error code %d", err);
+		ck_assert_msg (testStream.context.bufferIndx == refIndx && memcmp(buf, refBuf, refIndx) == 0 &&
+				(shift == 0 || buf[refIndx] == refBuf[refIndx]),
+				"encodeBinary differs from the octet encoding at bit offset %u", shift);
+
+		// Decode through a 16 byte buffer refilled from the encoded bytes
+		in.data = buf;
+		in.len = refIndx + 1;
+		in.pos = 0;
+		testStream.buffer.buf = smallBuf;
+		testStream.buffer.bufLen = sizeof(smallBuf);
+		testStream.buffer.ioStrm.readWriteToStream = readMemInput;
+		testStream.buffer.ioStrm.stream = &in;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = readBits(&testStream, 8, &nbit_val);
+		err += readBits(&testStream, shift, &nbit_val);
+		err += decodeBinary(&testStream, &bin_val, &nbytes);
+		ck_assert_msg (err == EXIP_OK && nbytes == 300 && memcmp(bin_val, data, 300) == 0,
+				"decodeBinary is incorrect at bit offset %u", shift);
+		EXIP_MFREE(bin_val);
+		testStream.buffer.ioStrm.readWriteToStream = NULL;
+		testStream.buffer.ioStrm.stream = NULL;
+	}
+}
+END_TEST
+
+#if STRING_UTF8_USE
+
+/* Characters of 1 to 4 UTF-8 bytes after an ASCII run longer than a vector block:
+ * one code point per character in the stream and the same bytes after decoding */
+START_TEST (test_utf8Strings)
+{
+	EXIStream testStream;
+	unsigned char buf[200];
+	unsigned char refBuf[200];
+	CharType decoded[200];
+	CharType small[3];
+	const char* text = "0123456789abcdefghij" "\xC3\xA9" "t\xC3\xA9" "\xE2\x82\xAC" "\xF0\x9F\x98\x80" "z";
+	const uint32_t codePoints[6] = {0xE9, 't', 0xE9, 0x20AC, 0x1F600, 'z'};
+	const char* invalid[] = {"\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "ab\xE2\x82", "\x80", "\xFF",
+			"xxxxx\xE0\x9F\xBFxxxxxxxxxxxxxxxx", "xxxxx\xED\xA0\x80xxxxxxxxxxxxxxxx"};
+	String testStr;
+	String decodedStr;
+	Index charCount = 0;
+	Index readerPosition;
+	Index writerPosition;
+	Index refIndx;
+	Index i;
+	UnsignedInteger len_val = 0;
+	unsigned int nbit_val = 0;
+	int mode;
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+
+	testStr.str = (CharType*) text;
+	testStr.length = strlen(text);
+	err = countStringChars(&testStr, &charCount);
+	ck_assert_msg (err == EXIP_OK && charCount == 26, "countStringChars returns %u characters, error code %d", (unsigned int) charCount, err);
+
+	readerPosition = 20;
+	for(i = 0; i < 6; i++)
+		ck_assert_msg (readCharFromString(&testStr, &readerPosition) == codePoints[i], "readCharFromString is incorrect at character %u", (unsigned int) i);
+	ck_assert (readerPosition == testStr.length);
+
+	for(i = 0; i < sizeof(invalid)/sizeof(invalid[0]); i++)
+	{
+		String badStr;
+		badStr.str = (CharType*) invalid[i];
+		badStr.length = strlen(invalid[i]);
+		ck_assert_msg (countStringChars(&badStr, &charCount) == EXIP_INVALID_STRING_OPERATION, "Invalid UTF-8 sequence %u is accepted", (unsigned int) i);
+	}
+
+	// Mixed 2 and 3 byte characters (with the E0 and ED lead bytes) at every block offset:
+	// any byte replaced by an ASCII or a continuation byte makes the text invalid
+	for(i = 0; i < 4; i++)
+	{
+		unsigned char mixed[64];
+		Index n = 0;
+		Index p;
+
+		memset(mixed, 'x', i);
+		n = i;
+		while(n + 8 <= sizeof(mixed))
+		{
+			memcpy(mixed + n, "\xD0\xB4\xE0\xA4\x95\xED\x9F\xBF", 8);
+			n += 8;
+		}
+		testStr.str = (CharType*) mixed;
+		testStr.length = n;
+		err = countStringChars(&testStr, &charCount);
+		ck_assert_msg (err == EXIP_OK && charCount == i + 3*(n - i)/8, "countStringChars is incorrect at offset %u", (unsigned int) i);
+
+		for(p = i; p < n; p++)
+		{
+			unsigned char orig = mixed[p];
+			mixed[p] = (orig & 0xC0) == 0x80 ? 'a' : 0x80;
+			ck_assert_msg (countStringChars(&testStr, &charCount) == EXIP_INVALID_STRING_OPERATION,
+					"Invalid byte at position %u is accepted", (unsigned int) p);
+			mixed[p] = orig;
+		}
+	}
+	testStr.str = (CharType*) text;
+	testStr.length = strlen(text);
+
+	decodedStr.str = small;
+	decodedStr.length = 3;
+	writerPosition = 0;
+	ck_assert (writeCharToString(&decodedStr, 0xD800, &writerPosition) == EXIP_INVALID_STRING_OPERATION);
+	ck_assert (writeCharToString(&decodedStr, 0x110000, &writerPosition) == EXIP_INVALID_STRING_OPERATION);
+	ck_assert (writeCharToString(&decodedStr, 0x1F600, &writerPosition) == EXIP_OUT_OF_BOUND_BUFFER);
+	ck_assert (writeCharToString(&decodedStr, 0x20AC, &writerPosition) == EXIP_OK && writerPosition == 3);
+
+	for(mode = 0; mode < 2; mode++)
+	{
+		makeDefaultOpts(&testStream.header.opts);
+		if(mode == 1)
+			SET_ALIGNMENT(testStream.header.opts.enumOpt, BYTE_ALIGNMENT);
+		setDecodePrimitives(&testStream);
+		setEncodePrimitives(&testStream);
+		testStream.buffer.ioStrm.readWriteToStream = NULL;
+		testStream.buffer.ioStrm.stream = NULL;
+		testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+		testStream.buffer.bufLen = 200;
+		testStream.buffer.bufContent = 0;
+
+		// Reference: the character count and one unsigned integer per code point
+		memset(refBuf, 0xAA, sizeof(refBuf));
+		testStream.buffer.buf = (char*) refBuf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = encodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, 5);
+		err += encodeUnsignedInteger(&testStream, 26);
+		for(i = 0; i < 20; i++)
+			err += encodeUnsignedInteger(&testStream, (UnsignedInteger) text[i]);
+		for(i = 0; i < 6; i++)
+			err += encodeUnsignedInteger(&testStream, (UnsignedInteger) codePoints[i]);
+		ck_assert_msg (err == EXIP_OK, "Character encoding returns error code %d", err);
+		refIndx = testStream.context.bufferIndx;
+
+		memset(buf, 0x55, sizeof(buf));
+		testStream.buffer.buf = (char*) buf;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		err = encodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, 5);
+		err += encodeString(&testStream, &testStr);
+		ck_assert_msg (err == EXIP_OK, "encodeString returns error code %d", err);
+		ck_assert_msg (testStream.context.bufferIndx == refIndx, "encodeString did not move the stream pointers correctly");
+		ck_assert_msg (memcmp(buf, refBuf, refIndx) == 0 &&
+				(testStream.context.bitPointer == 0 || (buf[refIndx] & (0xFF << (8 - testStream.context.bitPointer))) == (refBuf[refIndx] & (0xFF << (8 - testStream.context.bitPointer)))),
+				"encodeString differs from the code point encoding in mode %d", mode);
+
+		testStream.buffer.bufContent = refIndx + 1;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 0;
+		decodedStr.str = decoded;
+		decodedStr.length = 0;
+		err = decodeNBitUnsignedInteger(&testStream, mode == 0 ? 3 : 8, &nbit_val);
+		err += decodeUnsignedInteger(&testStream, &len_val);
+		ck_assert_msg (err == EXIP_OK && nbit_val == 5 && len_val == 26, "The string length is decoded wrong");
+		err = decodeStringOnly(&testStream, 26, &decodedStr);
+		ck_assert_msg (err == EXIP_OK && decodedStr.length == testStr.length && memcmp(decoded, text, testStr.length) == 0,
+				"decodeStringOnly is incorrect in mode %d", mode);
+	}
+
+	testStr.str = (CharType*) invalid[2];
+	testStr.length = strlen(invalid[2]);
+	testStream.buffer.buf = (char*) buf;
+	testStream.context.bufferIndx = 0;
+	testStream.context.bitPointer = 0;
+	ck_assert_msg (encodeString(&testStream, &testStr) == EXIP_INVALID_STRING_OPERATION, "encodeString accepts invalid UTF-8");
+}
+END_TEST
+
+#define UTF8_BENCH_SIZE (64*1024)
+#define UTF8_BENCH_ROUNDS 50
+
+/* Text in different scripts: 1 byte (Latin), 2 bytes (Cyrillic, Greek, Arabic),
+ * 3 bytes (Devanagari, CJK) and 4 bytes (emoji) UTF-8 sequences */
+static const char* utf8Corpora[][2] = {
+	{"English", "The quick brown fox jumps over the lazy dog. "},
+	{"German", "Falsches Üben von Xylophonmusik quält jeden größeren Zwerg. "},
+	{"Russian", "Съешь же ещё этих мягких французских булок, да выпей чаю. "},
+	{"Greek", "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. "},
+	{"Arabic", "نص حكيم له سر قاطع وذو شأن عظيم مكتوب على ثوب أخضر. "},
+	{"Hindi", "ऋषियों को सताने वाले दुष्ट राक्षसों के राजा रावण का सर्वनाश करने वाले। "},
+	{"Chinese", "我能吞下玻璃而不伤身体。"},
+	{"Japanese", "いろはにほへと ちりぬるを わかよたれそ つねならむ。"},
+	{"Emoji", "Launch \xF0\x9F\x9A\x80 done \xE2\x9C\x85 coffee \xE2\x98\x95 \xF0\x9F\x98\x80 "}
+};
+
+/* Fills text with the sentence of the corpus c repeated up to UTF8_BENCH_SIZE bytes
+ * and prepares a bit-packed stream over buf for its encoding */
+static void initUtf8Corpus(unsigned int c, char* text, String* testStr, EXIStream* testStream, unsigned char* buf)
+{
+	Index sentenceLen = strlen(utf8Corpora[c][1]);
+
+	testStr->str = text;
+	testStr->length = 0;
+	while(testStr->length + sentenceLen <= UTF8_BENCH_SIZE)
+	{
+		memcpy(text + testStr->length, utf8Corpora[c][1], sentenceLen);
+		testStr->length += sentenceLen;
+	}
+
+	makeDefaultOpts(&testStream->header.opts);
+	setDecodePrimitives(testStream);
+	setEncodePrimitives(testStream);
+	testStream->buffer.buf = (char*) buf;
+	testStream->buffer.bufLen = 2*UTF8_BENCH_SIZE + 16;
+	testStream->buffer.ioStrm.readWriteToStream = NULL;
+	testStream->buffer.ioStrm.stream = NULL;
+	testStream->buffer.bufStrm = EMPTY_BUFFER_STREAM;
+}
+
+/* Validation with character counting, encoding and decoding of
+ * multilingual string values in bit-packed mode */
+START_TEST (test_utf8Corpora)
+{
+	EXIStream testStream;
+	char* text;
+	unsigned char* buf;
+	CharType* decoded;
+	String testStr;
+	String decodedStr;
+	Index charCount = 0;
+	UnsignedInteger len_val = 0;
+	unsigned int c;
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+
+	text = (char*) malloc(UTF8_BENCH_SIZE);
+	buf = (unsigned char*) malloc(2*UTF8_BENCH_SIZE + 16);
+	decoded = (CharType*) malloc(UCS_CHAR_MAX_UNITS*UTF8_BENCH_SIZE);
+	ck_assert(text != NULL && buf != NULL && decoded != NULL);
+
+	for(c = 0; c < sizeof(utf8Corpora)/sizeof(utf8Corpora[0]); c++)
+	{
+		initUtf8Corpus(c, text, &testStr, &testStream, buf);
+
+		err = countStringChars(&testStr, &charCount);
+		ck_assert_msg (err == EXIP_OK, "countStringChars returns error code %d for %s", err, utf8Corpora[c][0]);
+
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 3;
+		err = encodeString(&testStream, &testStr);
+		ck_assert_msg (err == EXIP_OK, "encodeString returns error code %d for %s", err, utf8Corpora[c][0]);
+
+		testStream.buffer.bufContent = testStream.context.bufferIndx + 1;
+		testStream.context.bufferIndx = 0;
+		testStream.context.bitPointer = 3;
+		decodedStr.str = decoded;
+		err = decodeUnsignedInteger(&testStream, &len_val);
+		err += decodeStringOnly(&testStream, (Index) len_val, &decodedStr);
+		ck_assert_msg (err == EXIP_OK && len_val == charCount && decodedStr.length == testStr.length &&
+				memcmp(decoded, text, testStr.length) == 0, "The %s text is decoded wrong", utf8Corpora[c][0]);
+	}
+
+	free(text);
+	free(buf);
+	free(decoded);
+}
+END_TEST
+
+#ifdef EXIP_BENCH
+
+/* Throughput of the character counting, encoding and decoding of the corpora */
+START_TEST (bench_utf8)
+{
+	EXIStream testStream;
+	char* text;
+	unsigned char* buf;
+	CharType* decoded;
+	String testStr;
+	String decodedStr;
+	Index charCount = 0;
+	Index encodedLen;
+	UnsignedInteger len_val = 0;
+	unsigned int c;
+	unsigned int r;
+	clock_t start;
+	double countTime, encTime, decTime;
+
+	text = (char*) malloc(UTF8_BENCH_SIZE);
+	buf = (unsigned char*) malloc(2*UTF8_BENCH_SIZE + 16);
+	decoded = (CharType*) malloc(UCS_CHAR_MAX_UNITS*UTF8_BENCH_SIZE);
+	ck_assert(text != NULL && buf != NULL && decoded != NULL);
+
+	for(c = 0; c < sizeof(utf8Corpora)/sizeof(utf8Corpora[0]); c++)
+	{
+		initUtf8Corpus(c, text, &testStr, &testStream, buf);
+
+		start = clock();
+		for(r = 0; r < UTF8_BENCH_ROUNDS; r++)
+			countStringChars(&testStr, &charCount);
+		countTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for(r = 0; r < UTF8_BENCH_ROUNDS; r++)
+		{
+			testStream.context.bufferIndx = 0;
+			testStream.context.bitPointer = 3;
+			encodeString(&testStream, &testStr);
+		}
+		encTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+		encodedLen = testStream.context.bufferIndx + 1;
+
+		testStream.buffer.bufContent = encodedLen;
+		start = clock();
+		for(r = 0; r < UTF8_BENCH_ROUNDS; r++)
+		{
+			testStream.context.bufferIndx = 0;
+			testStream.context.bitPointer = 3;
+			decodedStr.str = decoded;
+			decodeUnsignedInteger(&testStream, &len_val);
+			decodeStringOnly(&testStream, (Index) len_val, &decodedStr);
+		}
+		decTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("UTF-8 benchmark %-8s (%u bytes, %u chars, %u encoded): count %.1f MB/s, encode %.1f MB/s, decode %.1f MB/s\n",
+				utf8Corpora[c][0], (unsigned int) testStr.length, (unsigned int) charCount, (unsigned int) encodedLen,
+				countTime > 0 ? UTF8_BENCH_ROUNDS*testStr.length/countTime/1e6 : 0.0,
+				encTime > 0 ? UTF8_BENCH_ROUNDS*testStr.length/encTime/1e6 : 0.0,
+				decTime > 0 ? UTF8_BENCH_ROUNDS*testStr.length/decTime/1e6 : 0.0);
+	}
+
+	free(text);
+	free(buf);
+	free(decoded);
+}
+END_TEST
+
+#endif /* EXIP_BENCH */
+
+#endif /* STRING_UTF8_USE */
+
 /* END: streamEncode tests */
 
 
@@ -1044,6 +1839,90 @@ END_TEST
 
 /* END: ioUtil tests */
 
+/* START: DEFLATE tests */
+
+#if COMPRESSION_USE
+
+/* Compresses and decompresses data with different redundancy:
+ * stored, fixed and dynamic Huffman blocks and long matches */
+START_TEST (test_deflateRoundTrip)
+{
+	const Index sizes[] = {0, 1, 5, 300, 70000, 300000};
+	const int kinds = 4;
+	unsigned char* data;
+	Index s;
+	int kind;
+
+	data = malloc(300000);
+	ck_assert(data != NULL);
+
+	for(kind = 0; kind < kinds; kind++)
+	{
+		Index i;
+		unsigned int rnd = 12345;
+
+		for(i = 0; i < 300000; i++)
+		{
+			rnd = rnd*1103515245 + 12345;
+			if(kind == 0) // incompressible
+				data[i] = (unsigned char) (rnd >> 16);
+			else if(kind == 1) // long runs
+				data[i] = (unsigned char) ('a' + (i/1000) % 3);
+			else if(kind == 2) // text like
+				data[i] = (unsigned char) ("<element attr=\"value\">text</element>\n"[i % 39] ^ ((rnd >> 28) == 0));
+			else // small alphabet
+				data[i] = (unsigned char) ('0' + ((rnd >> 16) % 10));
+		}
+
+		for(s = 0; s < sizeof(sizes)/sizeof(Index); s++)
+		{
+			BinaryBuffer compressed = {NULL, 0, 0, {NULL, NULL}, EMPTY_BUFFER_STREAM};
+			BinaryBuffer out = {NULL, 0, 0, {NULL, NULL}, EMPTY_BUFFER_STREAM};
+			struct memInput in;
+			EXIStream testStream;
+			char buf[64];
+			errorCode err;
+
+			err = deflateData(data, sizes[s], &compressed);
+			ck_assert_msg(err == EXIP_OK, "deflateData returns error code %d", err);
+			if(kind != 0 && sizes[s] >= 70000)
+				ck_assert_msg(compressed.bufContent < sizes[s]/2, "Poor compression: %u -> %u",
+						(unsigned int) sizes[s], (unsigned int) compressed.bufContent);
+
+			// Inflate through a small buffer that is refilled from the input stream
+			in.data = (unsigned char*) compressed.buf;
+			in.len = compressed.bufContent;
+			in.pos = 0;
+			testStream.buffer.buf = buf;
+			testStream.buffer.bufLen = sizeof(buf);
+			testStream.buffer.bufContent = 0;
+			testStream.buffer.ioStrm.readWriteToStream = readMemInput;
+			testStream.buffer.ioStrm.stream = &in;
+			testStream.buffer.bufStrm = EMPTY_BUFFER_STREAM;
+			testStream.context.bufferIndx = 0;
+			testStream.context.bitPointer = 0;
+
+			err = inflateData(&testStream, &out);
+			ck_assert_msg(err == EXIP_OK, "inflateData returns error code %d", err);
+			ck_assert_msg(out.bufContent == sizes[s], "Inflated %u bytes instead of %u",
+					(unsigned int) out.bufContent, (unsigned int) sizes[s]);
+			ck_assert_msg(sizes[s] == 0 || memcmp(out.buf, data, sizes[s]) == 0, "Inflated data differs");
+			ck_assert_msg(in.pos - testStream.buffer.bufContent + testStream.context.bufferIndx == compressed.bufContent,
+					"The stream is not positioned after the DEFLATE data");
+
+			free(compressed.buf);
+			free(out.buf);
+		}
+	}
+
+	free(data);
+}
+END_TEST
+
+#endif /* COMPRESSION_USE */
+
+/* END: DEFLATE tests */
+
 
 
 Suite * streamIO_suite (void)
@@ -1055,6 +1934,7 @@ Suite * streamIO_suite (void)
 	  TCase *tc_sRead = tcase_create ("StreamRead");
 	  tcase_add_test (tc_sRead, test_readNextBit);
 	  tcase_add_test (tc_sRead, test_readBits);
+	  tcase_add_test (tc_sRead, test_readBitsWindow);
 	  suite_add_tcase (s, tc_sRead);
   }
 
@@ -1063,6 +1943,7 @@ Suite * streamIO_suite (void)
 	  TCase *tc_sWrite = tcase_create ("StreamWrite");
 	  tcase_add_test (tc_sWrite, test_writeNextBit);
 	  tcase_add_test (tc_sWrite, test_writeNBits);
+	  tcase_add_test (tc_sWrite, test_writeNBitsReference);
 	  suite_add_tcase (s, tc_sWrite);
   }
 
@@ -1091,6 +1972,14 @@ Suite * streamIO_suite (void)
 	  tcase_add_test (tc_sEncode, test_encodeFloatValue);
 	  tcase_add_test (tc_sEncode, test_encodeIntegerValue);
 	  tcase_add_test (tc_sEncode, test_encodeDecimalValue);
+	  tcase_add_test (tc_sEncode, test_byteAlignedPrimitives);
+#if STRING_UTF8_USE
+	  tcase_add_test (tc_sEncode, test_utf8Strings);
+	  tcase_add_test (tc_sEncode, test_utf8Corpora);
+#else
+	  tcase_add_test (tc_sEncode, test_asciiStringRuns);
+#endif
+	  tcase_add_test (tc_sEncode, test_bulkOctets);
 	  suite_add_tcase (s, tc_sEncode);
   }
 
@@ -1102,6 +1991,25 @@ Suite * streamIO_suite (void)
 	  tcase_add_test (tc_ioUtil, test_log2INT);
 	  suite_add_tcase (s, tc_ioUtil);
   }
+#if COMPRESSION_USE
+  {
+	  /* DEFLATE test case */
+	  TCase *tc_deflate = tcase_create ("Deflate");
+	  tcase_add_test (tc_deflate, test_deflateRoundTrip);
+	  suite_add_tcase (s, tc_deflate);
+  }
+#endif
+#ifdef EXIP_BENCH
+  {
+	  /* Benchmark test case: only run by the bench_streamIO build */
+	  TCase *tc_bench = tcase_create ("Benchmark");
+	  tcase_add_test (tc_bench, bench_readBits);
+#if STRING_UTF8_USE
+	  tcase_add_test (tc_bench, bench_utf8);
+#endif
+	  suite_add_tcase (s, tc_bench);
+  }
+#endif
 
   return s;
 }
@@ -1114,7 +2022,11 @@ int main (void)
 #ifdef _MSC_VER
 	srunner_set_fork_status(sr, CK_NOFORK);
 #endif
+#ifdef EXIP_BENCH
+	srunner_run (sr, NULL, "Benchmark", CK_NORMAL);
+#else
 	srunner_run_all (sr, CK_NORMAL);
+#endif
 	number_failed = srunner_ntests_failed (sr);
 	srunner_free (sr);
 	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -16,12 +16,15 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 #include <check.h>
 #include "sTables.h"
 #include "stringManipulate.h"
 #include "memManagement.h"
 #include "dynamicArray.h"
 #include "grammars.h"
+#include "hashtable.h"
 
 /* BEGIN: table tests */
 
@@ -69,6 +72,10 @@ START_TEST (test_addUriEntry)
 	// Create the URI table
 	err = createDynArray(&uriTable.dynArray, sizeof(UriEntry), DEFAULT_URI_ENTRIES_NUMBER);
 	fail_if(err != EXIP_OK);
+#if STRING_TABLE_HASH_USE
+	uriTable.hashIndex.slots = NULL;
+	uriTable.hashIndex.size = 0;
+#endif
 
 	err = addUriEntry(&uriTable, test_uri, &entryId);
 
@@ -113,6 +120,10 @@ START_TEST (test_addLnEntry)
 
 	err = createDynArray(&lnTable.dynArray, sizeof(LnEntry), DEFAULT_LN_ENTRIES_NUMBER);
 	fail_if(err != EXIP_OK);
+#if STRING_TABLE_HASH_USE
+	lnTable.hashIndex.slots = NULL;
+	lnTable.hashIndex.size = 0;
+#endif
 
 	err = addLnEntry(&lnTable, test_ln, &entryId);
 
@@ -169,6 +180,10 @@ START_TEST (test_addValueEntry)
 		ck_assert_msg (testStrm.schema != NULL, "Memory alloc error");
 		/* Create and initialize initial string table entries */
 		tmp_err_code += createDynArray(&testStrm.schema->uriTable.dynArray, sizeof(UriEntry), DEFAULT_URI_ENTRIES_NUMBER);
+#if STRING_TABLE_HASH_USE
+		testStrm.schema->uriTable.hashIndex.slots = NULL;
+		testStrm.schema->uriTable.hashIndex.size = 0;
+#endif
 		tmp_err_code += createUriTableEntries(&testStrm.schema->uriTable, FALSE);
 	}
 	ck_assert_msg (tmp_err_code == EXIP_OK, "initStream returns an error code %d", tmp_err_code);
@@ -191,6 +206,235 @@ START_TEST (test_addValueEntry)
 }
 END_TEST
 
+#define LOOKUP_TEST_NAMES 1000
+
+/* The lookups find the same entries before and after the hash indexes are built
+ * and while they grow with the tables */
+START_TEST (test_lookupUriLn)
+{
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+	UriTable uriTable;
+	LnTable* lnTable;
+	char names[LOOKUP_TEST_NAMES][12];
+	String nameStr;
+	String missing = {"missing", 7};
+	SmallIndex uriId;
+	Index lnId;
+	Index i, j;
+
+	err = createDynArray(&uriTable.dynArray, sizeof(UriEntry), DEFAULT_URI_ENTRIES_NUMBER);
+	fail_if(err != EXIP_OK);
+#if STRING_TABLE_HASH_USE
+	uriTable.hashIndex.slots = NULL;
+	uriTable.hashIndex.size = 0;
+#endif
+	err = createUriTableEntries(&uriTable, TRUE);
+	ck_assert_msg (err == EXIP_OK, "createUriTableEntries returns error code %d", err);
+
+	// The 46 local names of the XML Schema namespace
+	ck_assert_msg (lookupUri(&uriTable, uriTable.uri[XML_SCHEMA_NAMESPACE_ID].uriStr, &uriId) && uriId == XML_SCHEMA_NAMESPACE_ID, "XML Schema namespace not found");
+	lnTable = &uriTable.uri[XML_SCHEMA_NAMESPACE_ID].lnTable;
+	for(i = 0; i < lnTable->count; i++)
+	{
+		ck_assert_msg (lookupLn(lnTable, lnTable->ln[i].lnStr, &lnId) && lnId == i, "Local name %u not found", (unsigned int) i);
+	}
+	ck_assert_msg (!lookupLn(lnTable, missing, &lnId), "Missing local name found");
+
+	for(i = 0; i < LOOKUP_TEST_NAMES; i++)
+	{
+		sprintf(names[i], "name%u", (unsigned int) i);
+		nameStr.str = names[i];
+		nameStr.length = strlen(names[i]);
+
+		// URIs and local names are added while the tables are searched
+		if(i < 100)
+		{
+			err = addUriEntry(&uriTable, nameStr, &uriId);
+			ck_assert_msg (err == EXIP_OK, "addUriEntry returns error code %d", err);
+			// The URI entries might have been moved
+			lnTable = &uriTable.uri[XML_SCHEMA_NAMESPACE_ID].lnTable;
+		}
+		err = addLnEntry(lnTable, nameStr, &lnId);
+		ck_assert_msg (err == EXIP_OK, "addLnEntry returns error code %d", err);
+
+		for(j = 0; j <= i; j += 7)
+		{
+			nameStr.str = names[j];
+			nameStr.length = strlen(names[j]);
+			ck_assert_msg (lookupLn(lnTable, nameStr, &lnId) && lnId == 46 + j, "Local name %s not found", names[j]);
+			if(j < 100)
+				ck_assert_msg (lookupUri(&uriTable, nameStr, &uriId) && uriId == 4 + j, "URI %s not found", names[j]);
+		}
+	}
+	ck_assert_msg (!lookupLn(lnTable, missing, &lnId), "Missing local name found");
+	ck_assert_msg (!lookupUri(&uriTable, missing, &uriId), "Missing URI found");
+
+#if STRING_TABLE_HASH_USE
+	ck_assert_msg (uriTable.hashIndex.slots != NULL && lnTable->hashIndex.slots != NULL, "The tables are not indexed");
+	destroyStringTableIndexes(&uriTable);
+#endif
+	for(i = 0; i < uriTable.count; i++)
+	{
+		if(uriTable.uri[i].pfxTable != NULL)
+			EXIP_MFREE(uriTable.uri[i].pfxTable);
+		destroyDynArray(&uriTable.uri[i].lnTable.dynArray);
+	}
+	destroyDynArray(&uriTable.dynArray);
+}
+END_TEST
+
+#if VALUE_CROSSTABLE_USE
+START_TEST (test_lookupVx)
+{
+	errorCode err = EXIP_UNEXPECTED_ERROR;
+	ValueTable valueTable;
+	VxTable vxTables[2];
+	char values[LOOKUP_TEST_NAMES][12];
+	String valueStr;
+	Index i, t, id, valueEntryId;
+	ValueEntry* valueEntry;
+	VxEntry vxEntry;
+	unsigned int useHash;
+
+	for(useHash = 0; useHash < 2; useHash++)
+	{
+		err = createValueTable(&valueTable);
+		fail_if(err != EXIP_OK);
+#if HASH_TABLE_USE
+		if(useHash)
+		{
+			valueTable.hashTbl = create_hashtable(INITIAL_HASH_TABLE_SIZE, stringHash, stringEqual);
+			fail_if(valueTable.hashTbl == NULL);
+		}
+#else
+		if(useHash)
+			break;
+#endif
+		for(t = 0; t < 2; t++)
+		{
+			err = createDynArray(&vxTables[t].dynArray, sizeof(VxEntry), DEFAULT_VX_ENTRIES_NUMBER);
+			fail_if(err != EXIP_OK);
+		}
+
+		// The values are distributed in two local partitions as addValueEntry() does
+		for(i = 0; i < LOOKUP_TEST_NAMES; i++)
+		{
+			valueStr.length = sprintf(values[i], "value%u", (unsigned int) i);
+			valueStr.str = values[i];
+			t = i % 2;
+
+			vxEntry.globalId = i;
+			err = addDynEntry(&vxTables[t].dynArray, &vxEntry, &id);
+			fail_if(err != EXIP_OK);
+			err = addEmptyDynEntry(&valueTable.dynArray, (void**)&valueEntry, &valueEntryId);
+			fail_if(err != EXIP_OK);
+			valueEntry->valueStr = valueStr;
+			valueEntry->locValuePartition.forQNameId.uriId = 0;
+			valueEntry->locValuePartition.forQNameId.lnId = t;
+			valueEntry->locValuePartition.vxEntryId = id;
+#if HASH_TABLE_USE
+			if(valueTable.hashTbl != NULL)
+			{
+				err = hashtable_insert(valueTable.hashTbl, valueStr, i);
+				fail_if(err != EXIP_OK);
+			}
+#endif
+		}
+
+		// Global ID 10 is overwritten after a wrap-around of the value table
+		vxTables[0].vx[5].globalId = INDEX_MAX;
+#if HASH_TABLE_USE
+		if(valueTable.hashTbl != NULL)
+			hashtable_remove(valueTable.hashTbl, valueTable.value[10].valueStr);
+#endif
+		valueTable.value[10].valueStr.str = "new value";
+		valueTable.value[10].valueStr.length = 9;
+
+		for(i = 0; i < LOOKUP_TEST_NAMES; i++)
+		{
+			valueStr.str = values[i];
+			valueStr.length = strlen(values[i]);
+			t = i % 2;
+
+			if(i == 10)
+				ck_assert_msg (!lookupVx(&valueTable, &vxTables[t], valueStr, &id), "Overwritten value found");
+			else
+				ck_assert_msg (lookupVx(&valueTable, &vxTables[t], valueStr, &id) && id == i/2, "Value %s not found in its local partition", values[i]);
+			ck_assert_msg (!lookupVx(&valueTable, &vxTables[1 - t], valueStr, &id), "Value %s found in another local partition", values[i]);
+		}
+
+		for(t = 0; t < 2; t++)
+			destroyDynArray(&vxTables[t].dynArray);
+#if HASH_TABLE_USE
+		if(valueTable.hashTbl != NULL)
+			hashtable_destroy(valueTable.hashTbl);
+#endif
+		destroyDynArray(&valueTable.dynArray);
+	}
+}
+END_TEST
+#endif
+
+#if HASH_TABLE_USE
+#define HASH_TEST_KEYS 40000
+
+START_TEST (test_valueHashTable)
+{
+	struct hashtable *h;
+	char* keys;
+	String keyStr;
+	String missing = {"missing", 7};
+	Index i;
+
+	// More keys than the old fixed limit of the table
+	keys = EXIP_MALLOC(HASH_TEST_KEYS*12);
+	fail_if(keys == NULL);
+	h = create_hashtable(16, stringHash, stringEqual);
+	fail_if(h == NULL);
+
+	for(i = 0; i < HASH_TEST_KEYS; i++)
+	{
+		keyStr.length = sprintf(keys + i*12, "value%u", (unsigned int) i);
+		keyStr.str = keys + i*12;
+		ck_assert_msg (hashtable_insert(h, keyStr, i) == EXIP_OK, "hashtable_insert fails for key %u", (unsigned int) i);
+	}
+	ck_assert_msg (hashtable_count(h) == HASH_TEST_KEYS, "Wrong number of entries: %u", hashtable_count(h));
+
+	// Remove every other key - the rest must stay reachable
+	for(i = 0; i < HASH_TEST_KEYS; i += 2)
+	{
+		keyStr.str = keys + i*12;
+		keyStr.length = strlen(keyStr.str);
+		ck_assert_msg (hashtable_remove(h, keyStr) == i, "hashtable_remove fails for key %u", (unsigned int) i);
+	}
+	ck_assert_msg (hashtable_count(h) == HASH_TEST_KEYS/2, "Wrong number of entries: %u", hashtable_count(h));
+
+	for(i = 0; i < HASH_TEST_KEYS; i++)
+	{
+		keyStr.str = keys + i*12;
+		keyStr.length = strlen(keyStr.str);
+		if(i % 2 == 0)
+			ck_assert_msg (hashtable_search(h, keyStr) == INDEX_MAX, "Removed key %u found", (unsigned int) i);
+		else
+			ck_assert_msg (hashtable_search(h, keyStr) == i, "Key %u not found", (unsigned int) i);
+	}
+	ck_assert_msg (hashtable_search(h, missing) == INDEX_MAX, "Missing key found");
+
+	// The freed slots are reused
+	for(i = 0; i < HASH_TEST_KEYS; i += 2)
+	{
+		keyStr.str = keys + i*12;
+		keyStr.length = strlen(keyStr.str);
+		ck_assert_msg (hashtable_insert(h, keyStr, i) == EXIP_OK, "hashtable_insert fails for key %u", (unsigned int) i);
+		ck_assert_msg (hashtable_search(h, keyStr) == i, "Key %u not found", (unsigned int) i);
+	}
+
+	hashtable_destroy(h);
+	EXIP_MFREE(keys);
+}
+END_TEST
+#endif
+
 /* END: table tests */
 
 Suite * tables_suite (void)
@@ -205,6 +449,13 @@ Suite * tables_suite (void)
 	  tcase_add_test (tc_tables, test_addUriEntry);
 	  tcase_add_test (tc_tables, test_addLnEntry);
 	  tcase_add_test (tc_tables, test_addValueEntry);
+	  tcase_add_test (tc_tables, test_lookupUriLn);
+#if VALUE_CROSSTABLE_USE
+	  tcase_add_test (tc_tables, test_lookupVx);
+#endif
+#if HASH_TABLE_USE
+	  tcase_add_test (tc_tables, test_valueHashTable);
+#endif
 	  suite_add_tcase (s, tc_tables);
   }
 
@@ -0,0 +1,6073 @@
+/** AUTO-GENERATED: Sun Oct 18 03:02:27 2026
+  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU
+  * $Id$ */
+
+#include "procTypes.h"
+#include "streamDecode.h"
+#include "streamEncode.h"
+#include "schema_demo_codec.h"
+
+#if !STATIC_CODEC_USE
+# error The generated event code functions require STATIC_CODEC_USE
+#endif
+
+#define CONST
+
+/** START_STRINGS_DEFINITONS */
+
+CONST CharType demo_LN_0_0[] = {0x4f, 0x46, 0x43, 0x61, 0x70, 0x61, 0x62, 0x6c, 0x65, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x52, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x4c, 0x69, 0x73, 0x74, 0x54, 0x79, 0x70, 0x65}; /* OFCapableSwitchResourceListType */
+CONST CharType demo_LN_0_1[] = {0x4f, 0x46, 0x43, 0x61, 0x70, 0x61, 0x62, 0x6c, 0x65, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x54, 0x79, 0x70, 0x65}; /* OFCapableSwitchType */
+CONST CharType demo_LN_0_2[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x49, 0x44}; /* OFConfigID */
+CONST CharType demo_LN_0_3[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x43, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x74, 0x61, 0x74, 0x65, 0x54, 0x79, 0x70, 0x65}; /* OFControllerConnectionStateType */
+CONST CharType demo_LN_0_4[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x4c, 0x69, 0x73, 0x74, 0x54, 0x79, 0x70, 0x65}; /* OFControllerListType */
+CONST CharType demo_LN_0_5[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x4f, 0x70, 0x65, 0x6e, 0x46, 0x6c, 0x6f, 0x77, 0x53, 0x74, 0x61, 0x74, 0x65, 0x54, 0x79, 0x70, 0x65}; /* OFControllerOpenFlowStateType */
+CONST CharType demo_LN_0_6[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x50, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c, 0x54, 0x79, 0x70, 0x65}; /* OFControllerProtocolType */
+CONST CharType demo_LN_0_7[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x52, 0x6f, 0x6c, 0x65, 0x54, 0x79, 0x70, 0x65}; /* OFControllerRoleType */
+CONST CharType demo_LN_0_8[] = {0x4f, 0x46, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x54, 0x79, 0x70, 0x65}; /* OFControllerType */
+CONST CharType demo_LN_0_9[] = {0x4f, 0x46, 0x4c, 0x6f, 0x67, 0x69, 0x63, 0x61, 0x6c, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x4c, 0x69, 0x73, 0x74, 0x54, 0x79, 0x70, 0x65}; /* OFLogicalSwitchListType */
+CONST CharType demo_LN_0_10[] = {0x4f, 0x46, 0x4c, 0x6f, 0x67, 0x69, 0x63, 0x61, 0x6c, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x4c, 0x6f, 0x73, 0x74, 0x43, 0x6f, 0x6e, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x42, 0x65, 0x68, 0x61, 0x76, 0x69, 0x6f, 0x72}; /* OFLogicalSwitchLostConnnectionBehavior */
+CONST CharType demo_LN_0_11[] = {0x4f, 0x46, 0x4c, 0x6f, 0x67, 0x69, 0x63, 0x61, 0x6c, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x52, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x4c, 0x69, 0x73, 0x74, 0x54, 0x79, 0x70, 0x65}; /* OFLogicalSwitchResourceListType */
+CONST CharType demo_LN_0_12[] = {0x4f, 0x46, 0x4c, 0x6f, 0x67, 0x69, 0x63, 0x61, 0x6c, 0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x54, 0x79, 0x70, 0x65}; /* OFLogicalSwitchType */
+CONST CharType demo_LN_0_13[] = {0x4f, 0x46, 0x4f, 0x70, 0x65, 0x6e, 0x46, 0x6c, 0x6f, 0x77, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x54, 0x79, 0x70, 0x65}; /* OFOpenFlowVersionType */
+CONST CharType demo_LN_0_14[] = {0x4f, 0x46, 0x50, 0x6f, 0x72, 0x74, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x75, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x54, 0x79, 0x70, 0x65}; /* OFPortConfigurationType */
+CONST CharType demo_LN_0_15[] = {0x4f, 0x46, 0x50, 0x6f, 0x72, 0x74, 0x53, 0x74, 0x61, 0x74, 0x65, 0x4f, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x54, 0x79, 0x70, 0x65}; /* OFPortStateOptionsType */
+CONST CharType demo_LN_0_16[] = {0x4f, 0x46, 0x50, 0x6f, 0x72, 0x74, 0x54, 0x79, 0x70, 0x65}; /* OFPortType */
+CONST CharType demo_LN_0_17[] = {0x61, 0x64, 0x6d, 0x69, 0x6e, 0x2d, 0x73, 0x74, 0x61, 0x74, 0x65}; /* admin-state */
+CONST CharType demo_LN_0_18[] = {0x63, 0x61, 0x70, 0x61, 0x62, 0x6c, 0x65, 0x2d, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68}; /* capable-switch */
+CONST CharType demo_LN_0_19[] = {0x63, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x75, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e}; /* configuration */
+CONST CharType demo_LN_0_20[] = {0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x73, 0x74, 0x61, 0x74, 0x65}; /* connection-state */
+CONST CharType demo_LN_0_21[] = {0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72}; /* controller */
+CONST CharType demo_LN_0_22[] = {0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x73}; /* controllers */
+CONST CharType demo_LN_0_23[] = {0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x2d, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e}; /* current-version */
+CONST CharType demo_LN_0_24[] = {0x64, 0x61, 0x74, 0x61, 0x70, 0x61, 0x74, 0x68, 0x2d, 0x69, 0x64}; /* datapath-id */
+CONST CharType demo_LN_0_25[] = {0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64}; /* enabled */
+CONST CharType demo_LN_0_26[] = {0x69, 0x64}; /* id */
+CONST CharType demo_LN_0_27[] = {0x69, 0x70, 0x2d, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73}; /* ip-address */
+CONST CharType demo_LN_0_28[] = {0x69, 0x70, 0x76, 0x34, 0x2d, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73}; /* ipv4-address */
+CONST CharType demo_LN_0_29[] = {0x69, 0x70, 0x76, 0x36, 0x2d, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73}; /* ipv6-address */
+CONST CharType demo_LN_0_30[] = {0x6c, 0x6f, 0x67, 0x69, 0x63, 0x61, 0x6c, 0x2d, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x65, 0x73}; /* logical-switches */
+CONST CharType demo_LN_0_31[] = {0x6c, 0x6f, 0x73, 0x74, 0x2d, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x62, 0x65, 0x68, 0x61, 0x76, 0x69, 0x6f, 0x72}; /* lost-connection-behavior */
+CONST CharType demo_LN_0_32[] = {0x6e, 0x6f, 0x2d, 0x66, 0x6f, 0x72, 0x77, 0x61, 0x72, 0x64}; /* no-forward */
+CONST CharType demo_LN_0_33[] = {0x6e, 0x6f, 0x2d, 0x70, 0x61, 0x63, 0x6b, 0x65, 0x74, 0x2d, 0x69, 0x6e}; /* no-packet-in */
+CONST CharType demo_LN_0_34[] = {0x6e, 0x6f, 0x2d, 0x72, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65}; /* no-receive */
+CONST CharType demo_LN_0_35[] = {0x70, 0x6f, 0x72, 0x74}; /* port */
+CONST CharType demo_LN_0_36[] = {0x70, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c}; /* protocol */
+CONST CharType demo_LN_0_37[] = {0x72, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x2d, 0x69, 0x64}; /* resource-id */
+CONST CharType demo_LN_0_38[] = {0x72, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x73}; /* resources */
+CONST CharType demo_LN_0_39[] = {0x72, 0x6f, 0x6c, 0x65}; /* role */
+CONST CharType demo_LN_0_40[] = {0x73, 0x74, 0x61, 0x74, 0x65}; /* state */
+CONST CharType demo_LN_0_41[] = {0x73, 0x77, 0x69, 0x74, 0x63, 0x68}; /* switch */
+CONST CharType demo_URI_1[] = {0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x58, 0x4d, 0x4c, 0x2f, 0x31, 0x39, 0x39, 0x38, 0x2f, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x70, 0x61, 0x63, 0x65}; /* http://www.w3.org/XML/1998/namespace */
+CONST CharType demo_PFX_1_0[] = {0x78, 0x6d, 0x6c}; /* xml */
+CONST CharType demo_LN_1_0[] = {0x62, 0x61, 0x73, 0x65}; /* base */
+CONST CharType demo_LN_1_1[] = {0x69, 0x64}; /* id */
+CONST CharType demo_LN_1_2[] = {0x6c, 0x61, 0x6e, 0x67}; /* lang */
+CONST CharType demo_LN_1_3[] = {0x73, 0x70, 0x61, 0x63, 0x65}; /* space */
+CONST CharType demo_URI_2[] = {0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65}; /* http://www.w3.org/2001/XMLSchema-instance */
+CONST CharType demo_PFX_2_0[] = {0x78, 0x73, 0x69}; /* xsi */
+CONST CharType demo_LN_2_0[] = {0x6e, 0x69, 0x6c}; /* nil */
+CONST CharType demo_LN_2_1[] = {0x74, 0x79, 0x70, 0x65}; /* type */
+CONST CharType demo_URI_3[] = {0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61}; /* http://www.w3.org/2001/XMLSchema */
+CONST CharType demo_LN_3_0[] = {0x45, 0x4e, 0x54, 0x49, 0x54, 0x49, 0x45, 0x53}; /* ENTITIES */
+CONST CharType demo_LN_3_1[] = {0x45, 0x4e, 0x54, 0x49, 0x54, 0x59}; /* ENTITY */
+CONST CharType demo_LN_3_2[] = {0x49, 0x44}; /* ID */
+CONST CharType demo_LN_3_3[] = {0x49, 0x44, 0x52, 0x45, 0x46}; /* IDREF */
+CONST CharType demo_LN_3_4[] = {0x49, 0x44, 0x52, 0x45, 0x46, 0x53}; /* IDREFS */
+CONST CharType demo_LN_3_5[] = {0x4e, 0x43, 0x4e, 0x61, 0x6d, 0x65}; /* NCName */
+CONST CharType demo_LN_3_6[] = {0x4e, 0x4d, 0x54, 0x4f, 0x4b, 0x45, 0x4e}; /* NMTOKEN */
+CONST CharType demo_LN_3_7[] = {0x4e, 0x4d, 0x54, 0x4f, 0x4b, 0x45, 0x4e, 0x53}; /* NMTOKENS */
+CONST CharType demo_LN_3_8[] = {0x4e, 0x4f, 0x54, 0x41, 0x54, 0x49, 0x4f, 0x4e}; /* NOTATION */
+CONST CharType demo_LN_3_9[] = {0x4e, 0x61, 0x6d, 0x65}; /* Name */
+CONST CharType demo_LN_3_10[] = {0x51, 0x4e, 0x61, 0x6d, 0x65}; /* QName */
+CONST CharType demo_LN_3_11[] = {0x61, 0x6e, 0x79, 0x53, 0x69, 0x6d, 0x70, 0x6c, 0x65, 0x54, 0x79, 0x70, 0x65}; /* anySimpleType */
+CONST CharType demo_LN_3_12[] = {0x61, 0x6e, 0x79, 0x54, 0x79, 0x70, 0x65}; /* anyType */
+CONST CharType demo_LN_3_13[] = {0x61, 0x6e, 0x79, 0x55, 0x52, 0x49}; /* anyURI */
+CONST CharType demo_LN_3_14[] = {0x62, 0x61, 0x73, 0x65, 0x36, 0x34, 0x42, 0x69, 0x6e, 0x61, 0x72, 0x79}; /* base64Binary */
+CONST CharType demo_LN_3_15[] = {0x62, 0x6f, 0x6f, 0x6c, 0x65, 0x61, 0x6e}; /* boolean */
+CONST CharType demo_LN_3_16[] = {0x62, 0x79, 0x74, 0x65}; /* byte */
+CONST CharType demo_LN_3_17[] = {0x64, 0x61, 0x74, 0x65}; /* date */
+CONST CharType demo_LN_3_18[] = {0x64, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6d, 0x65}; /* dateTime */
+CONST CharType demo_LN_3_19[] = {0x64, 0x65, 0x63, 0x69, 0x6d, 0x61, 0x6c}; /* decimal */
+CONST CharType demo_LN_3_20[] = {0x64, 0x6f, 0x75, 0x62, 0x6c, 0x65}; /* double */
+CONST CharType demo_LN_3_21[] = {0x64, 0x75, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e}; /* duration */
+CONST CharType demo_LN_3_22[] = {0x66, 0x6c, 0x6f, 0x61, 0x74}; /* float */
+CONST CharType demo_LN_3_23[] = {0x67, 0x44, 0x61, 0x79}; /* gDay */
+CONST CharType demo_LN_3_24[] = {0x67, 0x4d, 0x6f, 0x6e, 0x74, 0x68}; /* gMonth */
+CONST CharType demo_LN_3_25[] = {0x67, 0x4d, 0x6f, 0x6e, 0x74, 0x68, 0x44, 0x61, 0x79}; /* gMonthDay */
+CONST CharType demo_LN_3_26[] = {0x67, 0x59, 0x65, 0x61, 0x72}; /* gYear */
+CONST CharType demo_LN_3_27[] = {0x67, 0x59, 0x65, 0x61, 0x72, 0x4d, 0x6f, 0x6e, 0x74, 0x68}; /* gYearMonth */
+CONST CharType demo_LN_3_28[] = {0x68, 0x65, 0x78, 0x42, 0x69, 0x6e, 0x61, 0x72, 0x79}; /* hexBinary */
+CONST CharType demo_LN_3_29[] = {0x69, 0x6e, 0x74}; /* int */
+CONST CharType demo_LN_3_30[] = {0x69, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72}; /* integer */
+CONST CharType demo_LN_3_31[] = {0x6c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65}; /* language */
+CONST CharType demo_LN_3_32[] = {0x6c, 0x6f, 0x6e, 0x67}; /* long */
+CONST CharType demo_LN_3_33[] = {0x6e, 0x65, 0x67, 0x61, 0x74, 0x69, 0x76, 0x65, 0x49, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72}; /* negativeInteger */
+CONST CharType demo_LN_3_34[] = {0x6e, 0x6f, 0x6e, 0x4e, 0x65, 0x67, 0x61, 0x74, 0x69, 0x76, 0x65, 0x49, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72}; /* nonNegativeInteger */
+CONST CharType demo_LN_3_35[] = {0x6e, 0x6f, 0x6e, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x49, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72}; /* nonPositiveInteger */
+CONST CharType demo_LN_3_36[] = {0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x53, 0x74, 0x72, 0x69, 0x6e, 0x67}; /* normalizedString */
+CONST CharType demo_LN_3_37[] = {0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x49, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72}; /* positiveInteger */
+CONST CharType demo_LN_3_38[] = {0x73, 0x68, 0x6f, 0x72, 0x74}; /* short */
+CONST CharType demo_LN_3_39[] = {0x73, 0x74, 0x72, 0x69, 0x6e, 0x67}; /* string */
+CONST CharType demo_LN_3_40[] = {0x74, 0x69, 0x6d, 0x65}; /* time */
+CONST CharType demo_LN_3_41[] = {0x74, 0x6f, 0x6b, 0x65, 0x6e}; /* token */
+CONST CharType demo_LN_3_42[] = {0x75, 0x6e, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x64, 0x42, 0x79, 0x74, 0x65}; /* unsignedByte */
+CONST CharType demo_LN_3_43[] = {0x75, 0x6e, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x64, 0x49, 0x6e, 0x74}; /* unsignedInt */
+CONST CharType demo_LN_3_44[] = {0x75, 0x6e, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x64, 0x4c, 0x6f, 0x6e, 0x67}; /* unsignedLong */
+CONST CharType demo_LN_3_45[] = {0x75, 0x6e, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x64, 0x53, 0x68, 0x6f, 0x72, 0x74}; /* unsignedShort */
+
+/** END_STRINGS_DEFINITONS */
+
+static CONST Production demo_prod_0_0[1] =
+{
+    {
+        838860801, 0,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_0_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_0[2] =
+{
+    {demo_prod_0_0, 1, 0},
+    {demo_prod_0_1, 1, 1}
+};
+
+static CONST Production demo_prod_1_0[1] =
+{
+    {
+        838860801, 1,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_1_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_1[2] =
+{
+    {demo_prod_1_0, 1, 0},
+    {demo_prod_1_1, 1, 1}
+};
+
+static CONST Production demo_prod_2_0[1] =
+{
+    {
+        838860801, 2,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_2_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_2[2] =
+{
+    {demo_prod_2_0, 1, 0},
+    {demo_prod_2_1, 1, 1}
+};
+
+static CONST Production demo_prod_3_0[1] =
+{
+    {
+        838860801, 3,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_3_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_3[2] =
+{
+    {demo_prod_3_0, 1, 0},
+    {demo_prod_3_1, 1, 1}
+};
+
+static CONST Production demo_prod_4_0[1] =
+{
+    {
+        838860801, 4,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_4_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_4[2] =
+{
+    {demo_prod_4_0, 1, 0},
+    {demo_prod_4_1, 1, 1}
+};
+
+static CONST Production demo_prod_5_0[1] =
+{
+    {
+        838860801, 5,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_5_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_5[2] =
+{
+    {demo_prod_5_0, 1, 0},
+    {demo_prod_5_1, 1, 1}
+};
+
+static CONST Production demo_prod_6_0[1] =
+{
+    {
+        838860801, 6,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_6_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_6[2] =
+{
+    {demo_prod_6_0, 1, 0},
+    {demo_prod_6_1, 1, 1}
+};
+
+static CONST Production demo_prod_7_0[1] =
+{
+    {
+        838860801, 7,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_7_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_7[2] =
+{
+    {demo_prod_7_0, 1, 0},
+    {demo_prod_7_1, 1, 1}
+};
+
+static CONST Production demo_prod_8_0[1] =
+{
+    {
+        838860801, 8,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_8_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_8[2] =
+{
+    {demo_prod_8_0, 1, 0},
+    {demo_prod_8_1, 1, 1}
+};
+
+static CONST Production demo_prod_9_0[1] =
+{
+    {
+        838860801, 9,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_9_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_9[2] =
+{
+    {demo_prod_9_0, 1, 0},
+    {demo_prod_9_1, 1, 1}
+};
+
+static CONST Production demo_prod_10_0[1] =
+{
+    {
+        838860801, 10,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_10_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_10[2] =
+{
+    {demo_prod_10_0, 1, 0},
+    {demo_prod_10_1, 1, 1}
+};
+
+static CONST Production demo_prod_11_0[1] =
+{
+    {
+        838860801, 11,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_11_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_11[2] =
+{
+    {demo_prod_11_0, 1, 0},
+    {demo_prod_11_1, 1, 1}
+};
+
+static CONST Production demo_prod_12_0[4] =
+{
+    {
+        838860801, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        536870913, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        369098752, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_12_1[3] =
+{
+    {
+        838860801, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        536870913, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_12[2] =
+{
+    {demo_prod_12_0, 4, 1},
+    {demo_prod_12_1, 3, 1}
+};
+
+static CONST Production demo_prod_13_0[1] =
+{
+    {
+        838860801, 13,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_13_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_13[2] =
+{
+    {demo_prod_13_0, 1, 0},
+    {demo_prod_13_1, 1, 1}
+};
+
+static CONST Production demo_prod_14_0[1] =
+{
+    {
+        838860801, 14,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_14_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_14[2] =
+{
+    {demo_prod_14_0, 1, 0},
+    {demo_prod_14_1, 1, 1}
+};
+
+static CONST Production demo_prod_15_0[1] =
+{
+    {
+        838860801, 15,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_15_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_15[2] =
+{
+    {demo_prod_15_0, 1, 0},
+    {demo_prod_15_1, 1, 1}
+};
+
+static CONST Production demo_prod_16_0[1] =
+{
+    {
+        838860801, 16,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_16_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_16[2] =
+{
+    {demo_prod_16_0, 1, 0},
+    {demo_prod_16_1, 1, 1}
+};
+
+static CONST Production demo_prod_17_0[1] =
+{
+    {
+        838860801, 17,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_17_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_17[2] =
+{
+    {demo_prod_17_0, 1, 0},
+    {demo_prod_17_1, 1, 1}
+};
+
+static CONST Production demo_prod_18_0[1] =
+{
+    {
+        838860801, 18,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_18_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_18[2] =
+{
+    {demo_prod_18_0, 1, 0},
+    {demo_prod_18_1, 1, 1}
+};
+
+static CONST Production demo_prod_19_0[1] =
+{
+    {
+        838860801, 19,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_19_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_19[2] =
+{
+    {demo_prod_19_0, 1, 0},
+    {demo_prod_19_1, 1, 1}
+};
+
+static CONST Production demo_prod_20_0[1] =
+{
+    {
+        838860801, 20,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_20_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_20[2] =
+{
+    {demo_prod_20_0, 1, 0},
+    {demo_prod_20_1, 1, 1}
+};
+
+static CONST Production demo_prod_21_0[1] =
+{
+    {
+        838860801, 21,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_21_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_21[2] =
+{
+    {demo_prod_21_0, 1, 0},
+    {demo_prod_21_1, 1, 1}
+};
+
+static CONST Production demo_prod_22_0[1] =
+{
+    {
+        838860801, 22,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_22_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_22[2] =
+{
+    {demo_prod_22_0, 1, 0},
+    {demo_prod_22_1, 1, 1}
+};
+
+static CONST Production demo_prod_23_0[1] =
+{
+    {
+        838860801, 23,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_23_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_23[2] =
+{
+    {demo_prod_23_0, 1, 0},
+    {demo_prod_23_1, 1, 1}
+};
+
+static CONST Production demo_prod_24_0[1] =
+{
+    {
+        838860801, 24,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_24_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_24[2] =
+{
+    {demo_prod_24_0, 1, 0},
+    {demo_prod_24_1, 1, 1}
+};
+
+static CONST Production demo_prod_25_0[1] =
+{
+    {
+        838860801, 25,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_25_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_25[2] =
+{
+    {demo_prod_25_0, 1, 0},
+    {demo_prod_25_1, 1, 1}
+};
+
+static CONST Production demo_prod_26_0[1] =
+{
+    {
+        838860801, 26,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_26_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_26[2] =
+{
+    {demo_prod_26_0, 1, 0},
+    {demo_prod_26_1, 1, 1}
+};
+
+static CONST Production demo_prod_27_0[1] =
+{
+    {
+        838860801, 27,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_27_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_27[2] =
+{
+    {demo_prod_27_0, 1, 0},
+    {demo_prod_27_1, 1, 1}
+};
+
+static CONST Production demo_prod_28_0[1] =
+{
+    {
+        838860801, 28,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_28_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_28[2] =
+{
+    {demo_prod_28_0, 1, 0},
+    {demo_prod_28_1, 1, 1}
+};
+
+static CONST Production demo_prod_29_0[1] =
+{
+    {
+        838860801, 29,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_29_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_29[2] =
+{
+    {demo_prod_29_0, 1, 0},
+    {demo_prod_29_1, 1, 1}
+};
+
+static CONST Production demo_prod_30_0[1] =
+{
+    {
+        838860801, 30,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_30_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_30[2] =
+{
+    {demo_prod_30_0, 1, 0},
+    {demo_prod_30_1, 1, 1}
+};
+
+static CONST Production demo_prod_31_0[1] =
+{
+    {
+        838860801, 31,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_31_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_31[2] =
+{
+    {demo_prod_31_0, 1, 0},
+    {demo_prod_31_1, 1, 1}
+};
+
+static CONST Production demo_prod_32_0[1] =
+{
+    {
+        838860801, 32,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_32_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_32[2] =
+{
+    {demo_prod_32_0, 1, 0},
+    {demo_prod_32_1, 1, 1}
+};
+
+static CONST Production demo_prod_33_0[1] =
+{
+    {
+        838860801, 33,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_33_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_33[2] =
+{
+    {demo_prod_33_0, 1, 0},
+    {demo_prod_33_1, 1, 1}
+};
+
+static CONST Production demo_prod_34_0[1] =
+{
+    {
+        838860801, 34,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_34_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_34[2] =
+{
+    {demo_prod_34_0, 1, 0},
+    {demo_prod_34_1, 1, 1}
+};
+
+static CONST Production demo_prod_35_0[1] =
+{
+    {
+        838860801, 35,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_35_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_35[2] =
+{
+    {demo_prod_35_0, 1, 0},
+    {demo_prod_35_1, 1, 1}
+};
+
+static CONST Production demo_prod_36_0[1] =
+{
+    {
+        838860801, 36,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_36_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_36[2] =
+{
+    {demo_prod_36_0, 1, 0},
+    {demo_prod_36_1, 1, 1}
+};
+
+static CONST Production demo_prod_37_0[1] =
+{
+    {
+        838860801, 37,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_37_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_37[2] =
+{
+    {demo_prod_37_0, 1, 0},
+    {demo_prod_37_1, 1, 1}
+};
+
+static CONST Production demo_prod_38_0[1] =
+{
+    {
+        838860801, 38,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_38_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_38[2] =
+{
+    {demo_prod_38_0, 1, 0},
+    {demo_prod_38_1, 1, 1}
+};
+
+static CONST Production demo_prod_39_0[1] =
+{
+    {
+        838860801, 39,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_39_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_39[2] =
+{
+    {demo_prod_39_0, 1, 0},
+    {demo_prod_39_1, 1, 1}
+};
+
+static CONST Production demo_prod_40_0[1] =
+{
+    {
+        838860801, 40,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_40_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_40[2] =
+{
+    {demo_prod_40_0, 1, 0},
+    {demo_prod_40_1, 1, 1}
+};
+
+static CONST Production demo_prod_41_0[1] =
+{
+    {
+        838860801, 41,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_41_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_41[2] =
+{
+    {demo_prod_41_0, 1, 0},
+    {demo_prod_41_1, 1, 1}
+};
+
+static CONST Production demo_prod_42_0[1] =
+{
+    {
+        838860801, 42,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_42_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_42[2] =
+{
+    {demo_prod_42_0, 1, 0},
+    {demo_prod_42_1, 1, 1}
+};
+
+static CONST Production demo_prod_43_0[1] =
+{
+    {
+        838860801, 43,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_43_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_43[2] =
+{
+    {demo_prod_43_0, 1, 0},
+    {demo_prod_43_1, 1, 1}
+};
+
+static CONST Production demo_prod_44_0[1] =
+{
+    {
+        838860801, 44,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_44_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_44[2] =
+{
+    {demo_prod_44_0, 1, 0},
+    {demo_prod_44_1, 1, 1}
+};
+
+static CONST Production demo_prod_45_0[1] =
+{
+    {
+        838860801, 45,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_45_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_45[2] =
+{
+    {demo_prod_45_0, 1, 0},
+    {demo_prod_45_1, 1, 1}
+};
+
+static CONST Production demo_prod_46_0[1] =
+{
+    {
+        838860801, 46,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_46_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_46[2] =
+{
+    {demo_prod_46_0, 1, 0},
+    {demo_prod_46_1, 1, 1}
+};
+
+static CONST Production demo_prod_47_0[1] =
+{
+    {
+        838860801, 47,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_47_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_47[2] =
+{
+    {demo_prod_47_0, 1, 0},
+    {demo_prod_47_1, 1, 1}
+};
+
+static CONST Production demo_prod_48_0[1] =
+{
+    {
+        503316481, 47,
+        {0, 17}}
+};
+
+static CONST Production demo_prod_48_1[1] =
+{
+    {
+        503316482, 15,
+        {0, 34}}
+};
+
+static CONST Production demo_prod_48_2[1] =
+{
+    {
+        503316483, 15,
+        {0, 32}}
+};
+
+static CONST Production demo_prod_48_3[1] =
+{
+    {
+        503316484, 15,
+        {0, 33}}
+};
+
+static CONST Production demo_prod_48_4[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_48[5] =
+{
+    {demo_prod_48_0, 1, 0},
+    {demo_prod_48_1, 1, 0},
+    {demo_prod_48_2, 1, 0},
+    {demo_prod_48_3, 1, 0},
+    {demo_prod_48_4, 1, 1}
+};
+
+static CONST Production demo_prod_49_0[1] =
+{
+    {
+        503316481, 46,
+        {0, 37}}
+};
+
+static CONST Production demo_prod_49_1[1] =
+{
+    {
+        503316482, 48,
+        {0, 19}}
+};
+
+static CONST Production demo_prod_49_2[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_49[3] =
+{
+    {demo_prod_49_0, 1, 0},
+    {demo_prod_49_1, 1, 0},
+    {demo_prod_49_2, 1, 1}
+};
+
+static CONST Production demo_prod_50_0[1] =
+{
+    {
+        503316481, 49,
+        {0, 35}}
+};
+
+static CONST Production demo_prod_50_1[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 49,
+        {0, 35}}
+};
+
+static CONST Production demo_prod_50_2[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 49,
+        {0, 35}}
+};
+
+static CONST GrammarRule demo_rule_50[3] =
+{
+    {demo_prod_50_0, 1, 0},
+    {demo_prod_50_1, 2, 1},
+    {demo_prod_50_2, 2, 1}
+};
+
+static CONST Production demo_prod_51_0[1] =
+{
+    {
+        838860801, 48,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_51_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_51[2] =
+{
+    {demo_prod_51_0, 1, 0},
+    {demo_prod_51_1, 1, 1}
+};
+
+static CONST Production demo_prod_52_0[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316481, 46,
+        {0, 35}}
+};
+
+static CONST Production demo_prod_52_1[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316481, 46,
+        {0, 35}}
+};
+
+static CONST GrammarRule demo_rule_52[2] =
+{
+    {demo_prod_52_0, 2, 1},
+    {demo_prod_52_1, 2, 1}
+};
+
+static CONST Production demo_prod_53_0[1] =
+{
+    {
+        838860801, 49,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_53_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_53[2] =
+{
+    {demo_prod_53_0, 1, 0},
+    {demo_prod_53_1, 1, 1}
+};
+
+static CONST Production demo_prod_54_0[1] =
+{
+    {
+        838860801, 39,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_54_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_54[2] =
+{
+    {demo_prod_54_0, 1, 0},
+    {demo_prod_54_1, 1, 1}
+};
+
+static CONST Production demo_prod_55_0[1] =
+{
+    {
+        838860801, 50,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_55_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_55[2] =
+{
+    {demo_prod_55_0, 1, 0},
+    {demo_prod_55_1, 1, 1}
+};
+
+static CONST Production demo_prod_56_0[1] =
+{
+    {
+        838860801, 51,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_56_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_56[2] =
+{
+    {demo_prod_56_0, 1, 0},
+    {demo_prod_56_1, 1, 1}
+};
+
+static CONST Production demo_prod_57_0[1] =
+{
+    {
+        838860801, 52,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_57_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_57[2] =
+{
+    {demo_prod_57_0, 1, 0},
+    {demo_prod_57_1, 1, 1}
+};
+
+static CONST Production demo_prod_58_0[1] =
+{
+    {
+        503316481, 56,
+        {0, 20}}
+};
+
+static CONST Production demo_prod_58_1[1] =
+{
+    {
+        503316482, 57,
+        {0, 23}}
+};
+
+static CONST Production demo_prod_58_2[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_58[3] =
+{
+    {demo_prod_58_0, 1, 0},
+    {demo_prod_58_1, 1, 0},
+    {demo_prod_58_2, 1, 1}
+};
+
+static CONST Production demo_prod_59_0[1] =
+{
+    {
+        503316481, 46,
+        {0, 26}}
+};
+
+static CONST Production demo_prod_59_1[1] =
+{
+    {
+        503316482, 53,
+        {0, 39}}
+};
+
+static CONST Production demo_prod_59_2[1] =
+{
+    {
+        503316483, 54,
+        {0, 27}}
+};
+
+static CONST Production demo_prod_59_3[1] =
+{
+    {
+        503316484, 30,
+        {0, 35}}
+};
+
+static CONST Production demo_prod_59_4[1] =
+{
+    {
+        503316485, 55,
+        {0, 36}}
+};
+
+static CONST Production demo_prod_59_5[1] =
+{
+    {
+        503316486, 58,
+        {0, 40}}
+};
+
+static CONST Production demo_prod_59_6[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_59[7] =
+{
+    {demo_prod_59_0, 1, 0},
+    {demo_prod_59_1, 1, 0},
+    {demo_prod_59_2, 1, 0},
+    {demo_prod_59_3, 1, 0},
+    {demo_prod_59_4, 1, 0},
+    {demo_prod_59_5, 1, 0},
+    {demo_prod_59_6, 1, 1}
+};
+
+static CONST Production demo_prod_60_0[1] =
+{
+    {
+        503316481, 59,
+        {0, 21}}
+};
+
+static CONST Production demo_prod_60_1[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 59,
+        {0, 21}}
+};
+
+static CONST Production demo_prod_60_2[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 59,
+        {0, 21}}
+};
+
+static CONST GrammarRule demo_rule_60[3] =
+{
+    {demo_prod_60_0, 1, 0},
+    {demo_prod_60_1, 2, 1},
+    {demo_prod_60_2, 2, 1}
+};
+
+static CONST Production demo_prod_61_0[1] =
+{
+    {
+        503316481, 46,
+        {0, 26}}
+};
+
+static CONST Production demo_prod_61_1[1] =
+{
+    {
+        503316482, 46,
+        {0, 24}}
+};
+
+static CONST Production demo_prod_61_2[1] =
+{
+    {
+        503316483, 15,
+        {0, 25}}
+};
+
+static CONST Production demo_prod_61_3[1] =
+{
+    {
+        503316484, 51,
+        {0, 31}}
+};
+
+static CONST Production demo_prod_61_4[1] =
+{
+    {
+        503316485, 52,
+        {0, 38}}
+};
+
+static CONST Production demo_prod_61_5[1] =
+{
+    {
+        503316486, 60,
+        {0, 22}}
+};
+
+static CONST Production demo_prod_61_6[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_61[7] =
+{
+    {demo_prod_61_0, 1, 0},
+    {demo_prod_61_1, 1, 0},
+    {demo_prod_61_2, 1, 0},
+    {demo_prod_61_3, 1, 0},
+    {demo_prod_61_4, 1, 0},
+    {demo_prod_61_5, 1, 0},
+    {demo_prod_61_6, 1, 1}
+};
+
+static CONST Production demo_prod_62_0[1] =
+{
+    {
+        503316481, 61,
+        {0, 41}}
+};
+
+static CONST Production demo_prod_62_1[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 61,
+        {0, 41}}
+};
+
+static CONST Production demo_prod_62_2[2] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316482, 61,
+        {0, 41}}
+};
+
+static CONST GrammarRule demo_rule_62[3] =
+{
+    {demo_prod_62_0, 1, 0},
+    {demo_prod_62_1, 2, 1},
+    {demo_prod_62_2, 2, 1}
+};
+
+static CONST Production demo_prod_63_0[1] =
+{
+    {
+        503316481, 50,
+        {0, 38}}
+};
+
+static CONST Production demo_prod_63_1[1] =
+{
+    {
+        503316482, 62,
+        {0, 30}}
+};
+
+static CONST Production demo_prod_63_2[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_63[3] =
+{
+    {demo_prod_63_0, 1, 0},
+    {demo_prod_63_1, 1, 0},
+    {demo_prod_63_2, 1, 1}
+};
+
+static CONST Production demo_prod_64_0[1] =
+{
+    {
+        503316481, 63,
+        {0, 18}}
+};
+
+static CONST Production demo_prod_64_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_64[2] =
+{
+    {demo_prod_64_0, 1, 0},
+    {demo_prod_64_1, 1, 1}
+};
+
+static CONST Production demo_prod_65_0[1] =
+{
+    {
+        838860801, 53,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_65_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_65[2] =
+{
+    {demo_prod_65_0, 1, 0},
+    {demo_prod_65_1, 1, 1}
+};
+
+static CONST Production demo_prod_66_0[1] =
+{
+    {
+        838860801, 54,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST Production demo_prod_66_1[1] =
+{
+    {
+        687865855, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_rule_66[2] =
+{
+    {demo_prod_66_0, 1, 0},
+    {demo_prod_66_1, 1, 1}
+};
+
+static CONST EXIGrammar demo_grammarTable[67] =
+{
+   {demo_rule_0, 33554432, 2},
+   {demo_rule_1, 570425344, 2},
+   {demo_rule_2, 33554432, 2},
+   {demo_rule_3, 570425344, 2},
+   {demo_rule_4, 33554432, 2},
+   {demo_rule_5, 570425344, 2},
+   {demo_rule_6, 570425344, 2},
+   {demo_rule_7, 33554432, 2},
+   {demo_rule_8, 33554432, 2},
+   {demo_rule_9, 570425344, 2},
+   {demo_rule_10, 33554432, 2},
+   {demo_rule_11, 570425344, 2},
+   {demo_rule_12, 570425345, 2},
+   {demo_rule_13, 33554432, 2},
+   {demo_rule_14, 33554432, 2},
+   {demo_rule_15, 33554432, 2},
+   {demo_rule_16, 33554432, 2},
+   {demo_rule_17, 33554432, 2},
+   {demo_rule_18, 33554432, 2},
+   {demo_rule_19, 570425344, 2},
+   {demo_rule_20, 33554432, 2},
+   {demo_rule_21, 33554432, 2},
+   {demo_rule_22, 33554432, 2},
+   {demo_rule_23, 33554432, 2},
+   {demo_rule_24, 33554432, 2},
+   {demo_rule_25, 33554432, 2},
+   {demo_rule_26, 33554432, 2},
+   {demo_rule_27, 33554432, 2},
+   {demo_rule_28, 33554432, 2},
+   {demo_rule_29, 570425344, 2},
+   {demo_rule_30, 570425344, 2},
+   {demo_rule_31, 33554432, 2},
+   {demo_rule_32, 570425344, 2},
+   {demo_rule_33, 33554432, 2},
+   {demo_rule_34, 570425344, 2},
+   {demo_rule_35, 570425344, 2},
+   {demo_rule_36, 570425344, 2},
+   {demo_rule_37, 33554432, 2},
+   {demo_rule_38, 570425344, 2},
+   {demo_rule_39, 570425344, 2},
+   {demo_rule_40, 33554432, 2},
+   {demo_rule_41, 570425344, 2},
+   {demo_rule_42, 33554432, 2},
+   {demo_rule_43, 570425344, 2},
+   {demo_rule_44, 570425344, 2},
+   {demo_rule_45, 570425344, 2},
+   {demo_rule_46, 1107296256, 2},
+   {demo_rule_47, 1107296256, 2},
+   {demo_rule_48, 1107296256, 5},
+   {demo_rule_49, 1107296256, 3},
+   {demo_rule_50, 1107296256, 3},
+   {demo_rule_51, 1107296256, 2},
+   {demo_rule_52, 1107296256, 2},
+   {demo_rule_53, 1107296256, 2},
+   {demo_rule_54, 1644167168, 2},
+   {demo_rule_55, 1107296256, 2},
+   {demo_rule_56, 1107296256, 2},
+   {demo_rule_57, 1107296256, 2},
+   {demo_rule_58, 1107296256, 3},
+   {demo_rule_59, 1107296256, 7},
+   {demo_rule_60, 1107296256, 3},
+   {demo_rule_61, 1107296256, 7},
+   {demo_rule_62, 1107296256, 3},
+   {demo_rule_63, 1107296256, 3},
+   {demo_rule_64, 1107296256, 2},
+   {demo_rule_65, 1107296256, 2},
+   {demo_rule_66, 1107296256, 2},
+};
+
+static CONST PfxTable demo_pfxTable_0 =
+{
+    1,
+    {
+        {NULL, 0},
+        {NULL, 0},
+        {NULL, 0},
+        {NULL, 0}
+    }
+};
+
+static CONST LnEntry demo_LnEntry_0[42] =
+{
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_0, 31},
+        INDEX_MAX, 50
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_1, 19},
+        INDEX_MAX, 63
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_2, 10},
+        INDEX_MAX, 46
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_3, 31},
+        INDEX_MAX, 56
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_4, 20},
+        INDEX_MAX, 60
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_5, 29},
+        INDEX_MAX, 58
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_6, 24},
+        INDEX_MAX, 55
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_7, 20},
+        INDEX_MAX, 53
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_8, 16},
+        INDEX_MAX, 59
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_9, 23},
+        INDEX_MAX, 62
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_10, 38},
+        INDEX_MAX, 51
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_11, 31},
+        INDEX_MAX, 52
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_12, 19},
+        INDEX_MAX, 61
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_13, 21},
+        INDEX_MAX, 57
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_14, 23},
+        INDEX_MAX, 48
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_15, 22},
+        INDEX_MAX, 47
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_16, 10},
+        INDEX_MAX, 49
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_17, 11},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_18, 14},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_19, 13},
+        64, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_20, 16},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_21, 10},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_22, 11},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_23, 15},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_24, 11},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_25, 7},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_26, 2},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_27, 10},
+        INDEX_MAX, 54
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_28, 12},
+        INDEX_MAX, 65
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_29, 12},
+        INDEX_MAX, 66
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_30, 16},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_31, 24},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_32, 10},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_33, 12},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_34, 10},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_35, 4},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_36, 8},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_37, 11},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_38, 9},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_39, 4},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_40, 5},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_0_41, 6},
+        INDEX_MAX, INDEX_MAX
+    }
+};
+
+static CONST PfxTable demo_pfxTable_1 =
+{
+    1,
+    {
+        {demo_PFX_1_0, 3},
+        {NULL, 0},
+        {NULL, 0},
+        {NULL, 0}
+    }
+};
+
+static CONST LnEntry demo_LnEntry_1[4] =
+{
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_1_0, 4},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_1_1, 2},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_1_2, 4},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_1_3, 5},
+        INDEX_MAX, INDEX_MAX
+    }
+};
+
+static CONST PfxTable demo_pfxTable_2 =
+{
+    1,
+    {
+        {demo_PFX_2_0, 3},
+        {NULL, 0},
+        {NULL, 0},
+        {NULL, 0}
+    }
+};
+
+static CONST LnEntry demo_LnEntry_2[2] =
+{
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_2_0, 3},
+        INDEX_MAX, INDEX_MAX
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_2_1, 4},
+        INDEX_MAX, INDEX_MAX
+    }
+};
+
+static CONST LnEntry demo_LnEntry_3[46] =
+{
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_0, 8},
+        INDEX_MAX, 0
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_1, 6},
+        INDEX_MAX, 1
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_2, 2},
+        INDEX_MAX, 2
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_3, 5},
+        INDEX_MAX, 3
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_4, 6},
+        INDEX_MAX, 4
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_5, 6},
+        INDEX_MAX, 5
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_6, 7},
+        INDEX_MAX, 6
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_7, 8},
+        INDEX_MAX, 7
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_8, 8},
+        INDEX_MAX, 8
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_9, 4},
+        INDEX_MAX, 9
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_10, 5},
+        INDEX_MAX, 10
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_11, 13},
+        INDEX_MAX, 11
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_12, 7},
+        INDEX_MAX, 12
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_13, 6},
+        INDEX_MAX, 13
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_14, 12},
+        INDEX_MAX, 14
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_15, 7},
+        INDEX_MAX, 15
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_16, 4},
+        INDEX_MAX, 16
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_17, 4},
+        INDEX_MAX, 17
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_18, 8},
+        INDEX_MAX, 18
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_19, 7},
+        INDEX_MAX, 19
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_20, 6},
+        INDEX_MAX, 20
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_21, 8},
+        INDEX_MAX, 21
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_22, 5},
+        INDEX_MAX, 22
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_23, 4},
+        INDEX_MAX, 23
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_24, 6},
+        INDEX_MAX, 24
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_25, 9},
+        INDEX_MAX, 25
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_26, 5},
+        INDEX_MAX, 26
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_27, 10},
+        INDEX_MAX, 27
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_28, 9},
+        INDEX_MAX, 28
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_29, 3},
+        INDEX_MAX, 29
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_30, 7},
+        INDEX_MAX, 30
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_31, 8},
+        INDEX_MAX, 31
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_32, 4},
+        INDEX_MAX, 32
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_33, 15},
+        INDEX_MAX, 33
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_34, 18},
+        INDEX_MAX, 34
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_35, 18},
+        INDEX_MAX, 35
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_36, 16},
+        INDEX_MAX, 36
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_37, 15},
+        INDEX_MAX, 37
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_38, 5},
+        INDEX_MAX, 38
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_39, 6},
+        INDEX_MAX, 39
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_40, 4},
+        INDEX_MAX, 40
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_41, 5},
+        INDEX_MAX, 41
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_42, 12},
+        INDEX_MAX, 42
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_43, 11},
+        INDEX_MAX, 43
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_44, 12},
+        INDEX_MAX, 44
+    },
+    {
+#if VALUE_CROSSTABLE_USE
+         NULL,
+#endif
+        {demo_LN_3_45, 13},
+        INDEX_MAX, 45
+    }
+};
+
+static CONST UriEntry demo_uriEntry[4] =
+{
+    {
+        {{sizeof(LnEntry), 42, 42}, demo_LnEntry_0, 42},
+        &demo_pfxTable_0,
+        {NULL, 0}
+    },
+    {
+        {{sizeof(LnEntry), 4, 4}, demo_LnEntry_1, 4},
+        &demo_pfxTable_1,
+        {demo_URI_1, 36}
+    },
+    {
+        {{sizeof(LnEntry), 2, 2}, demo_LnEntry_2, 2},
+        &demo_pfxTable_2,
+        {demo_URI_2, 41}
+    },
+    {
+        {{sizeof(LnEntry), 46, 46}, demo_LnEntry_3, 46},
+        NULL,
+        {demo_URI_3, 32}
+    }
+};
+
+static CONST Production demo_prod_doc_content[2] =
+{
+    {
+        536870913, INDEX_MAX,
+        {URI_MAX, LN_MAX}},
+    {
+        503316481, 64,
+        {0, 19}}
+};
+
+static CONST Production demo_prod_doc_end[1] =
+{
+    {
+        0xAFFFFFF, INDEX_MAX,
+        {URI_MAX, LN_MAX}}
+};
+
+static CONST GrammarRule demo_docGrammarRule[2] =
+{
+    {demo_prod_doc_content, 2, 0},
+    {demo_prod_doc_end, 1, 0}
+};
+
+static CONST SimpleType demo_simpleTypes[55] =
+{
+    {1174405120, 1, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {1174405120, 3, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {1174405120, 6, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {4096, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {1006632960, 0, 0x0000000000000000, 0x0000000000000000},
+    {838860800, 0, 0x0000000000000000, 0x0000000000000000},
+    {1526727232, 0, 0x000000000000007F, 0xFFFFFFFFFFFFFF80},
+    {704643072, 0, 0x0000000000000000, 0x0000000000000000},
+    {671088640, 0, 0x0000000000000000, 0x0000000000000000},
+    {503320576, 0, 0x0000000000000000, 0x0000000000000000},
+    {335544320, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {335544320, 0, 0x0000000000000000, 0x0000000000000000},
+    {721420288, 0, 0x0000000000000000, 0x0000000000000000},
+    {721420288, 0, 0x0000000000000000, 0x0000000000000000},
+    {721420288, 0, 0x0000000000000000, 0x0000000000000000},
+    {687865856, 0, 0x0000000000000000, 0x0000000000000000},
+    {704643072, 0, 0x0000000000000000, 0x0000000000000000},
+    {1006632960, 0, 0x0000000000000000, 0x0000000000000000},
+    {1509953536, 0, 0x0000000000000000, 0x0000000000000000},
+    {1509953536, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {1509953536, 0, 0x0000000000000000, 0x0000000000000000},
+    {1509949504, 0, 0xFFFFFFFFFFFFFFFF, 0x0000000000000000},
+    {1543508480, 0, 0x0000000000000000, 0x0000000000000000},
+    {1509953600, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {1543504384, 0, 0x0000000000000000, 0x0000000000000001},
+    {1509954112, 0, 0x0000000000007FFF, 0xFFFFFFFFFFFF8000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {738197504, 0, 0x0000000000000000, 0x0000000000000000},
+    {167776256, 0, 0x0000000000000000, 0x0000000000000000},
+    {1526727232, 0, 0x00000000000000FF, 0x0000000000000000},
+    {1543508480, 0, 0x0000000000000000, 0x0000000000000000},
+    {1543508480, 0, 0x0000000000000000, 0x0000000000000000},
+    {1543508544, 0, 0x000000000000FFFF, 0x0000000000000000},
+    {167772160, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772176, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772168, 0, 0x0000000000000000, 0x0000000000000000},
+    {167772168, 0, 0x0000000000000000, 0x0000000000000000}
+};
+
+CONST CharType demo_ENUM_0_0[] = {0x75, 0x70}; /* up */
+CONST CharType demo_ENUM_0_1[] = {0x64, 0x6f, 0x77, 0x6e}; /* down */
+
+static CONST String demo_enumValues_0[2] = { 
+   {demo_ENUM_0_0, 2},
+   {demo_ENUM_0_1, 4}
+};
+
+CONST CharType demo_ENUM_1_0[] = {0x66, 0x61, 0x69, 0x6c, 0x53, 0x65, 0x63, 0x75, 0x72, 0x65, 0x4d, 0x6f, 0x64, 0x65}; /* failSecureMode */
+CONST CharType demo_ENUM_1_1[] = {0x66, 0x61, 0x69, 0x6c, 0x53, 0x74, 0x61, 0x6e, 0x64, 0x61, 0x6c, 0x6f, 0x6e, 0x65, 0x4d, 0x6f, 0x64, 0x65}; /* failStandaloneMode */
+
+static CONST String demo_enumValues_1[2] = { 
+   {demo_ENUM_1_0, 14},
+   {demo_ENUM_1_1, 18}
+};
+
+CONST CharType demo_ENUM_2_0[] = {0x6d, 0x61, 0x73, 0x74, 0x65, 0x72}; /* master */
+CONST CharType demo_ENUM_2_1[] = {0x73, 0x6c, 0x61, 0x76, 0x65}; /* slave */
+CONST CharType demo_ENUM_2_2[] = {0x65, 0x71, 0x75, 0x61, 0x6c}; /* equal */
+
+static CONST String demo_enumValues_2[3] = { 
+   {demo_ENUM_2_0, 6},
+   {demo_ENUM_2_1, 5},
+   {demo_ENUM_2_2, 5}
+};
+
+CONST CharType demo_ENUM_3_0[] = {0x74, 0x63, 0x70}; /* tcp */
+CONST CharType demo_ENUM_3_1[] = {0x74, 0x6c, 0x73}; /* tls */
+
+static CONST String demo_enumValues_3[2] = { 
+   {demo_ENUM_3_0, 3},
+   {demo_ENUM_3_1, 3}
+};
+
+CONST CharType demo_ENUM_4_0[] = {0x75, 0x70}; /* up */
+CONST CharType demo_ENUM_4_1[] = {0x64, 0x6f, 0x77, 0x6e}; /* down */
+
+static CONST String demo_enumValues_4[2] = { 
+   {demo_ENUM_4_0, 2},
+   {demo_ENUM_4_1, 4}
+};
+
+CONST CharType demo_ENUM_5_0[] = {0x31, 0x2e, 0x32}; /* 1.2 */
+CONST CharType demo_ENUM_5_1[] = {0x31, 0x2e, 0x31}; /* 1.1 */
+CONST CharType demo_ENUM_5_2[] = {0x31, 0x2e, 0x30}; /* 1.0 */
+
+static CONST String demo_enumValues_5[3] = { 
+   {demo_ENUM_5_0, 3},
+   {demo_ENUM_5_1, 3},
+   {demo_ENUM_5_2, 3}
+};
+
+static CONST EnumDefinition demo_enumTable[6] = { 
+   {47, demo_enumValues_0, 2},
+   {48, demo_enumValues_1, 2},
+   {49, demo_enumValues_2, 3},
+   {50, demo_enumValues_3, 2},
+   {51, demo_enumValues_4, 2},
+   {52, demo_enumValues_5, 3}
+};
+
+const QNameID demo_qnames[demo_QN_COUNT] =
+{
+    {0, 0},
+    {0, 1},
+    {0, 2},
+    {0, 3},
+    {0, 4},
+    {0, 5},
+    {0, 6},
+    {0, 7},
+    {0, 8},
+    {0, 9},
+    {0, 10},
+    {0, 11},
+    {0, 12},
+    {0, 13},
+    {0, 14},
+    {0, 15},
+    {0, 16},
+    {0, 17},
+    {0, 18},
+    {0, 19},
+    {0, 20},
+    {0, 21},
+    {0, 22},
+    {0, 23},
+    {0, 24},
+    {0, 25},
+    {0, 26},
+    {0, 27},
+    {0, 28},
+    {0, 29},
+    {0, 30},
+    {0, 31},
+    {0, 32},
+    {0, 33},
+    {0, 34},
+    {0, 35},
+    {0, 36},
+    {0, 37},
+    {0, 38},
+    {0, 39},
+    {0, 40},
+    {0, 41},
+    {1, 0},
+    {1, 1},
+    {1, 2},
+    {1, 3},
+    {2, 0},
+    {2, 1},
+    {3, 0},
+    {3, 1},
+    {3, 2},
+    {3, 3},
+    {3, 4},
+    {3, 5},
+    {3, 6},
+    {3, 7},
+    {3, 8},
+    {3, 9},
+    {3, 10},
+    {3, 11},
+    {3, 12},
+    {3, 13},
+    {3, 14},
+    {3, 15},
+    {3, 16},
+    {3, 17},
+    {3, 18},
+    {3, 19},
+    {3, 20},
+    {3, 21},
+    {3, 22},
+    {3, 23},
+    {3, 24},
+    {3, 25},
+    {3, 26},
+    {3, 27},
+    {3, 28},
+    {3, 29},
+    {3, 30},
+    {3, 31},
+    {3, 32},
+    {3, 33},
+    {3, 34},
+    {3, 35},
+    {3, 36},
+    {3, 37},
+    {3, 38},
+    {3, 39},
+    {3, 40},
+    {3, 41},
+    {3, 42},
+    {3, 43},
+    {3, 44},
+    {3, 45},
+};
+
+static const Index demo_uriBase[5] = {0, 42, 46, 48, 94};
+
+static errorCode demo_decode_doc(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		case 1:
+			*code = 0;
+			return EXIP_OK;
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_doc(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_configuration: *code = 0; break;
+						default:
+							*code = 1;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_ED_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return EXIP_OK;
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_0(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_0(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_LIST_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_1(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_1(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_2(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_2(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_3(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_3(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_4(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_4(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_LIST_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_5(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_5(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_6(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_6(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_7(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_7(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_LIST_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_8(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_8(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_9(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_9(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_10(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_10(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_11(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_11(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_12(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			return decodeNBitUnsignedInteger(strm, 3, code);
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 2, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_12(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_AT_CLASS:
+					*code = 0;
+				break;
+				case EVENT_SE_CLASS:
+					*code = 1;
+				break;
+				case EVENT_EE_CLASS:
+					*code = 2;
+				break;
+				case EVENT_CH_CLASS:
+					*code = 3;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 3, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					*code = 0;
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				case EVENT_CH_CLASS:
+					*code = 2;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_13(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_13(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_14(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_14(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_BINARY_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_15(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_15(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_BOOLEAN_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_16(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_16(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_17(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_17(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_18(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_18(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_19(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_19(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DECIMAL_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_20(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_20(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_FLOAT_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_21(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_21(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_22(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_22(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_FLOAT_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_23(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_23(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_24(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_24(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_25(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_25(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_26(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_26(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_27(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_27(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_28(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_28(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_BINARY_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_29(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_29(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_30(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_30(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_31(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_31(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_32(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_32(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_33(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_33(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_34(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_34(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_35(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_35(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_36(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_36(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_37(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_37(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_38(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_38(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_39(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_39(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_40(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_40(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_DATE_TIME_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_41(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_41(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_42(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_42(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_43(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_43(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_44(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_44(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_45(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_45(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_INTEGER_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_46(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_46(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_47(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_47(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_48(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_48(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_admin_state: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_no_receive: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_no_forward: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 3:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_no_packet_in: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 4:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_49(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_49(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_resource_id: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_configuration: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_50(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 2, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_50(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_51(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_51(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_52(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 2, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_52(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_53(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_53(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_54(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_54(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_55(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_55(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_56(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_56(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_57(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_57(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_58(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_58(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_connection_state: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_current_version: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_59(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+		case 5:
+		case 6:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_59(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_id: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_role: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_ip_address: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 3:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_port: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 4:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_protocol: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 5:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_state: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 6:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_60(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 2, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_60(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_controller: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_controller: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_controller: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_61(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+		case 5:
+		case 6:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_61(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_id: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_datapath_id: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_enabled: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 3:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_lost_connection_behavior: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 4:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_resources: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 5:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_controllers: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 6:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_62(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 2, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_62(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_switch: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_switch: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_switch: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				case EVENT_EE_CLASS:
+					*code = 1;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 2, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_63(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+		case 2:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_63(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_resources: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_logical_switches: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 2:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_64(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_64(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_SE_CLASS:
+					switch(qname)
+					{
+						case demo_QN_0_capable_switch: *code = 0; break;
+						default:
+							*code = INDEX_MAX;
+					}
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_65(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_65(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_decode_66(EXIStream* strm, SmallIndex ruleId, unsigned int* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+		case 1:
+			return decodeNBitUnsignedInteger(strm, 1, code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static errorCode demo_encode_66(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,
+								Index qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)
+{
+	switch(ruleId)
+	{
+		case 0:
+			switch(eventClass)
+			{
+				case EVENT_CH_CLASS:
+					*code = chTypeClass == VALUE_TYPE_STRING_CLASS ? 0 : INDEX_MAX;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		case 1:
+			switch(eventClass)
+			{
+				case EVENT_EE_CLASS:
+					*code = 0;
+				break;
+				default:
+					*code = INDEX_MAX;
+			}
+			return *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, 1, *code);
+		default:
+			return EXIP_INCONSISTENT_PROC_STATE;
+	}
+}
+
+static const StaticGrammarCodec demo_grammarCodec[67] =
+{
+    {demo_decode_0, demo_encode_0},
+    {demo_decode_1, demo_encode_1},
+    {demo_decode_2, demo_encode_2},
+    {demo_decode_3, demo_encode_3},
+    {demo_decode_4, demo_encode_4},
+    {demo_decode_5, demo_encode_5},
+    {demo_decode_6, demo_encode_6},
+    {demo_decode_7, demo_encode_7},
+    {demo_decode_8, demo_encode_8},
+    {demo_decode_9, demo_encode_9},
+    {demo_decode_10, demo_encode_10},
+    {demo_decode_11, demo_encode_11},
+    {demo_decode_12, demo_encode_12},
+    {demo_decode_13, demo_encode_13},
+    {demo_decode_14, demo_encode_14},
+    {demo_decode_15, demo_encode_15},
+    {demo_decode_16, demo_encode_16},
+    {demo_decode_17, demo_encode_17},
+    {demo_decode_18, demo_encode_18},
+    {demo_decode_19, demo_encode_19},
+    {demo_decode_20, demo_encode_20},
+    {demo_decode_21, demo_encode_21},
+    {demo_decode_22, demo_encode_22},
+    {demo_decode_23, demo_encode_23},
+    {demo_decode_24, demo_encode_24},
+    {demo_decode_25, demo_encode_25},
+    {demo_decode_26, demo_encode_26},
+    {demo_decode_27, demo_encode_27},
+    {demo_decode_28, demo_encode_28},
+    {demo_decode_29, demo_encode_29},
+    {demo_decode_30, demo_encode_30},
+    {demo_decode_31, demo_encode_31},
+    {demo_decode_32, demo_encode_32},
+    {demo_decode_33, demo_encode_33},
+    {demo_decode_34, demo_encode_34},
+    {demo_decode_35, demo_encode_35},
+    {demo_decode_36, demo_encode_36},
+    {demo_decode_37, demo_encode_37},
+    {demo_decode_38, demo_encode_38},
+    {demo_decode_39, demo_encode_39},
+    {demo_decode_40, demo_encode_40},
+    {demo_decode_41, demo_encode_41},
+    {demo_decode_42, demo_encode_42},
+    {demo_decode_43, demo_encode_43},
+    {demo_decode_44, demo_encode_44},
+    {demo_decode_45, demo_encode_45},
+    {demo_decode_46, demo_encode_46},
+    {demo_decode_47, demo_encode_47},
+    {demo_decode_48, demo_encode_48},
+    {demo_decode_49, demo_encode_49},
+    {demo_decode_50, demo_encode_50},
+    {demo_decode_51, demo_encode_51},
+    {demo_decode_52, demo_encode_52},
+    {demo_decode_53, demo_encode_53},
+    {demo_decode_54, demo_encode_54},
+    {demo_decode_55, demo_encode_55},
+    {demo_decode_56, demo_encode_56},
+    {demo_decode_57, demo_encode_57},
+    {demo_decode_58, demo_encode_58},
+    {demo_decode_59, demo_encode_59},
+    {demo_decode_60, demo_encode_60},
+    {demo_decode_61, demo_encode_61},
+    {demo_decode_62, demo_encode_62},
+    {demo_decode_63, demo_encode_63},
+    {demo_decode_64, demo_encode_64},
+    {demo_decode_65, demo_encode_65},
+    {demo_decode_66, demo_encode_66}
+};
+
+static const StaticCodec demo_codec =
+{
+    FALSE,
+    0,
+    {demo_decode_doc, demo_encode_doc},
+    demo_grammarCodec,
+    demo_uriBase,
+    4
+};
+
+CONST EXIPSchema demo_schema =
+{
+    {NULL, NULL},
+    {{sizeof(UriEntry), 4, 4}, demo_uriEntry, 4},
+    {demo_docGrammarRule, 100663296, 2},
+    {{sizeof(SimpleType), 55, 55}, demo_simpleTypes, 55},
+    {{sizeof(EXIGrammar), 67, 67}, demo_grammarTable, 67},
+    67,
+    {{sizeof(EnumDefinition), 6, 6}, demo_enumTable, 6},
+    &demo_codec
+};
+
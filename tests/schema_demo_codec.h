@@ -0,0 +1,113 @@
+/** AUTO-GENERATED: Sun Oct 18 03:02:27 2026
+  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU
+  * $Id$ */
+
+#ifndef demo_CODEC_H_
+#define demo_CODEC_H_
+
+#include "procTypes.h"
+
+/** The QName constants of the schema: demo_qnames[demo_QN_<uriId>_<local name>] is the QNameID */
+enum demo_QName
+{
+    demo_QN_0_OFCapableSwitchResourceListType,
+    demo_QN_0_OFCapableSwitchType,
+    demo_QN_0_OFConfigID,
+    demo_QN_0_OFControllerConnectionStateType,
+    demo_QN_0_OFControllerListType,
+    demo_QN_0_OFControllerOpenFlowStateType,
+    demo_QN_0_OFControllerProtocolType,
+    demo_QN_0_OFControllerRoleType,
+    demo_QN_0_OFControllerType,
+    demo_QN_0_OFLogicalSwitchListType,
+    demo_QN_0_OFLogicalSwitchLostConnnectionBehavior,
+    demo_QN_0_OFLogicalSwitchResourceListType,
+    demo_QN_0_OFLogicalSwitchType,
+    demo_QN_0_OFOpenFlowVersionType,
+    demo_QN_0_OFPortConfigurationType,
+    demo_QN_0_OFPortStateOptionsType,
+    demo_QN_0_OFPortType,
+    demo_QN_0_admin_state,
+    demo_QN_0_capable_switch,
+    demo_QN_0_configuration,
+    demo_QN_0_connection_state,
+    demo_QN_0_controller,
+    demo_QN_0_controllers,
+    demo_QN_0_current_version,
+    demo_QN_0_datapath_id,
+    demo_QN_0_enabled,
+    demo_QN_0_id,
+    demo_QN_0_ip_address,
+    demo_QN_0_ipv4_address,
+    demo_QN_0_ipv6_address,
+    demo_QN_0_logical_switches,
+    demo_QN_0_lost_connection_behavior,
+    demo_QN_0_no_forward,
+    demo_QN_0_no_packet_in,
+    demo_QN_0_no_receive,
+    demo_QN_0_port,
+    demo_QN_0_protocol,
+    demo_QN_0_resource_id,
+    demo_QN_0_resources,
+    demo_QN_0_role,
+    demo_QN_0_state,
+    demo_QN_0_switch,
+    demo_QN_1_base,
+    demo_QN_1_id,
+    demo_QN_1_lang,
+    demo_QN_1_space,
+    demo_QN_2_nil,
+    demo_QN_2_type,
+    demo_QN_3_ENTITIES,
+    demo_QN_3_ENTITY,
+    demo_QN_3_ID,
+    demo_QN_3_IDREF,
+    demo_QN_3_IDREFS,
+    demo_QN_3_NCName,
+    demo_QN_3_NMTOKEN,
+    demo_QN_3_NMTOKENS,
+    demo_QN_3_NOTATION,
+    demo_QN_3_Name,
+    demo_QN_3_QName,
+    demo_QN_3_anySimpleType,
+    demo_QN_3_anyType,
+    demo_QN_3_anyURI,
+    demo_QN_3_base64Binary,
+    demo_QN_3_boolean,
+    demo_QN_3_byte,
+    demo_QN_3_date,
+    demo_QN_3_dateTime,
+    demo_QN_3_decimal,
+    demo_QN_3_double,
+    demo_QN_3_duration,
+    demo_QN_3_float,
+    demo_QN_3_gDay,
+    demo_QN_3_gMonth,
+    demo_QN_3_gMonthDay,
+    demo_QN_3_gYear,
+    demo_QN_3_gYearMonth,
+    demo_QN_3_hexBinary,
+    demo_QN_3_int,
+    demo_QN_3_integer,
+    demo_QN_3_language,
+    demo_QN_3_long,
+    demo_QN_3_negativeInteger,
+    demo_QN_3_nonNegativeInteger,
+    demo_QN_3_nonPositiveInteger,
+    demo_QN_3_normalizedString,
+    demo_QN_3_positiveInteger,
+    demo_QN_3_short,
+    demo_QN_3_string,
+    demo_QN_3_time,
+    demo_QN_3_token,
+    demo_QN_3_unsignedByte,
+    demo_QN_3_unsignedInt,
+    demo_QN_3_unsignedLong,
+    demo_QN_3_unsignedShort,
+    demo_QN_COUNT
+};
+
+extern EXIPSchema demo_schema;
+extern const QNameID demo_qnames[demo_QN_COUNT];
+
+#endif /* demo_CODEC_H_ */
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""Writes the schema-less catalog fixtures of this directory.
+
+The EXI streams are produced by this encoder, written from the EXI 1.0
+specification independently of the exip encoder, and compressed with
+zlib (raw DEFLATE, RFC 1951). Only the subset of EXI used by the
+catalog documents is supported: built-in element grammars with SE, AT,
+CH and EE events, default options apart from the alignment/compression.
+The values of the documents have no global string table hits, whose
+compact identifiers depend on the order in which the value channels
+are decoded. These streams stand in for the output of another EXI
+implementation (e.g. EXIficient); such streams can be added next to them.
+"""
+
+import math
+import zlib
+
+# Header: distinguishing bits 10, options present, final version 1,
+# followed by the EXI options document (Appendix C) in strict bit-packed
+# mode; the two options documents below end on a byte boundary.
+HEADERS = {
+    # <header><lesscommon><uncommon><alignment><pre-compress/>
+    "pre-compress": bytes([0xA0, 0x00, 0xCA]),
+    # <header><common><compression/>
+    "compression": bytes([0xA0, 0x25]),
+}
+
+
+def nbits(count):
+    return 0 if count <= 1 else math.ceil(math.log2(count))
+
+
+class Out:
+    def __init__(self):
+        self.data = bytearray()
+
+    def nbit(self, value, bits):
+        # Byte aligned n-bit unsigned integer: least significant byte first
+        for _ in range((bits + 7) // 8):
+            self.data.append(value & 0xFF)
+            value >>= 8
+
+    def uint(self, value):
+        while True:
+            byte = value & 0x7F
+            value >>= 7
+            if value:
+                self.data.append(byte | 0x80)
+            else:
+                self.data.append(byte)
+                return
+
+    def chars(self, s):
+        for c in s:
+            self.uint(ord(c))
+
+
+class ElementGrammar:
+    """Built-in element grammar: learned productions come first, the most
+    recently learned with event code 0"""
+
+    def __init__(self):
+        self.start = []    # learned StartTagContent productions
+        self.content = []  # learned ElementContent productions
+
+
+class Encoder:
+    def __init__(self):
+        self.structure = Out()
+        self.channels = {}      # qname -> list of values in document order
+        self.uris = ["", "http://www.w3.org/XML/1998/namespace",
+                     "http://www.w3.org/2001/XMLSchema-instance"]
+        self.localNames = {0: []}
+        self.grammars = {}
+        self.stack = []         # [qname, in StartTagContent]
+
+    def eventCode(self, parts):
+        for value, count in parts:
+            self.structure.nbit(value, nbits(count))
+
+    def qname(self, name):
+        # uri "" is a hit (id 0), local-name hit or miss in the "" partition
+        self.structure.nbit(1, nbits(len(self.uris) + 1))
+        names = self.localNames[0]
+        if name in names:
+            self.structure.uint(0)
+            self.structure.nbit(names.index(name), nbits(len(names)))
+        else:
+            self.structure.uint(len(name) + 1)
+            self.structure.chars(name)
+            names.append(name)
+
+    def production(self, prod):
+        """Event code of prod in the grammar of the current element; the
+        undeclared productions of StartTagContent are EE, AT(*), SE(*), CH
+        and of ElementContent EE, SE(*), CH (no fidelity options).
+        Returns True if the production is a learned one"""
+        qname, inStart = self.stack[-1]
+        g = self.grammars[qname]
+        learned = g.start if inStart else g.content
+        if prod in learned:
+            self.eventCode([(learned.index(prod), len(learned) + (1 if inStart else 2))])
+            return True
+        if inStart:
+            generic = ["EE", "AT", "SE", "CH"]
+            kind = prod[0]
+            self.eventCode([(len(learned), len(learned) + 1), (generic.index(kind), 4)])
+        else:
+            generic = ["SE", "CH"]
+            kind = prod[0]
+            if kind == "EE":
+                self.eventCode([(len(learned), len(learned) + 2)])
+                return True
+            self.eventCode([(len(learned) + 1, len(learned) + 2), (generic.index(kind), 2)])
+        learned.insert(0, prod)
+        return False
+
+    def startElement(self, name):
+        # DocContent: SE(*) is the only production (0 bits)
+        learned = False
+        if self.stack:
+            learned = self.production(("SE", name))
+            self.stack[-1][1] = False
+        if not learned:
+            self.qname(name)
+        self.grammars.setdefault(name, ElementGrammar())
+        self.stack.append([name, True])
+
+    def attribute(self, name, value):
+        if not self.production(("AT", name)):
+            self.qname(name)
+        self.channels.setdefault(name, []).append(value)
+
+    def characters(self, value):
+        self.production(("CH",))
+        self.stack[-1][1] = False
+        self.channels.setdefault(self.stack[-1][0], []).append(value)
+
+    def endElement(self):
+        self.production(("EE",))
+        self.stack.pop()
+
+
+def encodeValues(channels, order):
+    """The string values of the channels in order, with the string table
+    updated in the same order"""
+    out = {}
+    globalValues = []
+    for qname in order:
+        local = []
+        o = Out()
+        for v in channels[qname]:
+            if v in local:
+                o.uint(0)
+                o.nbit(local.index(v), nbits(len(local)))
+            else:
+                assert v not in globalValues, "no global hits in the fixtures"
+                o.uint(len(v) + 2)
+                o.chars(v)
+                if v:
+                    local.append(v)
+                    globalValues.append(v)
+        out[qname] = bytes(o.data)
+    return out
+
+
+def encode(doc, mode):
+    enc = Encoder()
+    # SD and ED have a single production (0 bits)
+    events, order = doc
+    for ev in events:
+        getattr(enc, ev[0])(*ev[1:])
+    structure = bytes(enc.structure.data)
+    values = encodeValues(enc.channels, order)
+
+    total = sum(len(enc.channels[q]) for q in order)
+    if total <= 100:
+        streams = [structure + b"".join(values[q] for q in order)]
+    else:
+        streams = [structure]
+        small = b"".join(values[q] for q in order if len(enc.channels[q]) <= 100)
+        if small:
+            streams.append(small)
+        streams += [values[q] for q in order if len(enc.channels[q]) > 100]
+
+    body = b""
+    for s in streams:
+        if mode == "compression":
+            c = zlib.compressobj(9, zlib.DEFLATED, -15)
+            body += c.compress(s) + c.flush()
+        else:
+            body += s
+    return HEADERS[mode] + body
+
+
+def catalog(count):
+    """<catalog> with count <item> elements and a closing <note>: every
+    fourth item (3, 7, ...) is empty, the first one has a lang attribute"""
+    events = [("startElement", "catalog")]
+    xml = "<catalog>"
+    order = []
+
+    def value(q):
+        if q not in order:
+            order.append(q)
+
+    for i in range(count):
+        events.append(("startElement", "item"))
+        events.append(("attribute", "id", "i%d" % i))
+        value("id")
+        xml += '<item id="i%d"' % i
+        if i == 0:
+            events.append(("attribute", "lang", "en"))
+            value("lang")
+            xml += ' lang="en"'
+        if i % 4 == 3:
+            xml += "/>"
+        else:
+            events.append(("characters", "v%d" % (i % 3)))
+            value("item")
+            xml += ">v%d</item>" % (i % 3)
+        events.append(("endElement",))
+    events += [("startElement", "note"), ("characters", "done"), ("endElement",), ("endElement",)]
+    value("note")
+    xml += "<note>done</note></catalog>\n"
+    return (events, order), xml
+
+
+if __name__ == "__main__":
+    for name, count in (("catalog-small", 4), ("catalog-large", 140)):
+        doc, xml = catalog(count)
+        with open(name + ".xml", "w") as f:
+            f.write(xml)
+        with open(name + "-precompression.exi", "wb") as f:
+            f.write(encode(doc, "pre-compress"))
+        with open(name + "-compression.exi", "wb") as f:
+            f.write(encode(doc, "compression"))
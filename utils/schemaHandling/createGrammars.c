@@ -65,27 +65,16 @@ errorCode toText(EXIPSchema* schemaPtr, FILE *outfile)
 	return EXIP_OK;
 }
 
-errorCode toStaticSrc(EXIPSchema* schemaPtr, char* prefix, FILE *outfile)
+/**
+ * @brief The string tables, grammars, simple types and enumerations of a static schema
+ */
+static void staticSchemaDefsOutput(EXIPSchema* schemaPtr, char* prefix, FILE *outfile)
 {
-	time_t now;
-    Index count;
 	Index uriId;
 	Index stId, stIdMax;
 	Index grIter;
 	EXIGrammar* tmpGrammar;
 
-	time(&now);
-	fprintf(outfile, "/** AUTO-GENERATED: %.24s\n  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU\n  * $Id$ */\n\n",  ctime(&now));
-
-	// TODO: revise this comments!
-	// NOTE: Do not use without option mask! Also when strict == FALSE the memPairs are NULL which will create errors
-	// When there is no mask specified this is not correct if the schema is used more than once
-	// There is extra rule slot for each grammar to be use if
-	// strict == FALSE by addUndeclaredProductions() when no mask is specified
-
-	fprintf(outfile, "#include \"procTypes.h\"\n\n");
-	fprintf(outfile, "#define CONST\n\n");
-
 	staticStringTblDefsOutput(&schemaPtr->uriTable, prefix, outfile);
 
 	for(grIter = 0; grIter < schemaPtr->grammarTable.count; grIter++)
@@ -143,6 +132,14 @@ errorCode toStaticSrc(EXIPSchema* schemaPtr, char* prefix, FILE *outfile)
 
     /* Enum table entries */
     staticEnumTableOutput(schemaPtr, prefix, outfile);
+}
+
+/**
+ * @brief The EXIPSchema structure of a static schema; withCodec adds the production selection functions
+ */
+static void staticSchemaOutput(EXIPSchema* schemaPtr, char* prefix, boolean withCodec, FILE *outfile)
+{
+	Index count;
 
 	/* Finally, build the schema structure */
 	fprintf(outfile,
@@ -185,13 +182,82 @@ errorCode toStaticSrc(EXIPSchema* schemaPtr, char* prefix, FILE *outfile)
 
     count = schemaPtr->enumTable.count;
 	fprintf(outfile,
-            "    {{sizeof(EnumDefinition), %u, %u}, %s%s, %u}\n};\n\n",
+            "    {{sizeof(EnumDefinition), %u, %u}, %s%s, %u}",
 
             (unsigned int) count,
             (unsigned int) count,
             count == 0?"":prefix, count == 0?"NULL":"enumTable",
 			(unsigned int) count);
 
+	if(withCodec)
+		fprintf(outfile, ",\n    &%scodec", prefix);
+	fprintf(outfile, "\n};\n\n");
+}
+
+errorCode toStaticSrc(EXIPSchema* schemaPtr, char* prefix, FILE *outfile)
+{
+	time_t now;
+
+	time(&now);
+	fprintf(outfile, "/** AUTO-GENERATED: %.24s\n  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU\n  * $Id$ */\n\n",  ctime(&now));
+
+	// TODO: revise this comments!
+	// NOTE: Do not use without option mask! Also when strict == FALSE the memPairs are NULL which will create errors
+	// When there is no mask specified this is not correct if the schema is used more than once
+	// There is extra rule slot for each grammar to be use if
+	// strict == FALSE by addUndeclaredProductions() when no mask is specified
+
+	fprintf(outfile, "#include \"procTypes.h\"\n\n");
+	fprintf(outfile, "#define CONST\n\n");
+
+	staticSchemaDefsOutput(schemaPtr, prefix, outfile);
+	staticSchemaOutput(schemaPtr, prefix, FALSE, outfile);
+
+	return EXIP_OK;
+}
+
+errorCode toCodecSrc(EXIPSchema* schemaPtr, char* prefix, EXIOptions* opts, FILE *outfile, FILE *headerfile, char* headerName)
+{
+	time_t now;
+	EXIStream strm;
+	Index grIter;
+	char grName[20];
+
+	// Only the options are used for the number of bits of the event codes
+	strm.header.opts = *opts;
+
+	time(&now);
+	fprintf(outfile, "/** AUTO-GENERATED: %.24s\n  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU\n  * $Id$ */\n\n",  ctime(&now));
+	fprintf(outfile, "#include \"procTypes.h\"\n");
+	fprintf(outfile, "#include \"streamDecode.h\"\n");
+	fprintf(outfile, "#include \"streamEncode.h\"\n");
+	if(headerName != NULL)
+		fprintf(outfile, "#include \"%s\"\n", headerName);
+	fprintf(outfile, "\n#if !STATIC_CODEC_USE\n# error The generated event code functions require STATIC_CODEC_USE\n#endif\n\n");
+	fprintf(outfile, "#define CONST\n\n");
+
+	if(headerName != NULL)
+	{
+		fprintf(headerfile, "/** AUTO-GENERATED: %.24s\n  * Copyright (c) 2010 - 2011, Rumen Kyusakov, EISLAB, LTU\n  * $Id$ */\n\n",  ctime(&now));
+		fprintf(headerfile, "#ifndef %sCODEC_H_\n#define %sCODEC_H_\n\n#include \"procTypes.h\"\n\n", prefix, prefix);
+	}
+	codecQNameDefsOutput(&schemaPtr->uriTable, prefix, headerfile);
+	if(headerName != NULL)
+		fprintf(headerfile, "#endif /* %sCODEC_H_ */\n", prefix);
+
+	staticSchemaDefsOutput(schemaPtr, prefix, outfile);
+	codecQNameTableOutput(&schemaPtr->uriTable, prefix, outfile);
+
+	codecGrammarOutput(schemaPtr, &strm, &schemaPtr->docGrammar, prefix, "doc", outfile);
+	for(grIter = 0; grIter < schemaPtr->grammarTable.count; grIter++)
+	{
+		sprintf(grName, "%u", (unsigned int) grIter);
+		codecGrammarOutput(schemaPtr, &strm, &schemaPtr->grammarTable.grammar[grIter], prefix, grName, outfile);
+	}
+	codecTableOutput(schemaPtr, &strm, prefix, outfile);
+
+	staticSchemaOutput(schemaPtr, prefix, TRUE, outfile);
+
 	return EXIP_OK;
 }
 
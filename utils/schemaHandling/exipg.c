@@ -24,12 +24,16 @@
 #define OUT_TEXT     1
 #define OUT_SRC_DYN  2
 #define OUT_SRC_STAT 3
+#define OUT_SRC_CODEC 4
 
 static void printfHelp();
 
 int main(int argc, char *argv[])
 {
 	FILE *outfile = stdout; // Default is the standard output
+	FILE *headerfile = NULL;
+	char headerPath[FILENAME_MAX];
+	char* headerName = NULL;
 	EXIPSchema schema;
 	unsigned char outputFormat = OUT_EXIP;
 	int argIndex = 1;
@@ -71,6 +75,11 @@ int main(int argc, char *argv[])
 		outputFormat = OUT_SRC_STAT;
 		argIndex++;
 	}
+	else if(strcmp(argv[argIndex], "-codec") == 0)
+	{
+		outputFormat = OUT_SRC_CODEC;
+		argIndex++;
+	}
 
 	if(argc <= argIndex)
 	{
@@ -169,6 +178,21 @@ int main(int argc, char *argv[])
 			fprintf(stderr, "Unable to open file %s", argv[argIndex]);
 			return 1;
 		}
+
+		// The QName constants of a codec written to <name>.c are in <name>.h
+		if(outputFormat == OUT_SRC_CODEC && strlen(argv[argIndex]) > 2 && strlen(argv[argIndex]) < FILENAME_MAX &&
+				strcmp(argv[argIndex] + strlen(argv[argIndex]) - 2, ".c") == 0)
+		{
+			strcpy(headerPath, argv[argIndex]);
+			headerPath[strlen(headerPath) - 1] = 'h';
+			headerfile = fopen(headerPath, "wb" );
+			if(!headerfile)
+			{
+				fprintf(stderr, "Unable to open file %s", headerPath);
+				return 1;
+			}
+			headerName = strrchr(headerPath, '/') != NULL ? strrchr(headerPath, '/') + 1 : headerPath;
+		}
 		argIndex += 1;
 	}
 
@@ -186,6 +210,9 @@ int main(int argc, char *argv[])
 		case OUT_SRC_DYN:
 			tmp_err_code = toDynSrc(&schema, outfile);
 		break;
+		case OUT_SRC_CODEC:
+			tmp_err_code = toCodecSrc(&schema, prefix, &maskOpt, outfile, headerfile != NULL ? headerfile : outfile, headerName);
+		break;
 		default:
 			printf("\nUnsupported output format!");
 			exit(1);
@@ -195,6 +222,8 @@ int main(int argc, char *argv[])
 	destroySchema(&schema);
 
 	fclose(outfile);
+	if(headerfile != NULL)
+		fclose(headerfile);
 
 	if(tmp_err_code != EXIP_OK)
 	{
@@ -211,13 +240,17 @@ static void printfHelp()
     printf("  EXIP     Copyright (c) 2010 - 2012, EISLAB - Luleå University of Technology Version 0.5.1 \n");
     printf("           Author: Rumen Kyusakov\n");
     printf("  Usage:   exipg [options] -schema=<xsd_in> [grammar_out] \n\n");
-    printf("           Options: [-help | [[-exip | -text | -dynamic | -static] [-pfx=<prefix>] [-ops=<ops_mask>]] ] \n");
+    printf("           Options: [-help | [[-exip | -text | -dynamic | -static | -codec] [-pfx=<prefix>] [-ops=<ops_mask>]] ] \n");
     printf("           -help        :   Prints this help message\n");
     printf("           -exip        :   Format the output schema definitions in EXIP-specific format (Default)\n");
     printf("           -text        :   Format the output schema definitions in human readable text format\n");
     printf("           -dynamic     :   Create C code for the grammars defined. The output is a C function that dynamically generates the grammars\n");
     printf("           -static      :   Create C code for the grammars defined. The output is C structures describing the grammars\n");
-    printf("           -pfx         :   When in -dynamic or -static mode, this option allows you to specify a unique prefix for the\n");
+    printf("           -codec       :   Same as -static plus C functions that select the production of each event code; the values and the\n");
+    printf("                            string tables are still processed by the generic code. The element and attribute\n");
+    printf("                            names become the integer constants of an enumeration; with <grammar_out> = <name>.c they are written to <name>.h.\n");
+    printf("                            The code is specific to the STRICT, dtd, comments and pis values of <ops_mask> (default all 0)\n");
+    printf("           -pfx         :   When in -dynamic, -static or -codec mode, this option allows you to specify a unique prefix for the\n");
     printf("                            generated global types. The default is \"prfx_\"\n");
     printf("           ops_mask     :   The format is: <STRICT><SELF_CONTAINED><dtd><prefixes><lexicalValues><comments><pis> := <0|1><0|1><0|1><0|1><0|1><0|1><0|1>\n");
     printf("                            Use this argument only for specifying out-of-band options. That is if no options are specified in the header of the <xsd_in>\n");
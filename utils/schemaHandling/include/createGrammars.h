@@ -23,6 +23,13 @@ errorCode toText(EXIPSchema* schemaPtr, FILE *outfile);
 
 errorCode toStaticSrc(EXIPSchema* schemaPtr, char* prefix, FILE *outfile);
 
+/**
+ * The static schema of toStaticSrc() with functions that select the production of each event code
+ * for the Strict and Preserve options in opts. The QName constants of the schema are written
+ * to headerfile which is included as headerName; with no headerName they are written to outfile.
+ */
+errorCode toCodecSrc(EXIPSchema* schemaPtr, char* prefix, EXIOptions* opts, FILE *outfile, FILE *headerfile, char* headerName);
+
 errorCode toDynSrc(EXIPSchema* schemaPtr, FILE *outfile);
 
 errorCode toEXIP(EXIPSchema* schemaPtr, FILE *outfile);
@@ -133,6 +133,55 @@ void staticUriTableOutput(UriTable* uriTbl, char* prefix, FILE* out);
 void staticEnumTableOutput(EXIPSchema* schema, char* prefix, FILE* out);
 
 
+/** PRODUCTION SELECTION (CODEC) OUTPUT DEFINITIONS */
+
+/**
+ * @brief The name of the QName constant of a local name in the string tables
+ * @param[in] uriTbl the UriTable instance containing the string table entries
+ * @param[in] prefix prefix for the definitions
+ * @param[in] uriId uriId of the QName
+ * @param[in] lnId lnId of the QName
+ * @param[out] varName buffer of VAR_BUFFER_MAX_LENGTH characters for the name
+ */
+void codecQNameConstant(UriTable* uriTbl, char* prefix, Index uriId, Index lnId, char* varName);
+
+/**
+ * @brief Builds the enumeration of the QName constants of all local names in the string tables
+ * and the declarations of the schema and QName table for the header of the generated codec
+ * @param[in] uriTbl the UriTable instance containing the string table entries
+ * @param[in] prefix prefix for the definitions
+ * @param[out] out output stream
+ */
+void codecQNameDefsOutput(UriTable* uriTbl, char* prefix, FILE* out);
+
+/**
+ * @brief Builds the table of the QNameIDs of the QName constants and the first constant of each URI
+ * @param[in] uriTbl the UriTable instance containing the string table entries
+ * @param[in] prefix prefix for the definitions
+ * @param[out] out output stream
+ */
+void codecQNameTableOutput(UriTable* uriTbl, char* prefix, FILE* out);
+
+/**
+ * @brief Builds the event code decode and encode functions of a grammar (see StaticGrammarCodec)
+ * @param[in] schema the EXIPSchema instance
+ * @param[in] strm EXI stream with the options the codec is generated for
+ * @param[in] gr EXI grammar whose production selection is generated
+ * @param[in] prefix prefix for the definitions
+ * @param[in] grName suffix of the function names
+ * @param[out] out output stream
+ */
+void codecGrammarOutput(EXIPSchema* schema, EXIStream* strm, EXIGrammar* gr, char* prefix, char* grName, FILE* out);
+
+/**
+ * @brief Builds the StaticCodec instance of the schema from the functions of codecGrammarOutput()
+ * @param[in] schema the EXIPSchema instance
+ * @param[in] strm EXI stream with the options the codec is generated for
+ * @param[in] prefix prefix for the definitions
+ * @param[out] out output stream
+ */
+void codecTableOutput(EXIPSchema* schema, EXIStream* strm, char* prefix, FILE* out);
+
 /** DYNAMIC CODE OUTPUT DEFINITIONS */
 
 /**
@@ -0,0 +1,362 @@
+/*==================================================================*\
+|                EXIP - Embeddable EXI Processor in C                |
+|--------------------------------------------------------------------|
+|          This work is licensed under BSD 3-Clause License          |
+|  The full license terms and conditions are located in LICENSE.txt  |
+\===================================================================*/
+
+/**
+ * @file codecOutputUtils.c
+ * @brief Implement utility functions for compiling the grammars of an EXIPSchema
+ * instance into event code functions (see StaticCodec in procTypes.h)
+ * @version 0.5
+ * @par[Revision] $Id$
+ */
+
+#include "schemaOutputUtils.h"
+#include "grammars.h"
+
+static const char* eventClassNames[] = {"EVENT_SD_CLASS", "EVENT_ED_CLASS", "EVENT_AT_CLASS", "EVENT_SE_CLASS",
+										"EVENT_EE_CLASS", "EVENT_CH_CLASS", "EVENT_NS_CLASS", "EVENT_CM_CLASS",
+										"EVENT_PI_CLASS", "EVENT_DT_CLASS", "EVENT_ER_CLASS", "EVENT_SC_CLASS"};
+
+#define CODEC_EVENT_CLASS_COUNT (sizeof(eventClassNames)/sizeof(eventClassNames[0]))
+
+static const char* valueClassNames[] = {"VALUE_TYPE_NONE_CLASS", "VALUE_TYPE_STRING_CLASS", "VALUE_TYPE_FLOAT_CLASS",
+										"VALUE_TYPE_DECIMAL_CLASS", "VALUE_TYPE_DATE_TIME_CLASS", "VALUE_TYPE_BOOLEAN_CLASS",
+										"VALUE_TYPE_BINARY_CLASS", "VALUE_TYPE_LIST_CLASS", "VALUE_TYPE_QNAME_CLASS",
+										"VALUE_TYPE_INTEGER_CLASS"};
+
+/**
+ * @brief The local name with all characters that are not allowed in C identifiers replaced by '_'
+ */
+static void sanitizedLnName(String* ln, char* name)
+{
+	Index i;
+	Index len = ln->length < VAR_BUFFER_MAX_LENGTH/2 ? ln->length : VAR_BUFFER_MAX_LENGTH/2;
+
+	for(i = 0; i < len; i++)
+	{
+		if((ln->str[i] >= 'a' && ln->str[i] <= 'z') || (ln->str[i] >= 'A' && ln->str[i] <= 'Z') ||
+				(ln->str[i] >= '0' && ln->str[i] <= '9'))
+			name[i] = ln->str[i];
+		else
+			name[i] = '_';
+	}
+	name[len] = '\0';
+}
+
+void codecQNameConstant(UriTable* uriTbl, char* prefix, Index uriId, Index lnId, char* varName)
+{
+	char name[VAR_BUFFER_MAX_LENGTH];
+	char other[VAR_BUFFER_MAX_LENGTH];
+	Index i;
+
+	sanitizedLnName(&uriTbl->uri[uriId].lnTable.ln[lnId].lnStr, name);
+	sprintf(varName, "%sQN_%u_%s", prefix, (unsigned int) uriId, name);
+
+	// Local names that differ only in the replaced characters get the lnId as well
+	for(i = 0; i < lnId; i++)
+	{
+		sanitizedLnName(&uriTbl->uri[uriId].lnTable.ln[i].lnStr, other);
+		if(strcmp(name, other) == 0)
+		{
+			sprintf(varName, "%sQN_%u_%s_%u", prefix, (unsigned int) uriId, name, (unsigned int) lnId);
+			break;
+		}
+	}
+}
+
+void codecQNameDefsOutput(UriTable* uriTbl, char* prefix, FILE* out)
+{
+	Index uriIter, lnIter;
+	char varName[VAR_BUFFER_MAX_LENGTH];
+
+	fprintf(out, "/** The QName constants of the schema: %sqnames[%sQN_<uriId>_<local name>] is the QNameID */\n", prefix, prefix);
+	fprintf(out, "enum %sQName\n{\n", prefix);
+	for(uriIter = 0; uriIter < uriTbl->count; uriIter++)
+	{
+		for(lnIter = 0; lnIter < uriTbl->uri[uriIter].lnTable.count; lnIter++)
+		{
+			codecQNameConstant(uriTbl, prefix, uriIter, lnIter, varName);
+			fprintf(out, "    %s,\n", varName);
+		}
+	}
+	fprintf(out, "    %sQN_COUNT\n};\n\n", prefix);
+
+	fprintf(out, "extern EXIPSchema %sschema;\n", prefix);
+	fprintf(out, "extern const QNameID %sqnames[%sQN_COUNT];\n\n", prefix, prefix);
+}
+
+void codecQNameTableOutput(UriTable* uriTbl, char* prefix, FILE* out)
+{
+	Index uriIter, lnIter;
+	Index base = 0;
+
+	fprintf(out, "const QNameID %sqnames[%sQN_COUNT] =\n{\n", prefix, prefix);
+	for(uriIter = 0; uriIter < uriTbl->count; uriIter++)
+	{
+		for(lnIter = 0; lnIter < uriTbl->uri[uriIter].lnTable.count; lnIter++)
+			fprintf(out, "    {%u, %u},\n", (unsigned int) uriIter, (unsigned int) lnIter);
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "static const Index %suriBase[%u] = {", prefix, (unsigned int) uriTbl->count + 1);
+	for(uriIter = 0; uriIter < uriTbl->count; uriIter++)
+	{
+		fprintf(out, "%u, ", (unsigned int) base);
+		base += uriTbl->uri[uriIter].lnTable.count;
+	}
+	fprintf(out, "%u};\n\n", (unsigned int) base);
+}
+
+/**
+ * @brief The event code of the first production of a rule with an event class and,
+ * for SE and AT, a QName that matches uriId:lnId; URI_MAX/LN_MAX match the
+ * productions with any URI/local name only. INDEX_MAX if there is no such production.
+ * Same as findProduction() in bodyEncode.c
+ */
+static Index findCodecProduction(GrammarRule* rule, EventTypeClass eventClass, SmallIndex uriId, Index lnId)
+{
+	Index j;
+	Production* prod;
+
+	for(j = 0; j < rule->pCount; j++)
+	{
+		prod = &rule->production[rule->pCount - 1 - j];
+		if(GET_PROD_EXI_EVENT_CLASS(prod->content) != eventClass)
+			continue;
+		if(eventClass != EVENT_SE_CLASS && eventClass != EVENT_AT_CLASS)
+			return j;
+		if(prod->qnameId.uriId == URI_MAX || (prod->qnameId.uriId == uriId &&
+				(prod->qnameId.lnId == LN_MAX || prod->qnameId.lnId == lnId)))
+			return j;
+	}
+
+	return INDEX_MAX;
+}
+
+static void codecCodeOutput(Index code, FILE* out)
+{
+	if(code == INDEX_MAX)
+		fprintf(out, "*code = INDEX_MAX;");
+	else
+		fprintf(out, "*code = %u;", (unsigned int) code);
+}
+
+/**
+ * @brief Whether the production is the first SE(qname)/AT(qname) of the QName that is
+ * encoded with a code different from the one of the other QNames in its URI
+ */
+static boolean isQNameCase(GrammarRule* rule, EventTypeClass eventClass, Index j)
+{
+	Production* prod = &rule->production[rule->pCount - 1 - j];
+	Index code;
+
+	if(GET_PROD_EXI_EVENT_CLASS(prod->content) != eventClass || prod->qnameId.uriId == URI_MAX || prod->qnameId.lnId == LN_MAX)
+		return FALSE;
+
+	code = findCodecProduction(rule, eventClass, prod->qnameId.uriId, prod->qnameId.lnId);
+	return code == j && code != findCodecProduction(rule, eventClass, prod->qnameId.uriId, LN_MAX);
+}
+
+/**
+ * @brief Whether the production is the first SE(uri:*)/AT(uri:*) of its URI
+ */
+static boolean isUriCase(GrammarRule* rule, EventTypeClass eventClass, Index j)
+{
+	Production* prod = &rule->production[rule->pCount - 1 - j];
+
+	if(GET_PROD_EXI_EVENT_CLASS(prod->content) != eventClass || prod->qnameId.uriId == URI_MAX || prod->qnameId.lnId != LN_MAX)
+		return FALSE;
+
+	return findCodecProduction(rule, eventClass, prod->qnameId.uriId, LN_MAX) == j;
+}
+
+/**
+ * @brief The SE or AT case of the encode function of a rule: a switch
+ * on the QName constants and then on the URI for the uri:* productions
+ */
+static void codecQNameEventOutput(EXIPSchema* schema, GrammarRule* rule, EventTypeClass eventClass, char* prefix, FILE* out)
+{
+	Index j;
+	Production* prod;
+	char varName[VAR_BUFFER_MAX_LENGTH];
+	char indent[10] = "\t\t\t\t\t";
+	boolean hasQNameCase = FALSE;
+	boolean hasUriCase = FALSE;
+
+	for(j = 0; j < rule->pCount; j++)
+	{
+		hasQNameCase = hasQNameCase || isQNameCase(rule, eventClass, j);
+		hasUriCase = hasUriCase || isUriCase(rule, eventClass, j);
+	}
+
+	fprintf(out, "\t\t\t\tcase %s:\n", eventClassNames[eventClass]);
+	if(hasQNameCase)
+	{
+		fprintf(out, "%sswitch(qname)\n%s{\n", indent, indent);
+		for(j = 0; j < rule->pCount; j++)
+		{
+			if(!isQNameCase(rule, eventClass, j))
+				continue;
+
+			prod = &rule->production[rule->pCount - 1 - j];
+			codecQNameConstant(&schema->uriTable, prefix, prod->qnameId.uriId, prod->qnameId.lnId, varName);
+			fprintf(out, "%s\tcase %s: ", indent, varName);
+			codecCodeOutput(j, out);
+			fprintf(out, " break;\n");
+		}
+		fprintf(out, "%s\tdefault:\n", indent);
+		strcat(indent, "\t\t");
+	}
+
+	if(hasUriCase)
+	{
+		fprintf(out, "%sswitch(uriId)\n%s{\n", indent, indent);
+		for(j = 0; j < rule->pCount; j++)
+		{
+			if(!isUriCase(rule, eventClass, j))
+				continue;
+
+			prod = &rule->production[rule->pCount - 1 - j];
+			fprintf(out, "%s\tcase %u: ", indent, (unsigned int) prod->qnameId.uriId);
+			codecCodeOutput(j, out);
+			fprintf(out, " break;\n");
+		}
+		fprintf(out, "%s\tdefault: ", indent);
+		codecCodeOutput(findCodecProduction(rule, eventClass, URI_MAX, LN_MAX), out);
+		fprintf(out, "\n%s}\n", indent);
+	}
+	else
+	{
+		fprintf(out, "%s", indent);
+		codecCodeOutput(findCodecProduction(rule, eventClass, URI_MAX, LN_MAX), out);
+		fprintf(out, "\n");
+	}
+
+	if(hasQNameCase)
+		fprintf(out, "\t\t\t\t\t}\n");
+	fprintf(out, "\t\t\t\tbreak;\n");
+}
+
+void codecGrammarOutput(EXIPSchema* schema, EXIStream* strm, EXIGrammar* gr, char* prefix, char* grName, FILE* out)
+{
+	Index ruleIter, otherIter;
+	Index j;
+	Index code;
+	unsigned int bits;
+	unsigned int eventClass;
+	boolean hasClass[CODEC_EVENT_CLASS_COUNT];
+	boolean done;
+	GrammarRule* rule;
+	Production* prod;
+
+	/* Decoding: the rules are grouped by the number of bits of their event codes */
+	fprintf(out, "static errorCode %sdecode_%s(EXIStream* strm, SmallIndex ruleId, unsigned int* code)\n{\n", prefix, grName);
+	fprintf(out, "\tswitch(ruleId)\n\t{\n");
+	for(ruleIter = 0; ruleIter < gr->count; ruleIter++)
+	{
+		if(gr->rule[ruleIter].pCount == 0)
+			continue;
+
+		bits = getGrammarBitsFirstPartCode(strm, gr, gr->rule[ruleIter].pCount, ruleIter, FALSE);
+		done = FALSE;
+		for(otherIter = 0; otherIter < ruleIter; otherIter++)
+		{
+			if(gr->rule[otherIter].pCount > 0 &&
+					getGrammarBitsFirstPartCode(strm, gr, gr->rule[otherIter].pCount, otherIter, FALSE) == bits)
+				done = TRUE;
+		}
+		if(done)
+			continue;
+
+		for(otherIter = ruleIter; otherIter < gr->count; otherIter++)
+		{
+			if(gr->rule[otherIter].pCount > 0 &&
+					getGrammarBitsFirstPartCode(strm, gr, gr->rule[otherIter].pCount, otherIter, FALSE) == bits)
+				fprintf(out, "\t\tcase %u:\n", (unsigned int) otherIter);
+		}
+
+		if(bits == 0)
+			fprintf(out, "\t\t\t*code = 0;\n\t\t\treturn EXIP_OK;\n");
+		else
+			fprintf(out, "\t\t\treturn decodeNBitUnsignedInteger(strm, %u, code);\n", bits);
+	}
+	fprintf(out, "\t\tdefault:\n\t\t\treturn EXIP_INCONSISTENT_PROC_STATE;\n\t}\n}\n\n");
+
+	/* Encoding: a switch on the event class and the QName in each rule */
+	fprintf(out, "static errorCode %sencode_%s(EXIStream* strm, SmallIndex ruleId, EventTypeClass eventClass,\n", prefix, grName);
+	fprintf(out, "\t\t\t\t\t\t\t\tIndex qname, SmallIndex uriId, EXITypeClass chTypeClass, Index* code)\n{\n");
+	fprintf(out, "\tswitch(ruleId)\n\t{\n");
+	for(ruleIter = 0; ruleIter < gr->count; ruleIter++)
+	{
+		rule = &gr->rule[ruleIter];
+		if(rule->pCount == 0)
+			continue;
+
+		fprintf(out, "\t\tcase %u:\n\t\t\tswitch(eventClass)\n\t\t\t{\n", (unsigned int) ruleIter);
+		for(eventClass = 0; eventClass < CODEC_EVENT_CLASS_COUNT; eventClass++)
+			hasClass[eventClass] = FALSE;
+		for(j = 0; j < rule->pCount; j++)
+		{
+			prod = &rule->production[rule->pCount - 1 - j];
+			eventClass = GET_PROD_EXI_EVENT_CLASS(prod->content);
+			if(eventClass >= CODEC_EVENT_CLASS_COUNT || hasClass[eventClass])
+				continue;
+			hasClass[eventClass] = TRUE;
+
+			if(eventClass == EVENT_SE_CLASS || eventClass == EVENT_AT_CLASS)
+				codecQNameEventOutput(schema, rule, eventClass, prefix, out);
+			else
+			{
+				code = j;
+				fprintf(out, "\t\t\t\tcase %s:\n\t\t\t\t\t", eventClassNames[eventClass]);
+				if(eventClass == EVENT_CH_CLASS && prod->typeId != INDEX_MAX &&
+						GET_EXI_TYPE(schema->simpleTypeTable.sType[prod->typeId].content) != VALUE_TYPE_NONE &&
+						GET_EXI_TYPE(schema->simpleTypeTable.sType[prod->typeId].content) != VALUE_TYPE_UNTYPED)
+				{
+					// Only the first CH production is checked
+					fprintf(out, "*code = chTypeClass == %s ? %u : INDEX_MAX;\n",
+							valueClassNames[GET_VALUE_TYPE_CLASS(GET_EXI_TYPE(schema->simpleTypeTable.sType[prod->typeId].content))],
+							(unsigned int) code);
+				}
+				else
+				{
+					codecCodeOutput(code, out);
+					fprintf(out, "\n");
+				}
+				fprintf(out, "\t\t\t\tbreak;\n");
+			}
+		}
+		fprintf(out, "\t\t\t\tdefault:\n\t\t\t\t\t*code = INDEX_MAX;\n\t\t\t}\n");
+
+		bits = getGrammarBitsFirstPartCode(strm, gr, rule->pCount, ruleIter, FALSE);
+		if(bits == 0)
+			fprintf(out, "\t\t\treturn EXIP_OK;\n");
+		else
+			fprintf(out, "\t\t\treturn *code == INDEX_MAX ? EXIP_OK : encodeNBitUnsignedInteger(strm, %u, *code);\n", bits);
+	}
+	fprintf(out, "\t\tdefault:\n\t\t\treturn EXIP_INCONSISTENT_PROC_STATE;\n\t}\n}\n\n");
+}
+
+void codecTableOutput(EXIPSchema* schema, EXIStream* strm, char* prefix, FILE* out)
+{
+	Index grIter;
+
+	fprintf(out, "static const StaticGrammarCodec %sgrammarCodec[%u] =\n{\n", prefix, (unsigned int) schema->grammarTable.count);
+	for(grIter = 0; grIter < schema->grammarTable.count; grIter++)
+	{
+		fprintf(out, "    {%sdecode_%u, %sencode_%u}%s\n", prefix, (unsigned int) grIter, prefix, (unsigned int) grIter,
+				grIter == schema->grammarTable.count - 1 ? "" : ",");
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "static const StaticCodec %scodec =\n{\n", prefix);
+	fprintf(out, "    %s,\n", WITH_STRICT(strm->header.opts.enumOpt) ? "TRUE" : "FALSE");
+	fprintf(out, "    %u,\n", (unsigned int) (strm->header.opts.preserve & (PRESERVE_DTD | PRESERVE_COMMENTS | PRESERVE_PIS)));
+	fprintf(out, "    {%sdecode_doc, %sencode_doc},\n", prefix, prefix);
+	fprintf(out, "    %sgrammarCodec,\n", prefix);
+	fprintf(out, "    %suriBase,\n", prefix);
+	fprintf(out, "    %u\n};\n\n", (unsigned int) schema->uriTable.count);
+}